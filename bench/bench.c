@@ -0,0 +1,318 @@
+/**
+ * Nexus3D Benchmark Runner
+ * Runs every scenario headless, writes median and p99 timings as JSON and
+ * fails when a median regressed against the baseline
+ *
+ * Usage: nexus_bench [--output file] [--baseline file] [--threshold percent]
+ *                    [--filter text] [--iterations count] [--no-gpu]
+ */
+
+#include "bench.h"
+#include "nexus3d/renderer/upload.h"
+#include "nexus3d/utils/allocator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Scenarios that can be reported in one run */
+#define NEXUS_BENCH_MAX_RESULTS 64
+
+/**
+ * Command line options
+ */
+typedef struct {
+    const char* output;            /* JSON report path */
+    const char* baseline;          /* Baseline report to compare with (NULL = none) */
+    double threshold;              /* Median slowdown in percent that fails the run */
+    const char* filter;            /* Only scenarios whose name contains this (NULL = all) */
+    uint32_t iterations;           /* Iteration override (0 = per scenario) */
+    bool use_gpu;                  /* Create a headless GPU device */
+} NexusBenchOptions;
+
+/**
+ * Sort helper for iteration times
+ */
+static int nexus_bench_compare_times(const void* a, const void* b) {
+    double ta = *(const double*)a;
+    double tb = *(const double*)b;
+    return (ta > tb) - (ta < tb);
+}
+
+/**
+ * Run one scenario: setup, warmup, timed iterations, teardown
+ */
+static NexusBenchResult nexus_bench_run_scenario(const NexusBenchScenario* scenario, const NexusBenchContext* context,
+                                                 uint32_t iterations) {
+    NexusBenchResult result;
+    memset(&result, 0, sizeof(NexusBenchResult));
+    result.name = scenario->name;
+    result.skipped = true;
+
+    if (scenario->needs_gpu && context->device == NULL) {
+        return result;
+    }
+
+    if (iterations == 0) {
+        iterations = scenario->iterations > 0 ? scenario->iterations : NEXUS_BENCH_DEFAULT_ITERATIONS;
+    }
+
+    double* times = (double*)malloc(sizeof(double) * iterations);
+    if (times == NULL) {
+        fprintf(stderr, "Failed to allocate memory for benchmark timings!\n");
+        return result;
+    }
+
+    void* state = scenario->setup(context, scenario->param);
+    if (state == NULL) {
+        fprintf(stderr, "Failed to set up benchmark %s!\n", scenario->name);
+        free(times);
+        return result;
+    }
+
+    /* Warmup runs fill caches and grow buffers to their steady size */
+    for (uint32_t i = 0; i < NEXUS_BENCH_DEFAULT_WARMUP; i++) {
+        scenario->run(state);
+    }
+
+    double to_ms = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    for (uint32_t i = 0; i < iterations; i++) {
+        uint64_t start = SDL_GetPerformanceCounter();
+        scenario->run(state);
+        times[i] = (double)(SDL_GetPerformanceCounter() - start) * to_ms;
+    }
+
+    scenario->teardown(state);
+
+    /* Percentiles of the sorted iteration times */
+    qsort(times, iterations, sizeof(double), nexus_bench_compare_times);
+    double sum = 0.0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        sum += times[i];
+    }
+    uint32_t p99_index = (uint32_t)(0.99 * (double)iterations + 0.999999);
+    p99_index = p99_index > 0 ? p99_index - 1 : 0;
+
+    result.skipped = false;
+    result.iterations = iterations;
+    result.median = (iterations % 2) != 0 ? times[iterations / 2] :
+                    0.5 * (times[iterations / 2 - 1] + times[iterations / 2]);
+    result.p99 = times[p99_index];
+    result.min = times[0];
+    result.mean = sum / (double)iterations;
+
+    free(times);
+    return result;
+}
+
+/**
+ * Write the results as JSON, one scenario per line so baselines diff cleanly
+ */
+static bool nexus_bench_write_report(const char* filepath, const NexusBenchResult* results, uint32_t count) {
+    FILE* file = fopen(filepath, "w");
+    if (file == NULL) {
+        fprintf(stderr, "Failed to open benchmark report for writing: %s\n", filepath);
+        return false;
+    }
+
+    fprintf(file, "{\n  \"scenarios\": [\n");
+    for (uint32_t i = 0; i < count; i++) {
+        const NexusBenchResult* result = &results[i];
+        if (result->skipped) {
+            fprintf(file, "    {\"name\": \"%s\", \"skipped\": true}", result->name);
+        } else {
+            fprintf(file, "    {\"name\": \"%s\", \"iterations\": %u, \"median_ms\": %.6f, \"p99_ms\": %.6f, "
+                    "\"min_ms\": %.6f, \"mean_ms\": %.6f}",
+                    result->name, result->iterations, result->median, result->p99, result->min, result->mean);
+        }
+        fprintf(file, "%s\n", i + 1 < count ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+
+    fclose(file);
+    return true;
+}
+
+/**
+ * Look up a scenario's median in a report written by nexus_bench_write_report
+ * @return false if the report has no timings for the scenario
+ */
+static bool nexus_bench_find_baseline(const char* report, const char* name, double* median) {
+    char key[160];
+    snprintf(key, sizeof(key), "\"name\": \"%s\",", name);
+
+    const char* entry = strstr(report, key);
+    if (entry == NULL) {
+        return false;
+    }
+
+    /* The median has to be on the scenario's own line */
+    const char* line_end = strchr(entry, '\n');
+    const char* value = strstr(entry, "\"median_ms\": ");
+    if (value == NULL || (line_end != NULL && value > line_end)) {
+        return false;
+    }
+
+    return sscanf(value + strlen("\"median_ms\": "), "%lf", median) == 1;
+}
+
+/**
+ * Compare medians against a baseline report
+ * @return Number of scenarios that regressed
+ */
+static uint32_t nexus_bench_compare_baseline(const char* filepath, const NexusBenchResult* results, uint32_t count,
+                                             double threshold) {
+    FILE* file = fopen(filepath, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Failed to open benchmark baseline: %s\n", filepath);
+        return 0;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* report = (char*)malloc(size > 0 ? (size_t)size + 1 : 1);
+    if (report == NULL) {
+        fprintf(stderr, "Failed to allocate memory for benchmark baseline!\n");
+        fclose(file);
+        return 0;
+    }
+    size_t read = size > 0 ? fread(report, 1, (size_t)size, file) : 0;
+    report[read] = '\0';
+    fclose(file);
+
+    printf("\nBaseline %s (threshold %.1f%%)\n", filepath, threshold);
+    uint32_t regressions = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        double baseline;
+        if (results[i].skipped || !nexus_bench_find_baseline(report, results[i].name, &baseline) || baseline <= 0.0) {
+            continue;
+        }
+
+        double change = (results[i].median - baseline) / baseline * 100.0;
+        bool regressed = change > threshold;
+        printf("  %-36s %10.4f ms -> %10.4f ms  %+7.1f%%%s\n", results[i].name, baseline, results[i].median,
+               change, regressed ? "  REGRESSION" : "");
+        if (regressed) {
+            regressions++;
+        }
+    }
+
+    free(report);
+    return regressions;
+}
+
+/**
+ * Parse the command line
+ */
+static bool nexus_bench_parse_options(int argc, char* argv[], NexusBenchOptions* options) {
+    options->output = "bench_results.json";
+    options->baseline = NULL;
+    options->threshold = NEXUS_BENCH_DEFAULT_THRESHOLD;
+    options->filter = NULL;
+    options->iterations = 0;
+    options->use_gpu = true;
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--output") == 0 && has_value) {
+            options->output = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && has_value) {
+            options->baseline = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && has_value) {
+            options->threshold = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && has_value) {
+            options->filter = argv[++i];
+        } else if (strcmp(argv[i], "--iterations") == 0 && has_value) {
+            options->iterations = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--no-gpu") == 0) {
+            options->use_gpu = false;
+        } else {
+            fprintf(stderr, "Unknown benchmark option: %s\n", argv[i]);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    NexusBenchOptions options;
+    if (!nexus_bench_parse_options(argc, argv, &options)) {
+        fprintf(stderr, "Usage: %s [--output file] [--baseline file] [--threshold percent] "
+                "[--filter text] [--iterations count] [--no-gpu]\n", argv[0]);
+        return 2;
+    }
+
+    if (!SDL_Init(0)) {
+        fprintf(stderr, "Failed to initialize SDL: %s\n", SDL_GetError());
+        return 2;
+    }
+    nexus_memory_init(4096 * 1024, 1024 * 1024);
+
+    /* A device without a window renders nothing, GPU scenarios only need copies */
+    NexusBenchContext context;
+    memset(&context, 0, sizeof(NexusBenchContext));
+    NexusUploadManager* upload_manager = NULL;
+    if (options.use_gpu) {
+        context.device = SDL_CreateGPUDevice(SDL_GPU_SHADERFORMAT_SPIRV | SDL_GPU_SHADERFORMAT_DXBC |
+                                             SDL_GPU_SHADERFORMAT_MSL, false, NULL);
+        if (context.device == NULL) {
+            printf("No headless GPU device (%s), GPU scenarios are skipped\n", SDL_GetError());
+        } else {
+            upload_manager = nexus_upload_manager_create(context.device, NEXUS_UPLOAD_RING_SIZE);
+        }
+    }
+    context.jobs = nexus_jobs_create(-1);
+
+    /* Run the scenario groups in a fixed order */
+    const NexusBenchScenario* (*groups[])(uint32_t*) = {
+        nexus_bench_ecs_scenarios,
+        nexus_bench_physics_scenarios,
+        nexus_bench_renderer_scenarios
+    };
+    NexusBenchResult results[NEXUS_BENCH_MAX_RESULTS];
+    uint32_t result_count = 0;
+
+    printf("%-36s %10s %12s %12s %12s\n", "scenario", "iterations", "median ms", "p99 ms", "min ms");
+    for (size_t g = 0; g < sizeof(groups) / sizeof(groups[0]); g++) {
+        uint32_t count = 0;
+        const NexusBenchScenario* scenarios = groups[g](&count);
+        for (uint32_t i = 0; i < count && result_count < NEXUS_BENCH_MAX_RESULTS; i++) {
+            if (options.filter != NULL && strstr(scenarios[i].name, options.filter) == NULL) {
+                continue;
+            }
+
+            NexusBenchResult* result = &results[result_count++];
+            *result = nexus_bench_run_scenario(&scenarios[i], &context, options.iterations);
+            if (result->skipped) {
+                printf("%-36s %10s\n", result->name, "skipped");
+            } else {
+                printf("%-36s %10u %12.4f %12.4f %12.4f\n", result->name, result->iterations,
+                       result->median, result->p99, result->min);
+            }
+        }
+    }
+
+    int status = nexus_bench_write_report(options.output, results, result_count) ? 0 : 2;
+    if (status == 0) {
+        printf("\nResults written to %s\n", options.output);
+    }
+
+    if (options.baseline != NULL) {
+        uint32_t regressions = nexus_bench_compare_baseline(options.baseline, results, result_count,
+                                                            options.threshold);
+        if (regressions > 0) {
+            printf("%u scenario(s) regressed\n", regressions);
+            status = 1;
+        }
+    }
+
+    nexus_jobs_destroy(context.jobs);
+    if (context.device != NULL) {
+        nexus_upload_manager_destroy(upload_manager);
+        SDL_DestroyGPUDevice(context.device);
+    }
+    nexus_memory_shutdown();
+    SDL_Quit();
+    return status;
+}
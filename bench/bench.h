@@ -0,0 +1,84 @@
+/**
+ * Nexus3D Benchmarks
+ * Headless, reproducible scenarios timed after a warmup, reported as JSON
+ * and compared against a saved baseline to catch performance regressions
+ */
+
+#ifndef NEXUS3D_BENCH_H
+#define NEXUS3D_BENCH_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "nexus3d/core/jobs.h"
+
+/* Default run length of a scenario */
+#define NEXUS_BENCH_DEFAULT_WARMUP     5
+#define NEXUS_BENCH_DEFAULT_ITERATIONS 50
+
+/* Median slowdown in percent that counts as a regression */
+#define NEXUS_BENCH_DEFAULT_THRESHOLD  10.0
+
+/* Seed every scenario starts from, runs are identical across machines */
+#define NEXUS_BENCH_SEED 0x9E3779B9u
+
+/**
+ * Shared state scenarios are set up with
+ */
+typedef struct {
+    SDL_GPUDevice* device;         /* Headless GPU device (NULL = GPU scenarios are skipped) */
+    NexusJobSystem* jobs;          /* Job system for parallel scenarios */
+} NexusBenchContext;
+
+/**
+ * Benchmark scenario
+ * setup builds the scenario's state outside the timing, run is timed once per iteration
+ */
+typedef struct {
+    const char* name;              /* Scenario name in reports and baselines */
+    uint32_t param;                /* Size argument passed to setup */
+    uint32_t iterations;           /* Timed iterations (0 = NEXUS_BENCH_DEFAULT_ITERATIONS) */
+    bool needs_gpu;                /* Skipped without a GPU device */
+    void* (*setup)(const NexusBenchContext* context, uint32_t param);
+    void (*run)(void* state);
+    void (*teardown)(void* state);
+} NexusBenchScenario;
+
+/**
+ * Timings of a scenario in milliseconds
+ */
+typedef struct {
+    const char* name;              /* Scenario name */
+    uint32_t iterations;           /* Timed iterations */
+    bool skipped;                  /* Setup failed or a requirement is missing */
+    double median;                 /* Median iteration time */
+    double p99;                    /* 99th percentile iteration time */
+    double min;                    /* Fastest iteration */
+    double mean;                   /* Mean iteration time */
+} NexusBenchResult;
+
+/* Scenario tables of the benchmark groups */
+const NexusBenchScenario* nexus_bench_ecs_scenarios(uint32_t* count);
+const NexusBenchScenario* nexus_bench_physics_scenarios(uint32_t* count);
+const NexusBenchScenario* nexus_bench_renderer_scenarios(uint32_t* count);
+
+/**
+ * Deterministic random number (xorshift32)
+ */
+static inline uint32_t nexus_bench_random(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * Deterministic random float in [min, max)
+ */
+static inline float nexus_bench_random_range(uint32_t* state, float min, float max) {
+    return min + (max - min) * (float)(nexus_bench_random(state) >> 8) * (1.0f / 16777216.0f);
+}
+
+#endif /* NEXUS3D_BENCH_H */
@@ -0,0 +1,117 @@
+/**
+ * Nexus3D ECS Benchmarks
+ * Transform and hierarchy systems over entity chains with moving roots
+ */
+
+#include "bench.h"
+#include "nexus3d/ecs/components.h"
+#include "nexus3d/ecs/systems.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Entities per parent chain, the first of each chain is a root */
+#define NEXUS_BENCH_CHAIN_LENGTH 4
+
+/**
+ * Transform scenario state
+ */
+typedef struct {
+    ecs_world_t* world;            /* World running the registered systems */
+    ecs_entity_t* roots;           /* Chain roots moved every iteration */
+    uint32_t root_count;           /* Number of roots */
+    uint32_t frame;                /* Iterations run */
+} NexusBenchTransformState;
+
+/**
+ * Build chains of entities parented with EcsChildOf
+ */
+static void* nexus_bench_transform_setup(const NexusBenchContext* context, uint32_t entity_count) {
+    (void)context;
+
+    NexusBenchTransformState* state = (NexusBenchTransformState*)malloc(sizeof(NexusBenchTransformState));
+    if (state == NULL) {
+        return NULL;
+    }
+    memset(state, 0, sizeof(NexusBenchTransformState));
+
+    state->world = ecs_init();
+    state->root_count = (entity_count + NEXUS_BENCH_CHAIN_LENGTH - 1) / NEXUS_BENCH_CHAIN_LENGTH;
+    state->roots = (ecs_entity_t*)malloc(sizeof(ecs_entity_t) * state->root_count);
+    if (state->world == NULL || state->roots == NULL) {
+        if (state->world != NULL) {
+            ecs_fini(state->world);
+        }
+        free(state->roots);
+        free(state);
+        return NULL;
+    }
+
+    nexus_ecs_register_components(state->world);
+    nexus_ecs_register_systems(state->world);
+
+    uint32_t seed = NEXUS_BENCH_SEED;
+    ecs_entity_t parent = 0;
+    for (uint32_t i = 0; i < entity_count; i++) {
+        ecs_entity_t entity = ecs_new(state->world);
+        ecs_set(state->world, entity, NexusPositionComponent, {{
+            nexus_bench_random_range(&seed, -100.0f, 100.0f),
+            nexus_bench_random_range(&seed, -100.0f, 100.0f),
+            nexus_bench_random_range(&seed, -100.0f, 100.0f)
+        }});
+        ecs_set(state->world, entity, NexusRotationComponent, {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}});
+        ecs_set(state->world, entity, NexusScaleComponent, {{1.0f, 1.0f, 1.0f}});
+        ecs_add(state->world, entity, NexusTransformComponent);
+
+        if (i % NEXUS_BENCH_CHAIN_LENGTH == 0) {
+            state->roots[i / NEXUS_BENCH_CHAIN_LENGTH] = entity;
+        } else {
+            ecs_add_pair(state->world, entity, EcsChildOf, parent);
+        }
+        parent = entity;
+    }
+
+    return state;
+}
+
+/**
+ * Move every root and run one frame of the pipeline
+ */
+static void nexus_bench_transform_run(void* data) {
+    NexusBenchTransformState* state = (NexusBenchTransformState*)data;
+    float offset = (state->frame++ % 2) == 0 ? 0.01f : -0.01f;
+
+    for (uint32_t i = 0; i < state->root_count; i++) {
+        NexusPositionComponent* position = ecs_get_mut(state->world, state->roots[i], NexusPositionComponent);
+        position->value[0] += offset;
+        ecs_modified(state->world, state->roots[i], NexusPositionComponent);
+    }
+
+    ecs_progress(state->world, 1.0f / 60.0f);
+}
+
+/**
+ * Release the transform scenario
+ */
+static void nexus_bench_transform_teardown(void* data) {
+    NexusBenchTransformState* state = (NexusBenchTransformState*)data;
+    ecs_fini(state->world);
+    free(state->roots);
+    free(state);
+}
+
+/* ECS scenarios */
+static const NexusBenchScenario s_ecs_scenarios[] = {
+    { "ecs_transform_hierarchy_10k", 10000, 0, false,
+      nexus_bench_transform_setup, nexus_bench_transform_run, nexus_bench_transform_teardown },
+    { "ecs_transform_hierarchy_100k", 100000, 20, false,
+      nexus_bench_transform_setup, nexus_bench_transform_run, nexus_bench_transform_teardown }
+};
+
+/**
+ * Get the ECS scenarios
+ */
+const NexusBenchScenario* nexus_bench_ecs_scenarios(uint32_t* count) {
+    *count = (uint32_t)(sizeof(s_ecs_scenarios) / sizeof(s_ecs_scenarios[0]));
+    return s_ecs_scenarios;
+}
@@ -0,0 +1,227 @@
+/**
+ * Nexus3D Physics Benchmarks
+ * Broadphase updates at growing proxy counts and batched raycasts
+ */
+
+#include "bench.h"
+#include "nexus3d/ecs/components.h"
+#include "nexus3d/physics/broadphase.h"
+#include "nexus3d/physics/physics.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Fraction of proxies moved per broadphase iteration */
+#define NEXUS_BENCH_MOVED_FRACTION 10
+
+/* Rays of one batched raycast */
+#define NEXUS_BENCH_RAY_COUNT 10000
+
+/**
+ * Broadphase scenario state
+ */
+typedef struct {
+    NexusBroadphase* broadphase;   /* Tree under test */
+    int32_t* proxies;              /* Proxy of every box */
+    vec3* centers;                 /* Box centers */
+    float* extents;                /* Box half sizes */
+    uint32_t count;                /* Number of boxes */
+    uint32_t next;                 /* First box moved by the next iteration */
+    uint32_t seed;                 /* Motion random state */
+} NexusBenchBroadphaseState;
+
+/**
+ * Scatter boxes at a constant density, so pairs per box stay comparable across sizes
+ */
+static void* nexus_bench_broadphase_setup(const NexusBenchContext* context, uint32_t count) {
+    (void)context;
+
+    NexusBenchBroadphaseState* state = (NexusBenchBroadphaseState*)malloc(sizeof(NexusBenchBroadphaseState));
+    if (state == NULL) {
+        return NULL;
+    }
+    memset(state, 0, sizeof(NexusBenchBroadphaseState));
+
+    state->broadphase = nexus_broadphase_create();
+    state->proxies = (int32_t*)malloc(sizeof(int32_t) * count);
+    state->centers = (vec3*)malloc(sizeof(vec3) * count);
+    state->extents = (float*)malloc(sizeof(float) * count);
+    if (state->broadphase == NULL || state->proxies == NULL || state->centers == NULL || state->extents == NULL) {
+        nexus_broadphase_destroy(state->broadphase);
+        free(state->proxies);
+        free(state->centers);
+        free(state->extents);
+        free(state);
+        return NULL;
+    }
+
+    state->count = count;
+    state->seed = NEXUS_BENCH_SEED;
+    float half_world = 2.0f * cbrtf((float)count);
+    for (uint32_t i = 0; i < count; i++) {
+        for (int axis = 0; axis < 3; axis++) {
+            state->centers[i][axis] = nexus_bench_random_range(&state->seed, -half_world, half_world);
+        }
+        state->extents[i] = nexus_bench_random_range(&state->seed, 0.25f, 0.75f);
+
+        vec3 min, max;
+        glm_vec3_subs(state->centers[i], state->extents[i], min);
+        glm_vec3_adds(state->centers[i], state->extents[i], max);
+        state->proxies[i] = nexus_broadphase_create_proxy(state->broadphase, min, max, (ecs_entity_t)(i + 1));
+    }
+    nexus_broadphase_update_pairs(state->broadphase);
+
+    return state;
+}
+
+/**
+ * Move a rotating subset of the boxes past the fat margin and update the pairs
+ */
+static void nexus_bench_broadphase_run(void* data) {
+    NexusBenchBroadphaseState* state = (NexusBenchBroadphaseState*)data;
+    uint32_t moved = state->count / NEXUS_BENCH_MOVED_FRACTION;
+
+    for (uint32_t m = 0; m < moved; m++) {
+        uint32_t i = (state->next + m) % state->count;
+        for (int axis = 0; axis < 3; axis++) {
+            state->centers[i][axis] += nexus_bench_random_range(&state->seed, -0.3f, 0.3f);
+        }
+
+        vec3 min, max;
+        glm_vec3_subs(state->centers[i], state->extents[i], min);
+        glm_vec3_adds(state->centers[i], state->extents[i], max);
+        nexus_broadphase_move_proxy(state->broadphase, state->proxies[i], min, max);
+    }
+    state->next = (state->next + moved) % state->count;
+
+    nexus_broadphase_update_pairs(state->broadphase);
+}
+
+/**
+ * Release the broadphase scenario
+ */
+static void nexus_bench_broadphase_teardown(void* data) {
+    NexusBenchBroadphaseState* state = (NexusBenchBroadphaseState*)data;
+    nexus_broadphase_destroy(state->broadphase);
+    free(state->proxies);
+    free(state->centers);
+    free(state->extents);
+    free(state);
+}
+
+/**
+ * Raycast scenario state
+ */
+typedef struct {
+    ecs_world_t* world;            /* World holding the colliders */
+    NexusPhysics* physics;         /* Physics system casting the rays */
+    NexusPhysicsRay* rays;         /* Rays of the batch */
+    NexusPhysicsRayHit* hits;      /* Closest hits of the batch */
+} NexusBenchRaycastState;
+
+/**
+ * Scatter sphere and box colliders and aim rays through the field
+ */
+static void* nexus_bench_raycast_setup(const NexusBenchContext* context, uint32_t collider_count) {
+    NexusBenchRaycastState* state = (NexusBenchRaycastState*)malloc(sizeof(NexusBenchRaycastState));
+    if (state == NULL) {
+        return NULL;
+    }
+    memset(state, 0, sizeof(NexusBenchRaycastState));
+
+    state->world = ecs_init();
+    state->rays = (NexusPhysicsRay*)malloc(sizeof(NexusPhysicsRay) * NEXUS_BENCH_RAY_COUNT);
+    state->hits = (NexusPhysicsRayHit*)malloc(sizeof(NexusPhysicsRayHit) * NEXUS_BENCH_RAY_COUNT);
+    if (state->world != NULL) {
+        nexus_ecs_register_components(state->world);
+        state->physics = nexus_physics_create(state->world);
+    }
+    if (state->physics == NULL || state->rays == NULL || state->hits == NULL) {
+        nexus_physics_destroy(state->physics);
+        if (state->world != NULL) {
+            ecs_fini(state->world);
+        }
+        free(state->rays);
+        free(state->hits);
+        free(state);
+        return NULL;
+    }
+    nexus_physics_set_job_system(state->physics, context->jobs);
+
+    uint32_t seed = NEXUS_BENCH_SEED;
+    float half_world = 2.0f * cbrtf((float)collider_count);
+    for (uint32_t i = 0; i < collider_count; i++) {
+        NexusColliderComponent collider;
+        memset(&collider, 0, sizeof(NexusColliderComponent));
+        if ((i % 2) == 0) {
+            collider.shape.type = NEXUS_COLLISION_SHAPE_SPHERE;
+            collider.shape.data.sphere.radius = nexus_bench_random_range(&seed, 0.25f, 0.75f);
+        } else {
+            collider.shape.type = NEXUS_COLLISION_SHAPE_BOX;
+            glm_vec3_fill(collider.shape.data.box.half_extents, nexus_bench_random_range(&seed, 0.25f, 0.75f));
+        }
+
+        ecs_entity_t entity = ecs_new(state->world);
+        ecs_set(state->world, entity, NexusPositionComponent, {{
+            nexus_bench_random_range(&seed, -half_world, half_world),
+            nexus_bench_random_range(&seed, -half_world, half_world),
+            nexus_bench_random_range(&seed, -half_world, half_world)
+        }});
+        ecs_set_id(state->world, entity, ecs_id(NexusColliderComponent), sizeof(NexusColliderComponent), &collider);
+    }
+
+    /* Inserts every collider into the broadphase */
+    nexus_physics_detect_collisions(state->physics);
+
+    for (uint32_t i = 0; i < NEXUS_BENCH_RAY_COUNT; i++) {
+        NexusPhysicsRay* ray = &state->rays[i];
+        for (int axis = 0; axis < 3; axis++) {
+            ray->origin[axis] = nexus_bench_random_range(&seed, -half_world, half_world);
+            ray->direction[axis] = nexus_bench_random_range(&seed, -1.0f, 1.0f);
+        }
+        ray->max_distance = half_world;
+    }
+
+    return state;
+}
+
+/**
+ * Cast the whole batch
+ */
+static void nexus_bench_raycast_run(void* data) {
+    NexusBenchRaycastState* state = (NexusBenchRaycastState*)data;
+    nexus_physics_raycast_batch(state->physics, state->rays, state->hits, NEXUS_BENCH_RAY_COUNT);
+}
+
+/**
+ * Release the raycast scenario
+ */
+static void nexus_bench_raycast_teardown(void* data) {
+    NexusBenchRaycastState* state = (NexusBenchRaycastState*)data;
+    nexus_physics_destroy(state->physics);
+    ecs_fini(state->world);
+    free(state->rays);
+    free(state->hits);
+    free(state);
+}
+
+/* Physics scenarios */
+static const NexusBenchScenario s_physics_scenarios[] = {
+    { "broadphase_update_1k", 1000, 0, false,
+      nexus_bench_broadphase_setup, nexus_bench_broadphase_run, nexus_bench_broadphase_teardown },
+    { "broadphase_update_10k", 10000, 0, false,
+      nexus_bench_broadphase_setup, nexus_bench_broadphase_run, nexus_bench_broadphase_teardown },
+    { "broadphase_update_100k", 100000, 20, false,
+      nexus_bench_broadphase_setup, nexus_bench_broadphase_run, nexus_bench_broadphase_teardown },
+    { "raycast_batch_10k_rays_10k_colliders", 10000, 0, false,
+      nexus_bench_raycast_setup, nexus_bench_raycast_run, nexus_bench_raycast_teardown }
+};
+
+/**
+ * Get the physics scenarios
+ */
+const NexusBenchScenario* nexus_bench_physics_scenarios(uint32_t* count) {
+    *count = (uint32_t)(sizeof(s_physics_scenarios) / sizeof(s_physics_scenarios[0]));
+    return s_physics_scenarios;
+}
@@ -0,0 +1,172 @@
+/**
+ * Nexus3D Renderer Benchmarks
+ * Draw submission and sorting through the render queue, and procedural mesh
+ * generation uploaded through the shared staging ring
+ */
+
+#include "bench.h"
+#include <cglm/cglm.h>
+#include "nexus3d/renderer/mesh.h"
+#include "nexus3d/renderer/material.h"
+#include "nexus3d/renderer/render_queue.h"
+#include "nexus3d/renderer/upload.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Distinct meshes and materials draws are spread over */
+#define NEXUS_BENCH_MESH_COUNT     64
+#define NEXUS_BENCH_MATERIAL_COUNT 16
+
+/**
+ * Submission scenario state
+ * Meshes, materials and pipelines only serve as sort keys, none of them is
+ * backed by GPU objects, so the scenario runs without a device
+ */
+typedef struct {
+    NexusRenderQueue* queue;       /* Queue under test */
+    NexusMesh meshes[NEXUS_BENCH_MESH_COUNT]; /* Key-only meshes */
+    NexusMaterial materials[NEXUS_BENCH_MATERIAL_COUNT]; /* Key-only materials (a quarter blended) */
+    char pipelines[4];             /* Addresses used as pipeline keys */
+    char shader;                   /* Address used as the shader */
+    mat4* transforms;              /* Draw transforms */
+    float* depths;                 /* Normalized draw depths */
+    uint32_t count;                /* Draws per iteration */
+} NexusBenchSubmitState;
+
+/**
+ * Build the draws of one frame
+ */
+static void* nexus_bench_submit_setup(const NexusBenchContext* context, uint32_t draw_count) {
+    (void)context;
+
+    NexusBenchSubmitState* state = (NexusBenchSubmitState*)malloc(sizeof(NexusBenchSubmitState));
+    if (state == NULL) {
+        return NULL;
+    }
+    memset(state, 0, sizeof(NexusBenchSubmitState));
+
+    state->queue = nexus_render_queue_create(draw_count);
+    state->transforms = (mat4*)malloc(sizeof(mat4) * draw_count);
+    state->depths = (float*)malloc(sizeof(float) * draw_count);
+    if (state->queue == NULL || state->transforms == NULL || state->depths == NULL) {
+        nexus_render_queue_destroy(state->queue);
+        free(state->transforms);
+        free(state->depths);
+        free(state);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < NEXUS_BENCH_MATERIAL_COUNT; i++) {
+        state->materials[i].blend_mode = (i % 4) == 3 ? NEXUS_BLEND_MODE_ALPHA : NEXUS_BLEND_MODE_OPAQUE;
+    }
+
+    uint32_t seed = NEXUS_BENCH_SEED;
+    state->count = draw_count;
+    for (uint32_t i = 0; i < draw_count; i++) {
+        vec3 position = {
+            nexus_bench_random_range(&seed, -100.0f, 100.0f),
+            nexus_bench_random_range(&seed, -100.0f, 100.0f),
+            nexus_bench_random_range(&seed, -100.0f, 100.0f)
+        };
+        glm_translate_make(state->transforms[i], position);
+        state->depths[i] = nexus_bench_random_range(&seed, 0.0f, 1.0f);
+    }
+
+    return state;
+}
+
+/**
+ * Submit and sort one frame of draws
+ */
+static void nexus_bench_submit_run(void* data) {
+    NexusBenchSubmitState* state = (NexusBenchSubmitState*)data;
+
+    nexus_render_queue_reset(state->queue);
+    for (uint32_t i = 0; i < state->count; i++) {
+        nexus_render_queue_submit(state->queue,
+                                  &state->meshes[(i * 7) % NEXUS_BENCH_MESH_COUNT], 0,
+                                  &state->materials[(i * 13) % NEXUS_BENCH_MATERIAL_COUNT],
+                                  (NexusShader*)&state->shader,
+                                  (SDL_GPUGraphicsPipeline*)&state->pipelines[i % 4],
+                                  (const float*)state->transforms[i], state->depths[i]);
+    }
+    nexus_render_queue_sort(state->queue);
+}
+
+/**
+ * Release the submission scenario
+ */
+static void nexus_bench_submit_teardown(void* data) {
+    NexusBenchSubmitState* state = (NexusBenchSubmitState*)data;
+    nexus_render_queue_destroy(state->queue);
+    free(state->transforms);
+    free(state->depths);
+    free(state);
+}
+
+/**
+ * Mesh scenario state
+ */
+typedef struct {
+    SDL_GPUDevice* device;         /* Headless device the meshes are created on */
+    NexusUploadManager* uploader;  /* Staging ring of the device */
+    uint32_t segments;             /* Sphere rings and sectors */
+} NexusBenchMeshState;
+
+/**
+ * Meshes upload through the device's staging ring, as they do in the engine
+ */
+static void* nexus_bench_mesh_setup(const NexusBenchContext* context, uint32_t segments) {
+    NexusUploadManager* uploader = nexus_upload_manager_get(context->device);
+    if (uploader == NULL) {
+        return NULL;
+    }
+
+    NexusBenchMeshState* state = (NexusBenchMeshState*)malloc(sizeof(NexusBenchMeshState));
+    if (state == NULL) {
+        return NULL;
+    }
+
+    state->device = context->device;
+    state->uploader = uploader;
+    state->segments = segments;
+    return state;
+}
+
+/**
+ * Generate a sphere, wait for its upload to execute and release it
+ */
+static void nexus_bench_mesh_run(void* data) {
+    NexusBenchMeshState* state = (NexusBenchMeshState*)data;
+
+    NexusMesh* mesh = nexus_mesh_create_sphere(state->device, 1.0f, state->segments, state->segments);
+    nexus_upload_manager_flush(state->uploader);
+    nexus_upload_manager_wait_idle(state->uploader);
+    nexus_mesh_destroy(mesh);
+}
+
+/**
+ * Release the mesh scenario
+ */
+static void nexus_bench_mesh_teardown(void* data) {
+    free(data);
+}
+
+/* Renderer scenarios */
+static const NexusBenchScenario s_renderer_scenarios[] = {
+    { "render_queue_submit_sort_10k", 10000, 0, false,
+      nexus_bench_submit_setup, nexus_bench_submit_run, nexus_bench_submit_teardown },
+    { "render_queue_submit_sort_100k", 100000, 20, false,
+      nexus_bench_submit_setup, nexus_bench_submit_run, nexus_bench_submit_teardown },
+    { "mesh_sphere_generate_upload_128", 128, 0, true,
+      nexus_bench_mesh_setup, nexus_bench_mesh_run, nexus_bench_mesh_teardown }
+};
+
+/**
+ * Get the renderer scenarios
+ */
+const NexusBenchScenario* nexus_bench_renderer_scenarios(uint32_t* count) {
+    *count = (uint32_t)(sizeof(s_renderer_scenarios) / sizeof(s_renderer_scenarios[0]));
+    return s_renderer_scenarios;
+}
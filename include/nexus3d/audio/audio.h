@@ -1,6 +1,11 @@
 /**
  * Nexus3D Audio System
- * Handles audio playback using SDL3 audio
+ * Handles audio playback using SDL3 audio. Voices are mixed in software on
+ * the audio stream's thread: sounds are converted to float at the mix rate
+ * once when loaded, voices out of hearing range are culled, and when more
+ * voices are audible than config.max_channels the least important ones
+ * play on silently (virtual) until a channel frees up. Long sounds play
+ * from sound streams instead, decoded on jobs into a bounded ring
  */
 
 #ifndef NEXUS3D_AUDIO_H
@@ -10,27 +15,33 @@
 #include <stdbool.h>
 #include <cglm/cglm.h>
 #include "../core/config.h"
+#include "nexus3d/audio/mixer.h"
+#include "nexus3d/audio/sound_stream.h"
 
-/* Maximum number of sound sources */
-#define NEXUS_MAX_SOUND_SOURCES 128
+/* Maximum number of sound sources (voice pool size, mixed or not) */
+#define NEXUS_MAX_SOUND_SOURCES 512
 
-/**
- * Audio format enumeration
- */
-typedef enum {
-    NEXUS_AUDIO_FORMAT_UNKNOWN,
-    NEXUS_AUDIO_FORMAT_WAV,
-    NEXUS_AUDIO_FORMAT_OGG,
-    NEXUS_AUDIO_FORMAT_MP3
-} NexusAudioFormat;
+/* Mix format: interleaved float stereo, the rate follows the playback device */
+#define NEXUS_AUDIO_MIX_CHANNELS 2
+#define NEXUS_AUDIO_DEFAULT_MIX_RATE 48000
+
+/* Frames mixed per block, gains and voice selection are updated per block */
+#define NEXUS_AUDIO_MIX_BLOCK 512
+
+/* Combined gain below which a voice counts as inaudible */
+#define NEXUS_AUDIO_SILENCE_GAIN 1e-4f
+
+/* Priority of new voices, higher priorities are mixed and kept first */
+#define NEXUS_AUDIO_DEFAULT_PRIORITY 128
 
 /**
  * Sound structure
  */
 typedef struct {
-    Uint8* buffer;           /* Sound data buffer */
+    Uint8* buffer;           /* Sound data buffer (float samples, converted at load) */
     Uint32 length;           /* Buffer length in bytes */
-    SDL_AudioSpec spec;      /* Audio specification */
+    Uint32 frame_count;      /* Length in frames */
+    SDL_AudioSpec spec;      /* Audio specification (F32, 1 or 2 channels) */
     char name[64];           /* Sound name */
 } NexusSound;
 
@@ -38,21 +49,56 @@ typedef struct {
  * Sound source structure
  */
 typedef struct {
-    NexusSound* sound;       /* Sound data */
-    bool is_playing;         /* Playing flag */
+    NexusSound* sound;       /* Sound data (NULL for streamed voices) */
+    NexusSoundStream* stream; /* Streamed sound data (NULL for resident voices) */
+    bool is_playing;         /* Playing flag (the voice is allocated) */
+    bool is_paused;          /* Paused flag */
     bool is_looping;         /* Looping flag */
     float volume;            /* Volume [0.0, 1.0] */
     float pitch;             /* Pitch multiplier */
     float pan;               /* Panning [-1.0 (left) to 1.0 (right)] */
-    Uint32 position;         /* Current play position in bytes */
+    Uint32 position;         /* Current play position in frames */
+    double fraction;         /* Sub-frame play position of resampled voices */
     bool is_3d;              /* 3D positioning flag */
     vec3 position3d;         /* 3D position */
     float min_distance;      /* Minimum distance for 3D attenuation */
     float max_distance;      /* Maximum distance for 3D attenuation */
     float attenuation;       /* Attenuation factor */
-    Uint32 id;               /* Source ID */
+    int priority;            /* Stealing and mixing priority (higher = more important) */
+    float gain_left;         /* Left gain reached by the last mixed block */
+    float gain_right;        /* Right gain reached by the last mixed block */
+    float audibility;        /* Combined gain of the last block (0 = culled) */
+    bool was_mixed;          /* Mixed in the last block, gains ramp from gain_left/right */
+    Uint32 id;               /* Source ID (0 = free) */
 } NexusSoundSource;
 
+/**
+ * Per-block voice batch, gain stage inputs and outputs of the playing voices
+ */
+typedef struct {
+    float x[NEXUS_MAX_SOUND_SOURCES];
+    float y[NEXUS_MAX_SOUND_SOURCES];
+    float z[NEXUS_MAX_SOUND_SOURCES];
+    float min_distance[NEXUS_MAX_SOUND_SOURCES];
+    float max_distance[NEXUS_MAX_SOUND_SOURCES];
+    float rolloff[NEXUS_MAX_SOUND_SOURCES];
+    float volume[NEXUS_MAX_SOUND_SOURCES];
+    float pan[NEXUS_MAX_SOUND_SOURCES];
+    float spatial[NEXUS_MAX_SOUND_SOURCES];
+    float gain_left[NEXUS_MAX_SOUND_SOURCES];
+    float gain_right[NEXUS_MAX_SOUND_SOURCES];
+    Uint16 source[NEXUS_MAX_SOUND_SOURCES]; /* Source index of each entry */
+} NexusAudioVoiceBatch;
+
+/**
+ * Audible voice competing for a mixed channel
+ */
+typedef struct {
+    Uint32 entry;            /* Batch entry */
+    int priority;            /* Source priority */
+    float audibility;        /* Combined gain */
+} NexusAudioVoiceCandidate;
+
 /**
  * Audio system configuration
  */
@@ -73,17 +119,41 @@ typedef struct {
     SDL_AudioDeviceID audio_device;                  /* SDL audio device */
     NexusSoundSource sources[NEXUS_MAX_SOUND_SOURCES]; /* Sound sources array */
     int source_count;                                /* Number of active sources */
+    Uint16 free_sources[NEXUS_MAX_SOUND_SOURCES];    /* Free source indices (stack) */
+    int free_count;                                  /* Number of free sources */
+    Uint32 next_serial;                              /* Serial of the next source ID */
     SDL_AudioStream* audio_stream;                   /* SDL audio stream */
     bool initialized;                                /* Initialization flag */
+    bool paused;                                     /* Playback paused */
+    int mix_rate;                                    /* Mix rate in Hz */
+    float sfx_volume;                                /* Sound effects volume [0.0, 1.0] */
+    float music_volume;                              /* Music volume [0.0, 1.0] */
     vec3 listener_position;                          /* Listener position */
     vec3 listener_forward;                           /* Listener forward vector */
     vec3 listener_up;                                /* Listener up vector */
+    NexusJobSystem* jobs;                            /* Runs stream decode jobs (NULL = decode on update) */
+
+    /* Mixer state (audio thread, under the stream lock) */
+    NexusAudioVoiceBatch batch;                      /* Voices of the current block */
+    NexusAudioVoiceCandidate candidates[NEXUS_MAX_SOUND_SOURCES]; /* Audible voices of the current block */
+    float mix_buffer[NEXUS_AUDIO_MIX_BLOCK * NEXUS_AUDIO_MIX_CHANNELS]; /* Block being mixed */
+    float resample_buffer[NEXUS_AUDIO_MIX_BLOCK * NEXUS_AUDIO_MIX_CHANNELS]; /* Pitched voice scratch */
+
+    /* Stats of the last block */
+    int mixed_voice_count;                           /* Voices mixed */
+    int virtual_voice_count;                         /* Audible voices over max_channels, advanced silently */
+    int culled_voice_count;                          /* Inaudible voices (out of range or silent) */
+    int stream_underrun_count;                       /* Stream blocks mixed short, the decoder fell behind */
 } NexusAudio;
 
 /* Audio system functions */
 NexusAudio* nexus_audio_create(const NexusAudioConfig* config);
 void nexus_audio_destroy(NexusAudio* audio);
 void nexus_audio_update(NexusAudio* audio, float dt);
+void nexus_audio_set_job_system(NexusAudio* audio, NexusJobSystem* jobs);
+int nexus_audio_get_mix_rate(const NexusAudio* audio);
+void nexus_audio_get_voice_stats(const NexusAudio* audio, int* mixed, int* virtual_voices, int* culled);
+int nexus_audio_get_stream_underruns(const NexusAudio* audio);
 void nexus_audio_pause(NexusAudio* audio, bool pause);
 bool nexus_audio_is_paused(const NexusAudio* audio);
 void nexus_audio_set_master_volume(NexusAudio* audio, float volume);
@@ -104,10 +174,12 @@ void nexus_audio_get_listener_up(const NexusAudio* audio, vec3 up);
 NexusSound* nexus_sound_load_from_file(const char* filename);
 NexusSound* nexus_sound_load_from_memory(const void* data, size_t size, NexusAudioFormat format);
 void nexus_sound_destroy(NexusSound* sound);
+NexusSoundStream* nexus_audio_open_stream(const NexusAudio* audio, const char* filename);
 
 /* Sound source functions */
 Uint32 nexus_audio_play_sound(NexusAudio* audio, NexusSound* sound, float volume, float pitch, bool loop);
 Uint32 nexus_audio_play_sound_3d(NexusAudio* audio, NexusSound* sound, float x, float y, float z, float min_dist, float max_dist, float volume, float pitch, bool loop);
+Uint32 nexus_audio_play_stream(NexusAudio* audio, NexusSoundStream* stream, float volume, bool loop);
 void nexus_audio_stop_sound(NexusAudio* audio, Uint32 source_id);
 void nexus_audio_pause_sound(NexusAudio* audio, Uint32 source_id, bool pause);
 bool nexus_audio_is_sound_playing(const NexusAudio* audio, Uint32 source_id);
@@ -118,6 +190,7 @@ void nexus_audio_set_sound_position(NexusAudio* audio, Uint32 source_id, float x
 void nexus_audio_set_sound_min_distance(NexusAudio* audio, Uint32 source_id, float min_distance);
 void nexus_audio_set_sound_max_distance(NexusAudio* audio, Uint32 source_id, float max_distance);
 void nexus_audio_set_sound_attenuation(NexusAudio* audio, Uint32 source_id, float attenuation);
+void nexus_audio_set_sound_priority(NexusAudio* audio, Uint32 source_id, int priority);
 void nexus_audio_stop_all_sounds(NexusAudio* audio);
 void nexus_audio_pause_all_sounds(NexusAudio* audio, bool pause);
 
@@ -0,0 +1,46 @@
+/**
+ * Nexus3D Audio Mixer Kernels
+ * SIMD building blocks of the software mixer: per-voice gains from volume,
+ * pan and 3D distance computed four voices at a time, ramped accumulation of
+ * mono and stereo voices into an interleaved stereo mix, linear resampling
+ * for pitched voices and output clipping. All data is float
+ */
+
+#ifndef NEXUS3D_MIXER_H
+#define NEXUS3D_MIXER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Voices processed per gain batch */
+#define NEXUS_MIXER_LANES 4
+
+/**
+ * Gain stage inputs, one array entry per voice (structure of arrays)
+ */
+typedef struct {
+    const float* x;                /* World position */
+    const float* y;
+    const float* z;
+    const float* min_distance;     /* Distance attenuation starts at (> 0) */
+    const float* max_distance;     /* Distance the voice becomes inaudible at */
+    const float* rolloff;          /* Attenuation factor past min_distance */
+    const float* volume;           /* Voice volume */
+    const float* pan;              /* Pan of non-spatial voices [-1, 1] */
+    const float* spatial;          /* 1 = positioned in 3D, 0 = plain stereo voice */
+} NexusMixerGainInput;
+
+/* Mixer kernel functions */
+void nexus_mixer_compute_gains(const NexusMixerGainInput* input, uint32_t count, const float* listener,
+                               const float* listener_right, float master_volume,
+                               float* gain_left, float* gain_right);
+void nexus_mixer_mix_mono(float* out, const float* in, uint32_t frames,
+                          float gain_left, float gain_right, float step_left, float step_right);
+void nexus_mixer_mix_stereo(float* out, const float* in, uint32_t frames,
+                            float gain_left, float gain_right, float step_left, float step_right);
+uint32_t nexus_mixer_resample(float* out, uint32_t out_frames, const float* in, uint32_t in_frames,
+                              uint32_t channels, double* position, double step, bool loop);
+void nexus_mixer_clip(float* buffer, uint32_t count);
+const char* nexus_mixer_get_kernel_name(void);
+
+#endif /* NEXUS3D_MIXER_H */
@@ -0,0 +1,94 @@
+/**
+ * Nexus3D Sound Streams
+ * Long sounds (music, ambience, dialogue) decoded in small chunks on a job
+ * into a bounded ring the mixer reads from, instead of holding the whole
+ * decoded sound in memory. Decoders are registered per format, WAV (PCM and
+ * float) is built in
+ */
+
+#ifndef NEXUS3D_SOUND_STREAM_H
+#define NEXUS3D_SOUND_STREAM_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "nexus3d/core/jobs.h"
+
+/* Decoded audio buffered per stream by default */
+#define NEXUS_SOUND_STREAM_DEFAULT_BUFFER_MS 500
+
+/* Frames read from the decoder at a time */
+#define NEXUS_SOUND_STREAM_CHUNK_FRAMES 4096
+
+/**
+ * Audio format enumeration
+ */
+typedef enum {
+    NEXUS_AUDIO_FORMAT_UNKNOWN,
+    NEXUS_AUDIO_FORMAT_WAV,
+    NEXUS_AUDIO_FORMAT_OGG,
+    NEXUS_AUDIO_FORMAT_MP3,
+    NEXUS_AUDIO_FORMAT_OPUS,
+    NEXUS_AUDIO_FORMAT_COUNT
+} NexusAudioFormat;
+
+/**
+ * Streaming decoder of one audio format
+ * Called from one thread at a time, the decode jobs of a stream never overlap
+ */
+typedef struct {
+    const char* name;                                         /* Decoder name */
+    bool (*open)(SDL_IOStream* io, void** state, SDL_AudioSpec* spec); /* Read the header, report the decoded format */
+    int (*read)(void* state, void* buffer, int bytes);        /* Decode up to bytes (0 = end, < 0 = error) */
+    bool (*rewind)(void* state);                              /* Seek back to the first sample */
+    void (*close)(void* state);                               /* Free the state, the stream closes the file */
+} NexusSoundDecoder;
+
+/**
+ * Sound stream structure
+ * One decode job fills the ring, the mixer of a single voice drains it
+ */
+typedef struct {
+    const NexusSoundDecoder* decoder; /* Decoder of the file's format */
+    void* state;                   /* Decoder state */
+    SDL_IOStream* io;              /* Source file */
+    SDL_AudioStream* converter;    /* Decoded format to float at the mix rate */
+    SDL_AudioSpec spec;            /* Ring format (F32, 1 or 2 channels, mix rate) */
+    int decoded_frame_size;        /* Bytes per decoded frame */
+
+    float* ring;                   /* Converted frames */
+    uint32_t capacity;             /* Ring size in frames (power of two) */
+    SDL_AtomicU32 write_count;     /* Frames written (decode job) */
+    SDL_AtomicU32 read_count;      /* Frames read (mixer) */
+    Uint8* chunk;                  /* Decoder output of one chunk */
+    int chunk_size;                /* Chunk size in bytes */
+
+    SDL_AtomicInt looping;         /* Rewind the decoder at the end instead of finishing */
+    SDL_AtomicInt decoder_done;    /* Last frame converted (end reached or decoder failed) */
+    bool flushed;                  /* Decoder ended, the converter only drains */
+    bool rewound_empty;            /* Rewound without decoding anything since (empty loop) */
+
+    NexusJobSystem* jobs;          /* Job system of the pending decode job */
+    NexusJobCounter done;          /* Pending decode job */
+    char name[64];                 /* Stream name */
+} NexusSoundStream;
+
+/* Decoder registry */
+bool nexus_sound_stream_register_decoder(NexusAudioFormat format, const NexusSoundDecoder* decoder);
+NexusAudioFormat nexus_sound_stream_get_format(const char* filename);
+
+/* Sound stream functions */
+NexusSoundStream* nexus_sound_stream_open(const char* filename, int mix_rate, int buffer_ms);
+void nexus_sound_stream_destroy(NexusSoundStream* stream);
+uint32_t nexus_sound_stream_decode(NexusSoundStream* stream, uint32_t max_frames);
+void nexus_sound_stream_update(NexusSoundStream* stream, NexusJobSystem* jobs);
+bool nexus_sound_stream_rewind(NexusSoundStream* stream);
+void nexus_sound_stream_set_looping(NexusSoundStream* stream, bool loop);
+void nexus_sound_stream_set_pitch(NexusSoundStream* stream, float pitch);
+uint32_t nexus_sound_stream_read(NexusSoundStream* stream, float* out, uint32_t frames);
+uint32_t nexus_sound_stream_skip(NexusSoundStream* stream, uint32_t frames);
+uint32_t nexus_sound_stream_get_buffered(const NexusSoundStream* stream);
+bool nexus_sound_stream_is_finished(const NexusSoundStream* stream);
+size_t nexus_sound_stream_get_memory_size(const NexusSoundStream* stream);
+
+#endif /* NEXUS3D_SOUND_STREAM_H */
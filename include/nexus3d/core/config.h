@@ -16,7 +16,18 @@ typedef struct {
     int msaa_samples;              /* MSAA sample count (2, 4, 8, etc.) */
     bool enable_vsync;             /* Enable vertical sync */
     int max_fps;                   /* Maximum frames per second (0 = unlimited) */
+    char present_mode[16];         /* "vsync", "mailbox" or "immediate" (empty = from enable_vsync) */
+    int frames_in_flight;          /* Frames queued ahead of the GPU (1 = lowest latency, 3 = smoothest) */
     bool enable_hdr;               /* Enable high dynamic range */
+    bool enable_depth_prepass;     /* Depth-only pass before shading opaque geometry */
+    float lod_pixel_error;         /* Screen space error in pixels a mesh LOD may have */
+    float lod_hysteresis;          /* Fraction of lod_pixel_error a coarser LOD must stay below to switch */
+    int shadow_atlas_size;         /* Shadow atlas edge length in texels */
+    int shadow_cascades;           /* Cascades of directional light shadows (1 - 4) */
+    float shadow_distance;         /* View distance covered by directional light shadows */
+    char shader_cache_path[128];   /* Shader cache directory (empty = disabled) */
+    bool enable_gpu_driven;        /* Cull and draw opaque renderables on the GPU */
+    char gpu_cull_shader[128];     /* Compute shader of the GPU cull pass (.spv, .msl or .dxbc) */
 } NexusGraphicsConfig;
 
 /* Audio configuration */
@@ -24,6 +35,7 @@ typedef struct {
     bool enable_audio;             /* Enable audio */
     int max_channels;              /* Maximum audio channels */
     float master_volume;           /* Master volume (0.0 - 1.0) */
+    int stream_buffer_ms;          /* Decoded audio buffered per sound stream */
 } NexusAudioConfig;
 
 /* Physics configuration */
@@ -41,11 +53,34 @@ typedef struct {
     bool enable_mouse;             /* Enable mouse input */
 } NexusInputConfig;
 
+/* Threading configuration */
+typedef struct {
+    int worker_threads;            /* Job and ECS worker threads (0 = one per logical core, 1 = single threaded) */
+    bool pipelined_rendering;      /* Render frame N on a render thread while frame N+1 simulates */
+    int render_snapshots;          /* Frames extracted ahead when pipelined (2-4, each extra one adds a frame of latency and a snapshot of memory) */
+} NexusThreadingConfig;
+
+/* Memory configuration */
+typedef struct {
+    int frame_arena_kb;            /* Size of each of the two frame arenas */
+    int scratch_arena_kb;          /* Size of each thread's scratch arena */
+} NexusMemoryConfig;
+
+/* Asset streaming configuration */
+typedef struct {
+    int max_in_flight;             /* Decode jobs running at the same time */
+    int upload_budget_kb;          /* Decoded data uploaded per frame */
+} NexusStreamingConfig;
+
 /* Debug configuration */
 typedef struct {
     bool enable_debug_logging;     /* Enable debug logs */
     bool enable_physics_debug;     /* Enable physics debug rendering */
-    bool enable_profiling;         /* Enable performance profiling */
+    bool enable_profiling;         /* Capture a CPU trace (builds with NEXUS_PROFILE) */
+    int profile_frames;            /* Frames captured before the trace is written (0 = until shutdown) */
+    char profile_trace_path[128];  /* Chrome trace JSON written at the end of the capture */
+    bool async_logging;            /* Format and write log messages on a writer thread */
+    bool log_overflow_block;       /* Full log rings block the logging thread instead of dropping */
 } NexusDebugConfig;
 
 /* Main configuration structure */
@@ -55,6 +90,9 @@ typedef struct {
     NexusAudioConfig audio;        /* Audio configuration */
     NexusPhysicsConfig physics;    /* Physics configuration */
     NexusInputConfig input;        /* Input configuration */
+    NexusThreadingConfig threading; /* Threading configuration */
+    NexusMemoryConfig memory;      /* Memory configuration */
+    NexusStreamingConfig streaming; /* Asset streaming configuration */
     NexusDebugConfig debug;        /* Debug configuration */
 } NexusConfig;
 
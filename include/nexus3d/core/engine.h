@@ -17,6 +17,12 @@ struct NexusWindow;
 struct NexusInput;
 struct NexusPhysics;
 struct NexusAudio;
+struct NexusJobSystem;
+struct NexusAssetLoader;
+struct NexusLogger;
+struct NexusRenderThread;
+struct NexusRenderSnapshot;
+struct NexusFramePacer;
 
 /* Use the pointers to structs in the engine implementation */
 
@@ -38,8 +44,14 @@ typedef struct {
     struct NexusInput* input;          /* Input system */
     struct NexusPhysics* physics;      /* Physics system */
     struct NexusAudio* audio;          /* Audio system */
+    struct NexusJobSystem* jobs;       /* Job system (shared with the flecs task threads) */
+    struct NexusAssetLoader* assets;   /* Asynchronous mesh and texture loader */
+    struct NexusLogger* logger;        /* Engine logger (asynchronous unless configured otherwise) */
+    struct NexusRenderThread* render_thread; /* Pipelined rendering (NULL = frames render on the main thread) */
+    struct NexusRenderSnapshot* render_snapshot; /* Frame extracted for the main thread when not pipelined */
     
     /* Timing */
+    struct NexusFramePacer* pacer;     /* Frame start pacing and frame time measurement */
     double delta_time;                 /* Time between frames in seconds */
     double time_scale;                 /* Time scale factor */
     uint64_t frame_count;              /* Total frames since startup */
@@ -47,6 +59,7 @@ typedef struct {
     /* Performance metrics */
     double fps;                        /* Current frames per second */
     double avg_frame_time;             /* Average frame time in milliseconds */
+    double frame_time_variance;        /* Frame time variance in ms^2 (jitter squared) */
 } NexusEngine;
 
 /* Global engine instance */
@@ -68,6 +81,11 @@ uint64_t nexus_engine_get_frame_count(void);
 /* Performance metrics */
 double nexus_engine_get_fps(void);
 double nexus_engine_get_avg_frame_time(void);
+double nexus_engine_get_frame_time_variance(void);
+void nexus_engine_set_target_fps(double target_fps);
+
+/* Rendering */
+void nexus_engine_wait_for_render(void);
 
 /* ECS access */
 ecs_world_t* nexus_engine_get_world(void);
@@ -78,6 +96,9 @@ struct NexusWindow* nexus_engine_get_window(void);
 struct NexusInput* nexus_engine_get_input(void);
 struct NexusPhysics* nexus_engine_get_physics(void);
 struct NexusAudio* nexus_engine_get_audio(void);
+struct NexusJobSystem* nexus_engine_get_jobs(void);
+struct NexusAssetLoader* nexus_engine_get_asset_loader(void);
+struct NexusLogger* nexus_engine_get_logger(void);
 struct NexusConfig* nexus_engine_get_config(void);
 
 #endif /* NEXUS3D_ENGINE_H */
@@ -0,0 +1,141 @@
+/**
+ * Nexus3D Job System
+ * Work-stealing scheduler with per-worker Chase-Lev deques, shared by the
+ * engine subsystems and the flecs task threads
+ */
+
+#ifndef NEXUS3D_JOBS_H
+#define NEXUS3D_JOBS_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "nexus3d/utils/allocator.h"
+
+/* Jobs a worker deque holds (power of two), pushes beyond it run inline */
+#define NEXUS_JOBS_DEQUE_SIZE 4096
+
+/* Most jobs a parallel for is split into */
+#define NEXUS_JOBS_MAX_RANGES 256
+
+/* Upper bound of worker threads */
+#define NEXUS_JOBS_MAX_WORKERS 64
+
+/* Free jobs a worker hands over to the others at once */
+#define NEXUS_JOBS_FREE_BATCH 32
+
+/* Batches of free jobs waiting to be picked up by a worker */
+#define NEXUS_JOBS_FREE_BATCHES 64
+
+/**
+ * Job entry point
+ */
+typedef void (*NexusJobFunc)(void* data);
+
+/**
+ * Parallel for entry point, called with a sub range [first, end)
+ */
+typedef void (*NexusJobRangeFunc)(void* data, uint32_t first, uint32_t end);
+
+/**
+ * Dependency counter
+ * Counts the jobs still pending, a counter reaching zero releases waiters and
+ * jobs that run after it
+ */
+typedef struct {
+    SDL_AtomicInt pending;         /* Unfinished jobs */
+} NexusJobCounter;
+
+/**
+ * Queued job
+ */
+typedef struct NexusJob {
+    NexusJobFunc func;             /* Entry point */
+    void* data;                    /* Entry point argument */
+    NexusJobCounter* counter;      /* Decremented when the job finished (optional) */
+    NexusJobCounter* dependency;   /* Has to reach zero before the job starts (optional) */
+    struct NexusJob* next;         /* Freelist link while the job is unused */
+} NexusJob;
+
+/**
+ * Chase-Lev deque (the owner pushes and pops the bottom, thieves take the top)
+ */
+typedef struct {
+    SDL_AtomicU32 top;             /* Next job to steal */
+    uint8_t pad0[60];              /* Keep thieves and the owner on separate cache lines */
+    SDL_AtomicU32 bottom;          /* Next free slot */
+    uint8_t pad1[60];
+    void* slots[NEXUS_JOBS_DEQUE_SIZE]; /* Ring of NexusJob pointers */
+} NexusJobDeque;
+
+/**
+ * Worker statistics
+ */
+typedef struct {
+    uint64_t busy_ns;              /* Time spent running jobs */
+    uint64_t idle_ns;              /* Time spent looking for work or asleep */
+    uint64_t jobs_executed;        /* Jobs run by the worker */
+    uint64_t jobs_stolen;          /* Jobs taken from other workers */
+} NexusJobWorkerStats;
+
+struct NexusJobSystem;
+
+/**
+ * Worker (slot 0 is the thread that created the system)
+ */
+typedef struct {
+    struct NexusJobSystem* system; /* Owning job system */
+    SDL_Thread* thread;            /* Worker thread (NULL for slot 0) */
+    int index;                     /* Worker slot */
+    uint32_t random;               /* Victim selection state */
+    uint64_t last_ns;              /* End of the last busy or idle period */
+    NexusJobWorkerStats stats;     /* Statistics (written by the worker only) */
+    NexusJob* free_jobs;           /* Jobs this worker finished, reused without locking */
+    uint32_t free_count;           /* Jobs on the freelist */
+    NexusJobDeque deque;           /* Jobs pushed from this worker */
+} NexusJobWorker;
+
+/**
+ * Job system structure
+ */
+typedef struct NexusJobSystem {
+    NexusJobWorker* workers;       /* Worker slots */
+    int worker_count;              /* Slots including the creating thread */
+    SDL_AtomicInt running;         /* Cleared to stop the workers */
+    SDL_AtomicInt sleeping;        /* Workers waiting on the semaphore */
+    SDL_Semaphore* wake;           /* Wakes sleeping workers */
+    SDL_TLSID worker_tls;          /* Worker slot of the calling thread */
+    NexusPool job_pool;            /* Job storage (foreign threads and freelist misses) */
+
+    /* Freelist batches moving from the workers that run jobs to the ones that queue them */
+    SDL_SpinLock free_lock;        /* Guards the batches */
+    NexusJob* free_batches[NEXUS_JOBS_FREE_BATCHES]; /* Linked lists of NEXUS_JOBS_FREE_BATCH jobs */
+    int free_batch_count;          /* Batches waiting */
+
+    /* Jobs from threads without a deque and jobs waiting on a dependency */
+    SDL_Mutex* shared_lock;        /* Guards the shared queue */
+    SDL_AtomicInt shared_pending;  /* Queued jobs, readable without the lock */
+    NexusJob** shared;             /* FIFO ring */
+    uint32_t shared_head;          /* First queued job */
+    uint32_t shared_count;         /* Queued jobs */
+    uint32_t shared_capacity;      /* Ring size (power of two) */
+} NexusJobSystem;
+
+/* Job system functions */
+NexusJobSystem* nexus_jobs_create(int thread_count);
+void nexus_jobs_destroy(NexusJobSystem* jobs);
+void nexus_jobs_run(NexusJobSystem* jobs, NexusJobFunc func, void* data, NexusJobCounter* counter);
+void nexus_jobs_run_after(NexusJobSystem* jobs, NexusJobFunc func, void* data,
+                          NexusJobCounter* dependency, NexusJobCounter* counter);
+void nexus_jobs_wait(NexusJobSystem* jobs, NexusJobCounter* counter);
+void nexus_jobs_parallel_for(NexusJobSystem* jobs, uint32_t count, uint32_t batch_size,
+                             NexusJobRangeFunc func, void* data);
+int nexus_jobs_get_worker_count(const NexusJobSystem* jobs);
+int nexus_jobs_get_worker_index(NexusJobSystem* jobs);
+NexusJobWorkerStats nexus_jobs_get_worker_stats(const NexusJobSystem* jobs, int worker);
+
+/* Counter functions */
+void nexus_job_counter_init(NexusJobCounter* counter);
+bool nexus_job_counter_is_done(NexusJobCounter* counter);
+
+#endif /* NEXUS3D_JOBS_H */
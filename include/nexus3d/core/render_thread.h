@@ -0,0 +1,52 @@
+/**
+ * Nexus3D Render Thread
+ * Renders extracted frames on a thread of its own, so the world simulates
+ * and extracts frame N+1 while frame N is recorded and submitted. Snapshots
+ * rotate through a small ring: the main thread fills one, hands it over and
+ * blocks only when every other snapshot is still waiting to be rendered
+ */
+
+#ifndef NEXUS3D_RENDER_THREAD_H
+#define NEXUS3D_RENDER_THREAD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <SDL3/SDL.h>
+#include "nexus3d/renderer/render_snapshot.h"
+
+/* Forward declarations */
+struct NexusRenderer;
+
+/**
+ * Render thread structure
+ */
+typedef struct NexusRenderThread {
+    struct NexusRenderer* renderer;    /* Renderer the frames are drawn with */
+    SDL_Thread* thread;                /* Thread rendering the submitted snapshots */
+
+    /* Snapshot ring */
+    NexusRenderSnapshot* snapshots[NEXUS_RENDER_SNAPSHOT_MAX_COUNT]; /* Ring of extracted frames */
+    uint32_t snapshot_count;           /* Snapshots in the ring */
+    uint32_t write_index;              /* Snapshot the main thread extracts into */
+    uint32_t read_index;               /* Next snapshot to render (render thread only) */
+    SDL_Semaphore* ready;              /* Submitted snapshots waiting to be rendered */
+    SDL_Semaphore* free;               /* Snapshots the main thread can extract into */
+    SDL_AtomicInt running;             /* Cleared to stop the thread */
+
+    /* Stats */
+    SDL_AtomicInt frames_rendered;     /* Snapshots rendered into a swapchain image */
+    SDL_AtomicInt frames_skipped;      /* Snapshots dropped (minimized window, no swapchain) */
+    double wait_time;                  /* Time (ms) the last submit waited for a free snapshot */
+} NexusRenderThread;
+
+/* Render thread functions */
+NexusRenderThread* nexus_render_thread_create(struct NexusRenderer* renderer, uint32_t snapshot_count);
+void nexus_render_thread_destroy(NexusRenderThread* render_thread);
+NexusRenderSnapshot* nexus_render_thread_get_snapshot(const NexusRenderThread* render_thread);
+void nexus_render_thread_submit(NexusRenderThread* render_thread);
+void nexus_render_thread_wait_idle(NexusRenderThread* render_thread);
+uint32_t nexus_render_thread_get_frames_rendered(const NexusRenderThread* render_thread);
+uint32_t nexus_render_thread_get_frames_skipped(const NexusRenderThread* render_thread);
+double nexus_render_thread_get_wait_time(const NexusRenderThread* render_thread);
+
+#endif /* NEXUS3D_RENDER_THREAD_H */
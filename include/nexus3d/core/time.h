@@ -26,6 +26,29 @@ typedef struct {
     uint64_t performance_frequency; /* Performance counter frequency */
 } NexusTime;
 
+/* Final stretch of a pacing wait that is spun rather than slept (OS sleeps overshoot) */
+#define NEXUS_FRAME_PACER_SPIN_NS 1500000
+
+/**
+ * Frame pacer structure
+ * Starts frames at a fixed rate on the performance counter: the wait sleeps
+ * until shortly before the deadline, then spins, so frames neither drift nor
+ * inherit the sleep granularity of the OS. Frame times are measured from one
+ * frame start to the next, including everything outside the frame's own work
+ */
+typedef struct NexusFramePacer {
+    uint64_t frequency;            /* Performance counter ticks per second */
+    uint64_t target_ticks;         /* Target frame length in counter ticks (0 = unpaced) */
+    uint64_t spin_ticks;           /* Length of the spun part of a wait */
+    uint64_t deadline;             /* Counter value the next frame starts at */
+    uint64_t frame_start;          /* Counter value the current frame started at */
+    uint64_t frame_count;          /* Frames started */
+    double delta_time;             /* Start to start time of the last frame in seconds */
+    double wait_time;              /* Time (ms) the current frame waited for its start */
+    double average_frame_time;     /* Smoothed frame time in milliseconds */
+    double frame_time_variance;    /* Smoothed frame time variance in ms^2 */
+} NexusFramePacer;
+
 /* Time management functions */
 NexusTime* nexus_time_create(void);
 void nexus_time_destroy(NexusTime* time);
@@ -42,4 +65,14 @@ void nexus_time_set_fixed_timestep(NexusTime* time, double timestep);
 double nexus_time_get_fixed_timestep(const NexusTime* time);
 bool nexus_time_should_update_fixed(NexusTime* time);
 
+/* Frame pacer functions */
+NexusFramePacer* nexus_frame_pacer_create(double target_fps);
+void nexus_frame_pacer_destroy(NexusFramePacer* pacer);
+void nexus_frame_pacer_set_target_fps(NexusFramePacer* pacer, double target_fps);
+double nexus_frame_pacer_begin_frame(NexusFramePacer* pacer);
+double nexus_frame_pacer_get_delta_time(const NexusFramePacer* pacer);
+double nexus_frame_pacer_get_wait_time(const NexusFramePacer* pacer);
+double nexus_frame_pacer_get_average_frame_time(const NexusFramePacer* pacer);
+double nexus_frame_pacer_get_frame_time_variance(const NexusFramePacer* pacer);
+
 #endif /* NEXUS3D_TIME_H */
@@ -36,11 +36,15 @@ typedef struct {
 
 /**
  * Transform component
+ * World matrices follow EcsChildOf: world = parent world * local
  */
 typedef struct {
-    mat4 local;          /* Local transformation matrix */
+    mat4 local;          /* Local transformation matrix (relative to the parent) */
     mat4 world;          /* World transformation matrix */
-    bool dirty;          /* Flag indicating if matrices need recalculation */
+    bool world_dirty;    /* Local matrix changed (cleared by the hierarchy system) */
+    uint32_t world_version;  /* Incremented whenever the world matrix changes */
+    uint32_t parent_version; /* Parent world_version the world matrix was built from */
+    ecs_entity_t parent; /* Parent the world matrix was built from (0 = root) */
 } NexusTransformComponent;
 
 /**
@@ -52,8 +56,22 @@ typedef struct {
     bool visible;        /* Visibility flag */
     bool cast_shadows;   /* Whether the entity casts shadows */
     bool receive_shadows; /* Whether the entity receives shadows */
+    uint32_t lod;        /* Detail level drawn last frame, kept for LOD hysteresis */
+    uint32_t gpu_object; /* GPU scene object handle (0 = drawn through the render queue) */
 } NexusRenderableComponent;
 
+/**
+ * World bounds component
+ * Cached world-space AABB of a renderable, added automatically with
+ * NexusRenderableComponent and refreshed when the transform changes
+ */
+typedef struct {
+    vec3 min;            /* World space AABB minimum */
+    vec3 max;            /* World space AABB maximum */
+    const NexusMesh* mesh; /* Mesh the bounds were computed for */
+    uint32_t transform_version; /* Transform world_version the bounds were computed for */
+} NexusBoundsComponent;
+
 /**
  * Camera component
  */
@@ -104,8 +122,22 @@ typedef struct {
     bool kinematic;           /* Whether the body is kinematic */
     bool trigger;             /* Whether the body is a trigger */
     bool sleeping;            /* Whether the body is sleeping */
+    int32_t still_frames;     /* Steps spent below the sleep velocity */
+    int32_t solver_index;     /* Body slot of the current physics step */
 } NexusRigidBodyComponent;
 
+/**
+ * Interpolation component
+ * Renders an entity between its last two fixed physics steps instead of
+ * snapping to the latest one
+ */
+typedef struct {
+    vec3 previous_position;   /* Position before the last physics step */
+    versor previous_rotation; /* Rotation before the last physics step */
+    bool valid;               /* Previous state was captured */
+    bool blended;             /* Local matrix holds a blended state */
+} NexusInterpolationComponent;
+
 /**
  * Audio source component
  */
@@ -123,10 +155,12 @@ typedef struct {
 
 /**
  * Tag components (empty structures)
+ * Static entities live in their own tables, which change detection skips
  */
 typedef struct { char _unused; } NexusStaticTag;      /* Static object that doesn't move */
 typedef struct { char _unused; } NexusDynamicTag;     /* Dynamic object that moves */
 typedef struct { char _unused; } NexusMainCameraTag;  /* Tag for the main camera */
+typedef struct { char _unused; } NexusGpuDrivenTag;   /* Renderable culled and drawn by the GPU scene */
 
 /* Export component declarations for use in other files */
 extern ECS_COMPONENT_DECLARE(NexusPositionComponent);
@@ -134,11 +168,15 @@ extern ECS_COMPONENT_DECLARE(NexusRotationComponent);
 extern ECS_COMPONENT_DECLARE(NexusScaleComponent);
 extern ECS_COMPONENT_DECLARE(NexusTransformComponent);
 extern ECS_COMPONENT_DECLARE(NexusRenderableComponent);
+extern ECS_COMPONENT_DECLARE(NexusBoundsComponent);
 extern ECS_COMPONENT_DECLARE(NexusCameraComponent);
 extern ECS_COMPONENT_DECLARE(NexusLightComponent);
 extern ECS_COMPONENT_DECLARE(NexusVelocityComponent);
 extern ECS_COMPONENT_DECLARE(NexusRigidBodyComponent);
+extern ECS_COMPONENT_DECLARE(NexusInterpolationComponent);
 extern ECS_COMPONENT_DECLARE(NexusAudioSourceComponent);
+extern ECS_COMPONENT_DECLARE(NexusStaticTag);
+extern ECS_COMPONENT_DECLARE(NexusGpuDrivenTag);
 
 /* ECS component registration */
 void nexus_ecs_register_components(ecs_world_t* world);
@@ -0,0 +1,180 @@
+/**
+ * Nexus3D Scene Files
+ * Binary scene snapshots: every matched table is stored as contiguous
+ * component columns laid out as their in-memory structures, with meshes and
+ * materials referenced by content hash. Loading maps the file and inserts
+ * each table with one bulk call, saving copies the columns into a snapshot
+ * that can be written from any thread
+ */
+
+#ifndef NEXUS3D_SCENE_FILE_H
+#define NEXUS3D_SCENE_FILE_H
+
+#include <flecs.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "nexus3d/core/jobs.h"
+
+/* File identification ("NXSC") */
+#define NEXUS_SCENE_FILE_MAGIC   0x4353584Eu
+#define NEXUS_SCENE_FILE_VERSION 1u
+
+/* Scene file extension */
+#define NEXUS_SCENE_FILE_EXTENSION ".nxs"
+
+/* Sections and columns start at multiples of this many bytes */
+#define NEXUS_SCENE_FILE_ALIGNMENT 16u
+
+/* Maximum length of a scene path */
+#define NEXUS_SCENE_MAX_PATH 256
+
+/* Asset index of renderables without a mesh or material */
+#define NEXUS_SCENE_ASSET_NONE 0xFFFFFFFFu
+
+/**
+ * Component columns of a scene table
+ */
+typedef enum {
+    NEXUS_SCENE_COLUMN_POSITION,      /* NexusPositionComponent */
+    NEXUS_SCENE_COLUMN_ROTATION,      /* NexusRotationComponent */
+    NEXUS_SCENE_COLUMN_SCALE,         /* NexusScaleComponent */
+    NEXUS_SCENE_COLUMN_TRANSFORM,     /* NexusTransformComponent (hierarchy state reset) */
+    NEXUS_SCENE_COLUMN_RENDERABLE,    /* NexusSceneRenderable */
+    NEXUS_SCENE_COLUMN_RIGIDBODY,     /* NexusRigidBodyComponent (solver state reset) */
+    NEXUS_SCENE_COLUMN_LIGHT,         /* NexusLightComponent */
+    NEXUS_SCENE_COLUMN_COUNT
+} NexusSceneColumn;
+
+/* Tags kept per table */
+#define NEXUS_SCENE_TAG_STATIC     (1u << 0)
+#define NEXUS_SCENE_TAG_GPU_DRIVEN (1u << 1)
+
+/**
+ * Asset types referenced by scenes
+ */
+typedef enum {
+    NEXUS_SCENE_ASSET_MESH,           /* NexusMesh */
+    NEXUS_SCENE_ASSET_MATERIAL        /* NexusMaterial */
+} NexusSceneAssetType;
+
+/**
+ * Scene file header
+ * Followed by the columns, the table records and the asset table at the
+ * given offsets, all little endian
+ */
+typedef struct {
+    uint32_t magic;                    /* NEXUS_SCENE_FILE_MAGIC */
+    uint32_t version;                  /* NEXUS_SCENE_FILE_VERSION */
+    uint32_t column_sizes[NEXUS_SCENE_COLUMN_COUNT]; /* Element size of each column, rejects other layouts */
+    uint32_t table_count;              /* Number of NexusSceneFileTable records */
+    uint32_t entity_count;             /* Entities of all tables */
+    uint32_t asset_count;              /* Number of NexusSceneAssetRef entries */
+    uint32_t table_offset;             /* File offset of the table records */
+    uint32_t asset_offset;             /* File offset of the asset table */
+    uint32_t file_size;                /* Bytes of the whole file */
+} NexusSceneFileHeader;
+
+/**
+ * Table record, the entities of one component combination
+ */
+typedef struct {
+    uint32_t entity_count;             /* Entities (rows) of the table */
+    uint32_t column_mask;              /* 1 << NexusSceneColumn of each stored column */
+    uint32_t tag_mask;                 /* NEXUS_SCENE_TAG_* of the table */
+    uint32_t reserved;                 /* Padding, zero */
+    uint32_t column_offsets[NEXUS_SCENE_COLUMN_COUNT]; /* File offset of each stored column */
+    uint32_t padding;                  /* Padding, zero */
+} NexusSceneFileTable;
+
+/**
+ * Asset reference, resolved through NexusSceneAssets on load
+ */
+typedef struct {
+    uint64_t hash;                     /* Content hash */
+    uint32_t type;                     /* NexusSceneAssetType */
+    uint32_t reserved;                 /* Padding, zero */
+} NexusSceneAssetRef;
+
+/**
+ * Renderable as stored in scene files, pointers replaced by asset table indices
+ */
+typedef struct {
+    uint32_t mesh;                     /* Asset index of the mesh (NEXUS_SCENE_ASSET_NONE = none) */
+    uint32_t material;                 /* Asset index of the material (NEXUS_SCENE_ASSET_NONE = none) */
+    uint8_t visible;                   /* Visibility flag */
+    uint8_t cast_shadows;              /* Whether the entity casts shadows */
+    uint8_t receive_shadows;           /* Whether the entity receives shadows */
+    uint8_t reserved;                  /* Padding, zero */
+} NexusSceneRenderable;
+
+/**
+ * Registered asset
+ */
+typedef struct {
+    uint64_t hash;                     /* Content hash */
+    NexusSceneAssetType type;          /* Asset type */
+    void* asset;                       /* NexusMesh or NexusMaterial */
+} NexusSceneAsset;
+
+/**
+ * Asset registry, maps content hashes to loaded assets and back
+ */
+typedef struct {
+    NexusSceneAsset* entries;          /* Registered assets */
+    uint32_t count;                    /* Number of registered assets */
+    uint32_t capacity;                 /* Allocated entries */
+    uint32_t* by_hash;                 /* Entry index + 1 by hash (0 = empty, open addressing) */
+    uint32_t* by_pointer;              /* Entry index + 1 by asset pointer (0 = empty, open addressing) */
+    uint32_t table_capacity;           /* Slots of both lookup tables (power of two) */
+} NexusSceneAssets;
+
+/**
+ * Scene snapshot, the image of a scene file in memory
+ */
+typedef struct {
+    uint8_t* data;                     /* File image */
+    uint32_t size;                     /* Bytes used */
+    uint32_t capacity;                 /* Bytes allocated */
+    uint32_t missing_assets;           /* Renderable references to unregistered assets (stored as none) */
+} NexusSceneSnapshot;
+
+/**
+ * Quick save in progress
+ */
+typedef struct {
+    NexusSceneSnapshot* snapshot;      /* Copied scene */
+    char path[NEXUS_SCENE_MAX_PATH];   /* Destination file */
+    NexusJobSystem* jobs;              /* Job system running the write (NULL = written inline) */
+    NexusJobCounter done;              /* Released when the file was written */
+    bool success;                      /* Result of the write */
+} NexusSceneSave;
+
+/* Content hashing */
+uint64_t nexus_scene_hash_data(const void* data, size_t size);
+uint64_t nexus_scene_hash_file(const char* filename);
+
+/* Asset registry functions */
+NexusSceneAssets* nexus_scene_assets_create(void);
+void nexus_scene_assets_destroy(NexusSceneAssets* assets);
+bool nexus_scene_assets_add(NexusSceneAssets* assets, NexusSceneAssetType type, uint64_t hash, void* asset);
+void* nexus_scene_assets_find(const NexusSceneAssets* assets, NexusSceneAssetType type, uint64_t hash);
+
+/* Snapshot functions */
+NexusSceneSnapshot* nexus_scene_snapshot_capture(ecs_world_t* world, const NexusSceneAssets* assets);
+void nexus_scene_snapshot_destroy(NexusSceneSnapshot* snapshot);
+bool nexus_scene_snapshot_write(const NexusSceneSnapshot* snapshot, const char* filename);
+bool nexus_scene_snapshot_instantiate(const NexusSceneSnapshot* snapshot, ecs_world_t* world,
+                                      const NexusSceneAssets* assets, uint32_t* entity_count);
+
+/* Scene file functions */
+bool nexus_scene_save(ecs_world_t* world, const NexusSceneAssets* assets, const char* filename);
+bool nexus_scene_load(ecs_world_t* world, const NexusSceneAssets* assets, const char* filename,
+                      uint32_t* entity_count);
+
+/* Quick save functions */
+NexusSceneSave* nexus_scene_save_async(ecs_world_t* world, const NexusSceneAssets* assets,
+                                       const char* filename, NexusJobSystem* jobs);
+bool nexus_scene_save_is_done(NexusSceneSave* save);
+bool nexus_scene_save_finish(NexusSceneSave* save);
+
+#endif /* NEXUS3D_SCENE_FILE_H */
@@ -35,15 +35,34 @@ bool nexus_ecs_register_systems(ecs_world_t* world);
  */
 void nexus_transform_system(ecs_iter_t* it);
 
+/**
+ * Mark an entity's position, rotation or scale as changed
+ * Needed after writing through ecs_get_mut, ecs_set already does this
+ */
+void nexus_transform_mark_changed(ecs_world_t* world, ecs_entity_t entity);
+
+/**
+ * Interpolation system
+ * Blends local matrices between the previous and current physics step
+ */
+void nexus_interpolation_system(ecs_iter_t* it);
+
 /**
  * Hierarchy system
  * Updates world transforms based on parent-child relationships
  */
 void nexus_hierarchy_system(ecs_iter_t* it);
 
+/**
+ * GPU scene system
+ * Mirrors opaque renderables into the renderer's GPU scene, only changed
+ * entities are written
+ */
+void nexus_gpu_scene_system(ecs_iter_t* it);
+
 /**
  * Physics system
- * Updates physics simulation
+ * Moves entities without a rigid body by their velocity, once per fixed step
  */
 void nexus_physics_system(ecs_iter_t* it);
 
@@ -55,10 +74,16 @@ void nexus_renderer_system(ecs_iter_t* it);
 
 /**
  * Light system
- * Updates light parameters for rendering
+ * Submits lights to the renderer for clustered shading
  */
 void nexus_light_system(ecs_iter_t* it);
 
+/**
+ * Light reset system
+ * Clears the renderer's lights once per frame before the light system runs
+ */
+void nexus_light_reset_system(ecs_iter_t* it);
+
 /**
  * Camera system
  * Updates camera matrices and parameters
@@ -77,4 +102,11 @@ void nexus_audio_system(ecs_iter_t* it);
  */
 void nexus_animation_system(ecs_iter_t* it);
 
+#ifdef NEXUS_PROFILE
+/**
+ * Closes the profiler scope of the last pipeline phase, call after ecs_progress
+ */
+void nexus_ecs_profile_end_phase(void);
+#endif
+
 #endif /* NEXUS3D_SYSTEMS_H */
@@ -1,6 +1,9 @@
 /**
  * Nexus3D Input System
- * Handles keyboard, mouse, and gamepad input
+ * Handles keyboard, mouse, and gamepad input. Actions are registered once
+ * by name and queried through compact handles: their bindings live in flat
+ * per-device arrays and every action is evaluated once per frame into
+ * bitsets, so queries are single bit tests
  */
 
 #ifndef NEXUS3D_INPUT_H
@@ -9,10 +12,35 @@
 #include "SDL3/SDL_scancode.h"
 #include <SDL3/SDL.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 /* Maximum number of gamepads that can be tracked */
 #define NEXUS_MAX_GAMEPADS 8
 
+/* Maximum number of input actions */
+#define NEXUS_MAX_INPUT_ACTIONS 256
+
+/* Maximum number of bindings per device type (keys, mouse buttons, gamepad buttons, gamepad axes) */
+#define NEXUS_MAX_INPUT_BINDINGS 256
+
+/* Action name length including the terminator */
+#define NEXUS_INPUT_ACTION_NAME_LENGTH 32
+
+/* Name lookup table slots (power of two, twice the action count) */
+#define NEXUS_INPUT_ACTION_TABLE_SIZE 512
+
+/* Words of an action bitset */
+#define NEXUS_INPUT_ACTION_WORDS (NEXUS_MAX_INPUT_ACTIONS / 64)
+
+/* Scaled axis value an axis binding counts as down from */
+#define NEXUS_INPUT_AXIS_PRESS_THRESHOLD 0.5f
+
+/* Action handle returned by registration */
+typedef uint16_t NexusInputAction;
+
+/* Handle of no action */
+#define NEXUS_INPUT_ACTION_INVALID ((NexusInputAction)0xFFFF)
+
 /**
  * Key state enumeration
  */
@@ -35,6 +63,15 @@ typedef enum {
     NEXUS_MOUSE_BUTTON_COUNT
 } NexusMouseButton;
 
+/**
+ * Binding of a device input to an action
+ */
+typedef struct {
+    uint16_t code;                    /* Scancode, mouse button, gamepad button or gamepad axis */
+    NexusInputAction action;          /* Bound action */
+    float scale;                      /* Axis value multiplier (sign selects the direction), 1 for buttons */
+} NexusInputBinding;
+
 /**
  * Input system structure
  */
@@ -74,8 +111,31 @@ typedef struct {
     /* Touch state */
     bool touch_enabled;               /* Touch input enabled flag */
 
-    /* Input mappings */
-    char action_map[256][32];         /* Action name to key/button mapping */
+    /* Actions */
+    char action_names[NEXUS_MAX_INPUT_ACTIONS][NEXUS_INPUT_ACTION_NAME_LENGTH]; /* Action names */
+    uint32_t action_hashes[NEXUS_MAX_INPUT_ACTIONS]; /* Action name hashes */
+    uint16_t action_table[NEXUS_INPUT_ACTION_TABLE_SIZE]; /* Name hash to action handle + 1 (0 = empty) */
+    int action_count;                 /* Registered actions */
+
+    /* Bindings, flat per device type */
+    NexusInputBinding key_bindings[NEXUS_MAX_INPUT_BINDINGS];
+    NexusInputBinding mouse_bindings[NEXUS_MAX_INPUT_BINDINGS];
+    NexusInputBinding gamepad_button_bindings[NEXUS_MAX_INPUT_BINDINGS];
+    NexusInputBinding gamepad_axis_bindings[NEXUS_MAX_INPUT_BINDINGS];
+    int key_binding_count;
+    int mouse_binding_count;
+    int gamepad_button_binding_count;
+    int gamepad_axis_binding_count;
+
+    /* Action states, evaluated once per frame in nexus_input_update */
+    uint64_t actions_down[NEXUS_INPUT_ACTION_WORDS];     /* Actions held */
+    uint64_t actions_pressed[NEXUS_INPUT_ACTION_WORDS];  /* Actions pressed this frame */
+    uint64_t actions_released[NEXUS_INPUT_ACTION_WORDS]; /* Actions released this frame */
+    uint64_t actions_prev[NEXUS_INPUT_ACTION_WORDS];     /* Actions held last frame */
+    uint64_t event_pressed[NEXUS_INPUT_ACTION_WORDS];    /* Presses since the last update (events) */
+    uint64_t event_released[NEXUS_INPUT_ACTION_WORDS];   /* Releases since the last update (events) */
+    float action_values[NEXUS_MAX_INPUT_ACTIONS];        /* Analog value (strongest binding) */
+
     float input_deadzone;             /* Analog input deadzone */
 } NexusInput;
 
@@ -84,6 +144,7 @@ NexusInput* nexus_input_create(void);
 void nexus_input_destroy(NexusInput* input);
 void nexus_input_update(NexusInput* input);
 void nexus_input_process_event(NexusInput* input, const SDL_Event* event);
+void nexus_input_process_events(NexusInput* input, const SDL_Event* events, int count);
 void nexus_input_reset_states(NexusInput* input);
 
 /* Keyboard functions */
@@ -121,7 +182,21 @@ bool nexus_input_is_gamepad_button_pressed(const NexusInput* input, int gamepad_
 bool nexus_input_is_gamepad_button_released(const NexusInput* input, int gamepad_index, SDL_GamepadButton button);
 const char* nexus_input_get_gamepad_name(const NexusInput* input, int gamepad_index);
 
-/* Action mapping functions */
+/* Action functions */
+NexusInputAction nexus_input_register_action(NexusInput* input, const char* action_name);
+NexusInputAction nexus_input_find_action(const NexusInput* input, const char* action_name);
+const char* nexus_input_get_action_name(const NexusInput* input, NexusInputAction action);
+bool nexus_input_bind_key(NexusInput* input, NexusInputAction action, SDL_Scancode key);
+bool nexus_input_bind_mouse_button(NexusInput* input, NexusInputAction action, NexusMouseButton button);
+bool nexus_input_bind_gamepad_button(NexusInput* input, NexusInputAction action, SDL_GamepadButton button);
+bool nexus_input_bind_gamepad_axis(NexusInput* input, NexusInputAction action, SDL_GamepadAxis axis, float scale);
+void nexus_input_clear_bindings(NexusInput* input, NexusInputAction action);
+bool nexus_input_action_is_down(const NexusInput* input, NexusInputAction action);
+bool nexus_input_action_is_pressed(const NexusInput* input, NexusInputAction action);
+bool nexus_input_action_is_released(const NexusInput* input, NexusInputAction action);
+float nexus_input_action_get_value(const NexusInput* input, NexusInputAction action);
+
+/* Action mapping functions (by name) */
 void nexus_input_map_action(NexusInput* input, const char* action_name, SDL_Scancode key);
 void nexus_input_map_action_to_mouse(NexusInput* input, const char* action_name, NexusMouseButton button);
 void nexus_input_map_action_to_gamepad(NexusInput* input, const char* action_name, SDL_GamepadButton button);
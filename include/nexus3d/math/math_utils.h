@@ -333,4 +333,10 @@ static inline bool nexus_ray_aabb_intersect(const NexusRay* ray, const vec3 min,
     return tmin >= 0.0f; // Intersection is in positive direction of ray
 }
 
+/* Frustum and bounding volume functions */
+void nexus_frustum_from_viewproj(mat4 view_proj, vec4 planes[6]);
+bool nexus_frustum_contains_sphere(const vec4 planes[6], const vec3 center, float radius);
+bool nexus_frustum_contains_aabb(const vec4 planes[6], const vec3 min_point, const vec3 max_point);
+void nexus_aabb_transform(mat4 m, const vec3 min_point, const vec3 max_point, vec3 out_min, vec3 out_max);
+
 #endif /* NEXUS3D_MATH_UTILS_H */
@@ -0,0 +1,37 @@
+/**
+ * Nexus3D Batch Transforms
+ * SIMD composition of affine matrices from position, rotation and scale
+ */
+
+#ifndef NEXUS3D_TRANSFORM_BATCH_H
+#define NEXUS3D_TRANSFORM_BATCH_H
+
+#include <stddef.h>
+
+/**
+ * Strided input and output arrays of a batch
+ * Strides are in bytes so component arrays from ecs_field can be used as is
+ */
+typedef struct {
+    const float* positions;        /* xyz translation of the first element */
+    size_t position_stride;        /* Bytes between translations */
+    const float* rotations;        /* xyzw quaternion of the first element */
+    size_t rotation_stride;        /* Bytes between quaternions */
+    const float* scales;           /* xyz scale of the first element */
+    size_t scale_stride;           /* Bytes between scales */
+    float* matrices;               /* Column major 4x4 output of the first element */
+    size_t matrix_stride;          /* Bytes between matrices */
+} NexusTRSBatch;
+
+/**
+ * Batch kernel signature
+ */
+typedef void (*NexusTRSKernel)(const NexusTRSBatch* batch, int count);
+
+/* Batch transform functions */
+void nexus_trs_select_kernel(void);
+const char* nexus_trs_get_kernel_name(void);
+void nexus_trs_compose_batch(const NexusTRSBatch* batch, int count);
+void nexus_trs_compose_scalar(const NexusTRSBatch* batch, int count);
+
+#endif /* NEXUS3D_TRANSFORM_BATCH_H */
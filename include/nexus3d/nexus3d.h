@@ -21,23 +21,42 @@
 #include "nexus3d/physics/physics.h"
 #include "nexus3d/core/engine.h"
 #include "nexus3d/core/time.h"
+#include "nexus3d/core/jobs.h"
+#include "nexus3d/core/render_thread.h"
 
 /* Additional renderer includes */
 #include "nexus3d/renderer/camera.h"
 #include "nexus3d/renderer/mesh.h"
+#include "nexus3d/renderer/mesh_file.h"
+#include "nexus3d/renderer/mesh_optimize.h"
+#include "nexus3d/renderer/mesh_simplify.h"
+#include "nexus3d/renderer/vertex_layout.h"
 #include "nexus3d/renderer/material.h"
+#include "nexus3d/renderer/render_queue.h"
+#include "nexus3d/renderer/light_clusters.h"
+#include "nexus3d/renderer/shadow_atlas.h"
+#include "nexus3d/renderer/gpu_scene.h"
+#include "nexus3d/renderer/render_graph.h"
+#include "nexus3d/renderer/gpu_timer.h"
+#include "nexus3d/renderer/render_snapshot.h"
+#include "nexus3d/renderer/upload.h"
+#include "nexus3d/renderer/pipeline_cache.h"
+#include "nexus3d/renderer/shader_cache.h"
+#include "nexus3d/renderer/asset_loader.h"
 #include "nexus3d/renderer/shader.h"
 #include "nexus3d/renderer/texture.h"
 
 /* ECS includes */
 #include "nexus3d/ecs/components.h"
 #include "nexus3d/ecs/systems.h"
+#include "nexus3d/ecs/scene_file.h"
 
 /* Input includes */
 #include "nexus3d/input/input.h"
 
 /* Math includes */
 #include "nexus3d/math/math_utils.h"
+#include "nexus3d/math/transform_batch.h"
 
 /* Physics includes */
 #include "nexus3d/physics/physics.h"
@@ -47,6 +66,9 @@
 
 /* Utils */
 #include "nexus3d/utils/logger.h"
+#include "nexus3d/utils/profiler.h"
+#include "nexus3d/utils/mapped_file.h"
+#include "nexus3d/utils/allocator.h"
 
 /* Version info */
 #define NEXUS3D_VERSION_MAJOR 0
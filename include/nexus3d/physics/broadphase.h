@@ -0,0 +1,97 @@
+/**
+ * Nexus3D Physics Broadphase
+ * Dynamic AABB tree with incremental proxy updates and candidate pair generation
+ */
+
+#ifndef NEXUS3D_BROADPHASE_H
+#define NEXUS3D_BROADPHASE_H
+
+#include <cglm/cglm.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <flecs.h>
+
+/* Invalid node/proxy index */
+#define NEXUS_BROADPHASE_NULL (-1)
+
+/* Leaf bounds are enlarged by this much so small motions don't touch the tree */
+#define NEXUS_BROADPHASE_MARGIN 0.1f
+
+/* Traversal stack depth of queries (the tree is height balanced) */
+#define NEXUS_BROADPHASE_STACK_SIZE 256
+
+/**
+ * Tree node (leaves are proxies)
+ */
+typedef struct {
+    vec3 min;                      /* Fat bounds minimum */
+    vec3 max;                      /* Fat bounds maximum */
+    int32_t parent;                /* Parent node (next free node while on the free list) */
+    int32_t child1;                /* First child (NULL for leaves) */
+    int32_t child2;                /* Second child (NULL for leaves) */
+    int32_t height;                /* 0 for leaves, -1 for free nodes */
+    ecs_entity_t entity;           /* Entity owning a leaf */
+    bool moved;                    /* Leaf was reinserted since the last pair update */
+} NexusBroadphaseNode;
+
+/**
+ * Candidate pair (proxy_a < proxy_b)
+ */
+typedef struct {
+    int32_t proxy_a;               /* First proxy */
+    int32_t proxy_b;               /* Second proxy */
+    ecs_entity_t entity_a;         /* Entity of the first proxy */
+    ecs_entity_t entity_b;         /* Entity of the second proxy */
+} NexusBroadphasePair;
+
+/**
+ * Visitor called for every leaf a query reaches
+ * Returns false to stop the query
+ */
+typedef bool (*NexusBroadphaseQueryFunc)(void* user_data, int32_t proxy, ecs_entity_t entity);
+
+/**
+ * Visitor called for every leaf a ray reaches
+ * Returns the new maximum ray distance (the hit distance clips the ray), 0 stops the cast
+ */
+typedef float (*NexusBroadphaseRayFunc)(void* user_data, int32_t proxy, ecs_entity_t entity, float max_distance);
+
+/**
+ * Broadphase structure
+ */
+typedef struct {
+    /* Tree */
+    NexusBroadphaseNode* nodes;    /* Node pool */
+    int32_t node_capacity;         /* Allocated nodes */
+    int32_t node_count;            /* Nodes in use */
+    int32_t root;                  /* Root node */
+    int32_t free_list;             /* First free node */
+    int32_t proxy_count;           /* Leaves in the tree */
+
+    /* Proxies reinserted since the last pair update */
+    int32_t* move_buffer;          /* Moved proxies */
+    int32_t move_count;            /* Number of moved proxies */
+    int32_t move_capacity;         /* Allocated move capacity */
+
+    /* Candidate pairs (kept while the fat bounds overlap) */
+    NexusBroadphasePair* pairs;    /* Sorted, unique pairs */
+    int32_t pair_count;            /* Number of pairs */
+    int32_t pair_capacity;         /* Allocated pair capacity */
+} NexusBroadphase;
+
+/* Broadphase functions */
+NexusBroadphase* nexus_broadphase_create(void);
+void nexus_broadphase_destroy(NexusBroadphase* broadphase);
+int32_t nexus_broadphase_create_proxy(NexusBroadphase* broadphase, const vec3 min, const vec3 max, ecs_entity_t entity);
+void nexus_broadphase_destroy_proxy(NexusBroadphase* broadphase, int32_t proxy);
+bool nexus_broadphase_move_proxy(NexusBroadphase* broadphase, int32_t proxy, const vec3 min, const vec3 max);
+void nexus_broadphase_touch_proxy(NexusBroadphase* broadphase, int32_t proxy);
+int32_t nexus_broadphase_update_pairs(NexusBroadphase* broadphase);
+void nexus_broadphase_query(const NexusBroadphase* broadphase, const vec3 min, const vec3 max,
+                            NexusBroadphaseQueryFunc callback, void* user_data);
+void nexus_broadphase_raycast(const NexusBroadphase* broadphase, const vec3 origin, const vec3 direction,
+                              float max_distance, NexusBroadphaseRayFunc callback, void* user_data);
+bool nexus_broadphase_get_fat_bounds(const NexusBroadphase* broadphase, int32_t proxy, vec3 min, vec3 max);
+int32_t nexus_broadphase_get_height(const NexusBroadphase* broadphase);
+
+#endif /* NEXUS3D_BROADPHASE_H */
@@ -10,6 +10,10 @@
 #include <stdbool.h>
 #include <flecs.h>
 #include "../core/config.h"
+#include "nexus3d/ecs/components.h"
+#include "nexus3d/physics/broadphase.h"
+#include "nexus3d/utils/allocator.h"
+#include "nexus3d/core/jobs.h"
 
 /**
  * Collision shape type enumeration
@@ -40,6 +44,106 @@ typedef struct {
     } data;
 } NexusCollisionShape;
 
+/**
+ * Collider component
+ * Shape centered on the entity's position and oriented by its rotation
+ */
+typedef struct {
+    NexusCollisionShape shape;     /* Collision shape */
+    int32_t proxy;                 /* Broadphase proxy (valid when in_broadphase) */
+    bool in_broadphase;            /* Proxy has been created */
+} NexusColliderComponent;
+
+/**
+ * Contact produced by the narrowphase
+ */
+typedef struct {
+    ecs_entity_t entity_a;         /* First entity */
+    ecs_entity_t entity_b;         /* Second entity */
+    vec3 point;                    /* Contact point in world space */
+    vec3 normal;                   /* Contact normal pointing from a to b */
+    float penetration;             /* Penetration depth */
+} NexusPhysicsContact;
+
+/**
+ * Awake body gathered for a step
+ */
+typedef struct {
+    ecs_entity_t entity;           /* Body entity */
+    NexusPositionComponent* position; /* Position (written by the solver) */
+    NexusVelocityComponent* velocity; /* Velocity (written by the solver) */
+    NexusRigidBodyComponent* body; /* Rigid body state */
+    float inv_mass;                /* Inverse mass (0 = kinematic) */
+    int32_t parent;                /* Union-find parent while building islands */
+    int32_t island;                /* Island the body belongs to */
+} NexusPhysicsBody;
+
+/**
+ * Contact prepared for the solver
+ */
+typedef struct {
+    int32_t body_a;                /* Body slot of a (-1 = static or asleep) */
+    int32_t body_b;                /* Body slot of b (-1 = static or asleep) */
+    vec3 normal;                   /* Normal pointing from a to b */
+    float penetration;             /* Penetration depth */
+    float friction;                /* Combined friction */
+    float bounce;                  /* Target separating speed from restitution */
+    float normal_impulse;          /* Accumulated normal impulse */
+    float tangent_impulse[2];      /* Accumulated friction impulses */
+    vec3 tangent[2];               /* Friction directions */
+    int32_t island;                /* Island the contact belongs to */
+} NexusPhysicsSolverContact;
+
+/**
+ * Island of bodies connected by contacts, solved independently of the others
+ */
+typedef struct {
+    int32_t body_first;            /* First entry in the island body list */
+    int32_t body_count;            /* Bodies in the island */
+    int32_t contact_first;         /* First entry in the island contact list */
+    int32_t contact_count;         /* Contacts in the island */
+} NexusPhysicsIsland;
+
+/**
+ * Ray of a batched raycast
+ */
+typedef struct {
+    vec3 origin;                   /* Ray origin */
+    vec3 direction;                /* Ray direction (normalized by the cast) */
+    float max_distance;            /* Maximum hit distance */
+} NexusPhysicsRay;
+
+/**
+ * Closest hit of a ray
+ */
+typedef struct {
+    bool hit;                      /* Whether anything was hit */
+    ecs_entity_t entity;           /* Entity hit */
+    vec3 point;                    /* Hit point in world space */
+    vec3 normal;                   /* Surface normal at the hit point */
+    float distance;                /* Distance along the ray (max_distance on a miss) */
+} NexusPhysicsRayHit;
+
+/* Rays per job of a batched raycast, smaller batches stay on the caller */
+#define NEXUS_PHYSICS_RAYS_PER_JOB 64
+
+/**
+ * Collision detection statistics of the last step
+ */
+typedef struct {
+    uint32_t proxy_count;          /* Colliders in the broadphase */
+    uint32_t moved_count;          /* Proxies reinserted this step */
+    uint32_t pair_count;           /* Candidate pairs from the broadphase */
+    uint32_t contact_count;        /* Pairs the narrowphase confirmed */
+    int32_t tree_height;           /* Broadphase tree height */
+    uint32_t awake_bodies;         /* Bodies integrated this step */
+    uint32_t island_count;         /* Islands solved this step */
+    uint32_t islands_slept;        /* Islands that fell asleep this step */
+    double broadphase_ms;          /* Proxy updates and pair generation */
+    double narrowphase_ms;         /* Shape tests */
+    double solver_ms;              /* Island building and solving */
+} NexusPhysicsStats;
+
 /**
  * Physics material structure
  */
@@ -57,17 +161,49 @@ typedef struct {
     float fixed_timestep;  /* Fixed timestep for physics simulation */
     int max_substeps;      /* Maximum number of physics substeps per frame */
     bool debug_draw;       /* Debug drawing flag */
+    int solver_iterations; /* Velocity iterations per island */
+    float sleep_velocity;  /* Speed below which a body counts as still */
+    int sleep_frames;      /* Steps an island has to stay still before it sleeps */
 } NexusPhysicsExConfig;
 
 /**
  * Main physics system structure
  */
-typedef struct {
+typedef struct NexusPhysics {
     NexusPhysicsExConfig config;    /* Physics extended configuration */
     float accumulated_time;        /* Accumulated simulation time */
     ecs_world_t* world;            /* ECS world reference */
     bool paused;                   /* Physics paused flag */
     int iteration_count;           /* Iteration count in current frame */
+
+    /* Fixed step */
+    ecs_entity_t phase;            /* Phase of systems that run once per fixed step */
+    ecs_entity_t pipeline;         /* Pipeline running only the fixed step phase */
+    ecs_query_t* interpolation_query; /* Entities rendered between the last two steps */
+    float interpolation_alpha;     /* Fraction of a step the render state lags behind */
+    NexusJobSystem* jobs;          /* Runs narrowphase, island and raycast jobs (optional) */
+
+    /* Collision detection */
+    NexusBroadphase* broadphase;   /* Dynamic AABB tree of all colliders */
+    ecs_query_t* collider_query;   /* Colliders with position and optional rotation */
+    ecs_entity_t collider_observer; /* Removes proxies of removed colliders */
+    NexusPhysicsContact* contacts; /* Contacts of the last step (one slot per pair) */
+    uint32_t contact_count;        /* Number of contacts */
+    uint32_t contact_capacity;     /* Allocated contact capacity */
+    NexusPhysicsStats stats;       /* Statistics of the last step */
+
+    /* Solver */
+    ecs_query_t* body_query;       /* Rigid bodies with velocity and position */
+    NexusPhysicsBody* bodies;      /* Awake bodies of the current step */
+    uint32_t body_count;           /* Number of awake bodies */
+    uint32_t body_capacity;        /* Allocated body capacity */
+    NexusPhysicsSolverContact* solver_contacts; /* Contacts grouped by island */
+    uint32_t solver_contact_count; /* Number of solver contacts */
+    uint32_t solver_contact_capacity; /* Allocated solver contact capacity */
+    NexusPhysicsIsland* islands;   /* Islands of the current step */
+    int32_t* island_bodies;        /* Body slots grouped by island */
+    uint32_t island_count;         /* Number of islands */
+    uint32_t island_capacity;      /* Allocated island (and island body) capacity */
 } NexusPhysics;
 
 /* Physics system functions */
@@ -82,6 +218,15 @@ void nexus_physics_pause(NexusPhysics* physics, bool paused);
 bool nexus_physics_is_paused(const NexusPhysics* physics);
 void nexus_physics_set_debug_draw(NexusPhysics* physics, bool enabled);
 bool nexus_physics_get_debug_draw(const NexusPhysics* physics);
+void nexus_physics_step(NexusPhysics* physics, float dt);
+void nexus_physics_detect_collisions(NexusPhysics* physics);
+void nexus_physics_wake_body(NexusPhysics* physics, ecs_entity_t entity);
+void nexus_physics_apply_impulse(NexusPhysics* physics, ecs_entity_t entity, const vec3 impulse);
+const NexusPhysicsContact* nexus_physics_get_contacts(const NexusPhysics* physics, uint32_t* count);
+NexusPhysicsStats nexus_physics_get_stats(const NexusPhysics* physics);
+ecs_entity_t nexus_physics_get_phase(const NexusPhysics* physics);
+float nexus_physics_get_interpolation_alpha(const NexusPhysics* physics);
+void nexus_physics_set_job_system(NexusPhysics* physics, NexusJobSystem* jobs);
 
 /* Collision shape functions */
 NexusCollisionShape* nexus_collision_shape_create_box(float width, float height, float depth);
@@ -91,6 +236,9 @@ NexusCollisionShape* nexus_collision_shape_create_cylinder(float radius, float h
 NexusCollisionShape* nexus_collision_shape_create_cone(float radius, float height);
 NexusCollisionShape* nexus_collision_shape_create_convex_hull(const float* vertices, int vertex_count);
 void nexus_collision_shape_destroy(NexusCollisionShape* shape);
+NexusPoolStats nexus_collision_shape_get_pool_stats(void);
+bool nexus_collision_shape_get_bounds(const NexusCollisionShape* shape, const vec3 position, const versor rotation,
+                                      vec3 min, vec3 max);
 
 /* Physics material functions */
 NexusPhysicsMaterial* nexus_physics_material_create(void);
@@ -100,10 +248,13 @@ void nexus_physics_material_set_restitution(NexusPhysicsMaterial* material, floa
 void nexus_physics_material_set_density(NexusPhysicsMaterial* material, float density);
 
 /* ECS component registration */
+extern ECS_COMPONENT_DECLARE(NexusColliderComponent);
 void nexus_physics_register_components(ecs_world_t* world);
 
 /* Raycast functions */
 bool nexus_physics_raycast(NexusPhysics* physics, const vec3 origin, const vec3 direction, float max_distance,
                          ecs_entity_t* hit_entity, vec3 hit_point, vec3 hit_normal, float* hit_distance);
+uint32_t nexus_physics_raycast_batch(NexusPhysics* physics, const NexusPhysicsRay* rays, NexusPhysicsRayHit* hits,
+                                     uint32_t count);
 
 #endif /* NEXUS3D_PHYSICS_H */
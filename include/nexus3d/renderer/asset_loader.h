@@ -0,0 +1,142 @@
+/**
+ * Nexus3D Asset Loader
+ * Asynchronous mesh and texture streaming: files are read and decoded on the
+ * job system, the results are uploaded through the shared staging ring
+ */
+
+#ifndef NEXUS3D_ASSET_LOADER_H
+#define NEXUS3D_ASSET_LOADER_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "nexus3d/core/jobs.h"
+#include "nexus3d/renderer/mesh.h"
+#include "nexus3d/renderer/texture.h"
+#include "nexus3d/utils/allocator.h"
+
+/* Maximum length of an asset path */
+#define NEXUS_ASSET_MAX_PATH 256
+
+/* Defaults of the streaming limits */
+#define NEXUS_ASSET_DEFAULT_MAX_IN_FLIGHT 8
+#define NEXUS_ASSET_DEFAULT_UPLOAD_BUDGET (8u * 1024u * 1024u)
+
+/**
+ * Asset type enumeration
+ */
+typedef enum {
+    NEXUS_ASSET_MESH,               /* Cooked (.nxm) or Wavefront OBJ mesh */
+    NEXUS_ASSET_TEXTURE             /* Image texture */
+} NexusAssetType;
+
+/**
+ * Asset state enumeration
+ */
+typedef enum {
+    NEXUS_ASSET_QUEUED,             /* Waiting for a decode job */
+    NEXUS_ASSET_LOADING,            /* Being read and decoded */
+    NEXUS_ASSET_DECODED,            /* Waiting for its upload */
+    NEXUS_ASSET_READY,              /* GPU resource can be used */
+    NEXUS_ASSET_FAILED              /* Loading failed */
+} NexusAssetState;
+
+struct NexusAsset;
+
+/**
+ * Completion callback, called on the thread updating the loader once the
+ * asset is ready or has failed. It may load more assets and release the
+ * asset it is called for
+ */
+typedef void (*NexusAssetCallback)(struct NexusAsset* asset, void* user_data);
+
+/**
+ * Asset handle
+ */
+typedef struct NexusAsset {
+    struct NexusAssetLoader* loader; /* Owning loader */
+    NexusAssetType type;            /* Asset type */
+    SDL_AtomicInt state;            /* NexusAssetState */
+    char path[NEXUS_ASSET_MAX_PATH]; /* Source file */
+    bool generate_mipmaps;          /* Textures get a mip chain */
+    bool released;                  /* Released while its decode job was running */
+
+    /* Prioritization */
+    float position[3];              /* World position the asset is needed at */
+    bool has_position;              /* Without a position it loads before positioned assets */
+    float distance_sq;              /* Squared camera distance of the last update */
+
+    /* Completion */
+    NexusAssetCallback callback;    /* Called once ready or failed (optional) */
+    void* user_data;                /* Callback argument */
+    NexusJobCounter done;           /* Released when the decode job finished */
+    bool decode_success;            /* Result of the decode job */
+
+    /* Decoded data (written by the decode job) */
+    NexusMeshData mesh_data;        /* Mesh vertices and indices */
+    NexusImageData image;           /* Texture texels */
+
+    /* GPU resource (owned by the asset) */
+    NexusMesh* mesh;                /* Loaded mesh */
+    NexusTexture* texture;          /* Loaded texture */
+
+    /* Loader bookkeeping */
+    struct NexusAsset* prev;        /* Previous live asset */
+    struct NexusAsset* next;        /* Next live asset */
+} NexusAsset;
+
+/**
+ * Asset loader statistics
+ */
+typedef struct {
+    uint32_t queued;                /* Requests waiting for a decode job */
+    uint32_t in_flight;             /* Requests being decoded or waiting for their upload */
+    uint32_t loaded;                /* Assets that became ready */
+    uint32_t failed;                /* Assets that failed to load */
+    uint64_t bytes_uploaded;        /* Decoded bytes handed to the upload ring */
+} NexusAssetLoaderStats;
+
+/**
+ * Asset loader structure
+ */
+typedef struct NexusAssetLoader {
+    SDL_GPUDevice* device;          /* GPU device the resources are created on */
+    NexusJobSystem* jobs;           /* Runs the decode jobs (NULL = decode during updates) */
+    NexusPool asset_pool;           /* Asset handles */
+    NexusAsset* assets;             /* Live assets */
+
+    /* Requests that are not ready yet, sorted by camera distance on update */
+    NexusAsset** pending;           /* Queued, loading and decoded assets */
+    uint32_t pending_count;         /* Number of pending assets */
+    uint32_t pending_capacity;      /* Allocated pending capacity */
+
+    /* Limits */
+    uint32_t max_in_flight;         /* Decode jobs running at the same time */
+    uint32_t upload_budget;         /* Decoded bytes uploaded per update */
+    uint32_t vertex_layout;         /* NEXUS_VERTEX_LAYOUT_* of streamed meshes */
+
+    NexusAssetLoaderStats stats;    /* Statistics */
+} NexusAssetLoader;
+
+/* Asset loader functions */
+NexusAssetLoader* nexus_asset_loader_create(SDL_GPUDevice* device, NexusJobSystem* jobs);
+void nexus_asset_loader_destroy(NexusAssetLoader* loader);
+void nexus_asset_loader_set_limits(NexusAssetLoader* loader, uint32_t max_in_flight, uint32_t upload_budget);
+void nexus_asset_loader_set_vertex_layout(NexusAssetLoader* loader, uint32_t vertex_layout);
+void nexus_asset_loader_update(NexusAssetLoader* loader, const float* camera_position);
+void nexus_asset_loader_wait(NexusAssetLoader* loader);
+NexusAssetLoaderStats nexus_asset_loader_get_stats(const NexusAssetLoader* loader);
+
+/* Asset functions */
+NexusAsset* nexus_asset_load_mesh(NexusAssetLoader* loader, const char* path, NexusAssetCallback callback,
+                                  void* user_data);
+NexusAsset* nexus_asset_load_texture(NexusAssetLoader* loader, const char* path, bool generate_mipmaps,
+                                     NexusAssetCallback callback, void* user_data);
+void nexus_asset_release(NexusAsset* asset);
+void nexus_asset_set_position(NexusAsset* asset, float x, float y, float z);
+NexusAssetState nexus_asset_get_state(NexusAsset* asset);
+bool nexus_asset_is_ready(NexusAsset* asset);
+NexusMesh* nexus_asset_get_mesh(NexusAsset* asset);
+NexusTexture* nexus_asset_get_texture(NexusAsset* asset);
+
+#endif /* NEXUS3D_ASSET_LOADER_H */
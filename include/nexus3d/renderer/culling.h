@@ -0,0 +1,40 @@
+/**
+ * Nexus3D Culling
+ * Packed bounding box buffer and SIMD frustum tests
+ */
+
+#ifndef NEXUS3D_CULLING_H
+#define NEXUS3D_CULLING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <cglm/cglm.h>
+
+/* Boxes are tested in batches of this size, arrays are padded to it */
+#define NEXUS_CULLING_BATCH 8
+
+/**
+ * Culling buffer structure
+ * World-space AABBs stored as center/extent in structure-of-arrays form
+ */
+typedef struct NexusCullingBuffer {
+    float* center_x;               /* Box centers */
+    float* center_y;
+    float* center_z;
+    float* extent_x;               /* Box half extents */
+    float* extent_y;
+    float* extent_z;
+    uint8_t* visible;              /* Test result per box (1 = visible) */
+    uint32_t count;                /* Number of boxes */
+    uint32_t capacity;             /* Allocated box capacity (multiple of NEXUS_CULLING_BATCH) */
+    void* memory;                  /* Single allocation backing all arrays */
+} NexusCullingBuffer;
+
+/* Culling buffer functions */
+NexusCullingBuffer* nexus_culling_buffer_create(uint32_t capacity);
+void nexus_culling_buffer_destroy(NexusCullingBuffer* buffer);
+void nexus_culling_buffer_reset(NexusCullingBuffer* buffer);
+bool nexus_culling_buffer_add(NexusCullingBuffer* buffer, const float* min, const float* max);
+uint32_t nexus_culling_buffer_test(NexusCullingBuffer* buffer, const vec4 planes[6]);
+
+#endif /* NEXUS3D_CULLING_H */
@@ -0,0 +1,125 @@
+/**
+ * Nexus3D GPU Scene
+ * Persistent object storage for GPU-driven rendering, culled by a compute
+ * pass that writes indirect draw arguments
+ */
+
+#ifndef NEXUS3D_GPU_SCENE_H
+#define NEXUS3D_GPU_SCENE_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <cglm/cglm.h>
+#include "nexus3d/renderer/material.h"
+#include "nexus3d/renderer/mesh.h"
+#include "nexus3d/renderer/shader.h"
+#include "nexus3d/renderer/upload.h"
+
+/* Objects handled by one compute invocation group */
+#define NEXUS_GPU_SCENE_WORKGROUP_SIZE 64
+
+/* Object flags (NexusGpuObject.flags, 0 = free slot) */
+#define NEXUS_GPU_OBJECT_ACTIVE (1u << 0)
+
+/**
+ * Cull shader contract
+ * One invocation per object slot, NEXUS_GPU_SCENE_WORKGROUP_SIZE per group
+ *   read-only storage slot 0  - NexusGpuObject[]
+ *   read-write storage slot 0 - SDL_GPUIndexedIndirectDrawCommand[] (one per draw)
+ *   read-write storage slot 1 - mat4[] instance transforms
+ *   uniform slot 0            - NexusGpuCullUniforms
+ * An active object whose bounds are inside all six planes,
+ *   dot(plane.xyz, center) + dot(abs(plane.xyz), extent) + plane.w >= 0
+ * takes an instance with
+ *   instance = draws[draw].first_instance + atomicAdd(draws[draw].num_instances, 1)
+ * and copies its transform to instances[instance]
+ */
+
+/**
+ * Object as stored in the object storage buffer (std430)
+ */
+typedef struct {
+    float transform[16];           /* World transform (column major) */
+    float center[4];               /* World AABB center (xyz) */
+    float extent[4];               /* World AABB half size (xyz) */
+    uint32_t draw;                 /* Indirect draw the object is counted into */
+    uint32_t flags;                /* NEXUS_GPU_OBJECT_* */
+    uint32_t reserved[2];          /* Padding, zero */
+} NexusGpuObject;
+
+/**
+ * Cull pass uniform block
+ */
+typedef struct {
+    float planes[6][4];            /* Frustum planes, normals point inwards */
+    uint32_t object_count;         /* Object slots to test */
+    uint32_t reserved[3];          /* Padding, zero */
+} NexusGpuCullUniforms;
+
+/**
+ * Draw shared by the objects with the same mesh level and material
+ */
+typedef struct {
+    NexusMesh* mesh;               /* Mesh to draw (NULL = free slot) */
+    uint32_t lod;                  /* Detail level of the mesh */
+    NexusMaterial* material;       /* Material providing shader and state */
+    uint32_t object_count;         /* Objects counted into the draw */
+    uint32_t first_instance;       /* Instance range of the draw, assigned at upload */
+} NexusGpuDraw;
+
+/**
+ * GPU scene structure
+ */
+typedef struct NexusGpuScene {
+    /* Objects, mirrored on the CPU so updates only upload what changed */
+    NexusGpuObject* objects;       /* Object slots */
+    uint32_t object_count;         /* Slots in use, including freed ones below the top */
+    uint32_t object_capacity;      /* Allocated slots */
+    uint32_t live_count;           /* Active objects */
+    uint32_t* free_slots;          /* Freed slots below object_count */
+    uint32_t free_count;           /* Number of freed slots */
+    uint32_t* dirty;               /* Slots changed since the last upload */
+    uint32_t dirty_count;          /* Number of dirty slots */
+    uint8_t* dirty_flags;          /* Slot is in the dirty list */
+    bool upload_all;               /* The object buffer was recreated */
+
+    /* Draws */
+    NexusGpuDraw* draws;           /* Draw slots */
+    uint32_t draw_count;           /* Slots in use, including freed ones */
+    uint32_t draw_capacity;        /* Allocated draw slots */
+    uint32_t* draw_table;          /* Open addressing table of draw indices + 1 */
+    uint32_t draw_table_capacity;  /* Table size (power of two) */
+
+    /* GPU resources */
+    SDL_GPUDevice* device;         /* GPU device reference */
+    SDL_GPUComputePipeline* cull_pipeline; /* Cull shader (NULL = scene cannot be drawn) */
+    SDL_GPUBuffer* object_buffer;  /* object_capacity objects */
+    uint32_t object_buffer_capacity; /* Objects the buffer can hold */
+    SDL_GPUBuffer* draw_buffer;    /* Indirect draw arguments */
+    uint32_t draw_buffer_capacity; /* Draws the buffer can hold */
+    SDL_GPUBuffer* instance_buffer; /* Transforms of the visible objects (vertex + storage) */
+    uint32_t instance_buffer_capacity; /* Instances the buffer can hold */
+    uint32_t instance_count;       /* Instances reserved by the last upload */
+
+    SDL_Mutex* lock;               /* Serializes object changes against upload and draws */
+} NexusGpuScene;
+
+/* GPU scene functions */
+NexusGpuScene* nexus_gpu_scene_create(SDL_GPUDevice* device);
+void nexus_gpu_scene_destroy(NexusGpuScene* scene);
+void nexus_gpu_scene_lock(NexusGpuScene* scene);
+void nexus_gpu_scene_unlock(NexusGpuScene* scene);
+bool nexus_gpu_scene_load_cull_shader(NexusGpuScene* scene, NexusShaderLanguage language, const char* filename);
+uint32_t nexus_gpu_scene_add_object(NexusGpuScene* scene, NexusMesh* mesh, uint32_t lod, NexusMaterial* material,
+                                    const float* transform, const float* bounds_min, const float* bounds_max);
+bool nexus_gpu_scene_update_object(NexusGpuScene* scene, uint32_t handle, NexusMesh* mesh, uint32_t lod,
+                                   NexusMaterial* material, const float* transform, const float* bounds_min,
+                                   const float* bounds_max);
+void nexus_gpu_scene_remove_object(NexusGpuScene* scene, uint32_t handle);
+bool nexus_gpu_scene_accepts(const NexusGpuScene* scene, const NexusMesh* mesh, const NexusMaterial* material);
+uint32_t nexus_gpu_scene_get_object_count(const NexusGpuScene* scene);
+bool nexus_gpu_scene_upload(NexusGpuScene* scene, NexusUploadManager* manager);
+bool nexus_gpu_scene_cull(NexusGpuScene* scene, SDL_GPUCommandBuffer* cmd_buffer, const vec4 planes[6]);
+
+#endif /* NEXUS3D_GPU_SCENE_H */
@@ -0,0 +1,57 @@
+/**
+ * Nexus3D GPU Timer
+ * GPU frame timings without stalling the CPU: every frame is submitted with
+ * a fence that is polled a few frames later, the time from the GPU starting
+ * on the frame to its fence being seen signaled is the frame's GPU time
+ * SDL_GPU exposes no timestamp queries, so timings are per submission and
+ * bounded by how often the fences are polled
+ */
+
+#ifndef NEXUS3D_GPU_TIMER_H
+#define NEXUS3D_GPU_TIMER_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Frames whose fences can be pending at once, later submissions go untimed */
+#define NEXUS_GPU_TIMER_FRAMES 4
+
+/**
+ * Submitted frame waiting for its fence
+ */
+typedef struct {
+    SDL_GPUFence* fence;           /* Signaled when the frame's commands executed */
+    const char* name;              /* Submission name on the profiler's GPU track */
+    uint64_t submit_time;          /* Performance counter at submission */
+    uint64_t index;                /* Submission index */
+} NexusGpuTimerFrame;
+
+/**
+ * GPU timer structure
+ */
+typedef struct {
+    NexusGpuTimerFrame frames[NEXUS_GPU_TIMER_FRAMES]; /* Pending frames, oldest first */
+    uint32_t frame_count;          /* Number of pending frames */
+    uint64_t submitted;            /* Submissions so far */
+    uint64_t last_complete;        /* Performance counter the last frame was seen complete at */
+    uint64_t frequency;            /* Performance counter ticks per second */
+
+    /* Results */
+    double gpu_time;               /* GPU time per frame of the last resolve in ms */
+    double avg_gpu_time;           /* Smoothed GPU time in ms */
+    uint32_t latency;              /* Submissions the last result trailed by */
+    uint32_t untimed_count;        /* Submissions not timed because all slots were pending */
+
+    SDL_GPUDevice* device;         /* GPU device reference */
+} NexusGpuTimer;
+
+/* GPU timer functions */
+NexusGpuTimer* nexus_gpu_timer_create(SDL_GPUDevice* device);
+void nexus_gpu_timer_destroy(NexusGpuTimer* timer);
+bool nexus_gpu_timer_submit(NexusGpuTimer* timer, SDL_GPUCommandBuffer* cmd_buffer, const char* name);
+uint32_t nexus_gpu_timer_resolve(NexusGpuTimer* timer);
+double nexus_gpu_timer_get_time(const NexusGpuTimer* timer);
+double nexus_gpu_timer_get_avg_time(const NexusGpuTimer* timer);
+
+#endif /* NEXUS3D_GPU_TIMER_H */
@@ -0,0 +1,106 @@
+/**
+ * Nexus3D Light Clusters
+ * Per-frame binning of lights into a view space froxel grid for clustered
+ * forward shading
+ */
+
+#ifndef NEXUS3D_LIGHT_CLUSTERS_H
+#define NEXUS3D_LIGHT_CLUSTERS_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "nexus3d/renderer/upload.h"
+
+/**
+ * Cluster grid
+ * Tiles are numbered from the top left like fragment coordinates, depth
+ * slices are exponential between the camera's near and far planes. Shaders
+ * use the same constants to find their cluster:
+ *   tile  = floor(fragCoord.xy * u_clusterScale.xy)
+ *   slice = floor(log(viewDepth) * u_clusterScale.z + u_clusterScale.w)
+ *   index = tile.x + tile.y * GRID_X + slice * GRID_X * GRID_Y
+ */
+#define NEXUS_CLUSTER_GRID_X 16
+#define NEXUS_CLUSTER_GRID_Y 9
+#define NEXUS_CLUSTER_GRID_Z 24
+#define NEXUS_CLUSTER_COUNT (NEXUS_CLUSTER_GRID_X * NEXUS_CLUSTER_GRID_Y * NEXUS_CLUSTER_GRID_Z)
+
+/* Lights per frame (size of the light storage buffer) */
+#define NEXUS_MAX_LIGHTS 1024
+
+/* Light types (NexusLightData.direction_type[3], same values as NexusLightType) */
+#define NEXUS_LIGHT_TYPE_DIRECTIONAL 0
+#define NEXUS_LIGHT_TYPE_POINT       1
+#define NEXUS_LIGHT_TYPE_SPOT        2
+
+/* Cluster flags (u_clusterInfo.z) */
+#define NEXUS_CLUSTER_FLAG_HEATMAP (1u << 0) /* Shade lights per cluster instead of lighting */
+
+/**
+ * Light as stored in the light storage buffer (std430, world space)
+ * Directional lights come first and apply everywhere, the others are
+ * reached through the cluster index list
+ */
+typedef struct {
+    float position_range[4];       /* Position (xyz) and range (w) */
+    float color_intensity[4];      /* Color (xyz) and intensity (w) */
+    float direction_type[4];       /* Direction the light points in (xyz) and NEXUS_LIGHT_TYPE_* (w) */
+    float spot[4];                 /* Cosines of the outer (x) and inner (y) spot cone half angles, first shadow view (z) and view count (w) */
+} NexusLightData;
+
+/**
+ * Cluster entry, a range of the light index list
+ */
+typedef struct {
+    uint32_t offset;               /* First light index of the cluster */
+    uint32_t count;                /* Lights affecting the cluster */
+} NexusLightCluster;
+
+/**
+ * Light clusters structure
+ */
+typedef struct NexusLightClusters {
+    /* Lights of the frame */
+    NexusLightData* lights;        /* Lights, directional ones first after building */
+    uint32_t light_count;          /* Number of lights */
+    uint32_t directional_count;    /* Directional lights at the start of lights */
+
+    /* Binning results */
+    NexusLightCluster* clusters;   /* NEXUS_CLUSTER_COUNT entries */
+    uint32_t* indices;             /* Light index list */
+    uint32_t index_count;          /* Used light indices */
+    uint32_t index_capacity;       /* Allocated light indices */
+    uint32_t max_cluster_lights;   /* Most lights in one cluster */
+    bool built;                    /* Binned since the last reset */
+
+    /* View space cluster bounds, rebuilt when the projection changes */
+    float* bounds;                 /* Min xyz and max xyz per cluster */
+    float bounds_key[7];           /* Projection terms and planes the bounds were built for */
+    float slice_scale;             /* Depth slice = log(depth) * scale + bias */
+    float slice_bias;
+
+    /* Per-light working data */
+    float* spheres;                /* View space bounding sphere per light (xyz, radius) */
+    uint8_t* ranges;               /* Cluster range per light (x, y, z min and max) */
+
+    /* GPU buffers */
+    SDL_GPUDevice* device;         /* GPU device reference */
+    SDL_GPUBuffer* light_buffer;   /* NEXUS_MAX_LIGHTS lights */
+    SDL_GPUBuffer* cluster_buffer; /* NEXUS_CLUSTER_COUNT cluster entries */
+    SDL_GPUBuffer* index_buffer;   /* Light index list */
+    uint32_t index_buffer_capacity; /* Indices the index buffer can hold */
+} NexusLightClusters;
+
+/* Light cluster functions */
+NexusLightClusters* nexus_light_clusters_create(SDL_GPUDevice* device);
+void nexus_light_clusters_destroy(NexusLightClusters* clusters);
+void nexus_light_clusters_reset(NexusLightClusters* clusters);
+bool nexus_light_clusters_add(NexusLightClusters* clusters, const NexusLightData* light);
+bool nexus_light_clusters_build(NexusLightClusters* clusters, const float* view, const float* projection,
+                                float near_plane, float far_plane);
+bool nexus_light_clusters_upload(NexusLightClusters* clusters, NexusUploadManager* manager);
+void nexus_light_clusters_bind(const NexusLightClusters* clusters, SDL_GPURenderPass* render_pass);
+uint32_t nexus_light_clusters_get_heatmap(const NexusLightClusters* clusters, uint32_t* tiles);
+
+#endif /* NEXUS3D_LIGHT_CLUSTERS_H */
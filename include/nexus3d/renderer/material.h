@@ -74,6 +74,7 @@ void nexus_material_set_two_sided(NexusMaterial* material, bool two_sided);
 void nexus_material_set_wireframe(NexusMaterial* material, bool wireframe);
 void nexus_material_set_cast_shadows(NexusMaterial* material, bool cast_shadows);
 void nexus_material_set_receive_shadows(NexusMaterial* material, bool receive_shadows);
-void nexus_material_apply(NexusMaterial* material, SDL_GPURenderPass* render_pass);
+void nexus_material_apply(NexusMaterial* material, SDL_GPUCommandBuffer* cmd_buffer, SDL_GPURenderPass* render_pass);
+void nexus_material_apply_parameters(NexusMaterial* material, SDL_GPUCommandBuffer* cmd_buffer);
 
 #endif /* NEXUS3D_MATERIAL_H */
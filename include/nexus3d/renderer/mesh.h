@@ -8,16 +8,44 @@
 
 #include <SDL3/SDL.h>
 #include <stdbool.h>
+#include "nexus3d/utils/allocator.h"
+#include "nexus3d/utils/mapped_file.h"
+#include "nexus3d/renderer/vertex_layout.h"
+
+/* Meshlet size limits (cluster culling granularity) */
+#define NEXUS_MESHLET_MAX_VERTICES 64
+#define NEXUS_MESHLET_MAX_TRIANGLES 124
+
+/* Meshes with at most this many vertices get 16-bit indices */
+#define NEXUS_MESH_MAX_16BIT_VERTICES 65536u
+
+/* Detail levels per mesh */
+#define NEXUS_MESH_MAX_LODS 8
+
+/* Error assumed for the first coarse level of artist LODs, doubling per level */
+#define NEXUS_MESH_LOD_ARTIST_ERROR 0.01f
+
+/**
+ * Meshlet, a contiguous run of triangles with a bounding sphere
+ */
+typedef struct {
+    uint32_t index_offset;             /* First index of the meshlet */
+    uint32_t index_count;              /* Indices of the meshlet (3 per triangle) */
+    float center[3];                   /* Bounding sphere center */
+    float radius;                      /* Bounding sphere radius */
+} NexusMeshlet;
 
 /**
- * Vertex structure
+ * Level of detail, a range of the index buffer and its meshlets
  */
 typedef struct {
-    float position[3];  /* x, y, z */
-    float normal[3];    /* nx, ny, nz */
-    float texcoord[2];  /* u, v */
-    float color[4];     /* r, g, b, a */
-} NexusVertex;
+    uint32_t index_offset;             /* First index of the level */
+    uint32_t index_count;              /* Indices of the level */
+    uint32_t meshlet_offset;           /* First meshlet of the level */
+    uint32_t meshlet_count;            /* Meshlets of the level */
+    float error;                       /* Simplification error relative to the mesh radius (0 = full detail) */
+    uint32_t reserved;                 /* Padding, zero */
+} NexusMeshLod;
 
 /**
  * Mesh structure
@@ -25,19 +53,62 @@ typedef struct {
 typedef struct NexusMesh {
     SDL_GPUBuffer* vertex_buffer;      /* Vertex buffer */
     SDL_GPUBuffer* index_buffer;       /* Index buffer */
+    SDL_GPUBuffer* position_buffer;    /* Position only stream for depth passes (optional) */
     uint32_t vertex_count;             /* Number of vertices */
     uint32_t index_count;              /* Number of indices */
+    uint32_t vertex_layout;            /* NEXUS_VERTEX_LAYOUT_* of the vertex buffer */
+    bool position_stream;              /* Also keep a position only stream */
+    SDL_GPUIndexElementSize index_size; /* Index element size of the index buffer */
     SDL_GPUDevice* device;             /* GPU device reference */
-    SDL_GPUTransferBuffer* transfer_buffer; /* Transfer buffer for uploads */
     bool has_indices;                  /* Whether the mesh has indices */
+    float bounds_min[3];               /* Local space AABB minimum */
+    float bounds_max[3];               /* Local space AABB maximum */
+    NexusMeshLod* lods;                /* Detail levels (NULL = the whole index buffer) */
+    uint32_t lod_count;                /* Number of detail levels */
+    NexusMeshlet* meshlets;            /* Meshlets of all levels */
+    uint32_t meshlet_count;            /* Number of meshlets */
 } NexusMesh;
 
+/**
+ * Mesh data in CPU memory
+ * Arrays are malloc'd, or point into file when it was loaded from a cooked mesh
+ */
+typedef struct {
+    NexusVertex* vertices;             /* Vertices */
+    uint32_t vertex_count;             /* Number of vertices */
+    uint32_t* indices;                 /* Triangle list indices */
+    uint16_t* indices16;               /* 16-bit indices, used instead of indices when set */
+    uint32_t index_count;              /* Number of indices */
+    NexusMeshLod* lods;                /* Detail levels (optional) */
+    uint32_t lod_count;                /* Number of detail levels */
+    NexusMeshlet* meshlets;            /* Meshlets (optional) */
+    uint32_t meshlet_count;            /* Number of meshlets */
+    float bounds_min[3];               /* Local space AABB minimum */
+    float bounds_max[3];               /* Local space AABB maximum */
+    bool has_bounds;                   /* Bounds are valid, so they aren't recomputed on upload */
+    uint32_t vertex_layout;            /* NEXUS_VERTEX_LAYOUT_* the mesh is uploaded in */
+    bool position_stream;              /* Upload a position only stream as well */
+    NexusMappedFile file;              /* Cooked mesh file the arrays point into */
+} NexusMeshData;
+
 /* Mesh functions */
 NexusMesh* nexus_mesh_create(SDL_GPUDevice* device);
 void nexus_mesh_destroy(NexusMesh* mesh);
 bool nexus_mesh_set_vertices(NexusMesh* mesh, const NexusVertex* vertices, uint32_t vertex_count);
 bool nexus_mesh_set_indices(NexusMesh* mesh, const uint32_t* indices, uint32_t index_count);
+bool nexus_mesh_set_indices16(NexusMesh* mesh, const uint16_t* indices, uint32_t index_count);
+void nexus_mesh_set_vertex_layout(NexusMesh* mesh, uint32_t vertex_layout, bool position_stream);
+uint32_t nexus_mesh_get_vertex_layout(const NexusMesh* mesh);
 uint32_t nexus_mesh_draw(NexusMesh* mesh, SDL_GPURenderPass* render_pass);
+void nexus_mesh_get_bounds(const NexusMesh* mesh, float* min, float* max);
+void nexus_mesh_bind(NexusMesh* mesh, SDL_GPURenderPass* render_pass);
+bool nexus_mesh_bind_positions(NexusMesh* mesh, SDL_GPURenderPass* render_pass);
+uint32_t nexus_mesh_draw_bound(NexusMesh* mesh, SDL_GPURenderPass* render_pass);
+uint32_t nexus_mesh_draw_instanced(NexusMesh* mesh, SDL_GPURenderPass* render_pass, uint32_t instance_count, uint32_t first_instance);
+uint32_t nexus_mesh_draw_lod_instanced(NexusMesh* mesh, SDL_GPURenderPass* render_pass, uint32_t lod, uint32_t instance_count, uint32_t first_instance);
+bool nexus_mesh_set_lods(NexusMesh* mesh, const NexusMeshLod* lods, uint32_t lod_count);
+uint32_t nexus_mesh_get_lod_count(const NexusMesh* mesh);
+NexusPoolStats nexus_mesh_get_pool_stats(void);
 
 /* Primitive creation functions */
 NexusMesh* nexus_mesh_create_plane(SDL_GPUDevice* device, float width, float height, uint32_t width_segments, uint32_t height_segments);
@@ -48,6 +119,9 @@ NexusMesh* nexus_mesh_create_cone(SDL_GPUDevice* device, float radius, float hei
 NexusMesh* nexus_mesh_create_torus(SDL_GPUDevice* device, float radius, float tube_radius, uint32_t radial_segments, uint32_t tubular_segments);
 
 /* Mesh loading functions */
+NexusMesh* nexus_mesh_create_from_data(SDL_GPUDevice* device, const NexusMeshData* data);
+void nexus_mesh_data_free(NexusMeshData* data);
 NexusMesh* nexus_mesh_load_obj(SDL_GPUDevice* device, const char* filename);
+NexusMesh* nexus_mesh_load_cooked(SDL_GPUDevice* device, const char* filename);
 
 #endif /* NEXUS3D_MESH_H */
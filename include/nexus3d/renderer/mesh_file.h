@@ -0,0 +1,53 @@
+/**
+ * Nexus3D Mesh Files
+ * One pass OBJ importer and the cooked mesh format, a memory mappable image
+ * of the GPU buffers that uploads without per-vertex work
+ */
+
+#ifndef NEXUS3D_MESH_FILE_H
+#define NEXUS3D_MESH_FILE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "nexus3d/renderer/mesh.h"
+
+/* File identification ("NXMH") */
+#define NEXUS_MESH_FILE_MAGIC   0x484D584Eu
+#define NEXUS_MESH_FILE_VERSION 1u
+
+/* Cooked mesh file extension */
+#define NEXUS_MESH_FILE_EXTENSION ".nxm"
+
+/* Sections start at multiples of this many bytes */
+#define NEXUS_MESH_FILE_ALIGNMENT 16u
+
+/**
+ * Cooked mesh file header
+ * Followed by the vertex, index, LOD and meshlet sections at the given
+ * offsets, all little endian and laid out as their in-memory structures
+ */
+typedef struct {
+    uint32_t magic;                    /* NEXUS_MESH_FILE_MAGIC */
+    uint32_t version;                  /* NEXUS_MESH_FILE_VERSION */
+    uint32_t vertex_stride;            /* Bytes per vertex */
+    uint32_t index_size;               /* Bytes per index (2 or 4) */
+    uint32_t vertex_count;             /* Number of vertices */
+    uint32_t index_count;              /* Number of indices */
+    uint32_t lod_count;                /* Number of NexusMeshLod entries */
+    uint32_t meshlet_count;            /* Number of NexusMeshlet entries */
+    float bounds_min[3];               /* Local space AABB minimum */
+    float bounds_max[3];               /* Local space AABB maximum */
+    uint32_t vertex_offset;            /* File offset of the vertices */
+    uint32_t index_offset;             /* File offset of the indices */
+    uint32_t lod_offset;               /* File offset of the LOD table */
+    uint32_t meshlet_offset;           /* File offset of the meshlet table */
+} NexusMeshFileHeader;
+
+/* Importing and cooking (CPU only, callable from any thread) */
+bool nexus_mesh_data_load_obj(const char* filename, NexusMeshData* data);
+bool nexus_mesh_data_load_cooked(const char* filename, NexusMeshData* data);
+bool nexus_mesh_data_load_file(const char* filename, NexusMeshData* data);
+bool nexus_mesh_data_save_cooked(const NexusMeshData* data, const char* filename);
+bool nexus_mesh_cook_obj(const char* obj_filename, const char* cooked_filename);
+
+#endif /* NEXUS3D_MESH_FILE_H */
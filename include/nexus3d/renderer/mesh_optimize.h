@@ -0,0 +1,48 @@
+/**
+ * Nexus3D Mesh Optimization
+ * Triangle reordering for the post-transform vertex cache (Tipsify), cluster
+ * sorting against overdraw and vertex reordering for fetch locality
+ */
+
+#ifndef NEXUS3D_MESH_OPTIMIZE_H
+#define NEXUS3D_MESH_OPTIMIZE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "nexus3d/renderer/mesh.h"
+
+/* Post-transform cache size the triangle order is optimized and measured for */
+#define NEXUS_MESH_OPTIMIZE_CACHE_SIZE 16
+
+/* Cache efficiency a cluster may give up to be split for overdraw sorting (1.0 = none) */
+#define NEXUS_MESH_OPTIMIZE_OVERDRAW_THRESHOLD 1.05f
+
+/**
+ * Optimization statistics
+ * ACMR is the average cache miss ratio, vertices transformed per triangle
+ * (0.5 is the best a regular grid can get, 3.0 is no reuse at all)
+ */
+typedef struct {
+    float acmr_before;                 /* ACMR of the input order */
+    float acmr_after;                  /* ACMR of the optimized order */
+    uint32_t clusters;                 /* Triangle clusters sorted for overdraw (0 = overdraw pass skipped) */
+    uint32_t vertices_removed;         /* Unreferenced vertices dropped by the fetch reorder */
+} NexusMeshOptimizeStats;
+
+/* Individual passes (indices are triangle lists) */
+float nexus_mesh_compute_acmr(const uint32_t* indices, uint32_t index_count, uint32_t vertex_count,
+                              uint32_t cache_size);
+uint32_t nexus_mesh_optimize_vertex_cache(uint32_t* indices, uint32_t index_count, uint32_t vertex_count,
+                                          uint32_t* cluster_starts);
+uint32_t nexus_mesh_optimize_overdraw(const NexusVertex* vertices, uint32_t* indices, uint32_t index_count,
+                                      uint32_t vertex_count, const uint32_t* cluster_starts, uint32_t cluster_count,
+                                      float threshold);
+uint32_t nexus_mesh_optimize_vertex_fetch(NexusVertex* vertices, uint32_t vertex_count, uint32_t* indices,
+                                          uint32_t index_count);
+
+/* All passes */
+bool nexus_mesh_optimize_arrays(NexusVertex* vertices, uint32_t* vertex_count, uint32_t* indices,
+                                uint32_t index_count, bool overdraw, NexusMeshOptimizeStats* stats);
+bool nexus_mesh_data_optimize(NexusMeshData* data, bool overdraw, NexusMeshOptimizeStats* stats);
+
+#endif /* NEXUS3D_MESH_OPTIMIZE_H */
@@ -0,0 +1,28 @@
+/**
+ * Nexus3D Mesh Simplification
+ * Quadric error edge collapse simplification and LOD chain generation
+ */
+
+#ifndef NEXUS3D_MESH_SIMPLIFY_H
+#define NEXUS3D_MESH_SIMPLIFY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "nexus3d/renderer/mesh.h"
+
+/* LOD chain generation */
+#define NEXUS_MESH_LOD_REDUCTION     0.5f  /* Triangles each level keeps of the previous one */
+#define NEXUS_MESH_LOD_MIN_REDUCTION 0.9f  /* A level keeping more than this of the previous one ends the chain */
+#define NEXUS_MESH_LOD_MIN_TRIANGLES 32    /* Meshes and levels below this many triangles are not simplified */
+#define NEXUS_MESH_LOD_MAX_ERROR     0.1f  /* Largest error of a level, relative to the mesh radius */
+
+/* Simplification functions */
+uint32_t nexus_mesh_simplify(const NexusVertex* vertices, uint32_t vertex_count, const uint32_t* indices,
+                             uint32_t index_count, uint32_t target_index_count, float target_error,
+                             uint32_t* out_indices, float* out_error);
+uint32_t nexus_mesh_build_lod_chain(const NexusVertex* vertices, uint32_t vertex_count, const uint32_t* indices,
+                                    uint32_t index_count, uint32_t max_levels, uint32_t** chain_indices,
+                                    uint32_t* chain_index_count, NexusMeshLod* lods);
+bool nexus_mesh_data_generate_lods(NexusMeshData* data, uint32_t max_levels);
+
+#endif /* NEXUS3D_MESH_SIMPLIFY_H */
@@ -0,0 +1,94 @@
+/**
+ * Nexus3D Pipeline Cache
+ * Graphics pipeline variants keyed on shader modules and render state
+ */
+
+#ifndef NEXUS3D_PIPELINE_CACHE_H
+#define NEXUS3D_PIPELINE_CACHE_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "nexus3d/renderer/shader.h"
+#include "nexus3d/renderer/material.h"
+#include "nexus3d/renderer/vertex_layout.h"
+
+/**
+ * Render state baked into a pipeline
+ */
+typedef struct {
+    uint32_t vertex_layout;            /* NEXUS_VERTEX_LAYOUT_* (plus the per-instance world matrix) */
+    NexusBlendMode blend_mode;         /* Color blending */
+    SDL_GPUCullMode cull_mode;         /* Face culling */
+    SDL_GPUFillMode fill_mode;         /* Solid or wireframe */
+    bool color_write;                  /* Write color (false = depth only) */
+    bool depth_test;                   /* Enable depth testing */
+    bool depth_write;                  /* Enable depth writes */
+    SDL_GPUCompareOp depth_compare;    /* Depth comparison */
+    float depth_bias;                  /* Constant depth bias (0 = none, shadow casters) */
+    float depth_bias_slope;            /* Slope scaled depth bias (0 = none) */
+    SDL_GPUTextureFormat color_format; /* Color target format (INVALID = no color target) */
+    SDL_GPUTextureFormat depth_format; /* Depth target format (INVALID = no depth target) */
+    SDL_GPUSampleCount sample_count;   /* MSAA sample count */
+} NexusPipelineState;
+
+/**
+ * Cache key (zero padded so it can be hashed and compared bytewise)
+ */
+typedef struct {
+    SDL_GPUShader* vertex_shader;      /* Vertex module */
+    SDL_GPUShader* fragment_shader;    /* Fragment module */
+    NexusPipelineState state;          /* Render state */
+} NexusPipelineKey;
+
+/**
+ * Cache entry
+ */
+typedef struct {
+    uint64_t hash;                     /* Key hash (0 = empty slot) */
+    NexusPipelineKey key;              /* Full key */
+    SDL_GPUGraphicsPipeline* pipeline; /* Pipeline built for the key */
+} NexusPipelineCacheEntry;
+
+/**
+ * Pipeline cache structure
+ */
+typedef struct NexusPipelineCache {
+    SDL_GPUDevice* device;             /* GPU device reference */
+    NexusPipelineCacheEntry* entries;  /* Open addressing table */
+    uint32_t capacity;                 /* Table size (power of two) */
+    uint32_t count;                    /* Pipelines in the cache */
+    SDL_Mutex* lock;                   /* Guards the table (variants are prewarmed on a worker thread) */
+
+    /* Targets of the renderer's frame pass, used for default states */
+    SDL_GPUTextureFormat color_format; /* Color target format */
+    SDL_GPUTextureFormat depth_format; /* Depth target format */
+    SDL_GPUSampleCount sample_count;   /* Sample count */
+
+    /* Stats */
+    uint32_t hits;                     /* Lookups served from the cache */
+    uint32_t misses;                   /* Pipelines created on demand */
+} NexusPipelineCache;
+
+/* Pipeline state functions */
+void nexus_pipeline_state_default(NexusPipelineState* state);
+void nexus_pipeline_state_from_material(NexusPipelineState* state, const NexusMaterial* material);
+SDL_GPUGraphicsPipeline* nexus_pipeline_create(SDL_GPUDevice* device, const NexusShader* shader,
+                                               const NexusPipelineState* state);
+
+/* Pipeline cache functions */
+NexusPipelineCache* nexus_pipeline_cache_create(SDL_GPUDevice* device);
+void nexus_pipeline_cache_destroy(NexusPipelineCache* cache);
+NexusPipelineCache* nexus_pipeline_cache_get(SDL_GPUDevice* device);
+void nexus_pipeline_cache_set_targets(NexusPipelineCache* cache, SDL_GPUTextureFormat color_format,
+                                      SDL_GPUTextureFormat depth_format, SDL_GPUSampleCount sample_count);
+void nexus_pipeline_cache_get_state(const NexusPipelineCache* cache, const NexusMaterial* material,
+                                    NexusPipelineState* state);
+SDL_GPUGraphicsPipeline* nexus_pipeline_cache_acquire(NexusPipelineCache* cache, const NexusShader* shader,
+                                                      const NexusPipelineState* state);
+uint32_t nexus_pipeline_cache_prewarm(NexusPipelineCache* cache, const NexusShader* shader,
+                                      const NexusPipelineState* states, uint32_t count);
+void nexus_pipeline_cache_evict_shader(NexusPipelineCache* cache, const NexusShader* shader);
+uint32_t nexus_pipeline_cache_get_count(const NexusPipelineCache* cache);
+
+#endif /* NEXUS3D_PIPELINE_CACHE_H */
@@ -0,0 +1,184 @@
+/**
+ * Nexus3D Render Graph
+ * Per-frame passes declaring the textures they read and write, ordered and
+ * culled automatically, with pooled transient textures shared by passes
+ * whose lifetimes don't overlap
+ */
+
+#ifndef NEXUS3D_RENDER_GRAPH_H
+#define NEXUS3D_RENDER_GRAPH_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Per frame limits */
+#define NEXUS_RENDER_GRAPH_MAX_PASSES    64
+#define NEXUS_RENDER_GRAPH_MAX_TEXTURES  64
+#define NEXUS_RENDER_GRAPH_MAX_VERSIONS  256   /* Texture versions (one per write plus the initial one) */
+#define NEXUS_RENDER_GRAPH_MAX_COLORS    4     /* Color attachments of one pass */
+#define NEXUS_RENDER_GRAPH_MAX_READS     8     /* Sampled textures of one pass */
+
+/* Frames a pooled texture may stay unused before it is released */
+#define NEXUS_RENDER_GRAPH_POOL_FRAMES   3
+
+/* Invalid resource handle */
+#define NEXUS_RENDER_GRAPH_INVALID 0u
+
+/**
+ * Resource handle, one version of a graph texture
+ * Every write returns a new version, passes reading it run after the writer
+ * and before whoever writes the next version
+ */
+typedef uint32_t NexusRenderGraphResource;
+
+typedef struct NexusRenderGraph NexusRenderGraph;
+
+/**
+ * Graph texture description
+ */
+typedef struct {
+    uint32_t width;                /* Width in texels */
+    uint32_t height;               /* Height in texels */
+    SDL_GPUTextureFormat format;   /* Texel format */
+    SDL_GPUSampleCount sample_count; /* Samples per texel */
+} NexusRenderGraphTextureDesc;
+
+/**
+ * Pass execution context
+ */
+typedef struct {
+    NexusRenderGraph* graph;       /* Graph being executed (resolves resources) */
+    SDL_GPUCommandBuffer* cmd_buffer; /* Command buffer the graph records into */
+    SDL_GPURenderPass* render_pass; /* Pass over the declared attachments (NULL without attachments) */
+    uint32_t pass;                 /* Index of the executing pass */
+} NexusRenderGraphContext;
+
+/* Pass callback, records the pass' commands */
+typedef void (*NexusRenderGraphExecuteFunc)(const NexusRenderGraphContext* context, void* user_data);
+
+/**
+ * Attachment of a pass
+ */
+typedef struct {
+    NexusRenderGraphResource input; /* Version written over */
+    NexusRenderGraphResource output; /* Version produced */
+    bool clear;                    /* Clear instead of keeping the input's contents */
+    SDL_FColor clear_color;        /* Clear color (color attachments) */
+    float clear_depth;             /* Clear depth (depth attachment) */
+    SDL_GPULoadOp load_op;         /* Derived when compiled */
+    SDL_GPUStoreOp store_op;       /* Derived when compiled */
+} NexusRenderGraphAttachment;
+
+/**
+ * Pass of the current frame
+ */
+typedef struct {
+    const char* name;              /* Pass name (static string) */
+    NexusRenderGraphExecuteFunc execute; /* Recording callback */
+    void* user_data;               /* Callback argument */
+    NexusRenderGraphAttachment colors[NEXUS_RENDER_GRAPH_MAX_COLORS]; /* Color attachments */
+    uint32_t color_count;          /* Number of color attachments */
+    NexusRenderGraphAttachment depth; /* Depth attachment (output = INVALID without one) */
+    NexusRenderGraphResource reads[NEXUS_RENDER_GRAPH_MAX_READS]; /* Sampled versions */
+    uint32_t read_count;           /* Number of sampled versions */
+    bool side_effects;             /* Never culled (readbacks, uploads, ...) */
+    bool alive;                    /* Contributes to an output, set when compiled */
+} NexusRenderGraphPass;
+
+/**
+ * Texture version
+ */
+typedef struct {
+    uint32_t texture;              /* Graph texture */
+    int32_t writer;                /* Pass producing the version (-1 = initial contents) */
+    int32_t next_writer;           /* Pass writing over the version (-1 = final version) */
+} NexusRenderGraphVersion;
+
+/**
+ * Graph texture of the current frame
+ */
+typedef struct {
+    const char* name;              /* Texture name (static string) */
+    NexusRenderGraphTextureDesc desc; /* Size and format */
+    SDL_GPUTextureUsageFlags usage; /* Usage of all declared accesses */
+    SDL_GPUTexture* texture;       /* Imported texture, or the pooled one while compiled */
+    bool imported;                 /* Owned outside the graph */
+    bool has_contents;             /* Imported contents are valid on entry */
+    bool exported;                 /* Final version is used after the graph (swapchain, ...) */
+    int32_t first_use;             /* First alive pass in execution order (-1 = unused) */
+    int32_t last_use;              /* Last alive pass in execution order */
+    int32_t pool_entry;            /* Pooled texture of a transient (-1 = none) */
+} NexusRenderGraphTexture;
+
+/**
+ * Pooled transient texture, kept across frames
+ */
+typedef struct {
+    SDL_GPUTexture* texture;       /* GPU texture */
+    NexusRenderGraphTextureDesc desc; /* Size and format */
+    SDL_GPUTextureUsageFlags usage; /* Usage the texture was created with */
+    int32_t busy_until;            /* Last pass of this frame using it (-1 = free) */
+    uint64_t last_frame;           /* Frame the texture was last used in */
+} NexusRenderGraphPoolEntry;
+
+/**
+ * Render graph structure
+ */
+struct NexusRenderGraph {
+    /* Declarations of the frame */
+    NexusRenderGraphPass passes[NEXUS_RENDER_GRAPH_MAX_PASSES]; /* Passes in declaration order */
+    uint32_t pass_count;           /* Number of passes */
+    NexusRenderGraphTexture textures[NEXUS_RENDER_GRAPH_MAX_TEXTURES]; /* Graph textures */
+    uint32_t texture_count;        /* Number of textures */
+    NexusRenderGraphVersion versions[NEXUS_RENDER_GRAPH_MAX_VERSIONS]; /* Texture versions */
+    uint32_t version_count;        /* Number of versions */
+    bool failed;                   /* A declaration was rejected, the frame is not executed */
+
+    /* Compiled schedule */
+    uint32_t order[NEXUS_RENDER_GRAPH_MAX_PASSES]; /* Alive passes in execution order */
+    uint32_t order_count;          /* Number of alive passes */
+    bool compiled;                 /* Compiled since the last reset */
+
+    /* Transient texture pool */
+    NexusRenderGraphPoolEntry pool[NEXUS_RENDER_GRAPH_MAX_TEXTURES]; /* Pooled textures */
+    uint32_t pool_count;           /* Number of pooled textures */
+    uint64_t frame;                /* Frame counter for pool aging */
+
+    /* Statistics of the last compile */
+    uint32_t culled_count;         /* Passes dropped as unused */
+    uint32_t transient_count;      /* Transient textures in use */
+    uint32_t physical_count;       /* Pooled textures backing them */
+
+    SDL_GPUDevice* device;         /* GPU device reference */
+};
+
+/* Render graph functions */
+NexusRenderGraph* nexus_render_graph_create(SDL_GPUDevice* device);
+void nexus_render_graph_destroy(NexusRenderGraph* graph);
+void nexus_render_graph_reset(NexusRenderGraph* graph);
+NexusRenderGraphResource nexus_render_graph_import_texture(NexusRenderGraph* graph, const char* name,
+                                                           SDL_GPUTexture* texture,
+                                                           const NexusRenderGraphTextureDesc* desc,
+                                                           bool has_contents, bool exported);
+NexusRenderGraphResource nexus_render_graph_create_texture(NexusRenderGraph* graph, const char* name,
+                                                           const NexusRenderGraphTextureDesc* desc);
+uint32_t nexus_render_graph_add_pass(NexusRenderGraph* graph, const char* name,
+                                     NexusRenderGraphExecuteFunc execute, void* user_data);
+NexusRenderGraphResource nexus_render_graph_write_color(NexusRenderGraph* graph, uint32_t pass,
+                                                        NexusRenderGraphResource resource,
+                                                        const SDL_FColor* clear_color);
+NexusRenderGraphResource nexus_render_graph_write_depth(NexusRenderGraph* graph, uint32_t pass,
+                                                        NexusRenderGraphResource resource,
+                                                        bool clear, float clear_depth);
+bool nexus_render_graph_read(NexusRenderGraph* graph, uint32_t pass, NexusRenderGraphResource resource);
+void nexus_render_graph_set_side_effects(NexusRenderGraph* graph, uint32_t pass);
+bool nexus_render_graph_compile(NexusRenderGraph* graph);
+bool nexus_render_graph_execute(NexusRenderGraph* graph, SDL_GPUCommandBuffer* cmd_buffer);
+NexusRenderGraphResource nexus_render_graph_get_latest(const NexusRenderGraph* graph,
+                                                       NexusRenderGraphResource resource);
+SDL_GPUTexture* nexus_render_graph_get_texture(const NexusRenderGraph* graph, NexusRenderGraphResource resource);
+const NexusRenderGraphTextureDesc* nexus_render_graph_get_desc(const NexusRenderGraph* graph,
+                                                               NexusRenderGraphResource resource);
+
+#endif /* NEXUS3D_RENDER_GRAPH_H */
@@ -0,0 +1,92 @@
+/**
+ * Nexus3D Render Queue
+ * Per-frame draw command buffer sorted by compact draw keys
+ */
+
+#ifndef NEXUS3D_RENDER_QUEUE_H
+#define NEXUS3D_RENDER_QUEUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "nexus3d/renderer/mesh.h"
+#include "nexus3d/renderer/shader.h"
+#include "nexus3d/renderer/material.h"
+
+/**
+ * Draw key layout (most significant bit first)
+ *
+ * Opaque:      [63] 0 | [62..59] depth bucket | [58..48] pipeline | [47..32] material | [31..16] mesh | [15..0] depth
+ * Translucent: [63] 1 | [62..43] inverted depth | [42..32] pipeline | [31..16] material | [15..0] mesh
+ *
+ * Opaque draws are ordered front to back by coarse depth bucket so early-Z rejects
+ * hidden fragments, grouped by state within a bucket and ordered front to back again
+ * inside each group. Translucent draws always come after them and are ordered back to front.
+ */
+#define NEXUS_DRAW_KEY_PIPELINE_BITS     11
+#define NEXUS_DRAW_KEY_MATERIAL_BITS     16
+#define NEXUS_DRAW_KEY_MESH_BITS         16
+#define NEXUS_DRAW_KEY_DEPTH_BITS        20
+#define NEXUS_DRAW_KEY_DEPTH_BUCKET_BITS 4
+#define NEXUS_DRAW_KEY_OPAQUE_DEPTH_BITS 16
+
+/* Size of the per-frame pointer to id tables (power of two) */
+#define NEXUS_RENDER_QUEUE_ID_TABLE_SIZE 4096
+
+/**
+ * Draw command recorded into the queue
+ */
+typedef struct {
+    uint64_t key;                  /* Sort key */
+    NexusMesh* mesh;               /* Mesh to draw */
+    uint32_t lod;                  /* Detail level of the mesh */
+    NexusMaterial* material;       /* Material (may be NULL) */
+    NexusShader* shader;           /* Shader providing the uniforms */
+    SDL_GPUGraphicsPipeline* pipeline; /* Pipeline variant for the shader and material state */
+    float transform[16];           /* World transform (column major) */
+} NexusDrawCommand;
+
+/**
+ * Per-frame pointer to dense id table
+ */
+typedef struct {
+    const void* keys[NEXUS_RENDER_QUEUE_ID_TABLE_SIZE];   /* Interned pointers */
+    uint32_t stamps[NEXUS_RENDER_QUEUE_ID_TABLE_SIZE];    /* Frame stamp of each slot */
+    uint32_t ids[NEXUS_RENDER_QUEUE_ID_TABLE_SIZE];       /* Dense id of each slot */
+    uint32_t count;                /* Ids handed out this frame */
+} NexusRenderQueueIdTable;
+
+/**
+ * Render queue structure
+ */
+typedef struct NexusRenderQueue {
+    NexusDrawCommand* commands;    /* Commands in submission order */
+    uint32_t count;                /* Number of submitted commands */
+    uint32_t opaque_count;         /* Opaque commands (sorted before translucent ones) */
+    uint32_t capacity;             /* Allocated command capacity */
+
+    /* Sort scratch (keys and command indices, double buffered) */
+    uint64_t* sort_keys[2];        /* Key ping-pong buffers */
+    uint32_t* sort_indices[2];     /* Index ping-pong buffers */
+    uint32_t* sorted;              /* Sorted command order (points into sort_indices) */
+    bool is_sorted;                /* Whether the queue has been sorted since last submit */
+
+    /* Dense ids for key packing */
+    NexusRenderQueueIdTable pipelines; /* Pipeline variant ids */
+    NexusRenderQueueIdTable materials; /* Material ids */
+    NexusRenderQueueIdTable meshes;    /* Mesh ids */
+    uint32_t frame_stamp;          /* Current frame stamp */
+} NexusRenderQueue;
+
+/* Render queue functions */
+NexusRenderQueue* nexus_render_queue_create(uint32_t initial_capacity);
+void nexus_render_queue_destroy(NexusRenderQueue* queue);
+void nexus_render_queue_reset(NexusRenderQueue* queue);
+bool nexus_render_queue_submit(NexusRenderQueue* queue, NexusMesh* mesh, uint32_t lod, NexusMaterial* material,
+                               NexusShader* shader, SDL_GPUGraphicsPipeline* pipeline,
+                               const float* transform, float depth);
+void nexus_render_queue_sort(NexusRenderQueue* queue);
+uint32_t nexus_render_queue_get_count(const NexusRenderQueue* queue);
+uint32_t nexus_render_queue_get_opaque_count(const NexusRenderQueue* queue);
+const NexusDrawCommand* nexus_render_queue_get_sorted(const NexusRenderQueue* queue, uint32_t index);
+
+#endif /* NEXUS3D_RENDER_QUEUE_H */
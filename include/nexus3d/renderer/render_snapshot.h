@@ -0,0 +1,106 @@
+/**
+ * Nexus3D Render Snapshot
+ * Everything a frame draws, extracted from the world by the render systems:
+ * the view camera, visible draws with copies of their transforms, shadow
+ * casters and lights. The renderer replays a snapshot between begin and end
+ * frame, so it can be rendered while the world already simulates the next one
+ */
+
+#ifndef NEXUS3D_RENDER_SNAPSHOT_H
+#define NEXUS3D_RENDER_SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <cglm/cglm.h>
+#include "nexus3d/renderer/camera.h"
+#include "nexus3d/renderer/mesh.h"
+#include "nexus3d/renderer/material.h"
+#include "nexus3d/renderer/light_clusters.h"
+
+/* Draws a new snapshot has room for before it grows */
+#define NEXUS_RENDER_SNAPSHOT_INITIAL_DRAWS 1024
+
+/* Snapshots a pipelined frame loop can keep in flight */
+#define NEXUS_RENDER_SNAPSHOT_MAX_COUNT 4
+
+/**
+ * Draw of the snapshot
+ */
+typedef struct {
+    NexusMesh* mesh;               /* Mesh to draw */
+    NexusMaterial* material;       /* Material (NULL = default shader) */
+    uint32_t lod;                  /* Detail level picked at extraction */
+    float transform[16];           /* World transform at extraction */
+} NexusSnapshotDraw;
+
+/**
+ * Shadow caster of the snapshot
+ */
+typedef struct {
+    NexusMesh* mesh;               /* Mesh to draw into the shadow maps */
+    NexusMaterial* material;       /* Material (NULL = default shader) */
+    uint32_t lod;                  /* Detail level */
+    float transform[16];           /* World transform at extraction */
+    float world_min[3];            /* World bounds minimum */
+    float world_max[3];            /* World bounds maximum */
+} NexusSnapshotCaster;
+
+/**
+ * Light of the snapshot
+ */
+typedef struct {
+    NexusLightData data;           /* Light as the clusters store it */
+    uint64_t id;                   /* Light identity across frames (shadowed lights) */
+    uint32_t resolution;           /* Requested shadow tile size (0 = default) */
+    bool shadowed;                 /* Light casts shadows */
+} NexusSnapshotLight;
+
+/**
+ * Render snapshot structure
+ * Only holds copies, the world can change as soon as extraction finished.
+ * Meshes and materials are referenced, they have to outlive the frame
+ */
+typedef struct NexusRenderSnapshot {
+    /* View */
+    NexusCamera camera;            /* Copy of the view camera */
+    NexusCamera* source_camera;    /* Camera the copy was taken from (NULL = none) */
+    bool has_camera;               /* camera is valid */
+    vec4 frustum_planes[6];        /* Frustum of camera, normals point inwards */
+    uint32_t viewport_width;       /* Viewport size in pixels at extraction */
+    uint32_t viewport_height;
+
+    /* Contents */
+    NexusSnapshotDraw* draws;      /* Visible draws */
+    uint32_t draw_count;           /* Number of draws */
+    uint32_t draw_capacity;        /* Allocated draws */
+    NexusSnapshotCaster* casters;  /* Shadow casters (independent of camera culling) */
+    uint32_t caster_count;         /* Number of casters */
+    uint32_t caster_capacity;      /* Allocated casters */
+    NexusSnapshotLight* lights;    /* Lights */
+    uint32_t light_count;          /* Number of lights */
+    uint32_t light_capacity;       /* Allocated lights */
+
+    /* Stats */
+    uint64_t frame;                /* Engine frame the snapshot was extracted in */
+    uint32_t visible_count;        /* Objects that passed frustum culling */
+    uint32_t culled_count;         /* Objects rejected by frustum culling */
+} NexusRenderSnapshot;
+
+/* Render snapshot functions */
+NexusRenderSnapshot* nexus_render_snapshot_create(uint32_t draw_capacity);
+void nexus_render_snapshot_destroy(NexusRenderSnapshot* snapshot);
+void nexus_render_snapshot_reset(NexusRenderSnapshot* snapshot, uint64_t frame);
+void nexus_render_snapshot_set_camera(NexusRenderSnapshot* snapshot, NexusCamera* camera);
+void nexus_render_snapshot_set_viewport(NexusRenderSnapshot* snapshot, uint32_t width, uint32_t height);
+bool nexus_render_snapshot_add_draw(NexusRenderSnapshot* snapshot, NexusMesh* mesh, uint32_t lod,
+                                    NexusMaterial* material, const float* transform);
+bool nexus_render_snapshot_add_caster(NexusRenderSnapshot* snapshot, NexusMesh* mesh, uint32_t lod,
+                                      NexusMaterial* material, const float* transform,
+                                      const float* world_min, const float* world_max);
+bool nexus_render_snapshot_add_light(NexusRenderSnapshot* snapshot, const NexusLightData* light, bool shadowed,
+                                     uint64_t id, uint32_t resolution);
+void nexus_render_snapshot_clear_lights(NexusRenderSnapshot* snapshot);
+size_t nexus_render_snapshot_get_memory_size(const NexusRenderSnapshot* snapshot);
+
+#endif /* NEXUS3D_RENDER_SNAPSHOT_H */
@@ -12,6 +12,24 @@
 #include "nexus3d/renderer/camera.h"
 #include "nexus3d/renderer/mesh.h"
 #include "nexus3d/renderer/shader.h"
+#include "nexus3d/renderer/material.h"
+#include "nexus3d/renderer/render_queue.h"
+#include "nexus3d/renderer/culling.h"
+#include "nexus3d/renderer/light_clusters.h"
+#include "nexus3d/renderer/shadow_atlas.h"
+#include "nexus3d/renderer/gpu_scene.h"
+#include "nexus3d/renderer/render_graph.h"
+#include "nexus3d/renderer/gpu_timer.h"
+#include "nexus3d/renderer/render_snapshot.h"
+#include "nexus3d/renderer/upload.h"
+#include "nexus3d/renderer/pipeline_cache.h"
+#include "nexus3d/renderer/shader_cache.h"
+
+/* LOD selection defaults, used when the config leaves lod_pixel_error at 0 */
+#define NEXUS_RENDERER_DEFAULT_LOD_PIXEL_ERROR 1.0f
+
+/* Frames the CPU may queue ahead of the GPU by default */
+#define NEXUS_RENDERER_DEFAULT_FRAMES_IN_FLIGHT 2
 
 /**
  * Renderer capabilities structure
@@ -21,6 +39,7 @@ typedef struct {
     int max_msaa_samples;          /* Maximum MSAA samples */
     bool supports_compute;         /* Compute shader support */
     bool supports_hdr;             /* High dynamic range support */
+    bool supports_timestamps;      /* GPU timestamp queries (per pass timings) */
     int max_texture_size;          /* Maximum texture size */
     int max_texture_array_layers;  /* Maximum texture array layers */
     char gpu_vendor[64];           /* GPU vendor string */
@@ -38,7 +57,17 @@ typedef struct {
     bool enable_vsync;             /* Enable vertical sync */
     bool enable_hdr;               /* Enable high dynamic range */
     SDL_GPUSwapchainComposition composition_mode; /* Swapchain composition mode */
-    SDL_GPUPresentMode present_mode; /* Present mode */
+    SDL_GPUPresentMode present_mode; /* Present mode (unsupported modes fall back to VSYNC) */
+    uint32_t frames_in_flight;     /* Frames queued ahead of the GPU, 1 - 3 (0 = NEXUS_RENDERER_DEFAULT_FRAMES_IN_FLIGHT) */
+    const char* shader_cache_path; /* On-disk shader cache directory (NULL = disabled) */
+    bool enable_depth_prepass;     /* Lay down opaque depth before shading (fill-rate-bound scenes) */
+    float lod_pixel_error;         /* Screen space error in pixels a mesh LOD may have */
+    float lod_hysteresis;          /* Fraction of lod_pixel_error a coarser LOD must stay below to switch */
+    uint32_t shadow_atlas_size;    /* Shadow atlas edge length in texels (0 = NEXUS_SHADOW_ATLAS_DEFAULT_SIZE) */
+    uint32_t shadow_cascades;      /* Cascades of directional lights (0 = NEXUS_SHADOW_DEFAULT_CASCADES) */
+    float shadow_distance;         /* View distance covered by directional shadows (0 = NEXUS_SHADOW_DEFAULT_DISTANCE) */
+    bool enable_gpu_driven;        /* Cull and draw opaque renderables on the GPU (needs gpu_cull_shader) */
+    const char* gpu_cull_shader;   /* Compute shader of the GPU cull pass, language from the extension */
 } NexusRendererConfig;
 
 /**
@@ -54,8 +83,22 @@ typedef struct {
     uint32_t swapchain_height;     /* Swapchain height */
     SDL_GPUTextureFormat swapchain_format; /* Swapchain texture format */
     
+    /* Depth target (recreated with the swapchain size) */
+    SDL_GPUTexture* depth_texture; /* Managed depth buffer */
+    SDL_GPUTextureFormat depth_format; /* Depth buffer format */
+    uint32_t depth_width;          /* Depth buffer width */
+    uint32_t depth_height;         /* Depth buffer height */
+    bool depth_prepass;            /* Depth prepass active in the current frame */
+
     /* Command pools and buffers */
     SDL_GPUCommandBuffer* cmd_buffer; /* Current command buffer */
+    SDL_GPURenderPass* render_pass;   /* Scene pass (open while the render graph executes it) */
+
+    /* Frame passes */
+    NexusRenderGraph* render_graph; /* Passes of the current frame */
+    NexusRenderGraphResource graph_backbuffer; /* Swapchain as written by the scene pass */
+    NexusRenderGraphResource graph_depth; /* Depth buffer as written by the scene pass */
+    NexusGpuTimer* gpu_timer;      /* Fence based GPU frame timings (NULL = untimed) */
     
     /* Clear color */
     float clear_color[4];          /* RGBA clear color */
@@ -63,11 +106,52 @@ typedef struct {
     /* Resources */
     NexusShader* default_shader;   /* Default shader */
     NexusCamera* main_camera;      /* Main camera */
+    NexusCamera* frame_camera;     /* Camera the current frame renders with */
+    NexusCamera snapshot_camera;   /* Copy of the rendered snapshot's camera */
+    NexusUploadManager* upload_manager; /* Shared staging ring for all GPU uploads */
+    NexusPipelineCache* pipeline_cache; /* Pipeline variants for shader and material state */
+    NexusShaderCache* shader_cache; /* On-disk shader blobs and variant list (optional) */
+
+    /* Draw submission */
+    NexusRenderQueue* render_queue; /* Sorted per-frame draw queue */
+    NexusShader* bound_shader;     /* Shader whose uniforms are pushed */
+    SDL_GPUGraphicsPipeline* bound_pipeline; /* Pipeline bound in the frame pass */
+    NexusMaterial* bound_material; /* Material parameters currently applied */
+    NexusMesh* bound_mesh;         /* Vertex/index buffers currently bound */
+    NexusRenderSnapshot* snapshot; /* Snapshot the render systems extract into (NULL = none) */
+
+    /* Culling */
+    NexusCullingBuffer* culling_buffer; /* Packed world bounds tested against the frustum */
+    vec4 frustum_planes[6];        /* Frame camera frustum of the current frame */
+
+    /* Lighting */
+    NexusLightClusters* light_clusters; /* Frame lights binned into the cluster grid */
+    bool light_heatmap;            /* Shade lights per cluster instead of lighting (debug) */
+    NexusShadowAtlas* shadow_atlas; /* Shadow maps of the frame's shadowed lights */
+    SDL_GPUBuffer* shadow_instance_buffer; /* Shadow caster transforms (vertex + storage) */
+    uint32_t shadow_instance_capacity; /* Instances the shadow buffer can hold */
+
+    /* GPU-driven drawing */
+    NexusGpuScene* gpu_scene;      /* Persistent objects culled on the GPU (NULL = CPU path only) */
+    bool gpu_scene_pending;        /* Scene not yet culled and drawn this frame */
+
+    /* Instancing */
+    SDL_GPUBuffer* instance_buffer; /* Per-frame instance transforms (vertex + storage) */
+    uint32_t instance_capacity;    /* Instances the buffers can hold */
     
     /* Stats */
     double frame_time;             /* Last frame time in ms */
     uint32_t draw_calls;           /* Draw calls in the current frame */
     uint32_t triangle_count;       /* Triangle count in the current frame */
+    uint32_t pipeline_binds;       /* Pipeline binds in the current frame */
+    uint32_t buffer_binds;         /* Vertex/index buffer binds in the current frame */
+    uint32_t instance_count;       /* Instances drawn in the current frame */
+    uint32_t visible_count;        /* Objects that passed frustum culling */
+    uint32_t culled_count;         /* Objects rejected by frustum culling */
+    uint32_t lod_triangle_counts[NEXUS_MESH_MAX_LODS]; /* Triangles drawn per LOD in the current frame */
+    uint32_t shadow_views_rendered; /* Shadow tiles rendered in the current frame */
+    uint32_t shadow_views_cached;  /* Shadow tiles reused from earlier frames */
+    uint32_t gpu_object_count;     /* Objects submitted to the GPU cull pass */
 } NexusRenderer;
 
 /* Renderer functions */
@@ -76,17 +160,59 @@ void nexus_renderer_destroy(NexusRenderer* renderer);
 bool nexus_renderer_begin_frame(NexusRenderer* renderer);
 void nexus_renderer_end_frame(NexusRenderer* renderer);
 void nexus_renderer_render_mesh(NexusRenderer* renderer, NexusMesh* mesh, NexusShader* shader, const float* transform);
+bool nexus_renderer_submit(NexusRenderer* renderer, NexusMesh* mesh, NexusMaterial* material, const float* transform);
+bool nexus_renderer_submit_lod(NexusRenderer* renderer, NexusMesh* mesh, uint32_t lod, NexusMaterial* material, const float* transform);
+uint32_t nexus_renderer_select_lod(const NexusRenderer* renderer, const NexusMesh* mesh, const float* center, float radius, uint32_t current_lod);
+void nexus_renderer_flush(NexusRenderer* renderer);
+NexusCullingBuffer* nexus_renderer_get_culling_buffer(const NexusRenderer* renderer);
+bool nexus_renderer_add_light(NexusRenderer* renderer, const NexusLightData* light);
+bool nexus_renderer_add_shadowed_light(NexusRenderer* renderer, const NexusLightData* light, uint64_t id, uint32_t resolution);
+void nexus_renderer_clear_lights(NexusRenderer* renderer);
+bool nexus_renderer_submit_shadow_caster(NexusRenderer* renderer, NexusMesh* mesh, uint32_t lod, NexusMaterial* material,
+                                         const float* transform, const float* world_min, const float* world_max);
+NexusShadowAtlas* nexus_renderer_get_shadow_atlas(const NexusRenderer* renderer);
+NexusLightClusters* nexus_renderer_get_light_clusters(const NexusRenderer* renderer);
+NexusGpuScene* nexus_renderer_get_gpu_scene(const NexusRenderer* renderer);
+void nexus_renderer_set_light_heatmap(NexusRenderer* renderer, bool enabled);
+uint32_t nexus_renderer_cull(NexusRenderer* renderer);
+void nexus_renderer_begin_snapshot(NexusRenderer* renderer, NexusRenderSnapshot* snapshot, uint64_t frame);
+NexusRenderSnapshot* nexus_renderer_end_snapshot(NexusRenderer* renderer);
+NexusRenderSnapshot* nexus_renderer_get_snapshot(const NexusRenderer* renderer);
+bool nexus_renderer_render_snapshot(NexusRenderer* renderer, const NexusRenderSnapshot* snapshot);
 void nexus_renderer_set_clear_color(NexusRenderer* renderer, float r, float g, float b, float a);
 void nexus_renderer_set_camera(NexusRenderer* renderer, NexusCamera* camera);
 NexusCamera* nexus_renderer_get_camera(const NexusRenderer* renderer);
 void nexus_renderer_resize(NexusRenderer* renderer, int width, int height);
 NexusRendererCaps nexus_renderer_get_capabilities(NexusRenderer* renderer);
 SDL_GPUDevice* nexus_renderer_get_gpu_device(const NexusRenderer* renderer);
+SDL_GPURenderPass* nexus_renderer_get_render_pass(const NexusRenderer* renderer);
+bool nexus_renderer_is_in_frame(const NexusRenderer* renderer);
+NexusRenderGraph* nexus_renderer_get_render_graph(const NexusRenderer* renderer);
+NexusRenderGraphResource nexus_renderer_get_backbuffer(const NexusRenderer* renderer);
+NexusRenderGraphResource nexus_renderer_get_depth_resource(const NexusRenderer* renderer);
+NexusUploadManager* nexus_renderer_get_upload_manager(const NexusRenderer* renderer);
+NexusPipelineCache* nexus_renderer_get_pipeline_cache(const NexusRenderer* renderer);
+NexusShaderCache* nexus_renderer_get_shader_cache(const NexusRenderer* renderer);
+SDL_GPUTexture* nexus_renderer_get_depth_texture(const NexusRenderer* renderer);
+void nexus_renderer_set_depth_prepass(NexusRenderer* renderer, bool enabled);
+bool nexus_renderer_set_present_mode(NexusRenderer* renderer, SDL_GPUPresentMode present_mode);
+SDL_GPUPresentMode nexus_renderer_get_present_mode(const NexusRenderer* renderer);
+bool nexus_renderer_set_frames_in_flight(NexusRenderer* renderer, uint32_t frames_in_flight);
 
 /* Statistics and debugging */
 uint32_t nexus_renderer_get_draw_call_count(const NexusRenderer* renderer);
 uint32_t nexus_renderer_get_triangle_count(const NexusRenderer* renderer);
+uint32_t nexus_renderer_get_lod_triangle_count(const NexusRenderer* renderer, uint32_t lod);
+uint32_t nexus_renderer_get_pipeline_bind_count(const NexusRenderer* renderer);
+uint32_t nexus_renderer_get_buffer_bind_count(const NexusRenderer* renderer);
+uint32_t nexus_renderer_get_instance_count(const NexusRenderer* renderer);
+uint32_t nexus_renderer_get_visible_count(const NexusRenderer* renderer);
+uint32_t nexus_renderer_get_culled_count(const NexusRenderer* renderer);
+uint32_t nexus_renderer_get_shadow_views_rendered(const NexusRenderer* renderer);
+uint32_t nexus_renderer_get_shadow_views_cached(const NexusRenderer* renderer);
+uint32_t nexus_renderer_get_gpu_object_count(const NexusRenderer* renderer);
 double nexus_renderer_get_frame_time(const NexusRenderer* renderer);
+double nexus_renderer_get_gpu_frame_time(const NexusRenderer* renderer);
 void nexus_renderer_set_frame_time(NexusRenderer* renderer, double frame_time_ms);
 
 #endif /* NEXUS3D_RENDERER_H */
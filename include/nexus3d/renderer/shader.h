@@ -8,6 +8,138 @@
 
 #include <SDL3/SDL.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "nexus3d/renderer/vertex_layout.h"
+
+/**
+ * Instance data layout shared by all pipelines
+ * Vertex buffer slot 1 streams one world matrix per instance into
+ * attribute locations 4-7 (one float4 column each)
+ */
+#define NEXUS_SHADER_INSTANCE_BUFFER_SLOT 1
+#define NEXUS_SHADER_INSTANCE_ATTRIBUTE_LOCATION 4
+#define NEXUS_SHADER_INSTANCE_STRIDE (sizeof(float) * 16)
+
+/**
+ * Uniform block bindings
+ * Every shader uses the same fixed blocks (std140 layout):
+ *   vertex slot 0   - NexusFrameUniforms (written once per frame by the renderer)
+ *   vertex slot 1   - NexusObjectUniforms (per draw, non-instanced paths)
+ *   fragment slot 0 - NexusMaterialUniforms (written when the material changes)
+ *   fragment slot 1 - NexusFrameUniforms
+ */
+#define NEXUS_UNIFORM_SLOT_VERTEX_FRAME 0
+#define NEXUS_UNIFORM_SLOT_VERTEX_OBJECT 1
+#define NEXUS_UNIFORM_SLOT_FRAGMENT_MATERIAL 0
+#define NEXUS_UNIFORM_SLOT_FRAGMENT_FRAME 1
+#define NEXUS_VERTEX_UNIFORM_BUFFER_COUNT 2
+#define NEXUS_FRAGMENT_UNIFORM_BUFFER_COUNT 2
+
+/**
+ * Fragment storage buffer bindings (clustered lighting, see light_clusters.h)
+ *   slot 0 - NexusLightData[], directional lights first
+ *   slot 1 - NexusLightCluster[NEXUS_CLUSTER_COUNT], ranges of the index list
+ *   slot 2 - uint[], light indices of every cluster
+ *   slot 3 - NexusShadowView[], shadow views of the atlas (see shadow_atlas.h)
+ */
+#define NEXUS_STORAGE_SLOT_FRAGMENT_LIGHTS 0
+#define NEXUS_STORAGE_SLOT_FRAGMENT_CLUSTERS 1
+#define NEXUS_STORAGE_SLOT_FRAGMENT_LIGHT_INDICES 2
+#define NEXUS_STORAGE_SLOT_FRAGMENT_SHADOW_VIEWS 3
+#define NEXUS_FRAGMENT_STORAGE_BUFFER_COUNT 4
+
+/**
+ * Fragment sampler bindings
+ *   slot 0 - shadow atlas, depth texture with a comparison sampler
+ */
+#define NEXUS_SAMPLER_SLOT_FRAGMENT_SHADOW_ATLAS 0
+#define NEXUS_FRAGMENT_SAMPLER_COUNT 1
+
+/* Material map presence flags (NexusMaterialUniforms.map_flags) */
+#define NEXUS_MATERIAL_HAS_ALBEDO_MAP    (1u << 0)
+#define NEXUS_MATERIAL_HAS_NORMAL_MAP    (1u << 1)
+#define NEXUS_MATERIAL_HAS_METALLIC_MAP  (1u << 2)
+#define NEXUS_MATERIAL_HAS_ROUGHNESS_MAP (1u << 3)
+#define NEXUS_MATERIAL_HAS_AO_MAP        (1u << 4)
+#define NEXUS_MATERIAL_HAS_EMISSIVE_MAP  (1u << 5)
+
+/**
+ * Per-frame uniform block
+ */
+typedef struct {
+    float view[16];                /* u_view */
+    float projection[16];          /* u_projection */
+    float view_projection[16];     /* u_viewProjection */
+    float camera_position[4];      /* u_cameraPosition (xyz) */
+    float time[4];                 /* u_time (x = seconds, y = delta) */
+    float cluster_scale[4];        /* u_clusterScale (xy = tiles per pixel, zw = depth slice scale and bias) */
+    uint32_t cluster_info[4];      /* u_clusterInfo (x = directional lights, y = lights, z = NEXUS_CLUSTER_FLAG_*) */
+} NexusFrameUniforms;
+
+/**
+ * Per-object uniform block
+ */
+typedef struct {
+    float model[16];               /* u_model */
+    float params[4];               /* u_objectParams (user data) */
+} NexusObjectUniforms;
+
+/**
+ * Per-material uniform block
+ */
+typedef struct {
+    float base_color[4];           /* u_baseColor */
+    float emissive[4];             /* u_emissive (xyz) */
+    float metallic;                /* u_metallic */
+    float roughness;               /* u_roughness */
+    float ao;                      /* u_ao */
+    uint32_t map_flags;            /* u_mapFlags (NEXUS_MATERIAL_HAS_*) */
+} NexusMaterialUniforms;
+
+/**
+ * Uniform block identifiers
+ */
+typedef enum {
+    NEXUS_UNIFORM_BLOCK_FRAME,
+    NEXUS_UNIFORM_BLOCK_OBJECT,
+    NEXUS_UNIFORM_BLOCK_MATERIAL,
+    NEXUS_UNIFORM_BLOCK_COUNT
+} NexusUniformBlock;
+
+/**
+ * Resolved uniform location (block + byte offset)
+ */
+typedef struct {
+    int32_t block;                 /* NexusUniformBlock, or -1 if not found */
+    uint32_t offset;               /* Byte offset inside the block */
+    uint32_t size;                 /* Size in bytes */
+} NexusUniformHandle;
+
+/* Maximum number of resolved uniforms per shader */
+#define NEXUS_SHADER_MAX_UNIFORMS 32
+
+/* Slots of the name lookup table (power of two, at least twice the uniforms) */
+#define NEXUS_SHADER_UNIFORM_LOOKUP_SIZE 64
+
+/**
+ * Resolved uniform entry
+ */
+typedef struct {
+    char name[32];                 /* Uniform name */
+    uint32_t hash;                 /* Hash of the name */
+    NexusUniformHandle handle;     /* Resolved location */
+} NexusShaderUniform;
+
+/**
+ * CPU shadow copy of a uniform block
+ */
+typedef struct {
+    uint8_t data[256];             /* Block contents */
+    uint32_t size;                 /* Block size */
+    bool used;                     /* Written at least once */
+    bool dirty;                    /* Changed since last push */
+} NexusUniformBlockData;
 
 /**
  * Shader type enumeration
@@ -34,18 +166,35 @@ typedef enum {
 typedef struct NexusShader {
     SDL_GPUShader* vertex_shader;      /* Vertex shader */
     SDL_GPUShader* fragment_shader;    /* Fragment shader */
-    SDL_GPUGraphicsPipeline* pipeline; /* Graphics pipeline */
+    uint64_t vertex_hash;              /* Content hash of the vertex module (0 = none) */
+    uint64_t fragment_hash;            /* Content hash of the fragment module (0 = none) */
+    SDL_GPUGraphicsPipeline* pipeline; /* Default pipeline variant */
+    bool pipeline_cached;              /* Default pipeline is owned by the device's pipeline cache */
+    uint32_t vertex_layout;            /* NEXUS_VERTEX_LAYOUT_* the default variant is built for */
     SDL_GPUDevice* device;             /* GPU device reference */
     char name[64];                     /* Shader name */
+
+    /* Uniforms (resolved at compile time) */
+    NexusShaderUniform uniforms[NEXUS_SHADER_MAX_UNIFORMS]; /* Name to handle table */
+    uint32_t uniform_count;            /* Number of resolved uniforms */
+    uint8_t uniform_lookup[NEXUS_SHADER_UNIFORM_LOOKUP_SIZE]; /* Uniform slot + 1 by name hash (0 = empty) */
+    NexusUniformBlockData blocks[NEXUS_UNIFORM_BLOCK_COUNT]; /* Shadow copies of the blocks */
 } NexusShader;
 
 /* Shader functions */
 NexusShader* nexus_shader_create(SDL_GPUDevice* device, const char* name);
 void nexus_shader_destroy(NexusShader* shader);
 bool nexus_shader_load_from_source(NexusShader* shader, NexusShaderType type, NexusShaderLanguage language, const char* source);
+bool nexus_shader_load_from_memory(NexusShader* shader, NexusShaderType type, NexusShaderLanguage language, const void* code, size_t size);
 bool nexus_shader_load_from_file(NexusShader* shader, NexusShaderType type, NexusShaderLanguage language, const char* filename);
+void nexus_shader_set_vertex_layout(NexusShader* shader, uint32_t vertex_layout);
 bool nexus_shader_compile(NexusShader* shader);
 void nexus_shader_bind(NexusShader* shader, SDL_GPURenderPass* render_pass);
+NexusUniformHandle nexus_shader_get_uniform(const NexusShader* shader, const char* name);
+int32_t nexus_shader_get_uniform_slot(const NexusShader* shader, const char* name);
+void nexus_shader_set_uniform_slot(NexusShader* shader, int32_t slot, const void* data, uint32_t size);
+void nexus_shader_set_uniform_data(NexusShader* shader, NexusUniformHandle handle, const void* data, uint32_t size);
+void nexus_shader_push_uniforms(NexusShader* shader, SDL_GPUCommandBuffer* cmd_buffer, bool force);
 void nexus_shader_set_uniform_float(NexusShader* shader, const char* name, float value);
 void nexus_shader_set_uniform_float2(NexusShader* shader, const char* name, float x, float y);
 void nexus_shader_set_uniform_float3(NexusShader* shader, const char* name, float x, float y, float z);
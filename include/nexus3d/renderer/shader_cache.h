@@ -0,0 +1,118 @@
+/**
+ * Nexus3D Shader Cache
+ * On-disk cache of shader blobs and the pipeline variants used by previous runs
+ */
+
+#ifndef NEXUS3D_SHADER_CACHE_H
+#define NEXUS3D_SHADER_CACHE_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "nexus3d/renderer/shader.h"
+#include "nexus3d/renderer/pipeline_cache.h"
+#include "nexus3d/utils/mapped_file.h"
+
+/* Maximum length of the cache directory path */
+#define NEXUS_SHADER_CACHE_MAX_PATH 256
+
+/**
+ * Translates shader source into a format the device accepts
+ * The output is allocated with malloc and freed by the cache
+ */
+typedef bool (*NexusShaderCompileFunc)(const void* source, size_t source_size, NexusShaderLanguage language,
+                                       SDL_GPUShaderStage stage, SDL_GPUShaderFormat format,
+                                       void** code, size_t* code_size, void* user_data);
+
+/**
+ * Shader code ready for SDL_CreateGPUShader
+ */
+typedef struct {
+    const void* code;              /* Code in the device format */
+    size_t size;                   /* Code size in bytes */
+    SDL_GPUShaderFormat format;    /* Code format */
+    NexusMappedFile file;          /* Mapped cache file (cache hits) */
+    void* compiled;                /* Compiler output (cache misses) */
+} NexusShaderBlob;
+
+/**
+ * Persisted pipeline variant (shader content hashes + render state)
+ */
+typedef struct {
+    uint64_t vertex_hash;          /* Content hash of the vertex module */
+    uint64_t fragment_hash;        /* Content hash of the fragment module */
+    uint32_t vertex_layout;        /* NEXUS_VERTEX_LAYOUT_* */
+    uint32_t blend_mode;           /* NexusBlendMode */
+    uint32_t cull_mode;            /* SDL_GPUCullMode */
+    uint32_t fill_mode;            /* SDL_GPUFillMode */
+    uint32_t color_write;          /* Color writes enabled */
+    uint32_t depth_test;           /* Depth test enabled */
+    uint32_t depth_write;          /* Depth write enabled */
+    uint32_t depth_compare;        /* SDL_GPUCompareOp */
+    float depth_bias;              /* Constant depth bias */
+    float depth_bias_slope;        /* Slope scaled depth bias */
+    uint32_t color_format;         /* SDL_GPUTextureFormat */
+    uint32_t depth_format;         /* SDL_GPUTextureFormat */
+    uint32_t sample_count;         /* SDL_GPUSampleCount */
+} NexusPipelineRecord;
+
+/**
+ * Pipeline queued for background creation
+ */
+typedef struct {
+    const NexusShader* shader;     /* Shader the variant is built from */
+    NexusPipelineState state;      /* Variant state */
+} NexusPipelinePrewarmJob;
+
+/**
+ * Shader cache structure
+ */
+typedef struct NexusShaderCache {
+    SDL_GPUDevice* device;         /* GPU device reference */
+    char directory[NEXUS_SHADER_CACHE_MAX_PATH]; /* Cache directory */
+
+    /* Source translation */
+    NexusShaderCompileFunc compiler; /* Optional source translator */
+    void* compiler_data;           /* Translator user data */
+
+    /* Pipeline variants seen by this and previous runs */
+    NexusPipelineRecord* records;  /* Variant list */
+    uint32_t record_count;         /* Number of variants */
+    uint32_t record_capacity;      /* Allocated variant capacity */
+    bool records_dirty;            /* List changed since it was saved */
+    SDL_Mutex* lock;               /* Guards the list (pipelines are built on the prewarm thread) */
+
+    /* Background prewarming */
+    SDL_Thread* prewarm_thread;    /* Worker creating pipelines before the first frame */
+    NexusPipelinePrewarmJob* jobs; /* Variants the worker creates */
+    uint32_t job_count;            /* Number of jobs */
+    SDL_AtomicInt jobs_done;       /* Jobs the worker has finished */
+
+    /* Stats */
+    uint32_t blob_hits;            /* Blobs loaded from the cache */
+    uint32_t blob_misses;          /* Blobs compiled and stored */
+} NexusShaderCache;
+
+/* Shader cache functions */
+NexusShaderCache* nexus_shader_cache_create(SDL_GPUDevice* device, const char* directory);
+void nexus_shader_cache_destroy(NexusShaderCache* cache);
+NexusShaderCache* nexus_shader_cache_get(SDL_GPUDevice* device);
+void nexus_shader_cache_set_compiler(NexusShaderCache* cache, NexusShaderCompileFunc compiler, void* user_data);
+uint64_t nexus_shader_cache_hash(SDL_GPUDevice* device, SDL_GPUShaderStage stage, SDL_GPUShaderFormat format,
+                                 const void* code, size_t size);
+
+/* Shader blob functions */
+bool nexus_shader_cache_get_blob(NexusShaderCache* cache, uint64_t hash, const void* source, size_t source_size,
+                                 NexusShaderLanguage language, SDL_GPUShaderStage stage, NexusShaderBlob* blob);
+void nexus_shader_cache_release_blob(NexusShaderBlob* blob);
+
+/* Pipeline list functions */
+void nexus_shader_cache_record_pipeline(NexusShaderCache* cache, const NexusShader* shader,
+                                        const NexusPipelineState* state);
+bool nexus_shader_cache_save(NexusShaderCache* cache);
+uint32_t nexus_shader_cache_prewarm(NexusShaderCache* cache, const NexusShader* const* shaders, uint32_t count);
+bool nexus_shader_cache_is_prewarming(NexusShaderCache* cache);
+void nexus_shader_cache_wait(NexusShaderCache* cache);
+
+#endif /* NEXUS3D_SHADER_CACHE_H */
@@ -0,0 +1,177 @@
+/**
+ * Nexus3D Shadow Atlas
+ * Shadow map tiles of all shadowed lights packed into one depth texture,
+ * with cascades for directional lights and per tile caching
+ */
+
+#ifndef NEXUS3D_SHADOW_ATLAS_H
+#define NEXUS3D_SHADOW_ATLAS_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "nexus3d/renderer/camera.h"
+#include "nexus3d/renderer/culling.h"
+#include "nexus3d/renderer/light_clusters.h"
+#include "nexus3d/renderer/material.h"
+#include "nexus3d/renderer/mesh.h"
+#include "nexus3d/renderer/shader.h"
+#include "nexus3d/renderer/upload.h"
+
+/* Atlas and tile sizes (powers of two) */
+#define NEXUS_SHADOW_ATLAS_DEFAULT_SIZE 4096
+#define NEXUS_SHADOW_MIN_TILE_SIZE      128
+#define NEXUS_SHADOW_DEFAULT_RESOLUTION 1024  /* Tile size of lights that leave shadow_resolution at 0 */
+
+/* Cascaded shadow maps of directional lights */
+#define NEXUS_SHADOW_MAX_CASCADES       4
+#define NEXUS_SHADOW_DEFAULT_CASCADES   4
+#define NEXUS_SHADOW_DEFAULT_DISTANCE   100.0f /* View distance the last cascade ends at */
+#define NEXUS_SHADOW_CASCADE_LAMBDA     0.75f  /* Blend of logarithmic (1) and uniform (0) cascade splits */
+
+/* Per frame limits */
+#define NEXUS_SHADOW_MAX_LIGHTS 32             /* Shadowed lights */
+#define NEXUS_SHADOW_MAX_VIEWS  64             /* Rendered or cached tiles (a point light takes 6) */
+#define NEXUS_SHADOW_MAX_FACES  6              /* Most tiles of one light */
+
+/* Rasterizer depth bias of shadow casters */
+#define NEXUS_SHADOW_DEPTH_BIAS 2.0f
+#define NEXUS_SHADOW_SLOPE_BIAS 2.5f
+
+/**
+ * Shadow view as stored in the shadow view storage buffer (std430)
+ * A shadowed light stores its first view in NexusLightData.spot[2] and its
+ * view count in spot[3] (0 = no shadows). Directional lights have one view
+ * per cascade, the first one whose params.x is beyond the fragment's view
+ * depth applies. Point lights have six, in +X -X +Y -Y +Z -Z order. The
+ * atlas is sampled at
+ *   uv = atlas_rect.xy + (clip.xy / clip.w * vec2(0.5, -0.5) + 0.5) * atlas_rect.zw
+ */
+typedef struct {
+    float view_projection[16];     /* World to light clip space */
+    float atlas_rect[4];           /* Tile offset (xy) and size (zw) in atlas uv */
+    float params[4];               /* Cascade end or light range (x), near (y) and far (z) planes, world texel size at unit depth (w) */
+} NexusShadowView;
+
+/**
+ * Shadow caster of the current frame
+ */
+typedef struct {
+    NexusMesh* mesh;               /* Mesh to draw */
+    uint32_t lod;                  /* Detail level of the mesh */
+    NexusMaterial* material;       /* Material (culling state, may be NULL) */
+    NexusShader* shader;           /* Shader providing the vertex stage */
+    float transform[16];           /* World transform (column major) */
+    float bounds_min[3];           /* World space AABB minimum */
+    float bounds_max[3];           /* World space AABB maximum */
+    uint64_t hash;                 /* Hash of mesh, level, culling and transform (cache signatures) */
+} NexusShadowCaster;
+
+/**
+ * Atlas tile
+ */
+typedef struct {
+    uint16_t x;                    /* Left edge in texels */
+    uint16_t y;                    /* Top edge in texels */
+    uint16_t size;                 /* Edge length in texels */
+    uint16_t node;                 /* Quadtree node of the tile */
+} NexusShadowTile;
+
+/**
+ * Shadowed light, slots persist across frames so their tiles stay cached
+ */
+typedef struct {
+    uint64_t id;                   /* Caller's light id (0 = free slot) */
+    uint32_t type;                 /* NEXUS_LIGHT_TYPE_* the tiles were allocated for */
+    uint32_t resolution;           /* Requested tile size */
+    uint32_t tile_count;           /* Allocated tiles */
+    NexusShadowTile tiles[NEXUS_SHADOW_MAX_FACES]; /* Tile per view */
+    uint64_t signatures[NEXUS_SHADOW_MAX_FACES];   /* Matrix and caster signature each tile was rendered with */
+    bool valid[NEXUS_SHADOW_MAX_FACES];            /* Tile holds the depth of its signature */
+    bool requested;                /* Light was added this frame */
+} NexusShadowLight;
+
+/**
+ * Shadow request of the current frame
+ */
+typedef struct {
+    uint64_t id;                   /* Caller's light id, stable across frames */
+    uint32_t light_index;          /* Frame light to shadow */
+    uint32_t resolution;           /* Requested tile size (0 = NEXUS_SHADOW_DEFAULT_RESOLUTION) */
+} NexusShadowRequest;
+
+/**
+ * Per view data of the current frame
+ */
+typedef struct {
+    uint32_t slot;                 /* Shadowed light slot */
+    uint32_t face;                 /* Cascade or cube face */
+    float view[16];                /* Light view matrix */
+    float projection[16];          /* Light projection matrix */
+    uint32_t caster_offset;        /* First entry of draw_casters (dirty views) */
+    uint32_t caster_count;         /* Casters to draw (dirty views) */
+    bool dirty;                    /* Tile is re-rendered this frame */
+} NexusShadowViewInfo;
+
+/**
+ * Shadow atlas structure
+ */
+typedef struct NexusShadowAtlas {
+    /* Tile allocation */
+    uint32_t size;                 /* Atlas edge length in texels */
+    uint32_t levels;               /* Quadtree levels (atlas down to NEXUS_SHADOW_MIN_TILE_SIZE) */
+    uint8_t* nodes;                /* Quadtree node states, level by level */
+    NexusShadowLight lights[NEXUS_SHADOW_MAX_LIGHTS]; /* Shadowed light slots */
+
+    /* Lights of the frame */
+    NexusShadowRequest requests[NEXUS_SHADOW_MAX_LIGHTS]; /* Shadowed lights added this frame */
+    uint32_t request_count;        /* Number of requests */
+
+    /* Settings */
+    uint32_t cascade_count;        /* Cascades of directional lights */
+    float distance;                /* View distance covered by the cascades */
+
+    /* Casters of the frame */
+    NexusShadowCaster* casters;    /* Casters in submission order, grouped by state when built */
+    uint32_t caster_count;         /* Number of casters */
+    uint32_t caster_capacity;      /* Allocated casters */
+    NexusCullingBuffer* caster_bounds; /* Caster bounds tested against each light frustum */
+
+    /* Views of the frame */
+    NexusShadowView views[NEXUS_SHADOW_MAX_VIEWS];         /* GPU view data */
+    NexusShadowViewInfo view_info[NEXUS_SHADOW_MAX_VIEWS]; /* CPU view data */
+    uint32_t view_count;           /* Views of the frame */
+    uint32_t dirty_count;          /* Views re-rendered this frame */
+    uint32_t* draw_casters;        /* Caster indices of the dirty views */
+    uint32_t draw_caster_count;    /* Used caster indices */
+    uint32_t draw_caster_capacity; /* Allocated caster indices */
+    bool built;                    /* Built since the last reset */
+
+    /* GPU resources */
+    SDL_GPUDevice* device;         /* GPU device reference */
+    SDL_GPUTexture* texture;       /* Depth atlas */
+    SDL_GPUTextureFormat format;   /* Depth format of the atlas */
+    SDL_GPUSampler* sampler;       /* Depth comparison sampler */
+    SDL_GPUTexture* placeholder;   /* 1x1 depth texture bound in place of the atlas while it is rendered */
+    SDL_GPUBuffer* view_buffer;    /* NEXUS_SHADOW_MAX_VIEWS shadow views */
+    NexusMesh* clear_mesh;         /* Quad resetting a tile to the far plane */
+} NexusShadowAtlas;
+
+/* Shadow atlas functions */
+NexusShadowAtlas* nexus_shadow_atlas_create(SDL_GPUDevice* device, uint32_t size, uint32_t cascade_count,
+                                            float distance);
+void nexus_shadow_atlas_destroy(NexusShadowAtlas* atlas);
+void nexus_shadow_atlas_reset_lights(NexusShadowAtlas* atlas);
+void nexus_shadow_atlas_reset_casters(NexusShadowAtlas* atlas);
+bool nexus_shadow_atlas_add_light(NexusShadowAtlas* atlas, uint64_t id, uint32_t light_index, uint32_t resolution);
+bool nexus_shadow_atlas_add_caster(NexusShadowAtlas* atlas, NexusMesh* mesh, uint32_t lod, NexusMaterial* material,
+                                   NexusShader* shader, const float* transform, const float* bounds_min,
+                                   const float* bounds_max);
+bool nexus_shadow_atlas_build(NexusShadowAtlas* atlas, NexusLightData* lights, uint32_t light_count,
+                              const NexusCamera* camera);
+void nexus_shadow_atlas_finish(NexusShadowAtlas* atlas, bool rendered);
+bool nexus_shadow_atlas_upload(NexusShadowAtlas* atlas, NexusUploadManager* manager);
+void nexus_shadow_atlas_bind(const NexusShadowAtlas* atlas, SDL_GPURenderPass* render_pass);
+void nexus_shadow_atlas_bind_placeholder(const NexusShadowAtlas* atlas, SDL_GPURenderPass* render_pass);
+
+#endif /* NEXUS3D_SHADOW_ATLAS_H */
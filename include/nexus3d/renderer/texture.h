@@ -57,7 +57,13 @@ typedef enum {
     NEXUS_TEXTURE_FORMAT_DEPTH16,   /* Depth, 16-bit */
     NEXUS_TEXTURE_FORMAT_DEPTH24,   /* Depth, 24-bit */
     NEXUS_TEXTURE_FORMAT_DEPTH32F,  /* Depth, 32-bit float */
-    NEXUS_TEXTURE_FORMAT_DEPTH24_STENCIL8 /* Depth/stencil, 24-bit depth, 8-bit stencil */
+    NEXUS_TEXTURE_FORMAT_DEPTH24_STENCIL8, /* Depth/stencil, 24-bit depth, 8-bit stencil */
+    NEXUS_TEXTURE_FORMAT_BC1,       /* Block compressed RGBA, 8 bytes per 4x4 block (desktop) */
+    NEXUS_TEXTURE_FORMAT_BC3,       /* Block compressed RGBA, 16 bytes per 4x4 block (desktop) */
+    NEXUS_TEXTURE_FORMAT_BC7,       /* Block compressed RGBA, 16 bytes per 4x4 block (desktop) */
+    NEXUS_TEXTURE_FORMAT_ASTC_4X4,  /* Block compressed RGBA, 16 bytes per 4x4 block (mobile) */
+    NEXUS_TEXTURE_FORMAT_ASTC_6X6,  /* Block compressed RGBA, 16 bytes per 6x6 block (mobile) */
+    NEXUS_TEXTURE_FORMAT_ASTC_8X8   /* Block compressed RGBA, 16 bytes per 8x8 block (mobile) */
 } NexusTextureFormat;
 
 /**
@@ -86,20 +92,39 @@ typedef struct NexusTexture {
     char name[64];                  /* Texture name */
 } NexusTexture;
 
+/**
+ * Decoded image in CPU memory
+ */
+typedef struct {
+    void* pixels;                   /* Tightly packed texels (malloc) */
+    size_t size;                    /* Size of the texels in bytes */
+    uint32_t width;                 /* Image width */
+    uint32_t height;                /* Image height */
+    NexusTextureFormat format;      /* Texel format */
+} NexusImageData;
+
 /* Texture functions */
 NexusTexture* nexus_texture_create(SDL_GPUDevice* device, const char* name, NexusTextureType type, 
                                   uint32_t width, uint32_t height, uint32_t depth, 
                                   NexusTextureFormat format, uint32_t mip_levels);
 void nexus_texture_destroy(NexusTexture* texture);
 bool nexus_texture_set_data(NexusTexture* texture, const void* data, size_t size);
+bool nexus_texture_set_mip_data(NexusTexture* texture, uint32_t mip_level, uint32_t layer, const void* data, size_t size);
+size_t nexus_texture_get_mip_size(const NexusTexture* texture, uint32_t mip_level);
+bool nexus_texture_format_is_compressed(NexusTextureFormat format);
 bool nexus_texture_generate_mipmaps(NexusTexture* texture);
 void nexus_texture_set_filter(NexusTexture* texture, NexusTextureFilter min_filter, NexusTextureFilter mag_filter);
 void nexus_texture_set_wrap(NexusTexture* texture, NexusTextureWrap wrap_s, NexusTextureWrap wrap_t, NexusTextureWrap wrap_r);
 void nexus_texture_bind(NexusTexture* texture, SDL_GPURenderPass* render_pass, uint32_t binding);
 
 /* Texture loading functions */
+bool nexus_texture_decode_file(const char* filename, NexusImageData* image);
+void nexus_image_data_free(NexusImageData* image);
+NexusTexture* nexus_texture_create_from_image(SDL_GPUDevice* device, const char* name, const NexusImageData* image,
+                                              bool generate_mipmaps);
 NexusTexture* nexus_texture_load_from_file(SDL_GPUDevice* device, const char* filename, bool generate_mipmaps);
 NexusTexture* nexus_texture_load_cubemap_from_files(SDL_GPUDevice* device, const char* filenames[6], bool generate_mipmaps);
+NexusTexture* nexus_texture_load_compressed(SDL_GPUDevice* device, const char* filename);
 
 /* Utility texture creation functions */
 NexusTexture* nexus_texture_create_solid_color(SDL_GPUDevice* device, float r, float g, float b, float a);
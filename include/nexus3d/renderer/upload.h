@@ -0,0 +1,107 @@
+/**
+ * Nexus3D Upload Manager
+ * Shared staging ring for batched buffer and texture uploads
+ */
+
+#ifndef NEXUS3D_UPLOAD_H
+#define NEXUS3D_UPLOAD_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Default size of the staging ring */
+#define NEXUS_UPLOAD_RING_SIZE (32u * 1024u * 1024u)
+
+/* Staging allocations are aligned to this many bytes */
+#define NEXUS_UPLOAD_ALIGNMENT 16u
+
+/* Maximum number of submitted batches that can be in flight */
+#define NEXUS_UPLOAD_MAX_BATCHES 8
+
+/**
+ * Upload destination type
+ */
+typedef enum {
+    NEXUS_UPLOAD_BUFFER,
+    NEXUS_UPLOAD_TEXTURE,
+    NEXUS_UPLOAD_MIPMAPS           /* Mip chain generation after the batch's copies */
+} NexusUploadType;
+
+/**
+ * Copy recorded into the next batch
+ */
+typedef struct {
+    NexusUploadType type;          /* Destination type */
+    SDL_GPUTransferBuffer* transfer; /* Dedicated transfer buffer (NULL = staging ring) */
+    uint32_t source_offset;        /* Offset of the data in the transfer buffer */
+    uint32_t size;                 /* Size of the data in bytes */
+    bool cycle;                    /* Cycle the destination if it is still in use */
+
+    /* Buffer destination */
+    SDL_GPUBuffer* buffer;         /* Destination buffer */
+    uint32_t buffer_offset;        /* Destination offset in bytes */
+
+    /* Texture destination */
+    SDL_GPUTextureRegion region;   /* Destination texture region */
+    uint32_t pixels_per_row;       /* Source row length in pixels (0 = tightly packed) */
+    uint32_t rows_per_layer;       /* Source rows per layer (0 = tightly packed) */
+} NexusUploadCopy;
+
+/**
+ * Submitted batch waiting for the GPU
+ */
+typedef struct {
+    SDL_GPUFence* fence;           /* Signaled when the batch has executed */
+    uint64_t ring_end;             /* Ring write position at submission */
+} NexusUploadBatch;
+
+/**
+ * Upload manager structure
+ */
+typedef struct NexusUploadManager {
+    SDL_GPUDevice* device;         /* GPU device reference */
+    SDL_Mutex* lock;               /* Serializes uploads from different threads */
+
+    /* Staging ring */
+    SDL_GPUTransferBuffer* ring;   /* Ring transfer buffer shared by all uploads */
+    uint8_t* mapped;               /* Mapped ring memory while a batch is being filled */
+    uint32_t ring_size;            /* Ring size in bytes */
+    uint64_t head;                 /* Total bytes handed out (write position) */
+    uint64_t tail;                 /* Total bytes reclaimed (oldest byte still in use) */
+
+    /* Pending copies */
+    NexusUploadCopy* copies;       /* Copies recorded into the next batch */
+    uint32_t copy_count;           /* Number of pending copies */
+    uint32_t copy_capacity;        /* Allocated copy capacity */
+
+    /* In-flight batches (oldest first) */
+    NexusUploadBatch batches[NEXUS_UPLOAD_MAX_BATCHES];
+    uint32_t batch_count;          /* Number of batches in flight */
+
+    /* Stats */
+    uint64_t bytes_uploaded;       /* Bytes staged since creation */
+    uint32_t batches_submitted;    /* Batches submitted since creation */
+} NexusUploadManager;
+
+/* Upload manager functions */
+NexusUploadManager* nexus_upload_manager_create(SDL_GPUDevice* device, uint32_t ring_size);
+void nexus_upload_manager_destroy(NexusUploadManager* manager);
+NexusUploadManager* nexus_upload_manager_get(SDL_GPUDevice* device);
+void nexus_upload_manager_lock(NexusUploadManager* manager);
+void nexus_upload_manager_unlock(NexusUploadManager* manager);
+void* nexus_upload_manager_begin_buffer(NexusUploadManager* manager, SDL_GPUBuffer* buffer, uint32_t offset,
+                                        uint32_t size, bool cycle);
+bool nexus_upload_manager_upload_buffer(NexusUploadManager* manager, SDL_GPUBuffer* buffer, uint32_t offset,
+                                        const void* data, uint32_t size, bool cycle);
+bool nexus_upload_manager_upload_texture(NexusUploadManager* manager, const SDL_GPUTextureRegion* region,
+                                         const void* data, uint32_t size, bool cycle);
+bool nexus_upload_manager_generate_mipmaps(NexusUploadManager* manager, SDL_GPUTexture* texture);
+void nexus_upload_manager_cancel_buffer(NexusUploadManager* manager, SDL_GPUBuffer* buffer);
+void nexus_upload_manager_cancel_texture(NexusUploadManager* manager, SDL_GPUTexture* texture);
+bool nexus_upload_manager_flush(NexusUploadManager* manager);
+void nexus_upload_manager_reclaim(NexusUploadManager* manager);
+void nexus_upload_manager_wait_idle(NexusUploadManager* manager);
+uint32_t nexus_upload_manager_get_pending_count(const NexusUploadManager* manager);
+
+#endif /* NEXUS3D_UPLOAD_H */
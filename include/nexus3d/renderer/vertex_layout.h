@@ -0,0 +1,65 @@
+/**
+ * Nexus3D Vertex Layouts
+ * Vertex buffer formats a mesh can be stored in and the attribute
+ * descriptors pipelines are built from
+ */
+
+#ifndef NEXUS3D_VERTEX_LAYOUT_H
+#define NEXUS3D_VERTEX_LAYOUT_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Vertex layouts a mesh can be stored in and a pipeline can be built for
+ * Every layout feeds attribute locations 0-3 (position, normal, uv, color)
+ * as floats, so shaders written for the default layout also read compact
+ * meshes. Position only pipelines read location 0 alone
+ */
+#define NEXUS_VERTEX_LAYOUT_DEFAULT  0u  /* NexusVertex, 48 bytes */
+#define NEXUS_VERTEX_LAYOUT_COMPACT  1u  /* NexusVertexCompact, 24 bytes */
+#define NEXUS_VERTEX_LAYOUT_POSITION 2u  /* Position stream only, 12 bytes (shadow and depth passes) */
+#define NEXUS_VERTEX_LAYOUT_COUNT    3u
+
+/* Most per-vertex attributes of a layout */
+#define NEXUS_VERTEX_LAYOUT_MAX_ATTRIBUTES 4
+
+/**
+ * Vertex structure (full precision, the source format of every layout)
+ */
+typedef struct {
+    float position[3];  /* x, y, z */
+    float normal[3];    /* nx, ny, nz */
+    float texcoord[2];  /* u, v */
+    float color[4];     /* r, g, b, a */
+} NexusVertex;
+
+/**
+ * Compact vertex structure
+ */
+typedef struct {
+    float position[3];    /* x, y, z */
+    int8_t normal[4];     /* nx, ny, nz as snorm8, w = 0 */
+    uint16_t texcoord[2]; /* u, v as half floats */
+    uint8_t color[4];     /* r, g, b, a as unorm8 */
+} NexusVertexCompact;
+
+/**
+ * Vertex layout descriptor
+ */
+typedef struct {
+    const char* name;                  /* Layout name */
+    uint32_t stride;                   /* Bytes per vertex (vertex buffer pitch) */
+    uint32_t attribute_count;          /* Number of per-vertex attributes */
+    SDL_GPUVertexAttribute attributes[NEXUS_VERTEX_LAYOUT_MAX_ATTRIBUTES]; /* Slot 0 attributes */
+} NexusVertexLayout;
+
+/* Vertex layout functions */
+const NexusVertexLayout* nexus_vertex_layout_get(uint32_t layout);
+uint32_t nexus_vertex_layout_get_stride(uint32_t layout);
+bool nexus_vertex_layout_encode(uint32_t layout, const NexusVertex* vertices, uint32_t vertex_count, void* out);
+uint16_t nexus_float_to_half(float value);
+float nexus_half_to_float(uint16_t value);
+
+#endif /* NEXUS3D_VERTEX_LAYOUT_H */
@@ -0,0 +1,140 @@
+/**
+ * Nexus3D Allocators
+ * Linear arenas for transient data (double buffered frame arena, per-thread
+ * scratch) and fixed-size pools for long lived handles
+ */
+
+#ifndef NEXUS3D_ALLOCATOR_H
+#define NEXUS3D_ALLOCATOR_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Default sizes */
+#define NEXUS_FRAME_ARENA_DEFAULT_SIZE (4u * 1024u * 1024u)   /* Per frame buffer */
+#define NEXUS_SCRATCH_ARENA_DEFAULT_SIZE (1u * 1024u * 1024u) /* Per thread */
+
+/* Alignment of arena allocations without an explicit alignment */
+#define NEXUS_ARENA_DEFAULT_ALIGNMENT 16
+
+/**
+ * Arena memory block (data follows the header)
+ */
+typedef struct NexusArenaBlock {
+    struct NexusArenaBlock* prev;  /* Previously filled block */
+    size_t capacity;               /* Usable bytes */
+    size_t offset;                 /* Bytes handed out */
+} NexusArenaBlock;
+
+/**
+ * Linear arena
+ * Allocations are bumped from the current block, more blocks are chained when
+ * it runs out and folded into one block of the high-water size on reset
+ */
+typedef struct {
+    NexusArenaBlock* current;      /* Block allocations come from */
+    size_t block_size;             /* Minimum block size */
+    size_t used;                   /* Bytes handed out since the last reset */
+    size_t high_water;             /* Most bytes ever in use */
+    uint32_t alloc_count;          /* Allocations since the last reset */
+    uint32_t block_count;          /* Chained blocks */
+} NexusArena;
+
+/**
+ * Arena position to roll back to
+ */
+typedef struct {
+    NexusArenaBlock* block;        /* Current block at the time of the mark */
+    size_t offset;                 /* Block offset at the time of the mark */
+    size_t used;                   /* Arena usage at the time of the mark */
+    uint32_t alloc_count;          /* Allocation count at the time of the mark */
+} NexusArenaMark;
+
+/**
+ * Scratch allocation scope of the calling thread
+ */
+typedef struct {
+    NexusArena* arena;             /* Thread scratch arena */
+    NexusArenaMark mark;           /* Position released by nexus_scratch_end */
+} NexusScratch;
+
+/**
+ * Fixed-size pool
+ * Zero initialize it with NEXUS_POOL_INIT, chunks are allocated on demand and
+ * kept until the pool is released
+ */
+typedef struct {
+    size_t element_size;           /* Bytes per element (at least a pointer) */
+    uint32_t chunk_elements;       /* Elements added per chunk */
+    void* free_list;               /* First free element */
+    void* chunks;                  /* Allocated chunks (linked through their first word) */
+    uint32_t capacity;             /* Elements in all chunks */
+    uint32_t live;                 /* Elements handed out */
+    uint32_t high_water;           /* Most elements ever handed out */
+    uint64_t alloc_count;          /* Total allocations */
+    SDL_SpinLock lock;             /* Guards the pool (handles are created on loader threads) */
+} NexusPool;
+
+#define NEXUS_POOL_INIT(type, chunk) { sizeof(type) > sizeof(void*) ? sizeof(type) : sizeof(void*), (chunk), NULL, NULL, 0, 0, 0, 0, 0 }
+
+/**
+ * Arena statistics
+ */
+typedef struct {
+    size_t used;                   /* Bytes in use */
+    size_t capacity;               /* Bytes in all blocks */
+    size_t high_water;             /* Most bytes ever in use */
+    uint32_t alloc_count;          /* Allocations since the last reset */
+    uint32_t block_count;          /* Chained blocks */
+} NexusArenaStats;
+
+/**
+ * Pool statistics
+ */
+typedef struct {
+    uint32_t live;                 /* Elements in use */
+    uint32_t capacity;             /* Elements allocated */
+    uint32_t high_water;           /* Most elements ever in use */
+    uint64_t alloc_count;          /* Total allocations */
+} NexusPoolStats;
+
+/**
+ * Engine memory statistics
+ */
+typedef struct {
+    NexusArenaStats frame;         /* Frame arena being filled */
+    size_t frame_high_water;       /* Most frame memory used by a single frame */
+    uint32_t scratch_arenas;       /* Threads that created a scratch arena */
+    size_t scratch_high_water;     /* Most scratch memory used by a single thread */
+} NexusMemoryStats;
+
+/* Arena functions */
+void nexus_arena_init(NexusArena* arena, size_t block_size);
+void nexus_arena_release(NexusArena* arena);
+void* nexus_arena_alloc(NexusArena* arena, size_t size, size_t alignment);
+void* nexus_arena_calloc(NexusArena* arena, size_t count, size_t size);
+NexusArenaMark nexus_arena_mark(const NexusArena* arena);
+void nexus_arena_rewind(NexusArena* arena, NexusArenaMark mark);
+void nexus_arena_reset(NexusArena* arena);
+NexusArenaStats nexus_arena_get_stats(const NexusArena* arena);
+
+/* Pool functions */
+void* nexus_pool_alloc(NexusPool* pool);
+void nexus_pool_free(NexusPool* pool, void* element);
+void nexus_pool_release(NexusPool* pool);
+NexusPoolStats nexus_pool_get_stats(NexusPool* pool);
+
+/* Engine memory (frame arena and thread scratch) */
+void nexus_memory_init(size_t frame_arena_size, size_t scratch_arena_size);
+void nexus_memory_shutdown(void);
+void nexus_memory_begin_frame(void);
+void* nexus_frame_alloc(size_t size);
+void* nexus_frame_calloc(size_t count, size_t size);
+NexusScratch nexus_scratch_begin(void);
+void* nexus_scratch_alloc(NexusScratch* scratch, size_t size);
+void nexus_scratch_end(NexusScratch* scratch);
+NexusMemoryStats nexus_memory_get_stats(void);
+
+#endif /* NEXUS3D_ALLOCATOR_H */
@@ -1,13 +1,23 @@
 /**
  * Nexus3D Logger System
- * Handles logging and debugging output
+ * Handles logging and debugging output, either synchronously on the logging
+ * thread or through per-thread rings drained by a writer thread
  */
 
 #ifndef NEXUS3D_LOGGER_H
 #define NEXUS3D_LOGGER_H
 
+#include <SDL3/SDL.h>
 #include <stdbool.h>
 #include <stdarg.h>
+#include <stdint.h>
+
+/* Asynchronous mode limits */
+#define NEXUS_LOGGER_MAX_THREADS  64      /* Threads with a ring of their own, others log synchronously */
+#define NEXUS_LOGGER_RING_SIZE    65536   /* Bytes of each thread's ring (power of two) */
+#define NEXUS_LOGGER_MAX_RECORD   1024    /* Largest record, header and packed arguments */
+#define NEXUS_LOGGER_BATCH_SIZE   16384   /* Bytes the writer collects per output before writing */
+#define NEXUS_LOGGER_FLUSH_MS     10      /* Longest time records wait for the writer */
 
 /**
  * Log levels enumeration
@@ -38,12 +48,50 @@ typedef enum {
     NEXUS_LOG_CATEGORY_CUSTOM      /* Custom categories */
 } NexusLogCategory;
 
+/**
+ * Behaviour of a thread whose ring is full
+ */
+typedef enum {
+    NEXUS_LOG_OVERFLOW_DROP,       /* Drop the record (counted and reported by the writer) */
+    NEXUS_LOG_OVERFLOW_BLOCK       /* Wait until the writer made room */
+} NexusLogOverflowPolicy;
+
 /**
  * Logger callback type
+ * Asynchronous loggers call it on the writer thread
  */
 typedef void (*NexusLoggerCallback)(NexusLogLevel level, NexusLogCategory category, 
                                    const char* message, void* user_data);
 
+/**
+ * Record as stored in a ring, followed by the packed arguments
+ * The writer formats it with the format string, which therefore has to stay
+ * valid (string literals), %s arguments are copied
+ */
+typedef struct {
+    uint32_t size;                 /* Record bytes including the arguments (0 = wrap to the ring start) */
+    uint8_t level;                 /* NexusLogLevel */
+    uint8_t category;              /* NexusLogCategory */
+    uint16_t flags;                /* NEXUS_LOG_RECORD_* */
+    uint64_t timestamp_ns;         /* SDL_GetTicksNS when logged */
+    const char* fmt;               /* Format string (NULL for preformatted messages) */
+} NexusLogRecord;
+
+/* Record flags */
+#define NEXUS_LOG_RECORD_FORMATTED (1u << 0) /* Arguments are the formatted message */
+
+/**
+ * Single producer ring of one logging thread (read by the writer thread)
+ */
+typedef struct {
+    SDL_AtomicU32 head;            /* Read offset of the writer */
+    uint8_t pad0[60];              /* Keep the writer and the producer on separate cache lines */
+    SDL_AtomicU32 tail;            /* Write offset of the producer */
+    uint8_t pad1[60];
+    SDL_AtomicInt ready;           /* Ring is initialized and may be read */
+    uint8_t* data;                 /* NEXUS_LOGGER_RING_SIZE bytes */
+} NexusLogRing;
+
 /**
  * Logger structure
  */
@@ -57,6 +105,24 @@ typedef struct NexusLogger {
     bool color_output;                    /* Use colored output in console */
     NexusLoggerCallback callback;         /* Custom logging callback */
     void* callback_user_data;             /* Custom callback user data */
+
+    /* Asynchronous mode */
+    bool async_output;                    /* Records are formatted and written by the writer thread */
+    NexusLogOverflowPolicy overflow_policy; /* Behaviour of full rings */
+    NexusLogRing* rings;                  /* NEXUS_LOGGER_MAX_THREADS producer rings */
+    SDL_AtomicInt ring_count;             /* Rings claimed by logging threads */
+    SDL_TLSID ring_tls;                   /* Ring of the calling thread */
+    SDL_AtomicInt dropped;                /* Records dropped since the writer last reported */
+    SDL_Thread* writer;                   /* Writer thread */
+    SDL_Semaphore* wake;                  /* Wakes the writer early */
+    SDL_AtomicInt writer_running;         /* Cleared to stop the writer */
+    SDL_AtomicInt writer_passes;          /* Drain passes the writer completed */
+    char* batch;                          /* Writer batches (stdout, stderr, file) */
+    size_t batch_length[3];               /* Bytes collected per batch */
+    int64_t start_time;                   /* Wall clock seconds when async output started */
+    uint64_t start_ticks;                 /* SDL_GetTicksNS matching start_time */
+    int64_t cached_second;                /* Second of cached_time */
+    char cached_time[64];                 /* Time string of the writer */
 } NexusLogger;
 
 /* Logger functions */
@@ -71,6 +137,8 @@ void nexus_logger_enable_console_output(NexusLogger* logger, bool enable);
 void nexus_logger_enable_file_output(NexusLogger* logger, bool enable, const char* file_path);
 void nexus_logger_enable_color_output(NexusLogger* logger, bool enable);
 void nexus_logger_set_callback(NexusLogger* logger, NexusLoggerCallback callback, void* user_data);
+bool nexus_logger_enable_async(NexusLogger* logger, bool enable, NexusLogOverflowPolicy policy);
+void nexus_logger_flush(NexusLogger* logger);
 
 /* Logging functions */
 void nexus_log(NexusLogger* logger, NexusLogLevel level, NexusLogCategory category, const char* fmt, ...);
@@ -81,18 +149,33 @@ void nexus_log_warning(NexusLogger* logger, NexusLogCategory category, const cha
 void nexus_log_error(NexusLogger* logger, NexusLogCategory category, const char* fmt, ...);
 void nexus_log_fatal(NexusLogger* logger, NexusLogCategory category, const char* fmt, ...);
 
-/* Convenience macros */
-#ifdef NEXUS_DEBUG
-    #define NEXUS_LOG_TRACE(logger, category, ...) nexus_log_trace(logger, category, __VA_ARGS__)
-    #define NEXUS_LOG_DEBUG(logger, category, ...) nexus_log_debug(logger, category, __VA_ARGS__)
-#else
-    #define NEXUS_LOG_TRACE(logger, category, ...) ((void)0)
-    #define NEXUS_LOG_DEBUG(logger, category, ...) ((void)0)
+/* Lowest level the convenience macros compile in */
+#ifndef NEXUS_LOG_COMPILE_LEVEL
+    #ifdef NEXUS_DEBUG
+        #define NEXUS_LOG_COMPILE_LEVEL NEXUS_LOG_LEVEL_TRACE
+    #else
+        #define NEXUS_LOG_COMPILE_LEVEL NEXUS_LOG_LEVEL_INFO
+    #endif
 #endif
 
-#define NEXUS_LOG_INFO(logger, category, ...) nexus_log_info(logger, category, __VA_ARGS__)
-#define NEXUS_LOG_WARNING(logger, category, ...) nexus_log_warning(logger, category, __VA_ARGS__)
-#define NEXUS_LOG_ERROR(logger, category, ...) nexus_log_error(logger, category, __VA_ARGS__)
-#define NEXUS_LOG_FATAL(logger, category, ...) nexus_log_fatal(logger, category, __VA_ARGS__)
+/* Level and category check done before any arguments are evaluated */
+#define NEXUS_LOG_ENABLED(logger, level, category) \
+    ((level) >= NEXUS_LOG_COMPILE_LEVEL && (logger) != NULL && (level) >= (logger)->min_level && \
+     (logger)->enabled_categories[(category)])
+
+/* Convenience macros */
+#define NEXUS_LOG(logger, level, category, ...) \
+    do { \
+        if (NEXUS_LOG_ENABLED(logger, level, category)) { \
+            nexus_log(logger, level, category, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define NEXUS_LOG_TRACE(logger, category, ...) NEXUS_LOG(logger, NEXUS_LOG_LEVEL_TRACE, category, __VA_ARGS__)
+#define NEXUS_LOG_DEBUG(logger, category, ...) NEXUS_LOG(logger, NEXUS_LOG_LEVEL_DEBUG, category, __VA_ARGS__)
+#define NEXUS_LOG_INFO(logger, category, ...) NEXUS_LOG(logger, NEXUS_LOG_LEVEL_INFO, category, __VA_ARGS__)
+#define NEXUS_LOG_WARNING(logger, category, ...) NEXUS_LOG(logger, NEXUS_LOG_LEVEL_WARNING, category, __VA_ARGS__)
+#define NEXUS_LOG_ERROR(logger, category, ...) NEXUS_LOG(logger, NEXUS_LOG_LEVEL_ERROR, category, __VA_ARGS__)
+#define NEXUS_LOG_FATAL(logger, category, ...) NEXUS_LOG(logger, NEXUS_LOG_LEVEL_FATAL, category, __VA_ARGS__)
 
 #endif /* NEXUS3D_LOGGER_H */
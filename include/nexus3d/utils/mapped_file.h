@@ -0,0 +1,25 @@
+/**
+ * Nexus3D Mapped File
+ * Read-only memory mapped files for loading assets without copies
+ */
+
+#ifndef NEXUS3D_MAPPED_FILE_H
+#define NEXUS3D_MAPPED_FILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Mapped file structure
+ */
+typedef struct {
+    const void* data;              /* File contents (read-only) */
+    size_t size;                   /* File size in bytes */
+    bool mapped;                   /* Data is a mapping (false = heap copy) */
+} NexusMappedFile;
+
+/* Mapped file functions */
+bool nexus_mapped_file_open(NexusMappedFile* file, const char* filename);
+void nexus_mapped_file_close(NexusMappedFile* file);
+
+#endif /* NEXUS3D_MAPPED_FILE_H */
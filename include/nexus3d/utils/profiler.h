@@ -0,0 +1,76 @@
+/**
+ * Nexus3D CPU Profiler
+ * Hierarchical begin/end scopes recorded into per-thread event buffers and
+ * exported as Chrome trace JSON (chrome://tracing, ui.perfetto.dev), GPU
+ * timings share the timeline on a track of their own
+ * Scopes only exist in builds defining NEXUS_PROFILE, otherwise the macros
+ * compile to nothing and the capture functions are no-ops
+ */
+
+#ifndef NEXUS3D_PROFILER_H
+#define NEXUS3D_PROFILER_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Profiler limits */
+#define NEXUS_PROFILER_MAX_THREADS 64        /* Threads with an event buffer, others are not recorded */
+#define NEXUS_PROFILER_MAX_EVENTS  (1u << 18) /* Events one thread records per capture */
+#define NEXUS_PROFILER_MAX_DEPTH   32        /* Nested scopes per thread */
+
+/**
+ * Finished scope
+ */
+typedef struct {
+    const char* name;              /* Scope name (static string) */
+    uint64_t begin;                /* Performance counter at begin */
+    uint64_t end;                  /* Performance counter at end */
+} NexusProfileEvent;
+
+/**
+ * Open scope
+ */
+typedef struct {
+    const char* name;              /* Scope name */
+    uint64_t begin;                /* Performance counter at begin */
+} NexusProfileScope;
+
+/**
+ * Event buffer of one thread (written by its thread only)
+ */
+typedef struct {
+    NexusProfileEvent* events;     /* NEXUS_PROFILER_MAX_EVENTS events */
+    SDL_AtomicU32 event_count;     /* Events of the current capture, published after writing */
+    SDL_AtomicU32 dropped;         /* Events past the buffer end */
+    uint32_t capture;              /* Capture the events belong to */
+    NexusProfileScope stack[NEXUS_PROFILER_MAX_DEPTH]; /* Open scopes */
+    uint32_t depth;                /* Number of open scopes (may exceed the stack) */
+    SDL_ThreadID thread_id;        /* Owning thread */
+    char name[32];                 /* Thread name in the trace */
+} NexusProfileThread;
+
+/* Profiler functions */
+bool nexus_profiler_init(void);
+void nexus_profiler_shutdown(void);
+void nexus_profiler_set_thread_name(const char* name);
+void nexus_profiler_begin(const char* name);
+void nexus_profiler_end(void);
+void nexus_profiler_add_gpu_event(const char* name, uint64_t begin, uint64_t end);
+void nexus_profiler_start_capture(void);
+void nexus_profiler_stop_capture(void);
+bool nexus_profiler_is_capturing(void);
+bool nexus_profiler_write_trace(const char* filepath);
+
+/* Scope macros, begin and end have to pair up on the same thread */
+#ifdef NEXUS_PROFILE
+    #define NEXUS_PROFILE_BEGIN(name) nexus_profiler_begin(name)
+    #define NEXUS_PROFILE_END() nexus_profiler_end()
+    #define NEXUS_PROFILE_THREAD(name) nexus_profiler_set_thread_name(name)
+#else
+    #define NEXUS_PROFILE_BEGIN(name) ((void)0)
+    #define NEXUS_PROFILE_END() ((void)0)
+    #define NEXUS_PROFILE_THREAD(name) ((void)0)
+#endif
+
+#endif /* NEXUS3D_PROFILER_H */
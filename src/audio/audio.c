@@ -1,13 +1,362 @@
 /**
  * Nexus3D Audio System Implementation
- * Simple placeholder implementation
+ * Software mixer on the SDL audio stream callback with a pooled voice set
  */
 
 #include "nexus3d/audio/audio.h"
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+/* Source IDs carry a serial above the pool index, so stale IDs never match a reused source */
+#define NEXUS_AUDIO_SOURCE_INDEX_BITS 12
+#define NEXUS_AUDIO_SOURCE_INDEX_MASK ((1u << NEXUS_AUDIO_SOURCE_INDEX_BITS) - 1u)
+
+/* Rate sounds are converted to when loaded, the last created audio system's mix rate */
+static int s_sound_mix_rate = NEXUS_AUDIO_DEFAULT_MIX_RATE;
+
+/**
+ * Lock the mixer state, the audio stream callback runs with the same lock held
+ */
+static void nexus_audio_lock(const NexusAudio* audio) {
+    if (audio->audio_stream != NULL) {
+        SDL_LockAudioStream(audio->audio_stream);
+    }
+}
+
+/**
+ * Unlock the mixer state
+ */
+static void nexus_audio_unlock(const NexusAudio* audio) {
+    if (audio->audio_stream != NULL) {
+        SDL_UnlockAudioStream(audio->audio_stream);
+    }
+}
+
+/**
+ * Find the source of an ID (NULL = stopped, stolen or never played)
+ */
+static NexusSoundSource* nexus_audio_find_source(const NexusAudio* audio, Uint32 source_id) {
+    if (source_id == 0) {
+        return NULL;
+    }
+
+    Uint32 index = source_id & NEXUS_AUDIO_SOURCE_INDEX_MASK;
+    if (index >= NEXUS_MAX_SOUND_SOURCES || audio->sources[index].id != source_id) {
+        return NULL;
+    }
+
+    return (NexusSoundSource*)&audio->sources[index];
+}
+
+/**
+ * Return a source to the pool
+ */
+static void nexus_audio_free_source(NexusAudio* audio, NexusSoundSource* source) {
+    if (source->id == 0) {
+        return;
+    }
+
+    source->id = 0;
+    source->sound = NULL;
+    source->stream = NULL;
+    source->is_playing = false;
+    audio->free_sources[audio->free_count++] = (Uint16)(source - audio->sources);
+    audio->source_count--;
+}
+
+/**
+ * Take a source from the pool
+ * A full pool steals the least important voice (lowest priority, then quietest)
+ * unless all of them outrank priority
+ */
+static NexusSoundSource* nexus_audio_alloc_source(NexusAudio* audio, int priority) {
+    if (audio->free_count == 0) {
+        NexusSoundSource* victim = NULL;
+        for (int i = 0; i < NEXUS_MAX_SOUND_SOURCES; i++) {
+            NexusSoundSource* source = &audio->sources[i];
+            if (victim == NULL || source->priority < victim->priority ||
+                (source->priority == victim->priority && source->audibility < victim->audibility)) {
+                victim = source;
+            }
+        }
+        if (victim == NULL || victim->priority > priority) {
+            return NULL;
+        }
+        nexus_audio_free_source(audio, victim);
+    }
+
+    Uint16 index = audio->free_sources[--audio->free_count];
+    NexusSoundSource* source = &audio->sources[index];
+    memset(source, 0, sizeof(NexusSoundSource));
+
+    Uint32 serial = audio->next_serial++;
+    if (audio->next_serial > (0xFFFFFFFFu >> NEXUS_AUDIO_SOURCE_INDEX_BITS)) {
+        audio->next_serial = 1;
+    }
+    source->id = (serial << NEXUS_AUDIO_SOURCE_INDEX_BITS) | index;
+    source->priority = priority;
+    audio->source_count++;
+    return source;
+}
+
+/**
+ * Source frames a voice advances per mixed frame
+ */
+static double nexus_audio_get_step(const NexusAudio* audio, const NexusSoundSource* source) {
+    return (double)source->pitch * (double)source->sound->spec.freq / (double)audio->mix_rate;
+}
+
+/**
+ * Advance a voice that isn't mixed this block, stopping it at its end
+ */
+static void nexus_audio_advance_voice(NexusAudio* audio, NexusSoundSource* source, uint32_t frames) {
+    if (source->stream != NULL) {
+        nexus_sound_stream_skip(source->stream, frames);
+        if (nexus_sound_stream_is_finished(source->stream)) {
+            nexus_audio_free_source(audio, source);
+            return;
+        }
+        source->was_mixed = false;
+        return;
+    }
+
+    double frame_count = (double)source->sound->frame_count;
+    double position = (double)source->position + source->fraction + nexus_audio_get_step(audio, source) * frames;
+
+    if (position >= frame_count) {
+        if (!source->is_looping) {
+            nexus_audio_free_source(audio, source);
+            return;
+        }
+        position = fmod(position, frame_count);
+    }
+
+    source->position = (Uint32)position;
+    source->fraction = position - (double)source->position;
+    source->was_mixed = false;
+}
+
+/**
+ * Mix a streamed voice, its frames are already converted to the mix rate
+ * @return false if the stream ended and the voice was freed
+ */
+static bool nexus_audio_mix_stream_voice(NexusAudio* audio, NexusSoundSource* source, float* out, uint32_t frames,
+                                         float gain_left, float gain_right, float step_left, float step_right) {
+    uint32_t read = nexus_sound_stream_read(source->stream, audio->resample_buffer, frames);
+    if (source->stream->spec.channels == 1) {
+        nexus_mixer_mix_mono(out, audio->resample_buffer, read, gain_left, gain_right, step_left, step_right);
+    } else {
+        nexus_mixer_mix_stereo(out, audio->resample_buffer, read, gain_left, gain_right, step_left, step_right);
+    }
+
+    if (read < frames) {
+        if (nexus_sound_stream_is_finished(source->stream)) {
+            nexus_audio_free_source(audio, source);
+            return false;
+        }
+        audio->stream_underrun_count++;
+    }
+    return true;
+}
+
+/**
+ * Mix a voice into the block, ramping from the gains of its last block
+ * Pitched voices (and sounds loaded at another rate) are resampled first
+ */
+static void nexus_audio_mix_voice(NexusAudio* audio, NexusSoundSource* source, float* out, uint32_t frames,
+                                  float target_left, float target_right) {
+    float gain_left = source->was_mixed ? source->gain_left : target_left;
+    float gain_right = source->was_mixed ? source->gain_right : target_right;
+    float step_left = (target_left - gain_left) / (float)frames;
+    float step_right = (target_right - gain_right) / (float)frames;
+
+    if (source->stream != NULL) {
+        if (nexus_audio_mix_stream_voice(audio, source, out, frames, gain_left, gain_right, step_left, step_right)) {
+            source->gain_left = target_left;
+            source->gain_right = target_right;
+            source->was_mixed = true;
+        }
+        return;
+    }
+
+    const NexusSound* sound = source->sound;
+    const float* samples = (const float*)sound->buffer;
+    uint32_t channels = sound->spec.channels;
+
+    double step = nexus_audio_get_step(audio, source);
+    uint32_t done = 0;
+
+    if (fabs(step - 1.0) < 1e-6) {
+        /* Straight from the converted sound, split where it ends or loops */
+        while (done < frames) {
+            uint32_t count = sound->frame_count - source->position;
+            if (count > frames - done) {
+                count = frames - done;
+            }
+
+            const float* in = samples + (size_t)source->position * channels;
+            float left = gain_left + step_left * (float)done;
+            float right = gain_right + step_right * (float)done;
+            if (channels == 1) {
+                nexus_mixer_mix_mono(out + done * 2, in, count, left, right, step_left, step_right);
+            } else {
+                nexus_mixer_mix_stereo(out + done * 2, in, count, left, right, step_left, step_right);
+            }
+
+            done += count;
+            source->position += count;
+            if (source->position >= sound->frame_count) {
+                if (!source->is_looping) {
+                    nexus_audio_free_source(audio, source);
+                    return;
+                }
+                source->position = 0;
+            }
+        }
+    } else {
+        double position = (double)source->position + source->fraction;
+        uint32_t written = nexus_mixer_resample(audio->resample_buffer, frames, samples, sound->frame_count,
+                                                channels, &position, step, source->is_looping);
+        if (channels == 1) {
+            nexus_mixer_mix_mono(out, audio->resample_buffer, written, gain_left, gain_right, step_left, step_right);
+        } else {
+            nexus_mixer_mix_stereo(out, audio->resample_buffer, written, gain_left, gain_right, step_left, step_right);
+        }
+
+        if (written < frames) {
+            nexus_audio_free_source(audio, source);
+            return;
+        }
+        if (position >= (double)sound->frame_count) {
+            position = fmod(position, (double)sound->frame_count);
+        }
+        source->position = (Uint32)position;
+        source->fraction = position - (double)source->position;
+    }
+
+    source->gain_left = target_left;
+    source->gain_right = target_right;
+    source->was_mixed = true;
+}
+
+/**
+ * Order candidates by priority, then by loudness
+ */
+static int nexus_audio_compare_candidates(const void* a, const void* b) {
+    const NexusAudioVoiceCandidate* ca = (const NexusAudioVoiceCandidate*)a;
+    const NexusAudioVoiceCandidate* cb = (const NexusAudioVoiceCandidate*)b;
+
+    if (ca->priority != cb->priority) {
+        return ca->priority > cb->priority ? -1 : 1;
+    }
+    if (ca->audibility != cb->audibility) {
+        return ca->audibility > cb->audibility ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * Mix one block of the output
+ */
+static void nexus_audio_mix_block(NexusAudio* audio, float* out, uint32_t frames) {
+    memset(out, 0, sizeof(float) * frames * NEXUS_AUDIO_MIX_CHANNELS);
+
+    /* Gather the playing voices into the batch */
+    NexusAudioVoiceBatch* batch = &audio->batch;
+    uint32_t count = 0;
+    for (int i = 0; i < NEXUS_MAX_SOUND_SOURCES; i++) {
+        const NexusSoundSource* source = &audio->sources[i];
+        if (source->id == 0 || source->is_paused || (source->sound == NULL && source->stream == NULL)) {
+            continue;
+        }
+
+        batch->x[count] = source->position3d[0];
+        batch->y[count] = source->position3d[1];
+        batch->z[count] = source->position3d[2];
+        batch->min_distance[count] = source->min_distance;
+        batch->max_distance[count] = source->max_distance;
+        batch->rolloff[count] = source->attenuation;
+        batch->volume[count] = source->volume;
+        batch->pan[count] = source->pan;
+        batch->spatial[count] = source->is_3d ? 1.0f : 0.0f;
+        batch->source[count] = (Uint16)i;
+        count++;
+    }
+
+    /* Listener right vector for panning */
+    vec3 right;
+    glm_vec3_cross(audio->listener_forward, audio->listener_up, right);
+    glm_vec3_normalize(right);
+
+    NexusMixerGainInput input = {
+        batch->x, batch->y, batch->z, batch->min_distance, batch->max_distance, batch->rolloff,
+        batch->volume, batch->pan, batch->spatial
+    };
+    nexus_mixer_compute_gains(&input, count, audio->listener_position, right, audio->config.master_volume,
+                              batch->gain_left, batch->gain_right);
+
+    /* Inaudible voices only advance */
+    uint32_t candidate_count = 0;
+    audio->culled_voice_count = 0;
+    for (uint32_t k = 0; k < count; k++) {
+        NexusSoundSource* source = &audio->sources[batch->source[k]];
+        source->audibility = batch->gain_left[k] + batch->gain_right[k];
+        if (source->audibility <= NEXUS_AUDIO_SILENCE_GAIN) {
+            source->audibility = 0.0f;
+            nexus_audio_advance_voice(audio, source, frames);
+            audio->culled_voice_count++;
+        } else {
+            NexusAudioVoiceCandidate* candidate = &audio->candidates[candidate_count++];
+            candidate->entry = k;
+            candidate->priority = source->priority;
+            candidate->audibility = source->audibility;
+        }
+    }
+
+    /* The most important audible voices get the channels, the rest play on virtually */
+    uint32_t channels = audio->config.max_channels > 0 ? (uint32_t)audio->config.max_channels : 1;
+    if (candidate_count > channels) {
+        qsort(audio->candidates, candidate_count, sizeof(NexusAudioVoiceCandidate), nexus_audio_compare_candidates);
+    }
+
+    audio->mixed_voice_count = 0;
+    audio->virtual_voice_count = 0;
+    for (uint32_t c = 0; c < candidate_count; c++) {
+        Uint32 k = audio->candidates[c].entry;
+        NexusSoundSource* source = &audio->sources[batch->source[k]];
+        if (c < channels) {
+            nexus_audio_mix_voice(audio, source, out, frames, batch->gain_left[k], batch->gain_right[k]);
+            audio->mixed_voice_count++;
+        } else {
+            nexus_audio_advance_voice(audio, source, frames);
+            audio->virtual_voice_count++;
+        }
+    }
+
+    nexus_mixer_clip(out, frames * NEXUS_AUDIO_MIX_CHANNELS);
+}
+
+/**
+ * Audio stream callback, mixes what the device asks for in blocks
+ * Called on the audio thread with the stream locked
+ */
+static void SDLCALL nexus_audio_stream_callback(void* userdata, SDL_AudioStream* stream,
+                                                int additional_amount, int total_amount) {
+    NexusAudio* audio = (NexusAudio*)userdata;
+    (void)total_amount;
+
+    int frame_size = (int)sizeof(float) * NEXUS_AUDIO_MIX_CHANNELS;
+    int frames = (additional_amount + frame_size - 1) / frame_size;
+    while (frames > 0) {
+        uint32_t block = frames < NEXUS_AUDIO_MIX_BLOCK ? (uint32_t)frames : NEXUS_AUDIO_MIX_BLOCK;
+        nexus_audio_mix_block(audio, audio->mix_buffer, block);
+        SDL_PutAudioStreamData(stream, audio->mix_buffer, (int)block * frame_size);
+        frames -= (int)block;
+    }
+}
+
 /**
  * Create the audio system
  */
@@ -18,25 +367,71 @@ NexusAudio* nexus_audio_create(const NexusAudioConfig* config) {
         fprintf(stderr, "Failed to allocate memory for audio system!\n");
         return NULL;
     }
-    
+
     /* Initialize audio structure */
     memset(audio, 0, sizeof(NexusAudio));
-    
+
     /* Set default configuration */
     NexusAudioConfig default_config = {
         .enable_audio = true,
         .max_channels = 32,
-        .master_volume = 0.8f
+        .master_volume = 0.8f,
+        .stream_buffer_ms = NEXUS_SOUND_STREAM_DEFAULT_BUFFER_MS
     };
-    
+
     if (config != NULL) {
         memcpy(&audio->config, config, sizeof(NexusAudioConfig));
     } else {
         memcpy(&audio->config, &default_config, sizeof(NexusAudioConfig));
     }
-    
-    printf("Audio system created (placeholder)\n");
-    
+
+    /* Every source starts out free */
+    for (int i = 0; i < NEXUS_MAX_SOUND_SOURCES; i++) {
+        audio->free_sources[i] = (Uint16)(NEXUS_MAX_SOUND_SOURCES - 1 - i);
+    }
+    audio->free_count = NEXUS_MAX_SOUND_SOURCES;
+    audio->next_serial = 1;
+    audio->mix_rate = NEXUS_AUDIO_DEFAULT_MIX_RATE;
+    audio->sfx_volume = 1.0f;
+    audio->music_volume = 1.0f;
+    glm_vec3_zero(audio->listener_position);
+    glm_vec3_copy((vec3){0.0f, 0.0f, -1.0f}, audio->listener_forward);
+    glm_vec3_copy((vec3){0.0f, 1.0f, 0.0f}, audio->listener_up);
+
+    if (!audio->config.enable_audio) {
+        printf("Audio system created (disabled)\n");
+        return audio;
+    }
+
+    /* Without a device sources are still tracked, nothing is mixed */
+    if (!SDL_InitSubSystem(SDL_INIT_AUDIO)) {
+        fprintf(stderr, "Warning: SDL audio initialization failed: %s\n", SDL_GetError());
+        return audio;
+    }
+
+    /* Mix at the device's rate, so the stream only converts the final mix if at all */
+    SDL_AudioSpec device_spec;
+    if (SDL_GetAudioDeviceFormat(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &device_spec, NULL) && device_spec.freq > 0) {
+        audio->mix_rate = device_spec.freq;
+    }
+    s_sound_mix_rate = audio->mix_rate;
+
+    SDL_AudioSpec mix_spec = { SDL_AUDIO_F32, NEXUS_AUDIO_MIX_CHANNELS, audio->mix_rate };
+    audio->audio_stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &mix_spec,
+                                                    nexus_audio_stream_callback, audio);
+    if (audio->audio_stream == NULL) {
+        fprintf(stderr, "Warning: Failed to open audio device: %s\n", SDL_GetError());
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return audio;
+    }
+
+    audio->audio_device = SDL_GetAudioStreamDevice(audio->audio_stream);
+    audio->initialized = true;
+    SDL_ResumeAudioStreamDevice(audio->audio_stream);
+
+    printf("Audio system created (%d Hz, %d mixed channels, %s mixer)\n",
+           audio->mix_rate, audio->config.max_channels, nexus_mixer_get_kernel_name());
+
     return audio;
 }
 
@@ -47,22 +442,90 @@ void nexus_audio_destroy(NexusAudio* audio) {
     if (audio == NULL) {
         return;
     }
-    
+
+    /* Stops the callback before the mixer state goes away */
+    if (audio->audio_stream != NULL) {
+        SDL_DestroyAudioStream(audio->audio_stream);
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    }
+
     /* Free audio system */
     free(audio);
-    
+
     printf("Audio system destroyed\n");
 }
 
 /**
  * Update the audio system
+ * Mixing runs on the audio thread, the frame only keeps the playing streams decoded
  */
 void nexus_audio_update(NexusAudio* audio, float dt) {
     if (audio == NULL || !audio->config.enable_audio) {
         return;
     }
-    
-    /* No actual implementation yet */
+
+    /* Collect under the lock, decoding happens with the mixer running */
+    NexusSoundStream* streams[NEXUS_MAX_SOUND_SOURCES];
+    int stream_count = 0;
+    nexus_audio_lock(audio);
+    for (int i = 0; i < NEXUS_MAX_SOUND_SOURCES; i++) {
+        if (audio->sources[i].id != 0 && audio->sources[i].stream != NULL) {
+            streams[stream_count++] = audio->sources[i].stream;
+        }
+    }
+    nexus_audio_unlock(audio);
+
+    for (int i = 0; i < stream_count; i++) {
+        nexus_sound_stream_update(streams[i], audio->jobs);
+    }
+}
+
+/**
+ * Set the job system stream decode jobs run on (NULL = decode inline on update)
+ */
+void nexus_audio_set_job_system(NexusAudio* audio, NexusJobSystem* jobs) {
+    if (audio == NULL) {
+        return;
+    }
+
+    audio->jobs = jobs;
+}
+
+/**
+ * Get the rate voices are mixed at in Hz
+ */
+int nexus_audio_get_mix_rate(const NexusAudio* audio) {
+    if (audio == NULL) {
+        return 0;
+    }
+
+    return audio->mix_rate;
+}
+
+/**
+ * Get the voice counts of the last mixed block
+ */
+void nexus_audio_get_voice_stats(const NexusAudio* audio, int* mixed, int* virtual_voices, int* culled) {
+    if (audio == NULL) {
+        return;
+    }
+
+    nexus_audio_lock(audio);
+    if (mixed != NULL) *mixed = audio->mixed_voice_count;
+    if (virtual_voices != NULL) *virtual_voices = audio->virtual_voice_count;
+    if (culled != NULL) *culled = audio->culled_voice_count;
+    nexus_audio_unlock(audio);
+}
+
+/**
+ * Get the number of stream blocks mixed short because decoding fell behind
+ */
+int nexus_audio_get_stream_underruns(const NexusAudio* audio) {
+    if (audio == NULL) {
+        return 0;
+    }
+
+    return audio->stream_underrun_count;
 }
 
 /**
@@ -72,12 +535,14 @@ void nexus_audio_set_master_volume(NexusAudio* audio, float volume) {
     if (audio == NULL) {
         return;
     }
-    
+
     /* Clamp volume to [0.0, 1.0] */
     if (volume < 0.0f) volume = 0.0f;
     if (volume > 1.0f) volume = 1.0f;
-    
+
+    nexus_audio_lock(audio);
     audio->config.master_volume = volume;
+    nexus_audio_unlock(audio);
 }
 
 /**
@@ -87,7 +552,7 @@ float nexus_audio_get_master_volume(const NexusAudio* audio) {
     if (audio == NULL) {
         return 0.0f;
     }
-    
+
     return audio->config.master_volume;
 }
 
@@ -98,7 +563,7 @@ bool nexus_audio_is_enabled(const NexusAudio* audio) {
     if (audio == NULL) {
         return false;
     }
-    
+
     return audio->config.enable_audio;
 }
 
@@ -109,61 +574,559 @@ void nexus_audio_set_enabled(NexusAudio* audio, bool enabled) {
     if (audio == NULL) {
         return;
     }
-    
+
     audio->config.enable_audio = enabled;
 }
 
-/* Placeholder functions to satisfy the API */
+/**
+ * Pause or resume all playback at the device
+ */
 void nexus_audio_pause(NexusAudio* audio, bool pause) {
-    /* Placeholder */
+    if (audio == NULL) {
+        return;
+    }
+
+    audio->paused = pause;
+    if (audio->audio_stream != NULL) {
+        if (pause) {
+            SDL_PauseAudioStreamDevice(audio->audio_stream);
+        } else {
+            SDL_ResumeAudioStreamDevice(audio->audio_stream);
+        }
+    }
 }
 
+/**
+ * Check if playback is paused
+ */
 bool nexus_audio_is_paused(const NexusAudio* audio) {
-    return false; /* Placeholder */
+    if (audio == NULL) {
+        return false;
+    }
+
+    return audio->paused;
 }
 
+/**
+ * Set the sound effects volume
+ */
 void nexus_audio_set_sfx_volume(NexusAudio* audio, float volume) {
-    /* Placeholder */
+    if (audio == NULL) {
+        return;
+    }
+
+    audio->sfx_volume = volume < 0.0f ? 0.0f : (volume > 1.0f ? 1.0f : volume);
 }
 
+/**
+ * Get the sound effects volume
+ */
 float nexus_audio_get_sfx_volume(const NexusAudio* audio) {
-    return 0.8f; /* Placeholder */
+    if (audio == NULL) {
+        return 0.0f;
+    }
+
+    return audio->sfx_volume;
 }
 
+/**
+ * Set the music volume
+ */
 void nexus_audio_set_music_volume(NexusAudio* audio, float volume) {
-    /* Placeholder */
+    if (audio == NULL) {
+        return;
+    }
+
+    audio->music_volume = volume < 0.0f ? 0.0f : (volume > 1.0f ? 1.0f : volume);
 }
 
+/**
+ * Get the music volume
+ */
 float nexus_audio_get_music_volume(const NexusAudio* audio) {
-    return 0.8f; /* Placeholder */
+    if (audio == NULL) {
+        return 0.0f;
+    }
+
+    return audio->music_volume;
 }
 
+/**
+ * Set the listener position
+ */
 void nexus_audio_set_listener_position(NexusAudio* audio, float x, float y, float z) {
-    /* Placeholder */
+    if (audio == NULL) {
+        return;
+    }
+
+    nexus_audio_lock(audio);
+    glm_vec3_copy((vec3){x, y, z}, audio->listener_position);
+    nexus_audio_unlock(audio);
 }
 
-void nexus_audio_set_listener_orientation(NexusAudio* audio, float fx, float fy, float fz, 
+/**
+ * Set the listener orientation from its forward and up vectors
+ */
+void nexus_audio_set_listener_orientation(NexusAudio* audio, float fx, float fy, float fz,
                                         float ux, float uy, float uz) {
-    /* Placeholder */
+    if (audio == NULL) {
+        return;
+    }
+
+    nexus_audio_lock(audio);
+    glm_vec3_copy((vec3){fx, fy, fz}, audio->listener_forward);
+    glm_vec3_copy((vec3){ux, uy, uz}, audio->listener_up);
+    glm_vec3_normalize(audio->listener_forward);
+    glm_vec3_normalize(audio->listener_up);
+    nexus_audio_unlock(audio);
 }
 
+/**
+ * Get the listener position
+ */
 void nexus_audio_get_listener_position(const NexusAudio* audio, vec3 position) {
-    /* Placeholder */
-    position[0] = 0.0f;
-    position[1] = 0.0f;
-    position[2] = 0.0f;
+    if (audio == NULL) {
+        glm_vec3_zero(position);
+        return;
+    }
+
+    glm_vec3_copy((float*)audio->listener_position, position);
 }
 
+/**
+ * Get the listener forward vector
+ */
 void nexus_audio_get_listener_forward(const NexusAudio* audio, vec3 forward) {
-    /* Placeholder */
-    forward[0] = 0.0f;
-    forward[1] = 0.0f;
-    forward[2] = -1.0f;
+    if (audio == NULL) {
+        glm_vec3_copy((vec3){0.0f, 0.0f, -1.0f}, forward);
+        return;
+    }
+
+    glm_vec3_copy((float*)audio->listener_forward, forward);
 }
 
+/**
+ * Get the listener up vector
+ */
 void nexus_audio_get_listener_up(const NexusAudio* audio, vec3 up) {
-    /* Placeholder */
-    up[0] = 0.0f;
-    up[1] = 1.0f;
-    up[2] = 0.0f;
+    if (audio == NULL) {
+        glm_vec3_copy((vec3){0.0f, 1.0f, 0.0f}, up);
+        return;
+    }
+
+    glm_vec3_copy((float*)audio->listener_up, up);
+}
+
+/**
+ * Convert decoded samples to the mix format (float, mono or stereo, mix rate) once
+ */
+static NexusSound* nexus_sound_create_converted(const SDL_AudioSpec* spec, const Uint8* data, Uint32 length,
+                                                const char* name) {
+    NexusSound* sound = (NexusSound*)malloc(sizeof(NexusSound));
+    if (sound == NULL) {
+        fprintf(stderr, "Failed to allocate memory for sound!\n");
+        return NULL;
+    }
+    memset(sound, 0, sizeof(NexusSound));
+
+    /* Mono stays mono for cheap 3D voices, more channels are downmixed to stereo */
+    sound->spec.format = SDL_AUDIO_F32;
+    sound->spec.channels = spec->channels == 1 ? 1 : 2;
+    sound->spec.freq = s_sound_mix_rate;
+
+    int converted_length = 0;
+    if (!SDL_ConvertAudioSamples(spec, data, (int)length, &sound->spec, &sound->buffer, &converted_length)) {
+        fprintf(stderr, "Failed to convert sound %s: %s\n", name, SDL_GetError());
+        free(sound);
+        return NULL;
+    }
+
+    sound->length = (Uint32)converted_length;
+    sound->frame_count = sound->length / (Uint32)(sizeof(float) * sound->spec.channels);
+    strncpy(sound->name, name, sizeof(sound->name) - 1);
+    return sound;
+}
+
+/**
+ * Load a sound from a WAV file
+ */
+NexusSound* nexus_sound_load_from_file(const char* filename) {
+    if (filename == NULL) {
+        return NULL;
+    }
+
+    SDL_AudioSpec spec;
+    Uint8* data = NULL;
+    Uint32 length = 0;
+    if (!SDL_LoadWAV(filename, &spec, &data, &length)) {
+        fprintf(stderr, "Failed to load sound %s: %s\n", filename, SDL_GetError());
+        return NULL;
+    }
+
+    /* Keep the file name without its directories */
+    const char* name = strrchr(filename, '/');
+    name = name != NULL ? name + 1 : filename;
+
+    NexusSound* sound = nexus_sound_create_converted(&spec, data, length, name);
+    SDL_free(data);
+    return sound;
+}
+
+/**
+ * Load a sound from WAV data in memory
+ */
+NexusSound* nexus_sound_load_from_memory(const void* data, size_t size, NexusAudioFormat format) {
+    if (data == NULL || size == 0) {
+        return NULL;
+    }
+
+    if (format != NEXUS_AUDIO_FORMAT_WAV) {
+        fprintf(stderr, "Unsupported sound format %d, only WAV can be decoded!\n", (int)format);
+        return NULL;
+    }
+
+    SDL_AudioSpec spec;
+    Uint8* samples = NULL;
+    Uint32 length = 0;
+    SDL_IOStream* io = SDL_IOFromConstMem(data, size);
+    if (io == NULL || !SDL_LoadWAV_IO(io, true, &spec, &samples, &length)) {
+        fprintf(stderr, "Failed to load sound from memory: %s\n", SDL_GetError());
+        return NULL;
+    }
+
+    NexusSound* sound = nexus_sound_create_converted(&spec, samples, length, "memory");
+    SDL_free(samples);
+    return sound;
+}
+
+/**
+ * Destroy a sound, sources playing it have to be stopped first
+ */
+void nexus_sound_destroy(NexusSound* sound) {
+    if (sound == NULL) {
+        return;
+    }
+
+    SDL_free(sound->buffer);
+    free(sound);
+}
+
+/**
+ * Open a stream of a long sound (music, ambience) at the mix rate
+ * Buffers config.stream_buffer_ms of audio, the stream is destroyed with nexus_sound_stream_destroy
+ */
+NexusSoundStream* nexus_audio_open_stream(const NexusAudio* audio, const char* filename) {
+    if (audio == NULL) {
+        return NULL;
+    }
+
+    return nexus_sound_stream_open(filename, audio->mix_rate, audio->config.stream_buffer_ms);
+}
+
+/**
+ * Play a sound stream from its start
+ * A stream feeds a single voice, playing it again restarts it
+ * @return Source ID (0 = no source available)
+ */
+Uint32 nexus_audio_play_stream(NexusAudio* audio, NexusSoundStream* stream, float volume, bool loop) {
+    if (audio == NULL || stream == NULL) {
+        return 0;
+    }
+
+    /* The mixer must not read the stream while it rewinds */
+    nexus_audio_lock(audio);
+    for (int i = 0; i < NEXUS_MAX_SOUND_SOURCES; i++) {
+        if (audio->sources[i].id != 0 && audio->sources[i].stream == stream) {
+            nexus_audio_free_source(audio, &audio->sources[i]);
+        }
+    }
+    nexus_audio_unlock(audio);
+
+    nexus_sound_stream_set_looping(stream, loop);
+    if (!nexus_sound_stream_rewind(stream)) {
+        return 0;
+    }
+
+    nexus_audio_lock(audio);
+    NexusSoundSource* source = nexus_audio_alloc_source(audio, NEXUS_AUDIO_DEFAULT_PRIORITY);
+    Uint32 id = 0;
+    if (source != NULL) {
+        source->stream = stream;
+        source->is_playing = true;
+        source->is_looping = loop;
+        source->volume = volume;
+        source->pitch = 1.0f;
+        source->min_distance = 1.0f;
+        source->max_distance = 100.0f;
+        source->attenuation = 1.0f;
+        id = source->id;
+    }
+    nexus_audio_unlock(audio);
+
+    return id;
+}
+
+/**
+ * Play a sound
+ * @return Source ID (0 = no source available, every voice outranks the new one)
+ */
+Uint32 nexus_audio_play_sound(NexusAudio* audio, NexusSound* sound, float volume, float pitch, bool loop) {
+    if (audio == NULL || sound == NULL || sound->frame_count == 0) {
+        return 0;
+    }
+
+    nexus_audio_lock(audio);
+    NexusSoundSource* source = nexus_audio_alloc_source(audio, NEXUS_AUDIO_DEFAULT_PRIORITY);
+    Uint32 id = 0;
+    if (source != NULL) {
+        source->sound = sound;
+        source->is_playing = true;
+        source->is_looping = loop;
+        source->volume = volume;
+        source->pitch = pitch > 0.0f ? pitch : 1.0f;
+        source->min_distance = 1.0f;
+        source->max_distance = 100.0f;
+        source->attenuation = 1.0f;
+        id = source->id;
+    }
+    nexus_audio_unlock(audio);
+
+    return id;
+}
+
+/**
+ * Play a sound at a position, attenuated between min_dist and max_dist
+ * @return Source ID (0 = no source available)
+ */
+Uint32 nexus_audio_play_sound_3d(NexusAudio* audio, NexusSound* sound, float x, float y, float z,
+                                 float min_dist, float max_dist, float volume, float pitch, bool loop) {
+    if (audio == NULL) {
+        return 0;
+    }
+
+    Uint32 id = nexus_audio_play_sound(audio, sound, volume, pitch, loop);
+
+    nexus_audio_lock(audio);
+    NexusSoundSource* source = nexus_audio_find_source(audio, id);
+    if (source != NULL) {
+        source->is_3d = true;
+        glm_vec3_copy((vec3){x, y, z}, source->position3d);
+        source->min_distance = min_dist > 0.01f ? min_dist : 0.01f;
+        source->max_distance = max_dist > source->min_distance ? max_dist : source->min_distance;
+    }
+    nexus_audio_unlock(audio);
+
+    return id;
+}
+
+/**
+ * Stop a sound, its source returns to the pool
+ */
+void nexus_audio_stop_sound(NexusAudio* audio, Uint32 source_id) {
+    if (audio == NULL) {
+        return;
+    }
+
+    nexus_audio_lock(audio);
+    NexusSoundSource* source = nexus_audio_find_source(audio, source_id);
+    if (source != NULL) {
+        nexus_audio_free_source(audio, source);
+    }
+    nexus_audio_unlock(audio);
+}
+
+/**
+ * Pause or resume a sound
+ */
+void nexus_audio_pause_sound(NexusAudio* audio, Uint32 source_id, bool pause) {
+    if (audio == NULL) {
+        return;
+    }
+
+    nexus_audio_lock(audio);
+    NexusSoundSource* source = nexus_audio_find_source(audio, source_id);
+    if (source != NULL) {
+        source->is_paused = pause;
+        source->was_mixed = false;
+    }
+    nexus_audio_unlock(audio);
+}
+
+/**
+ * Check if a sound is still playing (paused sounds count as playing)
+ */
+bool nexus_audio_is_sound_playing(const NexusAudio* audio, Uint32 source_id) {
+    if (audio == NULL) {
+        return false;
+    }
+
+    nexus_audio_lock(audio);
+    bool playing = nexus_audio_find_source(audio, source_id) != NULL;
+    nexus_audio_unlock(audio);
+
+    return playing;
+}
+
+/**
+ * Set the volume of a sound
+ */
+void nexus_audio_set_sound_volume(NexusAudio* audio, Uint32 source_id, float volume) {
+    if (audio == NULL) {
+        return;
+    }
+
+    nexus_audio_lock(audio);
+    NexusSoundSource* source = nexus_audio_find_source(audio, source_id);
+    if (source != NULL) {
+        source->volume = volume < 0.0f ? 0.0f : volume;
+    }
+    nexus_audio_unlock(audio);
+}
+
+/**
+ * Set the pitch of a sound (1 = unchanged, anything else is resampled)
+ */
+void nexus_audio_set_sound_pitch(NexusAudio* audio, Uint32 source_id, float pitch) {
+    if (audio == NULL || pitch <= 0.0f) {
+        return;
+    }
+
+    nexus_audio_lock(audio);
+    NexusSoundSource* source = nexus_audio_find_source(audio, source_id);
+    if (source != NULL) {
+        source->pitch = pitch;
+        nexus_sound_stream_set_pitch(source->stream, pitch);
+    }
+    nexus_audio_unlock(audio);
+}
+
+/**
+ * Set the pan of a non-spatial sound
+ */
+void nexus_audio_set_sound_pan(NexusAudio* audio, Uint32 source_id, float pan) {
+    if (audio == NULL) {
+        return;
+    }
+
+    nexus_audio_lock(audio);
+    NexusSoundSource* source = nexus_audio_find_source(audio, source_id);
+    if (source != NULL) {
+        source->pan = pan < -1.0f ? -1.0f : (pan > 1.0f ? 1.0f : pan);
+    }
+    nexus_audio_unlock(audio);
+}
+
+/**
+ * Set the position of a sound, making it spatial
+ */
+void nexus_audio_set_sound_position(NexusAudio* audio, Uint32 source_id, float x, float y, float z) {
+    if (audio == NULL) {
+        return;
+    }
+
+    nexus_audio_lock(audio);
+    NexusSoundSource* source = nexus_audio_find_source(audio, source_id);
+    if (source != NULL) {
+        source->is_3d = true;
+        glm_vec3_copy((vec3){x, y, z}, source->position3d);
+    }
+    nexus_audio_unlock(audio);
+}
+
+/**
+ * Set the distance attenuation of a sound starts at
+ */
+void nexus_audio_set_sound_min_distance(NexusAudio* audio, Uint32 source_id, float min_distance) {
+    if (audio == NULL) {
+        return;
+    }
+
+    nexus_audio_lock(audio);
+    NexusSoundSource* source = nexus_audio_find_source(audio, source_id);
+    if (source != NULL) {
+        source->min_distance = min_distance > 0.01f ? min_distance : 0.01f;
+    }
+    nexus_audio_unlock(audio);
+}
+
+/**
+ * Set the distance a sound is culled from
+ */
+void nexus_audio_set_sound_max_distance(NexusAudio* audio, Uint32 source_id, float max_distance) {
+    if (audio == NULL) {
+        return;
+    }
+
+    nexus_audio_lock(audio);
+    NexusSoundSource* source = nexus_audio_find_source(audio, source_id);
+    if (source != NULL) {
+        source->max_distance = max_distance;
+    }
+    nexus_audio_unlock(audio);
+}
+
+/**
+ * Set how fast a sound attenuates past its min distance
+ */
+void nexus_audio_set_sound_attenuation(NexusAudio* audio, Uint32 source_id, float attenuation) {
+    if (audio == NULL) {
+        return;
+    }
+
+    nexus_audio_lock(audio);
+    NexusSoundSource* source = nexus_audio_find_source(audio, source_id);
+    if (source != NULL) {
+        source->attenuation = attenuation < 0.0f ? 0.0f : attenuation;
+    }
+    nexus_audio_unlock(audio);
+}
+
+/**
+ * Set the priority of a sound
+ * Higher priorities are mixed first when voices exceed max_channels and are stolen last
+ */
+void nexus_audio_set_sound_priority(NexusAudio* audio, Uint32 source_id, int priority) {
+    if (audio == NULL) {
+        return;
+    }
+
+    nexus_audio_lock(audio);
+    NexusSoundSource* source = nexus_audio_find_source(audio, source_id);
+    if (source != NULL) {
+        source->priority = priority;
+    }
+    nexus_audio_unlock(audio);
+}
+
+/**
+ * Stop every sound
+ */
+void nexus_audio_stop_all_sounds(NexusAudio* audio) {
+    if (audio == NULL) {
+        return;
+    }
+
+    nexus_audio_lock(audio);
+    for (int i = 0; i < NEXUS_MAX_SOUND_SOURCES; i++) {
+        nexus_audio_free_source(audio, &audio->sources[i]);
+    }
+    nexus_audio_unlock(audio);
+}
+
+/**
+ * Pause or resume every sound
+ */
+void nexus_audio_pause_all_sounds(NexusAudio* audio, bool pause) {
+    if (audio == NULL) {
+        return;
+    }
+
+    nexus_audio_lock(audio);
+    for (int i = 0; i < NEXUS_MAX_SOUND_SOURCES; i++) {
+        if (audio->sources[i].id != 0) {
+            audio->sources[i].is_paused = pause;
+            audio->sources[i].was_mixed = false;
+        }
+    }
+    nexus_audio_unlock(audio);
 }
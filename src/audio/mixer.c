@@ -0,0 +1,336 @@
+/**
+ * Nexus3D Audio Mixer Kernels Implementation
+ * SSE and NEON paths with scalar remainders, picked at compile time
+ */
+
+#include "nexus3d/audio/mixer.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define NEXUS_MIXER_HAS_SSE 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define NEXUS_MIXER_HAS_NEON 1
+#endif
+
+/* Distance below which a 3D voice is centered rather than panned */
+#define NEXUS_MIXER_PAN_EPSILON 1e-4f
+
+/**
+ * Gains of one voice
+ * Inverse distance attenuation clamped to [min_distance, max_distance],
+ * silent from max_distance on, constant power pan
+ */
+static void nexus_mixer_compute_gain(const NexusMixerGainInput* input, uint32_t i, const float* listener,
+                                     const float* right, float master_volume,
+                                     float* gain_left, float* gain_right) {
+    float attenuation = 1.0f;
+    float pan = input->pan[i];
+
+    if (input->spatial[i] > 0.5f) {
+        float dx = input->x[i] - listener[0];
+        float dy = input->y[i] - listener[1];
+        float dz = input->z[i] - listener[2];
+        float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+
+        float min_distance = input->min_distance[i];
+        float clamped = distance < min_distance ? min_distance : distance;
+        attenuation = distance >= input->max_distance[i] ? 0.0f :
+                      min_distance / (min_distance + input->rolloff[i] * (clamped - min_distance));
+        pan = distance > NEXUS_MIXER_PAN_EPSILON ?
+              (dx * right[0] + dy * right[1] + dz * right[2]) / distance : 0.0f;
+    }
+
+    if (pan < -1.0f) pan = -1.0f;
+    if (pan > 1.0f) pan = 1.0f;
+
+    float gain = input->volume[i] * master_volume * attenuation;
+    gain_left[i] = sqrtf(0.5f * (1.0f - pan)) * gain;
+    gain_right[i] = sqrtf(0.5f * (1.0f + pan)) * gain;
+}
+
+/**
+ * Compute the left and right gains of count voices
+ * listener_right is the unit vector pointing to the listener's right
+ */
+void nexus_mixer_compute_gains(const NexusMixerGainInput* input, uint32_t count, const float* listener,
+                               const float* listener_right, float master_volume,
+                               float* gain_left, float* gain_right) {
+    if (input == NULL || listener == NULL || listener_right == NULL || gain_left == NULL || gain_right == NULL) {
+        return;
+    }
+
+    uint32_t i = 0;
+
+#if defined(NEXUS_MIXER_HAS_SSE)
+    /* 4 voices per iteration */
+    const __m128 lx = _mm_set1_ps(listener[0]);
+    const __m128 ly = _mm_set1_ps(listener[1]);
+    const __m128 lz = _mm_set1_ps(listener[2]);
+    const __m128 rx = _mm_set1_ps(listener_right[0]);
+    const __m128 ry = _mm_set1_ps(listener_right[1]);
+    const __m128 rz = _mm_set1_ps(listener_right[2]);
+    const __m128 master = _mm_set1_ps(master_volume);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 epsilon = _mm_set1_ps(NEXUS_MIXER_PAN_EPSILON);
+
+    for (; i + NEXUS_MIXER_LANES <= count; i += NEXUS_MIXER_LANES) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(input->x + i), lx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(input->y + i), ly);
+        __m128 dz = _mm_sub_ps(_mm_loadu_ps(input->z + i), lz);
+        __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                                                 _mm_mul_ps(dz, dz)));
+
+        /* Inverse distance, zero from max_distance on */
+        __m128 min_distance = _mm_loadu_ps(input->min_distance + i);
+        __m128 clamped = _mm_max_ps(distance, min_distance);
+        __m128 attenuation = _mm_div_ps(min_distance,
+                                        _mm_add_ps(min_distance, _mm_mul_ps(_mm_loadu_ps(input->rolloff + i),
+                                                                            _mm_sub_ps(clamped, min_distance))));
+        attenuation = _mm_and_ps(attenuation, _mm_cmplt_ps(distance, _mm_loadu_ps(input->max_distance + i)));
+
+        /* Pan from the direction to the voice, centered when on top of the listener */
+        __m128 side = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, rx), _mm_mul_ps(dy, ry)), _mm_mul_ps(dz, rz));
+        __m128 spatial_pan = _mm_and_ps(_mm_div_ps(side, _mm_max_ps(distance, epsilon)),
+                                        _mm_cmpgt_ps(distance, epsilon));
+
+        /* Plain voices keep their pan and full volume */
+        __m128 spatial = _mm_cmpgt_ps(_mm_loadu_ps(input->spatial + i), half);
+        attenuation = _mm_or_ps(_mm_and_ps(spatial, attenuation), _mm_andnot_ps(spatial, one));
+        __m128 pan = _mm_or_ps(_mm_and_ps(spatial, spatial_pan), _mm_andnot_ps(spatial, _mm_loadu_ps(input->pan + i)));
+        pan = _mm_min_ps(_mm_max_ps(pan, _mm_set1_ps(-1.0f)), one);
+
+        __m128 gain = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(input->volume + i), master), attenuation);
+        _mm_storeu_ps(gain_left + i, _mm_mul_ps(_mm_sqrt_ps(_mm_mul_ps(half, _mm_sub_ps(one, pan))), gain));
+        _mm_storeu_ps(gain_right + i, _mm_mul_ps(_mm_sqrt_ps(_mm_mul_ps(half, _mm_add_ps(one, pan))), gain));
+    }
+#elif defined(NEXUS_MIXER_HAS_NEON) && defined(__aarch64__)
+    /* 4 voices per iteration (vector divide and square root are AArch64 only) */
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const float32x4_t epsilon = vdupq_n_f32(NEXUS_MIXER_PAN_EPSILON);
+
+    for (; i + NEXUS_MIXER_LANES <= count; i += NEXUS_MIXER_LANES) {
+        float32x4_t dx = vsubq_f32(vld1q_f32(input->x + i), vdupq_n_f32(listener[0]));
+        float32x4_t dy = vsubq_f32(vld1q_f32(input->y + i), vdupq_n_f32(listener[1]));
+        float32x4_t dz = vsubq_f32(vld1q_f32(input->z + i), vdupq_n_f32(listener[2]));
+        float32x4_t distance = vsqrtq_f32(vmlaq_f32(vmlaq_f32(vmulq_f32(dx, dx), dy, dy), dz, dz));
+
+        /* Inverse distance, zero from max_distance on */
+        float32x4_t min_distance = vld1q_f32(input->min_distance + i);
+        float32x4_t clamped = vmaxq_f32(distance, min_distance);
+        float32x4_t attenuation = vdivq_f32(min_distance,
+                                            vmlaq_f32(min_distance, vld1q_f32(input->rolloff + i),
+                                                      vsubq_f32(clamped, min_distance)));
+        uint32x4_t audible = vcltq_f32(distance, vld1q_f32(input->max_distance + i));
+        attenuation = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(attenuation), audible));
+
+        /* Pan from the direction to the voice, centered when on top of the listener */
+        float32x4_t side = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(dx, listener_right[0]), dy, listener_right[1]),
+                                       dz, listener_right[2]);
+        float32x4_t spatial_pan = vdivq_f32(side, vmaxq_f32(distance, epsilon));
+        spatial_pan = vbslq_f32(vcgtq_f32(distance, epsilon), spatial_pan, vdupq_n_f32(0.0f));
+
+        /* Plain voices keep their pan and full volume */
+        uint32x4_t spatial = vcgtq_f32(vld1q_f32(input->spatial + i), half);
+        attenuation = vbslq_f32(spatial, attenuation, one);
+        float32x4_t pan = vbslq_f32(spatial, spatial_pan, vld1q_f32(input->pan + i));
+        pan = vminq_f32(vmaxq_f32(pan, vdupq_n_f32(-1.0f)), one);
+
+        float32x4_t gain = vmulq_f32(vmulq_n_f32(vld1q_f32(input->volume + i), master_volume), attenuation);
+        vst1q_f32(gain_left + i, vmulq_f32(vsqrtq_f32(vmulq_f32(half, vsubq_f32(one, pan))), gain));
+        vst1q_f32(gain_right + i, vmulq_f32(vsqrtq_f32(vmulq_f32(half, vaddq_f32(one, pan))), gain));
+    }
+#endif
+
+    /* Scalar fallback (and remainder) */
+    for (; i < count; i++) {
+        nexus_mixer_compute_gain(input, i, listener, listener_right, master_volume, gain_left, gain_right);
+    }
+}
+
+/**
+ * Accumulate a mono voice into an interleaved stereo mix
+ * Gains ramp linearly by step per frame, so gain changes between blocks don't click
+ */
+void nexus_mixer_mix_mono(float* out, const float* in, uint32_t frames,
+                          float gain_left, float gain_right, float step_left, float step_right) {
+    uint32_t i = 0;
+
+#if defined(NEXUS_MIXER_HAS_SSE)
+    /* 4 frames per iteration */
+    __m128 left = _mm_setr_ps(gain_left, gain_left + step_left, gain_left + 2.0f * step_left,
+                              gain_left + 3.0f * step_left);
+    __m128 right = _mm_setr_ps(gain_right, gain_right + step_right, gain_right + 2.0f * step_right,
+                               gain_right + 3.0f * step_right);
+    const __m128 left_step = _mm_set1_ps(4.0f * step_left);
+    const __m128 right_step = _mm_set1_ps(4.0f * step_right);
+
+    for (; i + 4 <= frames; i += 4) {
+        __m128 samples = _mm_loadu_ps(in + i);
+        __m128 l = _mm_mul_ps(samples, left);
+        __m128 r = _mm_mul_ps(samples, right);
+        _mm_storeu_ps(out + 2 * i, _mm_add_ps(_mm_loadu_ps(out + 2 * i), _mm_unpacklo_ps(l, r)));
+        _mm_storeu_ps(out + 2 * i + 4, _mm_add_ps(_mm_loadu_ps(out + 2 * i + 4), _mm_unpackhi_ps(l, r)));
+        left = _mm_add_ps(left, left_step);
+        right = _mm_add_ps(right, right_step);
+    }
+#elif defined(NEXUS_MIXER_HAS_NEON)
+    /* 4 frames per iteration */
+    const float lanes[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+    float32x4_t ramp = vld1q_f32(lanes);
+    float32x4_t left = vmlaq_n_f32(vdupq_n_f32(gain_left), ramp, step_left);
+    float32x4_t right = vmlaq_n_f32(vdupq_n_f32(gain_right), ramp, step_right);
+    const float32x4_t left_step = vdupq_n_f32(4.0f * step_left);
+    const float32x4_t right_step = vdupq_n_f32(4.0f * step_right);
+
+    for (; i + 4 <= frames; i += 4) {
+        float32x4_t samples = vld1q_f32(in + i);
+        float32x4x2_t mixed = vld2q_f32(out + 2 * i);
+        mixed.val[0] = vmlaq_f32(mixed.val[0], samples, left);
+        mixed.val[1] = vmlaq_f32(mixed.val[1], samples, right);
+        vst2q_f32(out + 2 * i, mixed);
+        left = vaddq_f32(left, left_step);
+        right = vaddq_f32(right, right_step);
+    }
+#endif
+
+    /* Scalar fallback (and remainder) */
+    for (; i < frames; i++) {
+        out[2 * i] += in[i] * (gain_left + step_left * (float)i);
+        out[2 * i + 1] += in[i] * (gain_right + step_right * (float)i);
+    }
+}
+
+/**
+ * Accumulate an interleaved stereo voice into an interleaved stereo mix
+ * Gains ramp linearly by step per frame, like nexus_mixer_mix_mono
+ */
+void nexus_mixer_mix_stereo(float* out, const float* in, uint32_t frames,
+                            float gain_left, float gain_right, float step_left, float step_right) {
+    uint32_t i = 0;
+
+#if defined(NEXUS_MIXER_HAS_SSE)
+    /* 4 frames (two vectors of left/right pairs) per iteration */
+    __m128 first = _mm_setr_ps(gain_left, gain_right, gain_left + step_left, gain_right + step_right);
+    __m128 second = _mm_setr_ps(gain_left + 2.0f * step_left, gain_right + 2.0f * step_right,
+                                gain_left + 3.0f * step_left, gain_right + 3.0f * step_right);
+    const __m128 step = _mm_setr_ps(4.0f * step_left, 4.0f * step_right, 4.0f * step_left, 4.0f * step_right);
+
+    for (; i + 4 <= frames; i += 4) {
+        _mm_storeu_ps(out + 2 * i, _mm_add_ps(_mm_loadu_ps(out + 2 * i),
+                                              _mm_mul_ps(_mm_loadu_ps(in + 2 * i), first)));
+        _mm_storeu_ps(out + 2 * i + 4, _mm_add_ps(_mm_loadu_ps(out + 2 * i + 4),
+                                                  _mm_mul_ps(_mm_loadu_ps(in + 2 * i + 4), second)));
+        first = _mm_add_ps(first, step);
+        second = _mm_add_ps(second, step);
+    }
+#elif defined(NEXUS_MIXER_HAS_NEON)
+    /* 4 frames per iteration, deinterleaved on load */
+    const float lanes[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+    float32x4_t ramp = vld1q_f32(lanes);
+    float32x4_t left = vmlaq_n_f32(vdupq_n_f32(gain_left), ramp, step_left);
+    float32x4_t right = vmlaq_n_f32(vdupq_n_f32(gain_right), ramp, step_right);
+    const float32x4_t left_step = vdupq_n_f32(4.0f * step_left);
+    const float32x4_t right_step = vdupq_n_f32(4.0f * step_right);
+
+    for (; i + 4 <= frames; i += 4) {
+        float32x4x2_t samples = vld2q_f32(in + 2 * i);
+        float32x4x2_t mixed = vld2q_f32(out + 2 * i);
+        mixed.val[0] = vmlaq_f32(mixed.val[0], samples.val[0], left);
+        mixed.val[1] = vmlaq_f32(mixed.val[1], samples.val[1], right);
+        vst2q_f32(out + 2 * i, mixed);
+        left = vaddq_f32(left, left_step);
+        right = vaddq_f32(right, right_step);
+    }
+#endif
+
+    /* Scalar fallback (and remainder) */
+    for (; i < frames; i++) {
+        out[2 * i] += in[2 * i] * (gain_left + step_left * (float)i);
+        out[2 * i + 1] += in[2 * i + 1] * (gain_right + step_right * (float)i);
+    }
+}
+
+/**
+ * Resample a voice with linear interpolation
+ * Reads from position (in source frames, advanced by step per output frame),
+ * looping voices wrap around, others stop at their last frame
+ * @return Frames written (fewer than out_frames once a voice without loop ended)
+ */
+uint32_t nexus_mixer_resample(float* out, uint32_t out_frames, const float* in, uint32_t in_frames,
+                              uint32_t channels, double* position, double step, bool loop) {
+    if (out == NULL || in == NULL || position == NULL || in_frames == 0 || channels == 0) {
+        return 0;
+    }
+
+    double p = *position;
+    uint32_t written = 0;
+
+    while (written < out_frames) {
+        if (p >= (double)in_frames) {
+            if (!loop) {
+                break;
+            }
+            p = fmod(p, (double)in_frames);
+        }
+
+        uint32_t index = (uint32_t)p;
+        uint32_t next = index + 1 < in_frames ? index + 1 : (loop ? 0 : index);
+        float t = (float)(p - (double)index);
+
+        const float* a = in + (size_t)index * channels;
+        const float* b = in + (size_t)next * channels;
+        for (uint32_t c = 0; c < channels; c++) {
+            out[written * channels + c] = a[c] + (b[c] - a[c]) * t;
+        }
+
+        written++;
+        p += step;
+    }
+
+    *position = p;
+    return written;
+}
+
+/**
+ * Clamp mixed samples to [-1, 1]
+ */
+void nexus_mixer_clip(float* buffer, uint32_t count) {
+    uint32_t i = 0;
+
+#if defined(NEXUS_MIXER_HAS_SSE)
+    const __m128 low = _mm_set1_ps(-1.0f);
+    const __m128 high = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(buffer + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(buffer + i), low), high));
+    }
+#elif defined(NEXUS_MIXER_HAS_NEON)
+    const float32x4_t low = vdupq_n_f32(-1.0f);
+    const float32x4_t high = vdupq_n_f32(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(buffer + i, vminq_f32(vmaxq_f32(vld1q_f32(buffer + i), low), high));
+    }
+#endif
+
+    for (; i < count; i++) {
+        if (buffer[i] < -1.0f) buffer[i] = -1.0f;
+        if (buffer[i] > 1.0f) buffer[i] = 1.0f;
+    }
+}
+
+/**
+ * Get the name of the compiled in kernel set
+ */
+const char* nexus_mixer_get_kernel_name(void) {
+#if defined(NEXUS_MIXER_HAS_SSE)
+    return "sse";
+#elif defined(NEXUS_MIXER_HAS_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
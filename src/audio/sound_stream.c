@@ -0,0 +1,534 @@
+/**
+ * Nexus3D Sound Stream Implementation
+ * Chunked decoding into a single producer, single consumer ring
+ */
+
+#include "nexus3d/audio/sound_stream.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Smallest ring, keeps a few mix blocks buffered even for tiny buffer_ms */
+#define NEXUS_SOUND_STREAM_MIN_CAPACITY 1024
+
+/* RIFF chunk identifiers (little endian) */
+#define NEXUS_WAV_ID_RIFF 0x46464952u
+#define NEXUS_WAV_ID_WAVE 0x45564157u
+#define NEXUS_WAV_ID_FMT  0x20746D66u
+#define NEXUS_WAV_ID_DATA 0x61746164u
+
+/* WAV format tags */
+#define NEXUS_WAV_FORMAT_PCM        0x0001
+#define NEXUS_WAV_FORMAT_FLOAT      0x0003
+#define NEXUS_WAV_FORMAT_EXTENSIBLE 0xFFFE
+
+/**
+ * WAV decoder state
+ */
+typedef struct {
+    SDL_IOStream* io;              /* Source file */
+    Sint64 data_start;             /* File offset of the first sample */
+    Uint32 data_size;              /* Sample bytes */
+    Uint32 data_read;              /* Sample bytes read */
+    Uint32 block_align;            /* Bytes per frame */
+} NexusWavDecoder;
+
+/**
+ * Read the RIFF header up to the data chunk
+ */
+static bool nexus_wav_open(SDL_IOStream* io, void** state, SDL_AudioSpec* spec) {
+    Uint32 riff = 0, riff_size = 0, wave = 0;
+    if (!SDL_ReadU32LE(io, &riff) || !SDL_ReadU32LE(io, &riff_size) || !SDL_ReadU32LE(io, &wave) ||
+        riff != NEXUS_WAV_ID_RIFF || wave != NEXUS_WAV_ID_WAVE) {
+        fprintf(stderr, "Not a RIFF WAVE file!\n");
+        return false;
+    }
+
+    /* Walk the chunks, the format has to come before the samples */
+    Uint16 tag = 0, channels = 0, block_align = 0, bits = 0;
+    Uint32 rate = 0, byte_rate = 0;
+    bool have_format = false;
+    Uint32 id = 0, size = 0;
+    for (;;) {
+        if (!SDL_ReadU32LE(io, &id) || !SDL_ReadU32LE(io, &size)) {
+            fprintf(stderr, "WAV file has no data chunk!\n");
+            return false;
+        }
+        Sint64 next = SDL_TellIO(io) + (Sint64)size + (Sint64)(size & 1);
+
+        if (id == NEXUS_WAV_ID_FMT) {
+            if (size < 16 || !SDL_ReadU16LE(io, &tag) || !SDL_ReadU16LE(io, &channels) ||
+                !SDL_ReadU32LE(io, &rate) || !SDL_ReadU32LE(io, &byte_rate) ||
+                !SDL_ReadU16LE(io, &block_align) || !SDL_ReadU16LE(io, &bits)) {
+                fprintf(stderr, "Invalid WAV format chunk!\n");
+                return false;
+            }
+
+            /* Extensible files carry the real tag in the first two bytes of the sub format */
+            if (tag == NEXUS_WAV_FORMAT_EXTENSIBLE) {
+                Uint16 extension_size = 0, valid_bits = 0;
+                Uint32 channel_mask = 0;
+                if (size < 40 || !SDL_ReadU16LE(io, &extension_size) || !SDL_ReadU16LE(io, &valid_bits) ||
+                    !SDL_ReadU32LE(io, &channel_mask) || !SDL_ReadU16LE(io, &tag)) {
+                    fprintf(stderr, "Invalid WAV format chunk!\n");
+                    return false;
+                }
+            }
+            have_format = true;
+        } else if (id == NEXUS_WAV_ID_DATA) {
+            if (!have_format) {
+                fprintf(stderr, "WAV data chunk precedes the format chunk!\n");
+                return false;
+            }
+            break;
+        }
+
+        if (SDL_SeekIO(io, next, SDL_IO_SEEK_SET) < 0) {
+            fprintf(stderr, "WAV file has no data chunk!\n");
+            return false;
+        }
+    }
+
+    /* Map the encoding, 24 bit and compressed WAV are not streamed */
+    SDL_AudioFormat format = SDL_AUDIO_UNKNOWN;
+    if (tag == NEXUS_WAV_FORMAT_PCM && bits == 8) format = SDL_AUDIO_U8;
+    else if (tag == NEXUS_WAV_FORMAT_PCM && bits == 16) format = SDL_AUDIO_S16LE;
+    else if (tag == NEXUS_WAV_FORMAT_PCM && bits == 32) format = SDL_AUDIO_S32LE;
+    else if (tag == NEXUS_WAV_FORMAT_FLOAT && bits == 32) format = SDL_AUDIO_F32LE;
+    if (format == SDL_AUDIO_UNKNOWN || channels == 0 || rate == 0 || block_align != channels * (bits / 8)) {
+        fprintf(stderr, "Unsupported WAV encoding (format %u, %u bits)!\n", tag, bits);
+        return false;
+    }
+
+    NexusWavDecoder* wav = (NexusWavDecoder*)malloc(sizeof(NexusWavDecoder));
+    if (wav == NULL) {
+        fprintf(stderr, "Failed to allocate memory for WAV decoder!\n");
+        return false;
+    }
+
+    wav->io = io;
+    wav->data_start = SDL_TellIO(io);
+    wav->data_size = size;
+    wav->data_read = 0;
+    wav->block_align = block_align;
+
+    spec->format = format;
+    spec->channels = channels;
+    spec->freq = (int)rate;
+    *state = wav;
+    return true;
+}
+
+/**
+ * Read whole frames of samples
+ */
+static int nexus_wav_read(void* state, void* buffer, int bytes) {
+    NexusWavDecoder* wav = (NexusWavDecoder*)state;
+
+    Uint32 count = wav->data_size - wav->data_read;
+    if ((Uint32)bytes < count) {
+        count = (Uint32)bytes;
+    }
+    count -= count % wav->block_align;
+    if (count == 0) {
+        return 0;
+    }
+
+    size_t read = SDL_ReadIO(wav->io, buffer, count);
+    if (read < count) {
+        /* Truncated file, end at the last whole frame */
+        wav->data_read = wav->data_size;
+        return (int)(read - read % wav->block_align);
+    }
+
+    wav->data_read += count;
+    return (int)count;
+}
+
+/**
+ * Seek back to the first sample
+ */
+static bool nexus_wav_rewind(void* state) {
+    NexusWavDecoder* wav = (NexusWavDecoder*)state;
+
+    if (SDL_SeekIO(wav->io, wav->data_start, SDL_IO_SEEK_SET) < 0) {
+        return false;
+    }
+    wav->data_read = 0;
+    return true;
+}
+
+/**
+ * Free the WAV decoder state
+ */
+static void nexus_wav_close(void* state) {
+    free(state);
+}
+
+/* Built in decoders */
+static const NexusSoundDecoder s_wav_decoder = {
+    "wav", nexus_wav_open, nexus_wav_read, nexus_wav_rewind, nexus_wav_close
+};
+
+/* Decoder of each format (NULL = not streamable) */
+static const NexusSoundDecoder* s_decoders[NEXUS_AUDIO_FORMAT_COUNT] = {
+    [NEXUS_AUDIO_FORMAT_WAV] = &s_wav_decoder
+};
+
+/**
+ * Register the streaming decoder of a format, replacing the previous one
+ * Has to happen before streams of the format are opened
+ */
+bool nexus_sound_stream_register_decoder(NexusAudioFormat format, const NexusSoundDecoder* decoder) {
+    if (format <= NEXUS_AUDIO_FORMAT_UNKNOWN || format >= NEXUS_AUDIO_FORMAT_COUNT) {
+        return false;
+    }
+    if (decoder != NULL && (decoder->open == NULL || decoder->read == NULL ||
+                            decoder->rewind == NULL || decoder->close == NULL)) {
+        return false;
+    }
+
+    s_decoders[format] = decoder;
+    return true;
+}
+
+/**
+ * Get the format of a file from its extension
+ */
+NexusAudioFormat nexus_sound_stream_get_format(const char* filename) {
+    const char* extension = filename != NULL ? strrchr(filename, '.') : NULL;
+    if (extension == NULL) {
+        return NEXUS_AUDIO_FORMAT_UNKNOWN;
+    }
+
+    if (SDL_strcasecmp(extension, ".wav") == 0) return NEXUS_AUDIO_FORMAT_WAV;
+    if (SDL_strcasecmp(extension, ".ogg") == 0) return NEXUS_AUDIO_FORMAT_OGG;
+    if (SDL_strcasecmp(extension, ".mp3") == 0) return NEXUS_AUDIO_FORMAT_MP3;
+    if (SDL_strcasecmp(extension, ".opus") == 0) return NEXUS_AUDIO_FORMAT_OPUS;
+    return NEXUS_AUDIO_FORMAT_UNKNOWN;
+}
+
+/**
+ * Decode job entry point, fills the ring
+ */
+static void nexus_sound_stream_job(void* data) {
+    NexusSoundStream* stream = (NexusSoundStream*)data;
+
+    nexus_sound_stream_decode(stream, stream->capacity);
+}
+
+/**
+ * Open a sound stream
+ * The ring holds buffer_ms of audio at mix_rate (rounded up to a power of two frames),
+ * the first chunk is decoded right away
+ */
+NexusSoundStream* nexus_sound_stream_open(const char* filename, int mix_rate, int buffer_ms) {
+    if (filename == NULL || mix_rate <= 0) {
+        return NULL;
+    }
+
+    const NexusSoundDecoder* decoder = s_decoders[nexus_sound_stream_get_format(filename)];
+    if (decoder == NULL) {
+        fprintf(stderr, "No stream decoder for %s!\n", filename);
+        return NULL;
+    }
+
+    /* Allocate stream structure */
+    NexusSoundStream* stream = (NexusSoundStream*)malloc(sizeof(NexusSoundStream));
+    if (stream == NULL) {
+        fprintf(stderr, "Failed to allocate memory for sound stream!\n");
+        return NULL;
+    }
+
+    /* Initialize stream structure */
+    memset(stream, 0, sizeof(NexusSoundStream));
+    stream->decoder = decoder;
+    nexus_job_counter_init(&stream->done);
+
+    /* Keep the file name without its directories */
+    const char* name = strrchr(filename, '/');
+    strncpy(stream->name, name != NULL ? name + 1 : filename, sizeof(stream->name) - 1);
+
+    SDL_AudioSpec decoded_spec;
+    stream->io = SDL_IOFromFile(filename, "rb");
+    if (stream->io == NULL || !decoder->open(stream->io, &stream->state, &decoded_spec)) {
+        fprintf(stderr, "Failed to open sound stream %s: %s\n", filename, SDL_GetError());
+        nexus_sound_stream_destroy(stream);
+        return NULL;
+    }
+
+    /* Mono stays mono for cheap 3D voices, more channels are downmixed to stereo */
+    stream->spec.format = SDL_AUDIO_F32;
+    stream->spec.channels = decoded_spec.channels == 1 ? 1 : 2;
+    stream->spec.freq = mix_rate;
+    stream->decoded_frame_size = SDL_AUDIO_FRAMESIZE(decoded_spec);
+
+    if (buffer_ms <= 0) {
+        buffer_ms = NEXUS_SOUND_STREAM_DEFAULT_BUFFER_MS;
+    }
+    uint64_t frames = (uint64_t)mix_rate * (uint64_t)buffer_ms / 1000;
+    stream->capacity = NEXUS_SOUND_STREAM_MIN_CAPACITY;
+    while (stream->capacity < frames && stream->capacity < 0x80000000u) {
+        stream->capacity <<= 1;
+    }
+
+    stream->chunk_size = NEXUS_SOUND_STREAM_CHUNK_FRAMES * stream->decoded_frame_size;
+    stream->converter = SDL_CreateAudioStream(&decoded_spec, &stream->spec);
+    stream->ring = (float*)malloc((size_t)stream->capacity * stream->spec.channels * sizeof(float));
+    stream->chunk = (Uint8*)malloc((size_t)stream->chunk_size);
+    if (stream->converter == NULL || stream->ring == NULL || stream->chunk == NULL) {
+        fprintf(stderr, "Failed to create sound stream %s: %s\n", filename, SDL_GetError());
+        nexus_sound_stream_destroy(stream);
+        return NULL;
+    }
+
+    /* Enough to start playing, the decode job fills the rest */
+    nexus_sound_stream_decode(stream, NEXUS_SOUND_STREAM_CHUNK_FRAMES);
+
+    return stream;
+}
+
+/**
+ * Destroy a sound stream, the source playing it has to be stopped first
+ */
+void nexus_sound_stream_destroy(NexusSoundStream* stream) {
+    if (stream == NULL) {
+        return;
+    }
+
+    /* The decode job still uses the stream */
+    if (stream->jobs != NULL) {
+        nexus_jobs_wait(stream->jobs, &stream->done);
+    }
+
+    if (stream->state != NULL) {
+        stream->decoder->close(stream->state);
+    }
+    if (stream->io != NULL) SDL_CloseIO(stream->io);
+    if (stream->converter != NULL) SDL_DestroyAudioStream(stream->converter);
+    free(stream->ring);
+    free(stream->chunk);
+    free(stream);
+}
+
+/**
+ * Decode until the ring is full, max_frames were written or the end was reached
+ * Runs on the decode job (or inline without a job system), never concurrently with itself
+ * @return Frames written to the ring
+ */
+uint32_t nexus_sound_stream_decode(NexusSoundStream* stream, uint32_t max_frames) {
+    if (stream == NULL) {
+        return 0;
+    }
+
+    uint32_t channels = (uint32_t)stream->spec.channels;
+    int frame_size = (int)(sizeof(float) * channels);
+    uint32_t write = SDL_GetAtomicU32(&stream->write_count);
+    uint32_t written = 0;
+
+    while (written < max_frames) {
+        uint32_t free_frames = stream->capacity - (write - SDL_GetAtomicU32(&stream->read_count));
+        if (free_frames == 0) {
+            break;
+        }
+
+        /* Move converted frames into the ring first */
+        uint32_t available = (uint32_t)(SDL_GetAudioStreamAvailable(stream->converter) / frame_size);
+        if (available > 0) {
+            uint32_t offset = write & (stream->capacity - 1);
+            uint32_t count = available < free_frames ? available : free_frames;
+            if (count > max_frames - written) count = max_frames - written;
+            if (count > stream->capacity - offset) count = stream->capacity - offset;
+
+            int got = SDL_GetAudioStreamData(stream->converter, stream->ring + (size_t)offset * channels,
+                                             (int)count * frame_size);
+            if (got < frame_size) {
+                break;
+            }
+
+            count = (uint32_t)got / (uint32_t)frame_size;
+            write += count;
+            written += count;
+            SDL_SetAtomicU32(&stream->write_count, write);
+            continue;
+        }
+
+        if (stream->flushed) {
+            SDL_SetAtomicInt(&stream->decoder_done, 1);
+            break;
+        }
+
+        /* Converter drained, decode the next chunk */
+        int bytes = stream->decoder->read(stream->state, stream->chunk, stream->chunk_size);
+        if (bytes > 0) {
+            SDL_PutAudioStreamData(stream->converter, stream->chunk, bytes);
+            stream->rewound_empty = false;
+            continue;
+        }
+
+        /* End of the file, the converter keeps its state across the rewind so loops are seamless */
+        if (bytes == 0 && SDL_GetAtomicInt(&stream->looping) && !stream->rewound_empty &&
+            stream->decoder->rewind(stream->state)) {
+            stream->rewound_empty = true;
+            continue;
+        }
+        if (bytes < 0) {
+            fprintf(stderr, "Failed to decode sound stream %s!\n", stream->name);
+        }
+
+        SDL_FlushAudioStream(stream->converter);
+        stream->flushed = true;
+    }
+
+    return written;
+}
+
+/**
+ * Keep the ring filled, called once per frame
+ * Kicks a decode job once the ring is half empty (decodes inline without a job system)
+ */
+void nexus_sound_stream_update(NexusSoundStream* stream, NexusJobSystem* jobs) {
+    if (stream == NULL || SDL_GetAtomicInt(&stream->decoder_done)) {
+        return;
+    }
+    if (!nexus_job_counter_is_done(&stream->done) ||
+        nexus_sound_stream_get_buffered(stream) > stream->capacity / 2) {
+        return;
+    }
+
+    if (jobs == NULL) {
+        nexus_sound_stream_decode(stream, stream->capacity);
+        return;
+    }
+
+    stream->jobs = jobs;
+    nexus_jobs_run(jobs, nexus_sound_stream_job, stream, &stream->done);
+}
+
+/**
+ * Restart a stream from its first frame
+ * Nothing may read the stream meanwhile, the ring is reset and primed again
+ */
+bool nexus_sound_stream_rewind(NexusSoundStream* stream) {
+    if (stream == NULL) {
+        return false;
+    }
+
+    if (stream->jobs != NULL) {
+        nexus_jobs_wait(stream->jobs, &stream->done);
+    }
+    if (!stream->decoder->rewind(stream->state)) {
+        fprintf(stderr, "Failed to rewind sound stream %s!\n", stream->name);
+        return false;
+    }
+
+    SDL_ClearAudioStream(stream->converter);
+    SDL_SetAtomicU32(&stream->write_count, 0);
+    SDL_SetAtomicU32(&stream->read_count, 0);
+    SDL_SetAtomicInt(&stream->decoder_done, 0);
+    stream->flushed = false;
+    stream->rewound_empty = false;
+
+    nexus_sound_stream_decode(stream, NEXUS_SOUND_STREAM_CHUNK_FRAMES);
+    return true;
+}
+
+/**
+ * Set whether the stream starts over at its end
+ */
+void nexus_sound_stream_set_looping(NexusSoundStream* stream, bool loop) {
+    if (stream == NULL) {
+        return;
+    }
+
+    SDL_SetAtomicInt(&stream->looping, loop ? 1 : 0);
+}
+
+/**
+ * Set the pitch of the stream (1 = unchanged)
+ * Applied while converting, frames already in the ring keep the previous pitch
+ */
+void nexus_sound_stream_set_pitch(NexusSoundStream* stream, float pitch) {
+    if (stream == NULL || pitch <= 0.0f) {
+        return;
+    }
+
+    SDL_SetAudioStreamFrequencyRatio(stream->converter, pitch);
+}
+
+/**
+ * Read converted frames (mixer side)
+ * @return Frames read, fewer than requested when the decoder fell behind or the stream ended
+ */
+uint32_t nexus_sound_stream_read(NexusSoundStream* stream, float* out, uint32_t frames) {
+    if (stream == NULL || out == NULL) {
+        return 0;
+    }
+
+    uint32_t read = SDL_GetAtomicU32(&stream->read_count);
+    uint32_t available = SDL_GetAtomicU32(&stream->write_count) - read;
+    uint32_t count = frames < available ? frames : available;
+
+    /* Copy up to the end of the ring, then wrap */
+    uint32_t channels = (uint32_t)stream->spec.channels;
+    uint32_t offset = read & (stream->capacity - 1);
+    uint32_t first = count < stream->capacity - offset ? count : stream->capacity - offset;
+    memcpy(out, stream->ring + (size_t)offset * channels, sizeof(float) * first * channels);
+    memcpy(out + (size_t)first * channels, stream->ring, sizeof(float) * (count - first) * channels);
+
+    SDL_SetAtomicU32(&stream->read_count, read + count);
+    return count;
+}
+
+/**
+ * Drop converted frames without reading them (virtual and culled voices)
+ * @return Frames skipped
+ */
+uint32_t nexus_sound_stream_skip(NexusSoundStream* stream, uint32_t frames) {
+    if (stream == NULL) {
+        return 0;
+    }
+
+    uint32_t read = SDL_GetAtomicU32(&stream->read_count);
+    uint32_t available = SDL_GetAtomicU32(&stream->write_count) - read;
+    uint32_t count = frames < available ? frames : available;
+
+    SDL_SetAtomicU32(&stream->read_count, read + count);
+    return count;
+}
+
+/**
+ * Get the frames decoded but not read yet
+ */
+uint32_t nexus_sound_stream_get_buffered(const NexusSoundStream* stream) {
+    if (stream == NULL) {
+        return 0;
+    }
+
+    NexusSoundStream* mutable_stream = (NexusSoundStream*)stream;
+    return SDL_GetAtomicU32(&mutable_stream->write_count) - SDL_GetAtomicU32(&mutable_stream->read_count);
+}
+
+/**
+ * Check if every frame of the stream was read
+ */
+bool nexus_sound_stream_is_finished(const NexusSoundStream* stream) {
+    if (stream == NULL) {
+        return true;
+    }
+
+    return SDL_GetAtomicInt((SDL_AtomicInt*)&stream->decoder_done) && nexus_sound_stream_get_buffered(stream) == 0;
+}
+
+/**
+ * Get the memory held by the stream in bytes
+ * The converter's own buffer is not included, it never holds more than one chunk
+ */
+size_t nexus_sound_stream_get_memory_size(const NexusSoundStream* stream) {
+    if (stream == NULL) {
+        return 0;
+    }
+
+    return sizeof(NexusSoundStream) + (size_t)stream->capacity * stream->spec.channels * sizeof(float) +
+           (size_t)stream->chunk_size;
+}
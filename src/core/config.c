@@ -63,12 +63,24 @@ void nexus_config_set_defaults(NexusConfig* config) {
     config->graphics.msaa_samples = 4;
     config->graphics.enable_vsync = true;
     config->graphics.max_fps = 0; /* Unlimited */
+    config->graphics.present_mode[0] = '\0'; /* From enable_vsync */
+    config->graphics.frames_in_flight = 2;
     config->graphics.enable_hdr = false;
+    config->graphics.enable_depth_prepass = false;
+    config->graphics.lod_pixel_error = 1.0f;
+    config->graphics.lod_hysteresis = 0.25f;
+    config->graphics.shadow_atlas_size = 4096;
+    config->graphics.shadow_cascades = 4;
+    config->graphics.shadow_distance = 100.0f;
+    config->graphics.shader_cache_path[0] = '\0'; /* Disabled */
+    config->graphics.enable_gpu_driven = false;
+    config->graphics.gpu_cull_shader[0] = '\0';
     
     /* Audio configuration */
     config->audio.enable_audio = true;
     config->audio.max_channels = 32;
     config->audio.master_volume = 1.0f;
+    config->audio.stream_buffer_ms = 500;
     
     /* Physics configuration */
     config->physics.enable_physics = true;
@@ -81,10 +93,27 @@ void nexus_config_set_defaults(NexusConfig* config) {
     config->input.enable_keyboard = true;
     config->input.enable_mouse = true;
     
+    /* Threading configuration */
+    config->threading.worker_threads = 0; /* One per logical core */
+    config->threading.pipelined_rendering = false;
+    config->threading.render_snapshots = 2;
+
+    /* Memory configuration */
+    config->memory.frame_arena_kb = 4096;
+    config->memory.scratch_arena_kb = 1024;
+
+    /* Asset streaming configuration */
+    config->streaming.max_in_flight = 8;
+    config->streaming.upload_budget_kb = 8192;
+    
     /* Debug configuration */
     config->debug.enable_debug_logging = false;
     config->debug.enable_physics_debug = false;
     config->debug.enable_profiling = false;
+    config->debug.profile_frames = 300;
+    strcpy(config->debug.profile_trace_path, "nexus_trace.json");
+    config->debug.async_logging = true;
+    config->debug.log_overflow_block = false;
 }
 
 /**
@@ -136,6 +165,64 @@ bool nexus_config_load_from_file(NexusConfig* config, const char* filepath) {
                 config->window.vsync = (strcmp(v, "true") == 0 || strcmp(v, "1") == 0);
             } else if (strcmp(k, "graphics.enable_shadows") == 0) {
                 config->graphics.enable_shadows = (strcmp(v, "true") == 0 || strcmp(v, "1") == 0);
+            } else if (strcmp(k, "graphics.enable_vsync") == 0) {
+                config->graphics.enable_vsync = (strcmp(v, "true") == 0 || strcmp(v, "1") == 0);
+            } else if (strcmp(k, "graphics.max_fps") == 0) {
+                config->graphics.max_fps = atoi(v);
+            } else if (strcmp(k, "graphics.present_mode") == 0) {
+                strncpy(config->graphics.present_mode, v, sizeof(config->graphics.present_mode) - 1);
+                config->graphics.present_mode[sizeof(config->graphics.present_mode) - 1] = '\0';
+            } else if (strcmp(k, "graphics.frames_in_flight") == 0) {
+                config->graphics.frames_in_flight = atoi(v);
+            } else if (strcmp(k, "threading.worker_threads") == 0) {
+                config->threading.worker_threads = atoi(v);
+            } else if (strcmp(k, "threading.pipelined_rendering") == 0) {
+                config->threading.pipelined_rendering = (strcmp(v, "true") == 0 || strcmp(v, "1") == 0);
+            } else if (strcmp(k, "threading.render_snapshots") == 0) {
+                config->threading.render_snapshots = atoi(v);
+            } else if (strcmp(k, "audio.stream_buffer_ms") == 0) {
+                config->audio.stream_buffer_ms = atoi(v);
+            } else if (strcmp(k, "memory.frame_arena_kb") == 0) {
+                config->memory.frame_arena_kb = atoi(v);
+            } else if (strcmp(k, "memory.scratch_arena_kb") == 0) {
+                config->memory.scratch_arena_kb = atoi(v);
+            } else if (strcmp(k, "streaming.max_in_flight") == 0) {
+                config->streaming.max_in_flight = atoi(v);
+            } else if (strcmp(k, "streaming.upload_budget_kb") == 0) {
+                config->streaming.upload_budget_kb = atoi(v);
+            } else if (strcmp(k, "graphics.enable_depth_prepass") == 0) {
+                config->graphics.enable_depth_prepass = (strcmp(v, "true") == 0 || strcmp(v, "1") == 0);
+            } else if (strcmp(k, "graphics.lod_pixel_error") == 0) {
+                config->graphics.lod_pixel_error = (float)atof(v);
+            } else if (strcmp(k, "graphics.lod_hysteresis") == 0) {
+                config->graphics.lod_hysteresis = (float)atof(v);
+            } else if (strcmp(k, "graphics.shadow_atlas_size") == 0) {
+                config->graphics.shadow_atlas_size = atoi(v);
+            } else if (strcmp(k, "graphics.shadow_cascades") == 0) {
+                config->graphics.shadow_cascades = atoi(v);
+            } else if (strcmp(k, "graphics.shadow_distance") == 0) {
+                config->graphics.shadow_distance = (float)atof(v);
+            } else if (strcmp(k, "graphics.shader_cache_path") == 0) {
+                strncpy(config->graphics.shader_cache_path, v, sizeof(config->graphics.shader_cache_path) - 1);
+                config->graphics.shader_cache_path[sizeof(config->graphics.shader_cache_path) - 1] = '\0';
+            } else if (strcmp(k, "graphics.enable_gpu_driven") == 0) {
+                config->graphics.enable_gpu_driven = (strcmp(v, "true") == 0 || strcmp(v, "1") == 0);
+            } else if (strcmp(k, "graphics.gpu_cull_shader") == 0) {
+                strncpy(config->graphics.gpu_cull_shader, v, sizeof(config->graphics.gpu_cull_shader) - 1);
+                config->graphics.gpu_cull_shader[sizeof(config->graphics.gpu_cull_shader) - 1] = '\0';
+            } else if (strcmp(k, "debug.enable_debug_logging") == 0) {
+                config->debug.enable_debug_logging = (strcmp(v, "true") == 0 || strcmp(v, "1") == 0);
+            } else if (strcmp(k, "debug.enable_profiling") == 0) {
+                config->debug.enable_profiling = (strcmp(v, "true") == 0 || strcmp(v, "1") == 0);
+            } else if (strcmp(k, "debug.profile_frames") == 0) {
+                config->debug.profile_frames = atoi(v);
+            } else if (strcmp(k, "debug.profile_trace_path") == 0) {
+                strncpy(config->debug.profile_trace_path, v, sizeof(config->debug.profile_trace_path) - 1);
+                config->debug.profile_trace_path[sizeof(config->debug.profile_trace_path) - 1] = '\0';
+            } else if (strcmp(k, "debug.async_logging") == 0) {
+                config->debug.async_logging = (strcmp(v, "true") == 0 || strcmp(v, "1") == 0);
+            } else if (strcmp(k, "debug.log_overflow_block") == 0) {
+                config->debug.log_overflow_block = (strcmp(v, "true") == 0 || strcmp(v, "1") == 0);
             }
             /* Add more configuration options as needed */
         }
@@ -180,13 +267,25 @@ bool nexus_config_save_to_file(const NexusConfig* config, const char* filepath)
     fprintf(file, "graphics.msaa_samples=%d\n", config->graphics.msaa_samples);
     fprintf(file, "graphics.enable_vsync=%s\n", config->graphics.enable_vsync ? "true" : "false");
     fprintf(file, "graphics.max_fps=%d\n", config->graphics.max_fps);
-    fprintf(file, "graphics.enable_hdr=%s\n\n", config->graphics.enable_hdr ? "true" : "false");
+    fprintf(file, "graphics.present_mode=%s\n", config->graphics.present_mode);
+    fprintf(file, "graphics.frames_in_flight=%d\n", config->graphics.frames_in_flight);
+    fprintf(file, "graphics.enable_hdr=%s\n", config->graphics.enable_hdr ? "true" : "false");
+    fprintf(file, "graphics.enable_depth_prepass=%s\n", config->graphics.enable_depth_prepass ? "true" : "false");
+    fprintf(file, "graphics.lod_pixel_error=%.2f\n", config->graphics.lod_pixel_error);
+    fprintf(file, "graphics.lod_hysteresis=%.2f\n", config->graphics.lod_hysteresis);
+    fprintf(file, "graphics.shadow_atlas_size=%d\n", config->graphics.shadow_atlas_size);
+    fprintf(file, "graphics.shadow_cascades=%d\n", config->graphics.shadow_cascades);
+    fprintf(file, "graphics.shadow_distance=%.1f\n", config->graphics.shadow_distance);
+    fprintf(file, "graphics.shader_cache_path=%s\n", config->graphics.shader_cache_path);
+    fprintf(file, "graphics.enable_gpu_driven=%s\n", config->graphics.enable_gpu_driven ? "true" : "false");
+    fprintf(file, "graphics.gpu_cull_shader=%s\n\n", config->graphics.gpu_cull_shader);
     
     /* Write audio configuration */
     fprintf(file, "# Audio Configuration\n");
     fprintf(file, "audio.enable_audio=%s\n", config->audio.enable_audio ? "true" : "false");
     fprintf(file, "audio.max_channels=%d\n", config->audio.max_channels);
-    fprintf(file, "audio.master_volume=%f\n\n", config->audio.master_volume);
+    fprintf(file, "audio.master_volume=%f\n", config->audio.master_volume);
+    fprintf(file, "audio.stream_buffer_ms=%d\n\n", config->audio.stream_buffer_ms);
     
     /* Write physics configuration */
     fprintf(file, "# Physics Configuration\n");
@@ -201,11 +300,31 @@ bool nexus_config_save_to_file(const NexusConfig* config, const char* filepath)
     fprintf(file, "input.enable_keyboard=%s\n", config->input.enable_keyboard ? "true" : "false");
     fprintf(file, "input.enable_mouse=%s\n\n", config->input.enable_mouse ? "true" : "false");
     
+    /* Write threading configuration */
+    fprintf(file, "# Threading Configuration\n");
+    fprintf(file, "threading.worker_threads=%d\n", config->threading.worker_threads);
+    fprintf(file, "threading.pipelined_rendering=%s\n", config->threading.pipelined_rendering ? "true" : "false");
+    fprintf(file, "threading.render_snapshots=%d\n\n", config->threading.render_snapshots);
+
+    /* Write memory configuration */
+    fprintf(file, "# Memory Configuration\n");
+    fprintf(file, "memory.frame_arena_kb=%d\n", config->memory.frame_arena_kb);
+    fprintf(file, "memory.scratch_arena_kb=%d\n\n", config->memory.scratch_arena_kb);
+
+    /* Write asset streaming configuration */
+    fprintf(file, "# Asset Streaming Configuration\n");
+    fprintf(file, "streaming.max_in_flight=%d\n", config->streaming.max_in_flight);
+    fprintf(file, "streaming.upload_budget_kb=%d\n\n", config->streaming.upload_budget_kb);
+    
     /* Write debug configuration */
     fprintf(file, "# Debug Configuration\n");
     fprintf(file, "debug.enable_debug_logging=%s\n", config->debug.enable_debug_logging ? "true" : "false");
     fprintf(file, "debug.enable_physics_debug=%s\n", config->debug.enable_physics_debug ? "true" : "false");
     fprintf(file, "debug.enable_profiling=%s\n", config->debug.enable_profiling ? "true" : "false");
+    fprintf(file, "debug.profile_frames=%d\n", config->debug.profile_frames);
+    fprintf(file, "debug.profile_trace_path=%s\n", config->debug.profile_trace_path);
+    fprintf(file, "debug.async_logging=%s\n", config->debug.async_logging ? "true" : "false");
+    fprintf(file, "debug.log_overflow_block=%s\n", config->debug.log_overflow_block ? "true" : "false");
     
     fclose(file);
     return true;
@@ -11,9 +11,30 @@
 #include <SDL3/SDL_init.h>
 #include <unistd.h> /* For putenv */
 
+/* Events taken from the queue at a time */
+#define NEXUS_ENGINE_EVENT_BATCH 64
+
 /* Global engine instance */
 NexusEngine* g_engine = NULL;
 
+/**
+ * Present mode named by the graphics configuration, falling back to enable_vsync
+ */
+static SDL_GPUPresentMode convert_present_mode(const NexusGraphicsConfig* graphics) {
+    if (strcmp(graphics->present_mode, "vsync") == 0) {
+        return SDL_GPU_PRESENTMODE_VSYNC;
+    } else if (strcmp(graphics->present_mode, "mailbox") == 0) {
+        return SDL_GPU_PRESENTMODE_MAILBOX;
+    } else if (strcmp(graphics->present_mode, "immediate") == 0) {
+        return SDL_GPU_PRESENTMODE_IMMEDIATE;
+    }
+
+    if (graphics->present_mode[0] != '\0') {
+        printf("Warning: Unknown present mode '%s', using enable_vsync.\n", graphics->present_mode);
+    }
+    return graphics->enable_vsync ? SDL_GPU_PRESENTMODE_VSYNC : SDL_GPU_PRESENTMODE_MAILBOX;
+}
+
 /**
  * Helper function to convert from NexusGraphicsConfig to NexusRendererConfig
  */
@@ -25,12 +46,85 @@ static NexusRendererConfig convert_graphics_to_renderer_config(const NexusGraphi
         .enable_vsync = graphics->enable_vsync,
         .enable_hdr = graphics->enable_hdr,
         .composition_mode = SDL_GPU_SWAPCHAINCOMPOSITION_SDR,
-        .present_mode = graphics->enable_vsync ? SDL_GPU_PRESENTMODE_VSYNC : SDL_GPU_PRESENTMODE_MAILBOX
+        .present_mode = convert_present_mode(graphics),
+        .frames_in_flight = graphics->frames_in_flight > 0 ? (uint32_t)graphics->frames_in_flight : 0,
+        .enable_depth_prepass = graphics->enable_depth_prepass,
+        .lod_pixel_error = graphics->lod_pixel_error,
+        .lod_hysteresis = graphics->lod_hysteresis,
+        .shadow_atlas_size = graphics->shadow_atlas_size > 0 ? (uint32_t)graphics->shadow_atlas_size : 0,
+        .shadow_cascades = graphics->shadow_cascades > 0 ? (uint32_t)graphics->shadow_cascades : 0,
+        .shadow_distance = graphics->shadow_distance,
+        .shader_cache_path = graphics->shader_cache_path[0] != '\0' ? graphics->shader_cache_path : NULL,
+        .enable_gpu_driven = graphics->enable_gpu_driven,
+        .gpu_cull_shader = graphics->gpu_cull_shader[0] != '\0' ? graphics->gpu_cull_shader : NULL
     };
 
     return renderer_config;
 }
 
+/**
+ * Resolve the configured worker thread count (0 = one per logical core)
+ * The count is shared by the job system and the flecs pipeline
+ */
+static int nexus_engine_get_worker_threads(const NexusThreadingConfig* threading) {
+    int threads = threading->worker_threads;
+    if (threads <= 0) {
+        threads = SDL_GetNumLogicalCPUCores();
+    }
+
+    return threads > 1 ? threads : 1;
+}
+
+/**
+ * flecs task thread running as a job
+ */
+typedef struct {
+    ecs_os_thread_callback_t callback; /* flecs worker entry point */
+    void* param;                   /* flecs worker argument */
+    NexusJobCounter done;          /* Released when the worker returned */
+} NexusEngineTask;
+
+/**
+ * Run a flecs task
+ */
+static void nexus_engine_task_main(void* data) {
+    NexusEngineTask* task = (NexusEngineTask*)data;
+    task->callback(task->param);
+}
+
+/**
+ * Start a flecs task on the job system instead of a thread of its own
+ */
+static ecs_os_thread_t nexus_engine_task_new(ecs_os_thread_callback_t callback, void* param) {
+    NexusEngineTask* task = (NexusEngineTask*)malloc(sizeof(NexusEngineTask));
+    if (task == NULL) {
+        fprintf(stderr, "Failed to allocate memory for ECS task!\n");
+        callback(param);
+        return 0;
+    }
+
+    task->callback = callback;
+    task->param = param;
+    nexus_job_counter_init(&task->done);
+    nexus_jobs_run(g_engine->jobs, nexus_engine_task_main, task, &task->done);
+
+    return (ecs_os_thread_t)(uintptr_t)task;
+}
+
+/**
+ * Wait for a flecs task, running other jobs meanwhile
+ */
+static void* nexus_engine_task_join(ecs_os_thread_t thread) {
+    NexusEngineTask* task = (NexusEngineTask*)(uintptr_t)thread;
+    if (task == NULL) {
+        return NULL;
+    }
+
+    nexus_jobs_wait(g_engine->jobs, &task->done);
+    free(task);
+    return NULL;
+}
+
 /**
  * Initialize the engine
  */
@@ -65,6 +159,10 @@ static NexusRendererConfig convert_graphics_to_renderer_config(const NexusGraphi
      /* Set default configuration */
      nexus_config_set_defaults(g_engine->config);
 
+     /* Size the frame and scratch arenas before any subsystem allocates */
+     const NexusMemoryConfig* memory = &((NexusConfig*)g_engine->config)->memory;
+     nexus_memory_init((size_t)memory->frame_arena_kb * 1024, (size_t)memory->scratch_arena_kb * 1024);
+
      /* Set a dummy display variable - helps with headless environments */
      /* Avoid using environment variables */
 
@@ -78,6 +176,9 @@ static NexusRendererConfig convert_graphics_to_renderer_config(const NexusGraphi
          return false;
      }
 
+     /* Profiler first, so worker threads created below register their names */
+     nexus_profiler_init();
+
      /* Try to initialize video if we're not in a headless environment */
      if (!SDL_InitSubSystem(SDL_INIT_VIDEO)) {
          printf("Warning: SDL video initialization failed: %s\n", SDL_GetError());
@@ -86,6 +187,19 @@ static NexusRendererConfig convert_graphics_to_renderer_config(const NexusGraphi
          printf("SDL video initialized successfully\n");
      }
 
+     /* Engine logger, asynchronous so worker threads don't serialize on stdio */
+     const NexusDebugConfig* debug = &((NexusConfig*)g_engine->config)->debug;
+     g_engine->logger = nexus_logger_create();
+     if (g_engine->logger != NULL) {
+         nexus_logger_set_level(g_engine->logger,
+                                debug->enable_debug_logging ? NEXUS_LOG_LEVEL_DEBUG : NEXUS_LOG_LEVEL_INFO);
+         if (debug->async_logging &&
+             !nexus_logger_enable_async(g_engine->logger, true,
+                                        debug->log_overflow_block ? NEXUS_LOG_OVERFLOW_BLOCK : NEXUS_LOG_OVERFLOW_DROP)) {
+             printf("Warning: Failed to start the log writer thread. Messages are written synchronously.\n");
+         }
+     }
+
      /* Create main window */
      g_engine->window = nexus_window_create(&g_engine->config);
      if (g_engine->window == NULL) {
@@ -97,11 +211,28 @@ static NexusRendererConfig convert_graphics_to_renderer_config(const NexusGraphi
           */
      }
 
+     /* Job system, the creating (main) thread takes part as slot 0 */
+     int worker_threads = nexus_engine_get_worker_threads(&((NexusConfig*)g_engine->config)->threading);
+     g_engine->jobs = nexus_jobs_create(worker_threads - 1);
+     if (g_engine->jobs == NULL) {
+         printf("Warning: Failed to create job system. Parallel work will run on the calling thread.\n");
+     } else {
+         /* Route flecs worker threads onto the job workers so the cores aren't oversubscribed */
+         ecs_os_set_api_defaults();
+         ecs_os_api_t os_api = ecs_os_api;
+         os_api.task_new_ = nexus_engine_task_new;
+         os_api.task_join_ = nexus_engine_task_join;
+         ecs_os_set_api(&os_api);
+     }
+
      /* Initialize ECS */
      g_engine->world = ecs_init();
      if (g_engine->world == NULL) {
          printf("Failed to initialize ECS!\n");
+         nexus_jobs_destroy(g_engine->jobs);
          nexus_window_destroy(g_engine->window);
+         nexus_logger_destroy(g_engine->logger);
+         nexus_profiler_shutdown();
          SDL_Quit();
          nexus_config_destroy(g_engine->config);
          free(g_engine);
@@ -109,9 +240,19 @@ static NexusRendererConfig convert_graphics_to_renderer_config(const NexusGraphi
          return false;
      }
 
+     /* Systems flagged multi_threaded split their tables across the workers,
+      * which are short lived tasks on the job system when there is one */
+     if (worker_threads > 1) {
+         if (g_engine->jobs != NULL) {
+             ecs_set_task_threads(g_engine->world, worker_threads);
+         } else {
+             ecs_set_threads(g_engine->world, worker_threads);
+         }
+     }
+
      /* Initialize renderer - only if we have a window */
      if (g_engine->window != NULL) {
-         NexusRendererConfig renderer_config = convert_graphics_to_renderer_config(&g_engine->config);
+         NexusRendererConfig renderer_config = convert_graphics_to_renderer_config(&((NexusConfig*)g_engine->config)->graphics);
          g_engine->renderer = nexus_renderer_create(g_engine->window, &renderer_config);
          if (g_engine->renderer == NULL) {
              printf("Warning: Failed to create renderer. Visual output will be disabled.\n");
@@ -122,13 +263,29 @@ static NexusRendererConfig convert_graphics_to_renderer_config(const NexusGraphi
          g_engine->renderer = NULL;
      }
 
+     /* Asset streaming decodes on the job system and uploads through the renderer */
+     if (g_engine->renderer != NULL) {
+         const NexusStreamingConfig* streaming = &((NexusConfig*)g_engine->config)->streaming;
+         g_engine->assets = nexus_asset_loader_create(nexus_renderer_get_gpu_device(g_engine->renderer), g_engine->jobs);
+         if (g_engine->assets == NULL) {
+             printf("Warning: Failed to create asset loader. Assets have to be loaded synchronously.\n");
+         } else {
+             nexus_asset_loader_set_limits(g_engine->assets, (uint32_t)streaming->max_in_flight,
+                                           (uint32_t)streaming->upload_budget_kb * 1024);
+         }
+     }
+
      /* Initialize input system */
      g_engine->input = nexus_input_create();
      if (g_engine->input == NULL) {
          printf("Failed to create input system!\n");
+         nexus_asset_loader_destroy(g_engine->assets);
          nexus_renderer_destroy(g_engine->renderer);
          ecs_fini(g_engine->world);
+         nexus_jobs_destroy(g_engine->jobs);
          nexus_window_destroy(g_engine->window);
+         nexus_logger_destroy(g_engine->logger);
+         nexus_profiler_shutdown();
          SDL_Quit();
          nexus_config_destroy(g_engine->config);
          free(g_engine);
@@ -141,9 +298,13 @@ static NexusRendererConfig convert_graphics_to_renderer_config(const NexusGraphi
      if (g_engine->physics == NULL) {
          printf("Failed to create physics system!\n");
          nexus_input_destroy(g_engine->input);
+         nexus_asset_loader_destroy(g_engine->assets);
          nexus_renderer_destroy(g_engine->renderer);
          ecs_fini(g_engine->world);
+         nexus_jobs_destroy(g_engine->jobs);
          nexus_window_destroy(g_engine->window);
+         nexus_logger_destroy(g_engine->logger);
+         nexus_profiler_shutdown();
          SDL_Quit();
          nexus_config_destroy(g_engine->config);
          free(g_engine);
@@ -151,15 +312,21 @@ static NexusRendererConfig convert_graphics_to_renderer_config(const NexusGraphi
          return false;
      }
 
+     nexus_physics_set_job_system(g_engine->physics, g_engine->jobs);
+
      /* Initialize audio system */
-     g_engine->audio = nexus_audio_create(&g_engine->config);
+     g_engine->audio = nexus_audio_create(&((NexusConfig*)g_engine->config)->audio);
      if (g_engine->audio == NULL) {
          printf("Failed to create audio system!\n");
          nexus_physics_destroy(g_engine->physics);
          nexus_input_destroy(g_engine->input);
+         nexus_asset_loader_destroy(g_engine->assets);
          nexus_renderer_destroy(g_engine->renderer);
          ecs_fini(g_engine->world);
+         nexus_jobs_destroy(g_engine->jobs);
          nexus_window_destroy(g_engine->window);
+         nexus_logger_destroy(g_engine->logger);
+         nexus_profiler_shutdown();
          SDL_Quit();
          nexus_config_destroy(g_engine->config);
          free(g_engine);
@@ -167,6 +334,8 @@ static NexusRendererConfig convert_graphics_to_renderer_config(const NexusGraphi
          return false;
      }
 
+     nexus_audio_set_job_system(g_engine->audio, g_engine->jobs);
+
      /* Register ECS components */
      nexus_ecs_register_components(g_engine->world);
 
@@ -178,6 +347,35 @@ static NexusRendererConfig convert_graphics_to_renderer_config(const NexusGraphi
          printf("Successfully registered all ECS components and systems\n");
      }
 
+     /* Frames are extracted into snapshots, rendered on a thread of their own when pipelined */
+     if (g_engine->renderer != NULL) {
+         const NexusThreadingConfig* threading = &((NexusConfig*)g_engine->config)->threading;
+         if (threading->pipelined_rendering) {
+             g_engine->render_thread = nexus_render_thread_create(g_engine->renderer,
+                                                                  (uint32_t)threading->render_snapshots);
+             if (g_engine->render_thread == NULL) {
+                 printf("Warning: Failed to start the render thread. Frames render on the main thread.\n");
+             }
+         }
+         if (g_engine->render_thread == NULL) {
+             g_engine->render_snapshot = nexus_render_snapshot_create(0);
+             if (g_engine->render_snapshot == NULL) {
+                 printf("Warning: Failed to create the render snapshot. Render systems draw directly.\n");
+             }
+         }
+     }
+
+     /* Frames start at graphics.max_fps, or are only measured when it is 0 */
+     g_engine->pacer = nexus_frame_pacer_create((double)((NexusConfig*)g_engine->config)->graphics.max_fps);
+     if (g_engine->pacer == NULL) {
+         printf("Warning: Failed to create the frame pacer. Frames are unpaced.\n");
+     }
+
+     /* Capture a CPU trace from the first frame on (profile builds only) */
+     if (((NexusConfig*)g_engine->config)->debug.enable_profiling) {
+         nexus_profiler_start_capture();
+     }
+
      /* Engine is now running */
      g_engine->running = true;
 
@@ -186,6 +384,21 @@ static NexusRendererConfig convert_graphics_to_renderer_config(const NexusGraphi
      return true;
  }
 
+/**
+ * Stop a running profiler capture and write it to the configured trace file
+ */
+static void nexus_engine_write_profile(void) {
+    if (!nexus_profiler_is_capturing()) {
+        return;
+    }
+
+    nexus_profiler_stop_capture();
+    const NexusDebugConfig* debug = &((NexusConfig*)g_engine->config)->debug;
+    if (!nexus_profiler_write_trace(debug->profile_trace_path)) {
+        printf("Warning: Failed to write the profiler trace.\n");
+    }
+}
+
 /**
  * Shutdown the engine
  */
@@ -199,6 +412,19 @@ void nexus_engine_shutdown(void) {
     /* Stop engine */
     g_engine->running = false;
 
+    /* Write out a capture that was still running */
+    nexus_engine_write_profile();
+
+    /* Stop the render thread first, its frames reference everything below */
+    if (g_engine->render_thread != NULL) {
+        nexus_render_thread_destroy(g_engine->render_thread);
+        g_engine->render_thread = NULL;
+    }
+    if (g_engine->render_snapshot != NULL) {
+        nexus_render_snapshot_destroy(g_engine->render_snapshot);
+        g_engine->render_snapshot = NULL;
+    }
+
     /* Destroy audio system */
     if (g_engine->audio != NULL) {
         nexus_audio_destroy(g_engine->audio);
@@ -217,6 +443,12 @@ void nexus_engine_shutdown(void) {
         g_engine->input = NULL;
     }
 
+    /* Destroy asset loader (its resources live on the renderer's device) */
+    if (g_engine->assets != NULL) {
+        nexus_asset_loader_destroy(g_engine->assets);
+        g_engine->assets = NULL;
+    }
+
     /* Destroy renderer */
     if (g_engine->renderer != NULL) {
         nexus_renderer_destroy(g_engine->renderer);
@@ -229,18 +461,42 @@ void nexus_engine_shutdown(void) {
         g_engine->world = NULL;
     }
 
+    /* Destroy job system (after flecs, whose tasks run on it) */
+    if (g_engine->jobs != NULL) {
+        nexus_jobs_destroy(g_engine->jobs);
+        g_engine->jobs = NULL;
+    }
+
     /* Destroy window */
     if (g_engine->window != NULL) {
         nexus_window_destroy(g_engine->window);
         g_engine->window = NULL;
     }
 
+    /* Destroy logger, writing out what is still queued */
+    if (g_engine->logger != NULL) {
+        nexus_logger_destroy(g_engine->logger);
+        g_engine->logger = NULL;
+    }
+
+    /* Destroy frame pacer */
+    if (g_engine->pacer != NULL) {
+        nexus_frame_pacer_destroy(g_engine->pacer);
+        g_engine->pacer = NULL;
+    }
+
     /* Destroy configuration */
     if (g_engine->config != NULL) {
         nexus_config_destroy(g_engine->config);
         g_engine->config = NULL;
     }
 
+    /* Release frame and scratch arenas */
+    nexus_memory_shutdown();
+
+    /* Release the profiler's thread buffers */
+    nexus_profiler_shutdown();
+
     /* Shutdown SDL */
     SDL_Quit();
 
@@ -260,90 +516,174 @@ void nexus_engine_update(void) {
         return;
     }
 
+    /* Wait for the frame's start, input is polled right after. The delta runs
+     * from the previous frame's start, so it includes everything between frames */
+    if (g_engine->pacer != NULL) {
+        NEXUS_PROFILE_BEGIN("FramePacing");
+        g_engine->delta_time = nexus_frame_pacer_begin_frame(g_engine->pacer);
+        NEXUS_PROFILE_END();
+    }
+
     /* Start frame timing */
-    uint64_t frame_start_time = SDL_GetTicks();
+    uint64_t frame_start_time = SDL_GetPerformanceCounter();
+    NEXUS_PROFILE_BEGIN("Frame");
+
+    /* Frame allocations of two frames ago are released */
+    nexus_memory_begin_frame();
 
     /* Process window events - only if we have a window */
     if (g_engine->window != NULL) {
-        SDL_Event event;
-        while (SDL_PollEvent(&event)) {
-            /* Process input events */
-            nexus_input_process_event(g_engine->input, &event);
-
-            /* Handle quit event */
-            if (event.type == SDL_EVENT_QUIT) {
-                g_engine->running = false;
-                break;
-            }
-
-            /* Handle window events */
-            if (event.type == SDL_EVENT_WINDOW_RESIZED && g_engine->renderer != NULL) {
-                /* Resize renderer */
-                nexus_renderer_resize(g_engine->renderer, event.window.data1, event.window.data2);
+        NEXUS_PROFILE_BEGIN("Events");
+        SDL_Event events[NEXUS_ENGINE_EVENT_BATCH];
+        int event_count = 0;
+        bool quit = false;
+        SDL_PumpEvents();
+        while (!quit && (event_count = SDL_PeepEvents(events, NEXUS_ENGINE_EVENT_BATCH, SDL_GETEVENT,
+                                                      SDL_EVENT_FIRST, SDL_EVENT_LAST)) > 0) {
+            /* Process input events, a batch at a time */
+            nexus_input_process_events(g_engine->input, events, event_count);
+
+            for (int i = 0; i < event_count; i++) {
+                const SDL_Event* event = &events[i];
+
+                /* Handle quit event */
+                if (event->type == SDL_EVENT_QUIT) {
+                    g_engine->running = false;
+                    quit = true;
+                    break;
+                }
+
+                /* Handle window events */
+                if (event->type == SDL_EVENT_WINDOW_RESIZED && g_engine->renderer != NULL) {
+                    if (g_engine->render_thread != NULL) {
+                        /* The render thread follows the swapchain size itself, only the view changes here */
+                        NexusCamera* camera = nexus_renderer_get_camera(g_engine->renderer);
+                        if (camera != NULL && event->window.data2 > 0) {
+                            nexus_camera_set_aspect_ratio(camera, (float)event->window.data1 / (float)event->window.data2);
+                        }
+                    } else {
+                        /* Resize renderer */
+                        nexus_renderer_resize(g_engine->renderer, event->window.data1, event->window.data2);
+                    }
+                }
             }
         }
 
+        NEXUS_PROFILE_END();
+
         /* Check if window should be closed */
         if (nexus_window_should_close(g_engine->window)) {
             g_engine->running = false;
+            NEXUS_PROFILE_END();
             return;
         }
     }
 
-
-
     /* Update input system */
+    NEXUS_PROFILE_BEGIN("Input");
     nexus_input_update(g_engine->input);
-
-    /* Update ECS world - this processes all registered systems */
-    /* Only progress if we have a valid delta time */
-    if (g_engine->delta_time > 0) {
-        /* Temporarily disable ECS progress to avoid crash */
-        /* In a real fix, we would need to fix the ECS systems initialization */
-        printf("Frame time: %.2f ms\n", g_engine->delta_time * 1000.0);
-        // ecs_progress(g_engine->world, g_engine->delta_time * g_engine->time_scale);
-    }
+    NEXUS_PROFILE_END();
 
     /*
      * Note: Most systems are now handled by the ECS, but we still need to manually update
      * these subsystems for functionality that isn't yet integrated into the ECS architecture
      */
+    /* Physics runs its own phase in fixed steps before the frame's systems */
     nexus_physics_update(g_engine->physics, g_engine->delta_time * g_engine->time_scale);
+    NEXUS_PROFILE_BEGIN("Audio");
     nexus_audio_update(g_engine->audio, g_engine->delta_time * g_engine->time_scale);
+    NEXUS_PROFILE_END();
+
+    /* Streamed assets nearest to the camera are uploaded first, the
+     * copies are submitted ahead of the frame's draws */
+    if (g_engine->renderer != NULL) {
+        NEXUS_PROFILE_BEGIN("Assets");
+        NexusCamera* camera = nexus_renderer_get_camera(g_engine->renderer);
+        nexus_asset_loader_update(g_engine->assets, camera != NULL ? camera->position : NULL);
+        NEXUS_PROFILE_END();
+    }
+
+    /* The render systems record the frame into a snapshot while the world progresses */
+    NexusRenderSnapshot* snapshot = g_engine->render_thread != NULL ?
+                                    nexus_render_thread_get_snapshot(g_engine->render_thread) :
+                                    g_engine->render_snapshot;
+    nexus_renderer_begin_snapshot(g_engine->renderer, snapshot, g_engine->frame_count);
+
+    /* Without a snapshot they draw straight into the frame, which has to be open first */
+    bool in_frame = false;
+    if (g_engine->renderer != NULL && g_engine->render_thread == NULL && snapshot == NULL) {
+        NEXUS_PROFILE_BEGIN("RenderBegin");
+        in_frame = nexus_renderer_begin_frame(g_engine->renderer);
+        NEXUS_PROFILE_END();
+    }
+
+    /* Update ECS world once per frame - this processes all registered systems
+     * except the physics phase */
+    if (g_engine->delta_time > 0) {
+        NEXUS_PROFILE_BEGIN("ECS");
+        ecs_progress(g_engine->world, g_engine->delta_time * g_engine->time_scale);
+#ifdef NEXUS_PROFILE
+        nexus_ecs_profile_end_phase();
+#endif
+        NEXUS_PROFILE_END();
+    }
 
     /* Render frame - only if we have a renderer */
     // printf("rendering running...\n");
     if (g_engine->renderer != NULL) {
-        if (nexus_renderer_begin_frame(g_engine->renderer)) {
-            /* Rendering happens here, but is mostly handled by ECS systems */
-
+        snapshot = nexus_renderer_end_snapshot(g_engine->renderer);
+        if (g_engine->render_thread != NULL) {
+            /* Waits only while the render thread is a whole ring of frames behind */
+            NEXUS_PROFILE_BEGIN("RenderWait");
+            nexus_render_thread_submit(g_engine->render_thread);
+            NEXUS_PROFILE_END();
+        } else if (snapshot != NULL) {
+            nexus_renderer_render_snapshot(g_engine->renderer, snapshot);
+        } else if (in_frame) {
+            NEXUS_PROFILE_BEGIN("RenderEnd");
             nexus_renderer_end_frame(g_engine->renderer);
+            NEXUS_PROFILE_END();
         }
     }
 
     /* Update window - only if we have a window */
     if (g_engine->window != NULL) {
+        NEXUS_PROFILE_BEGIN("WindowUpdate");
         nexus_window_update(g_engine->window);
+        NEXUS_PROFILE_END();
     }
 
     /* Update frame counter */
     g_engine->frame_count++;
+    NEXUS_PROFILE_END();
 
-    /* Calculate frame time */
-    uint64_t frame_end_time = SDL_GetTicks();
-    double frame_time_ms = (double)(frame_end_time - frame_start_time);
+    /* A capture limited to a number of frames is written once they ran */
+    const NexusDebugConfig* debug = &((NexusConfig*)g_engine->config)->debug;
+    if (debug->profile_frames > 0 && g_engine->frame_count == (uint64_t)debug->profile_frames) {
+        nexus_engine_write_profile();
+    }
 
-    /* Update delta time for next frame (convert to seconds) */
-    g_engine->delta_time = frame_time_ms / 1000.0;
+    /* Without a pacer only the frame's own work is measured */
+    if (g_engine->pacer == NULL) {
+        uint64_t frame_end_time = SDL_GetPerformanceCounter();
+        double frame_time_ms = (double)(frame_end_time - frame_start_time) * 1000.0 /
+                               (double)SDL_GetPerformanceFrequency();
+        g_engine->delta_time = frame_time_ms / 1000.0;
+        g_engine->avg_frame_time = (g_engine->avg_frame_time * 0.95) + (frame_time_ms * 0.05);
+    } else {
+        g_engine->avg_frame_time = nexus_frame_pacer_get_average_frame_time(g_engine->pacer);
+        g_engine->frame_time_variance = nexus_frame_pacer_get_frame_time_variance(g_engine->pacer);
+    }
 
     /* Update renderer statistics */
     if (g_engine->renderer != NULL) {
-        nexus_renderer_set_frame_time(g_engine->renderer, frame_time_ms);
+        nexus_renderer_set_frame_time(g_engine->renderer, g_engine->delta_time * 1000.0);
     }
 
     /* Calculate and update performance metrics */
-    g_engine->avg_frame_time = (g_engine->avg_frame_time * 0.95) + (frame_time_ms * 0.05);
-    g_engine->fps = 1000.0 / g_engine->avg_frame_time;
+    if (g_engine->avg_frame_time > 0.0) {
+        g_engine->fps = 1000.0 / g_engine->avg_frame_time;
+    }
 }
 
 /**
@@ -415,6 +755,19 @@ ecs_world_t* nexus_engine_get_world(void) {
     return g_engine->world;
 }
 
+/**
+ * Wait until the render thread rendered every submitted frame
+ * Call before destroying meshes or materials that recent frames drew, without
+ * pipelined rendering frames are finished when nexus_engine_update returns
+ */
+void nexus_engine_wait_for_render(void) {
+    if (g_engine == NULL) {
+        return;
+    }
+
+    nexus_render_thread_wait_idle(g_engine->render_thread);
+}
+
 /**
  * Get the renderer
  */
@@ -445,6 +798,26 @@ struct NexusInput* nexus_engine_get_input(void) {
     return g_engine->input;
 }
 
+/**
+ * Get the job system
+ */
+struct NexusJobSystem* nexus_engine_get_jobs(void) {
+    if (g_engine == NULL) {
+        return NULL;
+    }
+    return g_engine->jobs;
+}
+
+/**
+ * Get the asset loader (NULL without a renderer)
+ */
+struct NexusAssetLoader* nexus_engine_get_asset_loader(void) {
+    if (g_engine == NULL) {
+        return NULL;
+    }
+    return g_engine->assets;
+}
+
 /**
  * Get the physics system
  */
@@ -465,6 +838,16 @@ struct NexusAudio* nexus_engine_get_audio(void) {
     return g_engine->audio;
 }
 
+/**
+ * Get the engine logger
+ */
+struct NexusLogger* nexus_engine_get_logger(void) {
+    if (g_engine == NULL) {
+        return NULL;
+    }
+    return g_engine->logger;
+}
+
 /**
  * Get the configuration
  */
@@ -494,3 +877,23 @@ double nexus_engine_get_avg_frame_time(void) {
     }
     return g_engine->avg_frame_time;
 }
+
+/**
+ * Get the frame time variance in ms^2, its square root is the frame time jitter
+ */
+double nexus_engine_get_frame_time_variance(void) {
+    if (g_engine == NULL) {
+        return 0.0;
+    }
+    return g_engine->frame_time_variance;
+}
+
+/**
+ * Set the rate frames start at (0 = unpaced), overriding graphics.max_fps
+ */
+void nexus_engine_set_target_fps(double target_fps) {
+    if (g_engine == NULL) {
+        return;
+    }
+    nexus_frame_pacer_set_target_fps(g_engine->pacer, target_fps);
+}
@@ -0,0 +1,665 @@
+/**
+ * Nexus3D Job System Implementation
+ * Chase-Lev deques on SDL atomics (all of which are sequentially consistent),
+ * a shared FIFO for foreign threads and deferred jobs, per-worker job
+ * freelists, and semaphore sleeps
+ */
+
+#include "nexus3d/core/jobs.h"
+#include "nexus3d/utils/profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Empty polls before an idle worker goes to sleep */
+#define NEXUS_JOBS_SPIN_COUNT 256
+
+/* Sleep timeout, bounds the latency of a missed wake up */
+#define NEXUS_JOBS_SLEEP_MS 2
+
+/* Initial shared queue size */
+#define NEXUS_JOBS_SHARED_CAPACITY 256
+
+/* Job storage per pool chunk */
+#define NEXUS_JOBS_POOL_CHUNK 256
+
+/**
+ * One sub range of a parallel for
+ */
+typedef struct {
+    NexusJobRangeFunc func;        /* Range entry point */
+    void* data;                    /* Range entry point argument */
+    uint32_t first;                /* First index */
+    uint32_t end;                  /* One past the last index */
+} NexusJobRange;
+
+/**
+ * Push a job onto the bottom of a deque (owner only)
+ */
+static bool nexus_jobs_deque_push(NexusJobDeque* deque, NexusJob* job) {
+    uint32_t bottom = SDL_GetAtomicU32(&deque->bottom);
+    uint32_t top = SDL_GetAtomicU32(&deque->top);
+    if (bottom - top >= NEXUS_JOBS_DEQUE_SIZE) {
+        return false;
+    }
+
+    SDL_SetAtomicPointer(&deque->slots[bottom & (NEXUS_JOBS_DEQUE_SIZE - 1)], job);
+    SDL_SetAtomicU32(&deque->bottom, bottom + 1);
+    return true;
+}
+
+/**
+ * Pop a job from the bottom of a deque (owner only)
+ */
+static NexusJob* nexus_jobs_deque_pop(NexusJobDeque* deque) {
+    uint32_t bottom = SDL_GetAtomicU32(&deque->bottom) - 1;
+    SDL_SetAtomicU32(&deque->bottom, bottom);
+    uint32_t top = SDL_GetAtomicU32(&deque->top);
+
+    /* Empty */
+    if ((int32_t)(bottom - top) < 0) {
+        SDL_SetAtomicU32(&deque->bottom, top);
+        return NULL;
+    }
+
+    NexusJob* job = (NexusJob*)SDL_GetAtomicPointer(&deque->slots[bottom & (NEXUS_JOBS_DEQUE_SIZE - 1)]);
+    if (bottom != top) {
+        return job;
+    }
+
+    /* Last job, race the thieves for it */
+    if (!SDL_CompareAndSwapAtomicU32(&deque->top, top, top + 1)) {
+        job = NULL;
+    }
+    SDL_SetAtomicU32(&deque->bottom, top + 1);
+    return job;
+}
+
+/**
+ * Steal a job from the top of a deque (any thread)
+ */
+static NexusJob* nexus_jobs_deque_steal(NexusJobDeque* deque) {
+    uint32_t top = SDL_GetAtomicU32(&deque->top);
+    uint32_t bottom = SDL_GetAtomicU32(&deque->bottom);
+    if ((int32_t)(bottom - top) <= 0) {
+        return NULL;
+    }
+
+    NexusJob* job = (NexusJob*)SDL_GetAtomicPointer(&deque->slots[top & (NEXUS_JOBS_DEQUE_SIZE - 1)]);
+    if (!SDL_CompareAndSwapAtomicU32(&deque->top, top, top + 1)) {
+        return NULL;
+    }
+    return job;
+}
+
+/**
+ * Append a job to the shared queue
+ */
+static bool nexus_jobs_shared_push(NexusJobSystem* jobs, NexusJob* job) {
+    SDL_LockMutex(jobs->shared_lock);
+
+    /* Grow the ring, unwrapping it into the new storage */
+    if (jobs->shared_count == jobs->shared_capacity) {
+        uint32_t capacity = jobs->shared_capacity ? jobs->shared_capacity * 2 : NEXUS_JOBS_SHARED_CAPACITY;
+        NexusJob** shared = (NexusJob**)malloc(sizeof(NexusJob*) * capacity);
+        if (shared == NULL) {
+            SDL_UnlockMutex(jobs->shared_lock);
+            fprintf(stderr, "Failed to grow the shared job queue!\n");
+            return false;
+        }
+
+        for (uint32_t i = 0; i < jobs->shared_count; i++) {
+            shared[i] = jobs->shared[(jobs->shared_head + i) & (jobs->shared_capacity - 1)];
+        }
+        free(jobs->shared);
+        jobs->shared = shared;
+        jobs->shared_head = 0;
+        jobs->shared_capacity = capacity;
+    }
+
+    jobs->shared[(jobs->shared_head + jobs->shared_count) & (jobs->shared_capacity - 1)] = job;
+    jobs->shared_count++;
+    SDL_AddAtomicInt(&jobs->shared_pending, 1);
+
+    SDL_UnlockMutex(jobs->shared_lock);
+    return true;
+}
+
+/**
+ * Take the oldest job of the shared queue
+ */
+static NexusJob* nexus_jobs_shared_pop(NexusJobSystem* jobs) {
+    if (SDL_GetAtomicInt(&jobs->shared_pending) <= 0) {
+        return NULL;
+    }
+
+    NexusJob* job = NULL;
+    SDL_LockMutex(jobs->shared_lock);
+    if (jobs->shared_count > 0) {
+        job = jobs->shared[jobs->shared_head];
+        jobs->shared_head = (jobs->shared_head + 1) & (jobs->shared_capacity - 1);
+        jobs->shared_count--;
+        SDL_AddAtomicInt(&jobs->shared_pending, -1);
+    }
+    SDL_UnlockMutex(jobs->shared_lock);
+    return job;
+}
+
+/**
+ * Get the worker slot of the calling thread (NULL for foreign threads)
+ */
+static NexusJobWorker* nexus_jobs_current_worker(NexusJobSystem* jobs) {
+    return (NexusJobWorker*)SDL_GetTLS(&jobs->worker_tls);
+}
+
+/**
+ * Take a job from the worker's freelist
+ * Foreign threads and empty freelists fall back to the locked pool
+ */
+static NexusJob* nexus_jobs_alloc(NexusJobSystem* jobs, NexusJobWorker* worker) {
+    if (worker == NULL) {
+        return (NexusJob*)nexus_pool_alloc(&jobs->job_pool);
+    }
+
+    /* Pick up a batch the workers that ran our jobs handed back */
+    if (worker->free_jobs == NULL) {
+        SDL_LockSpinlock(&jobs->free_lock);
+        if (jobs->free_batch_count > 0) {
+            worker->free_jobs = jobs->free_batches[--jobs->free_batch_count];
+            worker->free_count = NEXUS_JOBS_FREE_BATCH;
+        }
+        SDL_UnlockSpinlock(&jobs->free_lock);
+    }
+
+    NexusJob* job = worker->free_jobs;
+    if (job == NULL) {
+        return (NexusJob*)nexus_pool_alloc(&jobs->job_pool);
+    }
+
+    worker->free_jobs = job->next;
+    worker->free_count--;
+    return job;
+}
+
+/**
+ * Put a finished job on the worker's freelist
+ * Past two batches the newest batch is handed over to the other workers
+ */
+static void nexus_jobs_free(NexusJobSystem* jobs, NexusJobWorker* worker, NexusJob* job) {
+    if (worker == NULL) {
+        nexus_pool_free(&jobs->job_pool, job);
+        return;
+    }
+
+    job->next = worker->free_jobs;
+    worker->free_jobs = job;
+    if (++worker->free_count < NEXUS_JOBS_FREE_BATCH * 2) {
+        return;
+    }
+
+    /* Cut the batch off the list before anyone else can see it */
+    NexusJob* last = job;
+    for (int i = 1; i < NEXUS_JOBS_FREE_BATCH; i++) {
+        last = last->next;
+    }
+    worker->free_jobs = last->next;
+    worker->free_count -= NEXUS_JOBS_FREE_BATCH;
+    last->next = NULL;
+
+    bool handed = false;
+    SDL_LockSpinlock(&jobs->free_lock);
+    if (jobs->free_batch_count < NEXUS_JOBS_FREE_BATCHES) {
+        jobs->free_batches[jobs->free_batch_count++] = job;
+        handed = true;
+    }
+    SDL_UnlockSpinlock(&jobs->free_lock);
+
+    /* Every batch slot is taken, the jobs go back to the pool */
+    while (!handed && job != NULL) {
+        NexusJob* next = job->next;
+        nexus_pool_free(&jobs->job_pool, job);
+        job = next;
+    }
+}
+
+/**
+ * Find a job: own deque first, then the shared queue, then other workers
+ */
+static NexusJob* nexus_jobs_find(NexusJobSystem* jobs, NexusJobWorker* worker, bool* stolen) {
+    *stolen = false;
+
+    if (worker != NULL) {
+        NexusJob* job = nexus_jobs_deque_pop(&worker->deque);
+        if (job != NULL) {
+            return job;
+        }
+    }
+
+    NexusJob* job = nexus_jobs_shared_pop(jobs);
+    if (job != NULL) {
+        return job;
+    }
+
+    /* Random start so thieves spread over the victims */
+    uint32_t start = 0;
+    if (worker != NULL) {
+        worker->random = worker->random * 1664525u + 1013904223u;
+        start = worker->random >> 16;
+    }
+
+    for (int i = 0; i < jobs->worker_count; i++) {
+        NexusJobWorker* victim = &jobs->workers[(start + (uint32_t)i) % (uint32_t)jobs->worker_count];
+        if (victim == worker) {
+            continue;
+        }
+
+        job = nexus_jobs_deque_steal(&victim->deque);
+        if (job != NULL) {
+            *stolen = true;
+            return job;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Wake one sleeping worker
+ */
+static void nexus_jobs_wake(NexusJobSystem* jobs) {
+    if (SDL_GetAtomicInt(&jobs->sleeping) > 0) {
+        SDL_SignalSemaphore(jobs->wake);
+    }
+}
+
+/**
+ * Run a job on behalf of a worker slot (NULL for foreign threads), jobs whose
+ * dependency is still pending go back to the shared queue
+ * Returns true if the job ran
+ */
+static bool nexus_jobs_execute(NexusJobSystem* jobs, NexusJobWorker* worker, NexusJob* job) {
+    if (job->dependency != NULL && !nexus_job_counter_is_done(job->dependency)) {
+        if (!nexus_jobs_shared_push(jobs, job)) {
+            /* No room to defer, the dependency has to finish here */
+            NexusJobCounter* dependency = job->dependency;
+            job->dependency = NULL;
+            nexus_jobs_wait(jobs, dependency);
+            return nexus_jobs_execute(jobs, worker, job);
+        }
+        SDL_CPUPauseInstruction();
+        return false;
+    }
+
+    job->func(job->data);
+
+    NexusJobCounter* counter = job->counter;
+    nexus_jobs_free(jobs, worker, job);
+    if (counter != NULL) {
+        SDL_AddAtomicInt(&counter->pending, -1);
+    }
+    return true;
+}
+
+/**
+ * Book the time since the last period as busy or idle
+ */
+static void nexus_jobs_account(NexusJobWorker* worker, bool busy) {
+    uint64_t now = SDL_GetTicksNS();
+    uint64_t elapsed = now - worker->last_ns;
+    if (busy) {
+        worker->stats.busy_ns += elapsed;
+    } else {
+        worker->stats.idle_ns += elapsed;
+    }
+    worker->last_ns = now;
+}
+
+/**
+ * Find and run one job on behalf of a worker slot
+ * Returns false if there was nothing to do
+ */
+static bool nexus_jobs_run_one(NexusJobSystem* jobs, NexusJobWorker* worker) {
+    bool stolen;
+    NexusJob* job = nexus_jobs_find(jobs, worker, &stolen);
+    if (job == NULL) {
+        return false;
+    }
+
+    if (worker == NULL) {
+        nexus_jobs_execute(jobs, NULL, job);
+        return true;
+    }
+
+    nexus_jobs_account(worker, false);
+    if (nexus_jobs_execute(jobs, worker, job)) {
+        worker->stats.jobs_executed++;
+        if (stolen) {
+            worker->stats.jobs_stolen++;
+        }
+    }
+    nexus_jobs_account(worker, true);
+    return true;
+}
+
+/**
+ * Worker thread main loop
+ */
+static int nexus_jobs_worker_main(void* data) {
+    NexusJobWorker* worker = (NexusJobWorker*)data;
+    NexusJobSystem* jobs = worker->system;
+
+    SDL_SetTLS(&jobs->worker_tls, worker, NULL);
+    worker->last_ns = SDL_GetTicksNS();
+
+#ifdef NEXUS_PROFILE
+    char name[32];
+    snprintf(name, sizeof(name), "NexusWorker %d", (int)(worker - jobs->workers));
+    NEXUS_PROFILE_THREAD(name);
+#endif
+
+    int spins = 0;
+    while (SDL_GetAtomicInt(&jobs->running)) {
+        if (nexus_jobs_run_one(jobs, worker)) {
+            spins = 0;
+            continue;
+        }
+
+        /* Spin briefly, then sleep until new work is pushed */
+        if (++spins < NEXUS_JOBS_SPIN_COUNT) {
+            SDL_CPUPauseInstruction();
+            continue;
+        }
+
+        SDL_AddAtomicInt(&jobs->sleeping, 1);
+        SDL_WaitSemaphoreTimeout(jobs->wake, NEXUS_JOBS_SLEEP_MS);
+        SDL_AddAtomicInt(&jobs->sleeping, -1);
+        spins = 0;
+    }
+
+    nexus_jobs_account(worker, false);
+    return 0;
+}
+
+/**
+ * Create a job system
+ * thread_count worker threads are started (negative = one per logical core
+ * besides the calling thread, 0 = jobs only run on the calling thread), the
+ * calling thread becomes worker slot 0
+ */
+NexusJobSystem* nexus_jobs_create(int thread_count) {
+    if (thread_count < 0) {
+        thread_count = SDL_GetNumLogicalCPUCores() - 1;
+    }
+    if (thread_count < 0) {
+        thread_count = 0;
+    }
+    if (thread_count > NEXUS_JOBS_MAX_WORKERS - 1) {
+        thread_count = NEXUS_JOBS_MAX_WORKERS - 1;
+    }
+
+    /* Allocate job system structure */
+    NexusJobSystem* jobs = (NexusJobSystem*)malloc(sizeof(NexusJobSystem));
+    if (jobs == NULL) {
+        fprintf(stderr, "Failed to allocate memory for job system!\n");
+        return NULL;
+    }
+    memset(jobs, 0, sizeof(NexusJobSystem));
+
+    NexusPool job_pool = NEXUS_POOL_INIT(NexusJob, NEXUS_JOBS_POOL_CHUNK);
+    jobs->job_pool = job_pool;
+
+    jobs->worker_count = thread_count + 1;
+    jobs->workers = (NexusJobWorker*)calloc((size_t)jobs->worker_count, sizeof(NexusJobWorker));
+    jobs->wake = SDL_CreateSemaphore(0);
+    jobs->shared_lock = SDL_CreateMutex();
+    if (jobs->workers == NULL || jobs->wake == NULL || jobs->shared_lock == NULL) {
+        fprintf(stderr, "Failed to create job system: %s\n", SDL_GetError());
+        if (jobs->wake != NULL) SDL_DestroySemaphore(jobs->wake);
+        if (jobs->shared_lock != NULL) SDL_DestroyMutex(jobs->shared_lock);
+        free(jobs->workers);
+        free(jobs);
+        return NULL;
+    }
+
+    for (int i = 0; i < jobs->worker_count; i++) {
+        jobs->workers[i].system = jobs;
+        jobs->workers[i].index = i;
+        jobs->workers[i].random = 0x9E3779B9u * (uint32_t)(i + 1);
+    }
+
+    /* The creating thread owns slot 0 */
+    SDL_SetAtomicInt(&jobs->running, 1);
+    SDL_SetTLS(&jobs->worker_tls, &jobs->workers[0], NULL);
+    jobs->workers[0].last_ns = SDL_GetTicksNS();
+
+    for (int i = 1; i < jobs->worker_count; i++) {
+        jobs->workers[i].thread = SDL_CreateThread(nexus_jobs_worker_main, "NexusWorker", &jobs->workers[i]);
+        if (jobs->workers[i].thread == NULL) {
+            /* The slot stays empty, nothing is ever pushed to its deque */
+            fprintf(stderr, "Failed to create job worker %d: %s\n", i, SDL_GetError());
+        }
+    }
+
+    printf("Job system created with %d worker thread(s).\n", thread_count);
+
+    return jobs;
+}
+
+/**
+ * Destroy a job system
+ * Jobs still queued are dropped, wait on their counters first
+ */
+void nexus_jobs_destroy(NexusJobSystem* jobs) {
+    if (jobs == NULL) {
+        return;
+    }
+
+    /* Stop and join the workers */
+    SDL_SetAtomicInt(&jobs->running, 0);
+    for (int i = 1; i < jobs->worker_count; i++) {
+        SDL_SignalSemaphore(jobs->wake);
+    }
+    for (int i = 1; i < jobs->worker_count; i++) {
+        if (jobs->workers[i].thread != NULL) {
+            SDL_WaitThread(jobs->workers[i].thread, NULL);
+        }
+    }
+
+    SDL_SetTLS(&jobs->worker_tls, NULL, NULL);
+    SDL_DestroySemaphore(jobs->wake);
+    SDL_DestroyMutex(jobs->shared_lock);
+    nexus_pool_release(&jobs->job_pool);
+    free(jobs->shared);
+    free(jobs->workers);
+    free(jobs);
+}
+
+/**
+ * Queue a job
+ * counter (optional) is incremented now and decremented when the job finished
+ */
+void nexus_jobs_run(NexusJobSystem* jobs, NexusJobFunc func, void* data, NexusJobCounter* counter) {
+    nexus_jobs_run_after(jobs, func, data, NULL, counter);
+}
+
+/**
+ * Queue a job that starts once dependency reached zero
+ * Without a job system the job runs right away on the calling thread
+ */
+void nexus_jobs_run_after(NexusJobSystem* jobs, NexusJobFunc func, void* data,
+                          NexusJobCounter* dependency, NexusJobCounter* counter) {
+    if (func == NULL) {
+        return;
+    }
+
+    if (counter != NULL) {
+        SDL_AddAtomicInt(&counter->pending, 1);
+    }
+
+    NexusJobWorker* worker = jobs != NULL ? nexus_jobs_current_worker(jobs) : NULL;
+    NexusJob* job = jobs != NULL ? nexus_jobs_alloc(jobs, worker) : NULL;
+    if (job == NULL) {
+        /* No scheduler or out of job storage, run inline */
+        if (dependency != NULL) {
+            nexus_jobs_wait(jobs, dependency);
+        }
+        func(data);
+        if (counter != NULL) {
+            SDL_AddAtomicInt(&counter->pending, -1);
+        }
+        return;
+    }
+
+    job->func = func;
+    job->data = data;
+    job->counter = counter;
+    job->dependency = dependency;
+
+    /* Workers push to their own deque, everyone else to the shared queue */
+    bool ready = dependency == NULL || nexus_job_counter_is_done(dependency);
+    bool queued = worker != NULL && ready && nexus_jobs_deque_push(&worker->deque, job);
+    if (!queued) {
+        queued = nexus_jobs_shared_push(jobs, job);
+    }
+
+    if (!queued) {
+        job->dependency = NULL;
+        if (dependency != NULL) {
+            nexus_jobs_wait(jobs, dependency);
+        }
+        nexus_jobs_execute(jobs, worker, job);
+        return;
+    }
+
+    nexus_jobs_wake(jobs);
+}
+
+/**
+ * Wait until a counter reached zero, running other jobs meanwhile
+ */
+void nexus_jobs_wait(NexusJobSystem* jobs, NexusJobCounter* counter) {
+    if (jobs == NULL || counter == NULL) {
+        return;
+    }
+
+    NexusJobWorker* worker = nexus_jobs_current_worker(jobs);
+    if (worker != NULL) {
+        nexus_jobs_account(worker, worker->index != 0);
+    }
+
+    while (SDL_GetAtomicInt(&counter->pending) > 0) {
+        if (!nexus_jobs_run_one(jobs, worker)) {
+            SDL_CPUPauseInstruction();
+        }
+    }
+
+    if (worker != NULL) {
+        nexus_jobs_account(worker, false);
+    }
+}
+
+/**
+ * Run one sub range of a parallel for
+ */
+static void nexus_jobs_range_main(void* data) {
+    NexusJobRange* range = (NexusJobRange*)data;
+    range->func(range->data, range->first, range->end);
+}
+
+/**
+ * Split [0, count) into ranges of at least batch_size and run them in parallel
+ * Returns once every range finished, the caller runs the first range
+ */
+void nexus_jobs_parallel_for(NexusJobSystem* jobs, uint32_t count, uint32_t batch_size,
+                             NexusJobRangeFunc func, void* data) {
+    if (func == NULL || count == 0) {
+        return;
+    }
+
+    if (batch_size == 0) {
+        batch_size = 1;
+    }
+
+    uint32_t range_count = (count + batch_size - 1) / batch_size;
+    if (jobs == NULL || jobs->worker_count <= 1 || range_count <= 1) {
+        func(data, 0, count);
+        return;
+    }
+
+    if (range_count > NEXUS_JOBS_MAX_RANGES) {
+        range_count = NEXUS_JOBS_MAX_RANGES;
+    }
+    uint32_t per_range = (count + range_count - 1) / range_count;
+    range_count = (count + per_range - 1) / per_range;
+
+    NexusJobRange ranges[NEXUS_JOBS_MAX_RANGES];
+    NexusJobCounter counter;
+    nexus_job_counter_init(&counter);
+
+    for (uint32_t r = 0; r < range_count; r++) {
+        ranges[r].func = func;
+        ranges[r].data = data;
+        ranges[r].first = r * per_range;
+        ranges[r].end = SDL_min(count, (r + 1) * per_range);
+    }
+
+    /* Queue back to front so thieves take the far ranges first */
+    for (uint32_t r = range_count - 1; r > 0; r--) {
+        nexus_jobs_run(jobs, nexus_jobs_range_main, &ranges[r], &counter);
+    }
+
+    nexus_jobs_range_main(&ranges[0]);
+    nexus_jobs_wait(jobs, &counter);
+}
+
+/**
+ * Get the number of worker slots (worker threads plus the creating thread)
+ */
+int nexus_jobs_get_worker_count(const NexusJobSystem* jobs) {
+    if (jobs == NULL) {
+        return 1;
+    }
+    return jobs->worker_count;
+}
+
+/**
+ * Get the worker slot of the calling thread (-1 for other threads)
+ */
+int nexus_jobs_get_worker_index(NexusJobSystem* jobs) {
+    if (jobs == NULL) {
+        return -1;
+    }
+
+    NexusJobWorker* worker = nexus_jobs_current_worker(jobs);
+    return worker != NULL ? worker->index : -1;
+}
+
+/**
+ * Get statistics of a worker slot (values are updated by the worker itself)
+ */
+NexusJobWorkerStats nexus_jobs_get_worker_stats(const NexusJobSystem* jobs, int worker) {
+    NexusJobWorkerStats stats;
+    memset(&stats, 0, sizeof(NexusJobWorkerStats));
+
+    if (jobs == NULL || worker < 0 || worker >= jobs->worker_count) {
+        return stats;
+    }
+
+    return jobs->workers[worker].stats;
+}
+
+/**
+ * Reset a counter
+ */
+void nexus_job_counter_init(NexusJobCounter* counter) {
+    if (counter != NULL) {
+        SDL_SetAtomicInt(&counter->pending, 0);
+    }
+}
+
+/**
+ * Check whether all jobs of a counter finished
+ */
+bool nexus_job_counter_is_done(NexusJobCounter* counter) {
+    return counter == NULL || SDL_GetAtomicInt(&counter->pending) <= 0;
+}
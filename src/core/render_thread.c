@@ -0,0 +1,205 @@
+/**
+ * Nexus3D Render Thread Implementation
+ * Snapshot ring between the simulation and the render thread
+ */
+
+#include "nexus3d/core/render_thread.h"
+#include "nexus3d/renderer/renderer.h"
+#include "nexus3d/utils/profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Render thread main loop
+ * Renders the submitted snapshots in order, handing each back once its frame was recorded
+ */
+static int nexus_render_thread_main(void* data) {
+    NexusRenderThread* render_thread = (NexusRenderThread*)data;
+
+    NEXUS_PROFILE_THREAD("NexusRender");
+
+    for (;;) {
+        SDL_WaitSemaphore(render_thread->ready);
+        if (!SDL_GetAtomicInt(&render_thread->running)) {
+            break;
+        }
+
+        NexusRenderSnapshot* snapshot = render_thread->snapshots[render_thread->read_index];
+        render_thread->read_index = (render_thread->read_index + 1) % render_thread->snapshot_count;
+
+        NEXUS_PROFILE_BEGIN("RenderFrame");
+        if (nexus_renderer_render_snapshot(render_thread->renderer, snapshot)) {
+            SDL_AddAtomicInt(&render_thread->frames_rendered, 1);
+        } else {
+            SDL_AddAtomicInt(&render_thread->frames_skipped, 1);
+        }
+        NEXUS_PROFILE_END();
+
+        SDL_SignalSemaphore(render_thread->free);
+    }
+
+    return 0;
+}
+
+/**
+ * Create a render thread
+ * snapshot_count snapshots rotate (clamped to 2..NEXUS_RENDER_SNAPSHOT_MAX_COUNT),
+ * the main thread runs at most snapshot_count - 1 frames ahead of the GPU submission
+ */
+NexusRenderThread* nexus_render_thread_create(struct NexusRenderer* renderer, uint32_t snapshot_count) {
+    if (renderer == NULL) {
+        return NULL;
+    }
+    if (snapshot_count < 2) {
+        snapshot_count = 2;
+    }
+    if (snapshot_count > NEXUS_RENDER_SNAPSHOT_MAX_COUNT) {
+        snapshot_count = NEXUS_RENDER_SNAPSHOT_MAX_COUNT;
+    }
+
+    /* Allocate render thread structure */
+    NexusRenderThread* render_thread = (NexusRenderThread*)malloc(sizeof(NexusRenderThread));
+    if (render_thread == NULL) {
+        fprintf(stderr, "Failed to allocate memory for render thread!\n");
+        return NULL;
+    }
+
+    /* Initialize render thread structure */
+    memset(render_thread, 0, sizeof(NexusRenderThread));
+    render_thread->renderer = renderer;
+    render_thread->snapshot_count = snapshot_count;
+
+    bool created = true;
+    for (uint32_t i = 0; i < snapshot_count; i++) {
+        render_thread->snapshots[i] = nexus_render_snapshot_create(0);
+        created = created && render_thread->snapshots[i] != NULL;
+    }
+
+    /* The snapshot being extracted is never free */
+    render_thread->ready = SDL_CreateSemaphore(0);
+    render_thread->free = SDL_CreateSemaphore(snapshot_count - 1);
+    if (!created || render_thread->ready == NULL || render_thread->free == NULL) {
+        fprintf(stderr, "Failed to create render thread: %s\n", SDL_GetError());
+        nexus_render_thread_destroy(render_thread);
+        return NULL;
+    }
+
+    SDL_SetAtomicInt(&render_thread->running, 1);
+    render_thread->thread = SDL_CreateThread(nexus_render_thread_main, "NexusRender", render_thread);
+    if (render_thread->thread == NULL) {
+        fprintf(stderr, "Failed to start render thread: %s\n", SDL_GetError());
+        nexus_render_thread_destroy(render_thread);
+        return NULL;
+    }
+
+    printf("Render thread started with %u snapshot(s).\n", snapshot_count);
+
+    return render_thread;
+}
+
+/**
+ * Destroy a render thread
+ * The snapshots already submitted are rendered first
+ */
+void nexus_render_thread_destroy(NexusRenderThread* render_thread) {
+    if (render_thread == NULL) {
+        return;
+    }
+
+    /* Drain, then stop and join the thread */
+    if (render_thread->thread != NULL) {
+        nexus_render_thread_wait_idle(render_thread);
+        SDL_SetAtomicInt(&render_thread->running, 0);
+        SDL_SignalSemaphore(render_thread->ready);
+        SDL_WaitThread(render_thread->thread, NULL);
+    }
+
+    for (uint32_t i = 0; i < render_thread->snapshot_count; i++) {
+        nexus_render_snapshot_destroy(render_thread->snapshots[i]);
+    }
+    if (render_thread->ready != NULL) SDL_DestroySemaphore(render_thread->ready);
+    if (render_thread->free != NULL) SDL_DestroySemaphore(render_thread->free);
+    free(render_thread);
+}
+
+/**
+ * Get the snapshot the main thread extracts the current frame into
+ */
+NexusRenderSnapshot* nexus_render_thread_get_snapshot(const NexusRenderThread* render_thread) {
+    if (render_thread == NULL) {
+        return NULL;
+    }
+
+    return render_thread->snapshots[render_thread->write_index];
+}
+
+/**
+ * Hand the extracted snapshot to the render thread and move on to the next one
+ * Blocks while every other snapshot still waits to be rendered
+ */
+void nexus_render_thread_submit(NexusRenderThread* render_thread) {
+    if (render_thread == NULL) {
+        return;
+    }
+
+    SDL_SignalSemaphore(render_thread->ready);
+
+    uint64_t wait_start = SDL_GetPerformanceCounter();
+    SDL_WaitSemaphore(render_thread->free);
+    render_thread->wait_time = (double)(SDL_GetPerformanceCounter() - wait_start) * 1000.0 /
+                               (double)SDL_GetPerformanceFrequency();
+
+    render_thread->write_index = (render_thread->write_index + 1) % render_thread->snapshot_count;
+}
+
+/**
+ * Wait until every submitted snapshot was rendered
+ * Resources referenced by earlier frames can be released afterwards
+ */
+void nexus_render_thread_wait_idle(NexusRenderThread* render_thread) {
+    if (render_thread == NULL || render_thread->thread == NULL) {
+        return;
+    }
+
+    /* All free snapshots taken means nothing is left in flight, give them back */
+    for (uint32_t i = 0; i + 1 < render_thread->snapshot_count; i++) {
+        SDL_WaitSemaphore(render_thread->free);
+    }
+    for (uint32_t i = 0; i + 1 < render_thread->snapshot_count; i++) {
+        SDL_SignalSemaphore(render_thread->free);
+    }
+}
+
+/**
+ * Get the number of snapshots rendered into a swapchain image
+ */
+uint32_t nexus_render_thread_get_frames_rendered(const NexusRenderThread* render_thread) {
+    if (render_thread == NULL) {
+        return 0;
+    }
+
+    return (uint32_t)SDL_GetAtomicInt((SDL_AtomicInt*)&render_thread->frames_rendered);
+}
+
+/**
+ * Get the number of snapshots dropped because no frame could be rendered
+ */
+uint32_t nexus_render_thread_get_frames_skipped(const NexusRenderThread* render_thread) {
+    if (render_thread == NULL) {
+        return 0;
+    }
+
+    return (uint32_t)SDL_GetAtomicInt((SDL_AtomicInt*)&render_thread->frames_skipped);
+}
+
+/**
+ * Get the time (ms) the last submit waited for the render thread
+ */
+double nexus_render_thread_get_wait_time(const NexusRenderThread* render_thread) {
+    if (render_thread == NULL) {
+        return 0.0;
+    }
+
+    return render_thread->wait_time;
+}
@@ -196,3 +196,142 @@ bool nexus_time_should_update_fixed(NexusTime* time) {
     
     return false;
 }
+
+/**
+ * Create a frame pacer
+ * target_fps frames start per second (0 = unpaced, frames are only measured)
+ */
+NexusFramePacer* nexus_frame_pacer_create(double target_fps) {
+    /* Allocate frame pacer structure */
+    NexusFramePacer* pacer = (NexusFramePacer*)malloc(sizeof(NexusFramePacer));
+    if (pacer == NULL) {
+        printf("Failed to allocate memory for frame pacer!\n");
+        return NULL;
+    }
+
+    /* Initialize frame pacer structure */
+    memset(pacer, 0, sizeof(NexusFramePacer));
+    pacer->frequency = SDL_GetPerformanceFrequency();
+    pacer->spin_ticks = pacer->frequency * NEXUS_FRAME_PACER_SPIN_NS / 1000000000ULL;
+    nexus_frame_pacer_set_target_fps(pacer, target_fps);
+
+    return pacer;
+}
+
+/**
+ * Destroy a frame pacer
+ */
+void nexus_frame_pacer_destroy(NexusFramePacer* pacer) {
+    if (pacer == NULL) {
+        return;
+    }
+
+    free(pacer);
+}
+
+/**
+ * Set the rate frames start at (0 = unpaced)
+ */
+void nexus_frame_pacer_set_target_fps(NexusFramePacer* pacer, double target_fps) {
+    if (pacer == NULL) {
+        return;
+    }
+
+    pacer->target_ticks = target_fps > 0.0 ? (uint64_t)((double)pacer->frequency / target_fps) : 0;
+}
+
+/**
+ * Wait for the start of the next frame and start it
+ * Waiting before the frame rather than after it lets the frame poll input as
+ * late as possible
+ * @return Start to start time of the previous frame in seconds (0 for the first frame)
+ */
+double nexus_frame_pacer_begin_frame(NexusFramePacer* pacer) {
+    if (pacer == NULL) {
+        return 0.0;
+    }
+
+    uint64_t now = SDL_GetPerformanceCounter();
+    uint64_t wait_start = now;
+
+    if (pacer->target_ticks > 0 && pacer->frame_count > 0) {
+        /* Sleep through most of the wait, then spin out the rest */
+        if (pacer->deadline > now + pacer->spin_ticks) {
+            uint64_t sleep_ticks = pacer->deadline - now - pacer->spin_ticks;
+            SDL_DelayNS(sleep_ticks * 1000000000ULL / pacer->frequency);
+        }
+        while ((now = SDL_GetPerformanceCounter()) < pacer->deadline) {
+            SDL_CPUPauseInstruction();
+        }
+    }
+    pacer->wait_time = (double)(now - wait_start) * 1000.0 / (double)pacer->frequency;
+
+    /* Deadlines advance by whole frames, a frame more than one frame late restarts the schedule */
+    if (pacer->target_ticks > 0) {
+        pacer->deadline += pacer->target_ticks;
+        if (pacer->deadline + pacer->target_ticks < now || pacer->frame_count == 0) {
+            pacer->deadline = now + pacer->target_ticks;
+        }
+    }
+
+    pacer->delta_time = pacer->frame_count > 0 ?
+                        (double)(now - pacer->frame_start) / (double)pacer->frequency : 0.0;
+    pacer->frame_start = now;
+    pacer->frame_count++;
+
+    /* Exponentially weighted mean and variance of the frame time */
+    if (pacer->frame_count == 2) {
+        pacer->average_frame_time = pacer->delta_time * 1000.0;
+    } else if (pacer->frame_count > 2) {
+        const double alpha = 0.05; /* Smoothing factor */
+        double diff = pacer->delta_time * 1000.0 - pacer->average_frame_time;
+        pacer->average_frame_time += alpha * diff;
+        pacer->frame_time_variance = (1.0 - alpha) * (pacer->frame_time_variance + alpha * diff * diff);
+    }
+
+    return pacer->delta_time;
+}
+
+/**
+ * Get the start to start time of the last frame in seconds
+ */
+double nexus_frame_pacer_get_delta_time(const NexusFramePacer* pacer) {
+    if (pacer == NULL) {
+        return 0.0;
+    }
+
+    return pacer->delta_time;
+}
+
+/**
+ * Get the time (ms) the current frame waited for its start
+ */
+double nexus_frame_pacer_get_wait_time(const NexusFramePacer* pacer) {
+    if (pacer == NULL) {
+        return 0.0;
+    }
+
+    return pacer->wait_time;
+}
+
+/**
+ * Get the smoothed frame time in milliseconds
+ */
+double nexus_frame_pacer_get_average_frame_time(const NexusFramePacer* pacer) {
+    if (pacer == NULL) {
+        return 0.0;
+    }
+
+    return pacer->average_frame_time;
+}
+
+/**
+ * Get the smoothed frame time variance in ms^2, its square root is the frame time jitter
+ */
+double nexus_frame_pacer_get_frame_time_variance(const NexusFramePacer* pacer) {
+    if (pacer == NULL) {
+        return 0.0;
+    }
+
+    return pacer->frame_time_variance;
+}
@@ -14,11 +14,15 @@ ECS_COMPONENT_DECLARE(NexusRotationComponent);
 ECS_COMPONENT_DECLARE(NexusScaleComponent);
 ECS_COMPONENT_DECLARE(NexusTransformComponent);
 ECS_COMPONENT_DECLARE(NexusRenderableComponent);
+ECS_COMPONENT_DECLARE(NexusBoundsComponent);
 ECS_COMPONENT_DECLARE(NexusCameraComponent);
 ECS_COMPONENT_DECLARE(NexusLightComponent);
 ECS_COMPONENT_DECLARE(NexusVelocityComponent);
 ECS_COMPONENT_DECLARE(NexusRigidBodyComponent);
+ECS_COMPONENT_DECLARE(NexusInterpolationComponent);
 ECS_COMPONENT_DECLARE(NexusAudioSourceComponent);
+ECS_COMPONENT_DECLARE(NexusStaticTag);
+ECS_COMPONENT_DECLARE(NexusGpuDrivenTag);
 
 /* Component registration function */
 void nexus_ecs_register_components(ecs_world_t* world) {
@@ -33,14 +37,20 @@ void nexus_ecs_register_components(ecs_world_t* world) {
     ECS_COMPONENT_DEFINE(world, NexusScaleComponent);
     ECS_COMPONENT_DEFINE(world, NexusTransformComponent);
     ECS_COMPONENT_DEFINE(world, NexusRenderableComponent);
+    ECS_COMPONENT_DEFINE(world, NexusBoundsComponent);
     ECS_COMPONENT_DEFINE(world, NexusCameraComponent);
     ECS_COMPONENT_DEFINE(world, NexusLightComponent);
     ECS_COMPONENT_DEFINE(world, NexusVelocityComponent);
     ECS_COMPONENT_DEFINE(world, NexusRigidBodyComponent);
+    ECS_COMPONENT_DEFINE(world, NexusInterpolationComponent);
     ECS_COMPONENT_DEFINE(world, NexusAudioSourceComponent);
 
+    /* Renderables always carry a world bounds cache for culling */
+    ecs_add_pair(world, ecs_id(NexusRenderableComponent), EcsWith, ecs_id(NexusBoundsComponent));
+
     /* Register tags */
-    // ECS_TAG_DEFINE(world, NexusStaticTag);
+    ECS_COMPONENT_DEFINE(world, NexusStaticTag);
+    ECS_COMPONENT_DEFINE(world, NexusGpuDrivenTag);
     // ECS_TAG_DEFINE(world, NexusDynamicTag);
     // ECS_TAG_DEFINE(world, NexusMainCameraTag);
 
@@ -0,0 +1,827 @@
+/**
+ * Nexus3D Scene File Implementation
+ * Column snapshots of the scene tables, bulk instantiation and quick save
+ */
+
+#include "nexus3d/ecs/scene_file.h"
+#include "nexus3d/ecs/components.h"
+#include "nexus3d/utils/mapped_file.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Initial number of registry entries */
+#define NEXUS_SCENE_ASSETS_INITIAL_CAPACITY 64
+
+/* Initial snapshot image size */
+#define NEXUS_SCENE_SNAPSHOT_INITIAL_CAPACITY (64u * 1024u)
+
+/* Initial number of table records of a capture */
+#define NEXUS_SCENE_INITIAL_TABLES 32
+
+/**
+ * Round an offset up to the section alignment
+ */
+static uint32_t nexus_scene_align(uint32_t offset) {
+    return (offset + NEXUS_SCENE_FILE_ALIGNMENT - 1) & ~(NEXUS_SCENE_FILE_ALIGNMENT - 1);
+}
+
+/**
+ * Component of a column
+ */
+static ecs_id_t nexus_scene_column_id(NexusSceneColumn column) {
+    switch (column) {
+        case NEXUS_SCENE_COLUMN_POSITION: return ecs_id(NexusPositionComponent);
+        case NEXUS_SCENE_COLUMN_ROTATION: return ecs_id(NexusRotationComponent);
+        case NEXUS_SCENE_COLUMN_SCALE: return ecs_id(NexusScaleComponent);
+        case NEXUS_SCENE_COLUMN_TRANSFORM: return ecs_id(NexusTransformComponent);
+        case NEXUS_SCENE_COLUMN_RENDERABLE: return ecs_id(NexusRenderableComponent);
+        case NEXUS_SCENE_COLUMN_RIGIDBODY: return ecs_id(NexusRigidBodyComponent);
+        case NEXUS_SCENE_COLUMN_LIGHT: return ecs_id(NexusLightComponent);
+        default: return 0;
+    }
+}
+
+/**
+ * Bytes per element of a column in the file
+ */
+static uint32_t nexus_scene_column_size(NexusSceneColumn column) {
+    switch (column) {
+        case NEXUS_SCENE_COLUMN_POSITION: return sizeof(NexusPositionComponent);
+        case NEXUS_SCENE_COLUMN_ROTATION: return sizeof(NexusRotationComponent);
+        case NEXUS_SCENE_COLUMN_SCALE: return sizeof(NexusScaleComponent);
+        case NEXUS_SCENE_COLUMN_TRANSFORM: return sizeof(NexusTransformComponent);
+        case NEXUS_SCENE_COLUMN_RENDERABLE: return sizeof(NexusSceneRenderable);
+        case NEXUS_SCENE_COLUMN_RIGIDBODY: return sizeof(NexusRigidBodyComponent);
+        case NEXUS_SCENE_COLUMN_LIGHT: return sizeof(NexusLightComponent);
+        default: return 0;
+    }
+}
+
+/**
+ * Hash bytes (FNV-1a, never 0 so 0 can mean unknown)
+ */
+uint64_t nexus_scene_hash_data(const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash != 0 ? hash : 1;
+}
+
+/**
+ * Hash the contents of a file (0 = could not be read)
+ */
+uint64_t nexus_scene_hash_file(const char* filename) {
+    NexusMappedFile file;
+    if (filename == NULL || !nexus_mapped_file_open(&file, filename)) {
+        return 0;
+    }
+
+    uint64_t hash = nexus_scene_hash_data(file.data, file.size);
+    nexus_mapped_file_close(&file);
+    return hash;
+}
+
+/**
+ * Lookup key of a hash and type
+ */
+static uint64_t nexus_scene_assets_hash_key(NexusSceneAssetType type, uint64_t hash) {
+    return hash ^ ((uint64_t)type * 0x9E3779B97F4A7C15ull);
+}
+
+/**
+ * Lookup key of an asset pointer
+ */
+static uint64_t nexus_scene_assets_pointer_key(const void* asset) {
+    return ((uint64_t)(uintptr_t)asset * 0x9E3779B97F4A7C15ull) >> 16;
+}
+
+/**
+ * Put an entry into a lookup table
+ */
+static void nexus_scene_assets_insert(uint32_t* table, uint32_t capacity, uint64_t key, uint32_t entry) {
+    uint32_t mask = capacity - 1;
+    uint32_t slot = (uint32_t)key & mask;
+    while (table[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    table[slot] = entry + 1;
+}
+
+/**
+ * Rebuild both lookup tables with a new slot count
+ */
+static bool nexus_scene_assets_rehash(NexusSceneAssets* assets, uint32_t capacity) {
+    uint32_t* by_hash = (uint32_t*)calloc(capacity, sizeof(uint32_t));
+    uint32_t* by_pointer = (uint32_t*)calloc(capacity, sizeof(uint32_t));
+    if (by_hash == NULL || by_pointer == NULL) {
+        free(by_hash);
+        free(by_pointer);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < assets->count; i++) {
+        const NexusSceneAsset* entry = &assets->entries[i];
+        nexus_scene_assets_insert(by_hash, capacity, nexus_scene_assets_hash_key(entry->type, entry->hash), i);
+        nexus_scene_assets_insert(by_pointer, capacity, nexus_scene_assets_pointer_key(entry->asset), i);
+    }
+
+    free(assets->by_hash);
+    free(assets->by_pointer);
+    assets->by_hash = by_hash;
+    assets->by_pointer = by_pointer;
+    assets->table_capacity = capacity;
+    return true;
+}
+
+/**
+ * Find the registry entry of an asset pointer (UINT32_MAX = not registered)
+ */
+static uint32_t nexus_scene_assets_find_pointer(const NexusSceneAssets* assets, NexusSceneAssetType type,
+                                                const void* asset) {
+    if (assets == NULL || assets->count == 0) {
+        return UINT32_MAX;
+    }
+
+    uint32_t mask = assets->table_capacity - 1;
+    uint32_t slot = (uint32_t)nexus_scene_assets_pointer_key(asset) & mask;
+    while (assets->by_pointer[slot] != 0) {
+        uint32_t index = assets->by_pointer[slot] - 1;
+        if (assets->entries[index].asset == asset && assets->entries[index].type == type) {
+            return index;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return UINT32_MAX;
+}
+
+/**
+ * Create an asset registry
+ */
+NexusSceneAssets* nexus_scene_assets_create(void) {
+    /* Allocate registry structure */
+    NexusSceneAssets* assets = (NexusSceneAssets*)malloc(sizeof(NexusSceneAssets));
+    if (assets == NULL) {
+        fprintf(stderr, "Failed to allocate memory for scene asset registry!\n");
+        return NULL;
+    }
+
+    /* Initialize registry structure */
+    memset(assets, 0, sizeof(NexusSceneAssets));
+    assets->capacity = NEXUS_SCENE_ASSETS_INITIAL_CAPACITY;
+    assets->entries = (NexusSceneAsset*)malloc(sizeof(NexusSceneAsset) * assets->capacity);
+    if (assets->entries == NULL || !nexus_scene_assets_rehash(assets, assets->capacity * 2)) {
+        fprintf(stderr, "Failed to allocate memory for scene asset registry!\n");
+        nexus_scene_assets_destroy(assets);
+        return NULL;
+    }
+
+    return assets;
+}
+
+/**
+ * Destroy an asset registry, the assets themselves stay alive
+ */
+void nexus_scene_assets_destroy(NexusSceneAssets* assets) {
+    if (assets == NULL) {
+        return;
+    }
+
+    free(assets->entries);
+    free(assets->by_hash);
+    free(assets->by_pointer);
+    free(assets);
+}
+
+/**
+ * Register a loaded asset under its content hash (e.g. nexus_scene_hash_file of its source)
+ * Several assets may share a hash, loading resolves it to the first one
+ */
+bool nexus_scene_assets_add(NexusSceneAssets* assets, NexusSceneAssetType type, uint64_t hash, void* asset) {
+    if (assets == NULL || asset == NULL || hash == 0) {
+        return false;
+    }
+
+    uint32_t existing = nexus_scene_assets_find_pointer(assets, type, asset);
+    if (existing != UINT32_MAX) {
+        return assets->entries[existing].hash == hash;
+    }
+
+    /* Keep the lookup tables at most half full */
+    if (assets->count == assets->capacity) {
+        uint32_t capacity = assets->capacity * 2;
+        NexusSceneAsset* entries = (NexusSceneAsset*)realloc(assets->entries, sizeof(NexusSceneAsset) * capacity);
+        if (entries == NULL) {
+            fprintf(stderr, "Failed to grow scene asset registry!\n");
+            return false;
+        }
+        assets->entries = entries;
+        assets->capacity = capacity;
+    }
+    if ((assets->count + 1) * 2 > assets->table_capacity &&
+        !nexus_scene_assets_rehash(assets, assets->table_capacity * 2)) {
+        fprintf(stderr, "Failed to grow scene asset registry!\n");
+        return false;
+    }
+
+    uint32_t index = assets->count++;
+    assets->entries[index].hash = hash;
+    assets->entries[index].type = type;
+    assets->entries[index].asset = asset;
+    nexus_scene_assets_insert(assets->by_hash, assets->table_capacity, nexus_scene_assets_hash_key(type, hash), index);
+    nexus_scene_assets_insert(assets->by_pointer, assets->table_capacity, nexus_scene_assets_pointer_key(asset), index);
+    return true;
+}
+
+/**
+ * Find the asset registered under a content hash (NULL = not registered)
+ */
+void* nexus_scene_assets_find(const NexusSceneAssets* assets, NexusSceneAssetType type, uint64_t hash) {
+    if (assets == NULL || assets->count == 0) {
+        return NULL;
+    }
+
+    uint32_t mask = assets->table_capacity - 1;
+    uint32_t slot = (uint32_t)nexus_scene_assets_hash_key(type, hash) & mask;
+    while (assets->by_hash[slot] != 0) {
+        const NexusSceneAsset* entry = &assets->entries[assets->by_hash[slot] - 1];
+        if (entry->hash == hash && entry->type == type) {
+            return entry->asset;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return NULL;
+}
+
+/**
+ * Append a section to the snapshot image at the next aligned offset
+ * data NULL leaves the section for the caller to fill
+ * @return Offset of the section (0 = out of memory, the header occupies offset 0)
+ */
+static uint32_t nexus_scene_snapshot_append(NexusSceneSnapshot* snapshot, const void* data, uint32_t size) {
+    uint32_t offset = nexus_scene_align(snapshot->size);
+    uint64_t end = (uint64_t)offset + size;
+    if (end > UINT32_MAX) {
+        return 0;
+    }
+
+    if (end > snapshot->capacity) {
+        uint64_t capacity = snapshot->capacity ? snapshot->capacity : NEXUS_SCENE_SNAPSHOT_INITIAL_CAPACITY;
+        while (capacity < end) {
+            capacity *= 2;
+        }
+        if (capacity > UINT32_MAX) {
+            capacity = UINT32_MAX;
+        }
+
+        uint8_t* grown = (uint8_t*)realloc(snapshot->data, (size_t)capacity);
+        if (grown == NULL) {
+            return 0;
+        }
+        snapshot->data = grown;
+        snapshot->capacity = (uint32_t)capacity;
+    }
+
+    /* Padding is zero, so identical scenes give identical files */
+    memset(snapshot->data + snapshot->size, 0, offset - snapshot->size);
+    if (data != NULL && size > 0) {
+        memcpy(snapshot->data + offset, data, size);
+    }
+    snapshot->size = (uint32_t)end;
+    return offset;
+}
+
+/**
+ * Asset table index of a renderable's mesh or material, adding it on first use
+ */
+static uint32_t nexus_scene_capture_asset(const NexusSceneAssets* assets, NexusSceneAssetType type, const void* asset,
+                                          uint32_t* entry_refs, NexusSceneAssetRef** refs, uint32_t* ref_count,
+                                          uint32_t* missing) {
+    if (asset == NULL) {
+        return NEXUS_SCENE_ASSET_NONE;
+    }
+
+    uint32_t entry = nexus_scene_assets_find_pointer(assets, type, asset);
+    if (entry == UINT32_MAX) {
+        (*missing)++;
+        return NEXUS_SCENE_ASSET_NONE;
+    }
+
+    if (entry_refs[entry] == NEXUS_SCENE_ASSET_NONE) {
+        /* Registered assets bound the table size, it was allocated for all of them */
+        NexusSceneAssetRef* ref = &(*refs)[*ref_count];
+        ref->hash = assets->entries[entry].hash;
+        ref->type = (uint32_t)type;
+        ref->reserved = 0;
+        entry_refs[entry] = (*ref_count)++;
+    }
+    return entry_refs[entry];
+}
+
+/**
+ * Copy the scene tables into a snapshot
+ * Entities with any of the column components are captured, other components
+ * and the hierarchy are not part of the snapshot. Call it outside ecs_progress
+ */
+NexusSceneSnapshot* nexus_scene_snapshot_capture(ecs_world_t* world, const NexusSceneAssets* assets) {
+    if (world == NULL) {
+        return NULL;
+    }
+
+    /* Allocate snapshot structure */
+    NexusSceneSnapshot* snapshot = (NexusSceneSnapshot*)malloc(sizeof(NexusSceneSnapshot));
+    if (snapshot == NULL) {
+        fprintf(stderr, "Failed to allocate memory for scene snapshot!\n");
+        return NULL;
+    }
+
+    /* Initialize snapshot structure, the header is written last */
+    memset(snapshot, 0, sizeof(NexusSceneSnapshot));
+    NexusSceneFileHeader header;
+    memset(&header, 0, sizeof(NexusSceneFileHeader));
+    nexus_scene_snapshot_append(snapshot, &header, sizeof(NexusSceneFileHeader));
+    bool success = snapshot->data != NULL;
+
+    uint32_t asset_capacity = assets != NULL ? assets->count : 0;
+    uint32_t* entry_refs = (uint32_t*)malloc(sizeof(uint32_t) * (asset_capacity + 1));
+    NexusSceneAssetRef* refs = (NexusSceneAssetRef*)malloc(sizeof(NexusSceneAssetRef) * (asset_capacity + 1));
+    uint32_t ref_count = 0;
+    uint32_t table_capacity = NEXUS_SCENE_INITIAL_TABLES;
+    NexusSceneFileTable* tables = (NexusSceneFileTable*)malloc(sizeof(NexusSceneFileTable) * table_capacity);
+    success = success && entry_refs != NULL && refs != NULL && tables != NULL;
+    for (uint32_t i = 0; success && i < asset_capacity; i++) {
+        entry_refs[i] = NEXUS_SCENE_ASSET_NONE;
+    }
+
+    /* Tables with any of the columns */
+    ecs_query_desc_t desc;
+    memset(&desc, 0, sizeof(ecs_query_desc_t));
+    for (int c = 0; c < NEXUS_SCENE_COLUMN_COUNT; c++) {
+        desc.terms[c].id = nexus_scene_column_id((NexusSceneColumn)c);
+        desc.terms[c].oper = c + 1 < NEXUS_SCENE_COLUMN_COUNT ? EcsOr : EcsAnd;
+    }
+    ecs_query_t* query = success ? ecs_query_init(world, &desc) : NULL;
+    success = success && query != NULL;
+
+    if (success) {
+        ecs_iter_t it = ecs_query_iter(world, query);
+        while (ecs_query_next(&it)) {
+            if (!success || it.count == 0) {
+                continue;
+            }
+
+            if (header.table_count == table_capacity) {
+                table_capacity *= 2;
+                NexusSceneFileTable* grown = (NexusSceneFileTable*)realloc(tables, sizeof(NexusSceneFileTable) * table_capacity);
+                if (grown == NULL) {
+                    success = false;
+                    continue;
+                }
+                tables = grown;
+            }
+
+            NexusSceneFileTable* record = &tables[header.table_count];
+            memset(record, 0, sizeof(NexusSceneFileTable));
+            record->entity_count = (uint32_t)it.count;
+
+            /* Columns are copied whole, only runtime state is reset afterwards */
+            for (int c = 0; success && c < NEXUS_SCENE_COLUMN_COUNT; c++) {
+                ecs_id_t id = nexus_scene_column_id((NexusSceneColumn)c);
+                if (!ecs_table_has_id(world, it.table, id)) {
+                    continue;
+                }
+
+                const void* column = ecs_table_get_id(world, it.table, id, it.offset);
+                uint32_t size = nexus_scene_column_size((NexusSceneColumn)c) * (uint32_t)it.count;
+                uint32_t offset = nexus_scene_snapshot_append(snapshot, c == NEXUS_SCENE_COLUMN_RENDERABLE ? NULL : column,
+                                                              size);
+                if (offset == 0 || column == NULL) {
+                    success = false;
+                    break;
+                }
+                record->column_offsets[c] = offset;
+                record->column_mask |= 1u << c;
+
+                if (c == NEXUS_SCENE_COLUMN_TRANSFORM) {
+                    /* Parents aren't stored, the hierarchy system rebuilds the world matrices */
+                    NexusTransformComponent* transforms = (NexusTransformComponent*)(snapshot->data + offset);
+                    for (int32_t i = 0; i < it.count; i++) {
+                        transforms[i].world_dirty = true;
+                        transforms[i].world_version = 0;
+                        transforms[i].parent_version = 0;
+                        transforms[i].parent = 0;
+                    }
+                } else if (c == NEXUS_SCENE_COLUMN_RIGIDBODY) {
+                    NexusRigidBodyComponent* bodies = (NexusRigidBodyComponent*)(snapshot->data + offset);
+                    /* Not gathered until the next physics step */
+                    for (int32_t i = 0; i < it.count; i++) {
+                        bodies[i].solver_index = -1;
+                    }
+                } else if (c == NEXUS_SCENE_COLUMN_RENDERABLE) {
+                    /* Pointers become asset table indices */
+                    const NexusRenderableComponent* renderables = (const NexusRenderableComponent*)column;
+                    NexusSceneRenderable* stored = (NexusSceneRenderable*)(snapshot->data + offset);
+                    for (int32_t i = 0; i < it.count; i++) {
+                        stored[i].mesh = nexus_scene_capture_asset(assets, NEXUS_SCENE_ASSET_MESH, renderables[i].mesh,
+                                                                   entry_refs, &refs, &ref_count,
+                                                                   &snapshot->missing_assets);
+                        stored[i].material = nexus_scene_capture_asset(assets, NEXUS_SCENE_ASSET_MATERIAL,
+                                                                       renderables[i].material, entry_refs, &refs,
+                                                                       &ref_count, &snapshot->missing_assets);
+                        stored[i].visible = renderables[i].visible ? 1 : 0;
+                        stored[i].cast_shadows = renderables[i].cast_shadows ? 1 : 0;
+                        stored[i].receive_shadows = renderables[i].receive_shadows ? 1 : 0;
+                        stored[i].reserved = 0;
+                    }
+                }
+            }
+
+            if (ecs_table_has_id(world, it.table, ecs_id(NexusStaticTag))) {
+                record->tag_mask |= NEXUS_SCENE_TAG_STATIC;
+            }
+            if (ecs_table_has_id(world, it.table, ecs_id(NexusGpuDrivenTag))) {
+                record->tag_mask |= NEXUS_SCENE_TAG_GPU_DRIVEN;
+            }
+
+            header.table_count++;
+            header.entity_count += (uint32_t)it.count;
+        }
+        ecs_query_fini(query);
+    }
+
+    /* Table records and asset table follow the columns */
+    if (success) {
+        header.table_offset = nexus_scene_snapshot_append(snapshot, tables,
+                                                          sizeof(NexusSceneFileTable) * header.table_count);
+        header.asset_offset = nexus_scene_snapshot_append(snapshot, refs, sizeof(NexusSceneAssetRef) * ref_count);
+        success = header.table_offset != 0 && header.asset_offset != 0;
+    }
+
+    free(entry_refs);
+    free(refs);
+    free(tables);
+
+    if (!success) {
+        fprintf(stderr, "Failed to capture scene snapshot!\n");
+        nexus_scene_snapshot_destroy(snapshot);
+        return NULL;
+    }
+
+    header.magic = NEXUS_SCENE_FILE_MAGIC;
+    header.version = NEXUS_SCENE_FILE_VERSION;
+    for (int c = 0; c < NEXUS_SCENE_COLUMN_COUNT; c++) {
+        header.column_sizes[c] = nexus_scene_column_size((NexusSceneColumn)c);
+    }
+    header.asset_count = ref_count;
+    header.file_size = snapshot->size;
+    memcpy(snapshot->data, &header, sizeof(NexusSceneFileHeader));
+
+    if (snapshot->missing_assets > 0) {
+        fprintf(stderr, "Warning: %u renderable asset reference(s) of the scene are not registered!\n",
+                snapshot->missing_assets);
+    }
+
+    return snapshot;
+}
+
+/**
+ * Destroy a scene snapshot
+ */
+void nexus_scene_snapshot_destroy(NexusSceneSnapshot* snapshot) {
+    if (snapshot == NULL) {
+        return;
+    }
+
+    free(snapshot->data);
+    free(snapshot);
+}
+
+/**
+ * Write a snapshot to a scene file
+ * Only touches the snapshot, so it can run on any thread
+ */
+bool nexus_scene_snapshot_write(const NexusSceneSnapshot* snapshot, const char* filename) {
+    if (snapshot == NULL || snapshot->data == NULL || filename == NULL) {
+        return false;
+    }
+
+    /* Write to a temporary file and move it into place */
+    char temp_path[NEXUS_SCENE_MAX_PATH + 8];
+    if (snprintf(temp_path, sizeof(temp_path), "%s.tmp", filename) >= (int)sizeof(temp_path)) {
+        return false;
+    }
+
+    FILE* file = fopen(temp_path, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Failed to open '%s' for writing!\n", temp_path);
+        return false;
+    }
+
+    bool success = fwrite(snapshot->data, 1, snapshot->size, file) == snapshot->size;
+    success = fclose(file) == 0 && success;
+
+    /* rename does not replace existing files everywhere */
+    if (success && rename(temp_path, filename) != 0) {
+        remove(filename);
+        success = rename(temp_path, filename) == 0;
+    }
+    if (!success) {
+        fprintf(stderr, "Failed to write scene '%s'!\n", filename);
+        remove(temp_path);
+    }
+
+    return success;
+}
+
+/**
+ * Check that a section lies within the image and is aligned
+ */
+static bool nexus_scene_file_section(uint32_t file_size, uint32_t offset, uint32_t count, uint32_t stride) {
+    uint64_t size = (uint64_t)count * stride;
+    return (offset % NEXUS_SCENE_FILE_ALIGNMENT) == 0 && (uint64_t)offset + size <= file_size;
+}
+
+/**
+ * Create the entities of a scene image, one bulk insert per table
+ */
+static bool nexus_scene_instantiate_image(const uint8_t* data, size_t size, ecs_world_t* world,
+                                          const NexusSceneAssets* assets, uint32_t* entity_count, const char* name) {
+    NexusSceneFileHeader header;
+    bool valid = size >= sizeof(NexusSceneFileHeader);
+    if (valid) {
+        memcpy(&header, data, sizeof(NexusSceneFileHeader));
+        valid = header.magic == NEXUS_SCENE_FILE_MAGIC && header.version == NEXUS_SCENE_FILE_VERSION &&
+                header.file_size <= size &&
+                nexus_scene_file_section(header.file_size, header.table_offset, header.table_count,
+                                         sizeof(NexusSceneFileTable)) &&
+                nexus_scene_file_section(header.file_size, header.asset_offset, header.asset_count,
+                                         sizeof(NexusSceneAssetRef));
+        for (int c = 0; valid && c < NEXUS_SCENE_COLUMN_COUNT; c++) {
+            valid = header.column_sizes[c] == nexus_scene_column_size((NexusSceneColumn)c);
+        }
+    }
+
+    const NexusSceneFileTable* tables = valid ? (const NexusSceneFileTable*)(data + header.table_offset) : NULL;
+    for (uint32_t t = 0; valid && t < header.table_count; t++) {
+        for (int c = 0; valid && c < NEXUS_SCENE_COLUMN_COUNT; c++) {
+            valid = (tables[t].column_mask & (1u << c)) == 0 ||
+                    nexus_scene_file_section(header.file_size, tables[t].column_offsets[c], tables[t].entity_count,
+                                             header.column_sizes[c]);
+        }
+    }
+
+    if (!valid) {
+        fprintf(stderr, "Invalid or outdated scene '%s'!\n", name);
+        return false;
+    }
+
+    /* Resolve the content hashes once */
+    const NexusSceneAssetRef* refs = (const NexusSceneAssetRef*)(data + header.asset_offset);
+    void** resolved = (void**)malloc(sizeof(void*) * (header.asset_count + 1));
+    if (resolved == NULL) {
+        fprintf(stderr, "Failed to allocate memory for scene '%s'!\n", name);
+        return false;
+    }
+
+    uint32_t missing = 0;
+    for (uint32_t i = 0; i < header.asset_count; i++) {
+        resolved[i] = nexus_scene_assets_find(assets, (NexusSceneAssetType)refs[i].type, refs[i].hash);
+        if (resolved[i] == NULL) {
+            missing++;
+        }
+    }
+    if (missing > 0) {
+        fprintf(stderr, "Warning: %u asset(s) of scene '%s' are not registered, their renderables load empty!\n",
+                missing, name);
+    }
+
+    /* Scratch of the translated renderables and the tag data */
+    NexusRenderableComponent* renderables = NULL;
+    uint8_t* tag_data = NULL;
+    uint32_t scratch_capacity = 0;
+    uint32_t created = 0;
+    bool success = true;
+
+    for (uint32_t t = 0; success && t < header.table_count; t++) {
+        const NexusSceneFileTable* table = &tables[t];
+        if (table->entity_count == 0) {
+            continue;
+        }
+
+        if (table->entity_count > scratch_capacity) {
+            free(renderables);
+            free(tag_data);
+            renderables = (NexusRenderableComponent*)malloc(sizeof(NexusRenderableComponent) * table->entity_count);
+            tag_data = (uint8_t*)calloc(table->entity_count, sizeof(NexusStaticTag));
+            scratch_capacity = table->entity_count;
+            if (renderables == NULL || tag_data == NULL) {
+                fprintf(stderr, "Failed to allocate memory for scene '%s'!\n", name);
+                success = false;
+                break;
+            }
+        }
+
+        ecs_bulk_desc_t desc;
+        memset(&desc, 0, sizeof(ecs_bulk_desc_t));
+        void* columns[FLECS_ID_DESC_MAX];
+        int id_count = 0;
+        desc.count = (int32_t)table->entity_count;
+
+        /* Columns are handed to flecs straight from the image */
+        for (int c = 0; c < NEXUS_SCENE_COLUMN_COUNT; c++) {
+            if ((table->column_mask & (1u << c)) == 0) {
+                continue;
+            }
+
+            const uint8_t* column = data + table->column_offsets[c];
+            if (c == NEXUS_SCENE_COLUMN_RENDERABLE) {
+                /* Asset indices become pointers again */
+                const NexusSceneRenderable* stored = (const NexusSceneRenderable*)column;
+                memset(renderables, 0, sizeof(NexusRenderableComponent) * table->entity_count);
+                for (uint32_t i = 0; i < table->entity_count; i++) {
+                    if (stored[i].mesh < header.asset_count) {
+                        renderables[i].mesh = (NexusMesh*)resolved[stored[i].mesh];
+                    }
+                    if (stored[i].material < header.asset_count) {
+                        renderables[i].material = (NexusMaterial*)resolved[stored[i].material];
+                    }
+                    renderables[i].visible = stored[i].visible != 0;
+                    renderables[i].cast_shadows = stored[i].cast_shadows != 0;
+                    renderables[i].receive_shadows = stored[i].receive_shadows != 0;
+                }
+                column = (const uint8_t*)renderables;
+            }
+
+            desc.ids[id_count] = nexus_scene_column_id((NexusSceneColumn)c);
+            columns[id_count++] = (void*)column;
+        }
+        if (table->tag_mask & NEXUS_SCENE_TAG_STATIC) {
+            desc.ids[id_count] = ecs_id(NexusStaticTag);
+            columns[id_count++] = tag_data;
+        }
+        if (table->tag_mask & NEXUS_SCENE_TAG_GPU_DRIVEN) {
+            desc.ids[id_count] = ecs_id(NexusGpuDrivenTag);
+            columns[id_count++] = tag_data;
+        }
+        desc.data = columns;
+
+        if (ecs_bulk_init(world, &desc) == NULL) {
+            fprintf(stderr, "Failed to create the entities of scene '%s'!\n", name);
+            success = false;
+            break;
+        }
+        created += table->entity_count;
+    }
+
+    free(renderables);
+    free(tag_data);
+    free(resolved);
+
+    if (entity_count != NULL) {
+        *entity_count = created;
+    }
+    return success;
+}
+
+/**
+ * Create the entities of a snapshot in a world (outside ecs_progress)
+ */
+bool nexus_scene_snapshot_instantiate(const NexusSceneSnapshot* snapshot, ecs_world_t* world,
+                                      const NexusSceneAssets* assets, uint32_t* entity_count) {
+    if (entity_count != NULL) {
+        *entity_count = 0;
+    }
+    if (snapshot == NULL || snapshot->data == NULL || world == NULL) {
+        return false;
+    }
+
+    return nexus_scene_instantiate_image(snapshot->data, snapshot->size, world, assets, entity_count, "snapshot");
+}
+
+/**
+ * Save the scene to a file, blocking until it was written
+ */
+bool nexus_scene_save(ecs_world_t* world, const NexusSceneAssets* assets, const char* filename) {
+    if (world == NULL || filename == NULL) {
+        return false;
+    }
+
+    NexusSceneSnapshot* snapshot = nexus_scene_snapshot_capture(world, assets);
+    bool success = nexus_scene_snapshot_write(snapshot, filename);
+    nexus_scene_snapshot_destroy(snapshot);
+    return success;
+}
+
+/**
+ * Load a scene file into a world (outside ecs_progress)
+ * The file is mapped and each table inserted with one bulk call, renderable
+ * assets are resolved by content hash through assets
+ */
+bool nexus_scene_load(ecs_world_t* world, const NexusSceneAssets* assets, const char* filename,
+                      uint32_t* entity_count) {
+    if (entity_count != NULL) {
+        *entity_count = 0;
+    }
+    if (world == NULL || filename == NULL) {
+        return false;
+    }
+
+    NexusMappedFile file;
+    if (!nexus_mapped_file_open(&file, filename)) {
+        fprintf(stderr, "Failed to load scene '%s'!\n", filename);
+        return false;
+    }
+
+    bool success = nexus_scene_instantiate_image((const uint8_t*)file.data, file.size, world, assets,
+                                                 entity_count, filename);
+    nexus_mapped_file_close(&file);
+
+    if (success && entity_count != NULL) {
+        printf("Loaded scene '%s' (%u entities)\n", filename, *entity_count);
+    }
+    return success;
+}
+
+/**
+ * Quick save job entry point, writes the copied scene
+ */
+static void nexus_scene_save_job(void* data) {
+    NexusSceneSave* save = (NexusSceneSave*)data;
+
+    save->success = nexus_scene_snapshot_write(save->snapshot, save->path);
+}
+
+/**
+ * Quick save: copy the scene now and write it on a job
+ * The world can change right after the call, finish the save with nexus_scene_save_finish
+ */
+NexusSceneSave* nexus_scene_save_async(ecs_world_t* world, const NexusSceneAssets* assets,
+                                       const char* filename, NexusJobSystem* jobs) {
+    if (world == NULL || filename == NULL) {
+        return NULL;
+    }
+    if (strlen(filename) >= NEXUS_SCENE_MAX_PATH) {
+        fprintf(stderr, "Scene path '%s' is too long!\n", filename);
+        return NULL;
+    }
+
+    /* Allocate save structure */
+    NexusSceneSave* save = (NexusSceneSave*)malloc(sizeof(NexusSceneSave));
+    if (save == NULL) {
+        fprintf(stderr, "Failed to allocate memory for scene save!\n");
+        return NULL;
+    }
+
+    /* Initialize save structure */
+    memset(save, 0, sizeof(NexusSceneSave));
+    strncpy(save->path, filename, sizeof(save->path) - 1);
+    save->jobs = jobs;
+    nexus_job_counter_init(&save->done);
+
+    save->snapshot = nexus_scene_snapshot_capture(world, assets);
+    if (save->snapshot == NULL) {
+        free(save);
+        return NULL;
+    }
+
+    if (jobs != NULL) {
+        nexus_jobs_run(jobs, nexus_scene_save_job, save, &save->done);
+    } else {
+        nexus_scene_save_job(save);
+    }
+
+    return save;
+}
+
+/**
+ * Check if a quick save finished writing
+ */
+bool nexus_scene_save_is_done(NexusSceneSave* save) {
+    if (save == NULL) {
+        return true;
+    }
+
+    return nexus_job_counter_is_done(&save->done);
+}
+
+/**
+ * Wait for a quick save and release it
+ * @return Whether the file was written
+ */
+bool nexus_scene_save_finish(NexusSceneSave* save) {
+    if (save == NULL) {
+        return false;
+    }
+
+    if (save->jobs != NULL) {
+        nexus_jobs_wait(save->jobs, &save->done);
+    }
+
+    bool success = save->success;
+    nexus_scene_snapshot_destroy(save->snapshot);
+    free(save);
+    return success;
+}
@@ -7,7 +7,11 @@
 #include "nexus3d/ecs/systems.h"
 #include "nexus3d/ecs/components.h"
 #include "nexus3d/math/math_utils.h"
+#include "nexus3d/math/transform_batch.h"
 #include "nexus3d/renderer/renderer.h"
+#include "nexus3d/physics/physics.h"
+#include "nexus3d/utils/logger.h"
+#include "nexus3d/utils/profiler.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -23,18 +27,67 @@ ecs_entity_t NexusPhaseRender;
 ecs_entity_t NexusPhasePostRender;
 ecs_entity_t NexusPhaseCleanup;
 
+/* Renderable removal hook, frees the entity's GPU scene object */
+static void nexus_gpu_scene_renderable_removed(ecs_iter_t* it);
+
+#ifdef NEXUS_PROFILE
+/* Run callback timing a system (once per worker for multi threaded systems) */
+static void nexus_ecs_profile_system_run(ecs_iter_t* it);
+
+/* First system of a phase, opens the phase's profiler scope */
+static void nexus_ecs_profile_phase(ecs_iter_t* it);
+
+/* Phase scope opened by the last phase marker (main thread only) */
+static bool nexus_ecs_phase_scope_open = false;
+
+/* System entity, profiled builds run the system through a profiler scope */
+#define NEXUS_ECS_SYSTEM_ENTITY(world, system_name) \
+    .entity = ecs_entity(world, { .name = system_name }), \
+    .run = nexus_ecs_profile_system_run, \
+    .run_ctx = (void*)(system_name)
+#else
+#define NEXUS_ECS_SYSTEM_ENTITY(world, system_name) .entity = ecs_entity(world, { .name = system_name })
+#endif
+
+/**
+ * Log which systems run in parallel and which stay on the main thread
+ */
+static void nexus_ecs_log_system_threading(ecs_world_t* world, const ecs_entity_t* systems, size_t count) {
+    char parallel[256] = "";
+    char main_thread[256] = "";
+
+    for (size_t i = 0; i < count; i++) {
+        if (!systems[i]) {
+            continue;
+        }
+
+        const ecs_system_t* system = ecs_system_get(world, systems[i]);
+        char* list = system != NULL && system->multi_threaded ? parallel : main_thread;
+        size_t length = strlen(list);
+        snprintf(list + length, sizeof(parallel) - length, "%s%s",
+                 length > 0 ? ", " : "", ecs_get_name(world, systems[i]));
+    }
+
+    NEXUS_LOG_DEBUG(nexus_engine_get_logger(), NEXUS_LOG_CATEGORY_ECS,
+                    "ECS systems on %d thread(s), parallel: %s, main thread: %s",
+                    ecs_get_stage_count(world), parallel[0] ? parallel : "none", main_thread[0] ? main_thread : "none");
+}
+
 /**
  * Core system registration
  * Registers all built-in systems with the ECS world
  * @return true if successful, false if there was an error
  */
  bool nexus_ecs_register_systems(ecs_world_t* world) {
-         printf("shit");
       if (world == NULL) {
           printf("Failed to register systems: world is NULL\n");
           return false;
       }
 
+      /* Pick the transform kernel before systems can run on worker threads */
+      nexus_trs_select_kernel();
+      printf("Transform kernel: %s\n", nexus_trs_get_kernel_name());
+
       /* Create phase entities */
       NexusPhaseInit = ecs_entity_init(world, &(ecs_entity_desc_t){
           .name = "NexusPhaseInit"
@@ -64,11 +117,13 @@ ecs_entity_t NexusPhaseCleanup;
           .name = "NexusPhaseCleanup"
       });
 
-      /* Set up pipeline with custom phases */
+      /* Set up pipeline with custom phases, physics phase systems run in
+       * fixed steps from nexus_physics_update instead */
       ecs_entity_t pipeline = ecs_pipeline_init(world, &(ecs_pipeline_desc_t){
           .query.terms = {
               { .id = EcsSystem }, /* First term must be EcsSystem */
-              { .id = EcsPhase, .oper = EcsOptional }
+              { .id = EcsPhase, .oper = EcsOptional },
+              { .id = NexusPhasePhysics, .oper = EcsNot }
           }
       });
 
@@ -96,28 +151,66 @@ ecs_entity_t NexusPhaseCleanup;
       /* Set default pipeline */
       ecs_set_pipeline(world, pipeline);
 
+#ifdef NEXUS_PROFILE
+      /* Phase markers are created ahead of all systems so they run first in
+       * their phase (the physics phase is timed by nexus_physics_update) */
+      ecs_entity_t profiled_phases[] = {
+          NexusPhaseInit, NexusPhaseInput, NexusPhaseLogic, NexusPhaseAnimation,
+          NexusPhasePreRender, NexusPhaseRender, NexusPhasePostRender, NexusPhaseCleanup
+      };
+      for (size_t i = 0; i < sizeof(profiled_phases) / sizeof(profiled_phases[0]); i++) {
+          ecs_entity_t marker = ecs_system_init(world, &(ecs_system_desc_t){
+              .entity = ecs_new(world),
+              .callback = nexus_ecs_profile_phase,
+              .ctx = (void*)ecs_get_name(world, profiled_phases[i])
+          });
+          ecs_add_id(world, marker, profiled_phases[i]);
+      }
+#endif
+
       /* Register actual systems to their respective phases using system interface */
       /* Transform system - PreRender phase */
       ecs_entity_t transform_system = ecs_system_init(world, &(ecs_system_desc_t){
-          .entity = ecs_entity(world, { .name = "NexusTransformSystem" }),
+          NEXUS_ECS_SYSTEM_ENTITY(world, "NexusTransformSystem"),
           .query.terms = {
-              { .id = ecs_id(NexusPositionComponent) },
-              { .id = ecs_id(NexusRotationComponent) },
-              { .id = ecs_id(NexusScaleComponent) },
-              { .id = ecs_id(NexusTransformComponent) }
+              { .id = ecs_id(NexusPositionComponent), .inout = EcsIn },
+              { .id = ecs_id(NexusRotationComponent), .inout = EcsIn },
+              { .id = ecs_id(NexusScaleComponent), .inout = EcsIn },
+              { .id = ecs_id(NexusTransformComponent), .inout = EcsOut }
           },
-          .callback = nexus_transform_system
+          .callback = nexus_transform_system,
+          .multi_threaded = true
       });
       if (!transform_system) {
           fprintf(stderr, "Failed to create transform system\n");
       }
       ecs_add_id(world, transform_system, NexusPhasePreRender);
 
+      /* Interpolation system - PreRender phase, between local and world matrices */
+      ecs_entity_t interpolation_system = ecs_system_init(world, &(ecs_system_desc_t){
+          NEXUS_ECS_SYSTEM_ENTITY(world, "NexusInterpolationSystem"),
+          .query.terms = {
+              { .id = ecs_id(NexusInterpolationComponent) },
+              { .id = ecs_id(NexusPositionComponent), .inout = EcsIn },
+              { .id = ecs_id(NexusRotationComponent), .inout = EcsIn },
+              { .id = ecs_id(NexusScaleComponent), .inout = EcsIn },
+              { .id = ecs_id(NexusTransformComponent) }
+          },
+          .callback = nexus_interpolation_system,
+          .multi_threaded = true
+      });
+      if (!interpolation_system) {
+          fprintf(stderr, "Failed to create interpolation system\n");
+      }
+      ecs_add_id(world, interpolation_system, NexusPhasePreRender);
+
       /* Hierarchy system - PreRender phase */
       ecs_entity_t hierarchy_system = ecs_system_init(world, &(ecs_system_desc_t){
-          .entity = ecs_entity(world, { .name = "NexusHierarchySystem" }),
+          NEXUS_ECS_SYSTEM_ENTITY(world, "NexusHierarchySystem"),
           .query.terms = {
-              { .id = ecs_id(NexusTransformComponent) }
+              { .id = ecs_id(NexusTransformComponent) },
+              { .id = ecs_id(NexusTransformComponent), .src.id = EcsCascade | EcsUp,
+                .trav = EcsChildOf, .oper = EcsOptional, .inout = EcsIn }
           },
           .callback = nexus_hierarchy_system
       });
@@ -126,12 +219,37 @@ ecs_entity_t NexusPhaseCleanup;
       }
       ecs_add_id(world, hierarchy_system, NexusPhasePreRender);
 
+      /* GPU scene system - PreRender phase, after the world transforms are final */
+      ecs_entity_t gpu_scene_system = ecs_system_init(world, &(ecs_system_desc_t){
+          NEXUS_ECS_SYSTEM_ENTITY(world, "NexusGpuSceneSystem"),
+          .query.terms = {
+              { .id = ecs_id(NexusRenderableComponent) },
+              { .id = ecs_id(NexusTransformComponent), .inout = EcsIn },
+              { .id = ecs_id(NexusBoundsComponent), .oper = EcsOptional },
+              { .id = ecs_id(NexusGpuDrivenTag), .oper = EcsOptional, .inout = EcsIn }
+          },
+          .callback = nexus_gpu_scene_system
+      });
+      if (!gpu_scene_system) {
+          fprintf(stderr, "Failed to create GPU scene system\n");
+      }
+      ecs_add_id(world, gpu_scene_system, NexusPhasePreRender);
+
+      /* Deleted renderables give their GPU scene objects back */
+      ecs_observer_init(world, &(ecs_observer_desc_t){
+          .query.terms = {
+              { .id = ecs_id(NexusRenderableComponent) }
+          },
+          .events = { EcsOnRemove },
+          .callback = nexus_gpu_scene_renderable_removed
+      });
+
       /* Camera system - PreRender phase */
       ecs_entity_t camera_system = ecs_system_init(world, &(ecs_system_desc_t){
-          .entity = ecs_entity(world, { .name = "NexusCameraSystem" }),
+          NEXUS_ECS_SYSTEM_ENTITY(world, "NexusCameraSystem"),
           .query.terms = {
               { .id = ecs_id(NexusCameraComponent) },
-              { .id = ecs_id(NexusTransformComponent) }
+              { .id = ecs_id(NexusTransformComponent), .inout = EcsIn }
           },
           .callback = nexus_camera_system
       });
@@ -140,12 +258,22 @@ ecs_entity_t NexusPhaseCleanup;
       }
       ecs_add_id(world, camera_system, NexusPhasePreRender);
 
+      /* Light reset system - PreRender phase, ahead of the light system */
+      ecs_entity_t light_reset_system = ecs_system_init(world, &(ecs_system_desc_t){
+          .entity = ecs_entity(world, { .name = "NexusLightResetSystem" }),
+          .callback = nexus_light_reset_system
+      });
+      if (!light_reset_system) {
+          fprintf(stderr, "Failed to create light reset system\n");
+      }
+      ecs_add_id(world, light_reset_system, NexusPhasePreRender);
+
       /* Light system - PreRender phase */
       ecs_entity_t light_system = ecs_system_init(world, &(ecs_system_desc_t){
-          .entity = ecs_entity(world, { .name = "NexusLightSystem" }),
+          NEXUS_ECS_SYSTEM_ENTITY(world, "NexusLightSystem"),
           .query.terms = {
               { .id = ecs_id(NexusLightComponent) },
-              { .id = ecs_id(NexusTransformComponent) }
+              { .id = ecs_id(NexusTransformComponent), .inout = EcsIn }
           },
           .callback = nexus_light_system
       });
@@ -156,10 +284,12 @@ ecs_entity_t NexusPhaseCleanup;
 
       /* Renderer system - Render phase */
       ecs_entity_t renderer_system = ecs_system_init(world, &(ecs_system_desc_t){
-          .entity = ecs_entity(world, { .name = "NexusRendererSystem" }),
+          NEXUS_ECS_SYSTEM_ENTITY(world, "NexusRendererSystem"),
           .query.terms = {
               { .id = ecs_id(NexusRenderableComponent) },
-              { .id = ecs_id(NexusTransformComponent) }
+              { .id = ecs_id(NexusTransformComponent), .inout = EcsIn },
+              { .id = ecs_id(NexusBoundsComponent), .oper = EcsOptional },
+              { .id = ecs_id(NexusGpuDrivenTag), .oper = EcsNot }
           },
           .callback = nexus_renderer_system
       });
@@ -168,15 +298,16 @@ ecs_entity_t NexusPhaseCleanup;
       }
       ecs_add_id(world, renderer_system, NexusPhaseRender);
 
-      /* Physics system - Physics phase */
+      /* Physics system - Physics phase (fixed step, rigid bodies move in the solver) */
       ecs_entity_t physics_system = ecs_system_init(world, &(ecs_system_desc_t){
-          .entity = ecs_entity(world, { .name = "NexusPhysicsSystem" }),
+          NEXUS_ECS_SYSTEM_ENTITY(world, "NexusPhysicsSystem"),
           .query.terms = {
-              { .id = ecs_id(NexusRigidBodyComponent), .oper = EcsOptional },
               { .id = ecs_id(NexusPositionComponent) },
-              { .id = ecs_id(NexusRotationComponent), .oper = EcsOptional }
+              { .id = ecs_id(NexusVelocityComponent), .inout = EcsIn },
+              { .id = ecs_id(NexusRigidBodyComponent), .oper = EcsNot }
           },
-          .callback = nexus_physics_system
+          .callback = nexus_physics_system,
+          .multi_threaded = true
       });
       if (!physics_system) {
           fprintf(stderr, "Failed to create physics system\n");
@@ -185,11 +316,12 @@ ecs_entity_t NexusPhaseCleanup;
 
       /* Animation system - Animation phase */
       ecs_entity_t animation_system = ecs_system_init(world, &(ecs_system_desc_t){
-          .entity = ecs_entity(world, { .name = "NexusAnimationSystem" }),
+          NEXUS_ECS_SYSTEM_ENTITY(world, "NexusAnimationSystem"),
           .query.terms = {
               { .id = ecs_id(NexusTransformComponent) }
           },
-          .callback = nexus_animation_system
+          .callback = nexus_animation_system,
+          .multi_threaded = true
       });
       if (!animation_system) {
           fprintf(stderr, "Failed to create animation system\n");
@@ -198,10 +330,10 @@ ecs_entity_t NexusPhaseCleanup;
 
       /* Audio system - Logic phase */
       ecs_entity_t audio_system = ecs_system_init(world, &(ecs_system_desc_t){
-          .entity = ecs_entity(world, { .name = "NexusAudioSystem" }),
+          NEXUS_ECS_SYSTEM_ENTITY(world, "NexusAudioSystem"),
           .query.terms = {
               { .id = ecs_id(NexusAudioSourceComponent) },
-              { .id = ecs_id(NexusTransformComponent), .oper = EcsOptional }
+              { .id = ecs_id(NexusTransformComponent), .oper = EcsOptional, .inout = EcsIn }
           },
           .callback = nexus_audio_system
       });
@@ -210,6 +342,13 @@ ecs_entity_t NexusPhaseCleanup;
       }
       ecs_add_id(world, audio_system, NexusPhaseLogic);
 
+      /* Report which systems the workers share */
+      ecs_entity_t systems[] = {
+          transform_system, interpolation_system, hierarchy_system, gpu_scene_system, camera_system,
+          light_system, renderer_system, physics_system, animation_system, audio_system
+      };
+      nexus_ecs_log_system_threading(world, systems, sizeof(systems) / sizeof(systems[0]));
+
       printf("Successfully registered all ECS systems\n");
       return true;
   }
@@ -218,115 +357,288 @@ ecs_entity_t NexusPhaseCleanup;
  * Transform system - updates transform matrices based on position, rotation, and scale
  */
 void nexus_transform_system(ecs_iter_t* it) {
+    /* Tables whose position, rotation and scale columns were not written
+     * since the last run are skipped whole (static scenery never is) */
+    if (!ecs_iter_changed(it)) {
+        ecs_iter_skip(it);
+        return;
+    }
+
     /* Get component arrays */
+    NexusPositionComponent* positions = ecs_field(it, NexusPositionComponent, 0);
+    NexusRotationComponent* rotations = ecs_field(it, NexusRotationComponent, 1);
+    NexusScaleComponent* scales = ecs_field(it, NexusScaleComponent, 2);
+    NexusTransformComponent* transforms = ecs_field(it, NexusTransformComponent, 3);
+
+    /* Compose the whole table in SIMD batches */
+    NexusTRSBatch batch = {
+        .positions = positions[0].value,
+        .position_stride = sizeof(NexusPositionComponent),
+        .rotations = rotations[0].quaternion,
+        .rotation_stride = sizeof(NexusRotationComponent),
+        .scales = scales[0].value,
+        .scale_stride = sizeof(NexusScaleComponent),
+        .matrices = transforms[0].local[0],
+        .matrix_stride = sizeof(NexusTransformComponent)
+    };
+    nexus_trs_compose_batch(&batch, it->count);
+
+    /* The hierarchy system owns world matrices */
+    for (int i = 0; i < it->count; i++) {
+        transforms[i].world_dirty = true;
+    }
+}
+
+/**
+ * Interpolation system - blends local matrices between the last two physics steps
+ */
+void nexus_interpolation_system(ecs_iter_t* it) {
+    /* Get component arrays */
+    NexusInterpolationComponent* states = ecs_field(it, NexusInterpolationComponent, 0);
     NexusPositionComponent* positions = ecs_field(it, NexusPositionComponent, 1);
     NexusRotationComponent* rotations = ecs_field(it, NexusRotationComponent, 2);
     NexusScaleComponent* scales = ecs_field(it, NexusScaleComponent, 3);
     NexusTransformComponent* transforms = ecs_field(it, NexusTransformComponent, 4);
 
-    /* Static counter to limit debug output frequency */
-    static int debug_counter = 0;
-    if (debug_counter++ % 300 == 0) {
-        printf("Transform system processing %d entities\n", it->count);
-    }
+    NexusPhysics* physics = nexus_engine_get_physics();
+    float alpha = nexus_physics_get_interpolation_alpha(physics);
 
-    /* Update each entity */
     for (int i = 0; i < it->count; i++) {
-        /* Only update if transform is dirty */
-        if (transforms[i].dirty) {
-            /* Build model matrix from position, rotation, and scale */
-
-            /* Start with identity matrix */
-            glm_mat4_identity(transforms[i].local);
+        if (!states[i].valid) {
+            continue;
+        }
 
-            /* Apply translation */
-            glm_translate(transforms[i].local, positions[i].value);
+        /* Resting entities only need their last blended matrix replaced once */
+        bool moved = !glm_vec3_eqv(states[i].previous_position, positions[i].value) ||
+                     !glm_vec4_eqv(states[i].previous_rotation, rotations[i].quaternion);
+        if (!moved && !states[i].blended) {
+            continue;
+        }
 
-            /* Apply rotation from quaternion */
-            mat4 rotation_matrix;
-            glm_quat_mat4(rotations[i].quaternion, rotation_matrix);
-            glm_mat4_mul(transforms[i].local, rotation_matrix, transforms[i].local);
+        vec3 position;
+        versor rotation;
+        if (moved) {
+            glm_vec3_lerp(states[i].previous_position, positions[i].value, alpha, position);
+            glm_quat_slerp(states[i].previous_rotation, rotations[i].quaternion, alpha, rotation);
+        } else {
+            glm_vec3_copy(positions[i].value, position);
+            glm_quat_copy(rotations[i].quaternion, rotation);
+        }
 
-            /* Apply scale */
-            glm_scale(transforms[i].local, scales[i].value);
+        NexusTRSBatch batch = {
+            .positions = position,
+            .rotations = rotation,
+            .scales = scales[i].value,
+            .matrices = transforms[i].local[0]
+        };
+        nexus_trs_compose_scalar(&batch, 1);
 
-            /* Copy local to world (hierarchy system will update this if needed) */
-            glm_mat4_copy(transforms[i].local, transforms[i].world);
+        transforms[i].world_dirty = true;
+        states[i].blended = moved;
+    }
+}
 
-            /* Clear dirty flag */
-            transforms[i].dirty = false;
-        }
+/**
+ * Flag an entity whose position, rotation or scale was written without ecs_set
+ * (e.g. through ecs_get_mut), so change detection picks up its table
+ */
+void nexus_transform_mark_changed(ecs_world_t* world, ecs_entity_t entity) {
+    if (world == NULL || entity == 0) {
+        return;
     }
+
+    ecs_modified(world, entity, NexusPositionComponent);
 }
 
 /**
  * Hierarchy system - updates world transforms based on parent-child relationships
+ * Tables arrive in cascade order, so every parent is final before its children
  */
 void nexus_hierarchy_system(ecs_iter_t* it) {
-    /* Get transform components */
-    NexusTransformComponent* transforms = ecs_field(it, NexusTransformComponent, 1);
+    /* Skip tables where neither the transforms nor the parent's transform changed */
+    if (!ecs_iter_changed(it)) {
+        ecs_iter_skip(it);
+        return;
+    }
 
-    /* Static counter to limit debug output frequency */
-    static int debug_counter = 0;
-    if (debug_counter++ % 300 == 0) {
-        printf("Hierarchy system processing %d entities\n", it->count);
+    /* Get transform components */
+    NexusTransformComponent* transforms = ecs_field(it, NexusTransformComponent, 0);
+
+    /* ChildOf is part of the table type, so the whole table shares one parent */
+    NexusTransformComponent* parent = NULL;
+    ecs_entity_t parent_entity = 0;
+    uint32_t parent_version = 0;
+    if (ecs_field_is_set(it, 1)) {
+        parent = ecs_field(it, NexusTransformComponent, 1);
+        parent_entity = ecs_field_src(it, 1);
+        parent_version = parent->world_version;
     }
 
-    /* For a proper hierarchy system, we would have parent-child relationships,
-     * but for now we'll simply ensure world transforms are updated */
+    bool updated = false;
     for (int i = 0; i < it->count; i++) {
-        /* In a real implementation, we would iterate through the hierarchy
-         * and multiply parent world transforms with child local transforms */
+        NexusTransformComponent* transform = &transforms[i];
+
+        /* Skip unless the local matrix, the parent's world matrix or the parent itself changed */
+        if (!transform->world_dirty && transform->parent == parent_entity &&
+            transform->parent_version == parent_version) {
+            continue;
+        }
 
-        /* For now, just ensure world is a copy of local if no hierarchy exists */
-        if (transforms[i].dirty) {
-            glm_mat4_copy(transforms[i].local, transforms[i].world);
-            transforms[i].dirty = false;
+        if (parent != NULL) {
+            glm_mat4_mul(parent->world, transform->local, transform->world);
+        } else {
+            glm_mat4_copy(transform->local, transform->world);
         }
+
+        /* Children compare against the new version when their tables come up */
+        transform->parent = parent_entity;
+        transform->parent_version = parent_version;
+        transform->world_version++;
+        transform->world_dirty = false;
+        updated = true;
+    }
+
+    /* Only a table that was written marks its transforms changed for the children */
+    if (!updated) {
+        ecs_iter_skip(it);
     }
 }
 
 /**
- * Physics system - updates physics simulation
+ * GPU scene system - keeps the GPU scene's objects in sync with opaque renderables
+ * Entities the scene accepts are tagged NexusGpuDrivenTag, which takes them
+ * out of the renderer system. Tables without changes are skipped, so a static
+ * scene costs nothing per object
  */
-void nexus_physics_system(ecs_iter_t* it) {
+void nexus_gpu_scene_system(ecs_iter_t* it) {
+    struct NexusRenderer* renderer = nexus_engine_get_renderer();
+    NexusGpuScene* scene = nexus_renderer_get_gpu_scene(renderer);
+    if (scene == NULL || !ecs_iter_changed(it)) {
+        ecs_iter_skip(it);
+        return;
+    }
+
     /* Get component arrays */
-    NexusRigidBodyComponent* bodies = ecs_field(it, NexusRigidBodyComponent, 1);
-    NexusPositionComponent* positions = ecs_field(it, NexusPositionComponent, 2);
-    NexusRotationComponent* rotations = ecs_field(it, NexusRotationComponent, 3);
+    NexusRenderableComponent* renderables = ecs_field(it, NexusRenderableComponent, 0);
+    NexusTransformComponent* transforms = ecs_field(it, NexusTransformComponent, 1);
+    NexusBoundsComponent* bounds = ecs_field(it, NexusBoundsComponent, 2);
+    bool tagged = ecs_field_is_set(it, 3);
 
-    /* Static counter to limit debug output frequency */
-    static int debug_counter = 0;
-    if (debug_counter++ % 300 == 0) {
-        printf("Physics system processing %d entities\n", it->count);
+    /* A render thread may be uploading the scene of the previous frame */
+    nexus_gpu_scene_lock(scene);
+    bool updated = false;
+    for (int i = 0; i < it->count; i++) {
+        NexusRenderableComponent* renderable = &renderables[i];
+        NexusMesh* mesh = renderable->mesh;
+
+        /* Hidden, non-opaque and shadow casting renderables go back to the
+         * render queue (the shadow atlas takes its casters from there) */
+        if (!renderable->visible || renderable->cast_shadows ||
+            !nexus_gpu_scene_accepts(scene, mesh, renderable->material)) {
+            if (renderable->gpu_object != 0) {
+                nexus_gpu_scene_remove_object(scene, renderable->gpu_object);
+                renderable->gpu_object = 0;
+                updated = true;
+            }
+            if (tagged) {
+                ecs_remove(it->world, it->entities[i], NexusGpuDrivenTag);
+            }
+            continue;
+        }
+
+        /* The renderer system no longer sees these entities, refresh their bounds here */
+        vec3 world_min, world_max;
+        if (bounds != NULL) {
+            if (bounds[i].transform_version != transforms[i].world_version || bounds[i].mesh != mesh) {
+                nexus_aabb_transform(transforms[i].world, mesh->bounds_min, mesh->bounds_max,
+                                     bounds[i].min, bounds[i].max);
+                bounds[i].mesh = mesh;
+                bounds[i].transform_version = transforms[i].world_version;
+                updated = true;
+            }
+            glm_vec3_copy(bounds[i].min, world_min);
+            glm_vec3_copy(bounds[i].max, world_max);
+        } else {
+            nexus_aabb_transform(transforms[i].world, mesh->bounds_min, mesh->bounds_max, world_min, world_max);
+        }
+
+        /* Only changed objects are uploaded by the scene */
+        if (renderable->gpu_object != 0) {
+            nexus_gpu_scene_update_object(scene, renderable->gpu_object, mesh, renderable->lod,
+                                          renderable->material, (float*)transforms[i].world, world_min, world_max);
+        } else {
+            renderable->gpu_object = nexus_gpu_scene_add_object(scene, mesh, renderable->lod, renderable->material,
+                                                                (float*)transforms[i].world, world_min, world_max);
+            if (renderable->gpu_object != 0) {
+                updated = true;
+                if (!tagged) {
+                    ecs_add(it->world, it->entities[i], NexusGpuDrivenTag);
+                }
+            }
+        }
+    }
+    nexus_gpu_scene_unlock(scene);
+
+    /* Only a table that was written marks its components changed */
+    if (!updated) {
+        ecs_iter_skip(it);
     }
+}
 
-    /* In a real implementation, this would integrate with the physics engine */
-    /* For now, just print info about each rigid body */
+/**
+ * Free the GPU scene objects of removed renderables
+ */
+static void nexus_gpu_scene_renderable_removed(ecs_iter_t* it) {
+    /* The renderer is destroyed ahead of the world, its scene went with it */
+    NexusGpuScene* scene = nexus_renderer_get_gpu_scene(nexus_engine_get_renderer());
+    if (scene == NULL) {
+        return;
+    }
+
+    NexusRenderableComponent* renderables = ecs_field(it, NexusRenderableComponent, 0);
+    nexus_gpu_scene_lock(scene);
     for (int i = 0; i < it->count; i++) {
-        /* Check if this entity has a rigid body component */
-        if (bodies) {
-            /* Apply physics calculations (this would be more complex in reality) */
-            if (!bodies[i].sleeping && !bodies[i].kinematic) {
-                /* Basic gravity effect - move objects downward a bit */
-                positions[i].value[1] -= 9.8f * it->delta_time;
-            }
+        if (renderables[i].gpu_object != 0) {
+            nexus_gpu_scene_remove_object(scene, renderables[i].gpu_object);
+            renderables[i].gpu_object = 0;
         }
     }
+    nexus_gpu_scene_unlock(scene);
+}
+
+/**
+ * Physics system - updates physics simulation
+ */
+void nexus_physics_system(ecs_iter_t* it) {
+    /* Get component arrays */
+    NexusPositionComponent* positions = ecs_field(it, NexusPositionComponent, 0);
+    NexusVelocityComponent* velocities = ecs_field(it, NexusVelocityComponent, 1);
+
+    /* Entities without a rigid body just follow their velocity, delta_time is
+     * the fixed physics step */
+    for (int i = 0; i < it->count; i++) {
+        vec3 delta;
+        glm_vec3_scale(velocities[i].linear, it->delta_time, delta);
+        glm_vec3_add(positions[i].value, delta, positions[i].value);
+    }
 }
 
 /**
  * Renderer system - handles rendering of all entities with render components
+ * Visible draws and shadow casters are extracted into the renderer's
+ * snapshot, or drawn right away into an open frame without one
  */
 void nexus_renderer_system(ecs_iter_t* it) {
     /* Get component arrays */
-    NexusRenderableComponent* renderables = ecs_field(it, NexusRenderableComponent, 1);
-    NexusTransformComponent* transforms = ecs_field(it, NexusTransformComponent, 2);
+    NexusRenderableComponent* renderables = ecs_field(it, NexusRenderableComponent, 0);
+    NexusTransformComponent* transforms = ecs_field(it, NexusTransformComponent, 1);
+    NexusBoundsComponent* bounds = ecs_field(it, NexusBoundsComponent, 2);
 
     /* Static counter to limit debug output frequency */
     static int debug_counter = 0;
     if (debug_counter++ % 300 == 0) {
-        printf("Renderer system processing %d entities\n", it->count);
+        NEXUS_LOG_DEBUG(nexus_engine_get_logger(), NEXUS_LOG_CATEGORY_ECS,
+                        "Renderer system processing %d entities", it->count);
     }
 
     /* Get global renderer instance */
@@ -335,68 +647,207 @@ void nexus_renderer_system(ecs_iter_t* it) {
         return;
     }
 
+    /* Draws are extracted for a later frame or queued for the open frame's scene pass */
+    NexusRenderSnapshot* snapshot = nexus_renderer_get_snapshot(renderer);
+    if (snapshot == NULL && !nexus_renderer_is_in_frame(renderer)) {
+        return;
+    }
+
+    /* Gather world bounds of this table into the packed culling buffer */
+    NexusCullingBuffer* culling = nexus_renderer_get_culling_buffer(renderer);
+    nexus_culling_buffer_reset(culling);
+
+    for (int i = 0; i < it->count; i++) {
+        NexusMesh* mesh = renderables[i].mesh;
+        vec3 world_min = {0.0f, 0.0f, 0.0f};
+        vec3 world_max = {0.0f, 0.0f, 0.0f};
+
+        if (mesh != NULL) {
+            if (bounds != NULL) {
+                /* Refresh the cached bounds only when the transform or mesh changed */
+                if (bounds[i].transform_version != transforms[i].world_version || bounds[i].mesh != mesh) {
+                    nexus_aabb_transform(transforms[i].world, mesh->bounds_min, mesh->bounds_max,
+                                         bounds[i].min, bounds[i].max);
+                    bounds[i].mesh = mesh;
+                    bounds[i].transform_version = transforms[i].world_version;
+                }
+                glm_vec3_copy(bounds[i].min, world_min);
+                glm_vec3_copy(bounds[i].max, world_max);
+            } else {
+                nexus_aabb_transform(transforms[i].world, mesh->bounds_min, mesh->bounds_max,
+                                     world_min, world_max);
+            }
+        }
+
+        nexus_culling_buffer_add(culling, world_min, world_max);
+    }
+
+    /* SIMD frustum test over the whole table (against the snapshot's view) */
+    nexus_renderer_cull(renderer);
+
     /* Process each entity */
     for (int i = 0; i < it->count; i++) {
-        /* Only render visible objects */
-        if (renderables[i].visible && renderables[i].mesh && renderables[i].material) {
-            /* Render the mesh with its material and world transform */
-            nexus_renderer_render_mesh(
-                renderer,
-                renderables[i].mesh,
-                renderables[i].material->shader,
-                (float*)transforms[i].world
-            );
+        /* Shadow casters outside the camera view can still throw shadows into it */
+        if (renderables[i].visible && renderables[i].mesh && renderables[i].material &&
+            renderables[i].cast_shadows) {
+            float world_min[3] = { culling->center_x[i] - culling->extent_x[i],
+                                   culling->center_y[i] - culling->extent_y[i],
+                                   culling->center_z[i] - culling->extent_z[i] };
+            float world_max[3] = { culling->center_x[i] + culling->extent_x[i],
+                                   culling->center_y[i] + culling->extent_y[i],
+                                   culling->center_z[i] + culling->extent_z[i] };
+            if (snapshot != NULL) {
+                nexus_render_snapshot_add_caster(snapshot, renderables[i].mesh, renderables[i].lod,
+                                                 renderables[i].material, (float*)transforms[i].world,
+                                                 world_min, world_max);
+            } else {
+                nexus_renderer_submit_shadow_caster(renderer, renderables[i].mesh, renderables[i].lod,
+                                                    renderables[i].material, (float*)transforms[i].world,
+                                                    world_min, world_max);
+            }
+        }
+
+        /* Only render visible objects inside the frustum */
+        if (renderables[i].visible && renderables[i].mesh && renderables[i].material &&
+            culling->visible[i]) {
+            /* Pick the detail level from the projected size of the world bounds */
+            float center[3] = { culling->center_x[i], culling->center_y[i], culling->center_z[i] };
+            float radius = sqrtf(culling->extent_x[i] * culling->extent_x[i] +
+                                 culling->extent_y[i] * culling->extent_y[i] +
+                                 culling->extent_z[i] * culling->extent_z[i]);
+            renderables[i].lod = nexus_renderer_select_lod(renderer, renderables[i].mesh, center, radius,
+                                                           renderables[i].lod);
+
+            /* Queue the mesh with its material and world transform, the
+             * renderer sorts the frame's draws to minimize state changes */
+            if (snapshot != NULL) {
+                nexus_render_snapshot_add_draw(snapshot, renderables[i].mesh, renderables[i].lod,
+                                               renderables[i].material, (float*)transforms[i].world);
+            } else {
+                nexus_renderer_submit_lod(
+                    renderer,
+                    renderables[i].mesh,
+                    renderables[i].lod,
+                    renderables[i].material,
+                    (float*)transforms[i].world
+                );
+            }
         }
     }
 }
 
 /**
- * Light system - updates light parameters for rendering
+ * Light system - submits lights to the renderer for clustered shading
  */
 void nexus_light_system(ecs_iter_t* it) {
     /* Get component arrays */
-    NexusLightComponent* lights = ecs_field(it, NexusLightComponent, 1);
-    NexusTransformComponent* transforms = ecs_field(it, NexusTransformComponent, 2);
+    NexusLightComponent* lights = ecs_field(it, NexusLightComponent, 0);
+    NexusTransformComponent* transforms = ecs_field(it, NexusTransformComponent, 1);
 
     /* Static counter to limit debug output frequency */
     static int debug_counter = 0;
     if (debug_counter++ % 300 == 0) {
-        printf("Light system processing %d entities\n", it->count);
+        NEXUS_LOG_DEBUG(nexus_engine_get_logger(), NEXUS_LOG_CATEGORY_ECS,
+                        "Light system processing %d entities", it->count);
     }
 
-    /* In a real implementation, this would update light position, direction,
-     * and prepare shadow maps for rendering */
+    NexusRenderer* renderer = nexus_engine_get_renderer();
+    if (renderer == NULL) {
+        return;
+    }
+    NexusRenderSnapshot* snapshot = nexus_renderer_get_snapshot(renderer);
+
+    /* Hand every light to the renderer (through the snapshot), which bins them into clusters */
     for (int i = 0; i < it->count; i++) {
-        /* Different handling based on light type */
+        NexusLightData light;
+        memset(&light, 0, sizeof(light));
+
+        /* Position from the world transform, lights point down their -Z axis */
+        vec3 direction = {
+            -transforms[i].world[2][0],
+            -transforms[i].world[2][1],
+            -transforms[i].world[2][2]
+        };
+        glm_vec3_normalize(direction);
+
+        light.position_range[0] = transforms[i].world[3][0];
+        light.position_range[1] = transforms[i].world[3][1];
+        light.position_range[2] = transforms[i].world[3][2];
+        light.position_range[3] = lights[i].range;
+        glm_vec3_copy(lights[i].color, light.color_intensity);
+        light.color_intensity[3] = lights[i].intensity;
+        glm_vec3_copy(direction, light.direction_type);
+
         switch (lights[i].type) {
             case NEXUS_LIGHT_DIRECTIONAL:
-                /* Update directional light - extract direction from transform */
-                /* This would be passed to the renderer for shadow mapping and lighting */
+                light.direction_type[3] = (float)NEXUS_LIGHT_TYPE_DIRECTIONAL;
                 break;
 
             case NEXUS_LIGHT_POINT:
-                /* Update point light position from transform */
+                light.direction_type[3] = (float)NEXUS_LIGHT_TYPE_POINT;
                 break;
 
-            case NEXUS_LIGHT_SPOT:
-                /* Update spot light position and direction from transform */
+            case NEXUS_LIGHT_SPOT: {
+                /* Cone half angles, softness fades the inner part of the edge */
+                float outer = glm_rad(lights[i].spot_angle * 0.5f);
+                float inner = outer * (1.0f - glm_clamp(lights[i].spot_softness, 0.0f, 1.0f));
+                light.direction_type[3] = (float)NEXUS_LIGHT_TYPE_SPOT;
+                light.spot[0] = cosf(outer);
+                light.spot[1] = cosf(inner);
                 break;
+            }
+        }
+
+        /* Shadowed lights are tracked by entity so their shadow maps stay cached */
+        uint32_t resolution = lights[i].shadow_resolution > 0 ? (uint32_t)lights[i].shadow_resolution : 0;
+        bool added;
+        if (snapshot != NULL) {
+            added = nexus_render_snapshot_add_light(snapshot, &light, lights[i].cast_shadows,
+                                                    (uint64_t)it->entities[i], resolution);
+        } else {
+            added = lights[i].cast_shadows ?
+                nexus_renderer_add_shadowed_light(renderer, &light, (uint64_t)it->entities[i], resolution) :
+                nexus_renderer_add_light(renderer, &light);
+        }
+        if (!added) {
+            break;
         }
     }
 }
 
+/**
+ * Light reset system - clears last frame's lights before the light system runs
+ * Runs once per frame (no query), frames that were never rendered must not
+ * pile up their lights
+ */
+void nexus_light_reset_system(ecs_iter_t* it) {
+    (void)it;
+
+    /* Systems without terms keep their plain callback, the scope is taken here */
+    NEXUS_PROFILE_BEGIN("NexusLightResetSystem");
+    NexusRenderer* renderer = nexus_engine_get_renderer();
+    NexusRenderSnapshot* snapshot = nexus_renderer_get_snapshot(renderer);
+    if (snapshot != NULL) {
+        nexus_render_snapshot_clear_lights(snapshot);
+    } else {
+        nexus_renderer_clear_lights(renderer);
+    }
+    NEXUS_PROFILE_END();
+}
+
 /**
  * Camera system - updates camera matrices and parameters
  */
 void nexus_camera_system(ecs_iter_t* it) {
     /* Get component arrays */
-    NexusCameraComponent* cameras = ecs_field(it, NexusCameraComponent, 1);
-    NexusTransformComponent* transforms = ecs_field(it, NexusTransformComponent, 2);
+    NexusCameraComponent* cameras = ecs_field(it, NexusCameraComponent, 0);
+    NexusTransformComponent* transforms = ecs_field(it, NexusTransformComponent, 1);
 
     /* Static counter to limit debug output frequency */
     static int debug_counter = 0;
     if (debug_counter++ % 300 == 0) {
-        printf("Camera system processing %d entities\n", it->count);
+        NEXUS_LOG_DEBUG(nexus_engine_get_logger(), NEXUS_LOG_CATEGORY_ECS,
+                        "Camera system processing %d entities", it->count);
     }
 
     /* Reference to the main renderer */
@@ -435,9 +886,11 @@ void nexus_camera_system(ecs_iter_t* it) {
             /* Update camera matrices */
             nexus_camera_update(cameras[i].camera);
 
-            /* If this is the primary camera, set it as the renderer's main camera */
+            /* If this is the primary camera, set it as the renderer's main camera
+             * and the view of the snapshot being extracted */
             if (cameras[i].primary && renderer) {
                 nexus_renderer_set_camera(renderer, cameras[i].camera);
+                nexus_render_snapshot_set_camera(nexus_renderer_get_snapshot(renderer), cameras[i].camera);
             }
         }
     }
@@ -448,13 +901,14 @@ void nexus_camera_system(ecs_iter_t* it) {
  */
 void nexus_audio_system(ecs_iter_t* it) {
     /* Get component arrays */
-    NexusAudioSourceComponent* sources = ecs_field(it, NexusAudioSourceComponent, 1);
-    NexusTransformComponent* transforms = ecs_field(it, NexusTransformComponent, 2);
+    NexusAudioSourceComponent* sources = ecs_field(it, NexusAudioSourceComponent, 0);
+    NexusTransformComponent* transforms = ecs_field(it, NexusTransformComponent, 1);
 
     /* Static counter to limit debug output frequency */
     static int debug_counter = 0;
     if (debug_counter++ % 300 == 0) {
-        printf("Audio system processing %d entities\n", it->count);
+        NEXUS_LOG_DEBUG(nexus_engine_get_logger(), NEXUS_LOG_CATEGORY_ECS,
+                        "Audio system processing %d entities", it->count);
     }
 
     /* Get global audio subsystem */
@@ -490,13 +944,7 @@ void nexus_audio_system(ecs_iter_t* it) {
  */
 void nexus_animation_system(ecs_iter_t* it) {
     /* Get transform components */
-    NexusTransformComponent* transforms = ecs_field(it, NexusTransformComponent, 1);
-
-    /* Static counter to limit debug output frequency */
-    static int debug_counter = 0;
-    if (debug_counter++ % 300 == 0) {
-        printf("Animation system processing %d entities\n", it->count);
-    }
+    NexusTransformComponent* transforms = ecs_field(it, NexusTransformComponent, 0);
 
     /* In a real implementation, this would update skeletal animations,
      * blend animations, and apply results to transforms */
@@ -505,3 +953,37 @@ void nexus_animation_system(ecs_iter_t* it) {
         /* For now, the system is a placeholder */
     }
 }
+
+#ifdef NEXUS_PROFILE
+/**
+ * Run callback of profiled systems, forwards each table to the system callback
+ */
+static void nexus_ecs_profile_system_run(ecs_iter_t* it) {
+    NEXUS_PROFILE_BEGIN((const char*)it->run_ctx);
+    while (ecs_iter_next(it)) {
+        it->callback(it);
+    }
+    NEXUS_PROFILE_END();
+}
+
+/**
+ * Phase marker, closes the previous phase's scope and opens its own
+ */
+static void nexus_ecs_profile_phase(ecs_iter_t* it) {
+    if (nexus_ecs_phase_scope_open) {
+        NEXUS_PROFILE_END();
+    }
+    NEXUS_PROFILE_BEGIN((const char*)it->ctx);
+    nexus_ecs_phase_scope_open = true;
+}
+
+/**
+ * Close the scope of the last phase, called after ecs_progress
+ */
+void nexus_ecs_profile_end_phase(void) {
+    if (nexus_ecs_phase_scope_open) {
+        NEXUS_PROFILE_END();
+        nexus_ecs_phase_scope_open = false;
+    }
+}
+#endif
@@ -9,6 +9,37 @@
 #include <string.h>
 #include <math.h>
 
+/* Hash an action name (FNV-1a) */
+static uint32_t nexus_input_hash_name(const char* name) {
+    uint32_t hash = 0x811C9DC5u;
+    for (const char* c = name; *c != '\0'; c++) {
+        hash ^= (uint8_t)*c;
+        hash *= 0x01000193u;
+    }
+    return hash;
+}
+
+/* Set the bits of the actions bound to an input code */
+static void nexus_input_mark_bindings(const NexusInputBinding* bindings, int count, uint16_t code, uint64_t* bits) {
+    for (int i = 0; i < count; i++) {
+        if (bindings[i].code == code) {
+            bits[bindings[i].action >> 6] |= 1ull << (bindings[i].action & 63);
+        }
+    }
+}
+
+/* Translate an SDL mouse button (NEXUS_MOUSE_BUTTON_COUNT = not tracked) */
+static NexusMouseButton nexus_input_translate_mouse_button(Uint8 button) {
+    switch (button) {
+        case SDL_BUTTON_LEFT: return NEXUS_MOUSE_BUTTON_LEFT;
+        case SDL_BUTTON_RIGHT: return NEXUS_MOUSE_BUTTON_RIGHT;
+        case SDL_BUTTON_MIDDLE: return NEXUS_MOUSE_BUTTON_MIDDLE;
+        case SDL_BUTTON_X1: return NEXUS_MOUSE_BUTTON_X1;
+        case SDL_BUTTON_X2: return NEXUS_MOUSE_BUTTON_X2;
+        default: return NEXUS_MOUSE_BUTTON_COUNT;
+    }
+}
+
 /* Input system structure creation */
 NexusInput* nexus_input_create(void) {
     /* Allocate input structure */
@@ -29,9 +60,6 @@ NexusInput* nexus_input_create(void) {
     input->touch_enabled = true;
     input->input_deadzone = 0.1f; /* 10% deadzone */
     
-    /* Initialize action map */
-    memset(input->action_map, 0, sizeof(input->action_map));
-    
     printf("Input system created\n");
     
     return input;
@@ -70,6 +98,8 @@ void nexus_input_process_event(NexusInput* input, const SDL_Event* event) {
             if (input->keyboard_enabled && event->key.repeat == 0) {
                 input->keys_pressed[event->key.scancode] = true;
                 input->keys_down[event->key.scancode] = true;
+                nexus_input_mark_bindings(input->key_bindings, input->key_binding_count,
+                                          (uint16_t)event->key.scancode, input->event_pressed);
             }
             break;
             
@@ -77,6 +107,8 @@ void nexus_input_process_event(NexusInput* input, const SDL_Event* event) {
             if (input->keyboard_enabled) {
                 input->keys_released[event->key.scancode] = true;
                 input->keys_down[event->key.scancode] = false;
+                nexus_input_mark_bindings(input->key_bindings, input->key_binding_count,
+                                          (uint16_t)event->key.scancode, input->event_released);
             }
             break;
             
@@ -114,6 +146,9 @@ void nexus_input_process_event(NexusInput* input, const SDL_Event* event) {
                         input->mouse_buttons[NEXUS_MOUSE_BUTTON_X2] = true;
                         break;
                 }
+                nexus_input_mark_bindings(input->mouse_bindings, input->mouse_binding_count,
+                                          (uint16_t)nexus_input_translate_mouse_button(event->button.button),
+                                          input->event_pressed);
             }
             break;
             
@@ -141,6 +176,9 @@ void nexus_input_process_event(NexusInput* input, const SDL_Event* event) {
                         input->mouse_buttons[NEXUS_MOUSE_BUTTON_X2] = false;
                         break;
                 }
+                nexus_input_mark_bindings(input->mouse_bindings, input->mouse_binding_count,
+                                          (uint16_t)nexus_input_translate_mouse_button(event->button.button),
+                                          input->event_released);
             }
             break;
             
@@ -210,6 +248,8 @@ void nexus_input_process_event(NexusInput* input, const SDL_Event* event) {
                 
                 input->gamepad_buttons_pressed[event->gbutton.which][event->gbutton.button] = true;
                 input->gamepad_buttons[event->gbutton.which][event->gbutton.button] = true;
+                nexus_input_mark_bindings(input->gamepad_button_bindings, input->gamepad_button_binding_count,
+                                          (uint16_t)event->gbutton.button, input->event_pressed);
             }
             break;
             
@@ -220,6 +260,8 @@ void nexus_input_process_event(NexusInput* input, const SDL_Event* event) {
                 
                 input->gamepad_buttons_released[event->gbutton.which][event->gbutton.button] = true;
                 input->gamepad_buttons[event->gbutton.which][event->gbutton.button] = false;
+                nexus_input_mark_bindings(input->gamepad_button_bindings, input->gamepad_button_binding_count,
+                                          (uint16_t)event->gbutton.button, input->event_released);
             }
             break;
             
@@ -231,12 +273,84 @@ void nexus_input_process_event(NexusInput* input, const SDL_Event* event) {
     }
 }
 
+/* Process a batch of SDL events */
+void nexus_input_process_events(NexusInput* input, const SDL_Event* events, int count) {
+    if (input == NULL || events == NULL) {
+        return;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        nexus_input_process_event(input, &events[i]);
+    }
+}
+
+/* Evaluate every action from the current device state and the events since the last update */
+static void nexus_input_evaluate_actions(NexusInput* input) {
+    memcpy(input->actions_prev, input->actions_down, sizeof(input->actions_prev));
+    memset(input->actions_down, 0, sizeof(input->actions_down));
+    memset(input->action_values, 0, sizeof(float) * (size_t)input->action_count);
+    
+    /* Digital bindings are held at full value */
+    for (int i = 0; i < input->key_binding_count; i++) {
+        const NexusInputBinding* binding = &input->key_bindings[i];
+        if (input->keys_down[binding->code]) {
+            input->actions_down[binding->action >> 6] |= 1ull << (binding->action & 63);
+            input->action_values[binding->action] = 1.0f;
+        }
+    }
+    for (int i = 0; i < input->mouse_binding_count; i++) {
+        const NexusInputBinding* binding = &input->mouse_bindings[i];
+        if (input->mouse_buttons[binding->code]) {
+            input->actions_down[binding->action >> 6] |= 1ull << (binding->action & 63);
+            input->action_values[binding->action] = 1.0f;
+        }
+    }
+    
+    /* Gamepad bindings apply to every connected gamepad */
+    for (int g = 0; g < NEXUS_MAX_GAMEPADS; g++) {
+        if (!input->gamepad_connected[g]) {
+            continue;
+        }
+        
+        for (int i = 0; i < input->gamepad_button_binding_count; i++) {
+            const NexusInputBinding* binding = &input->gamepad_button_bindings[i];
+            if (input->gamepad_buttons[g][binding->code]) {
+                input->actions_down[binding->action >> 6] |= 1ull << (binding->action & 63);
+                input->action_values[binding->action] = 1.0f;
+            }
+        }
+        
+        /* Axes keep the strongest value, and count as down past the press threshold */
+        for (int i = 0; i < input->gamepad_axis_binding_count; i++) {
+            const NexusInputBinding* binding = &input->gamepad_axis_bindings[i];
+            float value = input->gamepad_axes[g][binding->code] * binding->scale;
+            if (fabsf(value) > fabsf(input->action_values[binding->action])) {
+                input->action_values[binding->action] = value;
+            }
+            if (value >= NEXUS_INPUT_AXIS_PRESS_THRESHOLD) {
+                input->actions_down[binding->action >> 6] |= 1ull << (binding->action & 63);
+            }
+        }
+    }
+    
+    /* Edges from the held state, plus presses and releases that happened within the frame */
+    for (int w = 0; w < NEXUS_INPUT_ACTION_WORDS; w++) {
+        input->actions_pressed[w] = input->event_pressed[w] | (input->actions_down[w] & ~input->actions_prev[w]);
+        input->actions_released[w] = input->event_released[w] | (input->actions_prev[w] & ~input->actions_down[w]);
+    }
+    memset(input->event_pressed, 0, sizeof(input->event_pressed));
+    memset(input->event_released, 0, sizeof(input->event_released));
+}
+
 /* Update input system */
 void nexus_input_update(NexusInput* input) {
     if (input == NULL) {
         return;
     }
     
+    /* Evaluate actions once, queries only test bits */
+    nexus_input_evaluate_actions(input);
+    
     /* Store previous key states */
     memcpy(input->keys_prev, input->keys_down, sizeof(input->keys_prev));
     
@@ -297,6 +411,15 @@ void nexus_input_reset_states(NexusInput* input) {
         memset(input->gamepad_buttons_released[i], 0, sizeof(bool) * SDL_GAMEPAD_AXIS_COUNT);
         memset(input->gamepad_buttons_prev[i], 0, sizeof(bool) * SDL_GAMEPAD_AXIS_COUNT);
     }
+    
+    /* Reset action state */
+    memset(input->actions_down, 0, sizeof(input->actions_down));
+    memset(input->actions_pressed, 0, sizeof(input->actions_pressed));
+    memset(input->actions_released, 0, sizeof(input->actions_released));
+    memset(input->actions_prev, 0, sizeof(input->actions_prev));
+    memset(input->event_pressed, 0, sizeof(input->event_pressed));
+    memset(input->event_released, 0, sizeof(input->event_released));
+    memset(input->action_values, 0, sizeof(input->action_values));
 }
 
 /* --- Keyboard Functions --- */
@@ -630,62 +753,233 @@ const char* nexus_input_get_gamepad_name(const NexusInput* input, int gamepad_in
     return SDL_GetGamepadName(input->gamepads[gamepad_index]);
 }
 
-/* --- Action Mapping Functions --- */
+/* --- Action Functions --- */
 
-/* Map action to keyboard key */
-void nexus_input_map_action(NexusInput* input, const char* action_name, SDL_Scancode key) {
-    if (input == NULL || action_name == NULL || key < 0 || key >= SDL_SCANCODE_COUNT) {
-        return;
+/* Register an action, or get the handle of the action already registered under the name */
+NexusInputAction nexus_input_register_action(NexusInput* input, const char* action_name) {
+    if (input == NULL || action_name == NULL || action_name[0] == '\0') {
+        return NEXUS_INPUT_ACTION_INVALID;
     }
     
-    /* Find empty action slot or existing action with same name */
-    int slot = -1;
-    for (int i = 0; i < 256; i++) {
-        if (input->action_map[i][0] == '\0') {
-            /* Empty slot */
-            if (slot == -1) {
-                slot = i;
-            }
-        } else if (strcmp(input->action_map[i], action_name) == 0) {
-            /* Existing action */
-            slot = i;
-            break;
-        }
+    NexusInputAction action = nexus_input_find_action(input, action_name);
+    if (action != NEXUS_INPUT_ACTION_INVALID) {
+        return action;
     }
     
-    /* No slot found */
-    if (slot == -1) {
+    if (input->action_count >= NEXUS_MAX_INPUT_ACTIONS) {
         printf("Action map is full!\n");
-        return;
+        return NEXUS_INPUT_ACTION_INVALID;
     }
     
-    /* Store action name */
-    strncpy(input->action_map[slot], action_name, 31);
-    input->action_map[slot][31] = '\0';
+    /* Store the name and hash it into the first free slot */
+    action = (NexusInputAction)input->action_count++;
+    strncpy(input->action_names[action], action_name, NEXUS_INPUT_ACTION_NAME_LENGTH - 1);
+    input->action_names[action][NEXUS_INPUT_ACTION_NAME_LENGTH - 1] = '\0';
+    input->action_hashes[action] = nexus_input_hash_name(input->action_names[action]);
+    
+    uint32_t slot = input->action_hashes[action] & (NEXUS_INPUT_ACTION_TABLE_SIZE - 1);
+    while (input->action_table[slot] != 0) {
+        slot = (slot + 1) & (NEXUS_INPUT_ACTION_TABLE_SIZE - 1);
+    }
+    input->action_table[slot] = (uint16_t)(action + 1);
+    
+    return action;
 }
 
-/* Map action to mouse button */
-void nexus_input_map_action_to_mouse(NexusInput* input, const char* action_name, NexusMouseButton button) {
-    /* Implementation depends on how you want to store mouse button mappings */
-    /* This is a placeholder implementation */
-    if (input == NULL || action_name == NULL || button < 0 || button >= NEXUS_MOUSE_BUTTON_COUNT) {
-        return;
+/* Find the handle of an action by name */
+NexusInputAction nexus_input_find_action(const NexusInput* input, const char* action_name) {
+    if (input == NULL || action_name == NULL) {
+        return NEXUS_INPUT_ACTION_INVALID;
     }
     
-    /* For now, just print a message */
-    printf("Mapped action '%s' to mouse button %d\n", action_name, button);
+    /* Names are stored truncated, look them up the same way */
+    char name[NEXUS_INPUT_ACTION_NAME_LENGTH];
+    strncpy(name, action_name, sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    
+    uint32_t hash = nexus_input_hash_name(name);
+    uint32_t slot = hash & (NEXUS_INPUT_ACTION_TABLE_SIZE - 1);
+    while (input->action_table[slot] != 0) {
+        NexusInputAction action = (NexusInputAction)(input->action_table[slot] - 1);
+        if (input->action_hashes[action] == hash && strcmp(input->action_names[action], name) == 0) {
+            return action;
+        }
+        slot = (slot + 1) & (NEXUS_INPUT_ACTION_TABLE_SIZE - 1);
+    }
+    
+    return NEXUS_INPUT_ACTION_INVALID;
 }
 
-/* Map action to gamepad button */
-void nexus_input_map_action_to_gamepad(NexusInput* input, const char* action_name, SDL_GamepadButton button) {
-    /* Implementation depends on how you want to store gamepad button mappings */
-    /* This is a placeholder implementation */
-    if (input == NULL || action_name == NULL || button < 0 || button >= SDL_GAMEPAD_BUTTON_COUNT) {
+/* Get the name of an action */
+const char* nexus_input_get_action_name(const NexusInput* input, NexusInputAction action) {
+    if (input == NULL || action >= input->action_count) {
+        return NULL;
+    }
+    
+    return input->action_names[action];
+}
+
+/* Append a binding to a device's binding array */
+static bool nexus_input_add_binding(NexusInput* input, NexusInputBinding* bindings, int* count,
+                                    NexusInputAction action, uint16_t code, float scale) {
+    if (action >= input->action_count) {
+        return false;
+    }
+    
+    /* Binding the same input twice only updates its scale */
+    for (int i = 0; i < *count; i++) {
+        if (bindings[i].action == action && bindings[i].code == code) {
+            bindings[i].scale = scale;
+            return true;
+        }
+    }
+    
+    if (*count >= NEXUS_MAX_INPUT_BINDINGS) {
+        printf("Input binding array is full!\n");
+        return false;
+    }
+    
+    bindings[*count].code = code;
+    bindings[*count].action = action;
+    bindings[*count].scale = scale;
+    (*count)++;
+    return true;
+}
+
+/* Remove the bindings of an action from a device's binding array */
+static void nexus_input_remove_bindings(NexusInputBinding* bindings, int* count, NexusInputAction action) {
+    int kept = 0;
+    for (int i = 0; i < *count; i++) {
+        if (bindings[i].action != action) {
+            bindings[kept++] = bindings[i];
+        }
+    }
+    *count = kept;
+}
+
+/* Bind a keyboard key to an action */
+bool nexus_input_bind_key(NexusInput* input, NexusInputAction action, SDL_Scancode key) {
+    if (input == NULL || key < 0 || key >= SDL_SCANCODE_COUNT) {
+        return false;
+    }
+    
+    return nexus_input_add_binding(input, input->key_bindings, &input->key_binding_count,
+                                   action, (uint16_t)key, 1.0f);
+}
+
+/* Bind a mouse button to an action */
+bool nexus_input_bind_mouse_button(NexusInput* input, NexusInputAction action, NexusMouseButton button) {
+    if (input == NULL || button < 0 || button >= NEXUS_MOUSE_BUTTON_COUNT) {
+        return false;
+    }
+    
+    return nexus_input_add_binding(input, input->mouse_bindings, &input->mouse_binding_count,
+                                   action, (uint16_t)button, 1.0f);
+}
+
+/* Bind a gamepad button to an action */
+bool nexus_input_bind_gamepad_button(NexusInput* input, NexusInputAction action, SDL_GamepadButton button) {
+    if (input == NULL || button < 0 || button >= SDL_GAMEPAD_BUTTON_COUNT) {
+        return false;
+    }
+    
+    return nexus_input_add_binding(input, input->gamepad_button_bindings, &input->gamepad_button_binding_count,
+                                   action, (uint16_t)button, 1.0f);
+}
+
+/* Bind a gamepad axis to an action (scale -1 binds the negative direction) */
+bool nexus_input_bind_gamepad_axis(NexusInput* input, NexusInputAction action, SDL_GamepadAxis axis, float scale) {
+    if (input == NULL || axis < 0 || axis >= SDL_GAMEPAD_AXIS_COUNT) {
+        return false;
+    }
+    
+    return nexus_input_add_binding(input, input->gamepad_axis_bindings, &input->gamepad_axis_binding_count,
+                                   action, (uint16_t)axis, scale);
+}
+
+/* Remove every binding of an action */
+void nexus_input_clear_bindings(NexusInput* input, NexusInputAction action) {
+    if (input == NULL) {
         return;
     }
     
-    /* For now, just print a message */
-    printf("Mapped action '%s' to gamepad button %d\n", action_name, button);
+    nexus_input_remove_bindings(input->key_bindings, &input->key_binding_count, action);
+    nexus_input_remove_bindings(input->mouse_bindings, &input->mouse_binding_count, action);
+    nexus_input_remove_bindings(input->gamepad_button_bindings, &input->gamepad_button_binding_count, action);
+    nexus_input_remove_bindings(input->gamepad_axis_bindings, &input->gamepad_axis_binding_count, action);
+}
+
+/* Check if an action is held */
+bool nexus_input_action_is_down(const NexusInput* input, NexusInputAction action) {
+    if (input == NULL || action >= NEXUS_MAX_INPUT_ACTIONS) {
+        return false;
+    }
+    
+    return (input->actions_down[action >> 6] >> (action & 63)) & 1u;
+}
+
+/* Check if an action was pressed this frame */
+bool nexus_input_action_is_pressed(const NexusInput* input, NexusInputAction action) {
+    if (input == NULL || action >= NEXUS_MAX_INPUT_ACTIONS) {
+        return false;
+    }
+    
+    return (input->actions_pressed[action >> 6] >> (action & 63)) & 1u;
+}
+
+/* Check if an action was released this frame */
+bool nexus_input_action_is_released(const NexusInput* input, NexusInputAction action) {
+    if (input == NULL || action >= NEXUS_MAX_INPUT_ACTIONS) {
+        return false;
+    }
+    
+    return (input->actions_released[action >> 6] >> (action & 63)) & 1u;
+}
+
+/* Get the analog value of an action (1 for held digital bindings, the strongest scaled axis otherwise) */
+float nexus_input_action_get_value(const NexusInput* input, NexusInputAction action) {
+    if (input == NULL || action >= NEXUS_MAX_INPUT_ACTIONS) {
+        return 0.0f;
+    }
+    
+    return input->action_values[action];
+}
+
+/* --- Action Mapping Functions --- */
+
+/* Map action to keyboard key */
+void nexus_input_map_action(NexusInput* input, const char* action_name, SDL_Scancode key) {
+    nexus_input_bind_key(input, nexus_input_register_action(input, action_name), key);
+}
+
+/* Map action to mouse button */
+void nexus_input_map_action_to_mouse(NexusInput* input, const char* action_name, NexusMouseButton button) {
+    nexus_input_bind_mouse_button(input, nexus_input_register_action(input, action_name), button);
+}
+
+/* Map action to gamepad button */
+void nexus_input_map_action_to_gamepad(NexusInput* input, const char* action_name, SDL_GamepadButton button) {
+    nexus_input_bind_gamepad_button(input, nexus_input_register_action(input, action_name), button);
+}
+
+/* Check if action was pressed this frame (hashed lookup, prefer the handle functions in hot code) */
+bool nexus_input_is_action_pressed(NexusInput* input, const char* action_name) {
+    return nexus_input_action_is_pressed(input, nexus_input_find_action(input, action_name));
+}
+
+/* Check if action was released this frame */
+bool nexus_input_is_action_released(NexusInput* input, const char* action_name) {
+    return nexus_input_action_is_released(input, nexus_input_find_action(input, action_name));
+}
+
+/* Check if action is held */
+bool nexus_input_is_action_down(NexusInput* input, const char* action_name) {
+    return nexus_input_action_is_down(input, nexus_input_find_action(input, action_name));
+}
+
+/* Get action analog value */
+float nexus_input_get_action_value(NexusInput* input, const char* action_name) {
+    return nexus_input_action_get_value(input, nexus_input_find_action(input, action_name));
 }
 
 /* Set deadzone for analog inputs */
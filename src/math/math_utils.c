@@ -114,7 +114,7 @@ void nexus_quat_slerp(const versor q1, const versor q2, float t, versor result)
 }
 
 /* Compute a frustum from view-projection matrix */
-void nexus_frustum_from_viewproj(const mat4 view_proj, vec4 planes[6]) {
+void nexus_frustum_from_viewproj(mat4 view_proj, vec4 planes[6]) {
     /* Extract planes from view-projection matrix */
     /* Left plane */
     planes[0][0] = view_proj[0][3] + view_proj[0][0];
@@ -212,6 +212,25 @@ bool nexus_frustum_contains_aabb(const vec4 planes[6], const vec3 min_point, con
     return true; /* AABB is at least partially inside the frustum */
 }
 
+/* Transform an AABB by a matrix and return the enclosing AABB (Arvo's method) */
+void nexus_aabb_transform(mat4 m, const vec3 min_point, const vec3 max_point, vec3 out_min, vec3 out_max) {
+    /* Start from the translation */
+    for (int i = 0; i < 3; i++) {
+        out_min[i] = m[3][i];
+        out_max[i] = m[3][i];
+    }
+
+    /* Add the extreme contribution of each basis axis */
+    for (int j = 0; j < 3; j++) {
+        for (int i = 0; i < 3; i++) {
+            float a = m[j][i] * min_point[j];
+            float b = m[j][i] * max_point[j];
+            out_min[i] += a < b ? a : b;
+            out_max[i] += a < b ? b : a;
+        }
+    }
+}
+
 /* Catmull-Rom spline interpolation */
 void nexus_catmull_rom(const vec3 p0, const vec3 p1, const vec3 p2, const vec3 p3, float t, vec3 result) {
     float t2 = t * t;
@@ -0,0 +1,404 @@
+/**
+ * Nexus3D Batch Transforms Implementation
+ * Builds M = T * R * S directly from the quaternion, the kernel is picked at runtime
+ */
+
+#include "nexus3d/math/transform_batch.h"
+#include <SDL3/SDL.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <immintrin.h>
+#define NEXUS_TRS_HAS_SSE 1
+#if defined(__AVX2__) || defined(__GNUC__) || defined(__clang__)
+#define NEXUS_TRS_HAS_AVX2 1
+#endif
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define NEXUS_TRS_HAS_NEON 1
+#endif
+
+/* AVX2 is compiled per function so the rest of the library keeps the baseline ISA */
+#if defined(NEXUS_TRS_HAS_AVX2) && !defined(__AVX2__)
+#define NEXUS_TRS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define NEXUS_TRS_TARGET_AVX2
+#endif
+
+/* Element access through byte strides */
+#define NEXUS_TRS_AT(base, stride, index) \
+    ((const float*)((const uint8_t*)(base) + (size_t)(index) * (stride)))
+#define NEXUS_TRS_OUT(base, stride, index) \
+    ((float*)((uint8_t*)(base) + (size_t)(index) * (stride)))
+
+/* Kernel used by nexus_trs_compose_batch */
+static NexusTRSKernel s_trs_kernel = NULL;
+static const char* s_trs_kernel_name = "scalar";
+
+/**
+ * Compose one matrix
+ */
+static void nexus_trs_compose_one(const float* p, const float* q, const float* s, float* m) {
+    /* 2 / |q|^2 keeps non-unit quaternions a pure rotation */
+    float n = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+    float k = n > 0.0f ? 2.0f / n : 0.0f;
+
+    float xs = q[0] * k, ys = q[1] * k, zs = q[2] * k;
+    float xx = q[0] * xs, yy = q[1] * ys, zz = q[2] * zs;
+    float xy = q[0] * ys, xz = q[0] * zs, yz = q[1] * zs;
+    float wx = q[3] * xs, wy = q[3] * ys, wz = q[3] * zs;
+
+    /* Rotation columns scaled per axis */
+    m[0]  = (1.0f - (yy + zz)) * s[0];
+    m[1]  = (xy + wz) * s[0];
+    m[2]  = (xz - wy) * s[0];
+    m[3]  = 0.0f;
+    m[4]  = (xy - wz) * s[1];
+    m[5]  = (1.0f - (xx + zz)) * s[1];
+    m[6]  = (yz + wx) * s[1];
+    m[7]  = 0.0f;
+    m[8]  = (xz + wy) * s[2];
+    m[9]  = (yz - wx) * s[2];
+    m[10] = (1.0f - (xx + yy)) * s[2];
+    m[11] = 0.0f;
+
+    /* Translation */
+    m[12] = p[0];
+    m[13] = p[1];
+    m[14] = p[2];
+    m[15] = 1.0f;
+}
+
+/**
+ * Scalar kernel (also handles the tails of the SIMD kernels)
+ */
+void nexus_trs_compose_scalar(const NexusTRSBatch* batch, int count) {
+    for (int i = 0; i < count; i++) {
+        nexus_trs_compose_one(NEXUS_TRS_AT(batch->positions, batch->position_stride, i),
+                              NEXUS_TRS_AT(batch->rotations, batch->rotation_stride, i),
+                              NEXUS_TRS_AT(batch->scales, batch->scale_stride, i),
+                              NEXUS_TRS_OUT(batch->matrices, batch->matrix_stride, i));
+    }
+}
+
+/**
+ * Offset a batch by a number of elements
+ */
+static NexusTRSBatch nexus_trs_batch_offset(const NexusTRSBatch* batch, int offset) {
+    NexusTRSBatch tail = *batch;
+    tail.positions = NEXUS_TRS_AT(batch->positions, batch->position_stride, offset);
+    tail.rotations = NEXUS_TRS_AT(batch->rotations, batch->rotation_stride, offset);
+    tail.scales = NEXUS_TRS_AT(batch->scales, batch->scale_stride, offset);
+    tail.matrices = NEXUS_TRS_OUT(batch->matrices, batch->matrix_stride, offset);
+    return tail;
+}
+
+#if defined(NEXUS_TRS_HAS_SSE)
+/**
+ * Compose four matrices from lane-per-element vectors and store them
+ */
+static inline void nexus_trs_sse_store(const NexusTRSBatch* batch, int base,
+                                       __m128 qx, __m128 qy, __m128 qz, __m128 qw,
+                                       __m128 px, __m128 py, __m128 pz,
+                                       __m128 sx, __m128 sy, __m128 sz) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    /* 2 / |q|^2, zero for degenerate quaternions */
+    __m128 n = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy)),
+                          _mm_add_ps(_mm_mul_ps(qz, qz), _mm_mul_ps(qw, qw)));
+    __m128 k = _mm_and_ps(_mm_div_ps(_mm_set1_ps(2.0f), n), _mm_cmpgt_ps(n, zero));
+
+    __m128 xs = _mm_mul_ps(qx, k), ys = _mm_mul_ps(qy, k), zs = _mm_mul_ps(qz, k);
+    __m128 xx = _mm_mul_ps(qx, xs), yy = _mm_mul_ps(qy, ys), zz = _mm_mul_ps(qz, zs);
+    __m128 xy = _mm_mul_ps(qx, ys), xz = _mm_mul_ps(qx, zs), yz = _mm_mul_ps(qy, zs);
+    __m128 wx = _mm_mul_ps(qw, xs), wy = _mm_mul_ps(qw, ys), wz = _mm_mul_ps(qw, zs);
+
+    /* Columns as rows of a 4x4 block, transposed into one column per element */
+    __m128 c[4][4] = {
+        { _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx),
+          _mm_mul_ps(_mm_add_ps(xy, wz), sx),
+          _mm_mul_ps(_mm_sub_ps(xz, wy), sx), zero },
+        { _mm_mul_ps(_mm_sub_ps(xy, wz), sy),
+          _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy),
+          _mm_mul_ps(_mm_add_ps(yz, wx), sy), zero },
+        { _mm_mul_ps(_mm_add_ps(xz, wy), sz),
+          _mm_mul_ps(_mm_sub_ps(yz, wx), sz),
+          _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz), zero },
+        { px, py, pz, one }
+    };
+
+    for (int column = 0; column < 4; column++) {
+        _MM_TRANSPOSE4_PS(c[column][0], c[column][1], c[column][2], c[column][3]);
+        for (int lane = 0; lane < 4; lane++) {
+            float* m = NEXUS_TRS_OUT(batch->matrices, batch->matrix_stride, base + lane);
+            _mm_storeu_ps(m + column * 4, c[column][lane]);
+        }
+    }
+}
+
+/**
+ * Gather one float of four elements
+ */
+#define NEXUS_TRS_SSE_GATHER(base, stride, index, component) \
+    _mm_setr_ps(NEXUS_TRS_AT(base, stride, (index) + 0)[component], \
+                NEXUS_TRS_AT(base, stride, (index) + 1)[component], \
+                NEXUS_TRS_AT(base, stride, (index) + 2)[component], \
+                NEXUS_TRS_AT(base, stride, (index) + 3)[component])
+
+/**
+ * SSE kernel, four elements per iteration
+ */
+static void nexus_trs_compose_sse(const NexusTRSBatch* batch, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        /* Quaternions are whole vectors, transpose them into lanes */
+        __m128 qx = _mm_loadu_ps(NEXUS_TRS_AT(batch->rotations, batch->rotation_stride, i + 0));
+        __m128 qy = _mm_loadu_ps(NEXUS_TRS_AT(batch->rotations, batch->rotation_stride, i + 1));
+        __m128 qz = _mm_loadu_ps(NEXUS_TRS_AT(batch->rotations, batch->rotation_stride, i + 2));
+        __m128 qw = _mm_loadu_ps(NEXUS_TRS_AT(batch->rotations, batch->rotation_stride, i + 3));
+        _MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+
+        /* Three float vectors are gathered so the last element is never over-read */
+        nexus_trs_sse_store(batch, i, qx, qy, qz, qw,
+                            NEXUS_TRS_SSE_GATHER(batch->positions, batch->position_stride, i, 0),
+                            NEXUS_TRS_SSE_GATHER(batch->positions, batch->position_stride, i, 1),
+                            NEXUS_TRS_SSE_GATHER(batch->positions, batch->position_stride, i, 2),
+                            NEXUS_TRS_SSE_GATHER(batch->scales, batch->scale_stride, i, 0),
+                            NEXUS_TRS_SSE_GATHER(batch->scales, batch->scale_stride, i, 1),
+                            NEXUS_TRS_SSE_GATHER(batch->scales, batch->scale_stride, i, 2));
+    }
+
+    /* Tail */
+    if (i < count) {
+        NexusTRSBatch tail = nexus_trs_batch_offset(batch, i);
+        nexus_trs_compose_scalar(&tail, count - i);
+    }
+}
+#endif
+
+#if defined(NEXUS_TRS_HAS_AVX2)
+/**
+ * AVX2 kernel, eight elements per iteration with hardware gathers
+ * Strides have to be multiples of 4 bytes (true for any float component)
+ */
+NEXUS_TRS_TARGET_AVX2
+static void nexus_trs_compose_avx2(const NexusTRSBatch* batch, int count) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i p_index = _mm256_mullo_epi32(lanes, _mm256_set1_epi32((int)(batch->position_stride / 4)));
+    const __m256i q_index = _mm256_mullo_epi32(lanes, _mm256_set1_epi32((int)(batch->rotation_stride / 4)));
+    const __m256i s_index = _mm256_mullo_epi32(lanes, _mm256_set1_epi32((int)(batch->scale_stride / 4)));
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const float* p = NEXUS_TRS_AT(batch->positions, batch->position_stride, i);
+        const float* q = NEXUS_TRS_AT(batch->rotations, batch->rotation_stride, i);
+        const float* s = NEXUS_TRS_AT(batch->scales, batch->scale_stride, i);
+
+        __m256 qx = _mm256_i32gather_ps(q + 0, q_index, 4);
+        __m256 qy = _mm256_i32gather_ps(q + 1, q_index, 4);
+        __m256 qz = _mm256_i32gather_ps(q + 2, q_index, 4);
+        __m256 qw = _mm256_i32gather_ps(q + 3, q_index, 4);
+        __m256 sx = _mm256_i32gather_ps(s + 0, s_index, 4);
+        __m256 sy = _mm256_i32gather_ps(s + 1, s_index, 4);
+        __m256 sz = _mm256_i32gather_ps(s + 2, s_index, 4);
+
+        /* 2 / |q|^2, zero for degenerate quaternions */
+        __m256 n = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(qx, qx), _mm256_mul_ps(qy, qy)),
+                                 _mm256_add_ps(_mm256_mul_ps(qz, qz), _mm256_mul_ps(qw, qw)));
+        __m256 k = _mm256_and_ps(_mm256_div_ps(_mm256_set1_ps(2.0f), n), _mm256_cmp_ps(n, zero, _CMP_GT_OQ));
+
+        __m256 xs = _mm256_mul_ps(qx, k), ys = _mm256_mul_ps(qy, k), zs = _mm256_mul_ps(qz, k);
+        __m256 xx = _mm256_mul_ps(qx, xs), yy = _mm256_mul_ps(qy, ys), zz = _mm256_mul_ps(qz, zs);
+        __m256 xy = _mm256_mul_ps(qx, ys), xz = _mm256_mul_ps(qx, zs), yz = _mm256_mul_ps(qy, zs);
+        __m256 wx = _mm256_mul_ps(qw, xs), wy = _mm256_mul_ps(qw, ys), wz = _mm256_mul_ps(qw, zs);
+
+        __m256 c[4][4] = {
+            { _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(yy, zz)), sx),
+              _mm256_mul_ps(_mm256_add_ps(xy, wz), sx),
+              _mm256_mul_ps(_mm256_sub_ps(xz, wy), sx), zero },
+            { _mm256_mul_ps(_mm256_sub_ps(xy, wz), sy),
+              _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, zz)), sy),
+              _mm256_mul_ps(_mm256_add_ps(yz, wx), sy), zero },
+            { _mm256_mul_ps(_mm256_add_ps(xz, wy), sz),
+              _mm256_mul_ps(_mm256_sub_ps(yz, wx), sz),
+              _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, yy)), sz), zero },
+            { _mm256_i32gather_ps(p + 0, p_index, 4),
+              _mm256_i32gather_ps(p + 1, p_index, 4),
+              _mm256_i32gather_ps(p + 2, p_index, 4), one }
+        };
+
+        /* Transpose each 128-bit half into one column per element */
+        for (int column = 0; column < 4; column++) {
+            for (int half = 0; half < 2; half++) {
+                __m128 r0 = half ? _mm256_extractf128_ps(c[column][0], 1) : _mm256_castps256_ps128(c[column][0]);
+                __m128 r1 = half ? _mm256_extractf128_ps(c[column][1], 1) : _mm256_castps256_ps128(c[column][1]);
+                __m128 r2 = half ? _mm256_extractf128_ps(c[column][2], 1) : _mm256_castps256_ps128(c[column][2]);
+                __m128 r3 = half ? _mm256_extractf128_ps(c[column][3], 1) : _mm256_castps256_ps128(c[column][3]);
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+                int base = i + half * 4;
+                _mm_storeu_ps(NEXUS_TRS_OUT(batch->matrices, batch->matrix_stride, base + 0) + column * 4, r0);
+                _mm_storeu_ps(NEXUS_TRS_OUT(batch->matrices, batch->matrix_stride, base + 1) + column * 4, r1);
+                _mm_storeu_ps(NEXUS_TRS_OUT(batch->matrices, batch->matrix_stride, base + 2) + column * 4, r2);
+                _mm_storeu_ps(NEXUS_TRS_OUT(batch->matrices, batch->matrix_stride, base + 3) + column * 4, r3);
+            }
+        }
+    }
+
+    /* Tail */
+    if (i < count) {
+        NexusTRSBatch tail = nexus_trs_batch_offset(batch, i);
+        nexus_trs_compose_scalar(&tail, count - i);
+    }
+}
+#endif
+
+#if defined(NEXUS_TRS_HAS_NEON)
+/**
+ * Transpose a 4x4 block held in four vectors
+ */
+static inline void nexus_trs_neon_transpose(float32x4_t* r0, float32x4_t* r1, float32x4_t* r2, float32x4_t* r3) {
+    float32x4x2_t t01 = vtrnq_f32(*r0, *r1);
+    float32x4x2_t t23 = vtrnq_f32(*r2, *r3);
+    *r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    *r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    *r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    *r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+/**
+ * Gather one float of four elements
+ */
+static inline float32x4_t nexus_trs_neon_gather(const float* base, size_t stride, int index, int component) {
+    float values[4];
+    for (int lane = 0; lane < 4; lane++) {
+        values[lane] = NEXUS_TRS_AT(base, stride, index + lane)[component];
+    }
+    return vld1q_f32(values);
+}
+
+/**
+ * NEON kernel, four elements per iteration
+ */
+static void nexus_trs_compose_neon(const NexusTRSBatch* batch, int count) {
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t two = vdupq_n_f32(2.0f);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t qx = vld1q_f32(NEXUS_TRS_AT(batch->rotations, batch->rotation_stride, i + 0));
+        float32x4_t qy = vld1q_f32(NEXUS_TRS_AT(batch->rotations, batch->rotation_stride, i + 1));
+        float32x4_t qz = vld1q_f32(NEXUS_TRS_AT(batch->rotations, batch->rotation_stride, i + 2));
+        float32x4_t qw = vld1q_f32(NEXUS_TRS_AT(batch->rotations, batch->rotation_stride, i + 3));
+        nexus_trs_neon_transpose(&qx, &qy, &qz, &qw);
+
+        float32x4_t sx = nexus_trs_neon_gather(batch->scales, batch->scale_stride, i, 0);
+        float32x4_t sy = nexus_trs_neon_gather(batch->scales, batch->scale_stride, i, 1);
+        float32x4_t sz = nexus_trs_neon_gather(batch->scales, batch->scale_stride, i, 2);
+
+        /* 2 / |q|^2 via reciprocal estimate and two Newton steps, zero for degenerate quaternions */
+        float32x4_t n = vaddq_f32(vaddq_f32(vmulq_f32(qx, qx), vmulq_f32(qy, qy)),
+                                  vaddq_f32(vmulq_f32(qz, qz), vmulq_f32(qw, qw)));
+        float32x4_t r = vrecpeq_f32(n);
+        r = vmulq_f32(r, vrecpsq_f32(n, r));
+        r = vmulq_f32(r, vrecpsq_f32(n, r));
+        float32x4_t k = vbslq_f32(vcgtq_f32(n, zero), vmulq_f32(two, r), zero);
+
+        float32x4_t xs = vmulq_f32(qx, k), ys = vmulq_f32(qy, k), zs = vmulq_f32(qz, k);
+        float32x4_t xx = vmulq_f32(qx, xs), yy = vmulq_f32(qy, ys), zz = vmulq_f32(qz, zs);
+        float32x4_t xy = vmulq_f32(qx, ys), xz = vmulq_f32(qx, zs), yz = vmulq_f32(qy, zs);
+        float32x4_t wx = vmulq_f32(qw, xs), wy = vmulq_f32(qw, ys), wz = vmulq_f32(qw, zs);
+
+        float32x4_t c[4][4] = {
+            { vmulq_f32(vsubq_f32(one, vaddq_f32(yy, zz)), sx),
+              vmulq_f32(vaddq_f32(xy, wz), sx),
+              vmulq_f32(vsubq_f32(xz, wy), sx), zero },
+            { vmulq_f32(vsubq_f32(xy, wz), sy),
+              vmulq_f32(vsubq_f32(one, vaddq_f32(xx, zz)), sy),
+              vmulq_f32(vaddq_f32(yz, wx), sy), zero },
+            { vmulq_f32(vaddq_f32(xz, wy), sz),
+              vmulq_f32(vsubq_f32(yz, wx), sz),
+              vmulq_f32(vsubq_f32(one, vaddq_f32(xx, yy)), sz), zero },
+            { nexus_trs_neon_gather(batch->positions, batch->position_stride, i, 0),
+              nexus_trs_neon_gather(batch->positions, batch->position_stride, i, 1),
+              nexus_trs_neon_gather(batch->positions, batch->position_stride, i, 2), one }
+        };
+
+        for (int column = 0; column < 4; column++) {
+            nexus_trs_neon_transpose(&c[column][0], &c[column][1], &c[column][2], &c[column][3]);
+            for (int lane = 0; lane < 4; lane++) {
+                float* m = NEXUS_TRS_OUT(batch->matrices, batch->matrix_stride, i + lane);
+                vst1q_f32(m + column * 4, c[column][lane]);
+            }
+        }
+    }
+
+    /* Tail */
+    if (i < count) {
+        NexusTRSBatch tail = nexus_trs_batch_offset(batch, i);
+        nexus_trs_compose_scalar(&tail, count - i);
+    }
+}
+#endif
+
+/**
+ * Pick the widest kernel the CPU supports
+ * Call once from the main thread before systems run on workers
+ */
+void nexus_trs_select_kernel(void) {
+    NexusTRSKernel kernel = nexus_trs_compose_scalar;
+    const char* name = "scalar";
+
+#if defined(NEXUS_TRS_HAS_AVX2)
+    if (SDL_HasAVX2()) {
+        kernel = nexus_trs_compose_avx2;
+        name = "avx2";
+    } else
+#endif
+#if defined(NEXUS_TRS_HAS_SSE)
+    if (SDL_HasSSE()) {
+        kernel = nexus_trs_compose_sse;
+        name = "sse";
+    }
+#endif
+#if defined(NEXUS_TRS_HAS_NEON)
+    if (SDL_HasNEON()) {
+        kernel = nexus_trs_compose_neon;
+        name = "neon";
+    }
+#endif
+
+    s_trs_kernel = kernel;
+    s_trs_kernel_name = name;
+}
+
+/**
+ * Get the name of the selected kernel
+ */
+const char* nexus_trs_get_kernel_name(void) {
+    if (s_trs_kernel == NULL) {
+        nexus_trs_select_kernel();
+    }
+
+    return s_trs_kernel_name;
+}
+
+/**
+ * Compose affine matrices for a batch with the selected kernel
+ */
+void nexus_trs_compose_batch(const NexusTRSBatch* batch, int count) {
+    if (batch == NULL || count <= 0) {
+        return;
+    }
+
+    if (s_trs_kernel == NULL) {
+        nexus_trs_select_kernel();
+    }
+
+    s_trs_kernel(batch, count);
+}
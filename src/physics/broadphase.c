@@ -0,0 +1,746 @@
+/**
+ * Nexus3D Physics Broadphase Implementation
+ * Surface area heuristic insertion with AVL-style rotations, after the usual dynamic AABB tree
+ */
+
+#include "nexus3d/physics/broadphase.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Initial node pool size */
+#define NEXUS_BROADPHASE_INITIAL_NODES 64
+
+/**
+ * Check whether a node is a leaf
+ */
+static inline bool nexus_broadphase_is_leaf(const NexusBroadphaseNode* node) {
+    return node->child1 == NEXUS_BROADPHASE_NULL;
+}
+
+/**
+ * Surface area of bounds
+ */
+static inline float nexus_broadphase_area(const vec3 min, const vec3 max) {
+    float dx = max[0] - min[0];
+    float dy = max[1] - min[1];
+    float dz = max[2] - min[2];
+    return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+/**
+ * Surface area of the union of two bounds
+ */
+static inline float nexus_broadphase_union_area(const vec3 min_a, const vec3 max_a, const vec3 min_b, const vec3 max_b) {
+    vec3 min = { glm_min(min_a[0], min_b[0]), glm_min(min_a[1], min_b[1]), glm_min(min_a[2], min_b[2]) };
+    vec3 max = { glm_max(max_a[0], max_b[0]), glm_max(max_a[1], max_b[1]), glm_max(max_a[2], max_b[2]) };
+    return nexus_broadphase_area(min, max);
+}
+
+/**
+ * Check whether two bounds overlap
+ */
+static inline bool nexus_broadphase_overlaps(const vec3 min_a, const vec3 max_a, const vec3 min_b, const vec3 max_b) {
+    return min_a[0] <= max_b[0] && max_a[0] >= min_b[0] &&
+           min_a[1] <= max_b[1] && max_a[1] >= min_b[1] &&
+           min_a[2] <= max_b[2] && max_a[2] >= min_b[2];
+}
+
+/**
+ * Check whether bounds a contain bounds b
+ */
+static inline bool nexus_broadphase_contains(const vec3 min_a, const vec3 max_a, const vec3 min_b, const vec3 max_b) {
+    return min_a[0] <= min_b[0] && min_a[1] <= min_b[1] && min_a[2] <= min_b[2] &&
+           max_a[0] >= max_b[0] && max_a[1] >= max_b[1] && max_a[2] >= max_b[2];
+}
+
+/**
+ * Set a node's bounds to the union of its children
+ */
+static inline void nexus_broadphase_refit(NexusBroadphase* broadphase, int32_t index) {
+    NexusBroadphaseNode* node = &broadphase->nodes[index];
+    const NexusBroadphaseNode* a = &broadphase->nodes[node->child1];
+    const NexusBroadphaseNode* b = &broadphase->nodes[node->child2];
+
+    for (int k = 0; k < 3; k++) {
+        node->min[k] = glm_min(a->min[k], b->min[k]);
+        node->max[k] = glm_max(a->max[k], b->max[k]);
+    }
+    node->height = 1 + (a->height > b->height ? a->height : b->height);
+}
+
+/**
+ * Take a node from the free list, growing the pool if needed
+ */
+static int32_t nexus_broadphase_allocate_node(NexusBroadphase* broadphase) {
+    if (broadphase->free_list == NEXUS_BROADPHASE_NULL) {
+        int32_t capacity = broadphase->node_capacity * 2;
+        NexusBroadphaseNode* nodes = (NexusBroadphaseNode*)realloc(broadphase->nodes,
+                                                                  sizeof(NexusBroadphaseNode) * (size_t)capacity);
+        if (nodes == NULL) {
+            fprintf(stderr, "Failed to grow broadphase node pool!\n");
+            return NEXUS_BROADPHASE_NULL;
+        }
+
+        /* Link the new nodes into the free list */
+        memset(&nodes[broadphase->node_capacity], 0,
+               sizeof(NexusBroadphaseNode) * (size_t)(capacity - broadphase->node_capacity));
+        for (int32_t i = broadphase->node_capacity; i < capacity; i++) {
+            nodes[i].parent = i + 1 < capacity ? i + 1 : NEXUS_BROADPHASE_NULL;
+            nodes[i].height = -1;
+        }
+
+        broadphase->free_list = broadphase->node_capacity;
+        broadphase->nodes = nodes;
+        broadphase->node_capacity = capacity;
+    }
+
+    int32_t index = broadphase->free_list;
+    NexusBroadphaseNode* node = &broadphase->nodes[index];
+    broadphase->free_list = node->parent;
+
+    node->parent = NEXUS_BROADPHASE_NULL;
+    node->child1 = NEXUS_BROADPHASE_NULL;
+    node->child2 = NEXUS_BROADPHASE_NULL;
+    node->height = 0;
+    node->entity = 0;
+    node->moved = false;
+    broadphase->node_count++;
+
+    return index;
+}
+
+/**
+ * Return a node to the free list
+ */
+static void nexus_broadphase_free_node(NexusBroadphase* broadphase, int32_t index) {
+    NexusBroadphaseNode* node = &broadphase->nodes[index];
+    node->parent = broadphase->free_list;
+    node->height = -1;
+    broadphase->free_list = index;
+    broadphase->node_count--;
+}
+
+/**
+ * Rotate the subtree at a if it is imbalanced, returns the new subtree root
+ */
+static int32_t nexus_broadphase_balance(NexusBroadphase* broadphase, int32_t ia) {
+    NexusBroadphaseNode* nodes = broadphase->nodes;
+    NexusBroadphaseNode* a = &nodes[ia];
+    if (nexus_broadphase_is_leaf(a) || a->height < 2) {
+        return ia;
+    }
+
+    int32_t ib = a->child1;
+    int32_t ic = a->child2;
+    NexusBroadphaseNode* b = &nodes[ib];
+    NexusBroadphaseNode* c = &nodes[ic];
+    int32_t balance = c->height - b->height;
+
+    /* Rotate c up */
+    if (balance > 1) {
+        int32_t i_f = c->child1;
+        int32_t ig = c->child2;
+        NexusBroadphaseNode* f = &nodes[i_f];
+        NexusBroadphaseNode* g = &nodes[ig];
+
+        c->child1 = ia;
+        c->parent = a->parent;
+        a->parent = ic;
+
+        if (c->parent != NEXUS_BROADPHASE_NULL) {
+            if (nodes[c->parent].child1 == ia) {
+                nodes[c->parent].child1 = ic;
+            } else {
+                nodes[c->parent].child2 = ic;
+            }
+        } else {
+            broadphase->root = ic;
+        }
+
+        /* The taller grandchild stays under c */
+        if (f->height > g->height) {
+            c->child2 = i_f;
+            a->child2 = ig;
+            g->parent = ia;
+        } else {
+            c->child2 = ig;
+            a->child2 = i_f;
+            f->parent = ia;
+        }
+
+        nexus_broadphase_refit(broadphase, ia);
+        nexus_broadphase_refit(broadphase, ic);
+        return ic;
+    }
+
+    /* Rotate b up */
+    if (balance < -1) {
+        int32_t id = b->child1;
+        int32_t ie = b->child2;
+        NexusBroadphaseNode* d = &nodes[id];
+        NexusBroadphaseNode* e = &nodes[ie];
+
+        b->child1 = ia;
+        b->parent = a->parent;
+        a->parent = ib;
+
+        if (b->parent != NEXUS_BROADPHASE_NULL) {
+            if (nodes[b->parent].child1 == ia) {
+                nodes[b->parent].child1 = ib;
+            } else {
+                nodes[b->parent].child2 = ib;
+            }
+        } else {
+            broadphase->root = ib;
+        }
+
+        if (d->height > e->height) {
+            b->child2 = id;
+            a->child1 = ie;
+            e->parent = ia;
+        } else {
+            b->child2 = ie;
+            a->child1 = id;
+            d->parent = ia;
+        }
+
+        nexus_broadphase_refit(broadphase, ia);
+        nexus_broadphase_refit(broadphase, ib);
+        return ib;
+    }
+
+    return ia;
+}
+
+/**
+ * Refit and rebalance from a node up to the root
+ */
+static void nexus_broadphase_fix_upwards(NexusBroadphase* broadphase, int32_t index) {
+    while (index != NEXUS_BROADPHASE_NULL) {
+        index = nexus_broadphase_balance(broadphase, index);
+        nexus_broadphase_refit(broadphase, index);
+        index = broadphase->nodes[index].parent;
+    }
+}
+
+/**
+ * Insert a leaf next to the sibling with the lowest surface area cost
+ */
+static void nexus_broadphase_insert_leaf(NexusBroadphase* broadphase, int32_t leaf) {
+    if (broadphase->root == NEXUS_BROADPHASE_NULL) {
+        broadphase->root = leaf;
+        broadphase->nodes[leaf].parent = NEXUS_BROADPHASE_NULL;
+        return;
+    }
+
+    /* Descend while splitting a child is cheaper than pairing with this node */
+    NexusBroadphaseNode* nodes = broadphase->nodes;
+    const float* leaf_min = nodes[leaf].min;
+    const float* leaf_max = nodes[leaf].max;
+    int32_t index = broadphase->root;
+
+    while (!nexus_broadphase_is_leaf(&nodes[index])) {
+        const NexusBroadphaseNode* node = &nodes[index];
+        float area = nexus_broadphase_area(node->min, node->max);
+        float combined = nexus_broadphase_union_area(node->min, node->max, leaf_min, leaf_max);
+
+        /* Cost of a new parent for this node and the leaf */
+        float cost = 2.0f * combined;
+
+        /* Minimum cost of pushing the leaf further down */
+        float inheritance = 2.0f * (combined - area);
+
+        float child_cost[2];
+        int32_t children[2] = { node->child1, node->child2 };
+        for (int k = 0; k < 2; k++) {
+            const NexusBroadphaseNode* child = &nodes[children[k]];
+            float child_union = nexus_broadphase_union_area(child->min, child->max, leaf_min, leaf_max);
+            if (nexus_broadphase_is_leaf(child)) {
+                child_cost[k] = child_union + inheritance;
+            } else {
+                child_cost[k] = child_union - nexus_broadphase_area(child->min, child->max) + inheritance;
+            }
+        }
+
+        if (cost < child_cost[0] && cost < child_cost[1]) {
+            break;
+        }
+
+        index = child_cost[0] < child_cost[1] ? children[0] : children[1];
+    }
+
+    /* Create a parent for the sibling and the leaf */
+    int32_t sibling = index;
+    int32_t old_parent = nodes[sibling].parent;
+    int32_t new_parent = nexus_broadphase_allocate_node(broadphase);
+    if (new_parent == NEXUS_BROADPHASE_NULL) {
+        return;
+    }
+    nodes = broadphase->nodes;
+
+    nodes[new_parent].parent = old_parent;
+    nodes[new_parent].child1 = sibling;
+    nodes[new_parent].child2 = leaf;
+    nodes[sibling].parent = new_parent;
+    nodes[leaf].parent = new_parent;
+
+    if (old_parent != NEXUS_BROADPHASE_NULL) {
+        if (nodes[old_parent].child1 == sibling) {
+            nodes[old_parent].child1 = new_parent;
+        } else {
+            nodes[old_parent].child2 = new_parent;
+        }
+    } else {
+        broadphase->root = new_parent;
+    }
+
+    nexus_broadphase_fix_upwards(broadphase, new_parent);
+}
+
+/**
+ * Detach a leaf, its parent is replaced by the sibling
+ */
+static void nexus_broadphase_remove_leaf(NexusBroadphase* broadphase, int32_t leaf) {
+    NexusBroadphaseNode* nodes = broadphase->nodes;
+
+    if (leaf == broadphase->root) {
+        broadphase->root = NEXUS_BROADPHASE_NULL;
+        return;
+    }
+
+    int32_t parent = nodes[leaf].parent;
+    int32_t grand_parent = nodes[parent].parent;
+    int32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grand_parent != NEXUS_BROADPHASE_NULL) {
+        if (nodes[grand_parent].child1 == parent) {
+            nodes[grand_parent].child1 = sibling;
+        } else {
+            nodes[grand_parent].child2 = sibling;
+        }
+        nodes[sibling].parent = grand_parent;
+        nexus_broadphase_free_node(broadphase, parent);
+        nexus_broadphase_fix_upwards(broadphase, grand_parent);
+    } else {
+        broadphase->root = sibling;
+        nodes[sibling].parent = NEXUS_BROADPHASE_NULL;
+        nexus_broadphase_free_node(broadphase, parent);
+    }
+}
+
+/**
+ * Remember a proxy for the next pair update
+ */
+static void nexus_broadphase_buffer_move(NexusBroadphase* broadphase, int32_t proxy) {
+    if (broadphase->nodes[proxy].moved) {
+        return;
+    }
+
+    if (broadphase->move_count == broadphase->move_capacity) {
+        int32_t capacity = broadphase->move_capacity * 2;
+        int32_t* moves = (int32_t*)realloc(broadphase->move_buffer, sizeof(int32_t) * (size_t)capacity);
+        if (moves == NULL) {
+            fprintf(stderr, "Failed to grow broadphase move buffer!\n");
+            return;
+        }
+        broadphase->move_buffer = moves;
+        broadphase->move_capacity = capacity;
+    }
+
+    broadphase->move_buffer[broadphase->move_count++] = proxy;
+    broadphase->nodes[proxy].moved = true;
+}
+
+/**
+ * Create a broadphase
+ */
+NexusBroadphase* nexus_broadphase_create(void) {
+    NexusBroadphase* broadphase = (NexusBroadphase*)malloc(sizeof(NexusBroadphase));
+    if (broadphase == NULL) {
+        fprintf(stderr, "Failed to allocate memory for broadphase!\n");
+        return NULL;
+    }
+    memset(broadphase, 0, sizeof(NexusBroadphase));
+
+    broadphase->root = NEXUS_BROADPHASE_NULL;
+    broadphase->free_list = NEXUS_BROADPHASE_NULL;
+
+    /* The node pool grows from the free list, start with an empty one */
+    broadphase->node_capacity = NEXUS_BROADPHASE_INITIAL_NODES / 2;
+    broadphase->nodes = (NexusBroadphaseNode*)malloc(sizeof(NexusBroadphaseNode) * (size_t)broadphase->node_capacity);
+    broadphase->move_capacity = NEXUS_BROADPHASE_INITIAL_NODES;
+    broadphase->move_buffer = (int32_t*)malloc(sizeof(int32_t) * (size_t)broadphase->move_capacity);
+    broadphase->pair_capacity = NEXUS_BROADPHASE_INITIAL_NODES;
+    broadphase->pairs = (NexusBroadphasePair*)malloc(sizeof(NexusBroadphasePair) * (size_t)broadphase->pair_capacity);
+
+    if (broadphase->nodes == NULL || broadphase->move_buffer == NULL || broadphase->pairs == NULL) {
+        fprintf(stderr, "Failed to allocate broadphase buffers!\n");
+        nexus_broadphase_destroy(broadphase);
+        return NULL;
+    }
+
+    /* Build the initial free list */
+    memset(broadphase->nodes, 0, sizeof(NexusBroadphaseNode) * (size_t)broadphase->node_capacity);
+    for (int32_t i = 0; i < broadphase->node_capacity; i++) {
+        broadphase->nodes[i].parent = i + 1 < broadphase->node_capacity ? i + 1 : NEXUS_BROADPHASE_NULL;
+        broadphase->nodes[i].height = -1;
+    }
+    broadphase->free_list = 0;
+
+    return broadphase;
+}
+
+/**
+ * Destroy a broadphase
+ */
+void nexus_broadphase_destroy(NexusBroadphase* broadphase) {
+    if (broadphase == NULL) {
+        return;
+    }
+
+    free(broadphase->nodes);
+    free(broadphase->move_buffer);
+    free(broadphase->pairs);
+    free(broadphase);
+}
+
+/**
+ * Insert a proxy for an entity's world bounds
+ */
+int32_t nexus_broadphase_create_proxy(NexusBroadphase* broadphase, const vec3 min, const vec3 max, ecs_entity_t entity) {
+    if (broadphase == NULL) {
+        return NEXUS_BROADPHASE_NULL;
+    }
+
+    int32_t proxy = nexus_broadphase_allocate_node(broadphase);
+    if (proxy == NEXUS_BROADPHASE_NULL) {
+        return NEXUS_BROADPHASE_NULL;
+    }
+
+    /* Fatten the bounds */
+    NexusBroadphaseNode* node = &broadphase->nodes[proxy];
+    for (int k = 0; k < 3; k++) {
+        node->min[k] = min[k] - NEXUS_BROADPHASE_MARGIN;
+        node->max[k] = max[k] + NEXUS_BROADPHASE_MARGIN;
+    }
+    node->entity = entity;
+
+    nexus_broadphase_insert_leaf(broadphase, proxy);
+    broadphase->proxy_count++;
+    nexus_broadphase_buffer_move(broadphase, proxy);
+
+    return proxy;
+}
+
+/**
+ * Remove a proxy
+ */
+void nexus_broadphase_destroy_proxy(NexusBroadphase* broadphase, int32_t proxy) {
+    if (broadphase == NULL || proxy < 0 || proxy >= broadphase->node_capacity ||
+        broadphase->nodes[proxy].height != 0) {
+        return;
+    }
+
+    /* Drop it from the move buffer */
+    if (broadphase->nodes[proxy].moved) {
+        for (int32_t i = 0; i < broadphase->move_count; i++) {
+            if (broadphase->move_buffer[i] == proxy) {
+                broadphase->move_buffer[i] = NEXUS_BROADPHASE_NULL;
+                break;
+            }
+        }
+    }
+
+    nexus_broadphase_remove_leaf(broadphase, proxy);
+    nexus_broadphase_free_node(broadphase, proxy);
+    broadphase->proxy_count--;
+}
+
+/**
+ * Update a proxy's bounds, the tree only changes when the tight bounds leave the fat ones
+ * Returns true if the proxy was reinserted
+ */
+bool nexus_broadphase_move_proxy(NexusBroadphase* broadphase, int32_t proxy, const vec3 min, const vec3 max) {
+    if (broadphase == NULL || proxy < 0 || proxy >= broadphase->node_capacity ||
+        broadphase->nodes[proxy].height != 0) {
+        return false;
+    }
+
+    NexusBroadphaseNode* node = &broadphase->nodes[proxy];
+    if (nexus_broadphase_contains(node->min, node->max, min, max)) {
+        return false;
+    }
+
+    /* Reinsert with new fat bounds */
+    nexus_broadphase_remove_leaf(broadphase, proxy);
+
+    node = &broadphase->nodes[proxy];
+    for (int k = 0; k < 3; k++) {
+        node->min[k] = min[k] - NEXUS_BROADPHASE_MARGIN;
+        node->max[k] = max[k] + NEXUS_BROADPHASE_MARGIN;
+    }
+
+    nexus_broadphase_insert_leaf(broadphase, proxy);
+    nexus_broadphase_buffer_move(broadphase, proxy);
+
+    return true;
+}
+
+/**
+ * Queue a proxy for pair generation without changing its bounds
+ */
+void nexus_broadphase_touch_proxy(NexusBroadphase* broadphase, int32_t proxy) {
+    if (broadphase == NULL || proxy < 0 || proxy >= broadphase->node_capacity ||
+        broadphase->nodes[proxy].height != 0) {
+        return;
+    }
+
+    nexus_broadphase_buffer_move(broadphase, proxy);
+}
+
+/**
+ * Order pairs by proxy indices
+ */
+static int nexus_broadphase_pair_compare(const void* a, const void* b) {
+    const NexusBroadphasePair* pa = (const NexusBroadphasePair*)a;
+    const NexusBroadphasePair* pb = (const NexusBroadphasePair*)b;
+
+    if (pa->proxy_a != pb->proxy_a) {
+        return pa->proxy_a < pb->proxy_a ? -1 : 1;
+    }
+    if (pa->proxy_b != pb->proxy_b) {
+        return pa->proxy_b < pb->proxy_b ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * Append a candidate pair
+ */
+static bool nexus_broadphase_add_pair(NexusBroadphase* broadphase, int32_t a, int32_t b) {
+    if (broadphase->pair_count == broadphase->pair_capacity) {
+        int32_t capacity = broadphase->pair_capacity * 2;
+        NexusBroadphasePair* pairs = (NexusBroadphasePair*)realloc(broadphase->pairs,
+                                                                  sizeof(NexusBroadphasePair) * (size_t)capacity);
+        if (pairs == NULL) {
+            fprintf(stderr, "Failed to grow broadphase pair buffer!\n");
+            return false;
+        }
+        broadphase->pairs = pairs;
+        broadphase->pair_capacity = capacity;
+    }
+
+    NexusBroadphasePair* pair = &broadphase->pairs[broadphase->pair_count++];
+    pair->proxy_a = a < b ? a : b;
+    pair->proxy_b = a < b ? b : a;
+    pair->entity_a = broadphase->nodes[pair->proxy_a].entity;
+    pair->entity_b = broadphase->nodes[pair->proxy_b].entity;
+    return true;
+}
+
+/**
+ * Check whether a pair from the last update is still a candidate
+ */
+static bool nexus_broadphase_pair_alive(const NexusBroadphase* broadphase, const NexusBroadphasePair* pair) {
+    const NexusBroadphaseNode* a = &broadphase->nodes[pair->proxy_a];
+    const NexusBroadphaseNode* b = &broadphase->nodes[pair->proxy_b];
+
+    /* Freed or reused proxies drop the pair, moved ones are found again by their query */
+    return a->height == 0 && b->height == 0 && a->entity == pair->entity_a && b->entity == pair->entity_b &&
+           !a->moved && !b->moved && nexus_broadphase_overlaps(a->min, a->max, b->min, b->max);
+}
+
+/**
+ * Update the candidate pair array
+ * Pairs persist while the fat bounds of both proxies overlap, new pairs come
+ * from querying the tree with the proxies that moved since the last update
+ */
+int32_t nexus_broadphase_update_pairs(NexusBroadphase* broadphase) {
+    if (broadphase == NULL) {
+        return 0;
+    }
+
+    /* Keep the pairs that are still overlapping */
+    int32_t kept = 0;
+    for (int32_t i = 0; i < broadphase->pair_count; i++) {
+        if (nexus_broadphase_pair_alive(broadphase, &broadphase->pairs[i])) {
+            broadphase->pairs[kept++] = broadphase->pairs[i];
+        }
+    }
+    broadphase->pair_count = kept;
+
+    int32_t stack[NEXUS_BROADPHASE_STACK_SIZE];
+    const NexusBroadphaseNode* nodes = broadphase->nodes;
+
+    for (int32_t m = 0; m < broadphase->move_count; m++) {
+        int32_t query = broadphase->move_buffer[m];
+        if (query == NEXUS_BROADPHASE_NULL || broadphase->root == NEXUS_BROADPHASE_NULL) {
+            continue;
+        }
+
+        const float* query_min = nodes[query].min;
+        const float* query_max = nodes[query].max;
+
+        int32_t top = 0;
+        stack[top++] = broadphase->root;
+
+        while (top > 0) {
+            int32_t index = stack[--top];
+            const NexusBroadphaseNode* node = &nodes[index];
+
+            if (!nexus_broadphase_overlaps(node->min, node->max, query_min, query_max)) {
+                continue;
+            }
+
+            if (nexus_broadphase_is_leaf(node)) {
+                /* Skip itself, and pairs of two moved proxies are found from the lower index only */
+                if (index == query || (node->moved && index < query)) {
+                    continue;
+                }
+                nexus_broadphase_add_pair(broadphase, query, index);
+            } else if (top + 2 <= NEXUS_BROADPHASE_STACK_SIZE) {
+                stack[top++] = node->child1;
+                stack[top++] = node->child2;
+            }
+        }
+    }
+
+    /* Reset the move buffer */
+    for (int32_t m = 0; m < broadphase->move_count; m++) {
+        int32_t proxy = broadphase->move_buffer[m];
+        if (proxy != NEXUS_BROADPHASE_NULL) {
+            broadphase->nodes[proxy].moved = false;
+        }
+    }
+    broadphase->move_count = 0;
+
+    /* Sort so the narrowphase walks memory in proxy order, then drop duplicates */
+    qsort(broadphase->pairs, (size_t)broadphase->pair_count, sizeof(NexusBroadphasePair),
+          nexus_broadphase_pair_compare);
+
+    int32_t unique = 0;
+    for (int32_t i = 0; i < broadphase->pair_count; i++) {
+        if (unique == 0 || nexus_broadphase_pair_compare(&broadphase->pairs[unique - 1], &broadphase->pairs[i]) != 0) {
+            broadphase->pairs[unique++] = broadphase->pairs[i];
+        }
+    }
+    broadphase->pair_count = unique;
+
+    return broadphase->pair_count;
+}
+
+/**
+ * Visit every proxy whose fat bounds overlap the given bounds
+ * Read only, safe to call from several threads while the tree isn't modified
+ */
+void nexus_broadphase_query(const NexusBroadphase* broadphase, const vec3 min, const vec3 max,
+                            NexusBroadphaseQueryFunc callback, void* user_data) {
+    if (broadphase == NULL || callback == NULL || broadphase->root == NEXUS_BROADPHASE_NULL) {
+        return;
+    }
+
+    int32_t stack[NEXUS_BROADPHASE_STACK_SIZE];
+    int32_t top = 0;
+    stack[top++] = broadphase->root;
+
+    while (top > 0) {
+        const NexusBroadphaseNode* node = &broadphase->nodes[stack[--top]];
+
+        if (!nexus_broadphase_overlaps(node->min, node->max, min, max)) {
+            continue;
+        }
+
+        if (nexus_broadphase_is_leaf(node)) {
+            if (!callback(user_data, (int32_t)(node - broadphase->nodes), node->entity)) {
+                return;
+            }
+        } else if (top + 2 <= NEXUS_BROADPHASE_STACK_SIZE) {
+            stack[top++] = node->child1;
+            stack[top++] = node->child2;
+        }
+    }
+}
+
+/**
+ * Slab test of a ray against bounds, entry distance in [0, max_distance]
+ */
+static inline bool nexus_broadphase_ray_overlaps(const vec3 origin, const vec3 inv_direction, float max_distance,
+                                                 const vec3 min, const vec3 max) {
+    float t_enter = 0.0f;
+    float t_exit = max_distance;
+
+    for (int k = 0; k < 3; k++) {
+        float t1 = (min[k] - origin[k]) * inv_direction[k];
+        float t2 = (max[k] - origin[k]) * inv_direction[k];
+        t_enter = glm_max(t_enter, glm_min(t1, t2));
+        t_exit = glm_min(t_exit, glm_max(t1, t2));
+    }
+
+    return t_enter <= t_exit;
+}
+
+/**
+ * Visit the proxies a ray passes through, the callback clips the ray to keep the search near
+ * Read only, safe to call from several threads while the tree isn't modified
+ */
+void nexus_broadphase_raycast(const NexusBroadphase* broadphase, const vec3 origin, const vec3 direction,
+                              float max_distance, NexusBroadphaseRayFunc callback, void* user_data) {
+    if (broadphase == NULL || callback == NULL || broadphase->root == NEXUS_BROADPHASE_NULL) {
+        return;
+    }
+
+    /* Zero direction components become huge slopes, which keep the slab test exact */
+    vec3 inv_direction;
+    for (int k = 0; k < 3; k++) {
+        inv_direction[k] = fabsf(direction[k]) > 1e-12f ? 1.0f / direction[k] : (direction[k] < 0.0f ? -1e30f : 1e30f);
+    }
+
+    int32_t stack[NEXUS_BROADPHASE_STACK_SIZE];
+    int32_t top = 0;
+    stack[top++] = broadphase->root;
+
+    while (top > 0) {
+        const NexusBroadphaseNode* node = &broadphase->nodes[stack[--top]];
+
+        if (!nexus_broadphase_ray_overlaps(origin, inv_direction, max_distance, node->min, node->max)) {
+            continue;
+        }
+
+        if (nexus_broadphase_is_leaf(node)) {
+            max_distance = callback(user_data, (int32_t)(node - broadphase->nodes), node->entity, max_distance);
+            if (max_distance <= 0.0f) {
+                return;
+            }
+        } else if (top + 2 <= NEXUS_BROADPHASE_STACK_SIZE) {
+            stack[top++] = node->child1;
+            stack[top++] = node->child2;
+        }
+    }
+}
+
+/**
+ * Get a proxy's fat bounds
+ */
+bool nexus_broadphase_get_fat_bounds(const NexusBroadphase* broadphase, int32_t proxy, vec3 min, vec3 max) {
+    if (broadphase == NULL || proxy < 0 || proxy >= broadphase->node_capacity ||
+        broadphase->nodes[proxy].height != 0) {
+        return false;
+    }
+
+    glm_vec3_copy((float*)broadphase->nodes[proxy].min, min);
+    glm_vec3_copy((float*)broadphase->nodes[proxy].max, max);
+    return true;
+}
+
+/**
+ * Get the tree height (0 when empty)
+ */
+int32_t nexus_broadphase_get_height(const NexusBroadphase* broadphase) {
+    if (broadphase == NULL || broadphase->root == NEXUS_BROADPHASE_NULL) {
+        return 0;
+    }
+
+    return broadphase->nodes[broadphase->root].height;
+}
@@ -6,6 +6,10 @@
 #include "nexus3d/physics/physics.h"
 #include "nexus3d/ecs/components.h"
 #include "nexus3d/math/math_utils.h"
+#include "nexus3d/utils/allocator.h"
+#include "nexus3d/utils/profiler.h"
+#include <SDL3/SDL.h>
+#include <float.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -17,6 +21,18 @@
 #define NEXUS_PHYSICS_DEFAULT_GRAVITY_Z 0.0f
 #define NEXUS_PHYSICS_DEFAULT_TIMESTEP (1.0f / 60.0f)
 #define NEXUS_PHYSICS_DEFAULT_MAX_SUBSTEPS 10
+#define NEXUS_PHYSICS_DEFAULT_SOLVER_ITERATIONS 8
+#define NEXUS_PHYSICS_DEFAULT_SLEEP_VELOCITY 0.05f
+#define NEXUS_PHYSICS_DEFAULT_SLEEP_FRAMES 30
+
+/* Contact solver tuning */
+#define NEXUS_PHYSICS_BAUMGARTE 0.2f          /* Fraction of penetration removed per step */
+#define NEXUS_PHYSICS_PENETRATION_SLOP 0.01f  /* Penetration left alone to keep contacts stable */
+#define NEXUS_PHYSICS_BOUNCE_THRESHOLD 1.0f   /* Approach speed below which restitution is ignored */
+
+/* Work per job, smaller workloads stay on the caller */
+#define NEXUS_PHYSICS_PAIRS_PER_JOB 128
+#define NEXUS_PHYSICS_ISLANDS_PER_JOB 8
 
 /* Helper for collision detection */
 typedef struct {
@@ -27,12 +43,19 @@ typedef struct {
 } NexusCollisionInfo;
 
 /* Forward declarations for internal functions */
-static void nexus_physics_movement_system(ecs_iter_t *it);
 static void nexus_physics_gravity_system(ecs_iter_t *it);
 static void nexus_physics_integration_system(ecs_iter_t *it);
-static void nexus_physics_collision_system(ecs_iter_t *it);
+static void nexus_physics_collider_removed(ecs_iter_t *it);
 static void nexus_physics_constraint_system(ecs_iter_t *it);
-static void nexus_physics_transform_update_system(ecs_iter_t *it);
+
+/* Collider component ID */
+ECS_COMPONENT_DECLARE(NexusColliderComponent);
+
+/* Collision shapes per pool chunk */
+#define NEXUS_PHYSICS_SHAPE_POOL_CHUNK 128
+
+/* Collision shapes come from a pool */
+static NexusPool g_shape_pool = NEXUS_POOL_INIT(NexusCollisionShape, NEXUS_PHYSICS_SHAPE_POOL_CHUNK);
 
 /* Collision detection helpers */
 static bool detect_sphere_sphere_collision(
@@ -41,13 +64,13 @@ static bool detect_sphere_sphere_collision(
     NexusCollisionInfo* collision_info);
 
 static bool detect_box_box_collision(
-    const vec3 pos_a, const vec3 half_extents_a, const mat4 rotation_a,
-    const vec3 pos_b, const vec3 half_extents_b, const mat4 rotation_b,
+    const vec3 pos_a, const vec3 half_extents_a, mat4 rotation_a,
+    const vec3 pos_b, const vec3 half_extents_b, mat4 rotation_b,
     NexusCollisionInfo* collision_info);
 
 static bool detect_sphere_box_collision(
     const vec3 sphere_pos, float sphere_radius,
-    const vec3 box_pos, const vec3 box_half_extents, const mat4 box_rotation,
+    const vec3 box_pos, const vec3 box_half_extents, mat4 box_rotation,
     NexusCollisionInfo* collision_info);
 
 /**
@@ -79,31 +102,72 @@ NexusPhysics* nexus_physics_create(ecs_world_t* world) {
     physics->config.fixed_timestep = NEXUS_PHYSICS_DEFAULT_TIMESTEP;
     physics->config.max_substeps = NEXUS_PHYSICS_DEFAULT_MAX_SUBSTEPS;
     physics->config.debug_draw = false;
+    physics->config.solver_iterations = NEXUS_PHYSICS_DEFAULT_SOLVER_ITERATIONS;
+    physics->config.sleep_velocity = NEXUS_PHYSICS_DEFAULT_SLEEP_VELOCITY;
+    physics->config.sleep_frames = NEXUS_PHYSICS_DEFAULT_SLEEP_FRAMES;
 
     /* Initialize accumulator */
     physics->accumulated_time = 0.0f;
     physics->paused = false;
 
-    /* Register ECS systems */
-
-    /* Create simplified ECS systems */
-    /* Movement system only for now */
-    ecs_entity_t movement_sys = ecs_new(world);
-    
-    ecs_system_desc_t movement_desc = {0};
-    movement_desc.entity = movement_sys;
-    movement_desc.callback = nexus_physics_movement_system;
-    ecs_system_init(world, &movement_desc);
-
-    /* Transform system */
-    ecs_entity_t transform_sys = ecs_new(world);
+    /* Collision detection */
+    nexus_physics_register_components(world);
 
-    ecs_system_desc_t transform_desc = {0};
-    transform_desc.entity = transform_sys;
-    transform_desc.callback = nexus_physics_transform_update_system;
-    ecs_system_init(world, &transform_desc);
+    physics->broadphase = nexus_broadphase_create();
+    if (physics->broadphase == NULL) {
+        fprintf(stderr, "Failed to create physics broadphase!\n");
+        free(physics);
+        return NULL;
+    }
 
-    /* The rest of the physics systems will be implemented later */
+    physics->collider_query = ecs_query_init(world, &(ecs_query_desc_t){
+        .terms = {
+            { .id = ecs_id(NexusColliderComponent) },
+            { .id = ecs_id(NexusPositionComponent), .inout = EcsIn },
+            { .id = ecs_id(NexusRotationComponent), .inout = EcsIn, .oper = EcsOptional }
+        },
+        .cache_kind = EcsQueryCacheAuto
+    });
+
+    physics->body_query = ecs_query_init(world, &(ecs_query_desc_t){
+        .terms = {
+            { .id = ecs_id(NexusRigidBodyComponent) },
+            { .id = ecs_id(NexusVelocityComponent) },
+            { .id = ecs_id(NexusPositionComponent) }
+        },
+        .cache_kind = EcsQueryCacheAuto
+    });
+
+    physics->collider_observer = ecs_observer_init(world, &(ecs_observer_desc_t){
+        .query.terms = {
+            { .id = ecs_id(NexusColliderComponent) }
+        },
+        .events = { EcsOnRemove },
+        .callback = nexus_physics_collider_removed,
+        .ctx = physics
+    });
+
+    /* Fixed step pipeline, runs only the systems of the physics phase (the
+     * named phase entity is shared with nexus_ecs_register_systems) */
+    physics->phase = ecs_entity_init(world, &(ecs_entity_desc_t){
+        .name = "NexusPhasePhysics"
+    });
+    physics->pipeline = ecs_pipeline_init(world, &(ecs_pipeline_desc_t){
+        .query.terms = {
+            { .id = EcsSystem }, /* First term must be EcsSystem */
+            { .id = physics->phase }
+        }
+    });
+
+    /* Render interpolation state */
+    physics->interpolation_query = ecs_query_init(world, &(ecs_query_desc_t){
+        .terms = {
+            { .id = ecs_id(NexusInterpolationComponent), .inout = EcsOut },
+            { .id = ecs_id(NexusPositionComponent), .inout = EcsIn },
+            { .id = ecs_id(NexusRotationComponent), .inout = EcsIn, .oper = EcsOptional }
+        },
+        .cache_kind = EcsQueryCacheAuto
+    });
 
     printf("Physics system created successfully.\n");
 
@@ -118,55 +182,95 @@ void nexus_physics_destroy(NexusPhysics* physics) {
         return;
     }
 
+    /* Release collision detection, proxies go with the tree */
+    if (physics->collider_observer != 0) {
+        ecs_delete(physics->world, physics->collider_observer);
+    }
+    if (physics->collider_query != NULL) {
+        ecs_query_fini(physics->collider_query);
+    }
+    if (physics->body_query != NULL) {
+        ecs_query_fini(physics->body_query);
+    }
+    if (physics->interpolation_query != NULL) {
+        ecs_query_fini(physics->interpolation_query);
+    }
+    if (physics->pipeline != 0) {
+        ecs_delete(physics->world, physics->pipeline);
+    }
+    nexus_broadphase_destroy(physics->broadphase);
+    free(physics->contacts);
+    free(physics->bodies);
+    free(physics->solver_contacts);
+    free(physics->islands);
+    free(physics->island_bodies);
+
     /* Free physics system structure */
     free(physics);
 
     printf("Physics system destroyed.\n");
 }
 
+/**
+ * Capture the state interpolated entities are rendered from
+ */
+static void nexus_physics_save_interpolation(NexusPhysics* physics) {
+    ecs_iter_t it = ecs_query_iter(physics->world, physics->interpolation_query);
+    while (ecs_query_next(&it)) {
+        NexusInterpolationComponent* states = ecs_field(&it, NexusInterpolationComponent, 0);
+        const NexusPositionComponent* positions = ecs_field(&it, NexusPositionComponent, 1);
+        const NexusRotationComponent* rotations = ecs_field(&it, NexusRotationComponent, 2);
+
+        for (int i = 0; i < it.count; i++) {
+            glm_vec3_copy((float*)positions[i].value, states[i].previous_position);
+            if (rotations != NULL) {
+                glm_quat_copy((float*)rotations[i].quaternion, states[i].previous_rotation);
+            } else {
+                glm_quat_identity(states[i].previous_rotation);
+            }
+            states[i].valid = true;
+        }
+    }
+}
+
 /**
  * Update the physics system
+ * Runs the physics phase and the solver in fixed steps, the rest of the world
+ * is progressed once per frame by the engine
  */
 void nexus_physics_update(NexusPhysics* physics, float dt) {
     if (physics == NULL || physics->world == NULL || physics->paused) {
         return;
     }
 
-    /* Update the physics world using fixed timestep */
+    float step = physics->config.fixed_timestep;
     physics->accumulated_time += dt;
     physics->iteration_count = 0;
 
     /* Process fixed timestep updates */
-    while (physics->accumulated_time >= physics->config.fixed_timestep &&
+    NEXUS_PROFILE_BEGIN("NexusPhasePhysics");
+    while (physics->accumulated_time >= step &&
            physics->iteration_count < physics->config.max_substeps) {
+        nexus_physics_save_interpolation(physics);
 
-        /* Set delta time for this iteration */
-        ecs_set_time_scale(physics->world, 1.0);
-        ecs_set_target_fps(physics->world, 1.0 / physics->config.fixed_timestep);
-
-        /* Progress the ECS world for one physics timestep */
-        ecs_progress(physics->world, 0);
+        /* Fixed step systems, then contacts and the solver */
+        ecs_run_pipeline(physics->world, physics->pipeline, step);
+        NEXUS_PROFILE_BEGIN("PhysicsStep");
+        nexus_physics_step(physics, step);
+        NEXUS_PROFILE_END();
 
-        /* Update accumulator */
-        physics->accumulated_time -= physics->config.fixed_timestep;
+        physics->accumulated_time -= step;
         physics->iteration_count++;
     }
+    NEXUS_PROFILE_END();
 
-    /* Handle remaining time if we've hit max substeps */
-    if (physics->accumulated_time > 0 && physics->iteration_count >= physics->config.max_substeps) {
-        /* Perform one more update with the remaining time */
-        float remaining_dt = physics->accumulated_time;
-
-        /* Set delta time for this iteration */
-        ecs_set_time_scale(physics->world, 1.0);
-        ecs_set_target_fps(physics->world, 1.0 / remaining_dt);
-
-        /* Progress the ECS world for the remaining time */
-        ecs_progress(physics->world, 0);
-
-        /* Reset accumulator */
-        physics->accumulated_time = 0;
+    /* Drop the time we can't catch up on rather than stepping with a longer dt */
+    if (physics->accumulated_time >= step) {
+        physics->accumulated_time = fmodf(physics->accumulated_time, step);
     }
+
+    /* Renderers blend from the previous towards the current step by this much */
+    physics->interpolation_alpha = physics->accumulated_time / step;
 }
 
 /**
@@ -271,7 +375,7 @@ NexusCollisionShape* nexus_collision_shape_create_box(float width, float height,
     }
 
     /* Allocate collision shape structure */
-    NexusCollisionShape* shape = (NexusCollisionShape*)malloc(sizeof(NexusCollisionShape));
+    NexusCollisionShape* shape = (NexusCollisionShape*)nexus_pool_alloc(&g_shape_pool);
     if (shape == NULL) {
         fprintf(stderr, "Failed to allocate memory for box collision shape!\n");
         return NULL;
@@ -296,7 +400,7 @@ NexusCollisionShape* nexus_collision_shape_create_sphere(float radius) {
     }
 
     /* Allocate collision shape structure */
-    NexusCollisionShape* shape = (NexusCollisionShape*)malloc(sizeof(NexusCollisionShape));
+    NexusCollisionShape* shape = (NexusCollisionShape*)nexus_pool_alloc(&g_shape_pool);
     if (shape == NULL) {
         fprintf(stderr, "Failed to allocate memory for sphere collision shape!\n");
         return NULL;
@@ -309,6 +413,24 @@ NexusCollisionShape* nexus_collision_shape_create_sphere(float radius) {
     return shape;
 }
 
+/**
+ * Destroy a collision shape
+ */
+void nexus_collision_shape_destroy(NexusCollisionShape* shape) {
+    if (shape == NULL) {
+        return;
+    }
+
+    nexus_pool_free(&g_shape_pool, shape);
+}
+
+/**
+ * Get statistics of the collision shape pool
+ */
+NexusPoolStats nexus_collision_shape_get_pool_stats(void) {
+    return nexus_pool_get_stats(&g_shape_pool);
+}
+
 /**
  * Collision detection helper: Sphere-Sphere collision
  */
@@ -358,135 +480,1200 @@ static bool detect_sphere_sphere_collision(
 }
 
 /**
- * Movement system implementation
+ * Box that bounds a shape in its local frame
  */
-static void nexus_physics_movement_system(ecs_iter_t *it) {
-    NexusPositionComponent *positions = ecs_field(it, NexusPositionComponent, 1);
-    NexusVelocityComponent *velocities = ecs_field(it, NexusVelocityComponent, 2);
+static bool nexus_collision_shape_get_local_box(const NexusCollisionShape* shape, vec3 half_extents) {
+    switch (shape->type) {
+        case NEXUS_COLLISION_SHAPE_BOX:
+            glm_vec3_copy((float*)shape->data.box.half_extents, half_extents);
+            return true;
+        case NEXUS_COLLISION_SHAPE_SPHERE:
+            half_extents[0] = half_extents[1] = half_extents[2] = shape->data.sphere.radius;
+            return true;
+        case NEXUS_COLLISION_SHAPE_CAPSULE:
+            half_extents[0] = half_extents[2] = shape->data.capsule.radius;
+            half_extents[1] = shape->data.capsule.height * 0.5f + shape->data.capsule.radius;
+            return true;
+        case NEXUS_COLLISION_SHAPE_CYLINDER:
+            half_extents[0] = half_extents[2] = shape->data.cylinder.radius;
+            half_extents[1] = shape->data.cylinder.height * 0.5f;
+            return true;
+        case NEXUS_COLLISION_SHAPE_CONE:
+            half_extents[0] = half_extents[2] = shape->data.cone.radius;
+            half_extents[1] = shape->data.cone.height * 0.5f;
+            return true;
+        case NEXUS_COLLISION_SHAPE_CONVEX_HULL: {
+            const float* vertices = (const float*)shape->data.convex_hull.vertices;
+            if (vertices == NULL || shape->data.convex_hull.vertex_count <= 0) {
+                return false;
+            }
+            half_extents[0] = half_extents[1] = half_extents[2] = 0.0f;
+            for (int i = 0; i < shape->data.convex_hull.vertex_count; i++) {
+                for (int k = 0; k < 3; k++) {
+                    half_extents[k] = glm_max(half_extents[k], fabsf(vertices[i * 3 + k]));
+                }
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
 
-    /* Apply velocities to positions */
-    for (int i = 0; i < it->count; i++) {
-        /* Calculate position change based on velocity and delta time */
-        vec3 delta;
-        glm_vec3_scale(velocities[i].linear, it->delta_time, delta);
+/**
+ * Compute a shape's world space AABB
+ */
+bool nexus_collision_shape_get_bounds(const NexusCollisionShape* shape, const vec3 position, const versor rotation,
+                                      vec3 min, vec3 max) {
+    if (shape == NULL || position == NULL) {
+        return false;
+    }
 
-        /* Update position */
-        glm_vec3_add(positions[i].value, delta, positions[i].value);
+    /* Spheres ignore rotation */
+    if (shape->type == NEXUS_COLLISION_SHAPE_SPHERE) {
+        for (int k = 0; k < 3; k++) {
+            min[k] = position[k] - shape->data.sphere.radius;
+            max[k] = position[k] + shape->data.sphere.radius;
+        }
+        return true;
     }
+
+    vec3 half_extents;
+    if (!nexus_collision_shape_get_local_box(shape, half_extents)) {
+        return false;
+    }
+
+    /* Extent along each world axis of the rotated local box */
+    mat4 basis = GLM_MAT4_IDENTITY_INIT;
+    if (rotation != NULL) {
+        glm_quat_mat4((float*)rotation, basis);
+    }
+
+    for (int k = 0; k < 3; k++) {
+        float extent = fabsf(basis[0][k]) * half_extents[0] +
+                       fabsf(basis[1][k]) * half_extents[1] +
+                       fabsf(basis[2][k]) * half_extents[2];
+        min[k] = position[k] - extent;
+        max[k] = position[k] + extent;
+    }
+
+    return true;
 }
 
 /**
- * Transform update system implementation
+ * Collision detection helper: Sphere-Box collision (oriented box)
  */
-static void nexus_physics_transform_update_system(ecs_iter_t *it) {
-    NexusPositionComponent *positions = ecs_field(it, NexusPositionComponent, 1);
-    NexusRotationComponent *rotations = ecs_field(it, NexusRotationComponent, 2);
-    NexusTransformComponent *transforms = ecs_field(it, NexusTransformComponent, 3);
+static bool detect_sphere_box_collision(
+    const vec3 sphere_pos, float sphere_radius,
+    const vec3 box_pos, const vec3 box_half_extents, mat4 box_rotation,
+    NexusCollisionInfo* collision_info) {
 
-    /* Update transform matrices */
-    for (int i = 0; i < it->count; i++) {
-        /* Mark transform as dirty */
-        transforms[i].dirty = true;
+    /* Sphere center in box space */
+    vec3 delta = { sphere_pos[0] - box_pos[0], sphere_pos[1] - box_pos[1], sphere_pos[2] - box_pos[2] };
+    vec3 local;
+    for (int i = 0; i < 3; i++) {
+        local[i] = delta[0] * box_rotation[i][0] + delta[1] * box_rotation[i][1] + delta[2] * box_rotation[i][2];
+    }
 
-        /* Create transform matrix from position and rotation */
-        /* We assume scale is handled elsewhere (or is uniform 1.0) */
-        mat4 pos_mat, rot_mat;
+    /* Closest point on the box */
+    vec3 closest;
+    bool inside = true;
+    for (int i = 0; i < 3; i++) {
+        closest[i] = glm_clamp(local[i], -box_half_extents[i], box_half_extents[i]);
+        if (closest[i] != local[i]) {
+            inside = false;
+        }
+    }
 
-        /* Create translation matrix */
-        glm_mat4_identity(pos_mat);
-        pos_mat[3][0] = positions[i].value[0];
-        pos_mat[3][1] = positions[i].value[1];
-        pos_mat[3][2] = positions[i].value[2];
+    vec3 local_normal;
+    float penetration;
+
+    if (inside) {
+        /* Center inside: leave through the nearest face */
+        int axis = 0;
+        float best = box_half_extents[0] - fabsf(local[0]);
+        for (int i = 1; i < 3; i++) {
+            float exit = box_half_extents[i] - fabsf(local[i]);
+            if (exit < best) {
+                best = exit;
+                axis = i;
+            }
+        }
 
-        /* Create rotation matrix from quaternion */
-        glm_quat_mat4(rotations[i].quaternion, rot_mat);
+        glm_vec3_zero(local_normal);
+        local_normal[axis] = local[axis] >= 0.0f ? -1.0f : 1.0f;
+        penetration = sphere_radius + best;
+    } else {
+        vec3 offset = { closest[0] - local[0], closest[1] - local[1], closest[2] - local[2] };
+        float distance_sq = offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2];
+        if (distance_sq >= sphere_radius * sphere_radius) {
+            return false; /* No collision */
+        }
 
-        /* Combine matrices */
-        glm_mat4_mul(pos_mat, rot_mat, transforms[i].local);
+        float distance = sqrtf(distance_sq);
+        if (distance > 0.0001f) {
+            glm_vec3_scale(offset, 1.0f / distance, local_normal);
+        } else {
+            local_normal[0] = 0.0f;
+            local_normal[1] = -1.0f;
+            local_normal[2] = 0.0f;
+        }
+        penetration = sphere_radius - distance;
+    }
 
-        /* For simplicity, we assume world = local
-         * A full implementation would need to handle parent-child relationships */
-        glm_mat4_copy(transforms[i].local, transforms[i].world);
+    if (collision_info != NULL) {
+        collision_info->collided = true;
+        collision_info->penetration_depth = penetration;
+
+        /* Back to world space, normal points from the sphere into the box */
+        for (int k = 0; k < 3; k++) {
+            collision_info->contact_normal[k] = box_rotation[0][k] * local_normal[0] +
+                                                box_rotation[1][k] * local_normal[1] +
+                                                box_rotation[2][k] * local_normal[2];
+            collision_info->contact_point[k] = box_pos[k] + box_rotation[0][k] * closest[0] +
+                                               box_rotation[1][k] * closest[1] +
+                                               box_rotation[2][k] * closest[2];
+        }
     }
+
+    return true; /* Collision detected */
 }
 
 /**
- * Perform a raycast in the physics world
+ * Collision detection helper: Box-Box collision (separating axis test over 15 axes)
  */
-bool nexus_physics_raycast(NexusPhysics* physics, const vec3 origin, const vec3 direction, float max_distance,
-                         ecs_entity_t* hit_entity, vec3 hit_point, vec3 hit_normal, float* hit_distance) {
-    if (physics == NULL || physics->world == NULL) {
+static bool detect_box_box_collision(
+    const vec3 pos_a, const vec3 half_extents_a, mat4 rotation_a,
+    const vec3 pos_b, const vec3 half_extents_b, mat4 rotation_b,
+    NexusCollisionInfo* collision_info) {
+
+    vec3 axes_a[3], axes_b[3];
+    for (int i = 0; i < 3; i++) {
+        for (int k = 0; k < 3; k++) {
+            axes_a[i][k] = rotation_a[i][k];
+            axes_b[i][k] = rotation_b[i][k];
+        }
+    }
+
+    vec3 t = { pos_b[0] - pos_a[0], pos_b[1] - pos_a[1], pos_b[2] - pos_a[2] };
+    float best_overlap = FLT_MAX;
+    vec3 best_axis = {0.0f, 1.0f, 0.0f};
+
+    /* Face axes of both boxes, then the nine edge cross products */
+    for (int n = 0; n < 15; n++) {
+        vec3 axis;
+        if (n < 3) {
+            glm_vec3_copy(axes_a[n], axis);
+        } else if (n < 6) {
+            glm_vec3_copy(axes_b[n - 3], axis);
+        } else {
+            glm_vec3_cross(axes_a[(n - 6) / 3], axes_b[(n - 6) % 3], axis);
+            float length_sq = glm_vec3_norm2(axis);
+            if (length_sq < 1e-6f) {
+                continue; /* Parallel edges, covered by the face axes */
+            }
+            glm_vec3_scale(axis, 1.0f / sqrtf(length_sq), axis);
+        }
+
+        float ra = 0.0f, rb = 0.0f;
+        for (int i = 0; i < 3; i++) {
+            ra += half_extents_a[i] * fabsf(glm_vec3_dot(axes_a[i], axis));
+            rb += half_extents_b[i] * fabsf(glm_vec3_dot(axes_b[i], axis));
+        }
+
+        float distance = glm_vec3_dot(t, axis);
+        float overlap = ra + rb - fabsf(distance);
+        if (overlap < 0.0f) {
+            return false; /* Separating axis found */
+        }
+
+        if (overlap < best_overlap) {
+            best_overlap = overlap;
+            glm_vec3_scale(axis, distance < 0.0f ? -1.0f : 1.0f, best_axis);
+        }
+    }
+
+    if (collision_info != NULL) {
+        collision_info->collided = true;
+        collision_info->penetration_depth = best_overlap;
+        glm_vec3_copy(best_axis, collision_info->contact_normal);
+
+        /* Deepest point of b along the normal, moved halfway out of a */
+        vec3 point;
+        glm_vec3_copy((float*)pos_b, point);
+        for (int i = 0; i < 3; i++) {
+            float side = glm_vec3_dot(axes_b[i], best_axis) > 0.0f ? -1.0f : 1.0f;
+            vec3 offset;
+            glm_vec3_scale(axes_b[i], side * half_extents_b[i], offset);
+            glm_vec3_add(point, offset, point);
+        }
+        vec3 half_push;
+        glm_vec3_scale(best_axis, best_overlap * 0.5f, half_push);
+        glm_vec3_add(point, half_push, collision_info->contact_point);
+    }
+
+    return true; /* Collision detected */
+}
+
+/**
+ * Gather the shape, position and orientation of a collider entity
+ */
+static bool nexus_physics_get_collider(ecs_world_t* world, ecs_entity_t entity, const NexusCollisionShape** shape,
+                                       vec3 position, mat4 rotation) {
+    const NexusColliderComponent* collider = ecs_get(world, entity, NexusColliderComponent);
+    const NexusPositionComponent* pos = ecs_get(world, entity, NexusPositionComponent);
+    if (collider == NULL || pos == NULL) {
+        return false;
+    }
+
+    const NexusRotationComponent* rot = ecs_get(world, entity, NexusRotationComponent);
+    if (rot != NULL) {
+        glm_quat_mat4((float*)rot->quaternion, rotation);
+    } else {
+        glm_mat4_identity(rotation);
+    }
+
+    *shape = &collider->shape;
+    glm_vec3_copy((float*)pos->value, position);
+    return true;
+}
+
+/**
+ * Check whether an entity is an awake rigid body
+ */
+static bool nexus_physics_is_active(ecs_world_t* world, ecs_entity_t entity) {
+    const NexusRigidBodyComponent* body = ecs_get(world, entity, NexusRigidBodyComponent);
+    return body != NULL && !body->sleeping;
+}
+
+/**
+ * Test one candidate pair with the shape specific narrowphase
+ * Shapes other than spheres and boxes are tested as their bounding box
+ */
+static bool nexus_physics_test_pair(ecs_world_t* world, const NexusBroadphasePair* pair, NexusPhysicsContact* contact) {
+    const NexusCollisionShape* shape_a;
+    const NexusCollisionShape* shape_b;
+    vec3 pos_a, pos_b;
+    mat4 rot_a, rot_b;
+
+    /* Pairs between static or sleeping colliders cost nothing */
+    if (!nexus_physics_is_active(world, pair->entity_a) && !nexus_physics_is_active(world, pair->entity_b)) {
+        return false;
+    }
+
+    if (!nexus_physics_get_collider(world, pair->entity_a, &shape_a, pos_a, rot_a) ||
+        !nexus_physics_get_collider(world, pair->entity_b, &shape_b, pos_b, rot_b)) {
+        return false;
+    }
+
+    NexusCollisionInfo info;
+    memset(&info, 0, sizeof(info));
+    bool sphere_a = shape_a->type == NEXUS_COLLISION_SHAPE_SPHERE;
+    bool sphere_b = shape_b->type == NEXUS_COLLISION_SHAPE_SPHERE;
+    bool hit;
+
+    if (sphere_a && sphere_b) {
+        hit = detect_sphere_sphere_collision(pos_a, shape_a->data.sphere.radius,
+                                             pos_b, shape_b->data.sphere.radius, &info);
+    } else if (sphere_a || sphere_b) {
+        vec3 box;
+        const NexusCollisionShape* other = sphere_a ? shape_b : shape_a;
+        if (!nexus_collision_shape_get_local_box(other, box)) {
+            return false;
+        }
+
+        if (sphere_a) {
+            hit = detect_sphere_box_collision(pos_a, shape_a->data.sphere.radius, pos_b, box, rot_b, &info);
+        } else {
+            /* The helper reports sphere to box, flip to a to b */
+            hit = detect_sphere_box_collision(pos_b, shape_b->data.sphere.radius, pos_a, box, rot_a, &info);
+            glm_vec3_negate(info.contact_normal);
+        }
+    } else {
+        vec3 box_a, box_b;
+        if (!nexus_collision_shape_get_local_box(shape_a, box_a) ||
+            !nexus_collision_shape_get_local_box(shape_b, box_b)) {
+            return false;
+        }
+        hit = detect_box_box_collision(pos_a, box_a, rot_a, pos_b, box_b, rot_b, &info);
+    }
+
+    if (!hit) {
         return false;
     }
 
-    /* Initialize output parameters */
-    if (hit_entity) *hit_entity = 0;
-    if (hit_point) hit_point[0] = hit_point[1] = hit_point[2] = 0.0f;
-    if (hit_normal) hit_normal[0] = hit_normal[1] = hit_normal[2] = 0.0f;
-    if (hit_distance) *hit_distance = max_distance;
+    contact->entity_a = pair->entity_a;
+    contact->entity_b = pair->entity_b;
+    glm_vec3_copy(info.contact_point, contact->point);
+    glm_vec3_copy(info.contact_normal, contact->normal);
+    contact->penetration = info.penetration_depth;
+    return true;
+}
+
+/**
+ * Narrowphase over a range of candidate pairs
+ * Each pair owns its contact slot and the world is only read, so disjoint
+ * ranges can run on different threads
+ */
+static void nexus_physics_narrowphase_range(NexusPhysics* physics, int32_t first, int32_t end) {
+    const NexusBroadphasePair* pairs = physics->broadphase->pairs;
+
+    for (int32_t i = first; i < end; i++) {
+        NexusPhysicsContact* contact = &physics->contacts[i];
+        if (!nexus_physics_test_pair(physics->world, &pairs[i], contact)) {
+            contact->entity_a = 0;
+        }
+    }
+}
 
-    /* Create a ray */
-    NexusRay ray;
-    nexus_ray_set(&ray, origin[0], origin[1], origin[2], direction[0], direction[1], direction[2]);
+/**
+ * Narrowphase job
+ */
+static void nexus_physics_narrowphase_job(void* data, uint32_t first, uint32_t end) {
+    nexus_physics_narrowphase_range((NexusPhysics*)data, (int32_t)first, (int32_t)end);
+}
 
-    /* Variables to track closest hit */
-    float closest_distance = max_distance;
-    ecs_entity_t closest_entity = 0;
-    vec3 closest_point = {0.0f, 0.0f, 0.0f};
-    vec3 closest_normal = {0.0f, 0.0f, 0.0f};
-    bool hit_found = false;
+/**
+ * Run collision detection for the current collider state
+ */
+void nexus_physics_detect_collisions(NexusPhysics* physics) {
+    if (physics == NULL || physics->broadphase == NULL || physics->collider_query == NULL) {
+        return;
+    }
 
-    /* Create a query for all rigid bodies with position */
-    ecs_query_desc_t query_desc = {0};
-    ecs_query_t *query = ecs_query_init(physics->world, &query_desc);
+    uint64_t frequency = SDL_GetPerformanceFrequency();
+    uint64_t start = SDL_GetPerformanceCounter();
+    uint32_t moved = 0;
 
-    /* Iterate all potential collision candidates */
-    ecs_iter_t it = ecs_query_iter(physics->world, query);
+    /* Insert new colliders and refit moved ones */
+    ecs_iter_t it = ecs_query_iter(physics->world, physics->collider_query);
     while (ecs_query_next(&it)) {
-        NexusPositionComponent *positions = ecs_field(&it, NexusPositionComponent, 1);
-        NexusRigidBodyComponent *bodies = ecs_field(&it, NexusRigidBodyComponent, 2);
+        NexusColliderComponent* colliders = ecs_field(&it, NexusColliderComponent, 0);
+        const NexusPositionComponent* positions = ecs_field(&it, NexusPositionComponent, 1);
+        const NexusRotationComponent* rotations = ecs_field(&it, NexusRotationComponent, 2);
 
         for (int i = 0; i < it.count; i++) {
-            ecs_entity_t entity = it.entities[i];
-            vec3 position;
-            float radius = 1.0f;  /* Default size for simple test */
-
-            /* Get entity position */
-            glm_vec3_copy(positions[i].value, position);
-
-            /* Perform ray-sphere intersection test */
-            float t;
-            if (nexus_ray_sphere_intersect(&ray, position, radius, &t)) {
-                if (t < closest_distance) {
-                    /* This is the closest hit so far */
-                    closest_distance = t;
-                    closest_entity = entity;
-
-                    /* Calculate hit point */
-                    vec3 scaled_dir;
-                    glm_vec3_scale(ray.direction, t, scaled_dir);
-                    glm_vec3_add(ray.origin, scaled_dir, closest_point);
-
-                    /* Calculate hit normal */
-                    glm_vec3_sub(closest_point, position, closest_normal);
-                    glm_vec3_normalize(closest_normal);
-
-                    hit_found = true;
+            vec3 min, max;
+            if (!nexus_collision_shape_get_bounds(&colliders[i].shape, positions[i].value,
+                                                  rotations ? rotations[i].quaternion : NULL, min, max)) {
+                continue;
+            }
+
+            if (!colliders[i].in_broadphase) {
+                colliders[i].proxy = nexus_broadphase_create_proxy(physics->broadphase, min, max, it.entities[i]);
+                colliders[i].in_broadphase = colliders[i].proxy != NEXUS_BROADPHASE_NULL;
+                moved++;
+            } else if (nexus_broadphase_move_proxy(physics->broadphase, colliders[i].proxy, min, max)) {
+                moved++;
+            }
+        }
+    }
+
+    /* Compact candidate pair array */
+    int32_t pair_count = nexus_broadphase_update_pairs(physics->broadphase);
+    uint64_t broadphase_end = SDL_GetPerformanceCounter();
+
+    /* One contact slot per pair */
+    if ((uint32_t)pair_count > physics->contact_capacity) {
+        uint32_t capacity = physics->contact_capacity ? physics->contact_capacity : 64;
+        while (capacity < (uint32_t)pair_count) {
+            capacity *= 2;
+        }
+        NexusPhysicsContact* contacts = (NexusPhysicsContact*)realloc(physics->contacts,
+                                                                      sizeof(NexusPhysicsContact) * capacity);
+        if (contacts == NULL) {
+            fprintf(stderr, "Failed to grow physics contact buffer!\n");
+            pair_count = (int32_t)physics->contact_capacity;
+        } else {
+            physics->contacts = contacts;
+            physics->contact_capacity = capacity;
+        }
+    }
+
+    nexus_jobs_parallel_for(physics->jobs, (uint32_t)pair_count, NEXUS_PHYSICS_PAIRS_PER_JOB,
+                            nexus_physics_narrowphase_job, physics);
+
+    /* Squeeze out the pairs that didn't touch */
+    uint32_t contact_count = 0;
+    for (int32_t i = 0; i < pair_count; i++) {
+        if (physics->contacts[i].entity_a != 0) {
+            physics->contacts[contact_count++] = physics->contacts[i];
+        }
+    }
+    physics->contact_count = contact_count;
+
+    uint64_t narrowphase_end = SDL_GetPerformanceCounter();
+
+    /* Stats */
+    physics->stats.proxy_count = (uint32_t)physics->broadphase->proxy_count;
+    physics->stats.moved_count = moved;
+    physics->stats.pair_count = (uint32_t)pair_count;
+    physics->stats.contact_count = contact_count;
+    physics->stats.tree_height = nexus_broadphase_get_height(physics->broadphase);
+    physics->stats.broadphase_ms = (double)(broadphase_end - start) * 1000.0 / (double)frequency;
+    physics->stats.narrowphase_ms = (double)(narrowphase_end - broadphase_end) * 1000.0 / (double)frequency;
+}
+
+/**
+ * Grow an array to hold at least count elements
+ */
+static bool nexus_physics_reserve(void** data, uint32_t* capacity, uint32_t count, size_t element_size) {
+    if (count <= *capacity) {
+        return true;
+    }
+
+    uint32_t new_capacity = *capacity ? *capacity : 64;
+    while (new_capacity < count) {
+        new_capacity *= 2;
+    }
+
+    void* grown = realloc(*data, element_size * new_capacity);
+    if (grown == NULL) {
+        fprintf(stderr, "Failed to grow physics solver buffer!\n");
+        return false;
+    }
+
+    *data = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+/**
+ * Gather awake bodies and apply gravity to their velocities
+ * Tables where every body sleeps are skipped and stay unwritten
+ */
+static void nexus_physics_gather_bodies(NexusPhysics* physics, float dt) {
+    physics->body_count = 0;
+
+    ecs_iter_t it = ecs_query_iter(physics->world, physics->body_query);
+    while (ecs_query_next(&it)) {
+        NexusRigidBodyComponent* bodies = ecs_field(&it, NexusRigidBodyComponent, 0);
+        NexusVelocityComponent* velocities = ecs_field(&it, NexusVelocityComponent, 1);
+        NexusPositionComponent* positions = ecs_field(&it, NexusPositionComponent, 2);
+
+        bool any_awake = false;
+        for (int i = 0; i < it.count && !any_awake; i++) {
+            any_awake = !bodies[i].sleeping;
+        }
+        if (!any_awake) {
+            ecs_iter_skip(&it);
+            continue;
+        }
+
+        if (!nexus_physics_reserve((void**)&physics->bodies, &physics->body_capacity,
+                                   physics->body_count + (uint32_t)it.count, sizeof(NexusPhysicsBody))) {
+            continue;
+        }
+
+        for (int i = 0; i < it.count; i++) {
+            if (bodies[i].sleeping) {
+                continue;
+            }
+
+            int32_t index = (int32_t)physics->body_count++;
+            NexusPhysicsBody* body = &physics->bodies[index];
+            body->entity = it.entities[i];
+            body->position = &positions[i];
+            body->velocity = &velocities[i];
+            body->body = &bodies[i];
+            body->inv_mass = (bodies[i].kinematic || bodies[i].mass <= 0.0f) ? 0.0f : 1.0f / bodies[i].mass;
+            body->parent = index;
+            body->island = -1;
+            bodies[i].solver_index = index;
+
+            if (body->inv_mass > 0.0f) {
+                vec3 dv;
+                glm_vec3_scale(physics->config.gravity, dt, dv);
+                glm_vec3_add(velocities[i].linear, dv, velocities[i].linear);
+            }
+        }
+    }
+}
+
+/**
+ * Find the body slot of a contact entity, waking sleeping bodies that were touched
+ * Returns -1 for static colliders and bodies that only wake up this step
+ */
+static int32_t nexus_physics_find_body(NexusPhysics* physics, ecs_entity_t entity, bool* trigger) {
+    NexusRigidBodyComponent* body = ecs_get_mut(physics->world, entity, NexusRigidBodyComponent);
+    if (body == NULL) {
+        return -1;
+    }
+
+    if (body->trigger) {
+        *trigger = true;
+    }
+
+    if (body->sleeping) {
+        body->sleeping = false;
+        body->still_frames = 0;
+        return -1;
+    }
+
+    int32_t index = body->solver_index;
+    if (index < 0 || (uint32_t)index >= physics->body_count || physics->bodies[index].entity != entity) {
+        return -1;
+    }
+
+    return index;
+}
+
+/**
+ * Union-find root with path halving
+ */
+static int32_t nexus_physics_island_root(NexusPhysicsBody* bodies, int32_t index) {
+    while (bodies[index].parent != index) {
+        bodies[index].parent = bodies[bodies[index].parent].parent;
+        index = bodies[index].parent;
+    }
+    return index;
+}
+
+/**
+ * Order solver contacts by island
+ */
+static int nexus_physics_contact_island_compare(const void* a, const void* b) {
+    int32_t ia = ((const NexusPhysicsSolverContact*)a)->island;
+    int32_t ib = ((const NexusPhysicsSolverContact*)b)->island;
+    return (ia > ib) - (ia < ib);
+}
+
+/**
+ * Turn contacts into solver contacts and group bodies into islands
+ */
+static void nexus_physics_build_islands(NexusPhysics* physics) {
+    NexusPhysicsBody* bodies = physics->bodies;
+    physics->solver_contact_count = 0;
+    physics->island_count = 0;
+
+    if (!nexus_physics_reserve((void**)&physics->solver_contacts, &physics->solver_contact_capacity,
+                               physics->contact_count, sizeof(NexusPhysicsSolverContact))) {
+        return;
+    }
+
+    /* Solver contacts, dynamic bodies in contact share an island */
+    for (uint32_t i = 0; i < physics->contact_count; i++) {
+        const NexusPhysicsContact* contact = &physics->contacts[i];
+        bool trigger = false;
+        int32_t a = nexus_physics_find_body(physics, contact->entity_a, &trigger);
+        int32_t b = nexus_physics_find_body(physics, contact->entity_b, &trigger);
+
+        float inv_mass_a = a >= 0 ? bodies[a].inv_mass : 0.0f;
+        float inv_mass_b = b >= 0 ? bodies[b].inv_mass : 0.0f;
+        if (trigger || inv_mass_a + inv_mass_b <= 0.0f) {
+            continue;
+        }
+
+        NexusPhysicsSolverContact* sc = &physics->solver_contacts[physics->solver_contact_count++];
+        memset(sc, 0, sizeof(NexusPhysicsSolverContact));
+        sc->body_a = a;
+        sc->body_b = b;
+        glm_vec3_copy((float*)contact->normal, sc->normal);
+        sc->penetration = contact->penetration;
+
+        /* Combined material */
+        float friction_a = a >= 0 ? bodies[a].body->friction : 0.5f;
+        float friction_b = b >= 0 ? bodies[b].body->friction : 0.5f;
+        float restitution_a = a >= 0 ? bodies[a].body->restitution : 0.0f;
+        float restitution_b = b >= 0 ? bodies[b].body->restitution : 0.0f;
+        sc->friction = sqrtf(glm_max(friction_a, 0.0f) * glm_max(friction_b, 0.0f));
+
+        vec3 relative = {0.0f, 0.0f, 0.0f};
+        if (b >= 0) glm_vec3_add(relative, bodies[b].velocity->linear, relative);
+        if (a >= 0) glm_vec3_sub(relative, bodies[a].velocity->linear, relative);
+        float approach = glm_vec3_dot(relative, sc->normal);
+        sc->bounce = approach < -NEXUS_PHYSICS_BOUNCE_THRESHOLD ? -glm_max(restitution_a, restitution_b) * approach : 0.0f;
+
+        /* Friction basis */
+        vec3 helper = {1.0f, 0.0f, 0.0f};
+        if (fabsf(sc->normal[0]) > 0.57735f) {
+            helper[0] = 0.0f;
+            helper[1] = 1.0f;
+        }
+        glm_vec3_cross(sc->normal, helper, sc->tangent[0]);
+        glm_vec3_normalize(sc->tangent[0]);
+        glm_vec3_cross(sc->normal, sc->tangent[0], sc->tangent[1]);
+
+        if (inv_mass_a > 0.0f && inv_mass_b > 0.0f) {
+            int32_t root_a = nexus_physics_island_root(bodies, a);
+            int32_t root_b = nexus_physics_island_root(bodies, b);
+            if (root_a != root_b) {
+                bodies[root_a].parent = root_b;
+            }
+        }
+    }
+
+    /* Number the islands, the island body list shares the island capacity */
+    uint32_t island_capacity = physics->island_capacity;
+    if (!nexus_physics_reserve((void**)&physics->islands, &physics->island_capacity,
+                               physics->body_count, sizeof(NexusPhysicsIsland))) {
+        physics->solver_contact_count = 0;
+        return;
+    }
+    if (physics->island_capacity != island_capacity) {
+        int32_t* island_bodies = (int32_t*)realloc(physics->island_bodies,
+                                                   sizeof(int32_t) * physics->island_capacity);
+        if (island_bodies == NULL) {
+            fprintf(stderr, "Failed to grow physics island buffer!\n");
+            free(physics->island_bodies);
+            physics->island_bodies = NULL;
+            physics->island_capacity = 0;
+            free(physics->islands);
+            physics->islands = NULL;
+            physics->solver_contact_count = 0;
+            return;
+        }
+        physics->island_bodies = island_bodies;
+    }
+
+    /* Kinematic bodies belong to no island, the islands touching them only read them */
+    for (uint32_t i = 0; i < physics->body_count; i++) {
+        if (bodies[i].inv_mass <= 0.0f) {
+            continue;
+        }
+
+        int32_t root = nexus_physics_island_root(bodies, (int32_t)i);
+        if (bodies[root].island < 0) {
+            NexusPhysicsIsland* island = &physics->islands[physics->island_count];
+            memset(island, 0, sizeof(NexusPhysicsIsland));
+            bodies[root].island = (int32_t)physics->island_count++;
+        }
+        bodies[i].island = bodies[root].island;
+        physics->islands[bodies[i].island].body_count++;
+    }
+
+    /* Bodies grouped by island */
+    int32_t offset = 0;
+    for (uint32_t i = 0; i < physics->island_count; i++) {
+        physics->islands[i].body_first = offset;
+        offset += physics->islands[i].body_count;
+        physics->islands[i].body_count = 0;
+    }
+    for (uint32_t i = 0; i < physics->body_count; i++) {
+        if (bodies[i].island < 0) {
+            continue;
+        }
+        NexusPhysicsIsland* island = &physics->islands[bodies[i].island];
+        physics->island_bodies[island->body_first + island->body_count++] = (int32_t)i;
+    }
+
+    /* Contacts grouped by island (the dynamic side decides) */
+    for (uint32_t i = 0; i < physics->solver_contact_count; i++) {
+        NexusPhysicsSolverContact* sc = &physics->solver_contacts[i];
+        int32_t owner = (sc->body_a >= 0 && bodies[sc->body_a].inv_mass > 0.0f) ? sc->body_a : sc->body_b;
+        sc->island = bodies[owner].island;
+    }
+    qsort(physics->solver_contacts, physics->solver_contact_count, sizeof(NexusPhysicsSolverContact),
+          nexus_physics_contact_island_compare);
+
+    for (uint32_t i = 0; i < physics->solver_contact_count; i++) {
+        NexusPhysicsIsland* island = &physics->islands[physics->solver_contacts[i].island];
+        if (island->contact_count == 0) {
+            island->contact_first = (int32_t)i;
+        }
+        island->contact_count++;
+    }
+}
+
+/**
+ * Apply an impulse along a direction to the dynamic bodies of a contact
+ * Kinematic bodies are shared by islands and never written
+ */
+static inline void nexus_physics_apply_contact_impulse(NexusPhysicsBody* bodies, const NexusPhysicsSolverContact* sc,
+                                                       const vec3 direction, float impulse) {
+    bool move_a = sc->body_a >= 0 && bodies[sc->body_a].inv_mass > 0.0f;
+    bool move_b = sc->body_b >= 0 && bodies[sc->body_b].inv_mass > 0.0f;
+    for (int k = 0; k < 3; k++) {
+        if (move_a) bodies[sc->body_a].velocity->linear[k] -= direction[k] * impulse * bodies[sc->body_a].inv_mass;
+        if (move_b) bodies[sc->body_b].velocity->linear[k] += direction[k] * impulse * bodies[sc->body_b].inv_mass;
+    }
+}
+
+/**
+ * Relative velocity of a contact along a direction
+ */
+static inline float nexus_physics_contact_speed(const NexusPhysicsBody* bodies, const NexusPhysicsSolverContact* sc,
+                                                const vec3 direction) {
+    float speed = 0.0f;
+    for (int k = 0; k < 3; k++) {
+        float vb = sc->body_b >= 0 ? bodies[sc->body_b].velocity->linear[k] : 0.0f;
+        float va = sc->body_a >= 0 ? bodies[sc->body_a].velocity->linear[k] : 0.0f;
+        speed += (vb - va) * direction[k];
+    }
+    return speed;
+}
+
+/**
+ * Solve a range of islands: sequential impulses, integration, penetration
+ * correction and sleep tracking
+ * Islands share no dynamic bodies and only read kinematic ones, so disjoint
+ * ranges can run on different threads
+ */
+static void nexus_physics_solve_islands(NexusPhysics* physics, uint32_t first, uint32_t end, float dt) {
+    NexusPhysicsBody* bodies = physics->bodies;
+    float sleep_speed_sq = physics->config.sleep_velocity * physics->config.sleep_velocity;
+
+    for (uint32_t i = first; i < end; i++) {
+        NexusPhysicsIsland* island = &physics->islands[i];
+        NexusPhysicsSolverContact* contacts = &physics->solver_contacts[island->contact_first];
+        const int32_t* members = &physics->island_bodies[island->body_first];
+
+        /* Velocity constraints */
+        for (int iteration = 0; iteration < physics->config.solver_iterations; iteration++) {
+            for (int32_t c = 0; c < island->contact_count; c++) {
+                NexusPhysicsSolverContact* sc = &contacts[c];
+                float inv_mass_a = sc->body_a >= 0 ? bodies[sc->body_a].inv_mass : 0.0f;
+                float inv_mass_b = sc->body_b >= 0 ? bodies[sc->body_b].inv_mass : 0.0f;
+                float effective = 1.0f / (inv_mass_a + inv_mass_b);
+
+                /* Non-penetration with restitution, accumulated impulse stays positive */
+                float vn = nexus_physics_contact_speed(bodies, sc, sc->normal);
+                float lambda = (sc->bounce - vn) * effective;
+                float total = glm_max(sc->normal_impulse + lambda, 0.0f);
+                nexus_physics_apply_contact_impulse(bodies, sc, sc->normal, total - sc->normal_impulse);
+                sc->normal_impulse = total;
+
+                /* Coulomb friction bounded by the normal impulse */
+                float limit = sc->friction * sc->normal_impulse;
+                for (int t = 0; t < 2; t++) {
+                    float vt = nexus_physics_contact_speed(bodies, sc, sc->tangent[t]);
+                    float friction = glm_clamp(sc->tangent_impulse[t] - vt * effective, -limit, limit);
+                    nexus_physics_apply_contact_impulse(bodies, sc, sc->tangent[t], friction - sc->tangent_impulse[t]);
+                    sc->tangent_impulse[t] = friction;
                 }
             }
         }
+
+        /* Integrate positions */
+        for (int32_t b = 0; b < island->body_count; b++) {
+            NexusPhysicsBody* body = &bodies[members[b]];
+            vec3 delta;
+            glm_vec3_scale(body->velocity->linear, dt, delta);
+            glm_vec3_add(body->position->value, delta, body->position->value);
+        }
+
+        /* Push bodies apart along the normal */
+        for (int32_t c = 0; c < island->contact_count; c++) {
+            NexusPhysicsSolverContact* sc = &contacts[c];
+            float inv_mass_a = sc->body_a >= 0 ? bodies[sc->body_a].inv_mass : 0.0f;
+            float inv_mass_b = sc->body_b >= 0 ? bodies[sc->body_b].inv_mass : 0.0f;
+            float correction = glm_max(sc->penetration - NEXUS_PHYSICS_PENETRATION_SLOP, 0.0f) *
+                               NEXUS_PHYSICS_BAUMGARTE / (inv_mass_a + inv_mass_b);
+
+            for (int k = 0; k < 3; k++) {
+                if (inv_mass_a > 0.0f) bodies[sc->body_a].position->value[k] -= sc->normal[k] * correction * inv_mass_a;
+                if (inv_mass_b > 0.0f) bodies[sc->body_b].position->value[k] += sc->normal[k] * correction * inv_mass_b;
+            }
+        }
+
+        /* The island sleeps once all of its dynamic bodies stayed still long enough */
+        int32_t still = INT32_MAX;
+        for (int32_t b = 0; b < island->body_count; b++) {
+            NexusPhysicsBody* body = &bodies[members[b]];
+            if (body->inv_mass <= 0.0f) {
+                continue;
+            }
+
+            if (glm_vec3_norm2(body->velocity->linear) < sleep_speed_sq) {
+                body->body->still_frames++;
+            } else {
+                body->body->still_frames = 0;
+            }
+            if (body->body->still_frames < still) {
+                still = body->body->still_frames;
+            }
+        }
+
+        if (still != INT32_MAX && still >= physics->config.sleep_frames) {
+            for (int32_t b = 0; b < island->body_count; b++) {
+                NexusPhysicsBody* body = &bodies[members[b]];
+                if (body->inv_mass > 0.0f) {
+                    body->body->sleeping = true;
+                    glm_vec3_zero(body->velocity->linear);
+                    glm_vec3_zero(body->velocity->angular);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Island solver job
+ */
+typedef struct {
+    NexusPhysics* physics;         /* Physics system */
+    float dt;                      /* Step length */
+} NexusPhysicsSolveJob;
+
+static void nexus_physics_solve_job(void* data, uint32_t first, uint32_t end) {
+    NexusPhysicsSolveJob* job = (NexusPhysicsSolveJob*)data;
+    nexus_physics_solve_islands(job->physics, first, end, job->dt);
+}
+
+/**
+ * Advance the simulation by one fixed step
+ */
+void nexus_physics_step(NexusPhysics* physics, float dt) {
+    if (physics == NULL || physics->body_query == NULL || dt <= 0.0f) {
+        return;
+    }
+
+    /* Gravity on awake bodies, then contacts at the current positions */
+    nexus_physics_gather_bodies(physics, dt);
+    nexus_physics_detect_collisions(physics);
+
+    uint64_t frequency = SDL_GetPerformanceFrequency();
+    uint64_t start = SDL_GetPerformanceCounter();
+
+    nexus_physics_build_islands(physics);
+    NexusPhysicsSolveJob solve = { physics, dt };
+    nexus_jobs_parallel_for(physics->jobs, physics->island_count, NEXUS_PHYSICS_ISLANDS_PER_JOB,
+                            nexus_physics_solve_job, &solve);
+
+    /* Kinematic bodies move once the islands stopped reading them */
+    for (uint32_t i = 0; i < physics->body_count; i++) {
+        NexusPhysicsBody* body = &physics->bodies[i];
+        if (body->inv_mass <= 0.0f) {
+            vec3 delta;
+            glm_vec3_scale(body->velocity->linear, dt, delta);
+            glm_vec3_add(body->position->value, delta, body->position->value);
+        }
+    }
+
+    /* Stats */
+    uint32_t slept = 0;
+    for (uint32_t i = 0; i < physics->island_count; i++) {
+        const NexusPhysicsIsland* island = &physics->islands[i];
+        for (int32_t b = 0; b < island->body_count; b++) {
+            const NexusPhysicsBody* body = &physics->bodies[physics->island_bodies[island->body_first + b]];
+            if (body->body->sleeping) {
+                slept++;
+                break;
+            }
+        }
     }
 
-    /* Clean up */
-    ecs_query_fini(query);
+    physics->stats.awake_bodies = physics->body_count;
+    physics->stats.island_count = physics->island_count;
+    physics->stats.islands_slept = slept;
+    physics->stats.solver_ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)frequency;
+}
 
-    /* Set output parameters if hit was found */
-    if (hit_found) {
-        if (hit_entity) *hit_entity = closest_entity;
-        if (hit_point) glm_vec3_copy(closest_point, hit_point);
-        if (hit_normal) glm_vec3_copy(closest_normal, hit_normal);
-        if (hit_distance) *hit_distance = closest_distance;
+/**
+ * Wake a sleeping body (its island follows on the next contact)
+ */
+void nexus_physics_wake_body(NexusPhysics* physics, ecs_entity_t entity) {
+    if (physics == NULL || physics->world == NULL || entity == 0) {
+        return;
     }
 
-    return hit_found;
+    NexusRigidBodyComponent* body = ecs_get_mut(physics->world, entity, NexusRigidBodyComponent);
+    if (body != NULL) {
+        body->sleeping = false;
+        body->still_frames = 0;
+    }
+}
+
+/**
+ * Apply a linear impulse to a body and wake it
+ */
+void nexus_physics_apply_impulse(NexusPhysics* physics, ecs_entity_t entity, const vec3 impulse) {
+    if (physics == NULL || physics->world == NULL || entity == 0 || impulse == NULL) {
+        return;
+    }
+
+    const NexusRigidBodyComponent* body = ecs_get(physics->world, entity, NexusRigidBodyComponent);
+    NexusVelocityComponent* velocity = ecs_get_mut(physics->world, entity, NexusVelocityComponent);
+    if (body == NULL || velocity == NULL || body->kinematic || body->mass <= 0.0f) {
+        return;
+    }
+
+    for (int k = 0; k < 3; k++) {
+        velocity->linear[k] += impulse[k] / body->mass;
+    }
+
+    nexus_physics_wake_body(physics, entity);
+}
+
+/**
+ * Get the phase whose systems run once per fixed step
+ */
+ecs_entity_t nexus_physics_get_phase(const NexusPhysics* physics) {
+    if (physics == NULL) {
+        return 0;
+    }
+    return physics->phase;
+}
+
+/**
+ * Get how far the render state is between the previous and the current step
+ */
+float nexus_physics_get_interpolation_alpha(const NexusPhysics* physics) {
+    if (physics == NULL) {
+        return 1.0f;
+    }
+    return physics->interpolation_alpha;
+}
+
+/**
+ * Set the job system the step and batched raycasts are split across
+ * NULL keeps all work on the calling thread
+ */
+void nexus_physics_set_job_system(NexusPhysics* physics, NexusJobSystem* jobs) {
+    if (physics == NULL) {
+        return;
+    }
+    physics->jobs = jobs;
+}
+
+/**
+ * Get the contacts of the last step
+ */
+const NexusPhysicsContact* nexus_physics_get_contacts(const NexusPhysics* physics, uint32_t* count) {
+    if (physics == NULL) {
+        if (count) *count = 0;
+        return NULL;
+    }
+
+    if (count) *count = physics->contact_count;
+    return physics->contacts;
+}
+
+/**
+ * Get collision detection statistics of the last step
+ */
+NexusPhysicsStats nexus_physics_get_stats(const NexusPhysics* physics) {
+    NexusPhysicsStats stats;
+    memset(&stats, 0, sizeof(stats));
+
+    if (physics != NULL) {
+        stats = physics->stats;
+    }
+
+    return stats;
+}
+
+/**
+ * Remove broadphase proxies of colliders that are removed or deleted
+ */
+static void nexus_physics_collider_removed(ecs_iter_t *it) {
+    NexusPhysics* physics = (NexusPhysics*)it->ctx;
+    NexusColliderComponent* colliders = ecs_field(it, NexusColliderComponent, 0);
+
+    for (int i = 0; i < it->count; i++) {
+        if (colliders[i].in_broadphase) {
+            nexus_broadphase_destroy_proxy(physics->broadphase, colliders[i].proxy);
+            colliders[i].in_broadphase = false;
+        }
+    }
+}
+
+/**
+ * Register physics components
+ */
+void nexus_physics_register_components(ecs_world_t* world) {
+    if (world == NULL) {
+        return;
+    }
+
+    ECS_COMPONENT_DEFINE(world, NexusColliderComponent);
+}
+
+/**
+ * Raycast state shared with the broadphase visitor
+ */
+typedef struct {
+    NexusPhysics* physics;         /* Physics system */
+    NexusRay ray;                  /* Normalized ray */
+    NexusPhysicsRayHit* hit;       /* Closest hit so far */
+} NexusPhysicsRaycastContext;
+
+/**
+ * Intersect a ray with a collider shape
+ * Shapes other than spheres and boxes are tested as their bounding box
+ */
+static bool nexus_physics_ray_shape(const NexusCollisionShape* shape, const vec3 position, mat4 rotation,
+                                    const NexusRay* ray, float* out_t, vec3 normal) {
+    if (shape->type == NEXUS_COLLISION_SHAPE_SPHERE) {
+        float t;
+        if (!nexus_ray_sphere_intersect(ray, position, shape->data.sphere.radius, &t)) {
+            return false;
+        }
+        for (int k = 0; k < 3; k++) {
+            normal[k] = (ray->origin[k] + ray->direction[k] * t - position[k]) / shape->data.sphere.radius;
+        }
+        *out_t = t;
+        return true;
+    }
+
+    vec3 half_extents;
+    if (!nexus_collision_shape_get_local_box(shape, half_extents)) {
+        return false;
+    }
+
+    /* Slab test in box space */
+    NexusRay local;
+    vec3 delta = { ray->origin[0] - position[0], ray->origin[1] - position[1], ray->origin[2] - position[2] };
+    for (int i = 0; i < 3; i++) {
+        local.origin[i] = delta[0] * rotation[i][0] + delta[1] * rotation[i][1] + delta[2] * rotation[i][2];
+        local.direction[i] = ray->direction[0] * rotation[i][0] + ray->direction[1] * rotation[i][1] +
+                             ray->direction[2] * rotation[i][2];
+    }
+
+    vec3 box_min = { -half_extents[0], -half_extents[1], -half_extents[2] };
+    float t;
+    if (!nexus_ray_aabb_intersect(&local, box_min, half_extents, &t)) {
+        return false;
+    }
+
+    /* Face normal from the axis the hit point lies furthest out on */
+    int axis = 0;
+    float best = -1.0f;
+    float sign = 1.0f;
+    for (int i = 0; i < 3; i++) {
+        float p = local.origin[i] + local.direction[i] * t;
+        float d = half_extents[i] > 0.0f ? fabsf(p) / half_extents[i] : 0.0f;
+        if (d > best) {
+            best = d;
+            axis = i;
+            sign = p < 0.0f ? -1.0f : 1.0f;
+        }
+    }
+
+    for (int k = 0; k < 3; k++) {
+        normal[k] = rotation[axis][k] * sign;
+    }
+    *out_t = t;
+    return true;
+}
+
+/**
+ * Broadphase visitor: exact test against the collider behind a proxy
+ */
+static float nexus_physics_raycast_visit(void* user_data, int32_t proxy, ecs_entity_t entity, float max_distance) {
+    NexusPhysicsRaycastContext* context = (NexusPhysicsRaycastContext*)user_data;
+    const NexusCollisionShape* shape;
+    vec3 position;
+    mat4 rotation;
+    float t;
+    vec3 normal;
+
+    if (!nexus_physics_get_collider(context->physics->world, entity, &shape, position, rotation)) {
+        return max_distance;
+    }
+
+    if (!nexus_physics_ray_shape(shape, position, rotation, &context->ray, &t, normal) || t >= max_distance) {
+        return max_distance;
+    }
+
+    /* Closest so far, clip the ray to it */
+    NexusPhysicsRayHit* hit = context->hit;
+    hit->hit = true;
+    hit->entity = entity;
+    hit->distance = t;
+    glm_vec3_copy(normal, hit->normal);
+    for (int k = 0; k < 3; k++) {
+        hit->point[k] = context->ray.origin[k] + context->ray.direction[k] * t;
+    }
+
+    return t;
+}
+
+/**
+ * Cast one ray through the broadphase
+ */
+static void nexus_physics_raycast_one(NexusPhysics* physics, const NexusPhysicsRay* ray, NexusPhysicsRayHit* hit) {
+    memset(hit, 0, sizeof(NexusPhysicsRayHit));
+    hit->distance = ray->max_distance;
+
+    NexusPhysicsRaycastContext context;
+    context.physics = physics;
+    context.hit = hit;
+    nexus_ray_set(&context.ray, ray->origin[0], ray->origin[1], ray->origin[2],
+                  ray->direction[0], ray->direction[1], ray->direction[2]);
+
+    /* Zero-length directions normalize to NaN */
+    if (!(glm_vec3_norm2(context.ray.direction) > 0.0f) || ray->max_distance <= 0.0f) {
+        return;
+    }
+
+    nexus_broadphase_raycast(physics->broadphase, context.ray.origin, context.ray.direction, ray->max_distance,
+                             nexus_physics_raycast_visit, &context);
+}
+
+/**
+ * Perform a raycast in the physics world
+ */
+bool nexus_physics_raycast(NexusPhysics* physics, const vec3 origin, const vec3 direction, float max_distance,
+                         ecs_entity_t* hit_entity, vec3 hit_point, vec3 hit_normal, float* hit_distance) {
+    if (physics == NULL || physics->world == NULL || physics->broadphase == NULL) {
+        return false;
+    }
+
+    NexusPhysicsRay ray;
+    glm_vec3_copy((float*)origin, ray.origin);
+    glm_vec3_copy((float*)direction, ray.direction);
+    ray.max_distance = max_distance;
+
+    NexusPhysicsRayHit hit;
+    nexus_physics_raycast_one(physics, &ray, &hit);
+
+    /* Set output parameters */
+    if (hit_entity) *hit_entity = hit.entity;
+    if (hit_point) glm_vec3_copy(hit.point, hit_point);
+    if (hit_normal) glm_vec3_copy(hit.normal, hit_normal);
+    if (hit_distance) *hit_distance = hit.distance;
+
+    return hit.hit;
+}
+
+/**
+ * Batched raycast job
+ */
+typedef struct {
+    NexusPhysics* physics;         /* Physics system */
+    const NexusPhysicsRay* rays;   /* Rays of the batch */
+    NexusPhysicsRayHit* hits;      /* Results of the batch */
+    SDL_AtomicInt hit_count;       /* Rays that hit something */
+} NexusPhysicsRaycastJob;
+
+/**
+ * Cast a range of rays
+ */
+static void nexus_physics_raycast_job(void* data, uint32_t first, uint32_t end) {
+    NexusPhysicsRaycastJob* job = (NexusPhysicsRaycastJob*)data;
+    int hit_count = 0;
+
+    for (uint32_t i = first; i < end; i++) {
+        nexus_physics_raycast_one(job->physics, &job->rays[i], &job->hits[i]);
+        if (job->hits[i].hit) {
+            hit_count++;
+        }
+    }
+
+    if (hit_count > 0) {
+        SDL_AddAtomicInt(&job->hit_count, hit_count);
+    }
+}
+
+/**
+ * Cast many rays, large batches are split across the job system
+ * The world must not change while the batch runs (call it between steps
+ * or from a read-only phase), returns the number of rays that hit
+ */
+uint32_t nexus_physics_raycast_batch(NexusPhysics* physics, const NexusPhysicsRay* rays, NexusPhysicsRayHit* hits,
+                                     uint32_t count) {
+    if (physics == NULL || physics->broadphase == NULL || rays == NULL || hits == NULL || count == 0) {
+        return 0;
+    }
+
+    NexusPhysicsRaycastJob job;
+    job.physics = physics;
+    job.rays = rays;
+    job.hits = hits;
+    SDL_SetAtomicInt(&job.hit_count, 0);
+
+    nexus_jobs_parallel_for(physics->jobs, count, NEXUS_PHYSICS_RAYS_PER_JOB, nexus_physics_raycast_job, &job);
+
+    return (uint32_t)SDL_GetAtomicInt(&job.hit_count);
 }
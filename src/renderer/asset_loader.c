@@ -0,0 +1,490 @@
+/**
+ * Nexus3D Asset Loader Implementation
+ * Decode jobs, camera distance prioritization and budgeted uploads
+ */
+
+#include "nexus3d/renderer/asset_loader.h"
+#include "nexus3d/renderer/mesh_file.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Asset handles per pool chunk */
+#define NEXUS_ASSET_POOL_CHUNK 64
+
+/**
+ * Decode job, reads and decodes the file into CPU memory
+ */
+static void nexus_asset_decode_job(void* data) {
+    NexusAsset* asset = (NexusAsset*)data;
+
+    if (asset->type == NEXUS_ASSET_MESH) {
+        asset->decode_success = nexus_mesh_data_load_file(asset->path, &asset->mesh_data);
+    } else {
+        asset->decode_success = nexus_texture_decode_file(asset->path, &asset->image);
+    }
+}
+
+/**
+ * Free an asset and everything it owns
+ * Its decode job must have finished
+ */
+static void nexus_asset_free(NexusAsset* asset) {
+    NexusAssetLoader* loader = asset->loader;
+
+    /* Unlink from the live list */
+    if (asset->prev != NULL) {
+        asset->prev->next = asset->next;
+    } else {
+        loader->assets = asset->next;
+    }
+    if (asset->next != NULL) {
+        asset->next->prev = asset->prev;
+    }
+
+    nexus_mesh_destroy(asset->mesh);
+    nexus_texture_destroy(asset->texture);
+    nexus_mesh_data_free(&asset->mesh_data);
+    nexus_image_data_free(&asset->image);
+
+    nexus_pool_free(&loader->asset_pool, asset);
+}
+
+/**
+ * Upload a decoded asset, returns the number of bytes staged
+ */
+static uint32_t nexus_asset_upload(NexusAsset* asset) {
+    NexusAssetLoader* loader = asset->loader;
+    uint32_t bytes = 0;
+
+    if (asset->type == NEXUS_ASSET_MESH) {
+        asset->mesh_data.vertex_layout = loader->vertex_layout;
+        asset->mesh = nexus_mesh_create_from_data(loader->device, &asset->mesh_data);
+        if (asset->mesh != NULL) {
+            bytes = asset->mesh->vertex_count * nexus_vertex_layout_get_stride(asset->mesh->vertex_layout) +
+                    asset->mesh->index_count *
+                    (asset->mesh->index_size == SDL_GPU_INDEXELEMENTSIZE_16BIT ? 2u : 4u);
+        }
+        nexus_mesh_data_free(&asset->mesh_data);
+    } else {
+        /* Texture name without the directory */
+        const char* name = strrchr(asset->path, '/');
+        name = name != NULL ? name + 1 : asset->path;
+
+        bytes = (uint32_t)asset->image.size;
+        asset->texture = nexus_texture_create_from_image(loader->device, name, &asset->image,
+                                                         asset->generate_mipmaps);
+        nexus_image_data_free(&asset->image);
+    }
+
+    bool success = asset->mesh != NULL || asset->texture != NULL;
+    SDL_SetAtomicInt(&asset->state, success ? NEXUS_ASSET_READY : NEXUS_ASSET_FAILED);
+    if (success) {
+        loader->stats.bytes_uploaded += bytes;
+    } else {
+        fprintf(stderr, "Failed to upload asset '%s'!\n", asset->path);
+    }
+
+    return bytes;
+}
+
+/**
+ * Order pending assets: unpositioned first, then nearest to the camera
+ */
+static int nexus_asset_priority_compare(const void* a, const void* b) {
+    const NexusAsset* asset_a = *(const NexusAsset* const*)a;
+    const NexusAsset* asset_b = *(const NexusAsset* const*)b;
+
+    if (asset_a->has_position != asset_b->has_position) {
+        return asset_a->has_position ? 1 : -1;
+    }
+    if (asset_a->distance_sq < asset_b->distance_sq) return -1;
+    if (asset_a->distance_sq > asset_b->distance_sq) return 1;
+    return 0;
+}
+
+/**
+ * Create an asset loader
+ */
+NexusAssetLoader* nexus_asset_loader_create(SDL_GPUDevice* device, NexusJobSystem* jobs) {
+    if (device == NULL) {
+        fprintf(stderr, "GPU device cannot be NULL when creating asset loader!\n");
+        return NULL;
+    }
+
+    /* Allocate asset loader structure */
+    NexusAssetLoader* loader = (NexusAssetLoader*)malloc(sizeof(NexusAssetLoader));
+    if (loader == NULL) {
+        fprintf(stderr, "Failed to allocate memory for asset loader!\n");
+        return NULL;
+    }
+    memset(loader, 0, sizeof(NexusAssetLoader));
+
+    NexusPool asset_pool = NEXUS_POOL_INIT(NexusAsset, NEXUS_ASSET_POOL_CHUNK);
+    loader->asset_pool = asset_pool;
+    loader->device = device;
+    loader->jobs = jobs;
+    loader->max_in_flight = NEXUS_ASSET_DEFAULT_MAX_IN_FLIGHT;
+    loader->upload_budget = NEXUS_ASSET_DEFAULT_UPLOAD_BUDGET;
+    loader->vertex_layout = NEXUS_VERTEX_LAYOUT_DEFAULT;
+
+    return loader;
+}
+
+/**
+ * Destroy an asset loader and all assets it still owns
+ */
+void nexus_asset_loader_destroy(NexusAssetLoader* loader) {
+    if (loader == NULL) {
+        return;
+    }
+
+    /* Decode jobs write into the assets, let them finish first */
+    for (uint32_t i = 0; i < loader->pending_count; i++) {
+        NexusAsset* asset = loader->pending[i];
+        if (SDL_GetAtomicInt(&asset->state) == NEXUS_ASSET_LOADING) {
+            nexus_jobs_wait(loader->jobs, &asset->done);
+        }
+    }
+
+    while (loader->assets != NULL) {
+        nexus_asset_free(loader->assets);
+    }
+
+    free(loader->pending);
+    nexus_pool_release(&loader->asset_pool);
+    free(loader);
+}
+
+/**
+ * Set the decode jobs running at the same time and the bytes uploaded per update
+ */
+void nexus_asset_loader_set_limits(NexusAssetLoader* loader, uint32_t max_in_flight, uint32_t upload_budget) {
+    if (loader == NULL) {
+        return;
+    }
+
+    loader->max_in_flight = max_in_flight > 0 ? max_in_flight : 1;
+    loader->upload_budget = upload_budget > 0 ? upload_budget : 1;
+}
+
+/**
+ * Select the vertex layout meshes loaded from now on are uploaded in
+ */
+void nexus_asset_loader_set_vertex_layout(NexusAssetLoader* loader, uint32_t vertex_layout) {
+    if (loader == NULL) {
+        return;
+    }
+
+    if (nexus_vertex_layout_get(vertex_layout) == NULL) {
+        fprintf(stderr, "Unknown vertex layout %u!\n", vertex_layout);
+        return;
+    }
+
+    loader->vertex_layout = vertex_layout;
+}
+
+/**
+ * Advance pending requests
+ * Finished decode jobs are collected, the queue is ordered by distance to
+ * the camera (NULL keeps the previous order), queued requests are started
+ * up to the in-flight limit and decoded ones uploaded within the budget.
+ * The uploads go into the shared staging ring, which the renderer submits
+ * before the frame's draws. Call it from the thread owning the GPU device
+ */
+void nexus_asset_loader_update(NexusAssetLoader* loader, const float* camera_position) {
+    if (loader == NULL || loader->pending_count == 0) {
+        return;
+    }
+
+    /* Nearest requests first */
+    if (camera_position != NULL) {
+        for (uint32_t i = 0; i < loader->pending_count; i++) {
+            NexusAsset* asset = loader->pending[i];
+            float distance_sq = 0.0f;
+            if (asset->has_position) {
+                for (int k = 0; k < 3; k++) {
+                    float d = asset->position[k] - camera_position[k];
+                    distance_sq += d * d;
+                }
+            }
+            asset->distance_sq = distance_sq;
+        }
+    }
+    qsort(loader->pending, loader->pending_count, sizeof(NexusAsset*), nexus_asset_priority_compare);
+
+    uint32_t loading = 0;
+    for (uint32_t i = 0; i < loader->pending_count; i++) {
+        if (SDL_GetAtomicInt(&loader->pending[i]->state) == NEXUS_ASSET_LOADING) {
+            loading++;
+        }
+    }
+
+    /* Finished requests are compacted out and reported after the loop, so
+     * callbacks can queue new requests */
+    NexusScratch scratch = nexus_scratch_begin();
+    NexusAsset** finished = (NexusAsset**)nexus_scratch_alloc(&scratch, sizeof(NexusAsset*) * loader->pending_count);
+    uint32_t finished_count = 0;
+    uint32_t uploaded = 0;
+    uint32_t kept = 0;
+
+    for (uint32_t i = 0; i < loader->pending_count; i++) {
+        NexusAsset* asset = loader->pending[i];
+        NexusAssetState state = (NexusAssetState)SDL_GetAtomicInt(&asset->state);
+
+        /* Collect finished decode jobs */
+        if (state == NEXUS_ASSET_LOADING && nexus_job_counter_is_done(&asset->done)) {
+            loading--;
+            if (asset->released) {
+                nexus_asset_free(asset);
+                continue;
+            }
+            state = asset->decode_success ? NEXUS_ASSET_DECODED : NEXUS_ASSET_FAILED;
+            SDL_SetAtomicInt(&asset->state, state);
+        }
+
+        /* Start decode jobs, without a job system the request decodes right here */
+        if (state == NEXUS_ASSET_QUEUED && loading < loader->max_in_flight) {
+            nexus_job_counter_init(&asset->done);
+            SDL_SetAtomicInt(&asset->state, NEXUS_ASSET_LOADING);
+            nexus_jobs_run(loader->jobs, nexus_asset_decode_job, asset, &asset->done);
+
+            if (nexus_job_counter_is_done(&asset->done)) {
+                state = asset->decode_success ? NEXUS_ASSET_DECODED : NEXUS_ASSET_FAILED;
+                SDL_SetAtomicInt(&asset->state, state);
+            } else {
+                state = NEXUS_ASSET_LOADING;
+                loading++;
+            }
+        }
+
+        /* Upload within the budget, the nearest decoded asset always goes */
+        if (state == NEXUS_ASSET_DECODED && (uploaded == 0 || uploaded < loader->upload_budget)) {
+            uploaded += nexus_asset_upload(asset);
+            state = (NexusAssetState)SDL_GetAtomicInt(&asset->state);
+        }
+
+        if (state == NEXUS_ASSET_READY || state == NEXUS_ASSET_FAILED) {
+            if (state == NEXUS_ASSET_READY) {
+                loader->stats.loaded++;
+            } else {
+                loader->stats.failed++;
+            }
+            if (finished != NULL) {
+                finished[finished_count++] = asset;
+            }
+            continue;
+        }
+
+        loader->pending[kept++] = asset;
+    }
+    loader->pending_count = kept;
+
+    /* Stats */
+    loader->stats.queued = 0;
+    loader->stats.in_flight = 0;
+    for (uint32_t i = 0; i < loader->pending_count; i++) {
+        if (SDL_GetAtomicInt(&loader->pending[i]->state) == NEXUS_ASSET_QUEUED) {
+            loader->stats.queued++;
+        } else {
+            loader->stats.in_flight++;
+        }
+    }
+
+    /* Completion callbacks */
+    for (uint32_t i = 0; i < finished_count; i++) {
+        if (finished[i]->callback != NULL) {
+            finished[i]->callback(finished[i], finished[i]->user_data);
+        }
+    }
+
+    nexus_scratch_end(&scratch);
+}
+
+/**
+ * Block until every pending request is ready or has failed
+ * Runs decode jobs on the calling thread while it waits
+ */
+void nexus_asset_loader_wait(NexusAssetLoader* loader) {
+    if (loader == NULL) {
+        return;
+    }
+
+    while (loader->pending_count > 0) {
+        nexus_asset_loader_update(loader, NULL);
+
+        /* Help with the first decode job still running */
+        for (uint32_t i = 0; i < loader->pending_count; i++) {
+            NexusAsset* asset = loader->pending[i];
+            if (SDL_GetAtomicInt(&asset->state) == NEXUS_ASSET_LOADING) {
+                nexus_jobs_wait(loader->jobs, &asset->done);
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * Get the asset loader statistics
+ */
+NexusAssetLoaderStats nexus_asset_loader_get_stats(const NexusAssetLoader* loader) {
+    NexusAssetLoaderStats stats;
+    memset(&stats, 0, sizeof(NexusAssetLoaderStats));
+    if (loader == NULL) {
+        return stats;
+    }
+    return loader->stats;
+}
+
+/**
+ * Queue a load request
+ */
+static NexusAsset* nexus_asset_request(NexusAssetLoader* loader, NexusAssetType type, const char* path,
+                                       NexusAssetCallback callback, void* user_data) {
+    if (loader == NULL || path == NULL) {
+        return NULL;
+    }
+
+    if (strlen(path) >= NEXUS_ASSET_MAX_PATH) {
+        fprintf(stderr, "Asset path '%s' is too long!\n", path);
+        return NULL;
+    }
+
+    /* Grow the pending queue */
+    if (loader->pending_count == loader->pending_capacity) {
+        uint32_t capacity = loader->pending_capacity ? loader->pending_capacity * 2 : 64;
+        NexusAsset** pending = (NexusAsset**)realloc(loader->pending, sizeof(NexusAsset*) * capacity);
+        if (pending == NULL) {
+            fprintf(stderr, "Failed to grow asset queue!\n");
+            return NULL;
+        }
+        loader->pending = pending;
+        loader->pending_capacity = capacity;
+    }
+
+    /* Allocate asset structure */
+    NexusAsset* asset = (NexusAsset*)nexus_pool_alloc(&loader->asset_pool);
+    if (asset == NULL) {
+        fprintf(stderr, "Failed to allocate memory for asset!\n");
+        return NULL;
+    }
+    memset(asset, 0, sizeof(NexusAsset));
+
+    asset->loader = loader;
+    asset->type = type;
+    SDL_SetAtomicInt(&asset->state, NEXUS_ASSET_QUEUED);
+    strcpy(asset->path, path);
+    asset->callback = callback;
+    asset->user_data = user_data;
+    nexus_job_counter_init(&asset->done);
+
+    /* Link into the live list */
+    asset->next = loader->assets;
+    if (loader->assets != NULL) {
+        loader->assets->prev = asset;
+    }
+    loader->assets = asset;
+
+    loader->pending[loader->pending_count++] = asset;
+    loader->stats.queued++;
+
+    return asset;
+}
+
+/**
+ * Request a mesh from a cooked mesh or a Wavefront OBJ file
+ */
+NexusAsset* nexus_asset_load_mesh(NexusAssetLoader* loader, const char* path, NexusAssetCallback callback,
+                                  void* user_data) {
+    return nexus_asset_request(loader, NEXUS_ASSET_MESH, path, callback, user_data);
+}
+
+/**
+ * Request a texture from an image file
+ */
+NexusAsset* nexus_asset_load_texture(NexusAssetLoader* loader, const char* path, bool generate_mipmaps,
+                                     NexusAssetCallback callback, void* user_data) {
+    NexusAsset* asset = nexus_asset_request(loader, NEXUS_ASSET_TEXTURE, path, callback, user_data);
+    if (asset != NULL) {
+        asset->generate_mipmaps = generate_mipmaps;
+    }
+    return asset;
+}
+
+/**
+ * Release an asset and its GPU resource
+ * A running decode job is left to finish, the asset is freed by the next update
+ */
+void nexus_asset_release(NexusAsset* asset) {
+    if (asset == NULL) {
+        return;
+    }
+
+    NexusAssetLoader* loader = asset->loader;
+    if (SDL_GetAtomicInt(&asset->state) == NEXUS_ASSET_LOADING) {
+        asset->callback = NULL;
+        asset->released = true;
+        return;
+    }
+
+    /* Drop the request from the queue */
+    for (uint32_t i = 0; i < loader->pending_count; i++) {
+        if (loader->pending[i] == asset) {
+            loader->pending[i] = loader->pending[--loader->pending_count];
+            break;
+        }
+    }
+
+    nexus_asset_free(asset);
+}
+
+/**
+ * Set the world position an asset is needed at, nearer requests load first
+ */
+void nexus_asset_set_position(NexusAsset* asset, float x, float y, float z) {
+    if (asset == NULL) {
+        return;
+    }
+
+    asset->position[0] = x;
+    asset->position[1] = y;
+    asset->position[2] = z;
+    asset->has_position = true;
+}
+
+/**
+ * Get the loading state of an asset
+ */
+NexusAssetState nexus_asset_get_state(NexusAsset* asset) {
+    if (asset == NULL) {
+        return NEXUS_ASSET_FAILED;
+    }
+    return (NexusAssetState)SDL_GetAtomicInt(&asset->state);
+}
+
+/**
+ * Check whether an asset's GPU resource can be used
+ */
+bool nexus_asset_is_ready(NexusAsset* asset) {
+    return nexus_asset_get_state(asset) == NEXUS_ASSET_READY;
+}
+
+/**
+ * Get the mesh of a ready mesh asset
+ */
+NexusMesh* nexus_asset_get_mesh(NexusAsset* asset) {
+    if (!nexus_asset_is_ready(asset)) {
+        return NULL;
+    }
+    return asset->mesh;
+}
+
+/**
+ * Get the texture of a ready texture asset
+ */
+NexusTexture* nexus_asset_get_texture(NexusAsset* asset) {
+    if (!nexus_asset_is_ready(asset)) {
+        return NULL;
+    }
+    return asset->texture;
+}
@@ -0,0 +1,292 @@
+/**
+ * Nexus3D Culling Implementation
+ * Packed bounding box buffer and SIMD frustum tests
+ */
+
+#include "nexus3d/renderer/culling.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/* Alignment of each packed array (enough for 8-wide loads) */
+#define NEXUS_CULLING_ALIGNMENT 32
+
+/**
+ * (Re)allocate the packed arrays, keeping existing boxes
+ */
+static bool nexus_culling_buffer_reserve(NexusCullingBuffer* buffer, uint32_t capacity) {
+    if (capacity <= buffer->capacity) {
+        return true;
+    }
+
+    /* Grow geometrically and pad to the batch size */
+    uint32_t new_capacity = buffer->capacity > 0 ? buffer->capacity : 256;
+    while (new_capacity < capacity) {
+        new_capacity *= 2;
+    }
+    new_capacity = (new_capacity + NEXUS_CULLING_BATCH - 1) & ~(uint32_t)(NEXUS_CULLING_BATCH - 1);
+
+    /* Six float arrays and one byte array, each aligned */
+    size_t float_array = sizeof(float) * new_capacity;
+    size_t byte_array = new_capacity;
+    void* memory = malloc(float_array * 6 + byte_array + NEXUS_CULLING_ALIGNMENT);
+    if (memory == NULL) {
+        fprintf(stderr, "Failed to allocate culling buffer!\n");
+        return false;
+    }
+
+    uintptr_t base = ((uintptr_t)memory + NEXUS_CULLING_ALIGNMENT - 1) & ~(uintptr_t)(NEXUS_CULLING_ALIGNMENT - 1);
+    float* arrays[6];
+    for (int i = 0; i < 6; i++) {
+        arrays[i] = (float*)(base + float_array * i);
+    }
+    uint8_t* visible = (uint8_t*)(base + float_array * 6);
+
+    /* Copy existing boxes */
+    if (buffer->memory != NULL && buffer->count > 0) {
+        size_t used = sizeof(float) * buffer->count;
+        memcpy(arrays[0], buffer->center_x, used);
+        memcpy(arrays[1], buffer->center_y, used);
+        memcpy(arrays[2], buffer->center_z, used);
+        memcpy(arrays[3], buffer->extent_x, used);
+        memcpy(arrays[4], buffer->extent_y, used);
+        memcpy(arrays[5], buffer->extent_z, used);
+    }
+    free(buffer->memory);
+
+    buffer->memory = memory;
+    buffer->center_x = arrays[0];
+    buffer->center_y = arrays[1];
+    buffer->center_z = arrays[2];
+    buffer->extent_x = arrays[3];
+    buffer->extent_y = arrays[4];
+    buffer->extent_z = arrays[5];
+    buffer->visible = visible;
+    buffer->capacity = new_capacity;
+
+    return true;
+}
+
+/**
+ * Create a culling buffer
+ */
+NexusCullingBuffer* nexus_culling_buffer_create(uint32_t capacity) {
+    /* Allocate buffer structure */
+    NexusCullingBuffer* buffer = (NexusCullingBuffer*)malloc(sizeof(NexusCullingBuffer));
+    if (buffer == NULL) {
+        fprintf(stderr, "Failed to allocate memory for culling buffer!\n");
+        return NULL;
+    }
+
+    /* Initialize buffer structure */
+    memset(buffer, 0, sizeof(NexusCullingBuffer));
+
+    if (!nexus_culling_buffer_reserve(buffer, capacity > 0 ? capacity : 256)) {
+        free(buffer);
+        return NULL;
+    }
+
+    return buffer;
+}
+
+/**
+ * Destroy a culling buffer
+ */
+void nexus_culling_buffer_destroy(NexusCullingBuffer* buffer) {
+    if (buffer == NULL) {
+        return;
+    }
+
+    free(buffer->memory);
+    free(buffer);
+}
+
+/**
+ * Remove all boxes from the buffer
+ */
+void nexus_culling_buffer_reset(NexusCullingBuffer* buffer) {
+    if (buffer == NULL) {
+        return;
+    }
+
+    buffer->count = 0;
+}
+
+/**
+ * Append a world-space AABB to the buffer
+ */
+bool nexus_culling_buffer_add(NexusCullingBuffer* buffer, const float* min, const float* max) {
+    if (buffer == NULL || min == NULL || max == NULL) {
+        return false;
+    }
+
+    if (!nexus_culling_buffer_reserve(buffer, buffer->count + 1)) {
+        return false;
+    }
+
+    /* Store as center and half extents */
+    uint32_t i = buffer->count++;
+    buffer->center_x[i] = (min[0] + max[0]) * 0.5f;
+    buffer->center_y[i] = (min[1] + max[1]) * 0.5f;
+    buffer->center_z[i] = (min[2] + max[2]) * 0.5f;
+    buffer->extent_x[i] = (max[0] - min[0]) * 0.5f;
+    buffer->extent_y[i] = (max[1] - min[1]) * 0.5f;
+    buffer->extent_z[i] = (max[2] - min[2]) * 0.5f;
+
+    return true;
+}
+
+/**
+ * Test all boxes against six frustum planes (normalized, pointing inward)
+ * A box is outside if, for any plane, dot(n, c) + d + dot(|n|, e) < 0
+ * @return Number of visible boxes, per box results are written to buffer->visible
+ */
+uint32_t nexus_culling_buffer_test(NexusCullingBuffer* buffer, const vec4 planes[6]) {
+    if (buffer == NULL || planes == NULL || buffer->count == 0) {
+        return 0;
+    }
+
+    uint32_t count = buffer->count;
+    uint32_t padded = (count + NEXUS_CULLING_BATCH - 1) & ~(uint32_t)(NEXUS_CULLING_BATCH - 1);
+
+    /* Zero the padding so the tail batch reads defined values */
+    for (uint32_t i = count; i < padded; i++) {
+        buffer->center_x[i] = buffer->center_y[i] = buffer->center_z[i] = 0.0f;
+        buffer->extent_x[i] = buffer->extent_y[i] = buffer->extent_z[i] = 0.0f;
+    }
+
+    uint32_t visible_count = 0;
+    uint32_t i = 0;
+
+#if defined(__AVX__)
+    /* 8 boxes per iteration */
+    for (; i < padded; i += 8) {
+        __m256 cx = _mm256_load_ps(buffer->center_x + i);
+        __m256 cy = _mm256_load_ps(buffer->center_y + i);
+        __m256 cz = _mm256_load_ps(buffer->center_z + i);
+        __m256 ex = _mm256_load_ps(buffer->extent_x + i);
+        __m256 ey = _mm256_load_ps(buffer->extent_y + i);
+        __m256 ez = _mm256_load_ps(buffer->extent_z + i);
+        __m256 outside = _mm256_setzero_ps();
+
+        for (int p = 0; p < 6; p++) {
+            __m256 nx = _mm256_set1_ps(planes[p][0]);
+            __m256 ny = _mm256_set1_ps(planes[p][1]);
+            __m256 nz = _mm256_set1_ps(planes[p][2]);
+            __m256 d = _mm256_set1_ps(planes[p][3]);
+            __m256 ax = _mm256_set1_ps(fabsf(planes[p][0]));
+            __m256 ay = _mm256_set1_ps(fabsf(planes[p][1]));
+            __m256 az = _mm256_set1_ps(fabsf(planes[p][2]));
+
+            __m256 dist = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, cx), _mm256_mul_ps(ny, cy)),
+                                        _mm256_add_ps(_mm256_mul_ps(nz, cz), d));
+            __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, ex), _mm256_mul_ps(ay, ey)),
+                                          _mm256_mul_ps(az, ez));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(dist, radius),
+                                                          _mm256_setzero_ps(), _CMP_LT_OQ));
+        }
+
+        int mask = _mm256_movemask_ps(outside);
+        for (int lane = 0; lane < 8 && i + (uint32_t)lane < count; lane++) {
+            uint8_t visible = (mask & (1 << lane)) ? 0 : 1;
+            buffer->visible[i + lane] = visible;
+            visible_count += visible;
+        }
+    }
+#elif defined(__SSE__) || defined(_M_X64)
+    /* 4 boxes per iteration */
+    for (; i < padded; i += 4) {
+        __m128 cx = _mm_load_ps(buffer->center_x + i);
+        __m128 cy = _mm_load_ps(buffer->center_y + i);
+        __m128 cz = _mm_load_ps(buffer->center_z + i);
+        __m128 ex = _mm_load_ps(buffer->extent_x + i);
+        __m128 ey = _mm_load_ps(buffer->extent_y + i);
+        __m128 ez = _mm_load_ps(buffer->extent_z + i);
+        __m128 outside = _mm_setzero_ps();
+
+        for (int p = 0; p < 6; p++) {
+            __m128 nx = _mm_set1_ps(planes[p][0]);
+            __m128 ny = _mm_set1_ps(planes[p][1]);
+            __m128 nz = _mm_set1_ps(planes[p][2]);
+            __m128 d = _mm_set1_ps(planes[p][3]);
+            __m128 ax = _mm_set1_ps(fabsf(planes[p][0]));
+            __m128 ay = _mm_set1_ps(fabsf(planes[p][1]));
+            __m128 az = _mm_set1_ps(fabsf(planes[p][2]));
+
+            __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)),
+                                     _mm_add_ps(_mm_mul_ps(nz, cz), d));
+            __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, ex), _mm_mul_ps(ay, ey)),
+                                       _mm_mul_ps(az, ez));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dist, radius), _mm_setzero_ps()));
+        }
+
+        int mask = _mm_movemask_ps(outside);
+        for (int lane = 0; lane < 4 && i + (uint32_t)lane < count; lane++) {
+            uint8_t visible = (mask & (1 << lane)) ? 0 : 1;
+            buffer->visible[i + lane] = visible;
+            visible_count += visible;
+        }
+    }
+#elif defined(__ARM_NEON)
+    /* 4 boxes per iteration */
+    for (; i < padded; i += 4) {
+        float32x4_t cx = vld1q_f32(buffer->center_x + i);
+        float32x4_t cy = vld1q_f32(buffer->center_y + i);
+        float32x4_t cz = vld1q_f32(buffer->center_z + i);
+        float32x4_t ex = vld1q_f32(buffer->extent_x + i);
+        float32x4_t ey = vld1q_f32(buffer->extent_y + i);
+        float32x4_t ez = vld1q_f32(buffer->extent_z + i);
+        uint32x4_t outside = vdupq_n_u32(0);
+
+        for (int p = 0; p < 6; p++) {
+            float32x4_t dist = vdupq_n_f32(planes[p][3]);
+            dist = vmlaq_n_f32(dist, cx, planes[p][0]);
+            dist = vmlaq_n_f32(dist, cy, planes[p][1]);
+            dist = vmlaq_n_f32(dist, cz, planes[p][2]);
+            dist = vmlaq_n_f32(dist, ex, fabsf(planes[p][0]));
+            dist = vmlaq_n_f32(dist, ey, fabsf(planes[p][1]));
+            dist = vmlaq_n_f32(dist, ez, fabsf(planes[p][2]));
+            outside = vorrq_u32(outside, vcltq_f32(dist, vdupq_n_f32(0.0f)));
+        }
+
+        uint32_t lanes[4];
+        vst1q_u32(lanes, outside);
+        for (int lane = 0; lane < 4 && i + (uint32_t)lane < count; lane++) {
+            uint8_t visible = lanes[lane] ? 0 : 1;
+            buffer->visible[i + lane] = visible;
+            visible_count += visible;
+        }
+    }
+#endif
+
+    /* Scalar fallback (and remainder when no SIMD path is compiled in) */
+    for (; i < count; i++) {
+        uint8_t visible = 1;
+        for (int p = 0; p < 6; p++) {
+            float dist = planes[p][0] * buffer->center_x[i] +
+                         planes[p][1] * buffer->center_y[i] +
+                         planes[p][2] * buffer->center_z[i] +
+                         planes[p][3];
+            float radius = fabsf(planes[p][0]) * buffer->extent_x[i] +
+                           fabsf(planes[p][1]) * buffer->extent_y[i] +
+                           fabsf(planes[p][2]) * buffer->extent_z[i];
+            if (dist + radius < 0.0f) {
+                visible = 0;
+                break;
+            }
+        }
+        buffer->visible[i] = visible;
+        visible_count += visible;
+    }
+
+    return visible_count;
+}
@@ -0,0 +1,680 @@
+/**
+ * Nexus3D GPU Scene Implementation
+ * Object slots mirrored in a persistent storage buffer, only changed slots
+ * are re-uploaded. A compute pass culls the slots and fills the indirect
+ * draw arguments of the frame
+ */
+
+#include "nexus3d/renderer/gpu_scene.h"
+#include "nexus3d/utils/mapped_file.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Initial slot counts */
+#define NEXUS_GPU_SCENE_INITIAL_OBJECTS 1024
+#define NEXUS_GPU_SCENE_INITIAL_DRAWS   64
+
+/* Clean slots between two dirty ones that are still uploaded as one copy */
+#define NEXUS_GPU_SCENE_MERGE_GAP 8
+
+/* Empty draw table entry */
+#define NEXUS_GPU_DRAW_EMPTY 0u
+
+/**
+ * Create a GPU scene
+ */
+NexusGpuScene* nexus_gpu_scene_create(SDL_GPUDevice* device) {
+    NexusGpuScene* scene = (NexusGpuScene*)malloc(sizeof(NexusGpuScene));
+    if (scene == NULL) {
+        fprintf(stderr, "Failed to allocate memory for GPU scene!\n");
+        return NULL;
+    }
+    memset(scene, 0, sizeof(NexusGpuScene));
+    scene->device = device;
+
+    /* Object slots and their bookkeeping */
+    scene->objects = (NexusGpuObject*)calloc(NEXUS_GPU_SCENE_INITIAL_OBJECTS, sizeof(NexusGpuObject));
+    scene->free_slots = (uint32_t*)malloc(sizeof(uint32_t) * NEXUS_GPU_SCENE_INITIAL_OBJECTS);
+    scene->dirty = (uint32_t*)malloc(sizeof(uint32_t) * NEXUS_GPU_SCENE_INITIAL_OBJECTS);
+    scene->dirty_flags = (uint8_t*)calloc(NEXUS_GPU_SCENE_INITIAL_OBJECTS, 1);
+    scene->object_capacity = NEXUS_GPU_SCENE_INITIAL_OBJECTS;
+
+    /* Draws and their lookup table (twice the draws keeps probes short) */
+    scene->draws = (NexusGpuDraw*)calloc(NEXUS_GPU_SCENE_INITIAL_DRAWS, sizeof(NexusGpuDraw));
+    scene->draw_capacity = NEXUS_GPU_SCENE_INITIAL_DRAWS;
+    scene->draw_table = (uint32_t*)calloc(NEXUS_GPU_SCENE_INITIAL_DRAWS * 2, sizeof(uint32_t));
+    scene->draw_table_capacity = NEXUS_GPU_SCENE_INITIAL_DRAWS * 2;
+
+    /* The world updates objects while a render thread uploads and draws them */
+    scene->lock = SDL_CreateMutex();
+
+    if (scene->objects == NULL || scene->free_slots == NULL || scene->dirty == NULL ||
+        scene->dirty_flags == NULL || scene->draws == NULL || scene->draw_table == NULL || scene->lock == NULL) {
+        fprintf(stderr, "Failed to allocate GPU scene arrays!\n");
+        nexus_gpu_scene_destroy(scene);
+        return NULL;
+    }
+
+    return scene;
+}
+
+/**
+ * Destroy a GPU scene
+ */
+void nexus_gpu_scene_destroy(NexusGpuScene* scene) {
+    if (scene == NULL) {
+        return;
+    }
+
+    if (scene->device != NULL) {
+        SDL_GPUBuffer* buffers[] = { scene->object_buffer, scene->draw_buffer, scene->instance_buffer };
+        for (size_t i = 0; i < sizeof(buffers) / sizeof(buffers[0]); i++) {
+            if (buffers[i] != NULL) {
+                SDL_ReleaseGPUBuffer(scene->device, buffers[i]);
+            }
+        }
+        if (scene->cull_pipeline != NULL) {
+            SDL_ReleaseGPUComputePipeline(scene->device, scene->cull_pipeline);
+        }
+    }
+
+    free(scene->objects);
+    free(scene->free_slots);
+    free(scene->dirty);
+    free(scene->dirty_flags);
+    free(scene->draws);
+    free(scene->draw_table);
+    if (scene->lock != NULL) {
+        SDL_DestroyMutex(scene->lock);
+    }
+    free(scene);
+}
+
+/**
+ * Lock the scene for the calling thread
+ * Held by the world while it changes objects and by the renderer from the
+ * upload to the draws, when the two run on different threads. The lock is recursive
+ */
+void nexus_gpu_scene_lock(NexusGpuScene* scene) {
+    if (scene == NULL) {
+        return;
+    }
+
+    SDL_LockMutex(scene->lock);
+}
+
+/**
+ * Unlock the scene
+ */
+void nexus_gpu_scene_unlock(NexusGpuScene* scene) {
+    if (scene == NULL) {
+        return;
+    }
+
+    SDL_UnlockMutex(scene->lock);
+}
+
+/**
+ * Load the compute shader that culls the objects (see the contract in gpu_scene.h)
+ */
+bool nexus_gpu_scene_load_cull_shader(NexusGpuScene* scene, NexusShaderLanguage language, const char* filename) {
+    if (scene == NULL || scene->device == NULL || filename == NULL) {
+        return false;
+    }
+
+    SDL_GPUComputePipelineCreateInfo info;
+    memset(&info, 0, sizeof(info));
+    switch (language) {
+        case NEXUS_SHADER_LANGUAGE_GLSL:
+        case NEXUS_SHADER_LANGUAGE_SPIRV:
+            info.format = SDL_GPU_SHADERFORMAT_SPIRV;
+            break;
+        case NEXUS_SHADER_LANGUAGE_HLSL:
+            info.format = SDL_GPU_SHADERFORMAT_DXBC;
+            break;
+        case NEXUS_SHADER_LANGUAGE_MSL:
+            info.format = SDL_GPU_SHADERFORMAT_MSL;
+            break;
+        default:
+            fprintf(stderr, "Unsupported cull shader language!\n");
+            return false;
+    }
+
+    /* Map the file, the code is handed to the driver without a copy */
+    NexusMappedFile file;
+    if (!nexus_mapped_file_open(&file, filename)) {
+        fprintf(stderr, "Failed to open cull shader file: %s\n", filename);
+        return false;
+    }
+
+    info.code = (const Uint8*)file.data;
+    info.code_size = file.size;
+    info.entrypoint = "main";
+    info.num_readonly_storage_buffers = 1;
+    info.num_readwrite_storage_buffers = 2;
+    info.num_uniform_buffers = 1;
+    info.threadcount_x = NEXUS_GPU_SCENE_WORKGROUP_SIZE;
+    info.threadcount_y = 1;
+    info.threadcount_z = 1;
+    SDL_GPUComputePipeline* pipeline = SDL_CreateGPUComputePipeline(scene->device, &info);
+    nexus_mapped_file_close(&file);
+
+    if (pipeline == NULL) {
+        fprintf(stderr, "Failed to create cull pipeline: %s\n", SDL_GetError());
+        return false;
+    }
+
+    if (scene->cull_pipeline != NULL) {
+        SDL_ReleaseGPUComputePipeline(scene->device, scene->cull_pipeline);
+    }
+    scene->cull_pipeline = pipeline;
+    return true;
+}
+
+/**
+ * Hash of a draw key for the draw table
+ */
+static uint32_t nexus_gpu_scene_hash_draw(const NexusMesh* mesh, uint32_t lod, const NexusMaterial* material) {
+    uint64_t key = (uint64_t)(uintptr_t)mesh * 0x9E3779B97F4A7C15ull;
+    key ^= ((uint64_t)(uintptr_t)material + lod) * 0xC2B2AE3D27D4EB4Full;
+    key ^= key >> 29;
+    return (uint32_t)key;
+}
+
+/**
+ * Insert a draw slot into the draw table (the table has a free entry)
+ */
+static void nexus_gpu_scene_insert_draw(NexusGpuScene* scene, uint32_t draw) {
+    const NexusGpuDraw* entry = &scene->draws[draw];
+    uint32_t mask = scene->draw_table_capacity - 1;
+    uint32_t slot = nexus_gpu_scene_hash_draw(entry->mesh, entry->lod, entry->material) & mask;
+    while (scene->draw_table[slot] != NEXUS_GPU_DRAW_EMPTY) {
+        slot = (slot + 1) & mask;
+    }
+    scene->draw_table[slot] = draw + 1;
+}
+
+/**
+ * Rebuild the draw table from the used draw slots
+ */
+static void nexus_gpu_scene_rebuild_draw_table(NexusGpuScene* scene) {
+    memset(scene->draw_table, 0, sizeof(uint32_t) * scene->draw_table_capacity);
+    for (uint32_t i = 0; i < scene->draw_count; i++) {
+        if (scene->draws[i].mesh != NULL) {
+            nexus_gpu_scene_insert_draw(scene, i);
+        }
+    }
+}
+
+/**
+ * Find the draw of a mesh level and material, creating it if needed
+ * @return Draw slot, UINT32_MAX on failure
+ */
+static uint32_t nexus_gpu_scene_acquire_draw(NexusGpuScene* scene, NexusMesh* mesh, uint32_t lod,
+                                             NexusMaterial* material) {
+    /* Existing draw */
+    uint32_t mask = scene->draw_table_capacity - 1;
+    uint32_t slot = nexus_gpu_scene_hash_draw(mesh, lod, material) & mask;
+    while (scene->draw_table[slot] != NEXUS_GPU_DRAW_EMPTY) {
+        NexusGpuDraw* draw = &scene->draws[scene->draw_table[slot] - 1];
+        if (draw->mesh == mesh && draw->lod == lod && draw->material == material) {
+            return scene->draw_table[slot] - 1;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    /* Reuse a freed slot before growing */
+    uint32_t index = UINT32_MAX;
+    for (uint32_t i = 0; i < scene->draw_count; i++) {
+        if (scene->draws[i].mesh == NULL) {
+            index = i;
+            break;
+        }
+    }
+    if (index == UINT32_MAX) {
+        if (scene->draw_count == scene->draw_capacity) {
+            uint32_t capacity = scene->draw_capacity * 2;
+            NexusGpuDraw* draws = (NexusGpuDraw*)realloc(scene->draws, sizeof(NexusGpuDraw) * capacity);
+            uint32_t* table = (uint32_t*)malloc(sizeof(uint32_t) * capacity * 2);
+            if (draws == NULL || table == NULL) {
+                if (draws != NULL) {
+                    scene->draws = draws;
+                }
+                free(table);
+                fprintf(stderr, "Failed to grow GPU scene draws!\n");
+                return UINT32_MAX;
+            }
+            scene->draws = draws;
+            scene->draw_capacity = capacity;
+            free(scene->draw_table);
+            scene->draw_table = table;
+            scene->draw_table_capacity = capacity * 2;
+            nexus_gpu_scene_rebuild_draw_table(scene);
+        }
+        index = scene->draw_count++;
+    }
+
+    NexusGpuDraw* draw = &scene->draws[index];
+    memset(draw, 0, sizeof(NexusGpuDraw));
+    draw->mesh = mesh;
+    draw->lod = lod;
+    draw->material = material;
+    nexus_gpu_scene_insert_draw(scene, index);
+    return index;
+}
+
+/**
+ * Drop an object from its draw, freeing the draw once it is empty
+ */
+static void nexus_gpu_scene_release_draw(NexusGpuScene* scene, uint32_t index) {
+    NexusGpuDraw* draw = &scene->draws[index];
+    if (draw->object_count > 1) {
+        draw->object_count--;
+        return;
+    }
+
+    /* Table entries cannot be removed from a probe chain, rebuild it instead */
+    memset(draw, 0, sizeof(NexusGpuDraw));
+    while (scene->draw_count > 0 && scene->draws[scene->draw_count - 1].mesh == NULL) {
+        scene->draw_count--;
+    }
+    nexus_gpu_scene_rebuild_draw_table(scene);
+}
+
+/**
+ * Queue an object slot for the next upload
+ */
+static void nexus_gpu_scene_mark_dirty(NexusGpuScene* scene, uint32_t index) {
+    if (!scene->dirty_flags[index]) {
+        scene->dirty_flags[index] = 1;
+        scene->dirty[scene->dirty_count++] = index;
+    }
+}
+
+/**
+ * Fill an object slot from a transform and world bounds
+ */
+static void nexus_gpu_scene_fill_object(NexusGpuObject* object, uint32_t draw, const float* transform,
+                                        const float* bounds_min, const float* bounds_max) {
+    memset(object, 0, sizeof(NexusGpuObject));
+    memcpy(object->transform, transform, sizeof(object->transform));
+    for (int i = 0; i < 3; i++) {
+        object->center[i] = (bounds_min[i] + bounds_max[i]) * 0.5f;
+        object->extent[i] = (bounds_max[i] - bounds_min[i]) * 0.5f;
+    }
+    object->draw = draw;
+    object->flags = NEXUS_GPU_OBJECT_ACTIVE;
+}
+
+/**
+ * Check whether a mesh and material can be drawn by the scene
+ * Indirect draws need indices, and they are drawn before the queue's
+ * sorted transparent draws, so only opaque materials qualify
+ */
+bool nexus_gpu_scene_accepts(const NexusGpuScene* scene, const NexusMesh* mesh, const NexusMaterial* material) {
+    if (scene == NULL || mesh == NULL || material == NULL || material->shader == NULL) {
+        return false;
+    }
+
+    return mesh->has_indices && mesh->index_buffer != NULL && mesh->vertex_buffer != NULL &&
+           material->blend_mode == NEXUS_BLEND_MODE_OPAQUE;
+}
+
+/**
+ * Grow the object slots to hold at least the given count
+ */
+static bool nexus_gpu_scene_reserve_objects(NexusGpuScene* scene, uint32_t count) {
+    if (count <= scene->object_capacity) {
+        return true;
+    }
+
+    uint32_t capacity = scene->object_capacity * 2;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+
+    NexusGpuObject* objects = (NexusGpuObject*)realloc(scene->objects, sizeof(NexusGpuObject) * capacity);
+    if (objects != NULL) {
+        scene->objects = objects;
+    }
+    uint32_t* free_slots = (uint32_t*)realloc(scene->free_slots, sizeof(uint32_t) * capacity);
+    if (free_slots != NULL) {
+        scene->free_slots = free_slots;
+    }
+    uint32_t* dirty = (uint32_t*)realloc(scene->dirty, sizeof(uint32_t) * capacity);
+    if (dirty != NULL) {
+        scene->dirty = dirty;
+    }
+    uint8_t* dirty_flags = (uint8_t*)realloc(scene->dirty_flags, capacity);
+    if (dirty_flags != NULL) {
+        scene->dirty_flags = dirty_flags;
+    }
+    if (objects == NULL || free_slots == NULL || dirty == NULL || dirty_flags == NULL) {
+        fprintf(stderr, "Failed to grow GPU scene objects!\n");
+        return false;
+    }
+
+    memset(scene->objects + scene->object_capacity, 0,
+           sizeof(NexusGpuObject) * (capacity - scene->object_capacity));
+    memset(scene->dirty_flags + scene->object_capacity, 0, capacity - scene->object_capacity);
+    scene->object_capacity = capacity;
+    return true;
+}
+
+/**
+ * Add an object to the scene
+ * @return Object handle, 0 on failure
+ */
+uint32_t nexus_gpu_scene_add_object(NexusGpuScene* scene, NexusMesh* mesh, uint32_t lod, NexusMaterial* material,
+                                    const float* transform, const float* bounds_min, const float* bounds_max) {
+    if (transform == NULL || bounds_min == NULL || bounds_max == NULL ||
+        !nexus_gpu_scene_accepts(scene, mesh, material)) {
+        return 0;
+    }
+
+    /* Freed slots first, the slot range the cull pass walks stays compact */
+    uint32_t index;
+    if (scene->free_count > 0) {
+        index = scene->free_slots[--scene->free_count];
+    } else {
+        if (!nexus_gpu_scene_reserve_objects(scene, scene->object_count + 1)) {
+            return 0;
+        }
+        index = scene->object_count++;
+    }
+
+    uint32_t draw = nexus_gpu_scene_acquire_draw(scene, mesh, lod, material);
+    if (draw == UINT32_MAX) {
+        scene->free_slots[scene->free_count++] = index;
+        return 0;
+    }
+    scene->draws[draw].object_count++;
+
+    nexus_gpu_scene_fill_object(&scene->objects[index], draw, transform, bounds_min, bounds_max);
+    nexus_gpu_scene_mark_dirty(scene, index);
+    scene->live_count++;
+    return index + 1;
+}
+
+/**
+ * Update an object, its slot is only uploaded when something changed
+ * @return true if the object changed
+ */
+bool nexus_gpu_scene_update_object(NexusGpuScene* scene, uint32_t handle, NexusMesh* mesh, uint32_t lod,
+                                   NexusMaterial* material, const float* transform, const float* bounds_min,
+                                   const float* bounds_max) {
+    if (scene == NULL || handle == 0 || handle > scene->object_count || transform == NULL ||
+        bounds_min == NULL || bounds_max == NULL) {
+        return false;
+    }
+
+    NexusGpuObject* object = &scene->objects[handle - 1];
+    if (!(object->flags & NEXUS_GPU_OBJECT_ACTIVE)) {
+        return false;
+    }
+
+    /* Move the object to the draw of its new mesh level and material */
+    uint32_t draw = object->draw;
+    const NexusGpuDraw* current = &scene->draws[draw];
+    if (current->mesh != mesh || current->lod != lod || current->material != material) {
+        if (!nexus_gpu_scene_accepts(scene, mesh, material)) {
+            return false;
+        }
+        uint32_t next = nexus_gpu_scene_acquire_draw(scene, mesh, lod, material);
+        if (next == UINT32_MAX) {
+            return false;
+        }
+        scene->draws[next].object_count++;
+        nexus_gpu_scene_release_draw(scene, draw);
+        draw = next;
+    }
+
+    NexusGpuObject updated;
+    nexus_gpu_scene_fill_object(&updated, draw, transform, bounds_min, bounds_max);
+    if (memcmp(&updated, object, sizeof(NexusGpuObject)) == 0) {
+        return false;
+    }
+
+    *object = updated;
+    nexus_gpu_scene_mark_dirty(scene, handle - 1);
+    return true;
+}
+
+/**
+ * Remove an object from the scene
+ */
+void nexus_gpu_scene_remove_object(NexusGpuScene* scene, uint32_t handle) {
+    if (scene == NULL || handle == 0 || handle > scene->object_count) {
+        return;
+    }
+
+    uint32_t index = handle - 1;
+    NexusGpuObject* object = &scene->objects[index];
+    if (!(object->flags & NEXUS_GPU_OBJECT_ACTIVE)) {
+        return;
+    }
+
+    nexus_gpu_scene_release_draw(scene, object->draw);
+    memset(object, 0, sizeof(NexusGpuObject));
+    scene->live_count--;
+
+    /* Inactive slots are skipped by the cull pass, they still have to be uploaded cleared */
+    if (index == scene->object_count - 1) {
+        scene->object_count--;
+        if (scene->dirty_flags[index]) {
+            /* Range is no longer walked, nothing to upload */
+            for (uint32_t i = 0; i < scene->dirty_count; i++) {
+                if (scene->dirty[i] == index) {
+                    scene->dirty[i] = scene->dirty[--scene->dirty_count];
+                    break;
+                }
+            }
+            scene->dirty_flags[index] = 0;
+        }
+    } else {
+        scene->free_slots[scene->free_count++] = index;
+        nexus_gpu_scene_mark_dirty(scene, index);
+    }
+}
+
+/**
+ * Get the number of objects in the scene
+ */
+uint32_t nexus_gpu_scene_get_object_count(const NexusGpuScene* scene) {
+    if (scene == NULL) {
+        return 0;
+    }
+
+    return scene->live_count;
+}
+
+/**
+ * Create a scene buffer, replacing an existing one
+ */
+static SDL_GPUBuffer* nexus_gpu_scene_create_buffer(NexusGpuScene* scene, NexusUploadManager* manager,
+                                                    SDL_GPUBuffer* old, SDL_GPUBufferUsageFlags usage,
+                                                    uint32_t size) {
+    if (old != NULL) {
+        nexus_upload_manager_cancel_buffer(manager, old);
+        SDL_ReleaseGPUBuffer(scene->device, old);
+    }
+
+    SDL_GPUBufferCreateInfo info = {
+        .usage = usage,
+        .size = size
+    };
+    SDL_GPUBuffer* buffer = SDL_CreateGPUBuffer(scene->device, &info);
+    if (buffer == NULL) {
+        fprintf(stderr, "Failed to create GPU scene buffer: %s\n", SDL_GetError());
+    }
+    return buffer;
+}
+
+/**
+ * Compare two slot indices for sorting
+ */
+static int nexus_gpu_scene_compare_slots(const void* a, const void* b) {
+    uint32_t lhs = *(const uint32_t*)a;
+    uint32_t rhs = *(const uint32_t*)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/**
+ * Stage the changed objects and the frame's indirect draw arguments
+ * Objects are uploaded in place, runs of nearby dirty slots share one copy.
+ * Draws are then assigned consecutive instance ranges with zero instances,
+ * the cull pass counts the visible objects into them
+ */
+bool nexus_gpu_scene_upload(NexusGpuScene* scene, NexusUploadManager* manager) {
+    if (scene == NULL || manager == NULL || scene->device == NULL) {
+        return false;
+    }
+
+    /* The object buffer follows the slot capacity, a new buffer gets every slot */
+    if (scene->object_buffer == NULL || scene->object_buffer_capacity < scene->object_capacity) {
+        scene->object_buffer = nexus_gpu_scene_create_buffer(scene, manager, scene->object_buffer,
+                                                             SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ,
+                                                             sizeof(NexusGpuObject) * scene->object_capacity);
+        scene->object_buffer_capacity = scene->object_buffer != NULL ? scene->object_capacity : 0;
+        scene->upload_all = true;
+    }
+    if (scene->draw_buffer == NULL || scene->draw_buffer_capacity < scene->draw_capacity) {
+        scene->draw_buffer = nexus_gpu_scene_create_buffer(scene, manager, scene->draw_buffer,
+                                                           SDL_GPU_BUFFERUSAGE_INDIRECT |
+                                                           SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE,
+                                                           sizeof(SDL_GPUIndexedIndirectDrawCommand) *
+                                                           scene->draw_capacity);
+        scene->draw_buffer_capacity = scene->draw_buffer != NULL ? scene->draw_capacity : 0;
+    }
+    if (scene->instance_buffer == NULL || scene->instance_buffer_capacity < scene->live_count) {
+        uint32_t capacity = scene->instance_buffer_capacity > 0 ? scene->instance_buffer_capacity :
+                            NEXUS_GPU_SCENE_INITIAL_OBJECTS;
+        while (capacity < scene->live_count) {
+            capacity *= 2;
+        }
+        scene->instance_buffer = nexus_gpu_scene_create_buffer(scene, manager, scene->instance_buffer,
+                                                               SDL_GPU_BUFFERUSAGE_VERTEX |
+                                                               SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ |
+                                                               SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE,
+                                                               (uint32_t)NEXUS_SHADER_INSTANCE_STRIDE * capacity);
+        scene->instance_buffer_capacity = scene->instance_buffer != NULL ? capacity : 0;
+    }
+    if (scene->object_buffer == NULL || scene->draw_buffer == NULL || scene->instance_buffer == NULL) {
+        return false;
+    }
+
+    /* Objects, written in place so clean slots keep their contents */
+    bool success = true;
+    if (scene->upload_all) {
+        if (scene->object_count > 0) {
+            success = nexus_upload_manager_upload_buffer(manager, scene->object_buffer, 0, scene->objects,
+                                                         sizeof(NexusGpuObject) * scene->object_count, false);
+        }
+    } else if (scene->dirty_count > 0) {
+        qsort(scene->dirty, scene->dirty_count, sizeof(uint32_t), nexus_gpu_scene_compare_slots);
+        uint32_t first = 0;
+        while (success && first < scene->dirty_count) {
+            uint32_t last = first + 1;
+            while (last < scene->dirty_count &&
+                   scene->dirty[last] - scene->dirty[last - 1] <= NEXUS_GPU_SCENE_MERGE_GAP + 1) {
+                last++;
+            }
+            uint32_t start = scene->dirty[first];
+            uint32_t count = scene->dirty[last - 1] - start + 1;
+            success = nexus_upload_manager_upload_buffer(manager, scene->object_buffer,
+                                                         (uint32_t)sizeof(NexusGpuObject) * start,
+                                                         &scene->objects[start],
+                                                         (uint32_t)sizeof(NexusGpuObject) * count, false);
+            first = last;
+        }
+    }
+    if (!success) {
+        fprintf(stderr, "Failed to stage GPU scene objects!\n");
+        return false;
+    }
+    for (uint32_t i = 0; i < scene->dirty_count; i++) {
+        scene->dirty_flags[scene->dirty[i]] = 0;
+    }
+    scene->dirty_count = 0;
+    scene->upload_all = false;
+
+    /* Indirect arguments, cycled since the previous frame may still draw from them */
+    scene->instance_count = 0;
+    if (scene->draw_count == 0) {
+        return true;
+    }
+    nexus_upload_manager_lock(manager);
+    SDL_GPUIndexedIndirectDrawCommand* commands = (SDL_GPUIndexedIndirectDrawCommand*)
+        nexus_upload_manager_begin_buffer(manager, scene->draw_buffer, 0,
+                                          sizeof(SDL_GPUIndexedIndirectDrawCommand) * scene->draw_count, true);
+    if (commands == NULL) {
+        nexus_upload_manager_unlock(manager);
+        fprintf(stderr, "Failed to stage GPU scene draws!\n");
+        return false;
+    }
+
+    for (uint32_t i = 0; i < scene->draw_count; i++) {
+        NexusGpuDraw* draw = &scene->draws[i];
+        SDL_GPUIndexedIndirectDrawCommand* command = &commands[i];
+        memset(command, 0, sizeof(SDL_GPUIndexedIndirectDrawCommand));
+        draw->first_instance = scene->instance_count;
+        if (draw->mesh == NULL) {
+            continue;
+        }
+
+        /* Index range of the level, the whole buffer without LODs */
+        const NexusMesh* mesh = draw->mesh;
+        command->num_indices = mesh->index_count;
+        if (mesh->lod_count > 0) {
+            const NexusMeshLod* level = &mesh->lods[draw->lod < mesh->lod_count ? draw->lod : mesh->lod_count - 1];
+            command->first_index = level->index_offset;
+            command->num_indices = level->index_count;
+        }
+        command->first_instance = draw->first_instance;
+        scene->instance_count += draw->object_count;
+    }
+    nexus_upload_manager_unlock(manager);
+
+    return true;
+}
+
+/**
+ * Record the cull pass into a command buffer
+ * Call after the upload batch holding nexus_gpu_scene_upload's copies was
+ * submitted. Zero planes reject nothing (no camera)
+ * @return true if the pass was recorded and the draws can be issued
+ */
+bool nexus_gpu_scene_cull(NexusGpuScene* scene, SDL_GPUCommandBuffer* cmd_buffer, const vec4 planes[6]) {
+    if (scene == NULL || cmd_buffer == NULL || scene->cull_pipeline == NULL || scene->live_count == 0 ||
+        scene->object_buffer == NULL || scene->draw_buffer == NULL || scene->instance_buffer == NULL) {
+        return false;
+    }
+
+    /* The staged draw arguments must survive, only the instances are rewritten in full */
+    SDL_GPUStorageBufferReadWriteBinding outputs[2] = {
+        { .buffer = scene->draw_buffer, .cycle = false },
+        { .buffer = scene->instance_buffer, .cycle = true }
+    };
+    SDL_GPUComputePass* pass = SDL_BeginGPUComputePass(cmd_buffer, NULL, 0, outputs, 2);
+    if (pass == NULL) {
+        fprintf(stderr, "Failed to begin cull pass: %s\n", SDL_GetError());
+        return false;
+    }
+
+    NexusGpuCullUniforms uniforms;
+    memset(&uniforms, 0, sizeof(uniforms));
+    if (planes != NULL) {
+        memcpy(uniforms.planes, planes, sizeof(uniforms.planes));
+    }
+    uniforms.object_count = scene->object_count;
+
+    SDL_BindGPUComputePipeline(pass, scene->cull_pipeline);
+    SDL_BindGPUComputeStorageBuffers(pass, 0, &scene->object_buffer, 1);
+    SDL_PushGPUComputeUniformData(cmd_buffer, 0, &uniforms, sizeof(uniforms));
+    SDL_DispatchGPUCompute(pass, (scene->object_count + NEXUS_GPU_SCENE_WORKGROUP_SIZE - 1) /
+                                 NEXUS_GPU_SCENE_WORKGROUP_SIZE, 1, 1);
+    SDL_EndGPUComputePass(pass);
+    return true;
+}
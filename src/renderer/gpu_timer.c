@@ -0,0 +1,143 @@
+/**
+ * Nexus3D GPU Timer Implementation
+ * Fence based frame timings feeding the profiler's GPU track
+ */
+
+#include "nexus3d/renderer/gpu_timer.h"
+#include "nexus3d/utils/profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Create a GPU timer
+ */
+NexusGpuTimer* nexus_gpu_timer_create(SDL_GPUDevice* device) {
+    if (device == NULL) {
+        fprintf(stderr, "Cannot create GPU timer without a GPU device!\n");
+        return NULL;
+    }
+
+    NexusGpuTimer* timer = (NexusGpuTimer*)malloc(sizeof(NexusGpuTimer));
+    if (timer == NULL) {
+        fprintf(stderr, "Failed to allocate memory for GPU timer!\n");
+        return NULL;
+    }
+    memset(timer, 0, sizeof(NexusGpuTimer));
+
+    timer->device = device;
+    timer->frequency = SDL_GetPerformanceFrequency();
+    return timer;
+}
+
+/**
+ * Destroy a GPU timer, waiting for the pending frames
+ */
+void nexus_gpu_timer_destroy(NexusGpuTimer* timer) {
+    if (timer == NULL) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < timer->frame_count; i++) {
+        SDL_GPUFence* fence = timer->frames[i].fence;
+        SDL_WaitForGPUFences(timer->device, true, &fence, 1);
+        SDL_ReleaseGPUFence(timer->device, fence);
+    }
+
+    free(timer);
+}
+
+/**
+ * Submit a command buffer, timing it when a slot is free
+ * @return false if the submission failed
+ */
+bool nexus_gpu_timer_submit(NexusGpuTimer* timer, SDL_GPUCommandBuffer* cmd_buffer, const char* name) {
+    if (cmd_buffer == NULL) {
+        return false;
+    }
+
+    /* The CPU never waits for a slot, the frame is submitted untimed instead */
+    if (timer == NULL || timer->frame_count >= NEXUS_GPU_TIMER_FRAMES) {
+        if (timer != NULL) {
+            timer->untimed_count++;
+            timer->submitted++;
+        }
+        return SDL_SubmitGPUCommandBuffer(cmd_buffer);
+    }
+
+    uint64_t submit_time = SDL_GetPerformanceCounter();
+    SDL_GPUFence* fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmd_buffer);
+    if (fence == NULL) {
+        return false;
+    }
+
+    NexusGpuTimerFrame* frame = &timer->frames[timer->frame_count++];
+    frame->fence = fence;
+    frame->name = name != NULL ? name : "GPU";
+    frame->submit_time = submit_time;
+    frame->index = timer->submitted++;
+    return true;
+}
+
+/**
+ * Time the pending frames whose fences have signaled (non-blocking)
+ * @return Number of frames resolved
+ */
+uint32_t nexus_gpu_timer_resolve(NexusGpuTimer* timer) {
+    if (timer == NULL || timer->frame_count == 0) {
+        return 0;
+    }
+
+    /* Frames complete in submission order */
+    uint32_t resolved = 0;
+    while (resolved < timer->frame_count && SDL_QueryGPUFence(timer->device, timer->frames[resolved].fence)) {
+        SDL_ReleaseGPUFence(timer->device, timer->frames[resolved].fence);
+        resolved++;
+    }
+    if (resolved == 0) {
+        return 0;
+    }
+
+    /* The GPU starts on a frame once it is submitted and the previous one is done,
+     * frames seen complete by the same poll share the span */
+    uint64_t now = SDL_GetPerformanceCounter();
+    const NexusGpuTimerFrame* first = &timer->frames[0];
+    const NexusGpuTimerFrame* last = &timer->frames[resolved - 1];
+    uint64_t begin = first->submit_time > timer->last_complete ? first->submit_time : timer->last_complete;
+    if (begin > now) {
+        begin = now;
+    }
+    timer->last_complete = now;
+
+    timer->gpu_time = (double)(now - begin) * 1000.0 / (double)timer->frequency / (double)resolved;
+    timer->avg_gpu_time = timer->avg_gpu_time > 0.0 ?
+                          (timer->avg_gpu_time * 0.95) + (timer->gpu_time * 0.05) : timer->gpu_time;
+    timer->latency = (uint32_t)(timer->submitted - last->index - 1);
+    nexus_profiler_add_gpu_event(last->name, begin, now);
+
+    timer->frame_count -= resolved;
+    memmove(&timer->frames[0], &timer->frames[resolved], sizeof(NexusGpuTimerFrame) * timer->frame_count);
+    return resolved;
+}
+
+/**
+ * Get the GPU time per frame of the last resolve in milliseconds
+ */
+double nexus_gpu_timer_get_time(const NexusGpuTimer* timer) {
+    if (timer == NULL) {
+        return 0.0;
+    }
+
+    return timer->gpu_time;
+}
+
+/**
+ * Get the smoothed GPU frame time in milliseconds
+ */
+double nexus_gpu_timer_get_avg_time(const NexusGpuTimer* timer) {
+    if (timer == NULL) {
+        return 0.0;
+    }
+
+    return timer->avg_gpu_time;
+}
@@ -0,0 +1,519 @@
+/**
+ * Nexus3D Light Clusters Implementation
+ * CPU binning of light bounding spheres against view space froxel bounds,
+ * uploaded as storage buffers once per frame
+ */
+
+#include "nexus3d/renderer/light_clusters.h"
+#include "nexus3d/renderer/shader.h"
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Initial capacity of the light index list */
+#define NEXUS_CLUSTER_INITIAL_INDICES 16384
+
+/* Closest near plane the depth slices are built for */
+#define NEXUS_CLUSTER_MIN_NEAR 0.01f
+
+/**
+ * Create the light clusters of a device
+ */
+NexusLightClusters* nexus_light_clusters_create(SDL_GPUDevice* device) {
+    NexusLightClusters* clusters = (NexusLightClusters*)malloc(sizeof(NexusLightClusters));
+    if (clusters == NULL) {
+        fprintf(stderr, "Failed to allocate memory for light clusters!\n");
+        return NULL;
+    }
+    memset(clusters, 0, sizeof(NexusLightClusters));
+    clusters->device = device;
+
+    /* Fixed size arrays */
+    clusters->lights = (NexusLightData*)malloc(sizeof(NexusLightData) * NEXUS_MAX_LIGHTS);
+    clusters->clusters = (NexusLightCluster*)calloc(NEXUS_CLUSTER_COUNT, sizeof(NexusLightCluster));
+    clusters->bounds = (float*)malloc(sizeof(float) * 6 * NEXUS_CLUSTER_COUNT);
+    clusters->spheres = (float*)malloc(sizeof(float) * 4 * NEXUS_MAX_LIGHTS);
+    clusters->ranges = (uint8_t*)malloc(6 * NEXUS_MAX_LIGHTS);
+    clusters->indices = (uint32_t*)malloc(sizeof(uint32_t) * NEXUS_CLUSTER_INITIAL_INDICES);
+    clusters->index_capacity = NEXUS_CLUSTER_INITIAL_INDICES;
+    if (clusters->lights == NULL || clusters->clusters == NULL || clusters->bounds == NULL ||
+        clusters->spheres == NULL || clusters->ranges == NULL || clusters->indices == NULL) {
+        fprintf(stderr, "Failed to allocate memory for light clusters!\n");
+        nexus_light_clusters_destroy(clusters);
+        return NULL;
+    }
+
+    /* Bounds are built on first use */
+    clusters->bounds_key[0] = NAN;
+
+    return clusters;
+}
+
+/**
+ * Destroy light clusters and their GPU buffers
+ */
+void nexus_light_clusters_destroy(NexusLightClusters* clusters) {
+    if (clusters == NULL) {
+        return;
+    }
+
+    if (clusters->device != NULL) {
+        NexusUploadManager* manager = nexus_upload_manager_get(clusters->device);
+        SDL_GPUBuffer* buffers[3] = { clusters->light_buffer, clusters->cluster_buffer, clusters->index_buffer };
+        for (int i = 0; i < 3; i++) {
+            if (buffers[i] != NULL) {
+                nexus_upload_manager_cancel_buffer(manager, buffers[i]);
+                SDL_ReleaseGPUBuffer(clusters->device, buffers[i]);
+            }
+        }
+    }
+
+    free(clusters->lights);
+    free(clusters->clusters);
+    free(clusters->bounds);
+    free(clusters->spheres);
+    free(clusters->ranges);
+    free(clusters->indices);
+    free(clusters);
+}
+
+/**
+ * Remove all lights, done once per frame before lights are added
+ */
+void nexus_light_clusters_reset(NexusLightClusters* clusters) {
+    if (clusters == NULL) {
+        return;
+    }
+
+    clusters->light_count = 0;
+    clusters->directional_count = 0;
+    clusters->built = false;
+}
+
+/**
+ * Add a light for the current frame
+ * @return false once NEXUS_MAX_LIGHTS lights were added
+ */
+bool nexus_light_clusters_add(NexusLightClusters* clusters, const NexusLightData* light) {
+    if (clusters == NULL || light == NULL) {
+        return false;
+    }
+
+    if (clusters->light_count >= NEXUS_MAX_LIGHTS) {
+        return false;
+    }
+
+    clusters->lights[clusters->light_count++] = *light;
+    return true;
+}
+
+/**
+ * Rebuild the view space bounds of every cluster for a projection
+ * Column major projection, the camera looks down -Z
+ */
+static void nexus_light_clusters_build_bounds(NexusLightClusters* clusters, const float* projection,
+                                              float near_plane, float far_plane) {
+    bool orthographic = projection[15] == 1.0f;
+    float depth_ratio = logf(far_plane / near_plane);
+
+    for (uint32_t z = 0; z < NEXUS_CLUSTER_GRID_Z; z++) {
+        float d0 = near_plane * expf(depth_ratio * (float)z / NEXUS_CLUSTER_GRID_Z);
+        float d1 = near_plane * expf(depth_ratio * (float)(z + 1) / NEXUS_CLUSTER_GRID_Z);
+
+        for (uint32_t y = 0; y < NEXUS_CLUSTER_GRID_Y; y++) {
+            /* Tile rows run top to bottom, NDC y points up */
+            float ndc_top = 1.0f - 2.0f * (float)y / NEXUS_CLUSTER_GRID_Y;
+            float ndc_bottom = 1.0f - 2.0f * (float)(y + 1) / NEXUS_CLUSTER_GRID_Y;
+
+            for (uint32_t x = 0; x < NEXUS_CLUSTER_GRID_X; x++) {
+                float ndc_left = -1.0f + 2.0f * (float)x / NEXUS_CLUSTER_GRID_X;
+                float ndc_right = -1.0f + 2.0f * (float)(x + 1) / NEXUS_CLUSTER_GRID_X;
+
+                float* bounds = &clusters->bounds[6 * (x + y * NEXUS_CLUSTER_GRID_X +
+                                                       z * NEXUS_CLUSTER_GRID_X * NEXUS_CLUSTER_GRID_Y)];
+                float min_x, max_x, min_y, max_y;
+                if (orthographic) {
+                    min_x = (ndc_left - projection[12]) / projection[0];
+                    max_x = (ndc_right - projection[12]) / projection[0];
+                    min_y = (ndc_bottom - projection[13]) / projection[5];
+                    max_y = (ndc_top - projection[13]) / projection[5];
+                } else {
+                    /* The tile's frustum widens with depth, the slice's far end is widest */
+                    float corners_x[4] = { ndc_left * d0, ndc_right * d0, ndc_left * d1, ndc_right * d1 };
+                    float corners_y[4] = { ndc_bottom * d0, ndc_top * d0, ndc_bottom * d1, ndc_top * d1 };
+                    min_x = max_x = corners_x[0] / projection[0];
+                    min_y = max_y = corners_y[0] / projection[5];
+                    for (int c = 1; c < 4; c++) {
+                        float cx = corners_x[c] / projection[0];
+                        float cy = corners_y[c] / projection[5];
+                        if (cx < min_x) min_x = cx;
+                        if (cx > max_x) max_x = cx;
+                        if (cy < min_y) min_y = cy;
+                        if (cy > max_y) max_y = cy;
+                    }
+                }
+
+                bounds[0] = min_x;
+                bounds[1] = min_y;
+                bounds[2] = -d1;
+                bounds[3] = max_x;
+                bounds[4] = max_y;
+                bounds[5] = -d0;
+            }
+        }
+    }
+
+    clusters->slice_scale = (float)NEXUS_CLUSTER_GRID_Z / depth_ratio;
+    clusters->slice_bias = -(float)NEXUS_CLUSTER_GRID_Z * logf(near_plane) / depth_ratio;
+}
+
+/**
+ * Tile column or row of an NDC coordinate
+ */
+static uint8_t nexus_light_clusters_tile(float t, uint32_t count) {
+    float tile = floorf(t * (float)count);
+    if (tile < 0.0f) return 0;
+    if (tile > (float)(count - 1)) return (uint8_t)(count - 1);
+    return (uint8_t)tile;
+}
+
+/**
+ * Find the cluster range a light's view space bounding sphere may touch
+ * @return false if the sphere is outside the depth range
+ */
+static bool nexus_light_clusters_range(const NexusLightClusters* clusters, const float* projection,
+                                       float near_plane, float far_plane, const float* sphere, uint8_t* range) {
+    float depth = -sphere[2];
+    float radius = sphere[3];
+    float d_min = depth - radius;
+    float d_max = depth + radius;
+    if (d_max < near_plane || d_min > far_plane) {
+        return false;
+    }
+
+    /* Depth slices */
+    float slice_min = d_min > near_plane ? logf(d_min) * clusters->slice_scale + clusters->slice_bias : 0.0f;
+    float slice_max = d_max < far_plane ? logf(d_max) * clusters->slice_scale + clusters->slice_bias :
+                      (float)(NEXUS_CLUSTER_GRID_Z - 1);
+    range[2] = nexus_light_clusters_tile(slice_min / NEXUS_CLUSTER_GRID_Z, NEXUS_CLUSTER_GRID_Z);
+    range[5] = nexus_light_clusters_tile(slice_max / NEXUS_CLUSTER_GRID_Z, NEXUS_CLUSTER_GRID_Z);
+
+    /* Screen rectangle of the sphere's box, whole screen if it reaches the camera */
+    bool orthographic = projection[15] == 1.0f;
+    float ndc[4] = { -1.0f, -1.0f, 1.0f, 1.0f };
+    if (orthographic || d_min > near_plane) {
+        float xs[2] = { sphere[0] - radius, sphere[0] + radius };
+        float ys[2] = { sphere[1] - radius, sphere[1] + radius };
+        ndc[0] = ndc[1] = FLT_MAX;
+        ndc[2] = ndc[3] = -FLT_MAX;
+        for (int i = 0; i < 2; i++) {
+            for (int d = 0; d < 2; d++) {
+                float w = orthographic ? 1.0f : (d == 0 ? d_min : d_max);
+                float nx = (projection[0] * xs[i] + projection[12]) / w;
+                float ny = (projection[5] * ys[i] + projection[13]) / w;
+                if (nx < ndc[0]) ndc[0] = nx;
+                if (ny < ndc[1]) ndc[1] = ny;
+                if (nx > ndc[2]) ndc[2] = nx;
+                if (ny > ndc[3]) ndc[3] = ny;
+            }
+        }
+        if (ndc[2] < -1.0f || ndc[0] > 1.0f || ndc[3] < -1.0f || ndc[1] > 1.0f) {
+            return false;
+        }
+    }
+
+    range[0] = nexus_light_clusters_tile((ndc[0] + 1.0f) * 0.5f, NEXUS_CLUSTER_GRID_X);
+    range[3] = nexus_light_clusters_tile((ndc[2] + 1.0f) * 0.5f, NEXUS_CLUSTER_GRID_X);
+    range[1] = nexus_light_clusters_tile((1.0f - ndc[3]) * 0.5f, NEXUS_CLUSTER_GRID_Y);
+    range[4] = nexus_light_clusters_tile((1.0f - ndc[1]) * 0.5f, NEXUS_CLUSTER_GRID_Y);
+    return true;
+}
+
+/**
+ * Test a sphere against a cluster's box
+ */
+static bool nexus_light_clusters_touches(const float* bounds, const float* sphere) {
+    float distance = 0.0f;
+    for (int k = 0; k < 3; k++) {
+        float v = sphere[k];
+        if (v < bounds[k]) {
+            distance += (bounds[k] - v) * (bounds[k] - v);
+        } else if (v > bounds[k + 3]) {
+            distance += (v - bounds[k + 3]) * (v - bounds[k + 3]);
+        }
+    }
+    return distance <= sphere[3] * sphere[3];
+}
+
+/**
+ * Bin the frame's lights into the clusters of a camera
+ * Directional lights are moved to the front of the light list, point and
+ * spot lights are tested with their bounding spheres (a spot light's cone
+ * gets its own tighter sphere). Column major view and projection, NULL
+ * matrices leave only the directional lights
+ */
+bool nexus_light_clusters_build(NexusLightClusters* clusters, const float* view, const float* projection,
+                                float near_plane, float far_plane) {
+    if (clusters == NULL) {
+        return false;
+    }
+
+    /* Directional lights first */
+    uint32_t directional = 0;
+    for (uint32_t i = 0; i < clusters->light_count; i++) {
+        if ((int)clusters->lights[i].direction_type[3] == NEXUS_LIGHT_TYPE_DIRECTIONAL) {
+            NexusLightData light = clusters->lights[i];
+            clusters->lights[i] = clusters->lights[directional];
+            clusters->lights[directional++] = light;
+        }
+    }
+    clusters->directional_count = directional;
+
+    /* Without a camera to bin for, every cluster is empty */
+    memset(clusters->clusters, 0, sizeof(NexusLightCluster) * NEXUS_CLUSTER_COUNT);
+    clusters->index_count = 0;
+    clusters->max_cluster_lights = 0;
+    clusters->built = true;
+    if (view == NULL || projection == NULL) {
+        return true;
+    }
+
+    if (near_plane < NEXUS_CLUSTER_MIN_NEAR) {
+        near_plane = NEXUS_CLUSTER_MIN_NEAR;
+    }
+    if (far_plane <= near_plane) {
+        far_plane = near_plane * 2.0f;
+    }
+
+    /* Cluster bounds only depend on the projection */
+    float key[7] = { projection[0], projection[5], projection[12], projection[13], projection[15],
+                     near_plane, far_plane };
+    if (memcmp(key, clusters->bounds_key, sizeof(key)) != 0) {
+        nexus_light_clusters_build_bounds(clusters, projection, near_plane, far_plane);
+        memcpy(clusters->bounds_key, key, sizeof(key));
+    }
+
+    /* View space bounding spheres and cluster ranges */
+    for (uint32_t i = directional; i < clusters->light_count; i++) {
+        const NexusLightData* light = &clusters->lights[i];
+        float center[3] = { light->position_range[0], light->position_range[1], light->position_range[2] };
+        float radius = light->position_range[3];
+
+        /* Bounding sphere of the cone, around its cap or along its axis when it is narrow */
+        if ((int)light->direction_type[3] == NEXUS_LIGHT_TYPE_SPOT) {
+            float cos_angle = light->spot[0];
+            float sin_angle = sqrtf(fmaxf(0.0f, 1.0f - cos_angle * cos_angle));
+            float offset;
+            if (cos_angle >= 0.70710678f) {
+                offset = radius / (2.0f * cos_angle);
+                radius = offset;
+            } else if (cos_angle > 0.0f) {
+                offset = radius * cos_angle;
+                radius = radius * sin_angle;
+            } else {
+                offset = 0.0f;
+            }
+            for (int k = 0; k < 3; k++) {
+                center[k] += light->direction_type[k] * offset;
+            }
+        }
+
+        float* sphere = &clusters->spheres[i * 4];
+        for (int k = 0; k < 3; k++) {
+            sphere[k] = view[k] * center[0] + view[4 + k] * center[1] + view[8 + k] * center[2] + view[12 + k];
+        }
+        sphere[3] = radius;
+
+        uint8_t* range = &clusters->ranges[i * 6];
+        if (radius <= 0.0f ||
+            !nexus_light_clusters_range(clusters, projection, near_plane, far_plane, sphere, range)) {
+            /* Empty range */
+            range[0] = range[1] = range[2] = 1;
+            range[3] = range[4] = range[5] = 0;
+        }
+    }
+
+    /* Count the lights of each cluster */
+    for (uint32_t i = directional; i < clusters->light_count; i++) {
+        const uint8_t* range = &clusters->ranges[i * 6];
+        const float* sphere = &clusters->spheres[i * 4];
+        for (uint32_t z = range[2]; z <= range[5]; z++) {
+            for (uint32_t y = range[1]; y <= range[4]; y++) {
+                for (uint32_t x = range[0]; x <= range[3]; x++) {
+                    uint32_t c = x + y * NEXUS_CLUSTER_GRID_X + z * NEXUS_CLUSTER_GRID_X * NEXUS_CLUSTER_GRID_Y;
+                    if (nexus_light_clusters_touches(&clusters->bounds[c * 6], sphere)) {
+                        clusters->clusters[c].count++;
+                    }
+                }
+            }
+        }
+    }
+
+    /* Prefix sum into offsets */
+    uint32_t total = 0;
+    uint32_t max_lights = 0;
+    for (uint32_t c = 0; c < NEXUS_CLUSTER_COUNT; c++) {
+        clusters->clusters[c].offset = total;
+        total += clusters->clusters[c].count;
+        if (clusters->clusters[c].count > max_lights) {
+            max_lights = clusters->clusters[c].count;
+        }
+        clusters->clusters[c].count = 0;
+    }
+
+    if (total > clusters->index_capacity) {
+        uint32_t capacity = clusters->index_capacity;
+        while (capacity < total) {
+            capacity *= 2;
+        }
+        uint32_t* indices = (uint32_t*)realloc(clusters->indices, sizeof(uint32_t) * capacity);
+        if (indices == NULL) {
+            fprintf(stderr, "Failed to allocate memory for light cluster indices!\n");
+            memset(clusters->clusters, 0, sizeof(NexusLightCluster) * NEXUS_CLUSTER_COUNT);
+            return false;
+        }
+        clusters->indices = indices;
+        clusters->index_capacity = capacity;
+    }
+
+    /* Fill the index list, lights stay in order within each cluster */
+    for (uint32_t i = directional; i < clusters->light_count; i++) {
+        const uint8_t* range = &clusters->ranges[i * 6];
+        const float* sphere = &clusters->spheres[i * 4];
+        for (uint32_t z = range[2]; z <= range[5]; z++) {
+            for (uint32_t y = range[1]; y <= range[4]; y++) {
+                for (uint32_t x = range[0]; x <= range[3]; x++) {
+                    uint32_t c = x + y * NEXUS_CLUSTER_GRID_X + z * NEXUS_CLUSTER_GRID_X * NEXUS_CLUSTER_GRID_Y;
+                    if (nexus_light_clusters_touches(&clusters->bounds[c * 6], sphere)) {
+                        NexusLightCluster* cluster = &clusters->clusters[c];
+                        clusters->indices[cluster->offset + cluster->count++] = i;
+                    }
+                }
+            }
+        }
+    }
+
+    clusters->index_count = total;
+    clusters->max_cluster_lights = max_lights;
+    return true;
+}
+
+/**
+ * Create a storage buffer, replacing an existing one
+ */
+static SDL_GPUBuffer* nexus_light_clusters_create_buffer(NexusLightClusters* clusters, NexusUploadManager* manager,
+                                                         SDL_GPUBuffer* old, uint32_t size) {
+    if (old != NULL) {
+        nexus_upload_manager_cancel_buffer(manager, old);
+        SDL_ReleaseGPUBuffer(clusters->device, old);
+    }
+
+    SDL_GPUBufferCreateInfo info = {
+        .usage = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ,
+        .size = size
+    };
+    SDL_GPUBuffer* buffer = SDL_CreateGPUBuffer(clusters->device, &info);
+    if (buffer == NULL) {
+        fprintf(stderr, "Failed to create light cluster buffer: %s\n", SDL_GetError());
+    }
+    return buffer;
+}
+
+/**
+ * Stage the lights, cluster table and light index list
+ * The buffers are cycled, frames in flight keep reading their own copy
+ */
+bool nexus_light_clusters_upload(NexusLightClusters* clusters, NexusUploadManager* manager) {
+    if (clusters == NULL || manager == NULL || clusters->device == NULL) {
+        return false;
+    }
+
+    /* Fixed size buffers on first use, the index buffer grows with the list */
+    if (clusters->light_buffer == NULL) {
+        clusters->light_buffer = nexus_light_clusters_create_buffer(clusters, manager, NULL,
+                                                                    sizeof(NexusLightData) * NEXUS_MAX_LIGHTS);
+    }
+    if (clusters->cluster_buffer == NULL) {
+        clusters->cluster_buffer = nexus_light_clusters_create_buffer(clusters, manager, NULL,
+                                                                      sizeof(NexusLightCluster) * NEXUS_CLUSTER_COUNT);
+    }
+    if (clusters->index_buffer == NULL || clusters->index_buffer_capacity < clusters->index_count) {
+        uint32_t capacity = clusters->index_buffer_capacity > 0 ? clusters->index_buffer_capacity :
+                            NEXUS_CLUSTER_INITIAL_INDICES;
+        while (capacity < clusters->index_count) {
+            capacity *= 2;
+        }
+        clusters->index_buffer = nexus_light_clusters_create_buffer(clusters, manager, clusters->index_buffer,
+                                                                    sizeof(uint32_t) * capacity);
+        clusters->index_buffer_capacity = clusters->index_buffer != NULL ? capacity : 0;
+    }
+    if (clusters->light_buffer == NULL || clusters->cluster_buffer == NULL || clusters->index_buffer == NULL) {
+        return false;
+    }
+
+    /* Empty lists leave the old contents, the cluster counts keep them unread */
+    bool success = nexus_upload_manager_upload_buffer(manager, clusters->cluster_buffer, 0, clusters->clusters,
+                                                      sizeof(NexusLightCluster) * NEXUS_CLUSTER_COUNT, true);
+    if (success && clusters->light_count > 0) {
+        success = nexus_upload_manager_upload_buffer(manager, clusters->light_buffer, 0, clusters->lights,
+                                                     sizeof(NexusLightData) * clusters->light_count, true);
+    }
+    if (success && clusters->index_count > 0) {
+        success = nexus_upload_manager_upload_buffer(manager, clusters->index_buffer, 0, clusters->indices,
+                                                     sizeof(uint32_t) * clusters->index_count, true);
+    }
+
+    if (!success) {
+        fprintf(stderr, "Failed to stage light clusters!\n");
+    }
+    return success;
+}
+
+/**
+ * Bind the light buffers to their fragment storage slots
+ */
+void nexus_light_clusters_bind(const NexusLightClusters* clusters, SDL_GPURenderPass* render_pass) {
+    if (clusters == NULL || render_pass == NULL || clusters->light_buffer == NULL ||
+        clusters->cluster_buffer == NULL || clusters->index_buffer == NULL) {
+        return;
+    }
+
+    SDL_GPUBuffer* buffers[NEXUS_STORAGE_SLOT_FRAGMENT_LIGHT_INDICES + 1];
+    buffers[NEXUS_STORAGE_SLOT_FRAGMENT_LIGHTS] = clusters->light_buffer;
+    buffers[NEXUS_STORAGE_SLOT_FRAGMENT_CLUSTERS] = clusters->cluster_buffer;
+    buffers[NEXUS_STORAGE_SLOT_FRAGMENT_LIGHT_INDICES] = clusters->index_buffer;
+    SDL_BindGPUFragmentStorageBuffers(render_pass, NEXUS_STORAGE_SLOT_FRAGMENT_LIGHTS, buffers,
+                                      NEXUS_STORAGE_SLOT_FRAGMENT_LIGHT_INDICES + 1);
+}
+
+/**
+ * Lights per screen tile for the debug heatmap, the most of any depth slice
+ * tiles holds NEXUS_CLUSTER_GRID_X * NEXUS_CLUSTER_GRID_Y counts, rows from the top
+ * @return The largest count
+ */
+uint32_t nexus_light_clusters_get_heatmap(const NexusLightClusters* clusters, uint32_t* tiles) {
+    if (clusters == NULL || tiles == NULL) {
+        return 0;
+    }
+
+    uint32_t tile_count = NEXUS_CLUSTER_GRID_X * NEXUS_CLUSTER_GRID_Y;
+    memset(tiles, 0, sizeof(uint32_t) * tile_count);
+    if (!clusters->built) {
+        return 0;
+    }
+
+    uint32_t max_count = 0;
+    for (uint32_t c = 0; c < NEXUS_CLUSTER_COUNT; c++) {
+        uint32_t tile = c % tile_count;
+        uint32_t count = clusters->clusters[c].count;
+        if (count > tiles[tile]) {
+            tiles[tile] = count;
+            if (count > max_count) {
+                max_count = count;
+            }
+        }
+    }
+    return max_count;
+}
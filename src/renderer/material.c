@@ -4,6 +4,7 @@
  */
 
 #include "nexus3d/renderer/material.h"
+#include "nexus3d/renderer/pipeline_cache.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -273,43 +274,57 @@ void nexus_material_set_receive_shadows(NexusMaterial* material, bool receive_sh
 /**
  * Apply material to a render pass
  */
-void nexus_material_apply(NexusMaterial* material, SDL_GPURenderPass* render_pass) {
+void nexus_material_apply(NexusMaterial* material, SDL_GPUCommandBuffer* cmd_buffer, SDL_GPURenderPass* render_pass) {
     if (material == NULL || render_pass == NULL || material->shader == NULL) {
         return;
     }
     
-    /* Bind shader pipeline */
-    nexus_shader_bind(material->shader, render_pass);
-    
-    /* Set material properties as shader uniforms */
-    nexus_shader_set_uniform_float4(material->shader, "u_baseColor", 
-                                   material->base_color[0], 
-                                   material->base_color[1], 
-                                   material->base_color[2], 
-                                   material->base_color[3]);
-    
-    nexus_shader_set_uniform_float(material->shader, "u_metallic", material->metallic);
-    nexus_shader_set_uniform_float(material->shader, "u_roughness", material->roughness);
-    nexus_shader_set_uniform_float(material->shader, "u_ao", material->ao);
-    
-    nexus_shader_set_uniform_float3(material->shader, "u_emissive", 
-                                   material->emissive_factor[0], 
-                                   material->emissive_factor[1], 
-                                   material->emissive_factor[2]);
-    
+    /* Bind the pipeline variant for the material's render state */
+    NexusPipelineCache* cache = nexus_pipeline_cache_get(material->shader->device);
+    NexusPipelineState state;
+    nexus_pipeline_cache_get_state(cache, material, &state);
+    state.vertex_layout = material->shader->vertex_layout;
+    SDL_GPUGraphicsPipeline* pipeline = nexus_pipeline_cache_acquire(cache, material->shader, &state);
+    if (pipeline != NULL) {
+        SDL_BindGPUGraphicsPipeline(render_pass, pipeline);
+    } else {
+        nexus_shader_bind(material->shader, render_pass);
+    }
+
+    /* Set material parameters */
+    nexus_material_apply_parameters(material, cmd_buffer);
+}
+
+/**
+ * Apply material parameters without rebinding the shader pipeline
+ * Used by the render queue when consecutive draws share a pipeline
+ */
+void nexus_material_apply_parameters(NexusMaterial* material, SDL_GPUCommandBuffer* cmd_buffer) {
+    if (material == NULL || cmd_buffer == NULL) {
+        return;
+    }
+
+    /* Fill the material uniform block in one go */
+    NexusMaterialUniforms uniforms;
+    memset(&uniforms, 0, sizeof(uniforms));
+    memcpy(uniforms.base_color, material->base_color, sizeof(uniforms.base_color));
+    uniforms.emissive[0] = material->emissive_factor[0];
+    uniforms.emissive[1] = material->emissive_factor[1];
+    uniforms.emissive[2] = material->emissive_factor[2];
+    uniforms.metallic = material->metallic;
+    uniforms.roughness = material->roughness;
+    uniforms.ao = material->ao;
+
     /* Set texture map presence flags */
-    nexus_shader_set_uniform_int(material->shader, "u_hasAlbedoMap", 
-                                material->albedo_map != NULL ? 1 : 0);
-    nexus_shader_set_uniform_int(material->shader, "u_hasNormalMap", 
-                                material->normal_map != NULL ? 1 : 0);
-    nexus_shader_set_uniform_int(material->shader, "u_hasMetallicMap", 
-                                material->metallic_map != NULL ? 1 : 0);
-    nexus_shader_set_uniform_int(material->shader, "u_hasRoughnessMap", 
-                                material->roughness_map != NULL ? 1 : 0);
-    nexus_shader_set_uniform_int(material->shader, "u_hasAOMap", 
-                                material->ao_map != NULL ? 1 : 0);
-    nexus_shader_set_uniform_int(material->shader, "u_hasEmissiveMap", 
-                                material->emissive_map != NULL ? 1 : 0);
+    if (material->albedo_map != NULL)    uniforms.map_flags |= NEXUS_MATERIAL_HAS_ALBEDO_MAP;
+    if (material->normal_map != NULL)    uniforms.map_flags |= NEXUS_MATERIAL_HAS_NORMAL_MAP;
+    if (material->metallic_map != NULL)  uniforms.map_flags |= NEXUS_MATERIAL_HAS_METALLIC_MAP;
+    if (material->roughness_map != NULL) uniforms.map_flags |= NEXUS_MATERIAL_HAS_ROUGHNESS_MAP;
+    if (material->ao_map != NULL)        uniforms.map_flags |= NEXUS_MATERIAL_HAS_AO_MAP;
+    if (material->emissive_map != NULL)  uniforms.map_flags |= NEXUS_MATERIAL_HAS_EMISSIVE_MAP;
+
+    /* Single push instead of one call per parameter */
+    SDL_PushGPUFragmentUniformData(cmd_buffer, NEXUS_UNIFORM_SLOT_FRAGMENT_MATERIAL, &uniforms, sizeof(uniforms));
     
     /* Bind textures if available */
     /* Note: This will be implemented once the texture system is complete */
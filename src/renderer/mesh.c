@@ -4,11 +4,127 @@
  */
 
 #include "nexus3d/renderer/mesh.h"
+#include "nexus3d/renderer/mesh_file.h"
+#include "nexus3d/renderer/mesh_optimize.h"
+#include "nexus3d/renderer/mesh_simplify.h"
+#include "nexus3d/renderer/upload.h"
+#include "nexus3d/utils/allocator.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
+/* Mesh handles per pool chunk */
+#define NEXUS_MESH_POOL_CHUNK 64
+
+/* Mesh handles come from a pool, their GPU buffers are separate */
+static NexusPool g_mesh_pool = NEXUS_POOL_INIT(NexusMesh, NEXUS_MESH_POOL_CHUNK);
+
+/**
+ * Upload data into a mesh buffer
+ * Goes through the device's shared upload manager when there is one, so the
+ * copy is batched with all other uploads, and falls back to a one-off copy pass
+ */
+static bool nexus_mesh_upload(NexusMesh* mesh, SDL_GPUBuffer* buffer, const void* data, uint32_t size) {
+    NexusUploadManager* uploader = nexus_upload_manager_get(mesh->device);
+    if (uploader != NULL) {
+        return nexus_upload_manager_upload_buffer(uploader, buffer, 0, data, size, false);
+    }
+
+    /* Create a transfer buffer for this upload only */
+    SDL_GPUTransferBufferCreateInfo transfer_info = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = size
+    };
+
+    SDL_GPUTransferBuffer* transfer_buffer = SDL_CreateGPUTransferBuffer(mesh->device, &transfer_info);
+    if (transfer_buffer == NULL) {
+        fprintf(stderr, "Failed to create transfer buffer: %s\n", SDL_GetError());
+        return false;
+    }
+
+    /* Copy data to the transfer buffer */
+    void* transfer_data = SDL_MapGPUTransferBuffer(mesh->device, transfer_buffer, false);
+    if (transfer_data == NULL) {
+        fprintf(stderr, "Failed to map transfer buffer: %s\n", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(mesh->device, transfer_buffer);
+        return false;
+    }
+    memcpy(transfer_data, data, size);
+    SDL_UnmapGPUTransferBuffer(mesh->device, transfer_buffer);
+
+    /* Begin a copy pass to upload data */
+    SDL_GPUCommandBuffer* cmd_buffer = SDL_AcquireGPUCommandBuffer(mesh->device);
+    if (cmd_buffer == NULL) {
+        fprintf(stderr, "Failed to acquire command buffer: %s\n", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(mesh->device, transfer_buffer);
+        return false;
+    }
+
+    SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass(cmd_buffer);
+    if (copy_pass == NULL) {
+        fprintf(stderr, "Failed to begin copy pass: %s\n", SDL_GetError());
+        SDL_CancelGPUCommandBuffer(cmd_buffer);
+        SDL_ReleaseGPUTransferBuffer(mesh->device, transfer_buffer);
+        return false;
+    }
+
+    /* Upload */
+    SDL_GPUTransferBufferLocation src_location = {
+        .transfer_buffer = transfer_buffer,
+        .offset = 0
+    };
+
+    SDL_GPUBufferRegion dst_region = {
+        .buffer = buffer,
+        .offset = 0,
+        .size = size
+    };
+
+    SDL_UploadToGPUBuffer(copy_pass, &src_location, &dst_region, false);
+    SDL_EndGPUCopyPass(copy_pass);
+    SDL_SubmitGPUCommandBuffer(cmd_buffer);
+
+    /* The GPU keeps the transfer buffer alive until the copy has run */
+    SDL_ReleaseGPUTransferBuffer(mesh->device, transfer_buffer);
+    return true;
+}
+
+/**
+ * Create a GPU buffer and queue its contents
+ */
+static SDL_GPUBuffer* nexus_mesh_create_buffer(NexusMesh* mesh, SDL_GPUBufferUsageFlags usage,
+                                               const void* data, uint32_t size) {
+    SDL_GPUBufferCreateInfo buffer_info = {
+        .size = size,
+        .usage = usage
+    };
+
+    SDL_GPUBuffer* buffer = SDL_CreateGPUBuffer(mesh->device, &buffer_info);
+    if (buffer == NULL) {
+        fprintf(stderr, "Failed to create mesh buffer: %s\n", SDL_GetError());
+        return NULL;
+    }
+
+    if (!nexus_mesh_upload(mesh, buffer, data, size)) {
+        SDL_ReleaseGPUBuffer(mesh->device, buffer);
+        return NULL;
+    }
+
+    return buffer;
+}
+
+/**
+ * Release a mesh buffer and cancel its pending uploads
+ */
+static void nexus_mesh_release_buffer(NexusMesh* mesh, SDL_GPUBuffer** buffer) {
+    if (*buffer != NULL) {
+        nexus_upload_manager_cancel_buffer(nexus_upload_manager_get(mesh->device), *buffer);
+        SDL_ReleaseGPUBuffer(mesh->device, *buffer);
+        *buffer = NULL;
+    }
+}
+
 /**
  * Create a mesh
  */
@@ -20,7 +136,7 @@ NexusMesh* nexus_mesh_create(SDL_GPUDevice* device) {
     }
 
     /* Allocate mesh structure */
-    NexusMesh* mesh = (NexusMesh*)malloc(sizeof(NexusMesh));
+    NexusMesh* mesh = (NexusMesh*)nexus_pool_alloc(&g_mesh_pool);
     if (mesh == NULL) {
         fprintf(stderr, "Failed to allocate memory for mesh!");
         return NULL;
@@ -31,20 +147,8 @@ NexusMesh* nexus_mesh_create(SDL_GPUDevice* device) {
 
     /* Store GPU device reference */
     mesh->device = device;
-
-    /* Create transfer buffer for uploading vertex and index data */
-    SDL_GPUTransferBufferCreateInfo transfer_info = {
-        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
-        .size = 1024 * 1024  /* 1MB initial size */
-    };
-
-    mesh->transfer_buffer = SDL_CreateGPUTransferBuffer(device, &transfer_info);
-    if (mesh->transfer_buffer == NULL) {
-        fprintf(stderr, "Failed to create transfer buffer: %s\
-", SDL_GetError());
-        free(mesh);
-        return NULL;
-    }
+    mesh->vertex_layout = NEXUS_VERTEX_LAYOUT_DEFAULT;
+    mesh->index_size = SDL_GPU_INDEXELEMENTSIZE_32BIT;
 
     return mesh;
 }
@@ -57,250 +161,396 @@ void nexus_mesh_destroy(NexusMesh* mesh) {
         return;
     }
 
-    /* Release vertex buffer */
-    if (mesh->vertex_buffer != NULL) {
-        SDL_ReleaseGPUBuffer(mesh->device, mesh->vertex_buffer);
-        mesh->vertex_buffer = NULL;
-    }
+    /* Uploads into the buffers must not run after they are released */
+    nexus_mesh_release_buffer(mesh, &mesh->vertex_buffer);
+    nexus_mesh_release_buffer(mesh, &mesh->position_buffer);
+    nexus_mesh_release_buffer(mesh, &mesh->index_buffer);
+
+    free(mesh->lods);
+    free(mesh->meshlets);
+
+    /* Return mesh structure to the pool */
+    nexus_pool_free(&g_mesh_pool, mesh);
+}
+
+/**
+ * Get statistics of the mesh handle pool
+ */
+NexusPoolStats nexus_mesh_get_pool_stats(void) {
+    return nexus_pool_get_stats(&g_mesh_pool);
+}
 
-    /* Release index buffer */
-    if (mesh->index_buffer != NULL) {
-        SDL_ReleaseGPUBuffer(mesh->device, mesh->index_buffer);
-        mesh->index_buffer = NULL;
+/**
+ * Convert vertices to a layout and store them in a new vertex buffer
+ */
+static SDL_GPUBuffer* nexus_mesh_create_vertex_buffer(NexusMesh* mesh, uint32_t layout,
+                                                      const NexusVertex* vertices, uint32_t vertex_count) {
+    /* Full precision vertices upload as they are */
+    if (layout == NEXUS_VERTEX_LAYOUT_DEFAULT) {
+        return nexus_mesh_create_buffer(mesh, SDL_GPU_BUFFERUSAGE_VERTEX, vertices,
+                                        vertex_count * (uint32_t)sizeof(NexusVertex));
     }
 
-    /* Release transfer buffer */
-    if (mesh->transfer_buffer != NULL) {
-        SDL_ReleaseGPUTransferBuffer(mesh->device, mesh->transfer_buffer);
-        mesh->transfer_buffer = NULL;
+    uint32_t size = vertex_count * nexus_vertex_layout_get_stride(layout);
+    NexusScratch scratch = nexus_scratch_begin();
+    void* encoded = nexus_scratch_alloc(&scratch, size);
+    SDL_GPUBuffer* buffer = NULL;
+    if (encoded == NULL) {
+        fprintf(stderr, "Failed to allocate memory for mesh vertices!\n");
+    } else if (nexus_vertex_layout_encode(layout, vertices, vertex_count, encoded)) {
+        buffer = nexus_mesh_create_buffer(mesh, SDL_GPU_BUFFERUSAGE_VERTEX, encoded, size);
     }
+    nexus_scratch_end(&scratch);
 
-    /* Free mesh structure */
-    free(mesh);
+    return buffer;
 }
 
 /**
- * Set vertex data for a mesh
+ * Create and fill the vertex buffers of a mesh in its layout
  */
-bool nexus_mesh_set_vertices(NexusMesh* mesh, const NexusVertex* vertices, uint32_t vertex_count) {
-    if (mesh == NULL || vertices == NULL || vertex_count == 0) {
+static bool nexus_mesh_store_vertices(NexusMesh* mesh, const NexusVertex* vertices, uint32_t vertex_count) {
+    SDL_GPUBuffer* vertex_buffer = nexus_mesh_create_vertex_buffer(mesh, mesh->vertex_layout, vertices, vertex_count);
+    if (vertex_buffer == NULL) {
         return false;
     }
 
-    /* Calculate vertex data size */
-    uint32_t vertex_data_size = vertex_count * sizeof(NexusVertex);
-
-    /* Map the transfer buffer */
-    void* transfer_data = SDL_MapGPUTransferBuffer(mesh->device, mesh->transfer_buffer, true);
-    if (transfer_data == NULL) {
-        fprintf(stderr, "Failed to map transfer buffer: %s\
-", SDL_GetError());
-        return false;
+    /* Depth passes read the positions alone, a third of the default layout's bandwidth */
+    SDL_GPUBuffer* position_buffer = NULL;
+    if (mesh->position_stream && mesh->vertex_layout != NEXUS_VERTEX_LAYOUT_POSITION) {
+        position_buffer = nexus_mesh_create_vertex_buffer(mesh, NEXUS_VERTEX_LAYOUT_POSITION, vertices, vertex_count);
+        if (position_buffer == NULL) {
+            nexus_mesh_release_buffer(mesh, &vertex_buffer);
+            return false;
+        }
     }
 
-    /* Copy vertex data to transfer buffer */
-    memcpy(transfer_data, vertices, vertex_data_size);
+    /* Release old vertex buffers if they exist */
+    nexus_mesh_release_buffer(mesh, &mesh->vertex_buffer);
+    nexus_mesh_release_buffer(mesh, &mesh->position_buffer);
 
-    /* Unmap the transfer buffer */
-    SDL_UnmapGPUTransferBuffer(mesh->device, mesh->transfer_buffer);
+    /* Store the new vertex buffers */
+    mesh->vertex_buffer = vertex_buffer;
+    mesh->position_buffer = position_buffer;
+    mesh->vertex_count = vertex_count;
 
-    /* Create vertex buffer */
-    SDL_GPUBufferCreateInfo buffer_info = {
-        .size = vertex_data_size,
-        .usage = SDL_GPU_BUFFERUSAGE_VERTEX
-    };
+    return true;
+}
 
-    SDL_GPUBuffer* vertex_buffer = SDL_CreateGPUBuffer(mesh->device, &buffer_info);
-    if (vertex_buffer == NULL) {
-        fprintf(stderr, "Failed to create vertex buffer: %s\
-", SDL_GetError());
-        return false;
+/**
+ * Select the vertex layout of a mesh, takes effect on the next nexus_mesh_set_vertices
+ * With position_stream a position only copy is kept for depth passes
+ */
+void nexus_mesh_set_vertex_layout(NexusMesh* mesh, uint32_t vertex_layout, bool position_stream) {
+    if (mesh == NULL) {
+        return;
     }
 
-    /* Begin a copy pass to upload data */
-    SDL_GPUCommandBuffer* cmd_buffer = SDL_AcquireGPUCommandBuffer(mesh->device);
-    if (cmd_buffer == NULL) {
-        fprintf(stderr, "Failed to acquire command buffer: %s\
-", SDL_GetError());
-        SDL_ReleaseGPUBuffer(mesh->device, vertex_buffer);
-        return false;
+    if (nexus_vertex_layout_get(vertex_layout) == NULL) {
+        fprintf(stderr, "Unknown vertex layout %u!\n", vertex_layout);
+        return;
     }
 
-    SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass(cmd_buffer);
-    if (copy_pass == NULL) {
-        fprintf(stderr, "Failed to begin copy pass: %s\
-", SDL_GetError());
-        SDL_CancelGPUCommandBuffer(cmd_buffer);
-        SDL_ReleaseGPUBuffer(mesh->device, vertex_buffer);
+    mesh->vertex_layout = vertex_layout;
+    mesh->position_stream = position_stream;
+}
+
+/**
+ * Get the vertex layout of a mesh's vertex buffer
+ */
+uint32_t nexus_mesh_get_vertex_layout(const NexusMesh* mesh) {
+    return mesh != NULL ? mesh->vertex_layout : NEXUS_VERTEX_LAYOUT_DEFAULT;
+}
+
+/**
+ * Set vertex data for a mesh
+ */
+bool nexus_mesh_set_vertices(NexusMesh* mesh, const NexusVertex* vertices, uint32_t vertex_count) {
+    if (mesh == NULL || vertices == NULL || vertex_count == 0) {
         return false;
     }
 
-    /* Set up buffer upload */
-    SDL_GPUTransferBufferLocation src_location = {
-        .transfer_buffer = mesh->transfer_buffer,
-        .offset = 0
-    };
+    if (!nexus_mesh_store_vertices(mesh, vertices, vertex_count)) {
+        return false;
+    }
 
-    SDL_GPUBufferRegion dst_region = {
-        .buffer = vertex_buffer,
-        .offset = 0,
-        .size = vertex_data_size
-    };
+    /* Compute local bounds for culling */
+    for (int axis = 0; axis < 3; axis++) {
+        mesh->bounds_min[axis] = vertices[0].position[axis];
+        mesh->bounds_max[axis] = vertices[0].position[axis];
+    }
+    for (uint32_t i = 1; i < vertex_count; i++) {
+        for (int axis = 0; axis < 3; axis++) {
+            float value = vertices[i].position[axis];
+            if (value < mesh->bounds_min[axis]) mesh->bounds_min[axis] = value;
+            if (value > mesh->bounds_max[axis]) mesh->bounds_max[axis] = value;
+        }
+    }
 
-    /* Upload vertex data */
-    SDL_UploadToGPUBuffer(copy_pass, &src_location, &dst_region, true);
+    return true;
+}
 
-    /* End copy pass */
-    SDL_EndGPUCopyPass(copy_pass);
+/**
+ * Get the local space bounding box of a mesh
+ */
+void nexus_mesh_get_bounds(const NexusMesh* mesh, float* min, float* max) {
+    if (mesh == NULL || min == NULL || max == NULL) {
+        return;
+    }
 
-    /* Submit command buffer */
-    SDL_SubmitGPUCommandBuffer(cmd_buffer);
+    for (int axis = 0; axis < 3; axis++) {
+        min[axis] = mesh->bounds_min[axis];
+        max[axis] = mesh->bounds_max[axis];
+    }
+}
 
-    /* Release old vertex buffer if exists */
-    if (mesh->vertex_buffer != NULL) {
-        SDL_ReleaseGPUBuffer(mesh->device, mesh->vertex_buffer);
+/**
+ * Store an index buffer in the given element size
+ */
+static bool nexus_mesh_store_indices(NexusMesh* mesh, const void* indices, uint32_t index_count,
+                                     SDL_GPUIndexElementSize index_size) {
+    uint32_t element_size = index_size == SDL_GPU_INDEXELEMENTSIZE_16BIT ? sizeof(uint16_t) : sizeof(uint32_t);
+    SDL_GPUBuffer* index_buffer = nexus_mesh_create_buffer(mesh, SDL_GPU_BUFFERUSAGE_INDEX, indices,
+                                                           index_count * element_size);
+    if (index_buffer == NULL) {
+        return false;
     }
 
-    /* Store the new vertex buffer */
-    mesh->vertex_buffer = vertex_buffer;
-    mesh->vertex_count = vertex_count;
+    /* Release old index buffer if exists */
+    nexus_mesh_release_buffer(mesh, &mesh->index_buffer);
+
+    /* Store the new index buffer */
+    mesh->index_buffer = index_buffer;
+    mesh->index_count = index_count;
+    mesh->index_size = index_size;
+    mesh->has_indices = true;
 
     return true;
 }
 
 /**
  * Set index data for a mesh
+ * Indices that all fit in 16 bits are narrowed, halving the index fetch
  */
 bool nexus_mesh_set_indices(NexusMesh* mesh, const uint32_t* indices, uint32_t index_count) {
     if (mesh == NULL || indices == NULL || index_count == 0) {
         return false;
     }
 
-    /* Calculate index data size */
-    uint32_t index_data_size = index_count * sizeof(uint32_t);
+    uint32_t max_index = 0;
+    for (uint32_t i = 0; i < index_count; i++) {
+        if (indices[i] > max_index) {
+            max_index = indices[i];
+        }
+    }
 
-    /* Map the transfer buffer */
-    void* transfer_data = SDL_MapGPUTransferBuffer(mesh->device, mesh->transfer_buffer, true);
-    if (transfer_data == NULL) {
-        fprintf(stderr, "Failed to map transfer buffer: %s\
-", SDL_GetError());
+    if (max_index >= NEXUS_MESH_MAX_16BIT_VERTICES) {
+        return nexus_mesh_store_indices(mesh, indices, index_count, SDL_GPU_INDEXELEMENTSIZE_32BIT);
+    }
+
+    NexusScratch scratch = nexus_scratch_begin();
+    uint16_t* narrow = (uint16_t*)nexus_scratch_alloc(&scratch, index_count * sizeof(uint16_t));
+    bool result;
+    if (narrow != NULL) {
+        for (uint32_t i = 0; i < index_count; i++) {
+            narrow[i] = (uint16_t)indices[i];
+        }
+        result = nexus_mesh_store_indices(mesh, narrow, index_count, SDL_GPU_INDEXELEMENTSIZE_16BIT);
+    } else {
+        /* No scratch memory, the wide indices still work */
+        result = nexus_mesh_store_indices(mesh, indices, index_count, SDL_GPU_INDEXELEMENTSIZE_32BIT);
+    }
+    nexus_scratch_end(&scratch);
+
+    return result;
+}
+
+/**
+ * Set 16-bit index data for a mesh
+ */
+bool nexus_mesh_set_indices16(NexusMesh* mesh, const uint16_t* indices, uint32_t index_count) {
+    if (mesh == NULL || indices == NULL || index_count == 0) {
         return false;
     }
 
-    /* Copy index data to transfer buffer */
-    memcpy(transfer_data, indices, index_data_size);
+    return nexus_mesh_store_indices(mesh, indices, index_count, SDL_GPU_INDEXELEMENTSIZE_16BIT);
+}
 
-    /* Unmap the transfer buffer */
-    SDL_UnmapGPUTransferBuffer(mesh->device, mesh->transfer_buffer);
+/**
+ * Bind the mesh vertex and index buffers to a render pass
+ */
+void nexus_mesh_bind(NexusMesh* mesh, SDL_GPURenderPass* render_pass) {
+    if (mesh == NULL || render_pass == NULL || mesh->vertex_buffer == NULL) {
+        return;
+    }
 
-    /* Create index buffer */
-    SDL_GPUBufferCreateInfo buffer_info = {
-        .size = index_data_size,
-        .usage = SDL_GPU_BUFFERUSAGE_INDEX
+    /* Bind vertex buffer */
+    SDL_GPUBufferBinding vertex_binding = {
+        .buffer = mesh->vertex_buffer,
+        .offset = 0
     };
 
-    SDL_GPUBuffer* index_buffer = SDL_CreateGPUBuffer(mesh->device, &buffer_info);
-    if (index_buffer == NULL) {
-        fprintf(stderr, "Failed to create index buffer: %s\
-", SDL_GetError());
-        return false;
+    SDL_BindGPUVertexBuffers(render_pass, 0, &vertex_binding, 1);
+
+    /* Bind index buffer */
+    if (mesh->has_indices && mesh->index_buffer != NULL) {
+        SDL_GPUBufferBinding index_binding = {
+            .buffer = mesh->index_buffer,
+            .offset = 0
+        };
+
+        SDL_BindGPUIndexBuffer(render_pass, &index_binding, mesh->index_size);
     }
+}
 
-    /* Begin a copy pass to upload data */
-    SDL_GPUCommandBuffer* cmd_buffer = SDL_AcquireGPUCommandBuffer(mesh->device);
-    if (cmd_buffer == NULL) {
-        fprintf(stderr, "Failed to acquire command buffer: %s\
-", SDL_GetError());
-        SDL_ReleaseGPUBuffer(mesh->device, index_buffer);
+/**
+ * Bind the position only stream and index buffer for a NEXUS_VERTEX_LAYOUT_POSITION pipeline
+ * @return false if the mesh has no position stream
+ */
+bool nexus_mesh_bind_positions(NexusMesh* mesh, SDL_GPURenderPass* render_pass) {
+    if (mesh == NULL || render_pass == NULL) {
         return false;
     }
 
-    SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass(cmd_buffer);
-    if (copy_pass == NULL) {
-        fprintf(stderr, "Failed to begin copy pass: %s\
-", SDL_GetError());
-        SDL_CancelGPUCommandBuffer(cmd_buffer);
-        SDL_ReleaseGPUBuffer(mesh->device, index_buffer);
+    /* A position layout mesh is its own position stream */
+    SDL_GPUBuffer* positions = mesh->vertex_layout == NEXUS_VERTEX_LAYOUT_POSITION ?
+        mesh->vertex_buffer : mesh->position_buffer;
+    if (positions == NULL) {
         return false;
     }
 
-    /* Set up buffer upload */
-    SDL_GPUTransferBufferLocation src_location = {
-        .transfer_buffer = mesh->transfer_buffer,
+    SDL_GPUBufferBinding vertex_binding = {
+        .buffer = positions,
         .offset = 0
     };
 
-    SDL_GPUBufferRegion dst_region = {
-        .buffer = index_buffer,
-        .offset = 0,
-        .size = index_data_size
-    };
+    SDL_BindGPUVertexBuffers(render_pass, 0, &vertex_binding, 1);
 
-    /* Upload index data */
-    SDL_UploadToGPUBuffer(copy_pass, &src_location, &dst_region, true);
+    if (mesh->has_indices && mesh->index_buffer != NULL) {
+        SDL_GPUBufferBinding index_binding = {
+            .buffer = mesh->index_buffer,
+            .offset = 0
+        };
 
-    /* End copy pass */
-    SDL_EndGPUCopyPass(copy_pass);
+        SDL_BindGPUIndexBuffer(render_pass, &index_binding, mesh->index_size);
+    }
 
-    /* Submit command buffer */
-    SDL_SubmitGPUCommandBuffer(cmd_buffer);
+    return true;
+}
 
-    /* Release old index buffer if exists */
-    if (mesh->index_buffer != NULL) {
-        SDL_ReleaseGPUBuffer(mesh->device, mesh->index_buffer);
+/**
+ * Set the detail levels of a mesh, ranges of its index buffer
+ * Level 0 is the full detail mesh, errors must grow along the chain
+ */
+bool nexus_mesh_set_lods(NexusMesh* mesh, const NexusMeshLod* lods, uint32_t lod_count) {
+    if (mesh == NULL || (lods == NULL && lod_count > 0)) {
+        return false;
     }
 
-    /* Store the new index buffer */
-    mesh->index_buffer = index_buffer;
-    mesh->index_count = index_count;
-    mesh->has_indices = true;
+    if (lod_count > NEXUS_MESH_MAX_LODS) {
+        fprintf(stderr, "Mesh has %u LODs, at most %d are supported!\n", lod_count, NEXUS_MESH_MAX_LODS);
+        return false;
+    }
 
+    for (uint32_t l = 0; l < lod_count; l++) {
+        if (lods[l].index_offset + lods[l].index_count > mesh->index_count) {
+            fprintf(stderr, "Mesh LOD %u is outside the index buffer!\n", l);
+            return false;
+        }
+    }
+
+    NexusMeshLod* copy = NULL;
+    if (lod_count > 0) {
+        copy = (NexusMeshLod*)malloc(sizeof(NexusMeshLod) * lod_count);
+        if (copy == NULL) {
+            fprintf(stderr, "Failed to allocate memory for mesh LODs!\n");
+            return false;
+        }
+        memcpy(copy, lods, sizeof(NexusMeshLod) * lod_count);
+    }
+
+    free(mesh->lods);
+    mesh->lods = copy;
+    mesh->lod_count = lod_count;
     return true;
 }
 
 /**
- * Draw a mesh in a render pass
- * @return The number of triangles drawn
+ * Get the number of detail levels of a mesh (1 for a mesh without LODs)
  */
-uint32_t nexus_mesh_draw(NexusMesh* mesh, SDL_GPURenderPass* render_pass) {
-    if (mesh == NULL || render_pass == NULL || mesh->vertex_buffer == NULL) {
+uint32_t nexus_mesh_get_lod_count(const NexusMesh* mesh) {
+    if (mesh == NULL) {
         return 0;
     }
 
-    /* Bind vertex buffer */
-    SDL_GPUBufferBinding vertex_binding = {
-        .buffer = mesh->vertex_buffer,
-        .offset = 0
-    };
+    return mesh->lod_count > 0 ? mesh->lod_count : 1;
+}
 
-    SDL_BindGPUVertexBuffers(render_pass, 0, &vertex_binding, 1);
+/**
+ * Draw instances of one detail level of a mesh whose buffers are already bound
+ * Levels past the end of the chain draw the coarsest level
+ * @return The number of triangles drawn
+ */
+uint32_t nexus_mesh_draw_lod_instanced(NexusMesh* mesh, SDL_GPURenderPass* render_pass, uint32_t lod,
+                                       uint32_t instance_count, uint32_t first_instance) {
+    if (mesh == NULL || render_pass == NULL || mesh->vertex_buffer == NULL || instance_count == 0) {
+        return 0;
+    }
 
     uint32_t triangle_count = 0;
 
     /* Draw the mesh */
     if (mesh->has_indices && mesh->index_buffer != NULL) {
-        /* Bind index buffer */
-        SDL_GPUBufferBinding index_binding = {
-            .buffer = mesh->index_buffer,
-            .offset = 0
-        };
-
-        SDL_BindGPUIndexBuffer(render_pass, &index_binding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
+        /* Index range of the level, the whole buffer without LODs */
+        uint32_t index_offset = 0;
+        uint32_t index_count = mesh->index_count;
+        if (mesh->lod_count > 0) {
+            const NexusMeshLod* level = &mesh->lods[lod < mesh->lod_count ? lod : mesh->lod_count - 1];
+            index_offset = level->index_offset;
+            index_count = level->index_count;
+        }
 
         /* Draw indexed primitives */
-        SDL_DrawGPUIndexedPrimitives(render_pass, mesh->index_count, 1, 0, 0, 0);
-        
+        SDL_DrawGPUIndexedPrimitives(render_pass, index_count, instance_count, index_offset, 0, first_instance);
+
         /* Calculate triangle count (each 3 indices = 1 triangle) */
-        triangle_count = mesh->index_count / 3;
+        triangle_count = index_count / 3;
     } else {
         /* Draw non-indexed primitives */
-        SDL_DrawGPUPrimitives(render_pass, mesh->vertex_count, 1, 0, 0);
-        
+        SDL_DrawGPUPrimitives(render_pass, mesh->vertex_count, instance_count, 0, first_instance);
+
         /* Calculate triangle count (each 3 vertices = 1 triangle) */
         triangle_count = mesh->vertex_count / 3;
     }
-    
-    return triangle_count;
+
+    return triangle_count * instance_count;
+}
+
+/**
+ * Draw instances of a mesh whose buffers are already bound (see nexus_mesh_bind)
+ * Meshes with LODs draw their full detail level
+ * @return The number of triangles drawn
+ */
+uint32_t nexus_mesh_draw_instanced(NexusMesh* mesh, SDL_GPURenderPass* render_pass,
+                                   uint32_t instance_count, uint32_t first_instance) {
+    return nexus_mesh_draw_lod_instanced(mesh, render_pass, 0, instance_count, first_instance);
+}
+
+/**
+ * Draw a mesh whose buffers are already bound (see nexus_mesh_bind)
+ * @return The number of triangles drawn
+ */
+uint32_t nexus_mesh_draw_bound(NexusMesh* mesh, SDL_GPURenderPass* render_pass) {
+    return nexus_mesh_draw_instanced(mesh, render_pass, 1, 0);
+}
+
+/**
+ * Draw a mesh in a render pass
+ * @return The number of triangles drawn
+ */
+uint32_t nexus_mesh_draw(NexusMesh* mesh, SDL_GPURenderPass* render_pass) {
+    /* Bind buffers and draw */
+    nexus_mesh_bind(mesh, render_pass);
+    return nexus_mesh_draw_bound(mesh, render_pass);
 }
 
 /**
@@ -323,17 +573,19 @@ NexusMesh* nexus_mesh_create_plane(SDL_GPUDevice* device, float width, float hei
     uint32_t index_count = width_segments * height_segments * 6;
 
     /* Allocate vertices */
-    NexusVertex* vertices = (NexusVertex*)malloc(vertex_count * sizeof(NexusVertex));
+    NexusScratch scratch = nexus_scratch_begin();
+    NexusVertex* vertices = (NexusVertex*)nexus_scratch_alloc(&scratch, vertex_count * sizeof(NexusVertex));
     if (vertices == NULL) {
         fprintf(stderr, "Failed to allocate memory for plane vertices!");
+        nexus_scratch_end(&scratch);
         return NULL;
     }
 
     /* Allocate indices */
-    uint32_t* indices = (uint32_t*)malloc(index_count * sizeof(uint32_t));
+    uint32_t* indices = (uint32_t*)nexus_scratch_alloc(&scratch, index_count * sizeof(uint32_t));
     if (indices == NULL) {
         fprintf(stderr, "Failed to allocate memory for plane indices!");
-        free(vertices);
+        nexus_scratch_end(&scratch);
         return NULL;
     }
 
@@ -341,8 +593,7 @@ NexusMesh* nexus_mesh_create_plane(SDL_GPUDevice* device, float width, float hei
     NexusMesh* mesh = nexus_mesh_create(device);
     if (mesh == NULL) {
         fprintf(stderr, "Failed to create plane mesh!");
-        free(vertices);
-        free(indices);
+        nexus_scratch_end(&scratch);
         return NULL;
     }
 
@@ -409,26 +660,26 @@ NexusMesh* nexus_mesh_create_plane(SDL_GPUDevice* device, float width, float hei
         }
     }
 
+    /* Reorder for the post-transform cache and vertex fetch */
+    nexus_mesh_optimize_arrays(vertices, &vertex_count, indices, index_count, false, NULL);
+
     /* Set vertices and indices */
     if (!nexus_mesh_set_vertices(mesh, vertices, vertex_count)) {
         fprintf(stderr, "Failed to set plane vertices!");
-        free(vertices);
-        free(indices);
+        nexus_scratch_end(&scratch);
         nexus_mesh_destroy(mesh);
         return NULL;
     }
 
     if (!nexus_mesh_set_indices(mesh, indices, index_count)) {
         fprintf(stderr, "Failed to set plane indices!");
-        free(vertices);
-        free(indices);
+        nexus_scratch_end(&scratch);
         nexus_mesh_destroy(mesh);
         return NULL;
     }
 
-    /* Free temporary data */
-    free(vertices);
-    free(indices);
+    /* Release temporary data */
+    nexus_scratch_end(&scratch);
 
     return mesh;
 }
@@ -451,17 +702,19 @@ NexusMesh* nexus_mesh_create_cube(SDL_GPUDevice* device, float size) {
     uint32_t index_count = 36;
 
     /* Allocate vertices */
-    NexusVertex* vertices = (NexusVertex*)malloc(vertex_count * sizeof(NexusVertex));
+    NexusScratch scratch = nexus_scratch_begin();
+    NexusVertex* vertices = (NexusVertex*)nexus_scratch_alloc(&scratch, vertex_count * sizeof(NexusVertex));
     if (vertices == NULL) {
         fprintf(stderr, "Failed to allocate memory for cube vertices!");
+        nexus_scratch_end(&scratch);
         return NULL;
     }
 
     /* Allocate indices */
-    uint32_t* indices = (uint32_t*)malloc(index_count * sizeof(uint32_t));
+    uint32_t* indices = (uint32_t*)nexus_scratch_alloc(&scratch, index_count * sizeof(uint32_t));
     if (indices == NULL) {
         fprintf(stderr, "Failed to allocate memory for cube indices!");
-        free(vertices);
+        nexus_scratch_end(&scratch);
         return NULL;
     }
 
@@ -469,8 +722,7 @@ NexusMesh* nexus_mesh_create_cube(SDL_GPUDevice* device, float size) {
     NexusMesh* mesh = nexus_mesh_create(device);
     if (mesh == NULL) {
         fprintf(stderr, "Failed to create cube mesh!");
-        free(vertices);
-        free(indices);
+        nexus_scratch_end(&scratch);
         return NULL;
     }
 
@@ -576,26 +828,26 @@ NexusMesh* nexus_mesh_create_cube(SDL_GPUDevice* device, float size) {
         indices[index_index++] = base_index + 3;
     }
 
+    /* Reorder for the post-transform cache and vertex fetch */
+    nexus_mesh_optimize_arrays(vertices, &vertex_count, indices, index_count, false, NULL);
+
     /* Set vertices and indices */
     if (!nexus_mesh_set_vertices(mesh, vertices, vertex_count)) {
         fprintf(stderr, "Failed to set cube vertices!");
-        free(vertices);
-        free(indices);
+        nexus_scratch_end(&scratch);
         nexus_mesh_destroy(mesh);
         return NULL;
     }
 
     if (!nexus_mesh_set_indices(mesh, indices, index_count)) {
         fprintf(stderr, "Failed to set cube indices!");
-        free(vertices);
-        free(indices);
+        nexus_scratch_end(&scratch);
         nexus_mesh_destroy(mesh);
         return NULL;
     }
 
-    /* Free temporary data */
-    free(vertices);
-    free(indices);
+    /* Release temporary data */
+    nexus_scratch_end(&scratch);
 
     return mesh;
 }
@@ -615,17 +867,19 @@ NexusMesh* nexus_mesh_create_sphere(SDL_GPUDevice* device, float radius, uint32_
     uint32_t index_count = rings * sectors * 6;
 
     /* Allocate vertices */
-    NexusVertex* vertices = (NexusVertex*)malloc(vertex_count * sizeof(NexusVertex));
+    NexusScratch scratch = nexus_scratch_begin();
+    NexusVertex* vertices = (NexusVertex*)nexus_scratch_alloc(&scratch, vertex_count * sizeof(NexusVertex));
     if (vertices == NULL) {
         fprintf(stderr, "Failed to allocate memory for sphere vertices!");
+        nexus_scratch_end(&scratch);
         return NULL;
     }
 
     /* Allocate indices */
-    uint32_t* indices = (uint32_t*)malloc(index_count * sizeof(uint32_t));
+    uint32_t* indices = (uint32_t*)nexus_scratch_alloc(&scratch, index_count * sizeof(uint32_t));
     if (indices == NULL) {
         fprintf(stderr, "Failed to allocate memory for sphere indices!");
-        free(vertices);
+        nexus_scratch_end(&scratch);
         return NULL;
     }
 
@@ -633,8 +887,7 @@ NexusMesh* nexus_mesh_create_sphere(SDL_GPUDevice* device, float radius, uint32_
     NexusMesh* mesh = nexus_mesh_create(device);
     if (mesh == NULL) {
         fprintf(stderr, "Failed to create sphere mesh!");
-        free(vertices);
-        free(indices);
+        nexus_scratch_end(&scratch);
         return NULL;
     }
 
@@ -700,26 +953,42 @@ NexusMesh* nexus_mesh_create_sphere(SDL_GPUDevice* device, float radius, uint32_
         }
     }
 
+    /* Reorder for the post-transform cache and vertex fetch */
+    nexus_mesh_optimize_arrays(vertices, &vertex_count, indices, index_count, false, NULL);
+
+    /* Simplified levels share the vertices, the chain replaces the indices */
+    NexusMeshLod lods[NEXUS_MESH_MAX_LODS];
+    uint32_t* chain = NULL;
+    uint32_t lod_count = nexus_mesh_build_lod_chain(vertices, vertex_count, indices, index_count,
+                                                    NEXUS_MESH_MAX_LODS, &chain, &index_count, lods);
+    if (lod_count > 0) {
+        indices = chain;
+    }
+
     /* Set vertices and indices */
     if (!nexus_mesh_set_vertices(mesh, vertices, vertex_count)) {
         fprintf(stderr, "Failed to set sphere vertices!");
-        free(vertices);
-        free(indices);
+        free(chain);
+        nexus_scratch_end(&scratch);
         nexus_mesh_destroy(mesh);
         return NULL;
     }
 
     if (!nexus_mesh_set_indices(mesh, indices, index_count)) {
         fprintf(stderr, "Failed to set sphere indices!");
-        free(vertices);
-        free(indices);
+        free(chain);
+        nexus_scratch_end(&scratch);
         nexus_mesh_destroy(mesh);
         return NULL;
     }
 
-    /* Free temporary data */
-    free(vertices);
-    free(indices);
+    if (lod_count > 1) {
+        nexus_mesh_set_lods(mesh, lods, lod_count);
+    }
+    free(chain);
+
+    /* Release temporary data */
+    nexus_scratch_end(&scratch);
 
     return mesh;
 }
@@ -739,17 +1008,19 @@ NexusMesh* nexus_mesh_create_cylinder(SDL_GPUDevice* device, float radius, float
     uint32_t index_count = segments * 3 * 2 + segments * 6;
 
     /* Allocate vertices */
-    NexusVertex* vertices = (NexusVertex*)malloc(vertex_count * sizeof(NexusVertex));
+    NexusScratch scratch = nexus_scratch_begin();
+    NexusVertex* vertices = (NexusVertex*)nexus_scratch_alloc(&scratch, vertex_count * sizeof(NexusVertex));
     if (vertices == NULL) {
         fprintf(stderr, "Failed to allocate memory for cylinder vertices!");
+        nexus_scratch_end(&scratch);
         return NULL;
     }
 
     /* Allocate indices */
-    uint32_t* indices = (uint32_t*)malloc(index_count * sizeof(uint32_t));
+    uint32_t* indices = (uint32_t*)nexus_scratch_alloc(&scratch, index_count * sizeof(uint32_t));
     if (indices == NULL) {
         fprintf(stderr, "Failed to allocate memory for cylinder indices!");
-        free(vertices);
+        nexus_scratch_end(&scratch);
         return NULL;
     }
 
@@ -757,8 +1028,7 @@ NexusMesh* nexus_mesh_create_cylinder(SDL_GPUDevice* device, float radius, float
     NexusMesh* mesh = nexus_mesh_create(device);
     if (mesh == NULL) {
         fprintf(stderr, "Failed to create cylinder mesh!");
-        free(vertices);
-        free(indices);
+        nexus_scratch_end(&scratch);
         return NULL;
     }
 
@@ -913,26 +1183,144 @@ NexusMesh* nexus_mesh_create_cylinder(SDL_GPUDevice* device, float radius, float
         indices[index_index++] = d;
     }
 
+    // Reorder for the post-transform cache and vertex fetch
+    nexus_mesh_optimize_arrays(vertices, &vertex_count, indices, index_count, false, NULL);
+
     // Set vertices and indices
     if (!nexus_mesh_set_vertices(mesh, vertices, vertex_count)) {
         fprintf(stderr, "Failed to set cylinder vertices!");
-        free(vertices);
-        free(indices);
+        nexus_scratch_end(&scratch);
         nexus_mesh_destroy(mesh);
         return NULL;
     }
 
     if (!nexus_mesh_set_indices(mesh, indices, index_count)) {
         fprintf(stderr, "Failed to set cylinder indices!");
-        free(vertices);
-        free(indices);
+        nexus_scratch_end(&scratch);
         nexus_mesh_destroy(mesh);
         return NULL;
     }
 
     // Free temporary data
-    free(vertices);
-    free(indices);
+    nexus_scratch_end(&scratch);
+
+    return mesh;
+}
+
+/**
+ * Create a mesh from CPU side mesh data
+ * Vertices in the default layout and indices are copied into the staging ring
+ * as they are, data with bounds (imported or cooked meshes) skips the
+ * per-vertex bounds pass
+ */
+NexusMesh* nexus_mesh_create_from_data(SDL_GPUDevice* device, const NexusMeshData* data) {
+    if (device == NULL || data == NULL || data->vertices == NULL || data->vertex_count == 0) {
+        return NULL;
+    }
+
+    NexusMesh* mesh = nexus_mesh_create(device);
+    if (mesh == NULL) {
+        return NULL;
+    }
+
+    nexus_mesh_set_vertex_layout(mesh, data->vertex_layout, data->position_stream);
+
+    bool success;
+    if (data->has_bounds) {
+        success = nexus_mesh_store_vertices(mesh, data->vertices, data->vertex_count);
+        memcpy(mesh->bounds_min, data->bounds_min, sizeof(float) * 3);
+        memcpy(mesh->bounds_max, data->bounds_max, sizeof(float) * 3);
+    } else {
+        success = nexus_mesh_set_vertices(mesh, data->vertices, data->vertex_count);
+    }
+
+    if (success && data->indices16 != NULL && data->index_count > 0) {
+        success = nexus_mesh_set_indices16(mesh, data->indices16, data->index_count);
+    } else if (success && data->indices != NULL && data->index_count > 0) {
+        success = nexus_mesh_set_indices(mesh, data->indices, data->index_count);
+    }
+
+    /* Detail levels and meshlets are small, the mesh keeps its own copy */
+    if (success && data->lod_count > 0) {
+        success = nexus_mesh_set_lods(mesh, data->lods, data->lod_count);
+    }
+    if (success && data->meshlet_count > 0) {
+        mesh->meshlets = (NexusMeshlet*)malloc(sizeof(NexusMeshlet) * data->meshlet_count);
+        success = mesh->meshlets != NULL;
+        if (success) {
+            memcpy(mesh->meshlets, data->meshlets, sizeof(NexusMeshlet) * data->meshlet_count);
+            mesh->meshlet_count = data->meshlet_count;
+        }
+    }
+
+    if (!success) {
+        nexus_mesh_destroy(mesh);
+        return NULL;
+    }
+
+    return mesh;
+}
+
+/**
+ * Free CPU side mesh data
+ */
+void nexus_mesh_data_free(NexusMeshData* data) {
+    if (data == NULL) {
+        return;
+    }
+
+    /* Cooked meshes point into their file */
+    if (data->file.data != NULL) {
+        nexus_mapped_file_close(&data->file);
+    } else {
+        free(data->vertices);
+        free(data->indices);
+        free(data->indices16);
+        free(data->lods);
+        free(data->meshlets);
+    }
+    memset(data, 0, sizeof(NexusMeshData));
+}
+
+/**
+ * Load a mesh from a Wavefront OBJ file
+ */
+NexusMesh* nexus_mesh_load_obj(SDL_GPUDevice* device, const char* filename) {
+    if (device == NULL || filename == NULL) {
+        return NULL;
+    }
+
+    NexusMeshData data;
+    if (!nexus_mesh_data_load_obj(filename, &data)) {
+        return NULL;
+    }
+
+    NexusMesh* mesh = nexus_mesh_create_from_data(device, &data);
+    nexus_mesh_data_free(&data);
+    if (mesh == NULL) {
+        return NULL;
+    }
+
+    printf("Loaded mesh from file '%s' (%u vertices, %u triangles)\n", filename, mesh->vertex_count,
+           mesh->index_count / 3);
+
+    return mesh;
+}
+
+/**
+ * Load a mesh from a cooked mesh file
+ */
+NexusMesh* nexus_mesh_load_cooked(SDL_GPUDevice* device, const char* filename) {
+    if (device == NULL || filename == NULL) {
+        return NULL;
+    }
+
+    NexusMeshData data;
+    if (!nexus_mesh_data_load_cooked(filename, &data)) {
+        return NULL;
+    }
 
+    NexusMesh* mesh = nexus_mesh_create_from_data(device, &data);
+    nexus_mesh_data_free(&data);
     return mesh;
 }
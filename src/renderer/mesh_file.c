@@ -0,0 +1,997 @@
+/**
+ * Nexus3D Mesh File Implementation
+ * Streaming OBJ import with vertex deduplication and optimization, meshlet
+ * building and the cooked mesh reader/writer
+ */
+
+#include "nexus3d/renderer/mesh_file.h"
+#include "nexus3d/renderer/mesh_optimize.h"
+#include "nexus3d/renderer/mesh_simplify.h"
+#include <ctype.h>
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Initial capacity of the importer arrays */
+#define NEXUS_OBJ_INITIAL_CAPACITY 1024
+
+/**
+ * Deduplication table entry, one per unique position/texcoord/normal triple
+ */
+typedef struct {
+    int32_t position;              /* Position index (-1 = empty slot) */
+    int32_t texcoord;              /* Texcoord index (-1 = none) */
+    int32_t normal;                /* Normal index (-1 = none) */
+    uint32_t vertex;               /* Vertex the triple maps to */
+} NexusObjVertexKey;
+
+/**
+ * Importer state
+ */
+typedef struct {
+    const char* filename;          /* File being imported (for errors) */
+
+    /* Attribute streams */
+    float* positions;
+    float* texcoords;
+    float* normals;
+    uint32_t position_count, position_capacity;
+    uint32_t texcoord_count, texcoord_capacity;
+    uint32_t normal_count, normal_capacity;
+
+    /* Output */
+    NexusMeshData* data;
+    uint32_t vertex_capacity;
+    uint32_t index_capacity;
+    uint8_t* smooth;               /* Vertex has no normal in the file and gets the face normals */
+    uint32_t smooth_capacity;
+
+    /* Deduplication table (open addressing, power of two) */
+    NexusObjVertexKey* keys;
+    uint32_t key_capacity;
+
+    /* Artist detail levels, objects or groups named <name>_LOD<level> */
+    uint32_t lod_starts[NEXUS_MESH_MAX_LODS]; /* First index of each level */
+    uint32_t lod_count;            /* Levels started so far */
+    bool lod_ignored;              /* Groups were out of order, import as one level */
+} NexusObjImporter;
+
+/**
+ * Grow an array to hold at least count elements
+ */
+static bool nexus_obj_reserve(void** array, uint32_t* capacity, uint32_t count, size_t element_size) {
+    if (count <= *capacity) {
+        return true;
+    }
+
+    uint32_t new_capacity = *capacity ? *capacity : NEXUS_OBJ_INITIAL_CAPACITY;
+    while (new_capacity < count) {
+        new_capacity *= 2;
+    }
+
+    void* grown = realloc(*array, new_capacity * element_size);
+    if (grown == NULL) {
+        return false;
+    }
+
+    *array = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+/**
+ * Skip blanks within a line
+ */
+static const char* nexus_obj_skip_blanks(const char* cursor, const char* end) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) {
+        cursor++;
+    }
+    return cursor;
+}
+
+/**
+ * Parse a decimal integer, returns false if there is none
+ * The mapping isn't terminated, so parsing is bounded by end
+ */
+static bool nexus_obj_parse_int(const char** cursor, const char* end, long* value) {
+    const char* c = *cursor;
+    bool negative = false;
+    if (c < end && (*c == '-' || *c == '+')) {
+        negative = *c == '-';
+        c++;
+    }
+
+    if (c >= end || *c < '0' || *c > '9') {
+        return false;
+    }
+
+    /* Longer digit runs clamp, they are out of range for every use anyway */
+    long result = 0;
+    while (c < end && *c >= '0' && *c <= '9') {
+        long digit = *c - '0';
+        result = result > (LONG_MAX - digit) / 10 ? LONG_MAX : result * 10 + digit;
+        c++;
+    }
+
+    *value = negative ? -result : result;
+    *cursor = c;
+    return true;
+}
+
+/**
+ * Parse a decimal float with optional exponent, missing numbers read as 0
+ */
+static float nexus_obj_parse_float(const char** cursor, const char* end) {
+    const char* c = nexus_obj_skip_blanks(*cursor, end);
+    bool negative = false;
+    if (c < end && (*c == '-' || *c == '+')) {
+        negative = *c == '-';
+        c++;
+    }
+
+    double value = 0.0;
+    while (c < end && *c >= '0' && *c <= '9') {
+        value = value * 10.0 + (*c - '0');
+        c++;
+    }
+
+    if (c < end && *c == '.') {
+        c++;
+        double scale = 0.1;
+        while (c < end && *c >= '0' && *c <= '9') {
+            value += (*c - '0') * scale;
+            scale *= 0.1;
+            c++;
+        }
+    }
+
+    if (c < end && (*c == 'e' || *c == 'E')) {
+        const char* exponent_start = c + 1;
+        long exponent;
+        if (nexus_obj_parse_int(&exponent_start, end, &exponent)) {
+            value *= pow(10.0, (double)exponent);
+            c = exponent_start;
+        }
+    }
+
+    *cursor = c;
+    return (float)(negative ? -value : value);
+}
+
+/**
+ * Resolve a 1-based (or negative, relative) OBJ index, returns -1 if out of range
+ */
+static int32_t nexus_obj_resolve(long index, uint32_t count) {
+    if (index > 0 && (uint32_t)index <= count) {
+        return (int32_t)(index - 1);
+    }
+    if (index < 0 && (uint32_t)(-index) <= count) {
+        return (int32_t)(count + index);
+    }
+    return -1;
+}
+
+/**
+ * Hash of an attribute triple
+ */
+static uint32_t nexus_obj_hash(int32_t position, int32_t texcoord, int32_t normal) {
+    uint32_t hash = (uint32_t)position * 73856093u;
+    hash ^= (uint32_t)texcoord * 19349663u;
+    hash ^= (uint32_t)normal * 83492791u;
+    return hash ^ (hash >> 16);
+}
+
+/**
+ * Double the deduplication table and reinsert its keys
+ */
+static bool nexus_obj_grow_keys(NexusObjImporter* importer) {
+    uint32_t capacity = importer->key_capacity ? importer->key_capacity * 2 : NEXUS_OBJ_INITIAL_CAPACITY * 2;
+    NexusObjVertexKey* keys = (NexusObjVertexKey*)malloc(sizeof(NexusObjVertexKey) * capacity);
+    if (keys == NULL) {
+        return false;
+    }
+    for (uint32_t i = 0; i < capacity; i++) {
+        keys[i].position = -1;
+    }
+
+    for (uint32_t i = 0; i < importer->key_capacity; i++) {
+        const NexusObjVertexKey* key = &importer->keys[i];
+        if (key->position < 0) {
+            continue;
+        }
+        uint32_t slot = nexus_obj_hash(key->position, key->texcoord, key->normal) & (capacity - 1);
+        while (keys[slot].position >= 0) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        keys[slot] = *key;
+    }
+
+    free(importer->keys);
+    importer->keys = keys;
+    importer->key_capacity = capacity;
+    return true;
+}
+
+/**
+ * Get the vertex of an attribute triple, emitting it the first time it is seen
+ * Returns UINT32_MAX when out of memory
+ */
+static uint32_t nexus_obj_vertex(NexusObjImporter* importer, int32_t position, int32_t texcoord, int32_t normal) {
+    NexusMeshData* data = importer->data;
+
+    /* Keep the table at most half full */
+    if ((data->vertex_count + 1) * 2 > importer->key_capacity && !nexus_obj_grow_keys(importer)) {
+        return UINT32_MAX;
+    }
+
+    uint32_t mask = importer->key_capacity - 1;
+    uint32_t slot = nexus_obj_hash(position, texcoord, normal) & mask;
+    while (importer->keys[slot].position >= 0) {
+        const NexusObjVertexKey* key = &importer->keys[slot];
+        if (key->position == position && key->texcoord == texcoord && key->normal == normal) {
+            return key->vertex;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    /* New vertex */
+    if (!nexus_obj_reserve((void**)&data->vertices, &importer->vertex_capacity, data->vertex_count + 1,
+                           sizeof(NexusVertex)) ||
+        !nexus_obj_reserve((void**)&importer->smooth, &importer->smooth_capacity, data->vertex_count + 1,
+                           sizeof(uint8_t))) {
+        return UINT32_MAX;
+    }
+
+    uint32_t index = data->vertex_count++;
+    NexusVertex* vertex = &data->vertices[index];
+    memset(vertex, 0, sizeof(NexusVertex));
+    memcpy(vertex->position, &importer->positions[position * 3], sizeof(float) * 3);
+    if (texcoord >= 0) {
+        memcpy(vertex->texcoord, &importer->texcoords[texcoord * 2], sizeof(float) * 2);
+    }
+    if (normal >= 0) {
+        memcpy(vertex->normal, &importer->normals[normal * 3], sizeof(float) * 3);
+    }
+    for (int k = 0; k < 4; k++) {
+        vertex->color[k] = 1.0f;
+    }
+    importer->smooth[index] = normal < 0;
+
+    /* Grow the bounds */
+    for (int k = 0; k < 3; k++) {
+        if (vertex->position[k] < data->bounds_min[k]) data->bounds_min[k] = vertex->position[k];
+        if (vertex->position[k] > data->bounds_max[k]) data->bounds_max[k] = vertex->position[k];
+    }
+
+    importer->keys[slot].position = position;
+    importer->keys[slot].texcoord = texcoord;
+    importer->keys[slot].normal = normal;
+    importer->keys[slot].vertex = index;
+    return index;
+}
+
+/**
+ * Emit a triangle, vertices without a file normal accumulate its area weighted normal
+ */
+static bool nexus_obj_triangle(NexusObjImporter* importer, uint32_t a, uint32_t b, uint32_t c) {
+    NexusMeshData* data = importer->data;
+    if (!nexus_obj_reserve((void**)&data->indices, &importer->index_capacity, data->index_count + 3,
+                           sizeof(uint32_t))) {
+        return false;
+    }
+
+    data->indices[data->index_count++] = a;
+    data->indices[data->index_count++] = b;
+    data->indices[data->index_count++] = c;
+
+    if (importer->smooth[a] || importer->smooth[b] || importer->smooth[c]) {
+        const float* pa = data->vertices[a].position;
+        const float* pb = data->vertices[b].position;
+        const float* pc = data->vertices[c].position;
+        float e1[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] };
+        float e2[3] = { pc[0] - pa[0], pc[1] - pa[1], pc[2] - pa[2] };
+        float normal[3] = {
+            e1[1] * e2[2] - e1[2] * e2[1],
+            e1[2] * e2[0] - e1[0] * e2[2],
+            e1[0] * e2[1] - e1[1] * e2[0]
+        };
+
+        uint32_t corners[3] = { a, b, c };
+        for (int i = 0; i < 3; i++) {
+            if (importer->smooth[corners[i]]) {
+                float* vn = data->vertices[corners[i]].normal;
+                for (int k = 0; k < 3; k++) {
+                    vn[k] += normal[k];
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Parse a face, polygons are fanned out from their first corner
+ */
+static bool nexus_obj_face(NexusObjImporter* importer, const char* cursor, const char* end) {
+    uint32_t first = 0, previous = 0;
+    uint32_t corner_count = 0;
+
+    for (;;) {
+        cursor = nexus_obj_skip_blanks(cursor, end);
+
+        long p_index, t_index = 0, n_index = 0;
+        if (!nexus_obj_parse_int(&cursor, end, &p_index)) {
+            break;
+        }
+        if (cursor < end && *cursor == '/') {
+            cursor++;
+            nexus_obj_parse_int(&cursor, end, &t_index);
+            if (cursor < end && *cursor == '/') {
+                cursor++;
+                nexus_obj_parse_int(&cursor, end, &n_index);
+            }
+        }
+
+        int32_t p = nexus_obj_resolve(p_index, importer->position_count);
+        if (p < 0) {
+            fprintf(stderr, "Invalid face index in mesh '%s'!\n", importer->filename);
+            return false;
+        }
+        int32_t t = t_index != 0 ? nexus_obj_resolve(t_index, importer->texcoord_count) : -1;
+        int32_t n = n_index != 0 ? nexus_obj_resolve(n_index, importer->normal_count) : -1;
+
+        uint32_t vertex = nexus_obj_vertex(importer, p, t, n);
+        if (vertex == UINT32_MAX) {
+            return false;
+        }
+
+        if (corner_count == 0) {
+            first = vertex;
+        } else if (corner_count >= 2 && !nexus_obj_triangle(importer, first, previous, vertex)) {
+            return false;
+        }
+        previous = vertex;
+        corner_count++;
+    }
+
+    return true;
+}
+
+/**
+ * Handle an object or group name, a _LOD<level> suffix starts a detail level
+ * Levels must follow each other in order, faces before the first named
+ * level belong to level 0
+ */
+static void nexus_obj_group(NexusObjImporter* importer, const char* cursor, const char* end) {
+    cursor = nexus_obj_skip_blanks(cursor, end);
+    while (end > cursor && isspace((unsigned char)end[-1])) {
+        end--;
+    }
+
+    /* Trailing digits after _LOD */
+    const char* digits = end;
+    while (digits > cursor && isdigit((unsigned char)digits[-1])) {
+        digits--;
+    }
+    if (digits == end || digits - cursor < 4 || digits[-4] != '_' ||
+        toupper((unsigned char)digits[-3]) != 'L' || toupper((unsigned char)digits[-2]) != 'O' ||
+        toupper((unsigned char)digits[-1]) != 'D') {
+        return;
+    }
+    long level = 0;
+    if (!nexus_obj_parse_int(&digits, end, &level) || importer->lod_ignored) {
+        return;
+    }
+
+    /* More groups of the current level */
+    if (importer->lod_count > 0 && level == (long)importer->lod_count - 1) {
+        return;
+    }
+
+    /* Ungrouped faces followed by _LOD1 are level 0 */
+    if (importer->lod_count == 0 && level == 1) {
+        importer->lod_starts[importer->lod_count++] = 0;
+    }
+
+    if (level != (long)importer->lod_count || level >= NEXUS_MESH_MAX_LODS) {
+        fprintf(stderr, "Mesh '%s' has out of order LOD groups, importing them as one level!\n",
+                importer->filename);
+        importer->lod_ignored = true;
+        return;
+    }
+    importer->lod_starts[importer->lod_count++] = level == 0 ? 0 : importer->data->index_count;
+}
+
+/**
+ * Turn the levels found by nexus_obj_group into the LOD table
+ * Artist levels carry no error, they get NEXUS_MESH_LOD_ARTIST_ERROR doubling per level
+ */
+static bool nexus_obj_finish_lods(NexusObjImporter* importer) {
+    NexusMeshData* data = importer->data;
+    if (importer->lod_ignored || importer->lod_count < 2) {
+        return true;
+    }
+
+    for (uint32_t l = 0; l < importer->lod_count; l++) {
+        uint32_t next = l + 1 < importer->lod_count ? importer->lod_starts[l + 1] : data->index_count;
+        if (next <= importer->lod_starts[l]) {
+            fprintf(stderr, "Mesh '%s' has an empty LOD %u, importing it as one level!\n",
+                    importer->filename, l);
+            return true;
+        }
+    }
+
+    data->lods = (NexusMeshLod*)malloc(sizeof(NexusMeshLod) * importer->lod_count);
+    if (data->lods == NULL) {
+        return false;
+    }
+    memset(data->lods, 0, sizeof(NexusMeshLod) * importer->lod_count);
+
+    float error = NEXUS_MESH_LOD_ARTIST_ERROR;
+    for (uint32_t l = 0; l < importer->lod_count; l++) {
+        uint32_t next = l + 1 < importer->lod_count ? importer->lod_starts[l + 1] : data->index_count;
+        data->lods[l].index_offset = importer->lod_starts[l];
+        data->lods[l].index_count = next - importer->lod_starts[l];
+        if (l > 0) {
+            data->lods[l].error = error;
+            error *= 2.0f;
+        }
+    }
+    data->lod_count = importer->lod_count;
+    return true;
+}
+
+/**
+ * Append a vector attribute
+ */
+static bool nexus_obj_attribute(float** stream, uint32_t* count, uint32_t* capacity, int components,
+                                const char* cursor, const char* end) {
+    if (!nexus_obj_reserve((void**)stream, capacity, *count + 1, sizeof(float) * components)) {
+        return false;
+    }
+
+    float* value = &(*stream)[(*count)++ * components];
+    for (int k = 0; k < components; k++) {
+        value[k] = nexus_obj_parse_float(&cursor, end);
+    }
+    return true;
+}
+
+/**
+ * Import a Wavefront OBJ file in one pass over its mapping
+ * Identical position/texcoord/normal triples share a vertex, polygons are
+ * triangulated as fans and vertices without file normals get smooth
+ * normals from their faces
+ */
+static bool nexus_obj_import(const char* filename, NexusMeshData* data) {
+    if (filename == NULL || data == NULL) {
+        return false;
+    }
+    memset(data, 0, sizeof(NexusMeshData));
+
+    NexusMappedFile file;
+    if (!nexus_mapped_file_open(&file, filename)) {
+        fprintf(stderr, "Failed to load mesh '%s'!\n", filename);
+        return false;
+    }
+
+    NexusObjImporter importer;
+    memset(&importer, 0, sizeof(NexusObjImporter));
+    importer.filename = filename;
+    importer.data = data;
+    for (int k = 0; k < 3; k++) {
+        data->bounds_min[k] = FLT_MAX;
+        data->bounds_max[k] = -FLT_MAX;
+    }
+
+    const char* cursor = (const char*)file.data;
+    const char* end = cursor + file.size;
+    bool success = true;
+
+    while (success && cursor < end) {
+        const char* line_end = (const char*)memchr(cursor, '\n', (size_t)(end - cursor));
+        if (line_end == NULL) {
+            line_end = end;
+        }
+
+        const char* c = nexus_obj_skip_blanks(cursor, line_end);
+        if (line_end - c >= 2 && c[0] == 'v' && (c[1] == ' ' || c[1] == '\t')) {
+            success = nexus_obj_attribute(&importer.positions, &importer.position_count, &importer.position_capacity,
+                                          3, c + 2, line_end);
+        } else if (line_end - c >= 2 && c[0] == 'v' && c[1] == 't') {
+            success = nexus_obj_attribute(&importer.texcoords, &importer.texcoord_count, &importer.texcoord_capacity,
+                                          2, c + 2, line_end);
+            if (success) {
+                /* OBJ has the origin at the bottom */
+                float* t = &importer.texcoords[(importer.texcoord_count - 1) * 2];
+                t[1] = 1.0f - t[1];
+            }
+        } else if (line_end - c >= 2 && c[0] == 'v' && c[1] == 'n') {
+            success = nexus_obj_attribute(&importer.normals, &importer.normal_count, &importer.normal_capacity,
+                                          3, c + 2, line_end);
+        } else if (line_end - c >= 2 && c[0] == 'f' && (c[1] == ' ' || c[1] == '\t')) {
+            success = nexus_obj_face(&importer, c + 2, line_end);
+        } else if (line_end - c >= 2 && (c[0] == 'o' || c[0] == 'g') && (c[1] == ' ' || c[1] == '\t')) {
+            nexus_obj_group(&importer, c + 2, line_end);
+        }
+
+        cursor = line_end + 1;
+    }
+
+    if (success) {
+        success = nexus_obj_finish_lods(&importer);
+    }
+
+    /* Normalize the accumulated face normals */
+    if (success) {
+        for (uint32_t i = 0; i < data->vertex_count; i++) {
+            if (!importer.smooth[i]) {
+                continue;
+            }
+            float* n = data->vertices[i].normal;
+            float length = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (length > 0.0f) {
+                for (int k = 0; k < 3; k++) {
+                    n[k] /= length;
+                }
+            }
+        }
+    }
+
+    free(importer.positions);
+    free(importer.texcoords);
+    free(importer.normals);
+    free(importer.smooth);
+    free(importer.keys);
+    nexus_mapped_file_close(&file);
+
+    if (!success || data->index_count == 0) {
+        if (success) {
+            fprintf(stderr, "Mesh '%s' has no faces!\n", filename);
+        } else {
+            fprintf(stderr, "Failed to import mesh '%s'!\n", filename);
+        }
+        nexus_mesh_data_free(data);
+        return false;
+    }
+
+    data->has_bounds = true;
+    return true;
+}
+
+/**
+ * Import a Wavefront OBJ file and optimize it for rendering
+ * Triangles are ordered for the vertex cache and against overdraw, vertices
+ * for fetch locality. Only touches CPU memory, so it can run on any thread
+ */
+bool nexus_mesh_data_load_obj(const char* filename, NexusMeshData* data) {
+    if (!nexus_obj_import(filename, data)) {
+        return false;
+    }
+
+    /* Keeping the artist's order only costs speed */
+    nexus_mesh_data_optimize(data, true, NULL);
+    return true;
+}
+
+/**
+ * Bounding sphere of a meshlet around its AABB center
+ */
+static void nexus_mesh_meshlet_bounds(const NexusMeshData* data, NexusMeshlet* meshlet) {
+    float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    const uint32_t* indices = &data->indices[meshlet->index_offset];
+
+    for (uint32_t i = 0; i < meshlet->index_count; i++) {
+        const float* p = data->vertices[indices[i]].position;
+        for (int k = 0; k < 3; k++) {
+            if (p[k] < min[k]) min[k] = p[k];
+            if (p[k] > max[k]) max[k] = p[k];
+        }
+    }
+
+    float radius_sq = 0.0f;
+    for (int k = 0; k < 3; k++) {
+        meshlet->center[k] = (min[k] + max[k]) * 0.5f;
+    }
+    for (uint32_t i = 0; i < meshlet->index_count; i++) {
+        const float* p = data->vertices[indices[i]].position;
+        float d[3] = { p[0] - meshlet->center[0], p[1] - meshlet->center[1], p[2] - meshlet->center[2] };
+        float distance_sq = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+        if (distance_sq > radius_sq) radius_sq = distance_sq;
+    }
+    meshlet->radius = sqrtf(radius_sq);
+}
+
+/**
+ * Split an index range into meshlets of consecutive triangles
+ * A meshlet closes once the next triangle would exceed the vertex or
+ * triangle limit, returns the number of meshlets written
+ */
+static uint32_t nexus_mesh_build_meshlets(const NexusMeshData* data, uint32_t index_offset, uint32_t index_count,
+                                          uint32_t* seen, NexusMeshlet* meshlets) {
+    uint32_t meshlet_count = 0;
+    uint32_t vertex_count = 0;
+    NexusMeshlet* current = NULL;
+
+    for (uint32_t i = index_offset; i + 2 < index_offset + index_count; i += 3) {
+        const uint32_t* triangle = &data->indices[i];
+
+        /* Vertices the triangle adds to the current meshlet */
+        uint32_t added = 0;
+        if (current != NULL) {
+            for (int k = 0; k < 3; k++) {
+                if (seen[triangle[k]] != meshlet_count) {
+                    added++;
+                }
+            }
+        }
+
+        if (current == NULL || vertex_count + added > NEXUS_MESHLET_MAX_VERTICES ||
+            current->index_count / 3 >= NEXUS_MESHLET_MAX_TRIANGLES) {
+            if (current != NULL) {
+                nexus_mesh_meshlet_bounds(data, current);
+            }
+            current = &meshlets[meshlet_count++];
+            current->index_offset = i;
+            current->index_count = 0;
+            vertex_count = 0;
+        }
+
+        for (int k = 0; k < 3; k++) {
+            if (seen[triangle[k]] != meshlet_count) {
+                seen[triangle[k]] = meshlet_count;
+                vertex_count++;
+            }
+        }
+        current->index_count += 3;
+    }
+
+    if (current != NULL) {
+        nexus_mesh_meshlet_bounds(data, current);
+    }
+    return meshlet_count;
+}
+
+/**
+ * Round an offset up to the section alignment
+ */
+static uint32_t nexus_mesh_file_align(uint32_t offset) {
+    return (offset + NEXUS_MESH_FILE_ALIGNMENT - 1) & ~(NEXUS_MESH_FILE_ALIGNMENT - 1);
+}
+
+/**
+ * Write mesh data as a cooked mesh file
+ * Meshes without a LOD table get a single full detail level, meshlets are
+ * built for every level that has none. Indices are stored in 16 bits when
+ * they all fit
+ */
+bool nexus_mesh_data_save_cooked(const NexusMeshData* source, const char* filename) {
+    if (source == NULL || filename == NULL || source->vertices == NULL ||
+        (source->indices == NULL && source->indices16 == NULL) ||
+        source->vertex_count == 0 || source->index_count == 0) {
+        return false;
+    }
+
+    /* Meshlets are built from 32-bit indices, widen 16-bit ones (re-cooking a cooked mesh) */
+    NexusMeshData wide = *source;
+    const NexusMeshData* data = &wide;
+    if (source->indices == NULL) {
+        wide.indices = (uint32_t*)malloc(sizeof(uint32_t) * source->index_count);
+        if (wide.indices == NULL) {
+            return false;
+        }
+        for (uint32_t i = 0; i < source->index_count; i++) {
+            wide.indices[i] = source->indices16[i];
+        }
+    }
+
+    /* Narrow the indices if they all fit in 16 bits */
+    uint32_t max_index = 0;
+    for (uint32_t i = 0; i < data->index_count; i++) {
+        if (data->indices[i] > max_index) {
+            max_index = data->indices[i];
+        }
+    }
+    uint32_t index_size = max_index < NEXUS_MESH_MAX_16BIT_VERTICES ? sizeof(uint16_t) : sizeof(uint32_t);
+    const void* indices = data->indices;
+    uint16_t* narrow = NULL;
+    if (index_size == sizeof(uint16_t)) {
+        narrow = (uint16_t*)malloc(sizeof(uint16_t) * data->index_count);
+        if (narrow != NULL) {
+            for (uint32_t i = 0; i < data->index_count; i++) {
+                narrow[i] = (uint16_t)data->indices[i];
+            }
+            indices = narrow;
+        } else {
+            index_size = sizeof(uint32_t);
+        }
+    }
+
+    /* Detail levels */
+    NexusMeshLod full = { 0, data->index_count, 0, data->meshlet_count, 0.0f, 0 };
+    const NexusMeshLod* source_lods = data->lod_count > 0 ? data->lods : &full;
+    uint32_t lod_count = data->lod_count > 0 ? data->lod_count : 1;
+
+    NexusMeshLod* lods = (NexusMeshLod*)malloc(sizeof(NexusMeshLod) * lod_count);
+    uint32_t* seen = (uint32_t*)malloc(sizeof(uint32_t) * data->vertex_count);
+    NexusMeshlet* meshlets = NULL;
+    uint32_t meshlet_count = 0;
+    bool success = lods != NULL && seen != NULL;
+
+    /* Meshlets, reusing the data's own where it has them */
+    if (success && data->meshlet_count > 0) {
+        memcpy(lods, source_lods, sizeof(NexusMeshLod) * lod_count);
+        meshlets = data->meshlets;
+        meshlet_count = data->meshlet_count;
+    } else if (success) {
+        /* Every meshlet holds at least a triangle, so the triangle counts bound them */
+        uint32_t max_meshlets = 0;
+        for (uint32_t l = 0; l < lod_count; l++) {
+            max_meshlets += source_lods[l].index_count / 3 + 1;
+        }
+        meshlets = (NexusMeshlet*)malloc(sizeof(NexusMeshlet) * max_meshlets);
+        success = meshlets != NULL;
+        for (uint32_t l = 0; success && l < lod_count; l++) {
+            lods[l] = source_lods[l];
+            if (lods[l].index_offset + lods[l].index_count > data->index_count) {
+                fprintf(stderr, "LOD %u exceeds the index buffer of mesh '%s'!\n", l, filename);
+                success = false;
+                break;
+            }
+            for (uint32_t v = 0; v < data->vertex_count; v++) {
+                seen[v] = 0;
+            }
+            lods[l].meshlet_offset = meshlet_count;
+            lods[l].meshlet_count = nexus_mesh_build_meshlets(data, lods[l].index_offset, lods[l].index_count,
+                                                              seen, &meshlets[meshlet_count]);
+            meshlet_count += lods[l].meshlet_count;
+        }
+    }
+
+    /* Header */
+    NexusMeshFileHeader header;
+    memset(&header, 0, sizeof(NexusMeshFileHeader));
+    header.magic = NEXUS_MESH_FILE_MAGIC;
+    header.version = NEXUS_MESH_FILE_VERSION;
+    header.vertex_stride = sizeof(NexusVertex);
+    header.index_size = index_size;
+    header.vertex_count = data->vertex_count;
+    header.index_count = data->index_count;
+    header.lod_count = lod_count;
+    header.meshlet_count = meshlet_count;
+
+    if (data->has_bounds) {
+        memcpy(header.bounds_min, data->bounds_min, sizeof(float) * 3);
+        memcpy(header.bounds_max, data->bounds_max, sizeof(float) * 3);
+    } else {
+        memcpy(header.bounds_min, data->vertices[0].position, sizeof(float) * 3);
+        memcpy(header.bounds_max, data->vertices[0].position, sizeof(float) * 3);
+        for (uint32_t i = 1; i < data->vertex_count; i++) {
+            for (int k = 0; k < 3; k++) {
+                float value = data->vertices[i].position[k];
+                if (value < header.bounds_min[k]) header.bounds_min[k] = value;
+                if (value > header.bounds_max[k]) header.bounds_max[k] = value;
+            }
+        }
+    }
+
+    /* Section layout */
+    const void* sections[4] = { data->vertices, indices, lods, meshlets };
+    uint32_t sizes[4] = {
+        data->vertex_count * (uint32_t)sizeof(NexusVertex),
+        data->index_count * index_size,
+        lod_count * (uint32_t)sizeof(NexusMeshLod),
+        meshlet_count * (uint32_t)sizeof(NexusMeshlet)
+    };
+    uint32_t offsets[4];
+    uint32_t offset = nexus_mesh_file_align(sizeof(NexusMeshFileHeader));
+    for (int s = 0; s < 4; s++) {
+        offsets[s] = offset;
+        offset = nexus_mesh_file_align(offset + sizes[s]);
+    }
+    header.vertex_offset = offsets[0];
+    header.index_offset = offsets[1];
+    header.lod_offset = offsets[2];
+    header.meshlet_offset = offsets[3];
+
+    /* Write to a temporary file and move it into place */
+    char temp_path[512];
+    if (success && snprintf(temp_path, sizeof(temp_path), "%s.tmp", filename) >= (int)sizeof(temp_path)) {
+        success = false;
+    }
+
+    FILE* file = success ? fopen(temp_path, "wb") : NULL;
+    if (success && file == NULL) {
+        fprintf(stderr, "Failed to open '%s' for writing!\n", temp_path);
+        success = false;
+    }
+
+    if (file != NULL) {
+        static const uint8_t s_padding[NEXUS_MESH_FILE_ALIGNMENT] = { 0 };
+        uint32_t written = sizeof(NexusMeshFileHeader);
+        success = fwrite(&header, 1, sizeof(NexusMeshFileHeader), file) == sizeof(NexusMeshFileHeader);
+        for (int s = 0; success && s < 4; s++) {
+            success = fwrite(s_padding, 1, offsets[s] - written, file) == offsets[s] - written &&
+                      (sizes[s] == 0 || fwrite(sections[s], 1, sizes[s], file) == sizes[s]);
+            written = offsets[s] + sizes[s];
+        }
+        success = fclose(file) == 0 && success;
+
+        /* rename does not replace existing files everywhere */
+        if (success && rename(temp_path, filename) != 0) {
+            remove(filename);
+            success = rename(temp_path, filename) == 0;
+        }
+        if (!success) {
+            fprintf(stderr, "Failed to write cooked mesh '%s'!\n", filename);
+            remove(temp_path);
+        }
+    }
+
+    if (meshlets != data->meshlets) {
+        free(meshlets);
+    }
+    if (wide.indices != source->indices) {
+        free(wide.indices);
+    }
+    free(narrow);
+    free(lods);
+    free(seen);
+    return success;
+}
+
+/**
+ * Check that a file section lies within the file and is aligned
+ */
+static bool nexus_mesh_file_section(const NexusMappedFile* file, uint32_t offset, uint32_t count, uint32_t stride) {
+    uint64_t size = (uint64_t)count * stride;
+    return (offset % NEXUS_MESH_FILE_ALIGNMENT) == 0 && (uint64_t)offset + size <= file->size;
+}
+
+/**
+ * Check the ranges inside the sections of a cooked mesh
+ * LODs and meshlets have to lie within the index and meshlet tables and every
+ * index within the vertices, so draws never read past the uploaded buffers
+ */
+static bool nexus_mesh_file_ranges(const NexusMeshFileHeader* header, const uint8_t* base) {
+    const NexusMeshLod* lods = (const NexusMeshLod*)(base + header->lod_offset);
+    for (uint32_t i = 0; i < header->lod_count; i++) {
+        if ((uint64_t)lods[i].index_offset + lods[i].index_count > header->index_count ||
+            (uint64_t)lods[i].meshlet_offset + lods[i].meshlet_count > header->meshlet_count) {
+            return false;
+        }
+    }
+
+    const NexusMeshlet* meshlets = (const NexusMeshlet*)(base + header->meshlet_offset);
+    for (uint32_t i = 0; i < header->meshlet_count; i++) {
+        if ((uint64_t)meshlets[i].index_offset + meshlets[i].index_count > header->index_count) {
+            return false;
+        }
+    }
+
+    if (header->index_size == sizeof(uint16_t)) {
+        const uint16_t* indices = (const uint16_t*)(base + header->index_offset);
+        for (uint32_t i = 0; i < header->index_count; i++) {
+            if (indices[i] >= header->vertex_count) {
+                return false;
+            }
+        }
+    } else {
+        const uint32_t* indices = (const uint32_t*)(base + header->index_offset);
+        for (uint32_t i = 0; i < header->index_count; i++) {
+            if (indices[i] >= header->vertex_count) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Load a cooked mesh file
+ * The data arrays point straight into the mapping, so uploading them is a
+ * plain copy into the staging ring. Only touches CPU memory, so it can run
+ * on any thread
+ */
+bool nexus_mesh_data_load_cooked(const char* filename, NexusMeshData* data) {
+    if (filename == NULL || data == NULL) {
+        return false;
+    }
+    memset(data, 0, sizeof(NexusMeshData));
+
+    if (!nexus_mapped_file_open(&data->file, filename)) {
+        fprintf(stderr, "Failed to load cooked mesh '%s'!\n", filename);
+        return false;
+    }
+
+    NexusMeshFileHeader header;
+    bool valid = data->file.size >= sizeof(NexusMeshFileHeader);
+    if (valid) {
+        memcpy(&header, data->file.data, sizeof(NexusMeshFileHeader));
+        valid = header.magic == NEXUS_MESH_FILE_MAGIC && header.version == NEXUS_MESH_FILE_VERSION &&
+                header.vertex_stride == sizeof(NexusVertex) &&
+                (header.index_size == sizeof(uint16_t) || header.index_size == sizeof(uint32_t)) &&
+                header.vertex_count > 0 && header.index_count > 0 &&
+                nexus_mesh_file_section(&data->file, header.vertex_offset, header.vertex_count, header.vertex_stride) &&
+                nexus_mesh_file_section(&data->file, header.index_offset, header.index_count, header.index_size) &&
+                nexus_mesh_file_section(&data->file, header.lod_offset, header.lod_count, sizeof(NexusMeshLod)) &&
+                nexus_mesh_file_section(&data->file, header.meshlet_offset, header.meshlet_count,
+                                        sizeof(NexusMeshlet)) &&
+                nexus_mesh_file_ranges(&header, (const uint8_t*)data->file.data);
+    }
+
+    if (!valid) {
+        fprintf(stderr, "Invalid or outdated cooked mesh '%s'!\n", filename);
+        nexus_mesh_data_free(data);
+        return false;
+    }
+
+    const uint8_t* base = (const uint8_t*)data->file.data;
+    data->vertices = (NexusVertex*)(base + header.vertex_offset);
+    data->vertex_count = header.vertex_count;
+    if (header.index_size == sizeof(uint16_t)) {
+        data->indices16 = (uint16_t*)(base + header.index_offset);
+    } else {
+        data->indices = (uint32_t*)(base + header.index_offset);
+    }
+    data->index_count = header.index_count;
+    data->lods = header.lod_count > 0 ? (NexusMeshLod*)(base + header.lod_offset) : NULL;
+    data->lod_count = header.lod_count;
+    data->meshlets = header.meshlet_count > 0 ? (NexusMeshlet*)(base + header.meshlet_offset) : NULL;
+    data->meshlet_count = header.meshlet_count;
+    memcpy(data->bounds_min, header.bounds_min, sizeof(float) * 3);
+    memcpy(data->bounds_max, header.bounds_max, sizeof(float) * 3);
+    data->has_bounds = true;
+
+    return true;
+}
+
+/**
+ * Load mesh data, cooked meshes by their extension and OBJ files otherwise
+ */
+bool nexus_mesh_data_load_file(const char* filename, NexusMeshData* data) {
+    if (filename == NULL || data == NULL) {
+        return false;
+    }
+
+    size_t length = strlen(filename);
+    size_t extension_length = strlen(NEXUS_MESH_FILE_EXTENSION);
+    if (length >= extension_length && strcmp(filename + length - extension_length, NEXUS_MESH_FILE_EXTENSION) == 0) {
+        return nexus_mesh_data_load_cooked(filename, data);
+    }
+
+    return nexus_mesh_data_load_obj(filename, data);
+}
+
+/**
+ * Import an OBJ file, optimize it and write it as a cooked mesh, reporting the ACMR gain
+ * Meshes without artist LODs get a simplified LOD chain
+ */
+bool nexus_mesh_cook_obj(const char* obj_filename, const char* cooked_filename) {
+    NexusMeshData data;
+    if (!nexus_obj_import(obj_filename, &data)) {
+        return false;
+    }
+
+    nexus_mesh_data_generate_lods(&data, NEXUS_MESH_MAX_LODS);
+
+    NexusMeshOptimizeStats stats;
+    nexus_mesh_data_optimize(&data, true, &stats);
+
+    bool success = nexus_mesh_data_save_cooked(&data, cooked_filename);
+    if (success) {
+        uint32_t triangle_count = data.lod_count > 0 ? data.lods[0].index_count / 3 : data.index_count / 3;
+        printf("Cooked mesh '%s' (%u vertices, %u triangles, %u LODs, ACMR %.3f -> %.3f)\n", cooked_filename,
+               data.vertex_count, triangle_count, data.lod_count > 0 ? data.lod_count : 1,
+               stats.acmr_before, stats.acmr_after);
+    }
+
+    nexus_mesh_data_free(&data);
+    return success;
+}
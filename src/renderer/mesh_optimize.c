@@ -0,0 +1,509 @@
+/**
+ * Nexus3D Mesh Optimization Implementation
+ * Tipsify triangle ordering (Sander et al. 2007), overdraw cluster sorting
+ * and first use vertex ordering
+ */
+
+#include "nexus3d/renderer/mesh_optimize.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* No vertex */
+#define NEXUS_MESH_OPTIMIZE_NONE UINT32_MAX
+
+/**
+ * Overdraw sort entry
+ */
+typedef struct {
+    float key;                         /* Outward facing distance from the mesh center */
+    uint32_t cluster;                  /* Cluster index (keeps the sort stable) */
+} NexusMeshClusterKey;
+
+/**
+ * Check that every index refers to a vertex
+ */
+static bool nexus_mesh_optimize_check(const uint32_t* indices, uint32_t index_count, uint32_t vertex_count) {
+    for (uint32_t i = 0; i < index_count; i++) {
+        if (indices[i] >= vertex_count) {
+            fprintf(stderr, "Cannot optimize mesh: index %u out of range!\n", indices[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Run a triangle through a FIFO cache, returns the number of misses
+ * A vertex is cached while fewer than cache_size vertices were added after it
+ */
+static uint32_t nexus_mesh_cache_triangle(const uint32_t* triangle, uint32_t* cache_time, uint32_t* time,
+                                          uint32_t cache_size) {
+    uint32_t misses = 0;
+    for (int k = 0; k < 3; k++) {
+        uint32_t v = triangle[k];
+        if (*time - cache_time[v] > cache_size) {
+            cache_time[v] = (*time)++;
+            misses++;
+        }
+    }
+    return misses;
+}
+
+/**
+ * Average cache miss ratio of a triangle list for a FIFO cache
+ * @return Vertices transformed per triangle, 0 for invalid input
+ */
+float nexus_mesh_compute_acmr(const uint32_t* indices, uint32_t index_count, uint32_t vertex_count,
+                              uint32_t cache_size) {
+    uint32_t triangle_count = index_count / 3;
+    if (indices == NULL || triangle_count == 0 || vertex_count == 0 || cache_size == 0 ||
+        !nexus_mesh_optimize_check(indices, triangle_count * 3, vertex_count)) {
+        return 0.0f;
+    }
+
+    uint32_t* cache_time = (uint32_t*)calloc(vertex_count, sizeof(uint32_t));
+    if (cache_time == NULL) {
+        return 0.0f;
+    }
+
+    uint32_t time = cache_size + 1;
+    uint32_t misses = 0;
+    for (uint32_t t = 0; t < triangle_count; t++) {
+        misses += nexus_mesh_cache_triangle(&indices[t * 3], cache_time, &time, cache_size);
+    }
+
+    free(cache_time);
+    return (float)misses / (float)triangle_count;
+}
+
+/**
+ * Reorder triangles for the post-transform vertex cache (Tipsify)
+ * Fans around the most recently used vertex that stays cached while its
+ * remaining triangles are emitted, and restarts from the dead end stack
+ * when no candidate qualifies. Each restart begins a cluster, whose first
+ * triangle is written to cluster_starts (optional, one entry per triangle)
+ * @return The number of clusters, 0 if the indices were left as they are
+ */
+uint32_t nexus_mesh_optimize_vertex_cache(uint32_t* indices, uint32_t index_count, uint32_t vertex_count,
+                                          uint32_t* cluster_starts) {
+    uint32_t triangle_count = index_count / 3;
+    if (indices == NULL || triangle_count == 0 || vertex_count == 0 ||
+        !nexus_mesh_optimize_check(indices, triangle_count * 3, vertex_count)) {
+        return 0;
+    }
+    index_count = triangle_count * 3;
+
+    /* Working memory */
+    uint32_t* live = (uint32_t*)calloc(vertex_count, sizeof(uint32_t));
+    uint32_t* offsets = (uint32_t*)malloc(sizeof(uint32_t) * (vertex_count + 1));
+    uint32_t* cache_time = (uint32_t*)calloc(vertex_count, sizeof(uint32_t));
+    uint32_t* adjacency = (uint32_t*)malloc(sizeof(uint32_t) * index_count);
+    uint32_t* dead_end = (uint32_t*)malloc(sizeof(uint32_t) * index_count);
+    uint32_t* output = (uint32_t*)malloc(sizeof(uint32_t) * index_count);
+    uint8_t* emitted = (uint8_t*)calloc(triangle_count, sizeof(uint8_t));
+    if (live == NULL || offsets == NULL || cache_time == NULL || adjacency == NULL ||
+        dead_end == NULL || output == NULL || emitted == NULL) {
+        fprintf(stderr, "Failed to allocate memory for vertex cache optimization!\n");
+        free(live); free(offsets); free(cache_time); free(adjacency); free(dead_end); free(output); free(emitted);
+        return 0;
+    }
+
+    /* Vertex to triangle adjacency, live counts the triangles not emitted yet */
+    for (uint32_t i = 0; i < index_count; i++) {
+        live[indices[i]]++;
+    }
+    offsets[0] = 0;
+    for (uint32_t v = 0; v < vertex_count; v++) {
+        offsets[v + 1] = offsets[v] + live[v];
+        cache_time[v] = offsets[v];
+    }
+    for (uint32_t i = 0; i < index_count; i++) {
+        adjacency[cache_time[indices[i]]++] = i / 3;
+    }
+    memset(cache_time, 0, sizeof(uint32_t) * vertex_count);
+
+    const uint32_t cache_size = NEXUS_MESH_OPTIMIZE_CACHE_SIZE;
+    uint32_t time = cache_size + 1;
+    uint32_t dead_top = 0;
+    uint32_t cursor = 0;
+    uint32_t written = 0;
+    uint32_t cluster_count = 0;
+    uint32_t fan = NEXUS_MESH_OPTIMIZE_NONE;
+
+    for (;;) {
+        if (fan == NEXUS_MESH_OPTIMIZE_NONE) {
+            /* Dead end: most recent vertex with triangles left, then input order */
+            while (dead_top > 0 && fan == NEXUS_MESH_OPTIMIZE_NONE) {
+                uint32_t v = dead_end[--dead_top];
+                if (live[v] > 0) {
+                    fan = v;
+                }
+            }
+            while (cursor < vertex_count && fan == NEXUS_MESH_OPTIMIZE_NONE) {
+                if (live[cursor] > 0) {
+                    fan = cursor;
+                } else {
+                    cursor++;
+                }
+            }
+            if (fan == NEXUS_MESH_OPTIMIZE_NONE) {
+                break;
+            }
+            if (cluster_starts != NULL) {
+                cluster_starts[cluster_count] = written / 3;
+            }
+            cluster_count++;
+        }
+
+        /* Emit every remaining triangle around the fanning vertex */
+        uint32_t candidates = dead_top;
+        for (uint32_t a = offsets[fan]; a < offsets[fan + 1]; a++) {
+            uint32_t t = adjacency[a];
+            if (emitted[t]) {
+                continue;
+            }
+            emitted[t] = 1;
+
+            for (int k = 0; k < 3; k++) {
+                uint32_t v = indices[t * 3 + k];
+                output[written++] = v;
+                dead_end[dead_top++] = v;
+                live[v]--;
+                if (time - cache_time[v] > cache_size) {
+                    cache_time[v] = time++;
+                }
+            }
+        }
+
+        /* Next fan: the oldest candidate that is still cached after its remaining triangles */
+        uint32_t next = NEXUS_MESH_OPTIMIZE_NONE;
+        int64_t best = -1;
+        for (uint32_t i = candidates; i < dead_top; i++) {
+            uint32_t v = dead_end[i];
+            if (live[v] == 0) {
+                continue;
+            }
+            int64_t age = (int64_t)(time - cache_time[v]);
+            int64_t priority = age + 2 * (int64_t)live[v] <= (int64_t)cache_size ? age : 0;
+            if (priority > best) {
+                best = priority;
+                next = v;
+            }
+        }
+        fan = next;
+    }
+
+    memcpy(indices, output, sizeof(uint32_t) * index_count);
+
+    free(live);
+    free(offsets);
+    free(cache_time);
+    free(adjacency);
+    free(dead_end);
+    free(output);
+    free(emitted);
+    return cluster_count;
+}
+
+/**
+ * Order clusters by overdraw sort key
+ */
+static int nexus_mesh_compare_clusters(const void* a, const void* b) {
+    const NexusMeshClusterKey* ka = (const NexusMeshClusterKey*)a;
+    const NexusMeshClusterKey* kb = (const NexusMeshClusterKey*)b;
+    if (ka->key != kb->key) {
+        return ka->key > kb->key ? -1 : 1;
+    }
+    return ka->cluster < kb->cluster ? -1 : (ka->cluster > kb->cluster ? 1 : 0);
+}
+
+/**
+ * Reorder the clusters of a cache optimized triangle list against overdraw
+ * Clusters are split further where their running ACMR is back within
+ * threshold of the whole cluster's, then sorted so that the ones facing
+ * away from the mesh center, which tend to occlude the rest, draw first
+ * @return The number of clusters after splitting, 0 if the indices were left as they are
+ */
+uint32_t nexus_mesh_optimize_overdraw(const NexusVertex* vertices, uint32_t* indices, uint32_t index_count,
+                                      uint32_t vertex_count, const uint32_t* cluster_starts, uint32_t cluster_count,
+                                      float threshold) {
+    uint32_t triangle_count = index_count / 3;
+    if (vertices == NULL || indices == NULL || cluster_starts == NULL || triangle_count == 0 ||
+        cluster_count == 0 || !nexus_mesh_optimize_check(indices, triangle_count * 3, vertex_count)) {
+        return 0;
+    }
+    index_count = triangle_count * 3;
+
+    uint32_t* cache_time = (uint32_t*)calloc(vertex_count, sizeof(uint32_t));
+    uint32_t* starts = (uint32_t*)malloc(sizeof(uint32_t) * (triangle_count + 1));
+    uint32_t* output = (uint32_t*)malloc(sizeof(uint32_t) * index_count);
+    NexusMeshClusterKey* keys = (NexusMeshClusterKey*)malloc(sizeof(NexusMeshClusterKey) * triangle_count);
+    if (cache_time == NULL || starts == NULL || output == NULL || keys == NULL) {
+        fprintf(stderr, "Failed to allocate memory for overdraw optimization!\n");
+        free(cache_time); free(starts); free(output); free(keys);
+        return 0;
+    }
+
+    /* Split clusters, each one starts with a cold cache (bumping the time expires every entry) */
+    const uint32_t cache_size = NEXUS_MESH_OPTIMIZE_CACHE_SIZE;
+    uint32_t time = cache_size + 1;
+    uint32_t split_count = 0;
+    for (uint32_t c = 0; c < cluster_count; c++) {
+        uint32_t first = cluster_starts[c];
+        uint32_t end = c + 1 < cluster_count ? cluster_starts[c + 1] : triangle_count;
+        if (first >= end || end > triangle_count) {
+            continue;
+        }
+
+        time += cache_size + 1;
+        uint32_t misses = 0;
+        for (uint32_t t = first; t < end; t++) {
+            misses += nexus_mesh_cache_triangle(&indices[t * 3], cache_time, &time, cache_size);
+        }
+        float target = (float)misses / (float)(end - first) * threshold;
+
+        starts[split_count++] = first;
+        time += cache_size + 1;
+        misses = 0;
+        uint32_t sub_first = first;
+        for (uint32_t t = first; t < end; t++) {
+            misses += nexus_mesh_cache_triangle(&indices[t * 3], cache_time, &time, cache_size);
+            if (t + 1 < end && (float)misses / (float)(t + 1 - sub_first) <= target) {
+                starts[split_count++] = t + 1;
+                sub_first = t + 1;
+                time += cache_size + 1;
+                misses = 0;
+            }
+        }
+    }
+    starts[split_count] = triangle_count;
+
+    /* Area weighted mesh center */
+    double center[3] = { 0.0, 0.0, 0.0 };
+    double total_area = 0.0;
+    for (uint32_t t = 0; t < triangle_count; t++) {
+        const float* p0 = vertices[indices[t * 3 + 0]].position;
+        const float* p1 = vertices[indices[t * 3 + 1]].position;
+        const float* p2 = vertices[indices[t * 3 + 2]].position;
+        float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+        float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+        float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+        double area = sqrt((double)n[0] * n[0] + (double)n[1] * n[1] + (double)n[2] * n[2]);
+        for (int k = 0; k < 3; k++) {
+            center[k] += area * (p0[k] + p1[k] + p2[k]) / 3.0;
+        }
+        total_area += area;
+    }
+    if (total_area > 0.0) {
+        for (int k = 0; k < 3; k++) {
+            center[k] /= total_area;
+        }
+    }
+
+    /* Sort key per cluster: how far its centroid lies out along its average normal */
+    for (uint32_t c = 0; c < split_count; c++) {
+        double centroid[3] = { 0.0, 0.0, 0.0 };
+        double normal[3] = { 0.0, 0.0, 0.0 };
+        double area_sum = 0.0;
+        for (uint32_t t = starts[c]; t < starts[c + 1]; t++) {
+            const float* p0 = vertices[indices[t * 3 + 0]].position;
+            const float* p1 = vertices[indices[t * 3 + 1]].position;
+            const float* p2 = vertices[indices[t * 3 + 2]].position;
+            float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+            float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+            float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+            double area = sqrt((double)n[0] * n[0] + (double)n[1] * n[1] + (double)n[2] * n[2]);
+            for (int k = 0; k < 3; k++) {
+                centroid[k] += area * (p0[k] + p1[k] + p2[k]) / 3.0;
+                normal[k] += n[k];
+            }
+            area_sum += area;
+        }
+
+        double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        double key = 0.0;
+        if (area_sum > 0.0 && length > 0.0) {
+            for (int k = 0; k < 3; k++) {
+                key += (centroid[k] / area_sum - center[k]) * normal[k] / length;
+            }
+        }
+        keys[c].key = (float)key;
+        keys[c].cluster = c;
+    }
+    qsort(keys, split_count, sizeof(NexusMeshClusterKey), nexus_mesh_compare_clusters);
+
+    /* Emit the clusters in sorted order */
+    uint32_t written = 0;
+    for (uint32_t i = 0; i < split_count; i++) {
+        uint32_t c = keys[i].cluster;
+        uint32_t count = (starts[c + 1] - starts[c]) * 3;
+        memcpy(&output[written], &indices[starts[c] * 3], sizeof(uint32_t) * count);
+        written += count;
+    }
+    memcpy(indices, output, sizeof(uint32_t) * index_count);
+
+    free(cache_time);
+    free(starts);
+    free(output);
+    free(keys);
+    return split_count;
+}
+
+/**
+ * Reorder vertices in the order the indices first use them
+ * Consecutive triangles then fetch neighbouring memory, vertices no index
+ * refers to are dropped
+ * @return The new vertex count
+ */
+uint32_t nexus_mesh_optimize_vertex_fetch(NexusVertex* vertices, uint32_t vertex_count, uint32_t* indices,
+                                          uint32_t index_count) {
+    if (vertices == NULL || indices == NULL || vertex_count == 0 ||
+        !nexus_mesh_optimize_check(indices, index_count, vertex_count)) {
+        return vertex_count;
+    }
+
+    uint32_t* remap = (uint32_t*)malloc(sizeof(uint32_t) * vertex_count);
+    NexusVertex* source = (NexusVertex*)malloc(sizeof(NexusVertex) * vertex_count);
+    if (remap == NULL || source == NULL) {
+        fprintf(stderr, "Failed to allocate memory for vertex fetch optimization!\n");
+        free(remap);
+        free(source);
+        return vertex_count;
+    }
+
+    memset(remap, 0xFF, sizeof(uint32_t) * vertex_count);
+    memcpy(source, vertices, sizeof(NexusVertex) * vertex_count);
+
+    uint32_t next = 0;
+    for (uint32_t i = 0; i < index_count; i++) {
+        uint32_t v = indices[i];
+        if (remap[v] == NEXUS_MESH_OPTIMIZE_NONE) {
+            remap[v] = next;
+            vertices[next++] = source[v];
+        }
+        indices[i] = remap[v];
+    }
+
+    free(remap);
+    free(source);
+    return next;
+}
+
+/**
+ * Cache and overdraw optimize one triangle range
+ */
+static bool nexus_mesh_optimize_range(const NexusVertex* vertices, uint32_t vertex_count, uint32_t* indices,
+                                      uint32_t index_count, bool overdraw, uint32_t* clusters) {
+    if (index_count < 3) {
+        return true;
+    }
+
+    uint32_t* cluster_starts = NULL;
+    if (overdraw) {
+        cluster_starts = (uint32_t*)malloc(sizeof(uint32_t) * (index_count / 3));
+        if (cluster_starts == NULL) {
+            return false;
+        }
+    }
+
+    /* The overdraw pass is optional, the cache order stands if it fails */
+    uint32_t cluster_count = nexus_mesh_optimize_vertex_cache(indices, index_count, vertex_count, cluster_starts);
+    if (cluster_count > 0 && overdraw) {
+        *clusters += nexus_mesh_optimize_overdraw(vertices, indices, index_count, vertex_count, cluster_starts,
+                                                  cluster_count, NEXUS_MESH_OPTIMIZE_OVERDRAW_THRESHOLD);
+    }
+
+    free(cluster_starts);
+    return cluster_count > 0;
+}
+
+/**
+ * Optimize a triangle list and its vertices in place
+ * vertex_count is updated when unreferenced vertices were dropped
+ */
+bool nexus_mesh_optimize_arrays(NexusVertex* vertices, uint32_t* vertex_count, uint32_t* indices,
+                                uint32_t index_count, bool overdraw, NexusMeshOptimizeStats* stats) {
+    if (vertices == NULL || vertex_count == NULL || indices == NULL) {
+        return false;
+    }
+
+    NexusMeshOptimizeStats result;
+    memset(&result, 0, sizeof(NexusMeshOptimizeStats));
+    result.acmr_before = nexus_mesh_compute_acmr(indices, index_count, *vertex_count, NEXUS_MESH_OPTIMIZE_CACHE_SIZE);
+
+    bool success = nexus_mesh_optimize_range(vertices, *vertex_count, indices, index_count, overdraw,
+                                             &result.clusters);
+    if (success) {
+        uint32_t used = nexus_mesh_optimize_vertex_fetch(vertices, *vertex_count, indices, index_count);
+        result.vertices_removed = *vertex_count - used;
+        *vertex_count = used;
+    }
+
+    result.acmr_after = nexus_mesh_compute_acmr(indices, index_count, *vertex_count, NEXUS_MESH_OPTIMIZE_CACHE_SIZE);
+    if (stats != NULL) {
+        *stats = result;
+    }
+    return success;
+}
+
+/**
+ * Optimize CPU side mesh data in place
+ * Every detail level is ordered on its own, ACMR is reported for the first.
+ * Meshlets are dropped since they index the old order (cooking rebuilds them)
+ */
+bool nexus_mesh_data_optimize(NexusMeshData* data, bool overdraw, NexusMeshOptimizeStats* stats) {
+    if (data == NULL || data->vertices == NULL || data->indices == NULL || data->index_count == 0) {
+        return false;
+    }
+
+    /* Cooked data points into a read only mapping */
+    if (data->file.data != NULL) {
+        fprintf(stderr, "Cannot optimize mesh data mapped from a cooked file!\n");
+        return false;
+    }
+
+    NexusMeshLod full = { 0, data->index_count, 0, 0, 0.0f, 0 };
+    const NexusMeshLod* lods = data->lod_count > 0 ? data->lods : &full;
+    uint32_t lod_count = data->lod_count > 0 ? data->lod_count : 1;
+    for (uint32_t l = 0; l < lod_count; l++) {
+        if (lods[l].index_offset + lods[l].index_count > data->index_count) {
+            fprintf(stderr, "Cannot optimize mesh: LOD %u exceeds the index buffer!\n", l);
+            return false;
+        }
+    }
+
+    NexusMeshOptimizeStats result;
+    memset(&result, 0, sizeof(NexusMeshOptimizeStats));
+    result.acmr_before = nexus_mesh_compute_acmr(&data->indices[lods[0].index_offset], lods[0].index_count,
+                                                 data->vertex_count, NEXUS_MESH_OPTIMIZE_CACHE_SIZE);
+
+    bool success = true;
+    for (uint32_t l = 0; success && l < lod_count; l++) {
+        success = nexus_mesh_optimize_range(data->vertices, data->vertex_count, &data->indices[lods[l].index_offset],
+                                            lods[l].index_count, overdraw, &result.clusters);
+    }
+
+    if (success) {
+        uint32_t used = nexus_mesh_optimize_vertex_fetch(data->vertices, data->vertex_count, data->indices,
+                                                         data->index_count);
+        result.vertices_removed = data->vertex_count - used;
+        data->vertex_count = used;
+
+        free(data->meshlets);
+        data->meshlets = NULL;
+        data->meshlet_count = 0;
+        for (uint32_t l = 0; l < data->lod_count; l++) {
+            data->lods[l].meshlet_offset = 0;
+            data->lods[l].meshlet_count = 0;
+        }
+    }
+
+    result.acmr_after = nexus_mesh_compute_acmr(&data->indices[lods[0].index_offset], lods[0].index_count,
+                                                data->vertex_count, NEXUS_MESH_OPTIMIZE_CACHE_SIZE);
+    if (stats != NULL) {
+        *stats = result;
+    }
+    return success;
+}
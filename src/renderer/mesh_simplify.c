@@ -0,0 +1,495 @@
+/**
+ * Nexus3D Mesh Simplification Implementation
+ * Garland-Heckbert quadrics with half edge collapses onto existing vertices,
+ * so every level of a LOD chain indexes the same vertex buffer
+ */
+
+#include "nexus3d/renderer/mesh_simplify.h"
+#include "nexus3d/renderer/mesh_optimize.h"
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Empty slot of the edge table */
+#define NEXUS_SIMPLIFY_EMPTY_EDGE UINT64_MAX
+
+/**
+ * Symmetric 4x4 error quadric, area weighted sum of squared plane distances
+ */
+typedef struct {
+    double a2, ab, ac, ad;
+    double b2, bc, bd;
+    double c2, cd;
+    double d2;
+    double weight;                     /* Total plane weight (area) */
+} NexusQuadric;
+
+/**
+ * Edge collapse candidate, moves from onto to
+ */
+typedef struct {
+    uint32_t from;                     /* Vertex that goes away */
+    uint32_t to;                       /* Vertex it is merged into */
+    float cost;                        /* Quadric error of the merged vertex */
+} NexusCollapse;
+
+/**
+ * Add a weighted plane (unit normal a, b, c and offset d) to a quadric
+ */
+static void nexus_quadric_add_plane(NexusQuadric* q, double a, double b, double c, double d, double w) {
+    q->a2 += w * a * a; q->ab += w * a * b; q->ac += w * a * c; q->ad += w * a * d;
+    q->b2 += w * b * b; q->bc += w * b * c; q->bd += w * b * d;
+    q->c2 += w * c * c; q->cd += w * c * d;
+    q->d2 += w * d * d;
+    q->weight += w;
+}
+
+/**
+ * Accumulate one quadric into another
+ */
+static void nexus_quadric_add(NexusQuadric* q, const NexusQuadric* other) {
+    q->a2 += other->a2; q->ab += other->ab; q->ac += other->ac; q->ad += other->ad;
+    q->b2 += other->b2; q->bc += other->bc; q->bd += other->bd;
+    q->c2 += other->c2; q->cd += other->cd;
+    q->d2 += other->d2;
+    q->weight += other->weight;
+}
+
+/**
+ * Mean squared distance of a point to the planes of a quadric
+ */
+static double nexus_quadric_error(const NexusQuadric* q, const float* p) {
+    double x = p[0], y = p[1], z = p[2];
+    double error = q->a2 * x * x + q->b2 * y * y + q->c2 * z * z +
+                   2.0 * (q->ab * x * y + q->ac * x * z + q->bc * y * z) +
+                   2.0 * (q->ad * x + q->bd * y + q->cd * z) + q->d2;
+    return q->weight > 0.0 ? fabs(error) / q->weight : 0.0;
+}
+
+/**
+ * Unnormalized triangle normal
+ */
+static void nexus_simplify_normal(const float* p0, const float* p1, const float* p2, double* n) {
+    double e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+    double e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+    n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+    n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+    n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+/**
+ * Order collapse candidates by cost
+ */
+static int nexus_simplify_compare(const void* a, const void* b) {
+    float ca = ((const NexusCollapse*)a)->cost;
+    float cb = ((const NexusCollapse*)b)->cost;
+    return ca < cb ? -1 : (ca > cb ? 1 : 0);
+}
+
+/**
+ * Hash a directed edge into the edge table
+ */
+static uint32_t nexus_simplify_edge_slot(uint64_t edge, uint32_t mask) {
+    return (uint32_t)((edge * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+/**
+ * Lock the vertices of open edges (borders and UV or normal seams, where
+ * the index topology splits) so outlines and seams keep their shape
+ */
+static bool nexus_simplify_lock_borders(const uint32_t* indices, uint32_t index_count, uint8_t* locked) {
+    uint32_t capacity = 16;
+    while (capacity < index_count * 2) {
+        capacity *= 2;
+    }
+    uint32_t mask = capacity - 1;
+
+    uint64_t* edges = (uint64_t*)malloc(sizeof(uint64_t) * capacity);
+    if (edges == NULL) {
+        return false;
+    }
+    memset(edges, 0xFF, sizeof(uint64_t) * capacity);
+
+    for (uint32_t i = 0; i < index_count; i++) {
+        uint32_t a = indices[i];
+        uint32_t b = indices[i % 3 == 2 ? i - 2 : i + 1];
+        if (a == b) {
+            continue;
+        }
+        uint64_t edge = ((uint64_t)a << 32) | b;
+        uint32_t slot = nexus_simplify_edge_slot(edge, mask);
+        while (edges[slot] != NEXUS_SIMPLIFY_EMPTY_EDGE && edges[slot] != edge) {
+            slot = (slot + 1) & mask;
+        }
+        edges[slot] = edge;
+    }
+
+    for (uint32_t i = 0; i < index_count; i++) {
+        uint32_t a = indices[i];
+        uint32_t b = indices[i % 3 == 2 ? i - 2 : i + 1];
+        if (a == b) {
+            continue;
+        }
+
+        /* An edge without its opposite has a single triangle */
+        uint64_t opposite = ((uint64_t)b << 32) | a;
+        uint32_t slot = nexus_simplify_edge_slot(opposite, mask);
+        while (edges[slot] != NEXUS_SIMPLIFY_EMPTY_EDGE && edges[slot] != opposite) {
+            slot = (slot + 1) & mask;
+        }
+        if (edges[slot] == NEXUS_SIMPLIFY_EMPTY_EDGE) {
+            locked[a] = 1;
+            locked[b] = 1;
+        }
+    }
+
+    free(edges);
+    return true;
+}
+
+/**
+ * Check that collapsing from onto to flips none of the triangles that survive
+ */
+static bool nexus_simplify_keeps_orientation(const NexusVertex* vertices, const uint32_t* indices,
+                                             const uint32_t* adjacency, uint32_t first, uint32_t end,
+                                             uint32_t from, uint32_t to) {
+    for (uint32_t a = first; a < end; a++) {
+        const uint32_t* triangle = &indices[adjacency[a] * 3];
+        if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+            continue;
+        }
+
+        const float* p[3];
+        const float* q[3];
+        for (int k = 0; k < 3; k++) {
+            p[k] = vertices[triangle[k]].position;
+            q[k] = triangle[k] == from ? vertices[to].position : p[k];
+        }
+
+        double before[3], after[3];
+        nexus_simplify_normal(p[0], p[1], p[2], before);
+        nexus_simplify_normal(q[0], q[1], q[2], after);
+
+        /* Degenerate triangles have no orientation to lose */
+        double before_sq = before[0] * before[0] + before[1] * before[1] + before[2] * before[2];
+        if (before_sq <= 0.0) {
+            continue;
+        }
+        if (before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Simplify a triangle list by collapsing edges onto existing vertices
+ * Collapses run in passes of independent edges, cheapest first, until the
+ * target index count is reached or the next collapse would exceed
+ * target_error (relative to the mesh radius). out_indices needs room for
+ * index_count indices and may alias indices
+ * @return The index count of the simplified list
+ */
+uint32_t nexus_mesh_simplify(const NexusVertex* vertices, uint32_t vertex_count, const uint32_t* indices,
+                             uint32_t index_count, uint32_t target_index_count, float target_error,
+                             uint32_t* out_indices, float* out_error) {
+    if (out_error != NULL) {
+        *out_error = 0.0f;
+    }
+    if (vertices == NULL || indices == NULL || out_indices == NULL || vertex_count == 0 || index_count < 3) {
+        return 0;
+    }
+
+    uint32_t count = index_count / 3 * 3;
+    for (uint32_t i = 0; i < count; i++) {
+        if (indices[i] >= vertex_count) {
+            fprintf(stderr, "Cannot simplify mesh: index %u out of range!\n", indices[i]);
+            return 0;
+        }
+    }
+    if (out_indices != indices) {
+        memmove(out_indices, indices, sizeof(uint32_t) * count);
+    }
+
+    /* Mesh radius, errors are relative to it */
+    float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (uint32_t i = 0; i < count; i++) {
+        const float* p = vertices[out_indices[i]].position;
+        for (int k = 0; k < 3; k++) {
+            if (p[k] < min[k]) min[k] = p[k];
+            if (p[k] > max[k]) max[k] = p[k];
+        }
+    }
+    double extent[3] = { max[0] - min[0], max[1] - min[1], max[2] - min[2] };
+    double radius = 0.5 * sqrt(extent[0] * extent[0] + extent[1] * extent[1] + extent[2] * extent[2]);
+    if (radius <= 0.0 || count <= target_index_count) {
+        return count;
+    }
+    double error_limit = (double)target_error * radius;
+    error_limit *= error_limit;
+
+    /* Working memory */
+    NexusQuadric* quadrics = (NexusQuadric*)calloc(vertex_count, sizeof(NexusQuadric));
+    uint8_t* locked = (uint8_t*)calloc(vertex_count, sizeof(uint8_t));
+    uint8_t* touched = (uint8_t*)malloc(vertex_count);
+    uint32_t* remap = (uint32_t*)malloc(sizeof(uint32_t) * vertex_count);
+    uint32_t* offsets = (uint32_t*)malloc(sizeof(uint32_t) * (vertex_count + 1));
+    uint32_t* adjacency = (uint32_t*)malloc(sizeof(uint32_t) * count);
+    NexusCollapse* collapses = (NexusCollapse*)malloc(sizeof(NexusCollapse) * count * 2);
+    bool success = quadrics != NULL && locked != NULL && touched != NULL && remap != NULL &&
+                   offsets != NULL && adjacency != NULL && collapses != NULL &&
+                   nexus_simplify_lock_borders(out_indices, count, locked);
+    if (!success) {
+        fprintf(stderr, "Failed to allocate memory for mesh simplification!\n");
+    }
+
+    /* Vertex quadrics from the planes of their triangles */
+    for (uint32_t t = 0; success && t < count; t += 3) {
+        const float* p0 = vertices[out_indices[t + 0]].position;
+        const float* p1 = vertices[out_indices[t + 1]].position;
+        const float* p2 = vertices[out_indices[t + 2]].position;
+        double n[3];
+        nexus_simplify_normal(p0, p1, p2, n);
+        double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length <= 0.0) {
+            continue;
+        }
+        n[0] /= length; n[1] /= length; n[2] /= length;
+        double d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+        for (int k = 0; k < 3; k++) {
+            nexus_quadric_add_plane(&quadrics[out_indices[t + k]], n[0], n[1], n[2], d, length * 0.5);
+        }
+    }
+
+    double max_error = 0.0;
+    while (success && count > target_index_count) {
+        /* Vertex to triangle adjacency of the current list */
+        memset(offsets, 0, sizeof(uint32_t) * (vertex_count + 1));
+        for (uint32_t i = 0; i < count; i++) {
+            offsets[out_indices[i] + 1]++;
+        }
+        for (uint32_t v = 0; v < vertex_count; v++) {
+            offsets[v + 1] += offsets[v];
+            remap[v] = offsets[v];
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            adjacency[remap[out_indices[i]]++] = i / 3;
+        }
+
+        /* Candidates in both directions of every edge */
+        uint32_t candidate_count = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t a = out_indices[i];
+            uint32_t b = out_indices[i % 3 == 2 ? i - 2 : i + 1];
+            if (a == b) {
+                continue;
+            }
+            for (int direction = 0; direction < 2; direction++) {
+                uint32_t from = direction == 0 ? a : b;
+                uint32_t to = direction == 0 ? b : a;
+                if (locked[from]) {
+                    continue;
+                }
+                NexusQuadric merged = quadrics[from];
+                nexus_quadric_add(&merged, &quadrics[to]);
+                NexusCollapse* collapse = &collapses[candidate_count++];
+                collapse->from = from;
+                collapse->to = to;
+                collapse->cost = (float)nexus_quadric_error(&merged, vertices[to].position);
+            }
+        }
+        qsort(collapses, candidate_count, sizeof(NexusCollapse), nexus_simplify_compare);
+
+        /* Apply independent collapses, cheapest first */
+        for (uint32_t v = 0; v < vertex_count; v++) {
+            remap[v] = v;
+        }
+        memset(touched, 0, vertex_count);
+        uint32_t goal = (count - target_index_count) / 3;
+        uint32_t removed = 0;
+        uint32_t applied = 0;
+        for (uint32_t c = 0; c < candidate_count && removed < goal; c++) {
+            const NexusCollapse* collapse = &collapses[c];
+            if (collapse->cost > error_limit) {
+                break;
+            }
+            if (touched[collapse->from] || touched[collapse->to] ||
+                !nexus_simplify_keeps_orientation(vertices, out_indices, adjacency, offsets[collapse->from],
+                                                  offsets[collapse->from + 1], collapse->from, collapse->to)) {
+                continue;
+            }
+
+            remap[collapse->from] = collapse->to;
+            nexus_quadric_add(&quadrics[collapse->to], &quadrics[collapse->from]);
+            if (collapse->cost > max_error) {
+                max_error = collapse->cost;
+            }
+            applied++;
+
+            /* Neighbouring triangles change shape, their vertices wait for the next pass */
+            for (uint32_t a = offsets[collapse->from]; a < offsets[collapse->from + 1]; a++) {
+                const uint32_t* triangle = &out_indices[adjacency[a] * 3];
+                for (int k = 0; k < 3; k++) {
+                    touched[triangle[k]] = 1;
+                }
+                if (triangle[0] == collapse->to || triangle[1] == collapse->to || triangle[2] == collapse->to) {
+                    removed++;
+                }
+            }
+        }
+
+        if (applied == 0) {
+            break;
+        }
+
+        /* Rewrite the list, dropping the triangles that collapsed */
+        uint32_t written = 0;
+        for (uint32_t t = 0; t < count; t += 3) {
+            uint32_t a = remap[out_indices[t + 0]];
+            uint32_t b = remap[out_indices[t + 1]];
+            uint32_t c = remap[out_indices[t + 2]];
+            if (a == b || b == c || a == c) {
+                continue;
+            }
+            out_indices[written++] = a;
+            out_indices[written++] = b;
+            out_indices[written++] = c;
+        }
+        count = written;
+    }
+
+    free(quadrics);
+    free(locked);
+    free(touched);
+    free(remap);
+    free(offsets);
+    free(adjacency);
+    free(collapses);
+
+    if (out_error != NULL) {
+        *out_error = (float)(sqrt(max_error) / radius);
+    }
+    return count;
+}
+
+/**
+ * Build a LOD chain, each level simplified from the previous one
+ * The chain's indices (malloc'd, the caller frees them) start with a copy
+ * of the input as level 0, generated levels are ordered for the vertex
+ * cache. Level errors accumulate, so they grow along the chain
+ * @return The number of levels written to lods (at most max_levels), 0 on failure
+ */
+uint32_t nexus_mesh_build_lod_chain(const NexusVertex* vertices, uint32_t vertex_count, const uint32_t* indices,
+                                    uint32_t index_count, uint32_t max_levels, uint32_t** chain_indices,
+                                    uint32_t* chain_index_count, NexusMeshLod* lods) {
+    if (vertices == NULL || indices == NULL || chain_indices == NULL || chain_index_count == NULL ||
+        lods == NULL || index_count < 3 || max_levels == 0) {
+        return 0;
+    }
+    index_count = index_count / 3 * 3;
+
+    /* Each level has at most NEXUS_MESH_LOD_MIN_REDUCTION of the previous one's indices */
+    uint64_t capacity = 0;
+    double level_size = index_count;
+    for (uint32_t l = 0; l < max_levels; l++) {
+        capacity += (uint64_t)level_size + 3;
+        level_size *= NEXUS_MESH_LOD_MIN_REDUCTION;
+    }
+    uint32_t* chain = (uint32_t*)malloc(sizeof(uint32_t) * capacity);
+    if (chain == NULL) {
+        fprintf(stderr, "Failed to allocate memory for a LOD chain!\n");
+        return 0;
+    }
+
+    memcpy(chain, indices, sizeof(uint32_t) * index_count);
+    memset(&lods[0], 0, sizeof(NexusMeshLod));
+    lods[0].index_count = index_count;
+    uint32_t level_count = 1;
+    uint32_t written = index_count;
+
+    while (level_count < max_levels) {
+        const NexusMeshLod* previous = &lods[level_count - 1];
+        if (previous->index_count / 3 < NEXUS_MESH_LOD_MIN_TRIANGLES * 2 ||
+            previous->error >= NEXUS_MESH_LOD_MAX_ERROR) {
+            break;
+        }
+
+        uint32_t target = (uint32_t)((float)(previous->index_count / 3) * NEXUS_MESH_LOD_REDUCTION) * 3;
+        float error = 0.0f;
+        uint32_t* level = &chain[written];
+        uint32_t level_indices = nexus_mesh_simplify(vertices, vertex_count, &chain[previous->index_offset],
+                                                     previous->index_count, target,
+                                                     NEXUS_MESH_LOD_MAX_ERROR - previous->error, level, &error);
+        if (level_indices == 0 ||
+            (float)level_indices > (float)previous->index_count * NEXUS_MESH_LOD_MIN_REDUCTION) {
+            break;
+        }
+
+        nexus_mesh_optimize_vertex_cache(level, level_indices, vertex_count, NULL);
+
+        NexusMeshLod* lod = &lods[level_count++];
+        memset(lod, 0, sizeof(NexusMeshLod));
+        lod->index_offset = written;
+        lod->index_count = level_indices;
+        lod->error = previous->error + error;
+        written += level_indices;
+    }
+
+    *chain_indices = chain;
+    *chain_index_count = written;
+    return level_count;
+}
+
+/**
+ * Generate the LOD chain of CPU side mesh data
+ * Data that already has detail levels (artist LODs) is left alone, and
+ * meshlets are dropped since they no longer match (cooking rebuilds them)
+ */
+bool nexus_mesh_data_generate_lods(NexusMeshData* data, uint32_t max_levels) {
+    if (data == NULL || data->vertices == NULL || data->indices == NULL || data->index_count == 0) {
+        return false;
+    }
+    if (data->lod_count > 1) {
+        return true;
+    }
+
+    /* Cooked data points into a read only mapping */
+    if (data->file.data != NULL) {
+        fprintf(stderr, "Cannot generate LODs of mesh data mapped from a cooked file!\n");
+        return false;
+    }
+
+    if (max_levels > NEXUS_MESH_MAX_LODS) {
+        max_levels = NEXUS_MESH_MAX_LODS;
+    }
+
+    NexusMeshLod levels[NEXUS_MESH_MAX_LODS];
+    uint32_t* chain = NULL;
+    uint32_t chain_count = 0;
+    uint32_t level_count = nexus_mesh_build_lod_chain(data->vertices, data->vertex_count, data->indices,
+                                                      data->index_count, max_levels, &chain, &chain_count, levels);
+    if (level_count == 0) {
+        return false;
+    }
+
+    NexusMeshLod* lods = (NexusMeshLod*)malloc(sizeof(NexusMeshLod) * level_count);
+    if (lods == NULL) {
+        free(chain);
+        return false;
+    }
+    memcpy(lods, levels, sizeof(NexusMeshLod) * level_count);
+
+    free(data->indices);
+    free(data->lods);
+    free(data->meshlets);
+    data->indices = chain;
+    data->index_count = chain_count;
+    data->lods = lods;
+    data->lod_count = level_count;
+    data->meshlets = NULL;
+    data->meshlet_count = 0;
+    return true;
+}
@@ -0,0 +1,632 @@
+/**
+ * Nexus3D Pipeline Cache Implementation
+ * Pipeline creation from render state, hashing and lazy variant creation
+ */
+
+#include "nexus3d/renderer/pipeline_cache.h"
+#include "nexus3d/renderer/shader_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Number of devices that can have a pipeline cache at the same time */
+#define NEXUS_PIPELINE_CACHE_MAX_DEVICES 4
+
+/* Initial table size (power of two) */
+#define NEXUS_PIPELINE_CACHE_INITIAL_CAPACITY 64
+
+/* Per-instance world matrix attributes, one float4 column per location */
+static const SDL_GPUVertexAttribute s_instance_attributes[] = {
+    {
+        .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, /* world matrix column 0 */
+        .offset = 0,
+        .buffer_slot = NEXUS_SHADER_INSTANCE_BUFFER_SLOT,
+        .location = NEXUS_SHADER_INSTANCE_ATTRIBUTE_LOCATION
+    },
+    {
+        .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, /* world matrix column 1 */
+        .offset = 16,
+        .buffer_slot = NEXUS_SHADER_INSTANCE_BUFFER_SLOT,
+        .location = NEXUS_SHADER_INSTANCE_ATTRIBUTE_LOCATION + 1
+    },
+    {
+        .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, /* world matrix column 2 */
+        .offset = 32,
+        .buffer_slot = NEXUS_SHADER_INSTANCE_BUFFER_SLOT,
+        .location = NEXUS_SHADER_INSTANCE_ATTRIBUTE_LOCATION + 2
+    },
+    {
+        .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, /* world matrix column 3 */
+        .offset = 48,
+        .buffer_slot = NEXUS_SHADER_INSTANCE_BUFFER_SLOT,
+        .location = NEXUS_SHADER_INSTANCE_ATTRIBUTE_LOCATION + 3
+    }
+};
+
+/* Number of instance attributes */
+#define NEXUS_PIPELINE_INSTANCE_ATTRIBUTES (sizeof(s_instance_attributes) / sizeof(s_instance_attributes[0]))
+
+/**
+ * Device to pipeline cache registry, lets shaders find the cache for their device
+ */
+static struct {
+    SDL_GPUDevice* device;
+    NexusPipelineCache* cache;
+} s_pipeline_caches[NEXUS_PIPELINE_CACHE_MAX_DEVICES];
+
+/**
+ * Color blend state for a blend mode
+ */
+static SDL_GPUColorTargetBlendState nexus_pipeline_get_blend_state(NexusBlendMode blend_mode) {
+    SDL_GPUColorTargetBlendState blend = {
+        .enable_blend = false,
+        .src_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE,
+        .dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ZERO,
+        .color_blend_op = SDL_GPU_BLENDOP_ADD,
+        .src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE,
+        .dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ZERO,
+        .alpha_blend_op = SDL_GPU_BLENDOP_ADD,
+        .color_write_mask = SDL_GPU_COLORCOMPONENT_R | SDL_GPU_COLORCOMPONENT_G |
+                           SDL_GPU_COLORCOMPONENT_B | SDL_GPU_COLORCOMPONENT_A,
+        .enable_color_write_mask = true
+    };
+
+    switch (blend_mode) {
+        case NEXUS_BLEND_MODE_ALPHA:
+            blend.enable_blend = true;
+            blend.src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA;
+            blend.dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+            blend.src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE;
+            blend.dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+            break;
+        case NEXUS_BLEND_MODE_ADDITIVE:
+            blend.enable_blend = true;
+            blend.src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA;
+            blend.dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE;
+            blend.src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ZERO;
+            blend.dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE;
+            break;
+        case NEXUS_BLEND_MODE_MULTIPLY:
+            blend.enable_blend = true;
+            blend.src_color_blendfactor = SDL_GPU_BLENDFACTOR_DST_COLOR;
+            blend.dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ZERO;
+            blend.src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_DST_ALPHA;
+            blend.dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ZERO;
+            break;
+        case NEXUS_BLEND_MODE_OPAQUE:
+        default:
+            break;
+    }
+
+    return blend;
+}
+
+/**
+ * Hash a key (FNV-1a over its bytes, never 0 so 0 can mark empty slots)
+ */
+static uint64_t nexus_pipeline_hash_key(const NexusPipelineKey* key) {
+    const uint8_t* bytes = (const uint8_t*)key;
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < sizeof(NexusPipelineKey); i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash != 0 ? hash : 1;
+}
+
+/**
+ * Build the key for a shader and state
+ */
+static void nexus_pipeline_make_key(const NexusShader* shader, const NexusPipelineState* state, NexusPipelineKey* key) {
+    /* Padding has to be zero for bytewise hashing and comparison */
+    memset(key, 0, sizeof(NexusPipelineKey));
+    key->vertex_shader = shader->vertex_shader;
+    key->fragment_shader = shader->fragment_shader;
+    key->state.vertex_layout = state->vertex_layout;
+    key->state.blend_mode = state->blend_mode;
+    key->state.cull_mode = state->cull_mode;
+    key->state.fill_mode = state->fill_mode;
+    key->state.color_write = state->color_write;
+    key->state.depth_test = state->depth_test;
+    key->state.depth_write = state->depth_write;
+    key->state.depth_compare = state->depth_compare;
+    key->state.depth_bias = state->depth_bias;
+    key->state.depth_bias_slope = state->depth_bias_slope;
+    key->state.color_format = state->color_format;
+    key->state.depth_format = state->depth_format;
+    key->state.sample_count = state->sample_count;
+}
+
+/**
+ * Insert an entry into a table without checking for duplicates
+ */
+static void nexus_pipeline_cache_insert(NexusPipelineCacheEntry* entries, uint32_t capacity,
+                                        const NexusPipelineCacheEntry* entry) {
+    uint32_t mask = capacity - 1;
+    uint32_t slot = (uint32_t)entry->hash & mask;
+    while (entries[slot].hash != 0) {
+        slot = (slot + 1) & mask;
+    }
+    entries[slot] = *entry;
+}
+
+/**
+ * Rebuild the table with the given capacity, keeping only entries with a pipeline
+ */
+static bool nexus_pipeline_cache_rehash(NexusPipelineCache* cache, uint32_t capacity) {
+    NexusPipelineCacheEntry* entries = (NexusPipelineCacheEntry*)calloc(capacity, sizeof(NexusPipelineCacheEntry));
+    if (entries == NULL) {
+        fprintf(stderr, "Failed to grow pipeline cache!\n");
+        return false;
+    }
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < cache->capacity; i++) {
+        if (cache->entries[i].hash != 0 && cache->entries[i].pipeline != NULL) {
+            nexus_pipeline_cache_insert(entries, capacity, &cache->entries[i]);
+            count++;
+        }
+    }
+
+    free(cache->entries);
+    cache->entries = entries;
+    cache->capacity = capacity;
+    cache->count = count;
+    return true;
+}
+
+/**
+ * Fill in the default render state (opaque, back face culling, depth tested)
+ */
+void nexus_pipeline_state_default(NexusPipelineState* state) {
+    if (state == NULL) {
+        return;
+    }
+
+    memset(state, 0, sizeof(NexusPipelineState));
+    state->vertex_layout = NEXUS_VERTEX_LAYOUT_DEFAULT;
+    state->blend_mode = NEXUS_BLEND_MODE_OPAQUE;
+    state->cull_mode = SDL_GPU_CULLMODE_BACK;
+    state->fill_mode = SDL_GPU_FILLMODE_FILL;
+    state->color_write = true;
+    state->depth_test = true;
+    state->depth_write = true;
+    state->depth_compare = SDL_GPU_COMPAREOP_LESS;
+    state->color_format = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM;
+    state->depth_format = SDL_GPU_TEXTUREFORMAT_D32_FLOAT;
+    state->sample_count = SDL_GPU_SAMPLECOUNT_1;
+}
+
+/**
+ * Apply a material's render properties to a state
+ * Target formats are left untouched
+ */
+void nexus_pipeline_state_from_material(NexusPipelineState* state, const NexusMaterial* material) {
+    if (state == NULL || material == NULL) {
+        return;
+    }
+
+    state->blend_mode = material->blend_mode;
+    state->cull_mode = material->two_sided ? SDL_GPU_CULLMODE_NONE : SDL_GPU_CULLMODE_BACK;
+    state->fill_mode = material->wireframe ? SDL_GPU_FILLMODE_LINE : SDL_GPU_FILLMODE_FILL;
+
+    /* Blended surfaces are depth tested but do not occlude what is behind them */
+    state->depth_write = material->blend_mode == NEXUS_BLEND_MODE_OPAQUE;
+}
+
+/**
+ * Create a graphics pipeline for a shader and render state
+ */
+SDL_GPUGraphicsPipeline* nexus_pipeline_create(SDL_GPUDevice* device, const NexusShader* shader,
+                                               const NexusPipelineState* state) {
+    if (device == NULL || shader == NULL || state == NULL ||
+        shader->vertex_shader == NULL || shader->fragment_shader == NULL) {
+        fprintf(stderr, "Cannot create pipeline: missing shader modules!\n");
+        return NULL;
+    }
+
+    /* Create graphics pipeline */
+    SDL_GPUGraphicsPipelineCreateInfo createInfo = {0};
+    bool has_depth = state->depth_format != SDL_GPU_TEXTUREFORMAT_INVALID;
+    
+    /* Set shader stages */
+    createInfo.vertex_shader = shader->vertex_shader;
+    createInfo.fragment_shader = shader->fragment_shader;
+    createInfo.primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
+    
+    /* Configure vertex attributes from the layout descriptor */
+    const NexusVertexLayout* layout = nexus_vertex_layout_get(state->vertex_layout);
+    if (layout == NULL) {
+        fprintf(stderr, "Cannot create pipeline: unknown vertex layout %u!\n", state->vertex_layout);
+        return NULL;
+    }
+
+    SDL_GPUVertexInputState vertexInput = {0};
+    
+    /* Set up vertex buffer bindings: per-vertex data and per-instance transforms */
+    SDL_GPUVertexBufferDescription vertexBuffers[2] = {
+        {
+            .pitch = layout->stride,
+            .input_rate = SDL_GPU_VERTEXINPUTRATE_VERTEX,
+            .slot = 0,
+            .instance_step_rate = 0
+        },
+        {
+            .pitch = NEXUS_SHADER_INSTANCE_STRIDE, /* world matrix (16 floats) */
+            .input_rate = SDL_GPU_VERTEXINPUTRATE_INSTANCE,
+            .slot = NEXUS_SHADER_INSTANCE_BUFFER_SLOT,
+            .instance_step_rate = 0
+        }
+    };
+
+    /* Layout attributes followed by the instance matrix */
+    SDL_GPUVertexAttribute vertexAttributes[NEXUS_VERTEX_LAYOUT_MAX_ATTRIBUTES + NEXUS_PIPELINE_INSTANCE_ATTRIBUTES];
+    memcpy(vertexAttributes, layout->attributes, layout->attribute_count * sizeof(SDL_GPUVertexAttribute));
+    memcpy(vertexAttributes + layout->attribute_count, s_instance_attributes, sizeof(s_instance_attributes));
+    
+    vertexInput.vertex_buffer_descriptions = vertexBuffers;
+    vertexInput.num_vertex_buffers = 2;
+    vertexInput.vertex_attributes = vertexAttributes;
+    vertexInput.num_vertex_attributes = layout->attribute_count + (uint32_t)NEXUS_PIPELINE_INSTANCE_ATTRIBUTES;
+    
+    createInfo.vertex_input_state = vertexInput;
+    
+    /* Set up rasterizer state */
+    SDL_GPURasterizerState rasterizerState = {
+        .fill_mode = state->fill_mode,
+        .cull_mode = state->cull_mode,
+        .front_face = SDL_GPU_FRONTFACE_COUNTER_CLOCKWISE,
+        .enable_depth_clip = true,
+        .enable_depth_bias = state->depth_bias != 0.0f || state->depth_bias_slope != 0.0f,
+        .depth_bias_constant_factor = state->depth_bias,
+        .depth_bias_clamp = 0.0f,
+        .depth_bias_slope_factor = state->depth_bias_slope
+    };
+    
+    createInfo.rasterizer_state = rasterizerState;
+    
+    /* Set up depth-stencil state */
+    SDL_GPUDepthStencilState depthStencilState = {
+        .enable_depth_test = has_depth && state->depth_test,
+        .enable_depth_write = has_depth && state->depth_write,
+        .compare_op = state->depth_compare,
+        .enable_stencil_test = false,
+        .compare_mask = 0xFF,
+        .write_mask = 0xFF,
+        .front_stencil_state = {
+            .fail_op = SDL_GPU_STENCILOP_KEEP,
+            .pass_op = SDL_GPU_STENCILOP_KEEP,
+            .depth_fail_op = SDL_GPU_STENCILOP_KEEP,
+            .compare_op = SDL_GPU_COMPAREOP_ALWAYS
+        },
+        .back_stencil_state = {
+            .fail_op = SDL_GPU_STENCILOP_KEEP,
+            .pass_op = SDL_GPU_STENCILOP_KEEP,
+            .depth_fail_op = SDL_GPU_STENCILOP_KEEP,
+            .compare_op = SDL_GPU_COMPAREOP_ALWAYS
+        }
+    };
+    
+    createInfo.depth_stencil_state = depthStencilState;
+    
+    /* Set up multisample state */
+    SDL_GPUMultisampleState multisampleState = {
+        .sample_count = state->sample_count,
+        .sample_mask = 0xFFFFFFFF,
+        .enable_mask = false
+    };
+    
+    createInfo.multisample_state = multisampleState;
+    
+    /* Set up color blend state for the render target */
+    SDL_GPUColorTargetBlendState colorTargetBlendState = nexus_pipeline_get_blend_state(state->blend_mode);
+    if (!state->color_write) {
+        /* Depth only variant (depth prepass) */
+        colorTargetBlendState.enable_blend = false;
+        colorTargetBlendState.color_write_mask = 0;
+    }
+    
+    /* Set up render target info */
+    SDL_GPUColorTargetDescription colorTarget = {
+        .format = state->color_format,
+        .blend_state = colorTargetBlendState
+    };
+    
+    /* Set up pipeline target info (depth only passes such as shadow maps have no color target) */
+    bool has_color = state->color_format != SDL_GPU_TEXTUREFORMAT_INVALID;
+    SDL_GPUGraphicsPipelineTargetInfo targetInfo = {
+        .color_target_descriptions = has_color ? &colorTarget : NULL,
+        .num_color_targets = has_color ? 1 : 0,
+        .has_depth_stencil_target = has_depth,
+        .depth_stencil_format = state->depth_format
+    };
+    
+    createInfo.target_info = targetInfo;
+    
+    /* Create the pipeline */
+    SDL_GPUGraphicsPipeline* pipeline = SDL_CreateGPUGraphicsPipeline(device, &createInfo);
+    if (pipeline == NULL) {
+        fprintf(stderr, "Failed to create graphics pipeline for shader '%s': %s\n", shader->name, SDL_GetError());
+    }
+
+    return pipeline;
+}
+
+/**
+ * Find the entry for a key (lock held)
+ */
+static NexusPipelineCacheEntry* nexus_pipeline_cache_find(NexusPipelineCache* cache, uint64_t hash,
+                                                          const NexusPipelineKey* key) {
+    uint32_t mask = cache->capacity - 1;
+    uint32_t slot = (uint32_t)hash & mask;
+    while (cache->entries[slot].hash != 0) {
+        NexusPipelineCacheEntry* entry = &cache->entries[slot];
+        if (entry->hash == hash && memcmp(&entry->key, key, sizeof(NexusPipelineKey)) == 0) {
+            return entry;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return NULL;
+}
+
+/**
+ * Create a pipeline cache and register it for the device
+ */
+NexusPipelineCache* nexus_pipeline_cache_create(SDL_GPUDevice* device) {
+    /* Check for null parameters */
+    if (device == NULL) {
+        fprintf(stderr, "GPU device cannot be NULL when creating pipeline cache!\n");
+        return NULL;
+    }
+
+    /* Allocate cache structure */
+    NexusPipelineCache* cache = (NexusPipelineCache*)malloc(sizeof(NexusPipelineCache));
+    if (cache == NULL) {
+        fprintf(stderr, "Failed to allocate memory for pipeline cache!\n");
+        return NULL;
+    }
+
+    /* Initialize cache structure */
+    memset(cache, 0, sizeof(NexusPipelineCache));
+    cache->device = device;
+    cache->color_format = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM;
+    cache->depth_format = SDL_GPU_TEXTUREFORMAT_D32_FLOAT;
+    cache->sample_count = SDL_GPU_SAMPLECOUNT_1;
+
+    /* Allocate the table */
+    cache->entries = (NexusPipelineCacheEntry*)calloc(NEXUS_PIPELINE_CACHE_INITIAL_CAPACITY,
+                                                      sizeof(NexusPipelineCacheEntry));
+    if (cache->entries == NULL) {
+        fprintf(stderr, "Failed to allocate pipeline cache table!\n");
+        free(cache);
+        return NULL;
+    }
+    cache->capacity = NEXUS_PIPELINE_CACHE_INITIAL_CAPACITY;
+
+    cache->lock = SDL_CreateMutex();
+    if (cache->lock == NULL) {
+        fprintf(stderr, "Failed to create pipeline cache lock: %s\n", SDL_GetError());
+        free(cache->entries);
+        free(cache);
+        return NULL;
+    }
+
+    /* Register for the device */
+    for (int i = 0; i < NEXUS_PIPELINE_CACHE_MAX_DEVICES; i++) {
+        if (s_pipeline_caches[i].device == NULL) {
+            s_pipeline_caches[i].device = device;
+            s_pipeline_caches[i].cache = cache;
+            break;
+        }
+    }
+
+    return cache;
+}
+
+/**
+ * Destroy a pipeline cache and all pipelines it owns
+ */
+void nexus_pipeline_cache_destroy(NexusPipelineCache* cache) {
+    if (cache == NULL) {
+        return;
+    }
+
+    /* Unregister */
+    for (int i = 0; i < NEXUS_PIPELINE_CACHE_MAX_DEVICES; i++) {
+        if (s_pipeline_caches[i].cache == cache) {
+            s_pipeline_caches[i].device = NULL;
+            s_pipeline_caches[i].cache = NULL;
+        }
+    }
+
+    /* Release pipelines */
+    for (uint32_t i = 0; i < cache->capacity; i++) {
+        if (cache->entries[i].pipeline != NULL) {
+            SDL_ReleaseGPUGraphicsPipeline(cache->device, cache->entries[i].pipeline);
+        }
+    }
+
+    /* Free cache structure */
+    SDL_DestroyMutex(cache->lock);
+    free(cache->entries);
+    free(cache);
+}
+
+/**
+ * Get the pipeline cache registered for a device (NULL if there is none)
+ */
+NexusPipelineCache* nexus_pipeline_cache_get(SDL_GPUDevice* device) {
+    if (device == NULL) {
+        return NULL;
+    }
+
+    for (int i = 0; i < NEXUS_PIPELINE_CACHE_MAX_DEVICES; i++) {
+        if (s_pipeline_caches[i].device == device) {
+            return s_pipeline_caches[i].cache;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Set the render targets states are built for by default
+ */
+void nexus_pipeline_cache_set_targets(NexusPipelineCache* cache, SDL_GPUTextureFormat color_format,
+                                      SDL_GPUTextureFormat depth_format, SDL_GPUSampleCount sample_count) {
+    if (cache == NULL) {
+        return;
+    }
+
+    cache->color_format = color_format;
+    cache->depth_format = depth_format;
+    cache->sample_count = sample_count;
+}
+
+/**
+ * Build the state for drawing a material into the cache's targets
+ * A NULL material gives the default opaque state
+ */
+void nexus_pipeline_cache_get_state(const NexusPipelineCache* cache, const NexusMaterial* material,
+                                    NexusPipelineState* state) {
+    if (state == NULL) {
+        return;
+    }
+
+    nexus_pipeline_state_default(state);
+    if (cache != NULL) {
+        state->color_format = cache->color_format;
+        state->depth_format = cache->depth_format;
+        state->sample_count = cache->sample_count;
+    }
+    nexus_pipeline_state_from_material(state, material);
+}
+
+/**
+ * Get the pipeline for a shader and state, creating it on first use
+ */
+SDL_GPUGraphicsPipeline* nexus_pipeline_cache_acquire(NexusPipelineCache* cache, const NexusShader* shader,
+                                                      const NexusPipelineState* state) {
+    if (cache == NULL || shader == NULL || state == NULL) {
+        return NULL;
+    }
+
+    NexusPipelineKey key;
+    nexus_pipeline_make_key(shader, state, &key);
+    uint64_t hash = nexus_pipeline_hash_key(&key);
+
+    /* Lookup */
+    SDL_LockMutex(cache->lock);
+    NexusPipelineCacheEntry* entry = nexus_pipeline_cache_find(cache, hash, &key);
+    if (entry != NULL) {
+        SDL_GPUGraphicsPipeline* pipeline = entry->pipeline;
+        cache->hits++;
+        SDL_UnlockMutex(cache->lock);
+        return pipeline;
+    }
+    SDL_UnlockMutex(cache->lock);
+
+    /* Miss, build the variant outside the lock (this is the hitch prewarming avoids) */
+    SDL_GPUGraphicsPipeline* pipeline = nexus_pipeline_create(cache->device, shader, state);
+    if (pipeline == NULL) {
+        return NULL;
+    }
+
+    SDL_LockMutex(cache->lock);
+
+    /* Another thread may have built the same variant in the meantime */
+    entry = nexus_pipeline_cache_find(cache, hash, &key);
+    if (entry != NULL) {
+        SDL_GPUGraphicsPipeline* existing = entry->pipeline;
+        SDL_UnlockMutex(cache->lock);
+        SDL_ReleaseGPUGraphicsPipeline(cache->device, pipeline);
+        return existing;
+    }
+    cache->misses++;
+
+    /* Keep the load factor below 3/4 */
+    if ((cache->count + 1) * 4 > cache->capacity * 3) {
+        if (!nexus_pipeline_cache_rehash(cache, cache->capacity * 2)) {
+            SDL_UnlockMutex(cache->lock);
+            SDL_ReleaseGPUGraphicsPipeline(cache->device, pipeline);
+            return NULL;
+        }
+    }
+
+    NexusPipelineCacheEntry new_entry;
+    new_entry.hash = hash;
+    new_entry.key = key;
+    new_entry.pipeline = pipeline;
+    nexus_pipeline_cache_insert(cache->entries, cache->capacity, &new_entry);
+    cache->count++;
+
+    SDL_UnlockMutex(cache->lock);
+
+    /* Remember the variant so the next run can prewarm it */
+    nexus_shader_cache_record_pipeline(nexus_shader_cache_get(cache->device), shader, state);
+
+    return pipeline;
+}
+
+/**
+ * Create the pipelines for a list of states up front (at load time)
+ * Returns the number of states that have a pipeline afterwards
+ */
+uint32_t nexus_pipeline_cache_prewarm(NexusPipelineCache* cache, const NexusShader* shader,
+                                      const NexusPipelineState* states, uint32_t count) {
+    if (cache == NULL || shader == NULL || states == NULL) {
+        return 0;
+    }
+
+    uint32_t ready = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (nexus_pipeline_cache_acquire(cache, shader, &states[i]) != NULL) {
+            ready++;
+        }
+    }
+
+    return ready;
+}
+
+/**
+ * Release all pipelines built from a shader's modules
+ * Must be called before the modules are released or replaced
+ */
+void nexus_pipeline_cache_evict_shader(NexusPipelineCache* cache, const NexusShader* shader) {
+    if (cache == NULL || shader == NULL) {
+        return;
+    }
+
+    SDL_LockMutex(cache->lock);
+
+    bool evicted = false;
+    for (uint32_t i = 0; i < cache->capacity; i++) {
+        NexusPipelineCacheEntry* entry = &cache->entries[i];
+        if (entry->hash != 0 &&
+            (entry->key.vertex_shader == shader->vertex_shader ||
+             entry->key.fragment_shader == shader->fragment_shader)) {
+            SDL_ReleaseGPUGraphicsPipeline(cache->device, entry->pipeline);
+            entry->pipeline = NULL;
+            evicted = true;
+        }
+    }
+
+    /* Rebuild to drop the emptied slots without breaking probe chains */
+    if (evicted) {
+        nexus_pipeline_cache_rehash(cache, cache->capacity);
+    }
+
+    SDL_UnlockMutex(cache->lock);
+}
+
+/**
+ * Get the number of pipelines in the cache
+ */
+uint32_t nexus_pipeline_cache_get_count(const NexusPipelineCache* cache) {
+    if (cache == NULL) {
+        return 0;
+    }
+
+    return cache->count;
+}
@@ -0,0 +1,761 @@
+/**
+ * Nexus3D Render Graph Implementation
+ * Passes are culled backwards from the exported textures and side effect
+ * passes, ordered by their texture dependencies and given pooled transient
+ * textures and load/store ops from the resulting lifetimes
+ */
+
+#include "nexus3d/renderer/render_graph.h"
+#include "nexus3d/utils/profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Invalid pass index */
+#define NEXUS_RENDER_GRAPH_NO_PASS UINT32_MAX
+
+/**
+ * Create a render graph
+ */
+NexusRenderGraph* nexus_render_graph_create(SDL_GPUDevice* device) {
+    NexusRenderGraph* graph = (NexusRenderGraph*)malloc(sizeof(NexusRenderGraph));
+    if (graph == NULL) {
+        fprintf(stderr, "Failed to allocate memory for render graph!\n");
+        return NULL;
+    }
+    memset(graph, 0, sizeof(NexusRenderGraph));
+    graph->device = device;
+
+    return graph;
+}
+
+/**
+ * Destroy a render graph and its pooled textures
+ */
+void nexus_render_graph_destroy(NexusRenderGraph* graph) {
+    if (graph == NULL) {
+        return;
+    }
+
+    if (graph->device != NULL) {
+        for (uint32_t i = 0; i < graph->pool_count; i++) {
+            SDL_ReleaseGPUTexture(graph->device, graph->pool[i].texture);
+        }
+    }
+
+    free(graph);
+}
+
+/**
+ * Start declaring a new frame
+ * Pooled textures unused for NEXUS_RENDER_GRAPH_POOL_FRAMES frames are released
+ */
+void nexus_render_graph_reset(NexusRenderGraph* graph) {
+    if (graph == NULL) {
+        return;
+    }
+
+    graph->pass_count = 0;
+    graph->texture_count = 0;
+    graph->version_count = 0;
+    graph->order_count = 0;
+    graph->failed = false;
+    graph->compiled = false;
+    graph->frame++;
+
+    /* Age the pool, the GPU keeps released textures alive until in-flight work is done */
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < graph->pool_count; i++) {
+        NexusRenderGraphPoolEntry* entry = &graph->pool[i];
+        if (graph->frame - entry->last_frame > NEXUS_RENDER_GRAPH_POOL_FRAMES) {
+            SDL_ReleaseGPUTexture(graph->device, entry->texture);
+            continue;
+        }
+        entry->busy_until = -1;
+        graph->pool[kept++] = *entry;
+    }
+    graph->pool_count = kept;
+}
+
+/**
+ * Add a texture with its initial version
+ */
+static NexusRenderGraphResource nexus_render_graph_add_texture(NexusRenderGraph* graph, const char* name,
+                                                               const NexusRenderGraphTextureDesc* desc) {
+    if (graph->texture_count >= NEXUS_RENDER_GRAPH_MAX_TEXTURES ||
+        graph->version_count >= NEXUS_RENDER_GRAPH_MAX_VERSIONS) {
+        fprintf(stderr, "Too many render graph textures, '%s' dropped!\n", name != NULL ? name : "");
+        graph->failed = true;
+        return NEXUS_RENDER_GRAPH_INVALID;
+    }
+
+    NexusRenderGraphTexture* texture = &graph->textures[graph->texture_count];
+    memset(texture, 0, sizeof(NexusRenderGraphTexture));
+    texture->name = name;
+    texture->desc = *desc;
+    if (texture->desc.sample_count == 0) {
+        texture->desc.sample_count = SDL_GPU_SAMPLECOUNT_1;
+    }
+    texture->first_use = -1;
+    texture->last_use = -1;
+    texture->pool_entry = -1;
+
+    NexusRenderGraphVersion* version = &graph->versions[graph->version_count];
+    version->texture = graph->texture_count++;
+    version->writer = -1;
+    version->next_writer = -1;
+    return ++graph->version_count;
+}
+
+/**
+ * Import a texture owned outside the graph
+ * @param has_contents The texture's contents on entry are kept by passes loading it
+ * @param exported The final version is used after the graph, its writers are never culled
+ */
+NexusRenderGraphResource nexus_render_graph_import_texture(NexusRenderGraph* graph, const char* name,
+                                                           SDL_GPUTexture* texture,
+                                                           const NexusRenderGraphTextureDesc* desc,
+                                                           bool has_contents, bool exported) {
+    if (graph == NULL || texture == NULL || desc == NULL) {
+        return NEXUS_RENDER_GRAPH_INVALID;
+    }
+
+    NexusRenderGraphResource resource = nexus_render_graph_add_texture(graph, name, desc);
+    if (resource != NEXUS_RENDER_GRAPH_INVALID) {
+        NexusRenderGraphTexture* entry = &graph->textures[graph->versions[resource - 1].texture];
+        entry->texture = texture;
+        entry->imported = true;
+        entry->has_contents = has_contents;
+        entry->exported = exported;
+    }
+    return resource;
+}
+
+/**
+ * Declare a transient texture, it only exists while passes use it and may
+ * share its GPU texture with transients whose lifetimes don't overlap
+ */
+NexusRenderGraphResource nexus_render_graph_create_texture(NexusRenderGraph* graph, const char* name,
+                                                           const NexusRenderGraphTextureDesc* desc) {
+    if (graph == NULL || desc == NULL || desc->width == 0 || desc->height == 0) {
+        return NEXUS_RENDER_GRAPH_INVALID;
+    }
+
+    return nexus_render_graph_add_texture(graph, name, desc);
+}
+
+/**
+ * Add a pass
+ * @return Pass index, UINT32_MAX on failure
+ */
+uint32_t nexus_render_graph_add_pass(NexusRenderGraph* graph, const char* name,
+                                     NexusRenderGraphExecuteFunc execute, void* user_data) {
+    if (graph == NULL) {
+        return NEXUS_RENDER_GRAPH_NO_PASS;
+    }
+    if (graph->pass_count >= NEXUS_RENDER_GRAPH_MAX_PASSES) {
+        fprintf(stderr, "Too many render graph passes, '%s' dropped!\n", name != NULL ? name : "");
+        graph->failed = true;
+        return NEXUS_RENDER_GRAPH_NO_PASS;
+    }
+
+    NexusRenderGraphPass* pass = &graph->passes[graph->pass_count];
+    memset(pass, 0, sizeof(NexusRenderGraphPass));
+    pass->name = name;
+    pass->execute = execute;
+    pass->user_data = user_data;
+    return graph->pass_count++;
+}
+
+/**
+ * Check a pass index and resource handle of a declaration
+ */
+static bool nexus_render_graph_check(NexusRenderGraph* graph, uint32_t pass, NexusRenderGraphResource resource) {
+    if (graph == NULL) {
+        return false;
+    }
+    if (pass >= graph->pass_count || resource == NEXUS_RENDER_GRAPH_INVALID || resource > graph->version_count) {
+        fprintf(stderr, "Invalid render graph pass or resource!\n");
+        graph->failed = true;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Record a write of a version, producing the next one
+ */
+static bool nexus_render_graph_write(NexusRenderGraph* graph, uint32_t pass, NexusRenderGraphResource resource,
+                                     SDL_GPUTextureUsageFlags usage, NexusRenderGraphAttachment* attachment) {
+    NexusRenderGraphVersion* version = &graph->versions[resource - 1];
+
+    /* Versions are linear, two passes writing over the same one would race */
+    if (version->next_writer >= 0) {
+        const char* name = graph->textures[version->texture].name;
+        fprintf(stderr, "Render graph texture '%s' written twice from the same version!\n",
+                name != NULL ? name : "");
+        graph->failed = true;
+        return false;
+    }
+    if (graph->version_count >= NEXUS_RENDER_GRAPH_MAX_VERSIONS) {
+        fprintf(stderr, "Too many render graph texture versions!\n");
+        graph->failed = true;
+        return false;
+    }
+
+    NexusRenderGraphVersion* next = &graph->versions[graph->version_count];
+    next->texture = version->texture;
+    next->writer = (int32_t)pass;
+    next->next_writer = -1;
+    version->next_writer = (int32_t)pass;
+    graph->textures[version->texture].usage |= usage;
+
+    attachment->input = resource;
+    attachment->output = ++graph->version_count;
+    return true;
+}
+
+/**
+ * Declare a color attachment of a pass
+ * @param clear_color Color to clear to, NULL keeps the contents of resource
+ * @return The version the pass produces
+ */
+NexusRenderGraphResource nexus_render_graph_write_color(NexusRenderGraph* graph, uint32_t pass,
+                                                        NexusRenderGraphResource resource,
+                                                        const SDL_FColor* clear_color) {
+    if (!nexus_render_graph_check(graph, pass, resource)) {
+        return NEXUS_RENDER_GRAPH_INVALID;
+    }
+
+    NexusRenderGraphPass* entry = &graph->passes[pass];
+    if (entry->color_count >= NEXUS_RENDER_GRAPH_MAX_COLORS) {
+        fprintf(stderr, "Too many color attachments in render graph pass '%s'!\n", entry->name);
+        graph->failed = true;
+        return NEXUS_RENDER_GRAPH_INVALID;
+    }
+
+    NexusRenderGraphAttachment* attachment = &entry->colors[entry->color_count];
+    memset(attachment, 0, sizeof(NexusRenderGraphAttachment));
+    if (!nexus_render_graph_write(graph, pass, resource, SDL_GPU_TEXTUREUSAGE_COLOR_TARGET, attachment)) {
+        return NEXUS_RENDER_GRAPH_INVALID;
+    }
+    if (clear_color != NULL) {
+        attachment->clear = true;
+        attachment->clear_color = *clear_color;
+    }
+
+    entry->color_count++;
+    return attachment->output;
+}
+
+/**
+ * Declare the depth attachment of a pass
+ * @return The version the pass produces
+ */
+NexusRenderGraphResource nexus_render_graph_write_depth(NexusRenderGraph* graph, uint32_t pass,
+                                                        NexusRenderGraphResource resource,
+                                                        bool clear, float clear_depth) {
+    if (!nexus_render_graph_check(graph, pass, resource)) {
+        return NEXUS_RENDER_GRAPH_INVALID;
+    }
+
+    NexusRenderGraphPass* entry = &graph->passes[pass];
+    if (entry->depth.output != NEXUS_RENDER_GRAPH_INVALID) {
+        fprintf(stderr, "Render graph pass '%s' already has a depth attachment!\n", entry->name);
+        graph->failed = true;
+        return NEXUS_RENDER_GRAPH_INVALID;
+    }
+
+    NexusRenderGraphAttachment* attachment = &entry->depth;
+    memset(attachment, 0, sizeof(NexusRenderGraphAttachment));
+    if (!nexus_render_graph_write(graph, pass, resource, SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET, attachment)) {
+        return NEXUS_RENDER_GRAPH_INVALID;
+    }
+    attachment->clear = clear;
+    attachment->clear_depth = clear_depth;
+    return attachment->output;
+}
+
+/**
+ * Declare a texture a pass samples
+ */
+bool nexus_render_graph_read(NexusRenderGraph* graph, uint32_t pass, NexusRenderGraphResource resource) {
+    if (!nexus_render_graph_check(graph, pass, resource)) {
+        return false;
+    }
+
+    NexusRenderGraphPass* entry = &graph->passes[pass];
+    NexusRenderGraphVersion* version = &graph->versions[resource - 1];
+    if (version->writer == (int32_t)pass || version->next_writer == (int32_t)pass) {
+        fprintf(stderr, "Render graph pass '%s' samples a texture it renders to!\n", entry->name);
+        graph->failed = true;
+        return false;
+    }
+    if (entry->read_count >= NEXUS_RENDER_GRAPH_MAX_READS) {
+        fprintf(stderr, "Too many sampled textures in render graph pass '%s'!\n", entry->name);
+        graph->failed = true;
+        return false;
+    }
+
+    entry->reads[entry->read_count++] = resource;
+    graph->textures[version->texture].usage |= SDL_GPU_TEXTUREUSAGE_SAMPLER;
+    return true;
+}
+
+/**
+ * Keep a pass even if nothing reads its outputs
+ */
+void nexus_render_graph_set_side_effects(NexusRenderGraph* graph, uint32_t pass) {
+    if (graph == NULL || pass >= graph->pass_count) {
+        return;
+    }
+
+    graph->passes[pass].side_effects = true;
+}
+
+/**
+ * Get the attachments of a pass as one list (colors, then depth)
+ */
+static uint32_t nexus_render_graph_get_attachments(NexusRenderGraphPass* pass,
+                                                   NexusRenderGraphAttachment** attachments) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < pass->color_count; i++) {
+        attachments[count++] = &pass->colors[i];
+    }
+    if (pass->depth.output != NEXUS_RENDER_GRAPH_INVALID) {
+        attachments[count++] = &pass->depth;
+    }
+    return count;
+}
+
+/**
+ * Mark the passes the frame's outputs depend on, walking backwards from the
+ * roots (side effects and the last writers of exported textures)
+ */
+static void nexus_render_graph_cull(NexusRenderGraph* graph) {
+    uint32_t stack[NEXUS_RENDER_GRAPH_MAX_PASSES];
+    uint32_t stack_count = 0;
+
+    for (uint32_t i = 0; i < graph->pass_count; i++) {
+        graph->passes[i].alive = graph->passes[i].side_effects;
+        if (graph->passes[i].alive) {
+            stack[stack_count++] = i;
+        }
+    }
+    for (uint32_t i = 0; i < graph->version_count; i++) {
+        const NexusRenderGraphVersion* version = &graph->versions[i];
+        if (version->next_writer < 0 && version->writer >= 0 && graph->textures[version->texture].exported &&
+            !graph->passes[version->writer].alive) {
+            graph->passes[version->writer].alive = true;
+            stack[stack_count++] = (uint32_t)version->writer;
+        }
+    }
+
+    while (stack_count > 0) {
+        NexusRenderGraphPass* pass = &graph->passes[stack[--stack_count]];
+
+        /* Producers of the sampled versions and of the contents loaded into the attachments */
+        int32_t producers[NEXUS_RENDER_GRAPH_MAX_READS + NEXUS_RENDER_GRAPH_MAX_COLORS + 1];
+        uint32_t producer_count = 0;
+        for (uint32_t i = 0; i < pass->read_count; i++) {
+            producers[producer_count++] = graph->versions[pass->reads[i] - 1].writer;
+        }
+        NexusRenderGraphAttachment* attachments[NEXUS_RENDER_GRAPH_MAX_COLORS + 1];
+        uint32_t attachment_count = nexus_render_graph_get_attachments(pass, attachments);
+        for (uint32_t i = 0; i < attachment_count; i++) {
+            if (!attachments[i]->clear) {
+                producers[producer_count++] = graph->versions[attachments[i]->input - 1].writer;
+            }
+        }
+
+        for (uint32_t i = 0; i < producer_count; i++) {
+            if (producers[i] >= 0 && !graph->passes[producers[i]].alive) {
+                graph->passes[producers[i]].alive = true;
+                stack[stack_count++] = (uint32_t)producers[i];
+            }
+        }
+    }
+}
+
+/**
+ * Order the alive passes so every pass runs after the producers of what it
+ * reads and before anyone overwrites it, ties keep declaration order
+ */
+static bool nexus_render_graph_sort(NexusRenderGraph* graph) {
+    /* depends[p][q]: pass p has to run after pass q */
+    bool depends[NEXUS_RENDER_GRAPH_MAX_PASSES][NEXUS_RENDER_GRAPH_MAX_PASSES];
+    memset(depends, 0, sizeof(depends));
+
+    uint32_t alive_count = 0;
+    for (uint32_t p = 0; p < graph->pass_count; p++) {
+        NexusRenderGraphPass* pass = &graph->passes[p];
+        if (!pass->alive) {
+            continue;
+        }
+        alive_count++;
+
+        /* Read after write */
+        for (uint32_t i = 0; i < pass->read_count; i++) {
+            int32_t writer = graph->versions[pass->reads[i] - 1].writer;
+            if (writer >= 0) {
+                depends[p][writer] = true;
+            }
+        }
+
+        NexusRenderGraphAttachment* attachments[NEXUS_RENDER_GRAPH_MAX_COLORS + 1];
+        uint32_t attachment_count = nexus_render_graph_get_attachments(pass, attachments);
+        for (uint32_t i = 0; i < attachment_count; i++) {
+            NexusRenderGraphResource input = attachments[i]->input;
+
+            /* Write after write */
+            int32_t writer = graph->versions[input - 1].writer;
+            if (writer >= 0) {
+                depends[p][writer] = true;
+            }
+
+            /* Write after read, every reader of the overwritten version goes first */
+            for (uint32_t q = 0; q < graph->pass_count; q++) {
+                const NexusRenderGraphPass* other = &graph->passes[q];
+                for (uint32_t r = 0; q != p && r < other->read_count; r++) {
+                    if (other->reads[r] == input) {
+                        depends[p][q] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    /* Repeatedly take the first alive pass whose dependencies all ran */
+    bool scheduled[NEXUS_RENDER_GRAPH_MAX_PASSES];
+    memset(scheduled, 0, sizeof(scheduled));
+    graph->order_count = 0;
+    while (graph->order_count < alive_count) {
+        uint32_t next = NEXUS_RENDER_GRAPH_NO_PASS;
+        for (uint32_t p = 0; p < graph->pass_count && next == NEXUS_RENDER_GRAPH_NO_PASS; p++) {
+            if (!graph->passes[p].alive || scheduled[p]) {
+                continue;
+            }
+            bool ready = true;
+            for (uint32_t q = 0; q < graph->pass_count && ready; q++) {
+                ready = !depends[p][q] || !graph->passes[q].alive || scheduled[q];
+            }
+            if (ready) {
+                next = p;
+            }
+        }
+        if (next == NEXUS_RENDER_GRAPH_NO_PASS) {
+            fprintf(stderr, "Render graph passes depend on each other!\n");
+            return false;
+        }
+
+        scheduled[next] = true;
+        graph->order[graph->order_count++] = next;
+    }
+
+    return true;
+}
+
+/**
+ * Check whether a version's contents are used by a later alive pass
+ */
+static bool nexus_render_graph_is_consumed(const NexusRenderGraph* graph, NexusRenderGraphResource resource) {
+    const NexusRenderGraphVersion* version = &graph->versions[resource - 1];
+
+    /* Sampled by a later pass */
+    for (uint32_t p = 0; p < graph->pass_count; p++) {
+        const NexusRenderGraphPass* pass = &graph->passes[p];
+        if (!pass->alive) {
+            continue;
+        }
+        for (uint32_t i = 0; i < pass->read_count; i++) {
+            if (pass->reads[i] == resource) {
+                return true;
+            }
+        }
+    }
+
+    /* Final version of a texture used after the graph */
+    if (version->next_writer < 0) {
+        return graph->textures[version->texture].exported;
+    }
+
+    /* The next writer loads it */
+    const NexusRenderGraphPass* next = &graph->passes[version->next_writer];
+    if (!next->alive) {
+        return false;
+    }
+    for (uint32_t i = 0; i < next->color_count; i++) {
+        if (next->colors[i].input == resource) {
+            return !next->colors[i].clear;
+        }
+    }
+    return next->depth.input == resource && !next->depth.clear;
+}
+
+/**
+ * Derive load and store ops, clear or load only what was asked for or
+ * written before, store only what is read later
+ */
+static void nexus_render_graph_derive_ops(NexusRenderGraph* graph) {
+    for (uint32_t i = 0; i < graph->order_count; i++) {
+        NexusRenderGraphPass* pass = &graph->passes[graph->order[i]];
+        NexusRenderGraphAttachment* attachments[NEXUS_RENDER_GRAPH_MAX_COLORS + 1];
+        uint32_t attachment_count = nexus_render_graph_get_attachments(pass, attachments);
+
+        for (uint32_t a = 0; a < attachment_count; a++) {
+            NexusRenderGraphAttachment* attachment = attachments[a];
+            const NexusRenderGraphVersion* input = &graph->versions[attachment->input - 1];
+            bool has_contents = input->writer >= 0 ? graph->passes[input->writer].alive :
+                                graph->textures[input->texture].has_contents;
+
+            if (attachment->clear) {
+                attachment->load_op = SDL_GPU_LOADOP_CLEAR;
+            } else {
+                attachment->load_op = has_contents ? SDL_GPU_LOADOP_LOAD : SDL_GPU_LOADOP_DONT_CARE;
+            }
+            attachment->store_op = nexus_render_graph_is_consumed(graph, attachment->output) ?
+                SDL_GPU_STOREOP_STORE : SDL_GPU_STOREOP_DONT_CARE;
+        }
+    }
+}
+
+/**
+ * Record a pass' use of a version in its texture's lifetime
+ */
+static void nexus_render_graph_touch(NexusRenderGraph* graph, NexusRenderGraphResource resource, int32_t position) {
+    NexusRenderGraphTexture* texture = &graph->textures[graph->versions[resource - 1].texture];
+    if (texture->first_use < 0 || position < texture->first_use) {
+        texture->first_use = position;
+    }
+    if (position > texture->last_use) {
+        texture->last_use = position;
+    }
+}
+
+/**
+ * Back the used transients with pooled textures, a transient takes over a
+ * compatible texture whose previous user's lifetime already ended
+ */
+static bool nexus_render_graph_allocate(NexusRenderGraph* graph) {
+    for (uint32_t i = 0; i < graph->order_count; i++) {
+        NexusRenderGraphPass* pass = &graph->passes[graph->order[i]];
+        for (uint32_t r = 0; r < pass->read_count; r++) {
+            nexus_render_graph_touch(graph, pass->reads[r], (int32_t)i);
+        }
+        NexusRenderGraphAttachment* attachments[NEXUS_RENDER_GRAPH_MAX_COLORS + 1];
+        uint32_t attachment_count = nexus_render_graph_get_attachments(pass, attachments);
+        for (uint32_t a = 0; a < attachment_count; a++) {
+            nexus_render_graph_touch(graph, attachments[a]->output, (int32_t)i);
+        }
+    }
+
+    /* Assign in order of first use so freed textures are picked up right away */
+    graph->transient_count = 0;
+    for (int32_t position = 0; position < (int32_t)graph->order_count; position++) {
+        for (uint32_t t = 0; t < graph->texture_count; t++) {
+            NexusRenderGraphTexture* texture = &graph->textures[t];
+            if (texture->imported || texture->first_use != position) {
+                continue;
+            }
+            graph->transient_count++;
+
+            int32_t found = -1;
+            for (uint32_t e = 0; e < graph->pool_count && found < 0; e++) {
+                const NexusRenderGraphPoolEntry* entry = &graph->pool[e];
+                if (entry->busy_until < position && memcmp(&entry->desc, &texture->desc, sizeof(entry->desc)) == 0 &&
+                    (entry->usage & texture->usage) == texture->usage) {
+                    found = (int32_t)e;
+                }
+            }
+
+            if (found < 0) {
+                if (graph->pool_count >= NEXUS_RENDER_GRAPH_MAX_TEXTURES) {
+                    fprintf(stderr, "Render graph texture pool is full!\n");
+                    return false;
+                }
+                SDL_GPUTextureCreateInfo info = {
+                    .type = SDL_GPU_TEXTURETYPE_2D,
+                    .format = texture->desc.format,
+                    .usage = texture->usage,
+                    .width = texture->desc.width,
+                    .height = texture->desc.height,
+                    .layer_count_or_depth = 1,
+                    .num_levels = 1,
+                    .sample_count = texture->desc.sample_count
+                };
+                SDL_GPUTexture* created = SDL_CreateGPUTexture(graph->device, &info);
+                if (created == NULL) {
+                    fprintf(stderr, "Failed to create render graph texture '%s': %s\n",
+                            texture->name != NULL ? texture->name : "", SDL_GetError());
+                    return false;
+                }
+                NexusRenderGraphPoolEntry* entry = &graph->pool[graph->pool_count];
+                entry->texture = created;
+                entry->desc = texture->desc;
+                entry->usage = texture->usage;
+                found = (int32_t)graph->pool_count++;
+            }
+
+            NexusRenderGraphPoolEntry* entry = &graph->pool[found];
+            entry->busy_until = texture->last_use;
+            entry->last_frame = graph->frame;
+            texture->pool_entry = found;
+            texture->texture = entry->texture;
+        }
+    }
+
+    /* Statistics */
+    graph->physical_count = 0;
+    for (uint32_t e = 0; e < graph->pool_count; e++) {
+        if (graph->pool[e].last_frame == graph->frame) {
+            graph->physical_count++;
+        }
+    }
+    return true;
+}
+
+/**
+ * Cull, order and allocate the frame's passes
+ */
+bool nexus_render_graph_compile(NexusRenderGraph* graph) {
+    if (graph == NULL || graph->failed) {
+        return false;
+    }
+    if (graph->compiled) {
+        return true;
+    }
+
+    nexus_render_graph_cull(graph);
+    if (!nexus_render_graph_sort(graph)) {
+        graph->failed = true;
+        return false;
+    }
+    graph->culled_count = graph->pass_count - graph->order_count;
+
+    nexus_render_graph_derive_ops(graph);
+    if (!nexus_render_graph_allocate(graph)) {
+        graph->failed = true;
+        return false;
+    }
+
+    graph->compiled = true;
+    return true;
+}
+
+/**
+ * Record the frame's passes into a command buffer, compiling first if needed
+ */
+bool nexus_render_graph_execute(NexusRenderGraph* graph, SDL_GPUCommandBuffer* cmd_buffer) {
+    if (graph == NULL || cmd_buffer == NULL || !nexus_render_graph_compile(graph)) {
+        return false;
+    }
+
+    bool success = true;
+    for (uint32_t i = 0; i < graph->order_count; i++) {
+        NexusRenderGraphPass* pass = &graph->passes[graph->order[i]];
+        NexusRenderGraphContext context = {
+            .graph = graph,
+            .cmd_buffer = cmd_buffer,
+            .render_pass = NULL,
+            .pass = graph->order[i]
+        };
+        NEXUS_PROFILE_BEGIN(pass->name != NULL ? pass->name : "RenderGraphPass");
+
+        /* Passes without attachments record their own copy or compute work */
+        if (pass->color_count == 0 && pass->depth.output == NEXUS_RENDER_GRAPH_INVALID) {
+            if (pass->execute != NULL) {
+                pass->execute(&context, pass->user_data);
+            }
+            NEXUS_PROFILE_END();
+            continue;
+        }
+
+        /* Imported textures may be cycled when their old contents are not needed,
+         * pooled ones stay put so the transients sharing them really share memory */
+        SDL_GPUColorTargetInfo colors[NEXUS_RENDER_GRAPH_MAX_COLORS];
+        memset(colors, 0, sizeof(colors));
+        for (uint32_t c = 0; c < pass->color_count; c++) {
+            const NexusRenderGraphAttachment* attachment = &pass->colors[c];
+            const NexusRenderGraphTexture* texture = &graph->textures[graph->versions[attachment->output - 1].texture];
+            colors[c].texture = texture->texture;
+            colors[c].clear_color = attachment->clear_color;
+            colors[c].load_op = attachment->load_op;
+            colors[c].store_op = attachment->store_op;
+            colors[c].cycle = texture->imported && attachment->load_op != SDL_GPU_LOADOP_LOAD;
+        }
+
+        SDL_GPUDepthStencilTargetInfo depth;
+        memset(&depth, 0, sizeof(depth));
+        bool has_depth = pass->depth.output != NEXUS_RENDER_GRAPH_INVALID;
+        if (has_depth) {
+            const NexusRenderGraphTexture* texture = &graph->textures[graph->versions[pass->depth.output - 1].texture];
+            depth.texture = texture->texture;
+            depth.clear_depth = pass->depth.clear_depth;
+            depth.load_op = pass->depth.load_op;
+            depth.store_op = pass->depth.store_op;
+            depth.stencil_load_op = SDL_GPU_LOADOP_DONT_CARE;
+            depth.stencil_store_op = SDL_GPU_STOREOP_DONT_CARE;
+            depth.cycle = texture->imported && pass->depth.load_op != SDL_GPU_LOADOP_LOAD;
+        }
+
+        context.render_pass = SDL_BeginGPURenderPass(cmd_buffer, colors, pass->color_count,
+                                                     has_depth ? &depth : NULL);
+        if (context.render_pass == NULL) {
+            fprintf(stderr, "Failed to begin render graph pass '%s': %s\n",
+                    pass->name != NULL ? pass->name : "", SDL_GetError());
+            success = false;
+            NEXUS_PROFILE_END();
+            continue;
+        }
+        if (pass->execute != NULL) {
+            pass->execute(&context, pass->user_data);
+        }
+        SDL_EndGPURenderPass(context.render_pass);
+        NEXUS_PROFILE_END();
+    }
+
+    return success;
+}
+
+/**
+ * Get the newest version of a texture declared so far
+ */
+NexusRenderGraphResource nexus_render_graph_get_latest(const NexusRenderGraph* graph,
+                                                       NexusRenderGraphResource resource) {
+    if (graph == NULL || resource == NEXUS_RENDER_GRAPH_INVALID || resource > graph->version_count) {
+        return NEXUS_RENDER_GRAPH_INVALID;
+    }
+
+    /* Versions of a texture are created in write order */
+    uint32_t texture = graph->versions[resource - 1].texture;
+    for (uint32_t i = graph->version_count; i > resource; i--) {
+        if (graph->versions[i - 1].texture == texture) {
+            return i;
+        }
+    }
+    return resource;
+}
+
+/**
+ * Get the GPU texture of a resource
+ * Transients only have one after the graph was compiled, during execution
+ */
+SDL_GPUTexture* nexus_render_graph_get_texture(const NexusRenderGraph* graph, NexusRenderGraphResource resource) {
+    if (graph == NULL || resource == NEXUS_RENDER_GRAPH_INVALID || resource > graph->version_count) {
+        return NULL;
+    }
+
+    return graph->textures[graph->versions[resource - 1].texture].texture;
+}
+
+/**
+ * Get the description of a resource's texture
+ */
+const NexusRenderGraphTextureDesc* nexus_render_graph_get_desc(const NexusRenderGraph* graph,
+                                                               NexusRenderGraphResource resource) {
+    if (graph == NULL || resource == NEXUS_RENDER_GRAPH_INVALID || resource > graph->version_count) {
+        return NULL;
+    }
+
+    return &graph->textures[graph->versions[resource - 1].texture].desc;
+}
@@ -0,0 +1,360 @@
+/**
+ * Nexus3D Render Queue Implementation
+ * Draw key packing and radix sorting of per-frame draw commands
+ */
+
+#include "nexus3d/renderer/render_queue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Below this many commands an insertion sort beats the radix passes */
+#define NEXUS_RENDER_QUEUE_SMALL_SORT 64
+
+/* Bit masks of the key fields */
+#define NEXUS_DRAW_KEY_MASK(bits) ((1ull << (bits)) - 1ull)
+
+/**
+ * Grow the command and sort buffers to hold at least the given capacity
+ */
+static bool nexus_render_queue_reserve(NexusRenderQueue* queue, uint32_t capacity) {
+    if (capacity <= queue->capacity) {
+        return true;
+    }
+
+    /* Grow geometrically */
+    uint32_t new_capacity = queue->capacity > 0 ? queue->capacity : 256;
+    while (new_capacity < capacity) {
+        new_capacity *= 2;
+    }
+
+    NexusDrawCommand* commands = (NexusDrawCommand*)realloc(queue->commands,
+                                                            sizeof(NexusDrawCommand) * new_capacity);
+    if (commands == NULL) {
+        fprintf(stderr, "Failed to grow render queue!\n");
+        return false;
+    }
+    queue->commands = commands;
+
+    /* Sort scratch does not need to keep its contents */
+    for (int i = 0; i < 2; i++) {
+        free(queue->sort_keys[i]);
+        free(queue->sort_indices[i]);
+        queue->sort_keys[i] = (uint64_t*)malloc(sizeof(uint64_t) * new_capacity);
+        queue->sort_indices[i] = (uint32_t*)malloc(sizeof(uint32_t) * new_capacity);
+        if (queue->sort_keys[i] == NULL || queue->sort_indices[i] == NULL) {
+            fprintf(stderr, "Failed to allocate render queue sort buffers!\n");
+            return false;
+        }
+    }
+
+    queue->sorted = queue->sort_indices[0];
+    queue->capacity = new_capacity;
+    return true;
+}
+
+/**
+ * Hashed id for pointers past the dense range, never 0 (reserved for NULL)
+ */
+static uint32_t nexus_render_queue_hashed_id(uint64_t hash, uint32_t max_id) {
+    uint32_t id = (uint32_t)(hash >> 48) & max_id;
+    return id != 0 ? id : 1;
+}
+
+/**
+ * Map a pointer to a dense id that is stable for the current frame
+ */
+static uint32_t nexus_render_queue_intern(NexusRenderQueueIdTable* table, const void* ptr,
+                                          uint32_t stamp, uint32_t max_id) {
+    if (ptr == NULL) {
+        return 0;
+    }
+
+    /* Fibonacci hash of the pointer */
+    uint64_t hash = (uint64_t)(uintptr_t)ptr * 0x9E3779B97F4A7C15ull;
+    uint32_t mask = NEXUS_RENDER_QUEUE_ID_TABLE_SIZE - 1;
+    uint32_t slot = (uint32_t)(hash >> 40) & mask;
+
+    /* Linear probe */
+    for (uint32_t probe = 0; probe < NEXUS_RENDER_QUEUE_ID_TABLE_SIZE; probe++) {
+        if (table->stamps[slot] != stamp) {
+            /* Free slot for this frame, hand out the next id (0 is reserved for NULL) */
+            table->stamps[slot] = stamp;
+            table->keys[slot] = ptr;
+            table->count++;
+            table->ids[slot] = table->count <= max_id ? table->count : nexus_render_queue_hashed_id(hash, max_id);
+            return table->ids[slot];
+        }
+
+        if (table->keys[slot] == ptr) {
+            return table->ids[slot];
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    /* Table is full, fall back to hashed ids (only costs extra state changes) */
+    return nexus_render_queue_hashed_id(hash, max_id);
+}
+
+/**
+ * Create a render queue
+ */
+NexusRenderQueue* nexus_render_queue_create(uint32_t initial_capacity) {
+    /* Allocate queue structure */
+    NexusRenderQueue* queue = (NexusRenderQueue*)malloc(sizeof(NexusRenderQueue));
+    if (queue == NULL) {
+        fprintf(stderr, "Failed to allocate memory for render queue!\n");
+        return NULL;
+    }
+
+    /* Initialize queue structure */
+    memset(queue, 0, sizeof(NexusRenderQueue));
+    queue->frame_stamp = 1;
+
+    /* Allocate initial storage */
+    if (!nexus_render_queue_reserve(queue, initial_capacity > 0 ? initial_capacity : 256)) {
+        nexus_render_queue_destroy(queue);
+        return NULL;
+    }
+
+    return queue;
+}
+
+/**
+ * Destroy a render queue
+ */
+void nexus_render_queue_destroy(NexusRenderQueue* queue) {
+    if (queue == NULL) {
+        return;
+    }
+
+    /* Free storage */
+    free(queue->commands);
+    for (int i = 0; i < 2; i++) {
+        free(queue->sort_keys[i]);
+        free(queue->sort_indices[i]);
+    }
+
+    /* Free queue structure */
+    free(queue);
+}
+
+/**
+ * Reset the queue for a new frame
+ */
+void nexus_render_queue_reset(NexusRenderQueue* queue) {
+    if (queue == NULL) {
+        return;
+    }
+
+    queue->count = 0;
+    queue->opaque_count = 0;
+    queue->is_sorted = true;
+
+    /* Advancing the stamp invalidates all interned ids without clearing the tables */
+    queue->frame_stamp++;
+    if (queue->frame_stamp == 0) {
+        memset(queue->pipelines.stamps, 0, sizeof(queue->pipelines.stamps));
+        memset(queue->materials.stamps, 0, sizeof(queue->materials.stamps));
+        memset(queue->meshes.stamps, 0, sizeof(queue->meshes.stamps));
+        queue->frame_stamp = 1;
+    }
+    queue->pipelines.count = 0;
+    queue->materials.count = 0;
+    queue->meshes.count = 0;
+}
+
+/**
+ * Submit a draw command to the queue
+ * Depth is the normalized [0,1] view distance of the object. Each detail
+ * level of a mesh counts as its own mesh, so equal levels sort together
+ */
+bool nexus_render_queue_submit(NexusRenderQueue* queue, NexusMesh* mesh, uint32_t lod, NexusMaterial* material,
+                               NexusShader* shader, SDL_GPUGraphicsPipeline* pipeline,
+                               const float* transform, float depth) {
+    if (queue == NULL || mesh == NULL || shader == NULL || pipeline == NULL) {
+        return false;
+    }
+
+    uint32_t lod_count = nexus_mesh_get_lod_count(mesh);
+    if (lod >= lod_count) {
+        lod = lod_count - 1;
+    }
+
+    if (!nexus_render_queue_reserve(queue, queue->count + 1)) {
+        return false;
+    }
+
+    /* Quantize depth */
+    if (depth < 0.0f) depth = 0.0f;
+    if (depth > 1.0f) depth = 1.0f;
+    uint64_t depth_bits = (uint64_t)(depth * (float)NEXUS_DRAW_KEY_MASK(NEXUS_DRAW_KEY_DEPTH_BITS));
+
+    /* Dense state ids */
+    uint64_t pipeline_id = nexus_render_queue_intern(&queue->pipelines, pipeline, queue->frame_stamp,
+                                                     (uint32_t)NEXUS_DRAW_KEY_MASK(NEXUS_DRAW_KEY_PIPELINE_BITS));
+    uint64_t material_id = nexus_render_queue_intern(&queue->materials, material, queue->frame_stamp,
+                                                     (uint32_t)NEXUS_DRAW_KEY_MASK(NEXUS_DRAW_KEY_MATERIAL_BITS));
+    const void* mesh_key = lod > 0 ? (const void*)&mesh->lods[lod] : (const void*)mesh;
+    uint64_t mesh_id = nexus_render_queue_intern(&queue->meshes, mesh_key, queue->frame_stamp,
+                                                 (uint32_t)NEXUS_DRAW_KEY_MASK(NEXUS_DRAW_KEY_MESH_BITS));
+
+    /* Pack the key */
+    uint64_t key;
+    if (material != NULL && material->blend_mode != NEXUS_BLEND_MODE_OPAQUE) {
+        uint64_t inverted_depth = NEXUS_DRAW_KEY_MASK(NEXUS_DRAW_KEY_DEPTH_BITS) - depth_bits;
+        key = (1ull << 63) |
+              (inverted_depth << 43) |
+              (pipeline_id << 32) |
+              (material_id << 16) |
+              mesh_id;
+    } else {
+        /* Buckets follow sqrt(depth) so near geometry, which occludes the most, is split finest */
+        uint64_t bucket = (uint64_t)(sqrtf(depth) * (float)NEXUS_DRAW_KEY_MASK(NEXUS_DRAW_KEY_DEPTH_BUCKET_BITS));
+        uint64_t fine_depth = depth_bits >> (NEXUS_DRAW_KEY_DEPTH_BITS - NEXUS_DRAW_KEY_OPAQUE_DEPTH_BITS);
+        key = (bucket << 59) |
+              (pipeline_id << 48) |
+              (material_id << 32) |
+              (mesh_id << 16) |
+              fine_depth;
+        queue->opaque_count++;
+    }
+
+    /* Record the command */
+    NexusDrawCommand* cmd = &queue->commands[queue->count++];
+    cmd->key = key;
+    cmd->mesh = mesh;
+    cmd->lod = lod;
+    cmd->material = material;
+    cmd->shader = shader;
+    cmd->pipeline = pipeline;
+    if (transform != NULL) {
+        memcpy(cmd->transform, transform, sizeof(cmd->transform));
+    } else {
+        memset(cmd->transform, 0, sizeof(cmd->transform));
+        cmd->transform[0] = cmd->transform[5] = cmd->transform[10] = cmd->transform[15] = 1.0f;
+    }
+
+    queue->is_sorted = false;
+    return true;
+}
+
+/**
+ * Sort the queue by draw key (LSD radix sort, 8 bits per pass)
+ */
+void nexus_render_queue_sort(NexusRenderQueue* queue) {
+    if (queue == NULL || queue->is_sorted) {
+        return;
+    }
+
+    uint32_t count = queue->count;
+    uint64_t* keys = queue->sort_keys[0];
+    uint32_t* indices = queue->sort_indices[0];
+
+    /* Gather keys */
+    for (uint32_t i = 0; i < count; i++) {
+        keys[i] = queue->commands[i].key;
+        indices[i] = i;
+    }
+
+    /* Small queues use insertion sort */
+    if (count <= NEXUS_RENDER_QUEUE_SMALL_SORT) {
+        for (uint32_t i = 1; i < count; i++) {
+            uint64_t key = keys[i];
+            uint32_t index = indices[i];
+            uint32_t j = i;
+            while (j > 0 && keys[j - 1] > key) {
+                keys[j] = keys[j - 1];
+                indices[j] = indices[j - 1];
+                j--;
+            }
+            keys[j] = key;
+            indices[j] = index;
+        }
+        queue->sorted = indices;
+        queue->is_sorted = true;
+        return;
+    }
+
+    /* Build all eight byte histograms in a single pass */
+    uint32_t histograms[8][256];
+    memset(histograms, 0, sizeof(histograms));
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t key = keys[i];
+        for (int pass = 0; pass < 8; pass++) {
+            histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+        }
+    }
+
+    /* Scatter passes, ping-ponging between the two buffers */
+    int src = 0;
+    for (int pass = 0; pass < 8; pass++) {
+        uint32_t* histogram = histograms[pass];
+
+        /* Skip passes where every key shares the same byte */
+        uint32_t first_byte = (uint32_t)(queue->sort_keys[src][0] >> (pass * 8)) & 0xFF;
+        if (histogram[first_byte] == count) {
+            continue;
+        }
+
+        /* Exclusive prefix sum */
+        uint32_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            uint32_t bucket = histogram[b];
+            histogram[b] = offset;
+            offset += bucket;
+        }
+
+        /* Scatter */
+        uint64_t* src_keys = queue->sort_keys[src];
+        uint32_t* src_indices = queue->sort_indices[src];
+        uint64_t* dst_keys = queue->sort_keys[src ^ 1];
+        uint32_t* dst_indices = queue->sort_indices[src ^ 1];
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t byte = (uint32_t)(src_keys[i] >> (pass * 8)) & 0xFF;
+            uint32_t dst = histogram[byte]++;
+            dst_keys[dst] = src_keys[i];
+            dst_indices[dst] = src_indices[i];
+        }
+
+        src ^= 1;
+    }
+
+    queue->sorted = queue->sort_indices[src];
+    queue->is_sorted = true;
+}
+
+/**
+ * Get the number of commands in the queue
+ */
+uint32_t nexus_render_queue_get_count(const NexusRenderQueue* queue) {
+    if (queue == NULL) {
+        return 0;
+    }
+
+    return queue->count;
+}
+
+/**
+ * Get the number of opaque commands, they occupy the start of the sorted order
+ */
+uint32_t nexus_render_queue_get_opaque_count(const NexusRenderQueue* queue) {
+    if (queue == NULL) {
+        return 0;
+    }
+
+    return queue->opaque_count;
+}
+
+/**
+ * Get a command in sorted order (call nexus_render_queue_sort first)
+ */
+const NexusDrawCommand* nexus_render_queue_get_sorted(const NexusRenderQueue* queue, uint32_t index) {
+    if (queue == NULL || index >= queue->count) {
+        return NULL;
+    }
+
+    return &queue->commands[queue->sorted[index]];
+}
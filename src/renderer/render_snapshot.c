@@ -0,0 +1,232 @@
+/**
+ * Nexus3D Render Snapshot Implementation
+ * Extracted frame contents replayed by the renderer
+ */
+
+#include "nexus3d/renderer/render_snapshot.h"
+#include "nexus3d/math/math_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Make room for one more element of an array, doubling its capacity
+ */
+static bool nexus_render_snapshot_reserve(void** array, uint32_t* capacity, uint32_t count, size_t element_size) {
+    if (count < *capacity) {
+        return true;
+    }
+
+    uint32_t new_capacity = *capacity > 0 ? *capacity * 2 : 64;
+    void* grown = realloc(*array, element_size * new_capacity);
+    if (grown == NULL) {
+        fprintf(stderr, "Failed to grow render snapshot!\n");
+        return false;
+    }
+
+    *array = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+/**
+ * Create a render snapshot
+ * draw_capacity draws fit before the snapshot grows (0 = NEXUS_RENDER_SNAPSHOT_INITIAL_DRAWS)
+ */
+NexusRenderSnapshot* nexus_render_snapshot_create(uint32_t draw_capacity) {
+    /* Allocate snapshot structure */
+    NexusRenderSnapshot* snapshot = (NexusRenderSnapshot*)malloc(sizeof(NexusRenderSnapshot));
+    if (snapshot == NULL) {
+        fprintf(stderr, "Failed to allocate memory for render snapshot!\n");
+        return NULL;
+    }
+
+    /* Initialize snapshot structure */
+    memset(snapshot, 0, sizeof(NexusRenderSnapshot));
+
+    /* Casters and lights start small, they grow with the scene like the draws */
+    snapshot->draw_capacity = draw_capacity > 0 ? draw_capacity : NEXUS_RENDER_SNAPSHOT_INITIAL_DRAWS;
+    snapshot->caster_capacity = snapshot->draw_capacity / 4 > 0 ? snapshot->draw_capacity / 4 : 1;
+    snapshot->light_capacity = 64;
+    snapshot->draws = (NexusSnapshotDraw*)malloc(sizeof(NexusSnapshotDraw) * snapshot->draw_capacity);
+    snapshot->casters = (NexusSnapshotCaster*)malloc(sizeof(NexusSnapshotCaster) * snapshot->caster_capacity);
+    snapshot->lights = (NexusSnapshotLight*)malloc(sizeof(NexusSnapshotLight) * snapshot->light_capacity);
+    if (snapshot->draws == NULL || snapshot->casters == NULL || snapshot->lights == NULL) {
+        fprintf(stderr, "Failed to allocate memory for render snapshot contents!\n");
+        nexus_render_snapshot_destroy(snapshot);
+        return NULL;
+    }
+
+    return snapshot;
+}
+
+/**
+ * Destroy a render snapshot
+ */
+void nexus_render_snapshot_destroy(NexusRenderSnapshot* snapshot) {
+    if (snapshot == NULL) {
+        return;
+    }
+
+    free(snapshot->draws);
+    free(snapshot->casters);
+    free(snapshot->lights);
+    free(snapshot);
+}
+
+/**
+ * Empty a snapshot for the extraction of a new frame, keeping its memory
+ */
+void nexus_render_snapshot_reset(NexusRenderSnapshot* snapshot, uint64_t frame) {
+    if (snapshot == NULL) {
+        return;
+    }
+
+    snapshot->has_camera = false;
+    snapshot->source_camera = NULL;
+    snapshot->draw_count = 0;
+    snapshot->caster_count = 0;
+    snapshot->light_count = 0;
+    snapshot->frame = frame;
+    snapshot->visible_count = 0;
+    snapshot->culled_count = 0;
+}
+
+/**
+ * Set the view of the snapshot
+ * The camera is copied with up to date matrices, later changes to it apply to
+ * the next snapshot only
+ */
+void nexus_render_snapshot_set_camera(NexusRenderSnapshot* snapshot, NexusCamera* camera) {
+    if (snapshot == NULL) {
+        return;
+    }
+
+    if (camera == NULL) {
+        snapshot->has_camera = false;
+        snapshot->source_camera = NULL;
+        return;
+    }
+
+    snapshot->camera = *camera;
+    snapshot->source_camera = camera;
+    snapshot->has_camera = true;
+    nexus_camera_update(&snapshot->camera);
+
+    /* Draws are culled against the copy during extraction */
+    mat4 view_projection;
+    nexus_camera_get_view_projection_matrix(&snapshot->camera, (float*)view_projection);
+    nexus_frustum_from_viewproj(view_projection, snapshot->frustum_planes);
+}
+
+/**
+ * Set the viewport size detail levels are selected for
+ */
+void nexus_render_snapshot_set_viewport(NexusRenderSnapshot* snapshot, uint32_t width, uint32_t height) {
+    if (snapshot == NULL) {
+        return;
+    }
+
+    snapshot->viewport_width = width;
+    snapshot->viewport_height = height;
+}
+
+/**
+ * Add a draw, its transform is copied
+ */
+bool nexus_render_snapshot_add_draw(NexusRenderSnapshot* snapshot, NexusMesh* mesh, uint32_t lod,
+                                    NexusMaterial* material, const float* transform) {
+    if (snapshot == NULL || mesh == NULL || transform == NULL) {
+        return false;
+    }
+
+    if (!nexus_render_snapshot_reserve((void**)&snapshot->draws, &snapshot->draw_capacity,
+                                       snapshot->draw_count, sizeof(NexusSnapshotDraw))) {
+        return false;
+    }
+
+    NexusSnapshotDraw* draw = &snapshot->draws[snapshot->draw_count++];
+    draw->mesh = mesh;
+    draw->material = material;
+    draw->lod = lod;
+    memcpy(draw->transform, transform, sizeof(draw->transform));
+    return true;
+}
+
+/**
+ * Add a shadow caster with its world bounds, its transform is copied
+ */
+bool nexus_render_snapshot_add_caster(NexusRenderSnapshot* snapshot, NexusMesh* mesh, uint32_t lod,
+                                      NexusMaterial* material, const float* transform,
+                                      const float* world_min, const float* world_max) {
+    if (snapshot == NULL || mesh == NULL || transform == NULL || world_min == NULL || world_max == NULL) {
+        return false;
+    }
+
+    if (!nexus_render_snapshot_reserve((void**)&snapshot->casters, &snapshot->caster_capacity,
+                                       snapshot->caster_count, sizeof(NexusSnapshotCaster))) {
+        return false;
+    }
+
+    NexusSnapshotCaster* caster = &snapshot->casters[snapshot->caster_count++];
+    caster->mesh = mesh;
+    caster->material = material;
+    caster->lod = lod;
+    memcpy(caster->transform, transform, sizeof(caster->transform));
+    memcpy(caster->world_min, world_min, sizeof(caster->world_min));
+    memcpy(caster->world_max, world_max, sizeof(caster->world_max));
+    return true;
+}
+
+/**
+ * Add a light
+ * Shadowed lights keep their id (an entity id, never 0) so their shadow maps stay cached
+ */
+bool nexus_render_snapshot_add_light(NexusRenderSnapshot* snapshot, const NexusLightData* light, bool shadowed,
+                                     uint64_t id, uint32_t resolution) {
+    if (snapshot == NULL || light == NULL) {
+        return false;
+    }
+
+    /* The renderer's light limit applies when the snapshot is replayed */
+    if (snapshot->light_count >= NEXUS_MAX_LIGHTS) {
+        return false;
+    }
+
+    if (!nexus_render_snapshot_reserve((void**)&snapshot->lights, &snapshot->light_capacity,
+                                       snapshot->light_count, sizeof(NexusSnapshotLight))) {
+        return false;
+    }
+
+    NexusSnapshotLight* entry = &snapshot->lights[snapshot->light_count++];
+    entry->data = *light;
+    entry->id = id;
+    entry->resolution = resolution;
+    entry->shadowed = shadowed;
+    return true;
+}
+
+/**
+ * Remove the lights added so far
+ */
+void nexus_render_snapshot_clear_lights(NexusRenderSnapshot* snapshot) {
+    if (snapshot == NULL) {
+        return;
+    }
+
+    snapshot->light_count = 0;
+}
+
+/**
+ * Get the memory held by a snapshot in bytes
+ */
+size_t nexus_render_snapshot_get_memory_size(const NexusRenderSnapshot* snapshot) {
+    if (snapshot == NULL) {
+        return 0;
+    }
+
+    return sizeof(NexusRenderSnapshot) +
+           sizeof(NexusSnapshotDraw) * snapshot->draw_capacity +
+           sizeof(NexusSnapshotCaster) * snapshot->caster_capacity +
+           sizeof(NexusSnapshotLight) * snapshot->light_capacity;
+}
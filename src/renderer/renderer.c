@@ -5,6 +5,8 @@
 
 #include "nexus3d/renderer/renderer.h"
 #include "nexus3d/utils/logger.h"
+#include "nexus3d/utils/profiler.h"
+#include "nexus3d/math/math_utils.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -19,9 +21,10 @@
 #define NEXUS_LOG_GPU_DRIVER(renderer)
 #endif
 
-/* Initialize GPU device */
+/* Initialize GPU device
+ * config is updated to the composition and present mode the swapchain ended up with */
 static SDL_GPUDevice* nexus_renderer_init_gpu(NexusWindow* window,
-                                           const NexusRendererConfig* config,
+                                           NexusRendererConfig* config,
                                            NexusRendererCaps* caps) {
     /* Check for null parameters */
     if (window == NULL || config == NULL || caps == NULL) {
@@ -59,6 +62,8 @@ static SDL_GPUDevice* nexus_renderer_init_gpu(NexusWindow* window,
     // We'll assume compute is supported for now
     caps->supports_compute = true;
     caps->supports_hdr = true;
+    /* SDL_GPU has no timestamp queries, frames are timed through fences */
+    caps->supports_timestamps = false;
     caps->max_texture_size = 4096;
     caps->max_texture_array_layers = 256;
 
@@ -71,9 +76,7 @@ static SDL_GPUDevice* nexus_renderer_init_gpu(NexusWindow* window,
 
     /* Set swapchain parameters */
     SDL_GPUSwapchainComposition composition = config->composition_mode;
-    SDL_GPUPresentMode present_mode = config->enable_vsync ?
-        SDL_GPU_PRESENTMODE_VSYNC : SDL_GPU_PRESENTMODE_MAILBOX;
-// printf("FUCK");
+    SDL_GPUPresentMode present_mode = config->present_mode;
     /* Check if the requested modes are supported */
     if (!SDL_WindowSupportsGPUSwapchainComposition(device, window->sdl_window, composition)) {
         fprintf(stderr, "Warning: Requested swapchain composition mode not supported, using default\n");
@@ -83,7 +86,7 @@ static SDL_GPUDevice* nexus_renderer_init_gpu(NexusWindow* window,
 
 
     if (!SDL_WindowSupportsGPUPresentMode(device, window->sdl_window, present_mode)) {
-        fprintf(stderr, "Warning: Requested present mode not supported, using FIFO\n");
+        fprintf(stderr, "Warning: Requested present mode not supported, using VSYNC\n");
         present_mode = SDL_GPU_PRESENTMODE_VSYNC;
     }
 
@@ -95,12 +98,295 @@ static SDL_GPUDevice* nexus_renderer_init_gpu(NexusWindow* window,
         return NULL;
     }
 
-    /* Set maximum frames in flight to 2 (double buffering) */
-    SDL_SetGPUAllowedFramesInFlight(device, 2);
+    /* Fewer frames in flight shorten the time from input to present, more absorb spikes */
+    if (!SDL_SetGPUAllowedFramesInFlight(device, config->frames_in_flight)) {
+        fprintf(stderr, "Warning: Failed to set frames in flight: %s\n", SDL_GetError());
+    }
+
+    config->composition_mode = composition;
+    config->present_mode = present_mode;
 
     return device;
 }
 
+/**
+ * Push the per-frame uniform block (camera and time) once for the frame
+ */
+static void nexus_renderer_push_frame_uniforms(NexusRenderer* renderer) {
+    NexusFrameUniforms frame;
+    memset(&frame, 0, sizeof(frame));
+
+    /* Camera matrices (camera was updated in begin_frame) */
+    if (renderer->frame_camera != NULL) {
+        nexus_camera_get_view_matrix(renderer->frame_camera, frame.view);
+        nexus_camera_get_projection_matrix(renderer->frame_camera, frame.projection);
+        nexus_camera_get_view_projection_matrix(renderer->frame_camera, frame.view_projection);
+        nexus_camera_get_position(renderer->frame_camera, &frame.camera_position[0],
+                                  &frame.camera_position[1], &frame.camera_position[2]);
+        frame.camera_position[3] = 1.0f;
+    }
+
+    /* Time */
+    frame.time[0] = (float)SDL_GetTicks() / 1000.0f;
+    frame.time[1] = (float)(renderer->frame_time / 1000.0);
+
+    /* Cluster lookup, the slices match the last cluster build */
+    const NexusLightClusters* clusters = renderer->light_clusters;
+    if (clusters != NULL && renderer->swapchain_width > 0 && renderer->swapchain_height > 0) {
+        frame.cluster_scale[0] = (float)NEXUS_CLUSTER_GRID_X / (float)renderer->swapchain_width;
+        frame.cluster_scale[1] = (float)NEXUS_CLUSTER_GRID_Y / (float)renderer->swapchain_height;
+        frame.cluster_scale[2] = clusters->slice_scale;
+        frame.cluster_scale[3] = clusters->slice_bias;
+        frame.cluster_info[0] = clusters->directional_count;
+        frame.cluster_info[1] = clusters->light_count;
+        frame.cluster_info[2] = renderer->light_heatmap ? NEXUS_CLUSTER_FLAG_HEATMAP : 0u;
+    }
+
+    /* Uniform data persists across pipeline binds for the rest of the command buffer */
+    SDL_PushGPUVertexUniformData(renderer->cmd_buffer, NEXUS_UNIFORM_SLOT_VERTEX_FRAME, &frame, sizeof(frame));
+    SDL_PushGPUFragmentUniformData(renderer->cmd_buffer, NEXUS_UNIFORM_SLOT_FRAGMENT_FRAME, &frame, sizeof(frame));
+}
+
+/**
+ * Pick the most precise depth format the device can render to
+ */
+static SDL_GPUTextureFormat nexus_renderer_choose_depth_format(SDL_GPUDevice* device) {
+    static const SDL_GPUTextureFormat s_depth_formats[] = {
+        SDL_GPU_TEXTUREFORMAT_D32_FLOAT,
+        SDL_GPU_TEXTUREFORMAT_D24_UNORM,
+        SDL_GPU_TEXTUREFORMAT_D16_UNORM
+    };
+
+    for (size_t i = 0; i < sizeof(s_depth_formats) / sizeof(s_depth_formats[0]); i++) {
+        if (SDL_GPUTextureSupportsFormat(device, s_depth_formats[i], SDL_GPU_TEXTURETYPE_2D,
+                                         SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET)) {
+            return s_depth_formats[i];
+        }
+    }
+
+    return SDL_GPU_TEXTUREFORMAT_INVALID;
+}
+
+/**
+ * Make sure the depth target matches the swapchain size, recreating it if needed
+ */
+static bool nexus_renderer_ensure_depth_target(NexusRenderer* renderer) {
+    if (renderer->depth_format == SDL_GPU_TEXTUREFORMAT_INVALID) {
+        return false;
+    }
+
+    if (renderer->depth_texture != NULL &&
+        renderer->depth_width == renderer->swapchain_width &&
+        renderer->depth_height == renderer->swapchain_height) {
+        return true;
+    }
+
+    /* The old target is released once frames still using it have finished */
+    if (renderer->depth_texture != NULL) {
+        SDL_ReleaseGPUTexture(renderer->gpu_device, renderer->depth_texture);
+        renderer->depth_texture = NULL;
+    }
+
+    if (renderer->swapchain_width == 0 || renderer->swapchain_height == 0) {
+        return false;
+    }
+
+    SDL_GPUTextureCreateInfo info = {
+        .type = SDL_GPU_TEXTURETYPE_2D,
+        .format = renderer->depth_format,
+        .usage = SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET,
+        .width = renderer->swapchain_width,
+        .height = renderer->swapchain_height,
+        .layer_count_or_depth = 1,
+        .num_levels = 1,
+        .sample_count = SDL_GPU_SAMPLECOUNT_1
+    };
+
+    renderer->depth_texture = SDL_CreateGPUTexture(renderer->gpu_device, &info);
+    if (renderer->depth_texture == NULL) {
+        fprintf(stderr, "Failed to create depth buffer: %s\n", SDL_GetError());
+        return false;
+    }
+
+    renderer->depth_width = renderer->swapchain_width;
+    renderer->depth_height = renderer->swapchain_height;
+    return true;
+}
+
+/**
+ * Normalized view distance of a transform's origin, used for depth ordering
+ */
+static float nexus_renderer_get_view_depth(const NexusRenderer* renderer, const float* transform) {
+    if (renderer->frame_camera == NULL || transform == NULL) {
+        return 0.0f;
+    }
+
+    vec3 eye, center;
+    nexus_camera_get_position(renderer->frame_camera, &eye[0], &eye[1], &eye[2]);
+    center[0] = transform[12];
+    center[1] = transform[13];
+    center[2] = transform[14];
+
+    float far_plane = renderer->frame_camera->far_plane;
+    return far_plane > 0.0f ? glm_vec3_distance(eye, center) / far_plane : 0.0f;
+}
+
+/**
+ * Bind a pipeline variant in the frame pass if it is not already bound
+ */
+static void nexus_renderer_bind_pipeline(NexusRenderer* renderer, NexusShader* shader,
+                                         SDL_GPUGraphicsPipeline* pipeline) {
+    if (renderer->bound_pipeline != pipeline) {
+        SDL_BindGPUGraphicsPipeline(renderer->render_pass, pipeline);
+        renderer->bound_pipeline = pipeline;
+        renderer->pipeline_binds++;
+    }
+
+    /* Variants of one shader share its uniform blocks, only a new shader restores its own */
+    if (renderer->bound_shader != shader) {
+        nexus_shader_push_uniforms(shader, renderer->cmd_buffer, true);
+
+        /* Material parameters have to be reapplied for the new shader */
+        renderer->bound_shader = shader;
+        renderer->bound_material = NULL;
+    }
+}
+
+/**
+ * Resolve the pipeline variant for a draw and record it into the queue
+ */
+static bool nexus_renderer_queue_draw(NexusRenderer* renderer, NexusMesh* mesh, uint32_t lod,
+                                      NexusMaterial* material, NexusShader* shader, const float* transform) {
+    /* Lazily created on first use, prewarm the cache at load time to avoid the hitch */
+    NexusPipelineState state;
+    nexus_pipeline_cache_get_state(renderer->pipeline_cache, material, &state);
+    state.vertex_layout = nexus_mesh_get_vertex_layout(mesh);
+
+    /* Opaque depth is already laid down by the prepass, shading only touches visible fragments */
+    if (renderer->depth_prepass && state.blend_mode == NEXUS_BLEND_MODE_OPAQUE) {
+        state.depth_write = false;
+        state.depth_compare = SDL_GPU_COMPAREOP_LESS_OR_EQUAL;
+    }
+
+    SDL_GPUGraphicsPipeline* pipeline = nexus_pipeline_cache_acquire(renderer->pipeline_cache, shader, &state);
+    if (pipeline == NULL) {
+        return false;
+    }
+
+    return nexus_render_queue_submit(renderer->render_queue, mesh, lod, material, shader, pipeline, transform,
+                                     nexus_renderer_get_view_depth(renderer, transform));
+}
+
+/**
+ * Bind a mesh's buffers in the frame pass if they are not already bound
+ */
+static void nexus_renderer_bind_mesh(NexusRenderer* renderer, NexusMesh* mesh) {
+    if (renderer->bound_mesh == mesh) {
+        return;
+    }
+
+    nexus_mesh_bind(mesh, renderer->render_pass);
+    renderer->bound_mesh = mesh;
+    renderer->buffer_binds++;
+}
+
+/**
+ * Make sure an instance buffer can hold the given number of instances
+ */
+static bool nexus_renderer_reserve_instances(NexusRenderer* renderer, SDL_GPUBuffer** buffer,
+                                             uint32_t* buffer_capacity, uint32_t count) {
+    if (count <= *buffer_capacity) {
+        return true;
+    }
+
+    /* Grow geometrically */
+    uint32_t capacity = *buffer_capacity > 0 ? *buffer_capacity : 1024;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+
+    /* Release the old buffer (the GPU keeps it alive until in-flight work is done) */
+    if (*buffer != NULL) {
+        nexus_upload_manager_cancel_buffer(renderer->upload_manager, *buffer);
+        SDL_ReleaseGPUBuffer(renderer->gpu_device, *buffer);
+        *buffer = NULL;
+    }
+    *buffer_capacity = 0;
+
+    /* Instance data is read as a vertex stream and by shaders as a storage buffer */
+    SDL_GPUBufferCreateInfo buffer_info = {
+        .usage = SDL_GPU_BUFFERUSAGE_VERTEX | SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ,
+        .size = capacity * (uint32_t)NEXUS_SHADER_INSTANCE_STRIDE
+    };
+    *buffer = SDL_CreateGPUBuffer(renderer->gpu_device, &buffer_info);
+    if (*buffer == NULL) {
+        fprintf(stderr, "Failed to create instance buffer: %s\n", SDL_GetError());
+        return false;
+    }
+
+    *buffer_capacity = capacity;
+    return true;
+}
+
+/**
+ * Write the sorted queue's transforms into the instance buffer
+ * The transforms are staged in the upload ring and copied with the next
+ * upload batch, which is submitted ahead of the frame's command buffer
+ */
+static bool nexus_renderer_upload_instances(NexusRenderer* renderer, NexusRenderQueue* queue, uint32_t count) {
+    if (!nexus_renderer_reserve_instances(renderer, &renderer->instance_buffer, &renderer->instance_capacity, count)) {
+        return false;
+    }
+
+    /* Cycle the buffer, the previous frame may still be reading it. The
+     * simulation thread can upload meanwhile, it must not flush half a copy */
+    nexus_upload_manager_lock(renderer->upload_manager);
+    float* staging = (float*)nexus_upload_manager_begin_buffer(renderer->upload_manager, renderer->instance_buffer, 0,
+                                                               count * (uint32_t)NEXUS_SHADER_INSTANCE_STRIDE, true);
+    if (staging == NULL) {
+        nexus_upload_manager_unlock(renderer->upload_manager);
+        fprintf(stderr, "Failed to stage instance transforms!\n");
+        return false;
+    }
+
+    /* Copy transforms in draw order */
+    for (uint32_t i = 0; i < count; i++) {
+        const NexusDrawCommand* cmd = nexus_render_queue_get_sorted(queue, i);
+        memcpy(staging + i * 16, cmd->transform, NEXUS_SHADER_INSTANCE_STRIDE);
+    }
+    nexus_upload_manager_unlock(renderer->upload_manager);
+
+    return true;
+}
+
+/**
+ * Create the GPU scene with the cull shader at the given path
+ * The shader language follows the file extension
+ */
+static NexusGpuScene* nexus_renderer_create_gpu_scene(NexusRenderer* renderer, const char* cull_shader) {
+    if (cull_shader == NULL || cull_shader[0] == '\0') {
+        fprintf(stderr, "No GPU cull shader configured!\n");
+        return NULL;
+    }
+
+    NexusShaderLanguage language = NEXUS_SHADER_LANGUAGE_SPIRV;
+    const char* extension = strrchr(cull_shader, '.');
+    if (extension != NULL) {
+        if (strcmp(extension, ".msl") == 0 || strcmp(extension, ".metal") == 0) {
+            language = NEXUS_SHADER_LANGUAGE_MSL;
+        } else if (strcmp(extension, ".dxbc") == 0 || strcmp(extension, ".hlsl") == 0) {
+            language = NEXUS_SHADER_LANGUAGE_HLSL;
+        }
+    }
+
+    NexusGpuScene* scene = nexus_gpu_scene_create(renderer->gpu_device);
+    if (scene != NULL && !nexus_gpu_scene_load_cull_shader(scene, language, cull_shader)) {
+        nexus_gpu_scene_destroy(scene);
+        scene = NULL;
+    }
+    return scene;
+}
+
 /**
  * Create a renderer
  */
@@ -138,6 +424,24 @@ NexusRenderer* nexus_renderer_create(NexusWindow* window, const NexusRendererCon
 
     /* Copy configuration */
     renderer->config = *config;
+    if (renderer->config.lod_pixel_error <= 0.0f) {
+        renderer->config.lod_pixel_error = NEXUS_RENDERER_DEFAULT_LOD_PIXEL_ERROR;
+    }
+    if (renderer->config.lod_hysteresis < 0.0f) renderer->config.lod_hysteresis = 0.0f;
+    if (renderer->config.lod_hysteresis > 0.9f) renderer->config.lod_hysteresis = 0.9f;
+    if (renderer->config.shadow_atlas_size == 0) {
+        renderer->config.shadow_atlas_size = NEXUS_SHADOW_ATLAS_DEFAULT_SIZE;
+    }
+    if (renderer->config.shadow_cascades == 0) {
+        renderer->config.shadow_cascades = NEXUS_SHADOW_DEFAULT_CASCADES;
+    }
+    if (renderer->config.shadow_distance <= 0.0f) {
+        renderer->config.shadow_distance = NEXUS_SHADOW_DEFAULT_DISTANCE;
+    }
+    if (renderer->config.frames_in_flight == 0) {
+        renderer->config.frames_in_flight = NEXUS_RENDERER_DEFAULT_FRAMES_IN_FLIGHT;
+    }
+    if (renderer->config.frames_in_flight > 3) renderer->config.frames_in_flight = 3;
 
     /* Set default clear color (dark blue) */
     renderer->clear_color[0] = 0.1f;  /* R */
@@ -154,7 +458,7 @@ NexusRenderer* nexus_renderer_create(NexusWindow* window, const NexusRendererCon
     renderer->window = window->sdl_window;
 
     /* Initialize GPU device and check capabilities */
-    renderer->gpu_device = nexus_renderer_init_gpu(window, config, &renderer->caps);
+    renderer->gpu_device = nexus_renderer_init_gpu(window, &renderer->config, &renderer->caps);
     if (renderer->gpu_device == NULL) {
         fprintf(stderr, "Failed to initialize GPU device!\n");
         free(renderer);
@@ -174,10 +478,138 @@ NexusRenderer* nexus_renderer_create(NexusWindow* window, const NexusRendererCon
     /* Create default shader (will be properly implemented in shader.c) */
     renderer->default_shader = NULL;
 
+    /* Create the shared upload ring, meshes and textures created on this device use it */
+    renderer->upload_manager = nexus_upload_manager_create(renderer->gpu_device, NEXUS_UPLOAD_RING_SIZE);
+    if (renderer->upload_manager == NULL) {
+        fprintf(stderr, "Failed to create upload manager!\n");
+        SDL_ReleaseWindowFromGPUDevice(renderer->gpu_device, window->sdl_window);
+        SDL_DestroyGPUDevice(renderer->gpu_device);
+        free(renderer);
+        return NULL;
+    }
+
+    /* Depth buffer format, the target itself is created with the swapchain size */
+    renderer->depth_format = nexus_renderer_choose_depth_format(renderer->gpu_device);
+    if (renderer->depth_format == SDL_GPU_TEXTUREFORMAT_INVALID) {
+        fprintf(stderr, "No supported depth buffer format, rendering without depth!\n");
+    }
+
+    /* Create the pipeline cache, variants target the swapchain and depth buffer */
+    renderer->pipeline_cache = nexus_pipeline_cache_create(renderer->gpu_device);
+    if (renderer->pipeline_cache == NULL) {
+        fprintf(stderr, "Failed to create pipeline cache!\n");
+        nexus_upload_manager_destroy(renderer->upload_manager);
+        SDL_ReleaseWindowFromGPUDevice(renderer->gpu_device, window->sdl_window);
+        SDL_DestroyGPUDevice(renderer->gpu_device);
+        free(renderer);
+        return NULL;
+    }
+    nexus_pipeline_cache_set_targets(renderer->pipeline_cache, renderer->swapchain_format,
+                                     renderer->depth_format, SDL_GPU_SAMPLECOUNT_1);
+
+    /* Open the shader cache, running without one only costs startup time */
+    if (config->shader_cache_path != NULL) {
+        renderer->shader_cache = nexus_shader_cache_create(renderer->gpu_device, config->shader_cache_path);
+        if (renderer->shader_cache == NULL) {
+            fprintf(stderr, "Failed to open shader cache, continuing without it!\n");
+        }
+    }
+
+    /* Create draw queue */
+    renderer->render_queue = nexus_render_queue_create(1024);
+    if (renderer->render_queue == NULL) {
+        fprintf(stderr, "Failed to create render queue!\n");
+        nexus_shader_cache_destroy(renderer->shader_cache);
+        nexus_pipeline_cache_destroy(renderer->pipeline_cache);
+        nexus_upload_manager_destroy(renderer->upload_manager);
+        SDL_ReleaseWindowFromGPUDevice(renderer->gpu_device, window->sdl_window);
+        SDL_DestroyGPUDevice(renderer->gpu_device);
+        free(renderer);
+        return NULL;
+    }
+
+    /* Create culling buffer */
+    renderer->culling_buffer = nexus_culling_buffer_create(1024);
+    if (renderer->culling_buffer == NULL) {
+        fprintf(stderr, "Failed to create culling buffer!\n");
+        nexus_render_queue_destroy(renderer->render_queue);
+        nexus_shader_cache_destroy(renderer->shader_cache);
+        nexus_pipeline_cache_destroy(renderer->pipeline_cache);
+        nexus_upload_manager_destroy(renderer->upload_manager);
+        SDL_ReleaseWindowFromGPUDevice(renderer->gpu_device, window->sdl_window);
+        SDL_DestroyGPUDevice(renderer->gpu_device);
+        free(renderer);
+        return NULL;
+    }
+
+    /* Create light clusters */
+    renderer->light_clusters = nexus_light_clusters_create(renderer->gpu_device);
+    if (renderer->light_clusters == NULL) {
+        fprintf(stderr, "Failed to create light clusters!\n");
+        nexus_culling_buffer_destroy(renderer->culling_buffer);
+        nexus_render_queue_destroy(renderer->render_queue);
+        nexus_shader_cache_destroy(renderer->shader_cache);
+        nexus_pipeline_cache_destroy(renderer->pipeline_cache);
+        nexus_upload_manager_destroy(renderer->upload_manager);
+        SDL_ReleaseWindowFromGPUDevice(renderer->gpu_device, window->sdl_window);
+        SDL_DestroyGPUDevice(renderer->gpu_device);
+        free(renderer);
+        return NULL;
+    }
+
+    /* Create the shadow atlas, a minimal one keeps the shader bindings valid without shadows */
+    renderer->shadow_atlas = nexus_shadow_atlas_create(renderer->gpu_device,
+        renderer->config.enable_shadows ? renderer->config.shadow_atlas_size : NEXUS_SHADOW_MIN_TILE_SIZE,
+        renderer->config.shadow_cascades, renderer->config.shadow_distance);
+    if (renderer->shadow_atlas == NULL) {
+        fprintf(stderr, "Failed to create shadow atlas!\n");
+        nexus_light_clusters_destroy(renderer->light_clusters);
+        nexus_culling_buffer_destroy(renderer->culling_buffer);
+        nexus_render_queue_destroy(renderer->render_queue);
+        nexus_shader_cache_destroy(renderer->shader_cache);
+        nexus_pipeline_cache_destroy(renderer->pipeline_cache);
+        nexus_upload_manager_destroy(renderer->upload_manager);
+        SDL_ReleaseWindowFromGPUDevice(renderer->gpu_device, window->sdl_window);
+        SDL_DestroyGPUDevice(renderer->gpu_device);
+        free(renderer);
+        return NULL;
+    }
+
+    /* Create the frame's render graph */
+    renderer->render_graph = nexus_render_graph_create(renderer->gpu_device);
+    if (renderer->render_graph == NULL) {
+        fprintf(stderr, "Failed to create render graph!\n");
+        nexus_shadow_atlas_destroy(renderer->shadow_atlas);
+        nexus_light_clusters_destroy(renderer->light_clusters);
+        nexus_culling_buffer_destroy(renderer->culling_buffer);
+        nexus_render_queue_destroy(renderer->render_queue);
+        nexus_shader_cache_destroy(renderer->shader_cache);
+        nexus_pipeline_cache_destroy(renderer->pipeline_cache);
+        nexus_upload_manager_destroy(renderer->upload_manager);
+        SDL_ReleaseWindowFromGPUDevice(renderer->gpu_device, window->sdl_window);
+        SDL_DestroyGPUDevice(renderer->gpu_device);
+        free(renderer);
+        return NULL;
+    }
+
+    /* GPU frame timings are optional, frames are submitted untimed without them */
+    renderer->gpu_timer = nexus_gpu_timer_create(renderer->gpu_device);
+    if (renderer->gpu_timer == NULL) {
+        fprintf(stderr, "Warning: Failed to create GPU timer, GPU frame times are not measured\n");
+    }
+
     /* Create main camera */
     renderer->main_camera = nexus_camera_create();
     if (renderer->main_camera == NULL) {
         fprintf(stderr, "Failed to create default camera!\n");
+        nexus_render_graph_destroy(renderer->render_graph);
+        nexus_shadow_atlas_destroy(renderer->shadow_atlas);
+        nexus_light_clusters_destroy(renderer->light_clusters);
+        nexus_culling_buffer_destroy(renderer->culling_buffer);
+        nexus_render_queue_destroy(renderer->render_queue);
+        nexus_shader_cache_destroy(renderer->shader_cache);
+        nexus_pipeline_cache_destroy(renderer->pipeline_cache);
+        nexus_upload_manager_destroy(renderer->upload_manager);
         SDL_ReleaseWindowFromGPUDevice(renderer->gpu_device, window->sdl_window);
         SDL_DestroyGPUDevice(renderer->gpu_device);
         free(renderer);
@@ -191,6 +623,14 @@ NexusRenderer* nexus_renderer_create(NexusWindow* window, const NexusRendererCon
     nexus_camera_look_at(renderer->main_camera, 0.0f, 0.0f, 0.0f);
     nexus_camera_update(renderer->main_camera);
 
+    /* GPU-driven drawing is optional, without the cull shader everything takes the CPU path */
+    if (renderer->config.enable_gpu_driven) {
+        renderer->gpu_scene = nexus_renderer_create_gpu_scene(renderer, config->gpu_cull_shader);
+        if (renderer->gpu_scene == NULL) {
+            printf("Warning: GPU-driven rendering unavailable, using CPU culling.\n");
+        }
+    }
+
     printf("Renderer created successfully!\n");
     NEXUS_LOG_GPU_DRIVER(renderer);
 
@@ -211,12 +651,93 @@ void nexus_renderer_destroy(NexusRenderer* renderer) {
         renderer->main_camera = NULL;
     }
 
+    /* Finish background pipeline creation before shaders go away */
+    nexus_shader_cache_wait(renderer->shader_cache);
+
     /* Destroy default shader */
     if (renderer->default_shader != NULL) {
         nexus_shader_destroy(renderer->default_shader);
         renderer->default_shader = NULL;
     }
 
+    /* Destroy draw queue */
+    if (renderer->render_queue != NULL) {
+        nexus_render_queue_destroy(renderer->render_queue);
+        renderer->render_queue = NULL;
+    }
+
+    /* Destroy culling buffer */
+    if (renderer->culling_buffer != NULL) {
+        nexus_culling_buffer_destroy(renderer->culling_buffer);
+        renderer->culling_buffer = NULL;
+    }
+
+    /* Destroy light clusters (before the upload manager, their buffers may be staged) */
+    if (renderer->light_clusters != NULL) {
+        nexus_light_clusters_destroy(renderer->light_clusters);
+        renderer->light_clusters = NULL;
+    }
+
+    /* Destroy GPU scene (before the upload manager, its objects may be staged) */
+    if (renderer->gpu_scene != NULL) {
+        nexus_gpu_scene_destroy(renderer->gpu_scene);
+        renderer->gpu_scene = NULL;
+    }
+
+    /* Destroy shadow atlas (before the upload manager, its views may be staged) */
+    if (renderer->shadow_atlas != NULL) {
+        nexus_shadow_atlas_destroy(renderer->shadow_atlas);
+        renderer->shadow_atlas = NULL;
+    }
+
+    /* Destroy GPU timer (waits for the frames it still tracks) */
+    if (renderer->gpu_timer != NULL) {
+        nexus_gpu_timer_destroy(renderer->gpu_timer);
+        renderer->gpu_timer = NULL;
+    }
+
+    /* Destroy render graph (releases its pooled textures) */
+    if (renderer->render_graph != NULL) {
+        nexus_render_graph_destroy(renderer->render_graph);
+        renderer->render_graph = NULL;
+    }
+
+    /* Release depth buffer */
+    if (renderer->gpu_device != NULL && renderer->depth_texture != NULL) {
+        SDL_ReleaseGPUTexture(renderer->gpu_device, renderer->depth_texture);
+        renderer->depth_texture = NULL;
+    }
+
+    /* Release instance buffer */
+    if (renderer->gpu_device != NULL && renderer->instance_buffer != NULL) {
+        nexus_upload_manager_cancel_buffer(renderer->upload_manager, renderer->instance_buffer);
+        SDL_ReleaseGPUBuffer(renderer->gpu_device, renderer->instance_buffer);
+        renderer->instance_buffer = NULL;
+    }
+    if (renderer->gpu_device != NULL && renderer->shadow_instance_buffer != NULL) {
+        nexus_upload_manager_cancel_buffer(renderer->upload_manager, renderer->shadow_instance_buffer);
+        SDL_ReleaseGPUBuffer(renderer->gpu_device, renderer->shadow_instance_buffer);
+        renderer->shadow_instance_buffer = NULL;
+    }
+
+    /* Destroy shader cache (saves the variant list) */
+    if (renderer->shader_cache != NULL) {
+        nexus_shader_cache_destroy(renderer->shader_cache);
+        renderer->shader_cache = NULL;
+    }
+
+    /* Destroy pipeline cache */
+    if (renderer->pipeline_cache != NULL) {
+        nexus_pipeline_cache_destroy(renderer->pipeline_cache);
+        renderer->pipeline_cache = NULL;
+    }
+
+    /* Destroy upload manager (waits for outstanding uploads) */
+    if (renderer->upload_manager != NULL) {
+        nexus_upload_manager_destroy(renderer->upload_manager);
+        renderer->upload_manager = NULL;
+    }
+
     /* Release SDL window from GPU device */
     if (renderer->gpu_device != NULL && renderer->window != NULL) {
         /* Wait for all GPU operations to complete */
@@ -235,12 +756,39 @@ void nexus_renderer_destroy(NexusRenderer* renderer) {
 }
 
 /**
- * Begin rendering a frame
+ * Render graph callback of the scene pass, executes the frame's queued draws
  */
-bool nexus_renderer_begin_frame(NexusRenderer* renderer) {
-    if (renderer == NULL || renderer->gpu_device == NULL || renderer->window == NULL) {
+static void nexus_renderer_execute_scene_pass(const NexusRenderGraphContext* context, void* user_data) {
+    NexusRenderer* renderer = (NexusRenderer*)user_data;
+    renderer->render_pass = context->render_pass;
+
+    /* Set up viewport to match the swapchain dimensions */
+    SDL_GPUViewport viewport = {
+        .x = 0,
+        .y = 0,
+        .w = (float)renderer->swapchain_width,
+        .h = (float)renderer->swapchain_height,
+        .min_depth = 0.0f,
+        .max_depth = 1.0f
+    };
+    SDL_SetGPUViewport(renderer->render_pass, &viewport);
+
+    /* Execute queued draws */
+    nexus_renderer_flush(renderer);
+    renderer->render_pass = NULL;
+}
+
+/**
+ * Begin a frame seen through a camera (NULL = no view)
+ */
+static bool nexus_renderer_begin_frame_view(NexusRenderer* renderer, NexusCamera* camera) {
+    if (renderer->gpu_device == NULL || renderer->window == NULL) {
         return false;
     }
+    renderer->frame_camera = camera;
+
+    /* Frames the GPU has finished are timed before more work is queued */
+    nexus_gpu_timer_resolve(renderer->gpu_timer);
 
     /* Acquire a command buffer */
     renderer->cmd_buffer = SDL_AcquireGPUCommandBuffer(renderer->gpu_device);
@@ -259,48 +807,112 @@ bool nexus_renderer_begin_frame(NexusRenderer* renderer) {
         return false;
     }
 
+    /* The swapchain wait may have let earlier frames finish, which tightens their timings */
+    nexus_gpu_timer_resolve(renderer->gpu_timer);
+
+    /* Window is minimized or occluded, nothing to render into this frame */
+    if (renderer->swapchain_texture == NULL) {
+        SDL_SubmitGPUCommandBuffer(renderer->cmd_buffer);
+        renderer->cmd_buffer = NULL;
+        return false;
+    }
+
+    /* Follow swapchain size changes the window did not report */
+    if (!nexus_renderer_ensure_depth_target(renderer) &&
+        renderer->depth_format != SDL_GPU_TEXTUREFORMAT_INVALID) {
+        SDL_SubmitGPUCommandBuffer(renderer->cmd_buffer);
+        renderer->cmd_buffer = NULL;
+        renderer->swapchain_texture = NULL;
+        return false;
+    }
+
+    /* Draws submitted this frame are built for the prepass setting latched here */
+    renderer->depth_prepass = renderer->config.enable_depth_prepass && renderer->depth_texture != NULL;
+
     /* Reset frame statistics */
     renderer->draw_calls = 0;
     renderer->triangle_count = 0;
+    renderer->pipeline_binds = 0;
+    renderer->buffer_binds = 0;
+    renderer->instance_count = 0;
+    renderer->visible_count = 0;
+    renderer->culled_count = 0;
+    renderer->shadow_views_rendered = 0;
+    renderer->shadow_views_cached = 0;
+    renderer->gpu_object_count = 0;
+    memset(renderer->lod_triangle_counts, 0, sizeof(renderer->lod_triangle_counts));
+
+    /* Reset bound state and the draw queue */
+    renderer->bound_shader = NULL;
+    renderer->bound_pipeline = NULL;
+    renderer->bound_material = NULL;
+    renderer->bound_mesh = NULL;
+    nexus_render_queue_reset(renderer->render_queue);
+    nexus_shadow_atlas_reset_casters(renderer->shadow_atlas);
+    renderer->gpu_scene_pending = renderer->gpu_scene != NULL;
+
+    /* Update camera matrices and the culling frustum once for the whole frame */
+    if (renderer->frame_camera != NULL) {
+        mat4 view_projection;
+        nexus_camera_update(renderer->frame_camera);
+        nexus_camera_get_view_projection_matrix(renderer->frame_camera, (float*)view_projection);
+        nexus_frustum_from_viewproj(view_projection, renderer->frustum_planes);
+    }
 
-    /* Begin a render pass to clear the swapchain */
-    SDL_GPUColorTargetInfo color_target = {
-        .texture = renderer->swapchain_texture,
-        .load_op = SDL_GPU_LOADOP_CLEAR,
-        .store_op = SDL_GPU_STOREOP_STORE,
-        .clear_color = {
-            renderer->clear_color[0],
-            renderer->clear_color[1],
-            renderer->clear_color[2],
-            renderer->clear_color[3]
-        },
-        .cycle = true
+    /* Camera data is written once per frame instead of per draw */
+    nexus_renderer_push_frame_uniforms(renderer);
+
+    /* The scene pass renders the queued draws into the swapchain, later
+     * passes added through the render graph build on its outputs */
+    nexus_render_graph_reset(renderer->render_graph);
+    NexusRenderGraphTextureDesc backbuffer_desc = {
+        .width = renderer->swapchain_width,
+        .height = renderer->swapchain_height,
+        .format = renderer->swapchain_format,
+        .sample_count = SDL_GPU_SAMPLECOUNT_1
+    };
+    NexusRenderGraphResource backbuffer = nexus_render_graph_import_texture(
+        renderer->render_graph, "backbuffer", renderer->swapchain_texture, &backbuffer_desc, false, true);
+
+    uint32_t scene_pass = nexus_render_graph_add_pass(renderer->render_graph, "scene",
+                                                      nexus_renderer_execute_scene_pass, renderer);
+    SDL_FColor clear_color = {
+        renderer->clear_color[0],
+        renderer->clear_color[1],
+        renderer->clear_color[2],
+        renderer->clear_color[3]
     };
+    renderer->graph_backbuffer = nexus_render_graph_write_color(renderer->render_graph, scene_pass, backbuffer,
+                                                                &clear_color);
+
+    /* Depth is only stored when a later pass reads it */
+    renderer->graph_depth = NEXUS_RENDER_GRAPH_INVALID;
+    if (renderer->depth_texture != NULL) {
+        NexusRenderGraphTextureDesc depth_desc = {
+            .width = renderer->depth_width,
+            .height = renderer->depth_height,
+            .format = renderer->depth_format,
+            .sample_count = SDL_GPU_SAMPLECOUNT_1
+        };
+        NexusRenderGraphResource depth = nexus_render_graph_import_texture(
+            renderer->render_graph, "depth", renderer->depth_texture, &depth_desc, false, false);
+        renderer->graph_depth = nexus_render_graph_write_depth(renderer->render_graph, scene_pass, depth,
+                                                               true, 1.0f);
+    }
 
-    SDL_GPURenderPass* render_pass = SDL_BeginGPURenderPass(
-        renderer->cmd_buffer, &color_target, 1, NULL);
+    /* Draws are queued until the render graph executes the scene pass in nexus_renderer_end_frame */
+    return true;
+}
 
-    if (render_pass == NULL) {
-        fprintf(stderr, "Failed to begin render pass: %s\n", SDL_GetError());
-        SDL_CancelGPUCommandBuffer(renderer->cmd_buffer);
+/**
+ * Begin rendering a frame through the main camera
+ */
+bool nexus_renderer_begin_frame(NexusRenderer* renderer) {
+    if (renderer == NULL) {
         return false;
     }
 
-    /* Set up viewport to match the swapchain dimensions */
-    SDL_GPUViewport viewport = {
-        .x = 0,
-        .y = 0,
-        .w = (float)renderer->swapchain_width,
-        .h = (float)renderer->swapchain_height,
-        .min_depth = 0.0f,
-        .max_depth = 1.0f
-    };
-    SDL_SetGPUViewport(render_pass, &viewport);
-
-    /* End the initial clear render pass */
-    SDL_EndGPURenderPass(render_pass);
-
-    return true;
+    return nexus_renderer_begin_frame_view(renderer, renderer->main_camera);
 }
 
 /**
@@ -311,18 +923,33 @@ void nexus_renderer_end_frame(NexusRenderer* renderer) {
         return;
     }
 
-    /* Submit the command buffer */
-    if (!SDL_SubmitGPUCommandBuffer(renderer->cmd_buffer)) {
+    /* Run the frame's passes, the scene pass executes the queued draws */
+    if (!nexus_render_graph_execute(renderer->render_graph, renderer->cmd_buffer)) {
+        fprintf(stderr, "Failed to execute render graph!\n");
+    }
+
+    /* Uploads recorded since the last flush have to execute before this frame */
+    nexus_upload_manager_flush(renderer->upload_manager);
+
+    /* Submit the command buffer, its fence times the frame a few frames later */
+    nexus_gpu_timer_resolve(renderer->gpu_timer);
+    if (!nexus_gpu_timer_submit(renderer->gpu_timer, renderer->cmd_buffer, "Frame")) {
         fprintf(stderr, "Failed to submit command buffer: %s\n", SDL_GetError());
     }
 
     /* Clear references */
     renderer->cmd_buffer = NULL;
     renderer->swapchain_texture = NULL;
+
+    /* Lights are submitted again for every frame, shadow tiles stay cached */
+    nexus_light_clusters_reset(renderer->light_clusters);
+    nexus_shadow_atlas_reset_lights(renderer->shadow_atlas);
 }
 
 /**
  * Render a mesh with a shader and transform
+ * The draw goes through the frame queue so it is sorted and instanced
+ * together with all other draws of the frame
  */
 void nexus_renderer_render_mesh(NexusRenderer* renderer,
                               NexusMesh* mesh,
@@ -342,69 +969,863 @@ void nexus_renderer_render_mesh(NexusRenderer* renderer,
         }
     }
 
-    /* Begin a render pass */
-    SDL_GPUColorTargetInfo color_target = {
-        .texture = renderer->swapchain_texture,
-        .load_op = SDL_GPU_LOADOP_LOAD,  /* We're not clearing, just drawing */
-        .store_op = SDL_GPU_STOREOP_STORE,
-        .clear_color = {0.0f, 0.0f, 0.0f, 0.0f},
-        .cycle = false
-    };
+    /* Queue the draw */
+    nexus_renderer_queue_draw(renderer, mesh, 0, NULL, shader, transform);
+}
 
-    SDL_GPURenderPass* render_pass = SDL_BeginGPURenderPass(
-        renderer->cmd_buffer, &color_target, 1, NULL);
+/**
+ * Submit a mesh to the frame draw queue
+ * Draws are sorted and executed on nexus_renderer_flush or at end of frame
+ */
+bool nexus_renderer_submit(NexusRenderer* renderer, NexusMesh* mesh,
+                           NexusMaterial* material, const float* transform) {
+    return nexus_renderer_submit_lod(renderer, mesh, 0, material, transform);
+}
 
-    if (render_pass == NULL) {
-        fprintf(stderr, "Failed to begin mesh render pass: %s\n", SDL_GetError());
-        return;
+/**
+ * Submit one detail level of a mesh to the frame draw queue
+ * See nexus_renderer_select_lod for picking the level
+ */
+bool nexus_renderer_submit_lod(NexusRenderer* renderer, NexusMesh* mesh, uint32_t lod,
+                               NexusMaterial* material, const float* transform) {
+    if (renderer == NULL || mesh == NULL || renderer->render_queue == NULL) {
+        return false;
     }
 
-    /* Set up viewport to match the swapchain dimensions */
-    SDL_GPUViewport viewport = {
-        .x = 0,
-        .y = 0,
-        .w = (float)renderer->swapchain_width,
-        .h = (float)renderer->swapchain_height,
-        .min_depth = 0.0f,
-        .max_depth = 1.0f
-    };
-    SDL_SetGPUViewport(render_pass, &viewport);
+    /* Resolve the shader providing the pipeline */
+    NexusShader* shader = material != NULL ? material->shader : NULL;
+    if (shader == NULL) {
+        shader = renderer->default_shader;
+        if (shader == NULL) {
+            return false;
+        }
+    }
 
-    /* Bind the shader's pipeline */
-    nexus_shader_bind(shader, render_pass);
+    return nexus_renderer_queue_draw(renderer, mesh, lod, material, shader, transform);
+}
 
-    /* Set camera matrices as uniforms */
-    if (renderer->main_camera != NULL) {
-        mat4 view, projection, view_projection;
+/**
+ * Select the detail level of a mesh from its projected size
+ * Picks the coarsest level whose error, scaled by the projected radius of
+ * the world bounding sphere, stays within lod_pixel_error. Switching to a
+ * coarser level than current_lod needs a margin of lod_hysteresis, so
+ * objects near a threshold don't flicker between levels
+ */
+uint32_t nexus_renderer_select_lod(const NexusRenderer* renderer, const NexusMesh* mesh, const float* center,
+                                   float radius, uint32_t current_lod) {
+    if (renderer == NULL || mesh == NULL || center == NULL || mesh->lod_count < 2 || radius <= 0.0f) {
+        return 0;
+    }
+
+    /* Levels are picked during extraction for the snapshot's view */
+    const NexusRenderSnapshot* snapshot = renderer->snapshot;
+    const NexusCamera* camera = snapshot != NULL ? (snapshot->has_camera ? &snapshot->camera : NULL) :
+                                renderer->main_camera;
+    uint32_t height = snapshot != NULL ? snapshot->viewport_height : renderer->swapchain_height;
+    if (camera == NULL || height == 0) {
+        return 0;
+    }
+
+    /* Pixels per world unit at the object's distance */
+    float viewport_height = (float)height;
+    float pixels_per_unit;
+    if (camera->projection_type == NEXUS_CAMERA_ORTHOGRAPHIC) {
+        if (camera->ortho_height <= 0.0f) {
+            return 0;
+        }
+        pixels_per_unit = viewport_height / camera->ortho_height;
+    } else {
+        vec3 eye, position = { center[0], center[1], center[2] };
+        nexus_camera_get_position(camera, &eye[0], &eye[1], &eye[2]);
+        float distance = glm_vec3_distance(eye, position);
+
+        /* Inside the bounds the object covers the screen */
+        float projection = tanf(glm_rad(camera->fov) * 0.5f);
+        if (distance <= radius || projection <= 0.0f) {
+            return 0;
+        }
+        pixels_per_unit = viewport_height * 0.5f / (distance * projection);
+    }
+    float radius_pixels = radius * pixels_per_unit;
+
+    /* Errors grow along the chain, stop at the first level that is too coarse */
+    float threshold = renderer->config.lod_pixel_error;
+    uint32_t selected = 0;
+    for (uint32_t l = 1; l < mesh->lod_count; l++) {
+        float limit = l > current_lod ? threshold * (1.0f - renderer->config.lod_hysteresis) : threshold;
+        if (mesh->lods[l].error * radius_pixels > limit) {
+            break;
+        }
+        selected = l;
+    }
+
+    return selected;
+}
+
+/**
+ * Add a light to the current frame
+ * Lights are binned into clusters on the first flush of the frame and are
+ * removed at its end
+ */
+bool nexus_renderer_add_light(NexusRenderer* renderer, const NexusLightData* light) {
+    if (renderer == NULL || light == NULL) {
+        return false;
+    }
+
+    /* Shadow views are assigned by the shadow atlas */
+    NexusLightData data = *light;
+    data.spot[2] = 0.0f;
+    data.spot[3] = 0.0f;
+    return nexus_light_clusters_add(renderer->light_clusters, &data);
+}
+
+/**
+ * Add a light that casts shadows to the current frame
+ * The id identifies the light across frames (an entity id, never 0) so its
+ * shadow maps are kept and only re-rendered when casters inside them move.
+ * resolution is the requested tile size (0 = NEXUS_SHADOW_DEFAULT_RESOLUTION)
+ * @return false if the light was not added, lights that don't fit into the atlas are unshadowed
+ */
+bool nexus_renderer_add_shadowed_light(NexusRenderer* renderer, const NexusLightData* light, uint64_t id,
+                                       uint32_t resolution) {
+    if (renderer == NULL || light == NULL) {
+        return false;
+    }
+
+    uint32_t index = renderer->light_clusters->light_count;
+    if (!nexus_renderer_add_light(renderer, light)) {
+        return false;
+    }
+
+    if (renderer->config.enable_shadows) {
+        nexus_shadow_atlas_add_light(renderer->shadow_atlas, id, index, resolution);
+    }
+    return true;
+}
+
+/**
+ * Remove the lights added so far this frame
+ */
+void nexus_renderer_clear_lights(NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return;
+    }
+
+    nexus_light_clusters_reset(renderer->light_clusters);
+    nexus_shadow_atlas_reset_lights(renderer->shadow_atlas);
+}
+
+/**
+ * Submit a shadow caster of the current frame with its world bounds
+ * Casters outside the camera view still cast into it, so submit them
+ * regardless of camera culling
+ */
+bool nexus_renderer_submit_shadow_caster(NexusRenderer* renderer, NexusMesh* mesh, uint32_t lod,
+                                         NexusMaterial* material, const float* transform,
+                                         const float* world_min, const float* world_max) {
+    if (renderer == NULL || mesh == NULL || !renderer->config.enable_shadows) {
+        return false;
+    }
+
+    /* Resolve the shader providing the vertex stage */
+    NexusShader* shader = material != NULL ? material->shader : NULL;
+    if (shader == NULL) {
+        shader = renderer->default_shader;
+        if (shader == NULL) {
+            return false;
+        }
+    }
+
+    return nexus_shadow_atlas_add_caster(renderer->shadow_atlas, mesh, lod, material, shader, transform,
+                                         world_min, world_max);
+}
+
+/**
+ * Get the renderer's shadow atlas (tile layout and views)
+ */
+NexusShadowAtlas* nexus_renderer_get_shadow_atlas(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return NULL;
+    }
+
+    return renderer->shadow_atlas;
+}
+
+/**
+ * Get the renderer's GPU scene
+ * @return NULL if GPU-driven rendering is disabled or unavailable
+ */
+NexusGpuScene* nexus_renderer_get_gpu_scene(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return NULL;
+    }
+
+    return renderer->gpu_scene;
+}
+
+/**
+ * Get the renderer's light clusters (light counts and the debug heatmap)
+ */
+NexusLightClusters* nexus_renderer_get_light_clusters(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return NULL;
+    }
+
+    return renderer->light_clusters;
+}
+
+/**
+ * Shade the lights per cluster as a heatmap instead of lighting
+ */
+void nexus_renderer_set_light_heatmap(NexusRenderer* renderer, bool enabled) {
+    if (renderer == NULL) {
+        return;
+    }
+
+    renderer->light_heatmap = enabled;
+}
+
+/**
+ * Get the renderer's culling buffer
+ * Fill it with world-space bounds, then call nexus_renderer_cull
+ */
+NexusCullingBuffer* nexus_renderer_get_culling_buffer(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return NULL;
+    }
 
-        /* Update camera matrices */
-        nexus_camera_update(renderer->main_camera);
+    return renderer->culling_buffer;
+}
 
-        /* Get matrices */
-        nexus_camera_get_view_matrix(renderer->main_camera, (float*)view);
-        nexus_camera_get_projection_matrix(renderer->main_camera, (float*)projection);
-        nexus_camera_get_view_projection_matrix(renderer->main_camera, (float*)view_projection);
+/**
+ * Test the culling buffer against the frustum of the snapshot being
+ * extracted, or the frame frustum without one
+ * Results are in culling_buffer->visible, the buffer is left for the caller to reset
+ * @return Number of visible boxes
+ */
+uint32_t nexus_renderer_cull(NexusRenderer* renderer) {
+    if (renderer == NULL || renderer->culling_buffer == NULL) {
+        return 0;
+    }
 
-        /* Set matrices as uniforms */
-        nexus_shader_set_uniform_matrix4(shader, "u_view", (float*)view);
-        nexus_shader_set_uniform_matrix4(shader, "u_projection", (float*)projection);
-        nexus_shader_set_uniform_matrix4(shader, "u_viewProjection", (float*)view_projection);
+    NexusCullingBuffer* buffer = renderer->culling_buffer;
+    if (buffer->count == 0) {
+        return 0;
     }
 
-    /* Set transform matrix if provided */
-    if (transform != NULL) {
-        nexus_shader_set_uniform_matrix4(shader, "u_model", transform);
+    /* Counts go to the snapshot, the frame that renders it reports them */
+    NexusRenderSnapshot* snapshot = renderer->snapshot;
+    uint32_t* visible_count = snapshot != NULL ? &snapshot->visible_count : &renderer->visible_count;
+    uint32_t* culled_count = snapshot != NULL ? &snapshot->culled_count : &renderer->culled_count;
+    bool has_view = snapshot != NULL ? snapshot->has_camera : renderer->frame_camera != NULL;
+    const vec4* planes = snapshot != NULL ? (const vec4*)snapshot->frustum_planes :
+                         (const vec4*)renderer->frustum_planes;
+
+    /* Without a camera nothing can be rejected */
+    if (!has_view) {
+        memset(buffer->visible, 1, buffer->count);
+        *visible_count += buffer->count;
+        return buffer->count;
     }
 
-    /* Draw the mesh */
-    uint32_t triangles = nexus_mesh_draw(mesh, render_pass);
+    uint32_t visible = nexus_culling_buffer_test(buffer, planes);
 
     /* Update statistics */
-    renderer->draw_calls++;
-    renderer->triangle_count += triangles;
+    *visible_count += visible;
+    *culled_count += buffer->count - visible;
+
+    return visible;
+}
+
+/**
+ * Start extracting a frame into a snapshot
+ * The render systems record into it instead of drawing, culling and detail
+ * levels use its view. The view starts out as a copy of the main camera
+ */
+void nexus_renderer_begin_snapshot(NexusRenderer* renderer, NexusRenderSnapshot* snapshot, uint64_t frame) {
+    if (renderer == NULL) {
+        return;
+    }
+
+    renderer->snapshot = snapshot;
+    if (snapshot == NULL) {
+        return;
+    }
+
+    /* The window is owned by the extracting (main) thread, the swapchain may be on another */
+    int width = 0, height = 0;
+    SDL_GetWindowSizeInPixels(renderer->window, &width, &height);
+    nexus_render_snapshot_reset(snapshot, frame);
+    nexus_render_snapshot_set_camera(snapshot, renderer->main_camera);
+    nexus_render_snapshot_set_viewport(snapshot, width > 0 ? (uint32_t)width : 0, height > 0 ? (uint32_t)height : 0);
+}
+
+/**
+ * Finish extracting the current snapshot
+ * @return The extracted snapshot, ready for nexus_renderer_render_snapshot
+ */
+NexusRenderSnapshot* nexus_renderer_end_snapshot(NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return NULL;
+    }
+
+    NexusRenderSnapshot* snapshot = renderer->snapshot;
+    renderer->snapshot = NULL;
+    return snapshot;
+}
+
+/**
+ * Get the snapshot being extracted (NULL = render systems draw into the open frame)
+ */
+NexusRenderSnapshot* nexus_renderer_get_snapshot(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return NULL;
+    }
+
+    return renderer->snapshot;
+}
+
+/**
+ * Render a whole frame from a snapshot
+ * Only reads the snapshot and the resources it references, so it can run on
+ * a render thread while the world extracts the next one
+ * @return false if no frame could be rendered (minimized window, no swapchain)
+ */
+bool nexus_renderer_render_snapshot(NexusRenderer* renderer, const NexusRenderSnapshot* snapshot) {
+    if (renderer == NULL || snapshot == NULL) {
+        return false;
+    }
+
+    /* The frame keeps its own copy, the snapshot may be reused right after */
+    NexusCamera* camera = NULL;
+    if (snapshot->has_camera) {
+        renderer->snapshot_camera = snapshot->camera;
+        camera = &renderer->snapshot_camera;
+    }
+
+    NEXUS_PROFILE_BEGIN("RenderBegin");
+    bool in_frame = nexus_renderer_begin_frame_view(renderer, camera);
+    NEXUS_PROFILE_END();
+    if (!in_frame) {
+        return false;
+    }
+
+    /* Replay into the frame queue, clusters and shadow atlas */
+    NEXUS_PROFILE_BEGIN("RenderSubmit");
+    renderer->visible_count += snapshot->visible_count;
+    renderer->culled_count += snapshot->culled_count;
+
+    for (uint32_t i = 0; i < snapshot->light_count; i++) {
+        const NexusSnapshotLight* light = &snapshot->lights[i];
+        bool added = light->shadowed ?
+            nexus_renderer_add_shadowed_light(renderer, &light->data, light->id, light->resolution) :
+            nexus_renderer_add_light(renderer, &light->data);
+        if (!added) {
+            break;
+        }
+    }
+    for (uint32_t i = 0; i < snapshot->caster_count; i++) {
+        const NexusSnapshotCaster* caster = &snapshot->casters[i];
+        nexus_renderer_submit_shadow_caster(renderer, caster->mesh, caster->lod, caster->material,
+                                            caster->transform, caster->world_min, caster->world_max);
+    }
+    for (uint32_t i = 0; i < snapshot->draw_count; i++) {
+        const NexusSnapshotDraw* draw = &snapshot->draws[i];
+        nexus_renderer_submit_lod(renderer, draw->mesh, draw->lod, draw->material, draw->transform);
+    }
+    NEXUS_PROFILE_END();
+
+    NEXUS_PROFILE_BEGIN("RenderEnd");
+    nexus_renderer_end_frame(renderer);
+    NEXUS_PROFILE_END();
+    return true;
+}
+
+/**
+ * Depth only variant of a draw's pipeline for the prepass
+ */
+static SDL_GPUGraphicsPipeline* nexus_renderer_get_prepass_pipeline(NexusRenderer* renderer,
+                                                                    const NexusDrawCommand* cmd) {
+    NexusPipelineState state;
+    nexus_pipeline_cache_get_state(renderer->pipeline_cache, cmd->material, &state);
+    state.vertex_layout = nexus_mesh_get_vertex_layout(cmd->mesh);
+    state.color_write = false;
+    state.depth_write = true;
+    state.depth_compare = SDL_GPU_COMPAREOP_LESS;
+
+    return nexus_pipeline_cache_acquire(renderer->pipeline_cache, cmd->shader, &state);
+}
+
+/**
+ * Execute a range of sorted draws, merging runs that share state into instanced draws
+ */
+static void nexus_renderer_draw_range(NexusRenderer* renderer, NexusRenderQueue* queue,
+                                      uint32_t first, uint32_t end, bool depth_only) {
+    while (first < end) {
+        const NexusDrawCommand* cmd = nexus_render_queue_get_sorted(queue, first);
+
+        /* Consecutive commands sharing mesh level, material and pipeline form one instanced draw */
+        uint32_t last = first + 1;
+        while (last < end) {
+            const NexusDrawCommand* next = nexus_render_queue_get_sorted(queue, last);
+            if (next->mesh != cmd->mesh || next->lod != cmd->lod || next->material != cmd->material ||
+                next->pipeline != cmd->pipeline) {
+                break;
+            }
+            last++;
+        }
+        uint32_t instances = last - first;
+
+        /* Only rebind what changed since the previous draw */
+        if (depth_only) {
+            SDL_GPUGraphicsPipeline* pipeline = nexus_renderer_get_prepass_pipeline(renderer, cmd);
+            if (pipeline == NULL) {
+                first = last;
+                continue;
+            }
+            nexus_renderer_bind_pipeline(renderer, cmd->shader, pipeline);
+        } else {
+            nexus_renderer_bind_pipeline(renderer, cmd->shader, cmd->pipeline);
+            if (cmd->material != NULL && cmd->material != renderer->bound_material) {
+                nexus_material_apply_parameters(cmd->material, renderer->cmd_buffer);
+                renderer->bound_material = cmd->material;
+            }
+        }
+        nexus_renderer_bind_mesh(renderer, cmd->mesh);
+
+        /* Draw the group and update statistics */
+        uint32_t triangles = nexus_mesh_draw_lod_instanced(cmd->mesh, renderer->render_pass, cmd->lod,
+                                                           instances, first);
+        renderer->draw_calls++;
+        if (!depth_only) {
+            renderer->triangle_count += triangles;
+            renderer->lod_triangle_counts[cmd->lod] += triangles;
+            renderer->instance_count += instances;
+        }
+
+        first = last;
+    }
+}
+
+/**
+ * Bin the frame's lights for the main camera and stage the light buffers
+ */
+static void nexus_renderer_build_light_clusters(NexusRenderer* renderer) {
+    NexusLightClusters* clusters = renderer->light_clusters;
+    NexusCamera* camera = renderer->frame_camera;
+
+    /* Without a camera only directional lights apply */
+    if (camera != NULL) {
+        mat4 view, projection;
+        nexus_camera_get_view_matrix(camera, (float*)view);
+        nexus_camera_get_projection_matrix(camera, (float*)projection);
+        nexus_light_clusters_build(clusters, (const float*)view, (const float*)projection,
+                                   camera->near_plane, camera->far_plane);
+    } else {
+        nexus_light_clusters_build(clusters, NULL, NULL, 0.0f, 0.0f);
+    }
+
+    nexus_light_clusters_upload(clusters, renderer->upload_manager);
+}
+
+/**
+ * Push the frame uniforms of a shadow view for the shadow pass
+ */
+static void nexus_renderer_push_shadow_uniforms(SDL_GPUCommandBuffer* cmd_buffer, const float* view,
+                                                const float* projection, const float* view_projection) {
+    NexusFrameUniforms frame;
+    memset(&frame, 0, sizeof(frame));
+    memcpy(frame.view, view, sizeof(frame.view));
+    memcpy(frame.projection, projection, sizeof(frame.projection));
+    memcpy(frame.view_projection, view_projection, sizeof(frame.view_projection));
+    frame.camera_position[3] = 1.0f;
+
+    SDL_PushGPUVertexUniformData(cmd_buffer, NEXUS_UNIFORM_SLOT_VERTEX_FRAME, &frame, sizeof(frame));
+    SDL_PushGPUFragmentUniformData(cmd_buffer, NEXUS_UNIFORM_SLOT_FRAGMENT_FRAME, &frame, sizeof(frame));
+}
+
+/**
+ * Depth only pipeline for a shadow caster or the tile clear quad
+ */
+static SDL_GPUGraphicsPipeline* nexus_renderer_get_shadow_pipeline(NexusRenderer* renderer, NexusShader* shader,
+                                                                   const NexusMaterial* material,
+                                                                   uint32_t vertex_layout, bool clear) {
+    NexusPipelineState state;
+    nexus_pipeline_cache_get_state(renderer->pipeline_cache, material, &state);
+    state.vertex_layout = vertex_layout;
+    state.blend_mode = NEXUS_BLEND_MODE_OPAQUE;
+    state.fill_mode = SDL_GPU_FILLMODE_FILL;
+    state.color_write = false;
+    state.color_format = SDL_GPU_TEXTUREFORMAT_INVALID;
+    state.depth_format = renderer->shadow_atlas->format;
+    state.sample_count = SDL_GPU_SAMPLECOUNT_1;
+    state.depth_test = true;
+    state.depth_write = true;
+
+    if (clear) {
+        /* Overwrite whatever the tile held with the far plane */
+        state.cull_mode = SDL_GPU_CULLMODE_NONE;
+        state.depth_compare = SDL_GPU_COMPAREOP_ALWAYS;
+    } else {
+        state.depth_compare = SDL_GPU_COMPAREOP_LESS_OR_EQUAL;
+        state.depth_bias = NEXUS_SHADOW_DEPTH_BIAS;
+        state.depth_bias_slope = NEXUS_SHADOW_SLOPE_BIAS;
+    }
+
+    return nexus_pipeline_cache_acquire(renderer->pipeline_cache, shader, &state);
+}
+
+/**
+ * Render the shadow tiles whose light view or casters changed
+ * Tiles reuse their depth from earlier frames otherwise. The passes record
+ * into their own command buffer, submitted ahead of the frame's like the
+ * upload batches, so the frame pass samples finished tiles
+ */
+static void nexus_renderer_render_shadows(NexusRenderer* renderer) {
+    NexusShadowAtlas* atlas = renderer->shadow_atlas;
+    nexus_shadow_atlas_upload(atlas, renderer->upload_manager);
+    renderer->shadow_views_cached = atlas->view_count - atlas->dirty_count;
+    if (atlas->dirty_count == 0) {
+        return;
+    }
+
+    /* Instance 0 is the identity transform of the clear quad, caster i is instance 1 + i */
+    uint32_t count = atlas->caster_count + 1;
+    if (!nexus_renderer_reserve_instances(renderer, &renderer->shadow_instance_buffer,
+                                          &renderer->shadow_instance_capacity, count)) {
+        return;
+    }
+
+    nexus_upload_manager_lock(renderer->upload_manager);
+    float* staging = (float*)nexus_upload_manager_begin_buffer(renderer->upload_manager,
+                                                               renderer->shadow_instance_buffer, 0,
+                                                               count * (uint32_t)NEXUS_SHADER_INSTANCE_STRIDE, true);
+    if (staging == NULL) {
+        nexus_upload_manager_unlock(renderer->upload_manager);
+        fprintf(stderr, "Failed to stage shadow caster transforms!\n");
+        return;
+    }
+    memset(staging, 0, NEXUS_SHADER_INSTANCE_STRIDE);
+    staging[0] = staging[5] = staging[10] = staging[15] = 1.0f;
+    for (uint32_t i = 0; i < atlas->caster_count; i++) {
+        memcpy(staging + (i + 1) * 16, atlas->casters[i].transform, NEXUS_SHADER_INSTANCE_STRIDE);
+    }
+    nexus_upload_manager_unlock(renderer->upload_manager);
+
+    /* Caster transforms, views and light lists have to be in place before the shadow passes */
+    if (!nexus_upload_manager_flush(renderer->upload_manager)) {
+        return;
+    }
+
+    SDL_GPUCommandBuffer* cmd_buffer = SDL_AcquireGPUCommandBuffer(renderer->gpu_device);
+    if (cmd_buffer == NULL) {
+        fprintf(stderr, "Failed to acquire shadow command buffer: %s\n", SDL_GetError());
+        return;
+    }
+
+    /* Cached tiles have to survive the pass, only tiles being re-rendered are cleared */
+    bool clear_all = atlas->caster_count == 0 || atlas->dirty_count == atlas->view_count;
+    SDL_GPUDepthStencilTargetInfo depth_target = {
+        .texture = atlas->texture,
+        .clear_depth = 1.0f,
+        .load_op = clear_all ? SDL_GPU_LOADOP_CLEAR : SDL_GPU_LOADOP_LOAD,
+        .store_op = SDL_GPU_STOREOP_STORE,
+        .stencil_load_op = SDL_GPU_LOADOP_DONT_CARE,
+        .stencil_store_op = SDL_GPU_STOREOP_DONT_CARE,
+        .cycle = false
+    };
+    SDL_GPURenderPass* pass = SDL_BeginGPURenderPass(cmd_buffer, NULL, 0, &depth_target);
+    if (pass == NULL) {
+        fprintf(stderr, "Failed to begin shadow pass: %s\n", SDL_GetError());
+        SDL_CancelGPUCommandBuffer(cmd_buffer);
+        return;
+    }
+
+    /* Casters run their own vertex and fragment stages, which read the light lists */
+    nexus_light_clusters_bind(renderer->light_clusters, pass);
+    nexus_shadow_atlas_bind_placeholder(atlas, pass);
+    SDL_GPUBufferBinding instance_binding = {
+        .buffer = renderer->shadow_instance_buffer,
+        .offset = 0
+    };
+    SDL_BindGPUVertexBuffers(pass, NEXUS_SHADER_INSTANCE_BUFFER_SLOT, &instance_binding, 1);
+
+    /* Maps the clear quad onto the far plane */
+    static const float s_clear_matrix[16] = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f,
+        0.0f, 0.0f, 0.0f, 1.0f
+    };
+    static const float s_identity[16] = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f
+    };
+
+    SDL_GPUGraphicsPipeline* bound_pipeline = NULL;
+    NexusMesh* bound_mesh = NULL;
+    for (uint32_t v = 0; v < atlas->view_count; v++) {
+        const NexusShadowViewInfo* info = &atlas->view_info[v];
+        if (!info->dirty) {
+            continue;
+        }
+
+        /* Restrict rasterization to the tile */
+        const NexusShadowTile* tile = &atlas->lights[info->slot].tiles[info->face];
+        SDL_GPUViewport viewport = {
+            .x = (float)tile->x,
+            .y = (float)tile->y,
+            .w = (float)tile->size,
+            .h = (float)tile->size,
+            .min_depth = 0.0f,
+            .max_depth = 1.0f
+        };
+        SDL_Rect scissor = { tile->x, tile->y, tile->size, tile->size };
+        SDL_SetGPUViewport(pass, &viewport);
+        SDL_SetGPUScissor(pass, &scissor);
+
+        /* Reset the tile with a far plane quad */
+        if (!clear_all) {
+            SDL_GPUGraphicsPipeline* pipeline = nexus_renderer_get_shadow_pipeline(
+                renderer, atlas->casters[0].shader, NULL, NEXUS_VERTEX_LAYOUT_POSITION, true);
+            if (pipeline != NULL && nexus_mesh_bind_positions(atlas->clear_mesh, pass)) {
+                if (pipeline != bound_pipeline) {
+                    SDL_BindGPUGraphicsPipeline(pass, pipeline);
+                    bound_pipeline = pipeline;
+                }
+                bound_mesh = atlas->clear_mesh;
+                nexus_renderer_push_shadow_uniforms(cmd_buffer, s_identity, s_clear_matrix, s_clear_matrix);
+                nexus_mesh_draw_lod_instanced(atlas->clear_mesh, pass, 0, 1, 0);
+                renderer->draw_calls++;
+            }
+        }
+
+        nexus_renderer_push_shadow_uniforms(cmd_buffer, info->view, info->projection,
+                                            atlas->views[v].view_projection);
+
+        /* Runs of consecutive casters sharing shader, culling, mesh and level form one instanced draw */
+        const uint32_t* casters = atlas->draw_casters + info->caster_offset;
+        uint32_t first = 0;
+        while (first < info->caster_count) {
+            const NexusShadowCaster* caster = &atlas->casters[casters[first]];
+            bool two_sided = caster->material != NULL && caster->material->two_sided;
+            uint32_t last = first + 1;
+            while (last < info->caster_count && casters[last] == casters[last - 1] + 1) {
+                const NexusShadowCaster* next = &atlas->casters[casters[last]];
+                if (next->mesh != caster->mesh || next->lod != caster->lod || next->shader != caster->shader ||
+                    (next->material != NULL && next->material->two_sided) != two_sided) {
+                    break;
+                }
+                last++;
+            }
+
+            /* Depth only needs positions, use the mesh's position stream when it has one */
+            NexusMesh* mesh = caster->mesh;
+            if (mesh != bound_mesh) {
+                if (!nexus_mesh_bind_positions(mesh, pass)) {
+                    nexus_mesh_bind(mesh, pass);
+                }
+                bound_mesh = mesh;
+            }
+            uint32_t layout = mesh->vertex_layout == NEXUS_VERTEX_LAYOUT_POSITION || mesh->position_buffer != NULL ?
+                NEXUS_VERTEX_LAYOUT_POSITION : nexus_mesh_get_vertex_layout(mesh);
+
+            SDL_GPUGraphicsPipeline* pipeline = nexus_renderer_get_shadow_pipeline(renderer, caster->shader,
+                                                                                  caster->material, layout, false);
+            if (pipeline != NULL) {
+                if (pipeline != bound_pipeline) {
+                    SDL_BindGPUGraphicsPipeline(pass, pipeline);
+                    bound_pipeline = pipeline;
+                }
+                nexus_mesh_draw_lod_instanced(mesh, pass, caster->lod, last - first, casters[first] + 1);
+                renderer->draw_calls++;
+            }
+
+            first = last;
+        }
+    }
+
+    SDL_EndGPURenderPass(pass);
+    bool submitted = SDL_SubmitGPUCommandBuffer(cmd_buffer);
+    if (!submitted) {
+        fprintf(stderr, "Failed to submit shadow command buffer: %s\n", SDL_GetError());
+    }
+
+    /* Tiles count as cached from the next frame on */
+    nexus_shadow_atlas_finish(atlas, submitted);
+    if (submitted) {
+        renderer->shadow_views_rendered = atlas->dirty_count;
+    }
+}
+
+/**
+ * Cull the GPU scene for the frame camera
+ * The pass records into its own command buffer, submitted ahead of the
+ * frame's like the upload batches, so the frame's indirect draws read
+ * finished arguments. Call after the scene's upload batch was flushed
+ * @return true if the scene's draws can be issued this frame
+ */
+static bool nexus_renderer_cull_gpu_scene(NexusRenderer* renderer) {
+    SDL_GPUCommandBuffer* cmd_buffer = SDL_AcquireGPUCommandBuffer(renderer->gpu_device);
+    if (cmd_buffer == NULL) {
+        fprintf(stderr, "Failed to acquire cull command buffer: %s\n", SDL_GetError());
+        return false;
+    }
+
+    /* Without a camera nothing can be rejected */
+    const vec4* planes = renderer->frame_camera != NULL ? (const vec4*)renderer->frustum_planes : NULL;
+    if (!nexus_gpu_scene_cull(renderer->gpu_scene, cmd_buffer, planes)) {
+        SDL_CancelGPUCommandBuffer(cmd_buffer);
+        return false;
+    }
+
+    if (!SDL_SubmitGPUCommandBuffer(cmd_buffer)) {
+        fprintf(stderr, "Failed to submit cull command buffer: %s\n", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Issue the GPU scene's indirect draws into the frame render pass
+ * Each draw reads its instance count from the cull pass results, the CPU
+ * cost follows the number of draws rather than the number of objects
+ */
+static void nexus_renderer_draw_gpu_scene(NexusRenderer* renderer) {
+    NexusGpuScene* scene = renderer->gpu_scene;
+
+    /* Visible transforms were compacted by the cull pass, draws select their range through first_instance */
+    SDL_GPUBufferBinding instance_binding = {
+        .buffer = scene->instance_buffer,
+        .offset = 0
+    };
+    SDL_BindGPUVertexBuffers(renderer->render_pass, NEXUS_SHADER_INSTANCE_BUFFER_SLOT, &instance_binding, 1);
+    renderer->buffer_binds++;
+
+    for (uint32_t i = 0; i < scene->draw_count; i++) {
+        const NexusGpuDraw* draw = &scene->draws[i];
+        if (draw->mesh == NULL || draw->object_count == 0) {
+            continue;
+        }
+
+        NexusPipelineState state;
+        nexus_pipeline_cache_get_state(renderer->pipeline_cache, draw->material, &state);
+        state.vertex_layout = nexus_mesh_get_vertex_layout(draw->mesh);
+        SDL_GPUGraphicsPipeline* pipeline = nexus_pipeline_cache_acquire(renderer->pipeline_cache,
+                                                                         draw->material->shader, &state);
+        if (pipeline == NULL) {
+            continue;
+        }
+
+        nexus_renderer_bind_pipeline(renderer, draw->material->shader, pipeline);
+        if (draw->material != renderer->bound_material) {
+            nexus_material_apply_parameters(draw->material, renderer->cmd_buffer);
+            renderer->bound_material = draw->material;
+        }
+        nexus_renderer_bind_mesh(renderer, draw->mesh);
+
+        SDL_DrawGPUIndexedPrimitivesIndirect(renderer->render_pass, scene->draw_buffer,
+                                             i * (uint32_t)sizeof(SDL_GPUIndexedIndirectDrawCommand), 1);
+        renderer->draw_calls++;
+    }
+}
+
+/**
+ * Sort and execute the queued draws, the caller holds the GPU scene
+ */
+static void nexus_renderer_flush_queue(NexusRenderer* renderer) {
+    /* The GPU scene is culled and drawn by the frame's first flush */
+    bool gpu_draws = renderer->gpu_scene_pending && nexus_gpu_scene_get_object_count(renderer->gpu_scene) > 0;
+    renderer->gpu_scene_pending = false;
+
+    NexusRenderQueue* queue = renderer->render_queue;
+    uint32_t count = nexus_render_queue_get_count(queue);
+    if (count == 0 && !gpu_draws) {
+        return;
+    }
+
+    /* Order draws by state and depth */
+    nexus_render_queue_sort(queue);
+
+    /* Bin the frame's lights once, later flushes reuse the clusters. Shadow
+     * views are assigned first, binning reorders the lights */
+    bool lights_changed = !renderer->light_clusters->built;
+    if (lights_changed) {
+        NexusLightClusters* clusters = renderer->light_clusters;
+        nexus_shadow_atlas_build(renderer->shadow_atlas, clusters->lights, clusters->light_count,
+                                 renderer->frame_camera);
+        nexus_renderer_build_light_clusters(renderer);
+        nexus_renderer_render_shadows(renderer);
+    }
+
+    /* Changed scene objects and the frame's indirect arguments go into the same upload batch */
+    if (gpu_draws) {
+        gpu_draws = nexus_gpu_scene_upload(renderer->gpu_scene, renderer->upload_manager);
+    }
+
+    /* Stream all transforms into the instance buffer and submit the upload
+     * batch so it executes before the frame's command buffer */
+    if ((count > 0 && !nexus_renderer_upload_instances(renderer, queue, count)) ||
+        !nexus_upload_manager_flush(renderer->upload_manager)) {
+        nexus_render_queue_reset(queue);
+        return;
+    }
+    if (gpu_draws) {
+        gpu_draws = nexus_renderer_cull_gpu_scene(renderer);
+    }
 
-    /* End the render pass */
-    SDL_EndGPURenderPass(render_pass);
+    /* Light lists and shadow maps are read by every fragment shader */
+    nexus_light_clusters_bind(renderer->light_clusters, renderer->render_pass);
+    nexus_shadow_atlas_bind(renderer->shadow_atlas, renderer->render_pass);
+    if (lights_changed) {
+        nexus_renderer_push_frame_uniforms(renderer);
+    }
+
+    /* GPU-driven objects are opaque, they go ahead of the queue's transparent draws */
+    if (gpu_draws) {
+        nexus_renderer_draw_gpu_scene(renderer);
+        renderer->gpu_object_count = nexus_gpu_scene_get_object_count(renderer->gpu_scene);
+    }
+    if (count == 0) {
+        return;
+    }
+
+    /* Instance buffer stays bound for the queue's draws, groups select their
+     * range through first_instance */
+    SDL_GPUBufferBinding instance_binding = {
+        .buffer = renderer->instance_buffer,
+        .offset = 0
+    };
+    SDL_BindGPUVertexBuffers(renderer->render_pass, NEXUS_SHADER_INSTANCE_BUFFER_SLOT, &instance_binding, 1);
+    renderer->buffer_binds++;
+
+    /* Depth prepass over the opaque draws (they are sorted first) */
+    if (renderer->depth_prepass) {
+        nexus_renderer_draw_range(renderer, queue, 0, nexus_render_queue_get_opaque_count(queue), true);
+    }
+
+    /* Shade everything */
+    nexus_renderer_draw_range(renderer, queue, 0, count, false);
+
+    /* Queue is consumed */
+    nexus_render_queue_reset(queue);
+}
+
+/**
+ * Sort and execute all queued draws into the frame render pass
+ */
+void nexus_renderer_flush(NexusRenderer* renderer) {
+    if (renderer == NULL || renderer->render_pass == NULL || renderer->render_queue == NULL) {
+        return;
+    }
+
+    /* The world may change GPU scene objects from another thread, they stay
+     * put from the upload until the scene's draws are recorded */
+    nexus_gpu_scene_lock(renderer->gpu_scene);
+    nexus_renderer_flush_queue(renderer);
+    nexus_gpu_scene_unlock(renderer->gpu_scene);
 }
 
 /**
@@ -457,6 +1878,9 @@ void nexus_renderer_resize(NexusRenderer* renderer, int width, int height) {
     renderer->swapchain_width = (uint32_t)width;
     renderer->swapchain_height = (uint32_t)height;
 
+    /* Recreate the depth buffer now rather than on the next frame */
+    nexus_renderer_ensure_depth_target(renderer);
+
     /* Update main camera aspect ratio */
     float aspect_ratio = (float)width / (float)height;
     nexus_camera_set_aspect_ratio(renderer->main_camera, aspect_ratio);
@@ -464,6 +1888,63 @@ void nexus_renderer_resize(NexusRenderer* renderer, int width, int height) {
     printf("Renderer resized to %dx%d (aspect: %.2f)\n", width, height, aspect_ratio);
 }
 
+/**
+ * Switch the present mode of the swapchain
+ * VSYNC never tears, MAILBOX replaces queued images for lower latency without
+ * tearing, IMMEDIATE presents at once and may tear. Call between frames
+ * @return false if the window doesn't support the mode, the current one stays
+ */
+bool nexus_renderer_set_present_mode(NexusRenderer* renderer, SDL_GPUPresentMode present_mode) {
+    if (renderer == NULL || renderer->gpu_device == NULL || renderer->window == NULL) {
+        return false;
+    }
+
+    if (!SDL_WindowSupportsGPUPresentMode(renderer->gpu_device, renderer->window, present_mode)) {
+        fprintf(stderr, "Warning: Present mode %d not supported by the window!\n", (int)present_mode);
+        return false;
+    }
+
+    if (!SDL_SetGPUSwapchainParameters(renderer->gpu_device, renderer->window,
+                                       renderer->config.composition_mode, present_mode)) {
+        fprintf(stderr, "Failed to set swapchain parameters: %s\n", SDL_GetError());
+        return false;
+    }
+
+    renderer->config.present_mode = present_mode;
+    renderer->config.enable_vsync = present_mode == SDL_GPU_PRESENTMODE_VSYNC;
+    return true;
+}
+
+/**
+ * Get the present mode the swapchain uses
+ */
+SDL_GPUPresentMode nexus_renderer_get_present_mode(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return SDL_GPU_PRESENTMODE_VSYNC;
+    }
+
+    return renderer->config.present_mode;
+}
+
+/**
+ * Set how many frames the CPU may queue ahead of the GPU (1 - 3)
+ * One frame gives the lowest input latency, at the cost of the CPU and the GPU
+ * no longer overlapping. Call between frames
+ */
+bool nexus_renderer_set_frames_in_flight(NexusRenderer* renderer, uint32_t frames_in_flight) {
+    if (renderer == NULL || renderer->gpu_device == NULL || frames_in_flight < 1 || frames_in_flight > 3) {
+        return false;
+    }
+
+    if (!SDL_SetGPUAllowedFramesInFlight(renderer->gpu_device, frames_in_flight)) {
+        fprintf(stderr, "Failed to set frames in flight: %s\n", SDL_GetError());
+        return false;
+    }
+
+    renderer->config.frames_in_flight = frames_in_flight;
+    return true;
+}
+
 /**
  * Get the capabilities of the renderer
  */
@@ -489,6 +1970,119 @@ SDL_GPUDevice* nexus_renderer_get_gpu_device(const NexusRenderer* renderer) {
     return renderer->gpu_device;
 }
 
+/**
+ * Get the scene render pass (only open while the render graph executes the scene pass)
+ */
+SDL_GPURenderPass* nexus_renderer_get_render_pass(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return NULL;
+    }
+
+    return renderer->render_pass;
+}
+
+/**
+ * Check if a frame is being recorded (between begin and end frame)
+ */
+bool nexus_renderer_is_in_frame(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return false;
+    }
+
+    return renderer->cmd_buffer != NULL;
+}
+
+/**
+ * Get the renderer's render graph, passes added between begin and end frame
+ * execute with the scene pass
+ */
+NexusRenderGraph* nexus_renderer_get_render_graph(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return NULL;
+    }
+
+    return renderer->render_graph;
+}
+
+/**
+ * Get the latest version of the swapchain texture in the render graph
+ * @return NEXUS_RENDER_GRAPH_INVALID outside begin/end frame
+ */
+NexusRenderGraphResource nexus_renderer_get_backbuffer(const NexusRenderer* renderer) {
+    if (renderer == NULL || renderer->cmd_buffer == NULL) {
+        return NEXUS_RENDER_GRAPH_INVALID;
+    }
+
+    return nexus_render_graph_get_latest(renderer->render_graph, renderer->graph_backbuffer);
+}
+
+/**
+ * Get the latest version of the depth texture in the render graph
+ * @return NEXUS_RENDER_GRAPH_INVALID outside begin/end frame
+ */
+NexusRenderGraphResource nexus_renderer_get_depth_resource(const NexusRenderer* renderer) {
+    if (renderer == NULL || renderer->cmd_buffer == NULL) {
+        return NEXUS_RENDER_GRAPH_INVALID;
+    }
+
+    return nexus_render_graph_get_latest(renderer->render_graph, renderer->graph_depth);
+}
+
+/**
+ * Get the renderer's shared upload manager
+ */
+NexusUploadManager* nexus_renderer_get_upload_manager(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return NULL;
+    }
+
+    return renderer->upload_manager;
+}
+
+/**
+ * Get the renderer's pipeline cache
+ */
+NexusPipelineCache* nexus_renderer_get_pipeline_cache(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return NULL;
+    }
+
+    return renderer->pipeline_cache;
+}
+
+/**
+ * Get the renderer's shader cache (NULL when disabled)
+ */
+NexusShaderCache* nexus_renderer_get_shader_cache(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return NULL;
+    }
+
+    return renderer->shader_cache;
+}
+
+/**
+ * Get the renderer's depth buffer (NULL before the first frame or without depth support)
+ */
+SDL_GPUTexture* nexus_renderer_get_depth_texture(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return NULL;
+    }
+
+    return renderer->depth_texture;
+}
+
+/**
+ * Enable or disable the opaque depth prepass, takes effect from the next frame
+ */
+void nexus_renderer_set_depth_prepass(NexusRenderer* renderer, bool enabled) {
+    if (renderer == NULL) {
+        return;
+    }
+
+    renderer->config.enable_depth_prepass = enabled;
+}
+
 /**
  * Get the number of draw calls in the current frame
  */
@@ -511,6 +2105,105 @@ uint32_t nexus_renderer_get_triangle_count(const NexusRenderer* renderer) {
     return renderer->triangle_count;
 }
 
+/**
+ * Get the number of triangles drawn at one detail level in the current frame
+ */
+uint32_t nexus_renderer_get_lod_triangle_count(const NexusRenderer* renderer, uint32_t lod) {
+    if (renderer == NULL || lod >= NEXUS_MESH_MAX_LODS) {
+        return 0;
+    }
+
+    return renderer->lod_triangle_counts[lod];
+}
+
+/**
+ * Get the number of pipeline binds in the current frame
+ */
+uint32_t nexus_renderer_get_pipeline_bind_count(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return 0;
+    }
+
+    return renderer->pipeline_binds;
+}
+
+/**
+ * Get the number of vertex/index buffer binds in the current frame
+ */
+uint32_t nexus_renderer_get_buffer_bind_count(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return 0;
+    }
+
+    return renderer->buffer_binds;
+}
+
+/**
+ * Get the number of instances drawn in the current frame
+ */
+uint32_t nexus_renderer_get_instance_count(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return 0;
+    }
+
+    return renderer->instance_count;
+}
+
+/**
+ * Get the number of objects that passed frustum culling in the current frame
+ */
+uint32_t nexus_renderer_get_visible_count(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return 0;
+    }
+
+    return renderer->visible_count;
+}
+
+/**
+ * Get the number of objects rejected by frustum culling in the current frame
+ */
+uint32_t nexus_renderer_get_culled_count(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return 0;
+    }
+
+    return renderer->culled_count;
+}
+
+/**
+ * Get the number of shadow tiles rendered in the current frame
+ */
+uint32_t nexus_renderer_get_shadow_views_rendered(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return 0;
+    }
+
+    return renderer->shadow_views_rendered;
+}
+
+/**
+ * Get the number of shadow tiles reused from earlier frames in the current frame
+ */
+uint32_t nexus_renderer_get_shadow_views_cached(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return 0;
+    }
+
+    return renderer->shadow_views_cached;
+}
+
+/**
+ * Get the number of objects culled and drawn on the GPU in the current frame
+ */
+uint32_t nexus_renderer_get_gpu_object_count(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return 0;
+    }
+
+    return renderer->gpu_object_count;
+}
+
 /**
  * Get the time taken to render the last frame (in milliseconds)
  */
@@ -522,6 +2215,18 @@ double nexus_renderer_get_frame_time(const NexusRenderer* renderer) {
     return renderer->frame_time;
 }
 
+/**
+ * Get the GPU time of the most recently completed frame in milliseconds
+ * The result trails the CPU by a few frames and is an upper bound, see gpu_timer.h
+ */
+double nexus_renderer_get_gpu_frame_time(const NexusRenderer* renderer) {
+    if (renderer == NULL) {
+        return 0.0;
+    }
+
+    return nexus_gpu_timer_get_time(renderer->gpu_timer);
+}
+
 /**
  * Set the frame time value
  * This should be called by the engine after measuring the frame time
@@ -4,40 +4,114 @@
  */
 
 #include "nexus3d/renderer/shader.h"
+#include "nexus3d/renderer/pipeline_cache.h"
+#include "nexus3d/renderer/shader_cache.h"
+#include "nexus3d/utils/mapped_file.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 
-/* Vertex attributes structure array */
-static const SDL_GPUVertexAttribute s_default_vertex_attributes[] = {
-    {
-        .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3, /* xyz position */
-        .offset = 0,
-        .buffer_slot = 0,
-        .location = 0
-    },
-    {
-        .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3, /* xyz normal */
-        .offset = 12, /* offset after position (3 floats × 4 bytes) */
-        .buffer_slot = 0,
-        .location = 1
-    },
-    {
-        .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2, /* uv coordinates */
-        .offset = 24, /* offset after position and normal (3+3 floats × 4 bytes) */
-        .buffer_slot = 0,
-        .location = 2
-    },
-    {
-        .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, /* rgba color */
-        .offset = 32, /* offset after position, normal, and uv (3+3+2 floats × 4 bytes) */
-        .buffer_slot = 0,
-        .location = 3
-    }
+/**
+ * Built-in uniform layout, resolved into each shader at compile time
+ */
+typedef struct {
+    const char* name;
+    NexusUniformBlock block;
+    uint32_t offset;
+    uint32_t size;
+} NexusBuiltinUniform;
+
+static const NexusBuiltinUniform s_builtin_uniforms[] = {
+    /* Per-frame block */
+    { "u_view",           NEXUS_UNIFORM_BLOCK_FRAME,    offsetof(NexusFrameUniforms, view),            sizeof(float) * 16 },
+    { "u_projection",     NEXUS_UNIFORM_BLOCK_FRAME,    offsetof(NexusFrameUniforms, projection),      sizeof(float) * 16 },
+    { "u_viewProjection", NEXUS_UNIFORM_BLOCK_FRAME,    offsetof(NexusFrameUniforms, view_projection), sizeof(float) * 16 },
+    { "u_cameraPosition", NEXUS_UNIFORM_BLOCK_FRAME,    offsetof(NexusFrameUniforms, camera_position), sizeof(float) * 4 },
+    { "u_time",           NEXUS_UNIFORM_BLOCK_FRAME,    offsetof(NexusFrameUniforms, time),            sizeof(float) * 4 },
+    { "u_clusterScale",   NEXUS_UNIFORM_BLOCK_FRAME,    offsetof(NexusFrameUniforms, cluster_scale),   sizeof(float) * 4 },
+    { "u_clusterInfo",    NEXUS_UNIFORM_BLOCK_FRAME,    offsetof(NexusFrameUniforms, cluster_info),    sizeof(uint32_t) * 4 },
+
+    /* Per-object block */
+    { "u_model",          NEXUS_UNIFORM_BLOCK_OBJECT,   offsetof(NexusObjectUniforms, model),          sizeof(float) * 16 },
+    { "u_objectParams",   NEXUS_UNIFORM_BLOCK_OBJECT,   offsetof(NexusObjectUniforms, params),         sizeof(float) * 4 },
+
+    /* Per-material block */
+    { "u_baseColor",      NEXUS_UNIFORM_BLOCK_MATERIAL, offsetof(NexusMaterialUniforms, base_color),   sizeof(float) * 4 },
+    { "u_emissive",       NEXUS_UNIFORM_BLOCK_MATERIAL, offsetof(NexusMaterialUniforms, emissive),     sizeof(float) * 4 },
+    { "u_metallic",       NEXUS_UNIFORM_BLOCK_MATERIAL, offsetof(NexusMaterialUniforms, metallic),     sizeof(float) },
+    { "u_roughness",      NEXUS_UNIFORM_BLOCK_MATERIAL, offsetof(NexusMaterialUniforms, roughness),    sizeof(float) },
+    { "u_ao",             NEXUS_UNIFORM_BLOCK_MATERIAL, offsetof(NexusMaterialUniforms, ao),           sizeof(float) },
+    { "u_mapFlags",       NEXUS_UNIFORM_BLOCK_MATERIAL, offsetof(NexusMaterialUniforms, map_flags),    sizeof(uint32_t) }
 };
 
-/* Number of vertex attributes */
-static const int s_num_vertex_attributes = sizeof(s_default_vertex_attributes) / sizeof(s_default_vertex_attributes[0]);
+/* Number of built-in uniforms */
+static const int s_num_builtin_uniforms = sizeof(s_builtin_uniforms) / sizeof(s_builtin_uniforms[0]);
+
+/* Size of each uniform block */
+static const uint32_t s_uniform_block_sizes[NEXUS_UNIFORM_BLOCK_COUNT] = {
+    sizeof(NexusFrameUniforms),
+    sizeof(NexusObjectUniforms),
+    sizeof(NexusMaterialUniforms)
+};
+
+/**
+ * Hash a uniform name (FNV-1a)
+ */
+static uint32_t nexus_shader_hash_name(const char* name) {
+    uint32_t hash = 2166136261u;
+    for (const char* c = name; *c != '\0'; c++) {
+        hash ^= (uint8_t)*c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Resolve uniform names to block/offset handles
+ */
+static void nexus_shader_resolve_uniforms(NexusShader* shader) {
+    /* Set up block shadow copies */
+    for (int i = 0; i < NEXUS_UNIFORM_BLOCK_COUNT; i++) {
+        shader->blocks[i].size = s_uniform_block_sizes[i];
+    }
+
+    /* Build the name table and its hash lookup */
+    shader->uniform_count = 0;
+    memset(shader->uniform_lookup, 0, sizeof(shader->uniform_lookup));
+    for (int i = 0; i < s_num_builtin_uniforms && i < NEXUS_SHADER_MAX_UNIFORMS; i++) {
+        uint32_t index = shader->uniform_count++;
+        NexusShaderUniform* uniform = &shader->uniforms[index];
+        strncpy(uniform->name, s_builtin_uniforms[i].name, sizeof(uniform->name) - 1);
+        uniform->name[sizeof(uniform->name) - 1] = '\0';
+        uniform->hash = nexus_shader_hash_name(uniform->name);
+        uniform->handle.block = (int32_t)s_builtin_uniforms[i].block;
+        uniform->handle.offset = s_builtin_uniforms[i].offset;
+        uniform->handle.size = s_builtin_uniforms[i].size;
+
+        uint32_t slot = uniform->hash & (NEXUS_SHADER_UNIFORM_LOOKUP_SIZE - 1);
+        while (shader->uniform_lookup[slot] != 0) {
+            slot = (slot + 1) & (NEXUS_SHADER_UNIFORM_LOOKUP_SIZE - 1);
+        }
+        shader->uniform_lookup[slot] = (uint8_t)(index + 1);
+    }
+}
+
+/**
+ * Release the shader's default pipeline and every cached variant of its modules
+ */
+static void nexus_shader_release_pipeline(NexusShader* shader) {
+    /* The prewarm worker may still be building variants of this shader */
+    nexus_shader_cache_wait(nexus_shader_cache_get(shader->device));
+
+    nexus_pipeline_cache_evict_shader(nexus_pipeline_cache_get(shader->device), shader);
+
+    if (shader->pipeline != NULL && !shader->pipeline_cached) {
+        SDL_ReleaseGPUGraphicsPipeline(shader->device, shader->pipeline);
+    }
+    shader->pipeline = NULL;
+    shader->pipeline_cached = false;
+}
 
 /**
  * Create a shader
@@ -61,6 +135,7 @@ NexusShader* nexus_shader_create(SDL_GPUDevice* device, const char* name) {
     
     /* Store GPU device reference */
     shader->device = device;
+    shader->vertex_layout = NEXUS_VERTEX_LAYOUT_DEFAULT;
     
     /* Set shader name */
     if (name != NULL) {
@@ -81,6 +156,9 @@ void nexus_shader_destroy(NexusShader* shader) {
         return;
     }
     
+    /* Release the pipelines before the modules they were built from */
+    nexus_shader_release_pipeline(shader);
+
     /* Release the shaders */
     if (shader->vertex_shader != NULL) {
         SDL_ReleaseGPUShader(shader->device, shader->vertex_shader);
@@ -92,12 +170,6 @@ void nexus_shader_destroy(NexusShader* shader) {
         shader->fragment_shader = NULL;
     }
     
-    /* Release the pipeline */
-    if (shader->pipeline != NULL) {
-        SDL_ReleaseGPUGraphicsPipeline(shader->device, shader->pipeline);
-        shader->pipeline = NULL;
-    }
-    
     /* Free shader structure */
     free(shader);
 }
@@ -110,6 +182,18 @@ bool nexus_shader_load_from_source(NexusShader* shader, NexusShaderType type,
     if (shader == NULL || source == NULL) {
         return false;
     }
+
+    return nexus_shader_load_from_memory(shader, type, language, source, strlen(source));
+}
+
+/**
+ * Load shader from a block of code (binary formats such as SPIR-V may contain zero bytes)
+ */
+bool nexus_shader_load_from_memory(NexusShader* shader, NexusShaderType type,
+                                   NexusShaderLanguage language, const void* code, size_t size) {
+    if (shader == NULL || code == NULL || size == 0) {
+        return false;
+    }
     
     /* Create shader based on type */
     SDL_GPUShaderCreateInfo createInfo = {0};
@@ -152,19 +236,45 @@ bool nexus_shader_load_from_source(NexusShader* shader, NexusShaderType type,
             return false;
     }
     
+    /* Declare the fixed uniform blocks */
+    createInfo.num_uniform_buffers = stage == SDL_GPU_SHADERSTAGE_VERTEX ?
+        NEXUS_VERTEX_UNIFORM_BUFFER_COUNT : NEXUS_FRAGMENT_UNIFORM_BUFFER_COUNT;
+
+    /* Fragment shaders read the clustered light lists and sample the shadow atlas */
+    createInfo.num_storage_buffers = stage == SDL_GPU_SHADERSTAGE_FRAGMENT ? NEXUS_FRAGMENT_STORAGE_BUFFER_COUNT : 0;
+    createInfo.num_samplers = stage == SDL_GPU_SHADERSTAGE_FRAGMENT ? NEXUS_FRAGMENT_SAMPLER_COUNT : 0;
+
+    /* Content hash of the source for the device's driver (shader cache key) */
+    uint64_t hash = nexus_shader_cache_hash(shader->device, stage, createInfo.format, code, size);
+
     /* Configure shader creation info */
     createInfo.stage = stage;
-    createInfo.code = (const Uint8 *)source;
-    createInfo.code_size = strlen(source);
+    createInfo.code = (const Uint8 *)code;
+    createInfo.code_size = size;
     createInfo.entrypoint = "main";
+
+    /* Sources the driver cannot consume go through the shader cache (mapped blob or translation) */
+    NexusShaderBlob blob;
+    memset(&blob, 0, sizeof(blob));
+    if ((SDL_GetGPUShaderFormats(shader->device) & createInfo.format) == 0 &&
+        nexus_shader_cache_get_blob(nexus_shader_cache_get(shader->device), hash, code, size,
+                                    language, stage, &blob)) {
+        createInfo.format = blob.format;
+        createInfo.code = (const Uint8 *)blob.code;
+        createInfo.code_size = blob.size;
+    }
     
     /* Create the shader */
     SDL_GPUShader* gpu_shader = SDL_CreateGPUShader(shader->device, &createInfo);
+    nexus_shader_cache_release_blob(&blob);
     if (gpu_shader == NULL) {
         fprintf(stderr, "Failed to create shader: %s\n", SDL_GetError());
         return false;
     }
     
+    /* Pipelines built from a replaced module are stale */
+    nexus_shader_release_pipeline(shader);
+
     /* Store the shader based on type */
     switch (type) {
         case NEXUS_SHADER_TYPE_VERTEX:
@@ -173,6 +283,7 @@ bool nexus_shader_load_from_source(NexusShader* shader, NexusShaderType type,
                 SDL_ReleaseGPUShader(shader->device, shader->vertex_shader);
             }
             shader->vertex_shader = gpu_shader;
+            shader->vertex_hash = hash;
             break;
         case NEXUS_SHADER_TYPE_FRAGMENT:
             /* Release previous fragment shader if exists */
@@ -180,6 +291,7 @@ bool nexus_shader_load_from_source(NexusShader* shader, NexusShaderType type,
                 SDL_ReleaseGPUShader(shader->device, shader->fragment_shader);
             }
             shader->fragment_shader = gpu_shader;
+            shader->fragment_hash = hash;
             break;
         default:
             /* Unsupported shader type for graphics pipeline */
@@ -199,48 +311,39 @@ bool nexus_shader_load_from_file(NexusShader* shader, NexusShaderType type,
         return false;
     }
     
-    /* Open file */
-    FILE* file = fopen(filename, "rb");
-    if (file == NULL) {
+    /* Map the file, the code is handed to the driver without a copy */
+    NexusMappedFile file;
+    if (!nexus_mapped_file_open(&file, filename)) {
         fprintf(stderr, "Failed to open shader file: %s\n", filename);
         return false;
     }
     
-    /* Get file size */
-    fseek(file, 0, SEEK_END);
-    long file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
-    
-    /* Allocate memory for file content */
-    char* source = (char*)malloc(file_size + 1);
-    if (source == NULL) {
-        fprintf(stderr, "Failed to allocate memory for shader source!\n");
-        fclose(file);
-        return false;
-    }
-    
-    /* Read file content */
-    size_t read_size = fread(source, 1, file_size, file);
-    fclose(file);
-    
-    if (read_size != (size_t)file_size) {
-        fprintf(stderr, "Failed to read shader file: %s\n", filename);
-        free(source);
-        return false;
-    }
-    
-    /* Null-terminate the source */
-    source[file_size] = '\0';
-    
-    /* Load shader from source */
-    bool result = nexus_shader_load_from_source(shader, type, language, source);
+    /* Load shader from the mapped code */
+    bool result = nexus_shader_load_from_memory(shader, type, language, file.data, file.size);
     
-    /* Free source */
-    free(source);
+    /* Unmap file */
+    nexus_mapped_file_close(&file);
     
     return result;
 }
 
+/**
+ * Select the vertex layout the default variant reads, call before nexus_shader_compile
+ * Other variants take their layout from the mesh they draw
+ */
+void nexus_shader_set_vertex_layout(NexusShader* shader, uint32_t vertex_layout) {
+    if (shader == NULL) {
+        return;
+    }
+
+    if (nexus_vertex_layout_get(vertex_layout) == NULL) {
+        fprintf(stderr, "Unknown vertex layout %u for shader '%s'!\n", vertex_layout, shader->name);
+        return;
+    }
+
+    shader->vertex_layout = vertex_layout;
+}
+
 /**
  * Compile shader
  */
@@ -250,123 +353,32 @@ bool nexus_shader_compile(NexusShader* shader) {
         return false;
     }
     
-    /* Create graphics pipeline */
-    SDL_GPUGraphicsPipelineCreateInfo createInfo = {0};
-    
-    /* Set shader stages */
-    createInfo.vertex_shader = shader->vertex_shader;
-    createInfo.fragment_shader = shader->fragment_shader;
-    createInfo.primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
-    
-    /* Configure vertex attributes */
-    SDL_GPUVertexInputState vertexInput = {0};
-    
-    /* Set up vertex buffer binding */
-    SDL_GPUVertexBufferDescription vertexBuffer = {
-        .pitch = sizeof(float) * (3 + 3 + 2 + 4), /* pos(3) + normal(3) + uv(2) + color(4) */
-        .input_rate = SDL_GPU_VERTEXINPUTRATE_VERTEX,
-        .slot = 0,
-        .instance_step_rate = 0
-    };
-    
-    vertexInput.vertex_buffer_descriptions = &vertexBuffer;
-    vertexInput.num_vertex_buffers = 1;
-    vertexInput.vertex_attributes = s_default_vertex_attributes;
-    vertexInput.num_vertex_attributes = s_num_vertex_attributes;
-    
-    createInfo.vertex_input_state = vertexInput;
-    
-    /* Set up rasterizer state */
-    SDL_GPURasterizerState rasterizerState = {
-        .fill_mode = SDL_GPU_FILLMODE_FILL,
-        .cull_mode = SDL_GPU_CULLMODE_BACK,
-        .front_face = SDL_GPU_FRONTFACE_COUNTER_CLOCKWISE,
-        .enable_depth_clip = true,
-        .enable_depth_bias = false,
-        .depth_bias_constant_factor = 0.0f,
-        .depth_bias_clamp = 0.0f,
-        .depth_bias_slope_factor = 0.0f
-    };
-    
-    createInfo.rasterizer_state = rasterizerState;
-    
-    /* Set up depth-stencil state */
-    SDL_GPUDepthStencilState depthStencilState = {
-        .enable_depth_test = true,
-        .enable_depth_write = true,
-        .compare_op = SDL_GPU_COMPAREOP_LESS,
-        .enable_stencil_test = false,
-        .compare_mask = 0xFF,
-        .write_mask = 0xFF,
-        .front_stencil_state = {
-            .fail_op = SDL_GPU_STENCILOP_KEEP,
-            .pass_op = SDL_GPU_STENCILOP_KEEP,
-            .depth_fail_op = SDL_GPU_STENCILOP_KEEP,
-            .compare_op = SDL_GPU_COMPAREOP_ALWAYS
-        },
-        .back_stencil_state = {
-            .fail_op = SDL_GPU_STENCILOP_KEEP,
-            .pass_op = SDL_GPU_STENCILOP_KEEP,
-            .depth_fail_op = SDL_GPU_STENCILOP_KEEP,
-            .compare_op = SDL_GPU_COMPAREOP_ALWAYS
-        }
-    };
-    
-    createInfo.depth_stencil_state = depthStencilState;
-    
-    /* Set up multisample state */
-    SDL_GPUMultisampleState multisampleState = {
-        .sample_count = SDL_GPU_SAMPLECOUNT_1,
-        .sample_mask = 0xFFFFFFFF,
-        .enable_mask = false
-    };
-    
-    createInfo.multisample_state = multisampleState;
-    
-    /* Set up color blend state for the render target */
-    SDL_GPUColorTargetBlendState colorTargetBlendState = {
-        .enable_blend = false,
-        .src_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE,
-        .dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ZERO,
-        .color_blend_op = SDL_GPU_BLENDOP_ADD,
-        .src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE,
-        .dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ZERO,
-        .alpha_blend_op = SDL_GPU_BLENDOP_ADD,
-        .color_write_mask = SDL_GPU_COLORCOMPONENT_R | SDL_GPU_COLORCOMPONENT_G | 
-                           SDL_GPU_COLORCOMPONENT_B | SDL_GPU_COLORCOMPONENT_A,
-        .enable_color_write_mask = true
-    };
-    
-    /* Set up render target info */
-    SDL_GPUColorTargetDescription colorTarget = {
-        .format = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM,
-        .blend_state = colorTargetBlendState
-    };
-    
-    /* Set up pipeline target info */
-    SDL_GPUGraphicsPipelineTargetInfo targetInfo = {
-        .color_target_descriptions = &colorTarget,
-        .num_color_targets = 1,
-        .has_depth_stencil_target = true,
-        .depth_stencil_format = SDL_GPU_TEXTUREFORMAT_D32_FLOAT
-    };
-    
-    createInfo.target_info = targetInfo;
-    
-    /* Create the pipeline */
-    SDL_GPUGraphicsPipeline* pipeline = SDL_CreateGPUGraphicsPipeline(shader->device, &createInfo);
+    /* Default variant (opaque, back face culling, depth tested). With a pipeline
+     * cache for the device the variant is shared with the cache, which owns it */
+    NexusPipelineCache* cache = nexus_pipeline_cache_get(shader->device);
+    NexusPipelineState state;
+    nexus_pipeline_cache_get_state(cache, NULL, &state);
+    state.vertex_layout = shader->vertex_layout;
+
+    SDL_GPUGraphicsPipeline* pipeline = cache != NULL ?
+        nexus_pipeline_cache_acquire(cache, shader, &state) :
+        nexus_pipeline_create(shader->device, shader, &state);
     if (pipeline == NULL) {
-        fprintf(stderr, "Failed to create graphics pipeline: %s\n", SDL_GetError());
+        fprintf(stderr, "Failed to create graphics pipeline for shader '%s'\n", shader->name);
         return false;
     }
-    
-    /* Release previous pipeline if exists */
-    if (shader->pipeline != NULL) {
+
+    /* Release previous pipeline if this shader owns it */
+    if (shader->pipeline != NULL && !shader->pipeline_cached) {
         SDL_ReleaseGPUGraphicsPipeline(shader->device, shader->pipeline);
     }
-    
+
     /* Store the pipeline */
     shader->pipeline = pipeline;
+    shader->pipeline_cached = cache != NULL;
+
+    /* Resolve uniform names once so setters never search at draw time */
+    nexus_shader_resolve_uniforms(shader);
     
     return true;
 }
@@ -383,6 +395,112 @@ void nexus_shader_bind(NexusShader* shader, SDL_GPURenderPass* render_pass) {
     SDL_BindGPUGraphicsPipeline(render_pass, shader->pipeline);
 }
 
+/**
+ * Resolve a uniform name to a handle (do this once, not per draw)
+ */
+NexusUniformHandle nexus_shader_get_uniform(const NexusShader* shader, const char* name) {
+    NexusUniformHandle invalid = { -1, 0, 0 };
+
+    int32_t slot = nexus_shader_get_uniform_slot(shader, name);
+    return slot >= 0 ? shader->uniforms[slot].handle : invalid;
+}
+
+/**
+ * Resolve a uniform name to its slot in the shader's uniform table (-1 = not found)
+ * Resolve once and set through nexus_shader_set_uniform_slot per draw
+ */
+int32_t nexus_shader_get_uniform_slot(const NexusShader* shader, const char* name) {
+    if (shader == NULL || name == NULL) {
+        return -1;
+    }
+
+    uint32_t hash = nexus_shader_hash_name(name);
+    uint32_t slot = hash & (NEXUS_SHADER_UNIFORM_LOOKUP_SIZE - 1);
+    while (shader->uniform_lookup[slot] != 0) {
+        const NexusShaderUniform* uniform = &shader->uniforms[shader->uniform_lookup[slot] - 1];
+        if (uniform->hash == hash && strcmp(uniform->name, name) == 0) {
+            return (int32_t)(shader->uniform_lookup[slot] - 1);
+        }
+        slot = (slot + 1) & (NEXUS_SHADER_UNIFORM_LOOKUP_SIZE - 1);
+    }
+
+    return -1;
+}
+
+/**
+ * Write uniform data through a slot from nexus_shader_get_uniform_slot
+ */
+void nexus_shader_set_uniform_slot(NexusShader* shader, int32_t slot, const void* data, uint32_t size) {
+    if (shader == NULL || slot < 0 || (uint32_t)slot >= shader->uniform_count) {
+        return;
+    }
+
+    nexus_shader_set_uniform_data(shader, shader->uniforms[slot].handle, data, size);
+}
+
+/**
+ * Write uniform data through a handle
+ * The data lands in the shader's block shadow copy and is pushed on the next
+ * nexus_shader_push_uniforms call
+ */
+void nexus_shader_set_uniform_data(NexusShader* shader, NexusUniformHandle handle, const void* data, uint32_t size) {
+    if (shader == NULL || data == NULL || handle.block < 0 || handle.block >= NEXUS_UNIFORM_BLOCK_COUNT) {
+        return;
+    }
+
+    /* Clamp to the resolved size */
+    if (size > handle.size) {
+        size = handle.size;
+    }
+
+    NexusUniformBlockData* block = &shader->blocks[handle.block];
+    if (handle.offset + size > block->size) {
+        return;
+    }
+
+    memcpy(block->data + handle.offset, data, size);
+    block->used = true;
+    block->dirty = true;
+}
+
+/**
+ * Push the shader's uniform blocks to the command buffer
+ * Dirty blocks are always pushed, force also re-pushes every written block
+ * (needed after switching to this shader) except the frame block, which the
+ * renderer pushes itself once per frame
+ */
+void nexus_shader_push_uniforms(NexusShader* shader, SDL_GPUCommandBuffer* cmd_buffer, bool force) {
+    if (shader == NULL || cmd_buffer == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < NEXUS_UNIFORM_BLOCK_COUNT; i++) {
+        NexusUniformBlockData* block = &shader->blocks[i];
+        bool restore = force && block->used && i != NEXUS_UNIFORM_BLOCK_FRAME;
+        if (!block->dirty && !restore) {
+            continue;
+        }
+
+        /* Route the block to its fixed slots */
+        switch (i) {
+            case NEXUS_UNIFORM_BLOCK_FRAME:
+                SDL_PushGPUVertexUniformData(cmd_buffer, NEXUS_UNIFORM_SLOT_VERTEX_FRAME, block->data, block->size);
+                SDL_PushGPUFragmentUniformData(cmd_buffer, NEXUS_UNIFORM_SLOT_FRAGMENT_FRAME, block->data, block->size);
+                break;
+            case NEXUS_UNIFORM_BLOCK_OBJECT:
+                SDL_PushGPUVertexUniformData(cmd_buffer, NEXUS_UNIFORM_SLOT_VERTEX_OBJECT, block->data, block->size);
+                break;
+            case NEXUS_UNIFORM_BLOCK_MATERIAL:
+                SDL_PushGPUFragmentUniformData(cmd_buffer, NEXUS_UNIFORM_SLOT_FRAGMENT_MATERIAL, block->data, block->size);
+                break;
+            default:
+                break;
+        }
+
+        block->dirty = false;
+    }
+}
+
 /**
  * Set uniform float
  */
@@ -390,10 +508,8 @@ void nexus_shader_set_uniform_float(NexusShader* shader, const char* name, float
     if (shader == NULL || name == NULL) {
         return;
     }
-    
-    /* TODO: Implement uniform binding based on shader reflection or manual slot assignments */
-    /* For now, this is a placeholder as the actual implementation depends on how uniforms
-     * are handled in the SDL3 GPU API */
+
+    nexus_shader_set_uniform_slot(shader, nexus_shader_get_uniform_slot(shader, name), &value, sizeof(value));
 }
 
 /**
@@ -403,8 +519,9 @@ void nexus_shader_set_uniform_float2(NexusShader* shader, const char* name, floa
     if (shader == NULL || name == NULL) {
         return;
     }
-    
-    /* TODO: Implement uniform binding */
+
+    float value[2] = { x, y };
+    nexus_shader_set_uniform_slot(shader, nexus_shader_get_uniform_slot(shader, name), value, sizeof(value));
 }
 
 /**
@@ -414,8 +531,9 @@ void nexus_shader_set_uniform_float3(NexusShader* shader, const char* name, floa
     if (shader == NULL || name == NULL) {
         return;
     }
-    
-    /* TODO: Implement uniform binding */
+
+    float value[3] = { x, y, z };
+    nexus_shader_set_uniform_slot(shader, nexus_shader_get_uniform_slot(shader, name), value, sizeof(value));
 }
 
 /**
@@ -425,8 +543,9 @@ void nexus_shader_set_uniform_float4(NexusShader* shader, const char* name, floa
     if (shader == NULL || name == NULL) {
         return;
     }
-    
-    /* TODO: Implement uniform binding */
+
+    float value[4] = { x, y, z, w };
+    nexus_shader_set_uniform_slot(shader, nexus_shader_get_uniform_slot(shader, name), value, sizeof(value));
 }
 
 /**
@@ -436,8 +555,8 @@ void nexus_shader_set_uniform_int(NexusShader* shader, const char* name, int val
     if (shader == NULL || name == NULL) {
         return;
     }
-    
-    /* TODO: Implement uniform binding */
+
+    nexus_shader_set_uniform_slot(shader, nexus_shader_get_uniform_slot(shader, name), &value, sizeof(value));
 }
 
 /**
@@ -447,6 +566,6 @@ void nexus_shader_set_uniform_matrix4(NexusShader* shader, const char* name, con
     if (shader == NULL || name == NULL || matrix == NULL) {
         return;
     }
-    
-    /* TODO: Implement uniform binding */
+
+    nexus_shader_set_uniform_slot(shader, nexus_shader_get_uniform_slot(shader, name), matrix, sizeof(float) * 16);
 }
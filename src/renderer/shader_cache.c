@@ -0,0 +1,603 @@
+/**
+ * Nexus3D Shader Cache Implementation
+ * Content-addressed shader blobs and the persisted pipeline variant list
+ */
+
+#include "nexus3d/renderer/shader_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Number of devices that can have a shader cache at the same time */
+#define NEXUS_SHADER_CACHE_MAX_DEVICES 4
+
+/* File identification ("NXSB" blob, "NXPL" pipeline list) */
+#define NEXUS_SHADER_BLOB_MAGIC    0x4253584Eu
+#define NEXUS_PIPELINE_LIST_MAGIC  0x4C50584Eu
+#define NEXUS_SHADER_CACHE_VERSION 3u
+
+/* Pipeline list file name inside the cache directory */
+#define NEXUS_PIPELINE_LIST_FILE "pipelines.nxp"
+
+/**
+ * Blob file header, followed by the code
+ */
+typedef struct {
+    uint32_t magic;                /* NEXUS_SHADER_BLOB_MAGIC */
+    uint32_t version;              /* NEXUS_SHADER_CACHE_VERSION */
+    uint64_t hash;                 /* Content hash the blob was built for */
+    uint32_t format;               /* SDL_GPUShaderFormat of the code */
+    uint32_t code_size;            /* Code size in bytes */
+} NexusShaderBlobHeader;
+
+/**
+ * Pipeline list file header, followed by the records
+ */
+typedef struct {
+    uint32_t magic;                /* NEXUS_PIPELINE_LIST_MAGIC */
+    uint32_t version;              /* NEXUS_SHADER_CACHE_VERSION */
+    uint32_t record_size;          /* sizeof(NexusPipelineRecord) */
+    uint32_t record_count;         /* Number of records */
+} NexusPipelineListHeader;
+
+/* Shader cache registered for each device */
+static struct {
+    SDL_GPUDevice* device;
+    NexusShaderCache* cache;
+} s_shader_caches[NEXUS_SHADER_CACHE_MAX_DEVICES];
+
+/**
+ * FNV-1a over a block of bytes, continuing from a previous hash
+ */
+static uint64_t nexus_shader_cache_fnv1a(uint64_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * Build the path of a file inside the cache directory
+ */
+static bool nexus_shader_cache_path(const NexusShaderCache* cache, const char* name, char* path, size_t size) {
+    int length = snprintf(path, size, "%s/%s", cache->directory, name);
+    return length > 0 && (size_t)length < size;
+}
+
+/**
+ * Build the path of the blob for a content hash
+ */
+static bool nexus_shader_cache_blob_path(const NexusShaderCache* cache, uint64_t hash, char* path, size_t size) {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.nxs", (unsigned long long)hash);
+    return nexus_shader_cache_path(cache, name, path, size);
+}
+
+/**
+ * Write a file atomically (temporary file + rename) so a crash never leaves a torn entry
+ */
+static bool nexus_shader_cache_write_file(const char* path, const void* header, size_t header_size,
+                                          const void* data, size_t data_size) {
+    char temp_path[NEXUS_SHADER_CACHE_MAX_PATH + 8];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+
+    FILE* file = fopen(temp_path, "wb");
+    if (file == NULL) {
+        return false;
+    }
+
+    bool written = fwrite(header, 1, header_size, file) == header_size &&
+                   (data_size == 0 || fwrite(data, 1, data_size, file) == data_size);
+    written = fclose(file) == 0 && written;
+    if (!written) {
+        remove(temp_path);
+        return false;
+    }
+
+    /* rename does not replace existing files everywhere */
+    if (rename(temp_path, path) != 0) {
+        remove(path);
+        if (rename(temp_path, path) != 0) {
+            remove(temp_path);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Convert between pipeline states and their fixed size records
+ */
+static void nexus_shader_cache_make_record(const NexusShader* shader, const NexusPipelineState* state,
+                                           NexusPipelineRecord* record) {
+    memset(record, 0, sizeof(NexusPipelineRecord));
+    record->vertex_hash = shader->vertex_hash;
+    record->fragment_hash = shader->fragment_hash;
+    record->vertex_layout = state->vertex_layout;
+    record->blend_mode = (uint32_t)state->blend_mode;
+    record->cull_mode = (uint32_t)state->cull_mode;
+    record->fill_mode = (uint32_t)state->fill_mode;
+    record->color_write = state->color_write ? 1u : 0u;
+    record->depth_test = state->depth_test ? 1u : 0u;
+    record->depth_write = state->depth_write ? 1u : 0u;
+    record->depth_compare = (uint32_t)state->depth_compare;
+    record->depth_bias = state->depth_bias;
+    record->depth_bias_slope = state->depth_bias_slope;
+    record->color_format = (uint32_t)state->color_format;
+    record->depth_format = (uint32_t)state->depth_format;
+    record->sample_count = (uint32_t)state->sample_count;
+}
+
+static void nexus_shader_cache_record_state(const NexusPipelineRecord* record, NexusPipelineState* state) {
+    memset(state, 0, sizeof(NexusPipelineState));
+    state->vertex_layout = record->vertex_layout;
+    state->blend_mode = (NexusBlendMode)record->blend_mode;
+    state->cull_mode = (SDL_GPUCullMode)record->cull_mode;
+    state->fill_mode = (SDL_GPUFillMode)record->fill_mode;
+    state->color_write = record->color_write != 0;
+    state->depth_test = record->depth_test != 0;
+    state->depth_write = record->depth_write != 0;
+    state->depth_compare = (SDL_GPUCompareOp)record->depth_compare;
+    state->depth_bias = record->depth_bias;
+    state->depth_bias_slope = record->depth_bias_slope;
+    state->color_format = (SDL_GPUTextureFormat)record->color_format;
+    state->depth_format = (SDL_GPUTextureFormat)record->depth_format;
+    state->sample_count = (SDL_GPUSampleCount)record->sample_count;
+}
+
+/**
+ * Append a record if it is not in the list yet (lock held)
+ */
+static bool nexus_shader_cache_add_record(NexusShaderCache* cache, const NexusPipelineRecord* record) {
+    for (uint32_t i = 0; i < cache->record_count; i++) {
+        if (memcmp(&cache->records[i], record, sizeof(NexusPipelineRecord)) == 0) {
+            return false;
+        }
+    }
+
+    /* Grow the list */
+    if (cache->record_count >= cache->record_capacity) {
+        uint32_t new_capacity = cache->record_capacity > 0 ? cache->record_capacity * 2 : 64;
+        NexusPipelineRecord* records = (NexusPipelineRecord*)realloc(cache->records,
+                                                                     new_capacity * sizeof(NexusPipelineRecord));
+        if (records == NULL) {
+            fprintf(stderr, "Failed to grow pipeline list!\n");
+            return false;
+        }
+        cache->records = records;
+        cache->record_capacity = new_capacity;
+    }
+
+    cache->records[cache->record_count++] = *record;
+    return true;
+}
+
+/**
+ * Load the pipeline list written by a previous run
+ */
+static void nexus_shader_cache_load_records(NexusShaderCache* cache) {
+    char path[NEXUS_SHADER_CACHE_MAX_PATH];
+    if (!nexus_shader_cache_path(cache, NEXUS_PIPELINE_LIST_FILE, path, sizeof(path))) {
+        return;
+    }
+
+    NexusMappedFile file;
+    if (!nexus_mapped_file_open(&file, path)) {
+        return;
+    }
+
+    /* Validate the header, a stale or foreign list is ignored and rewritten */
+    NexusPipelineListHeader header;
+    bool valid = file.size >= sizeof(header);
+    if (valid) {
+        memcpy(&header, file.data, sizeof(header));
+        valid = header.magic == NEXUS_PIPELINE_LIST_MAGIC &&
+                header.version == NEXUS_SHADER_CACHE_VERSION &&
+                header.record_size == sizeof(NexusPipelineRecord) &&
+                (file.size - sizeof(header)) / sizeof(NexusPipelineRecord) >= header.record_count;
+    }
+
+    if (valid) {
+        const uint8_t* data = (const uint8_t*)file.data + sizeof(header);
+        for (uint32_t i = 0; i < header.record_count; i++) {
+            NexusPipelineRecord record;
+            memcpy(&record, data + i * sizeof(NexusPipelineRecord), sizeof(record));
+            nexus_shader_cache_add_record(cache, &record);
+        }
+    }
+
+    nexus_mapped_file_close(&file);
+}
+
+/**
+ * Prewarm worker, creates the queued pipelines through the device's pipeline cache
+ */
+static int nexus_shader_cache_prewarm_worker(void* data) {
+    NexusShaderCache* cache = (NexusShaderCache*)data;
+    NexusPipelineCache* pipeline_cache = nexus_pipeline_cache_get(cache->device);
+
+    for (uint32_t i = 0; i < cache->job_count; i++) {
+        nexus_pipeline_cache_acquire(pipeline_cache, cache->jobs[i].shader, &cache->jobs[i].state);
+        SDL_AddAtomicInt(&cache->jobs_done, 1);
+    }
+
+    return 0;
+}
+
+/**
+ * Create a shader cache in a directory and register it for the device
+ */
+NexusShaderCache* nexus_shader_cache_create(SDL_GPUDevice* device, const char* directory) {
+    /* Check for null parameters */
+    if (device == NULL || directory == NULL) {
+        fprintf(stderr, "GPU device and directory are required to create a shader cache!\n");
+        return NULL;
+    }
+
+    if (strlen(directory) >= NEXUS_SHADER_CACHE_MAX_PATH - 32) {
+        fprintf(stderr, "Shader cache path is too long: %s\n", directory);
+        return NULL;
+    }
+
+    /* Make sure the directory exists */
+    if (!SDL_CreateDirectory(directory)) {
+        fprintf(stderr, "Failed to create shader cache directory %s: %s\n", directory, SDL_GetError());
+        return NULL;
+    }
+
+    /* Allocate cache structure */
+    NexusShaderCache* cache = (NexusShaderCache*)malloc(sizeof(NexusShaderCache));
+    if (cache == NULL) {
+        fprintf(stderr, "Failed to allocate memory for shader cache!\n");
+        return NULL;
+    }
+
+    /* Initialize cache structure */
+    memset(cache, 0, sizeof(NexusShaderCache));
+    cache->device = device;
+    strcpy(cache->directory, directory);
+
+    cache->lock = SDL_CreateMutex();
+    if (cache->lock == NULL) {
+        fprintf(stderr, "Failed to create shader cache lock: %s\n", SDL_GetError());
+        free(cache);
+        return NULL;
+    }
+
+    /* Pick up the variants previous runs used */
+    nexus_shader_cache_load_records(cache);
+
+    /* Register for the device */
+    for (int i = 0; i < NEXUS_SHADER_CACHE_MAX_DEVICES; i++) {
+        if (s_shader_caches[i].device == NULL) {
+            s_shader_caches[i].device = device;
+            s_shader_caches[i].cache = cache;
+            break;
+        }
+    }
+
+    return cache;
+}
+
+/**
+ * Destroy a shader cache, saving the pipeline list if it changed
+ */
+void nexus_shader_cache_destroy(NexusShaderCache* cache) {
+    if (cache == NULL) {
+        return;
+    }
+
+    /* Let the worker finish before anything it uses goes away */
+    nexus_shader_cache_wait(cache);
+    nexus_shader_cache_save(cache);
+
+    /* Unregister */
+    for (int i = 0; i < NEXUS_SHADER_CACHE_MAX_DEVICES; i++) {
+        if (s_shader_caches[i].cache == cache) {
+            s_shader_caches[i].device = NULL;
+            s_shader_caches[i].cache = NULL;
+        }
+    }
+
+    /* Free cache structure */
+    SDL_DestroyMutex(cache->lock);
+    free(cache->records);
+    free(cache);
+}
+
+/**
+ * Get the shader cache registered for a device (NULL if there is none)
+ */
+NexusShaderCache* nexus_shader_cache_get(SDL_GPUDevice* device) {
+    if (device == NULL) {
+        return NULL;
+    }
+
+    for (int i = 0; i < NEXUS_SHADER_CACHE_MAX_DEVICES; i++) {
+        if (s_shader_caches[i].device == device) {
+            return s_shader_caches[i].cache;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Set the translator used for sources the device cannot consume directly
+ */
+void nexus_shader_cache_set_compiler(NexusShaderCache* cache, NexusShaderCompileFunc compiler, void* user_data) {
+    if (cache == NULL) {
+        return;
+    }
+
+    cache->compiler = compiler;
+    cache->compiler_data = user_data;
+}
+
+/**
+ * Content hash of shader code for a stage, source format and GPU driver
+ * Never returns 0 so 0 can mean "no module"
+ */
+uint64_t nexus_shader_cache_hash(SDL_GPUDevice* device, SDL_GPUShaderStage stage, SDL_GPUShaderFormat format,
+                                 const void* code, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+
+    /* Blobs and pipelines are only valid for the driver that built them */
+    const char* driver = device != NULL ? SDL_GetGPUDeviceDriver(device) : NULL;
+    if (driver != NULL) {
+        hash = nexus_shader_cache_fnv1a(hash, driver, strlen(driver));
+    }
+
+    uint32_t params[2] = { (uint32_t)stage, (uint32_t)format };
+    hash = nexus_shader_cache_fnv1a(hash, params, sizeof(params));
+    if (code != NULL) {
+        hash = nexus_shader_cache_fnv1a(hash, code, size);
+    }
+
+    return hash != 0 ? hash : 1;
+}
+
+/**
+ * Get device-ready code for a source the device cannot consume directly
+ * Hits map the stored blob, misses run the translator and store its output
+ */
+bool nexus_shader_cache_get_blob(NexusShaderCache* cache, uint64_t hash, const void* source, size_t source_size,
+                                 NexusShaderLanguage language, SDL_GPUShaderStage stage, NexusShaderBlob* blob) {
+    if (cache == NULL || source == NULL || blob == NULL) {
+        return false;
+    }
+
+    memset(blob, 0, sizeof(NexusShaderBlob));
+
+    char path[NEXUS_SHADER_CACHE_MAX_PATH];
+    if (!nexus_shader_cache_blob_path(cache, hash, path, sizeof(path))) {
+        return false;
+    }
+
+    /* Hit, use the stored code straight from the mapping */
+    if (nexus_mapped_file_open(&blob->file, path)) {
+        NexusShaderBlobHeader header;
+        if (blob->file.size >= sizeof(header)) {
+            memcpy(&header, blob->file.data, sizeof(header));
+            if (header.magic == NEXUS_SHADER_BLOB_MAGIC && header.version == NEXUS_SHADER_CACHE_VERSION &&
+                header.hash == hash && blob->file.size - sizeof(header) >= header.code_size) {
+                blob->code = (const uint8_t*)blob->file.data + sizeof(header);
+                blob->size = header.code_size;
+                blob->format = (SDL_GPUShaderFormat)header.format;
+                cache->blob_hits++;
+                return true;
+            }
+        }
+
+        /* Stale entry, rebuild it below */
+        nexus_mapped_file_close(&blob->file);
+    }
+
+    if (cache->compiler == NULL) {
+        return false;
+    }
+
+    /* Translate to the first format the device supports */
+    SDL_GPUShaderFormat formats = SDL_GetGPUShaderFormats(cache->device);
+    static const SDL_GPUShaderFormat s_preferred_formats[] = {
+        SDL_GPU_SHADERFORMAT_SPIRV, SDL_GPU_SHADERFORMAT_DXIL, SDL_GPU_SHADERFORMAT_METALLIB,
+        SDL_GPU_SHADERFORMAT_MSL, SDL_GPU_SHADERFORMAT_DXBC
+    };
+    SDL_GPUShaderFormat format = SDL_GPU_SHADERFORMAT_INVALID;
+    for (size_t i = 0; i < sizeof(s_preferred_formats) / sizeof(s_preferred_formats[0]); i++) {
+        if (formats & s_preferred_formats[i]) {
+            format = s_preferred_formats[i];
+            break;
+        }
+    }
+    if (format == SDL_GPU_SHADERFORMAT_INVALID) {
+        return false;
+    }
+
+    void* code = NULL;
+    size_t code_size = 0;
+    if (!cache->compiler(source, source_size, language, stage, format, &code, &code_size, cache->compiler_data) ||
+        code == NULL || code_size == 0 || code_size > UINT32_MAX) {
+        free(code);
+        fprintf(stderr, "Failed to translate shader source for the GPU driver!\n");
+        return false;
+    }
+
+    blob->code = code;
+    blob->size = code_size;
+    blob->format = format;
+    blob->compiled = code;
+    cache->blob_misses++;
+
+    /* Store for the next run, failing to write only costs the next run a translation */
+    NexusShaderBlobHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = NEXUS_SHADER_BLOB_MAGIC;
+    header.version = NEXUS_SHADER_CACHE_VERSION;
+    header.hash = hash;
+    header.format = (uint32_t)format;
+    header.code_size = (uint32_t)code_size;
+    if (!nexus_shader_cache_write_file(path, &header, sizeof(header), code, code_size)) {
+        fprintf(stderr, "Failed to write shader cache entry: %s\n", path);
+    }
+
+    return true;
+}
+
+/**
+ * Release a blob returned by nexus_shader_cache_get_blob
+ */
+void nexus_shader_cache_release_blob(NexusShaderBlob* blob) {
+    if (blob == NULL) {
+        return;
+    }
+
+    nexus_mapped_file_close(&blob->file);
+    free(blob->compiled);
+    memset(blob, 0, sizeof(NexusShaderBlob));
+}
+
+/**
+ * Remember a pipeline variant so the next run can create it before the first frame
+ */
+void nexus_shader_cache_record_pipeline(NexusShaderCache* cache, const NexusShader* shader,
+                                        const NexusPipelineState* state) {
+    if (cache == NULL || shader == NULL || state == NULL ||
+        shader->vertex_hash == 0 || shader->fragment_hash == 0) {
+        return;
+    }
+
+    NexusPipelineRecord record;
+    nexus_shader_cache_make_record(shader, state, &record);
+
+    SDL_LockMutex(cache->lock);
+    if (nexus_shader_cache_add_record(cache, &record)) {
+        cache->records_dirty = true;
+    }
+    SDL_UnlockMutex(cache->lock);
+}
+
+/**
+ * Write the pipeline list if it changed
+ */
+bool nexus_shader_cache_save(NexusShaderCache* cache) {
+    if (cache == NULL) {
+        return false;
+    }
+
+    char path[NEXUS_SHADER_CACHE_MAX_PATH];
+    if (!nexus_shader_cache_path(cache, NEXUS_PIPELINE_LIST_FILE, path, sizeof(path))) {
+        return false;
+    }
+
+    SDL_LockMutex(cache->lock);
+
+    bool saved = true;
+    if (cache->records_dirty) {
+        NexusPipelineListHeader header;
+        memset(&header, 0, sizeof(header));
+        header.magic = NEXUS_PIPELINE_LIST_MAGIC;
+        header.version = NEXUS_SHADER_CACHE_VERSION;
+        header.record_size = sizeof(NexusPipelineRecord);
+        header.record_count = cache->record_count;
+
+        saved = nexus_shader_cache_write_file(path, &header, sizeof(header), cache->records,
+                                              cache->record_count * sizeof(NexusPipelineRecord));
+        if (saved) {
+            cache->records_dirty = false;
+        } else {
+            fprintf(stderr, "Failed to write pipeline list: %s\n", path);
+        }
+    }
+
+    SDL_UnlockMutex(cache->lock);
+    return saved;
+}
+
+/**
+ * Create the recorded variants of the given shaders on a background thread
+ * Call after the shaders are compiled and before the first frame, returns the number of variants queued
+ */
+uint32_t nexus_shader_cache_prewarm(NexusShaderCache* cache, const NexusShader* const* shaders, uint32_t count) {
+    if (cache == NULL || shaders == NULL || nexus_pipeline_cache_get(cache->device) == NULL) {
+        return 0;
+    }
+
+    /* One prewarm at a time */
+    nexus_shader_cache_wait(cache);
+
+    SDL_LockMutex(cache->lock);
+
+    /* Collect the recorded variants of these shaders */
+    NexusPipelinePrewarmJob* jobs = NULL;
+    uint32_t job_count = 0;
+    if (cache->record_count > 0) {
+        jobs = (NexusPipelinePrewarmJob*)malloc(cache->record_count * sizeof(NexusPipelinePrewarmJob));
+    }
+    for (uint32_t i = 0; jobs != NULL && i < cache->record_count; i++) {
+        const NexusPipelineRecord* record = &cache->records[i];
+        for (uint32_t j = 0; j < count; j++) {
+            const NexusShader* shader = shaders[j];
+            if (shader != NULL && shader->vertex_shader != NULL && shader->fragment_shader != NULL &&
+                shader->vertex_hash == record->vertex_hash && shader->fragment_hash == record->fragment_hash) {
+                jobs[job_count].shader = shader;
+                nexus_shader_cache_record_state(record, &jobs[job_count].state);
+                job_count++;
+                break;
+            }
+        }
+    }
+
+    SDL_UnlockMutex(cache->lock);
+
+    if (job_count == 0) {
+        free(jobs);
+        return 0;
+    }
+
+    cache->jobs = jobs;
+    cache->job_count = job_count;
+    SDL_SetAtomicInt(&cache->jobs_done, 0);
+
+    /* Build on a worker, or inline if no thread can be started */
+    cache->prewarm_thread = SDL_CreateThread(nexus_shader_cache_prewarm_worker, "NexusPipelinePrewarm", cache);
+    if (cache->prewarm_thread == NULL) {
+        nexus_shader_cache_prewarm_worker(cache);
+        free(cache->jobs);
+        cache->jobs = NULL;
+        cache->job_count = 0;
+    }
+
+    return job_count;
+}
+
+/**
+ * Check whether the background prewarm is still running
+ */
+bool nexus_shader_cache_is_prewarming(NexusShaderCache* cache) {
+    if (cache == NULL || cache->prewarm_thread == NULL) {
+        return false;
+    }
+
+    return (uint32_t)SDL_GetAtomicInt(&cache->jobs_done) < cache->job_count;
+}
+
+/**
+ * Wait for the background prewarm to finish
+ * Shaders being prewarmed must not be destroyed before this returns
+ */
+void nexus_shader_cache_wait(NexusShaderCache* cache) {
+    if (cache == NULL || cache->prewarm_thread == NULL) {
+        return;
+    }
+
+    SDL_WaitThread(cache->prewarm_thread, NULL);
+    cache->prewarm_thread = NULL;
+
+    free(cache->jobs);
+    cache->jobs = NULL;
+    cache->job_count = 0;
+}
@@ -0,0 +1,1025 @@
+/**
+ * Nexus3D Shadow Atlas Implementation
+ * Quadtree tile allocation, light views and cascades, and the caster
+ * signatures that decide which tiles have to be rendered again
+ */
+
+#include "nexus3d/renderer/shadow_atlas.h"
+#include "nexus3d/math/math_utils.h"
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Quadtree node states */
+#define NEXUS_SHADOW_NODE_NONE  0  /* Covered by an ancestor */
+#define NEXUS_SHADOW_NODE_FREE  1  /* Available as a whole */
+#define NEXUS_SHADOW_NODE_SPLIT 2  /* Children are allocated individually */
+#define NEXUS_SHADOW_NODE_USED  3  /* Allocated tile */
+
+/* Largest atlas 16 bit tile coordinates can address */
+#define NEXUS_SHADOW_MAX_ATLAS_SIZE 16384
+
+/* Initial caster capacity */
+#define NEXUS_SHADOW_INITIAL_CASTERS 256
+
+/* Widest spot cone that gets a shadow map (half angle in degrees) */
+#define NEXUS_SHADOW_MAX_SPOT_ANGLE 85.0f
+
+/* Cube face directions and up vectors (+X -X +Y -Y +Z -Z) */
+static const float s_cube_faces[NEXUS_SHADOW_MAX_FACES][2][3] = {
+    { {  1.0f,  0.0f,  0.0f }, { 0.0f, -1.0f,  0.0f } },
+    { { -1.0f,  0.0f,  0.0f }, { 0.0f, -1.0f,  0.0f } },
+    { {  0.0f,  1.0f,  0.0f }, { 0.0f,  0.0f,  1.0f } },
+    { {  0.0f, -1.0f,  0.0f }, { 0.0f,  0.0f, -1.0f } },
+    { {  0.0f,  0.0f,  1.0f }, { 0.0f, -1.0f,  0.0f } },
+    { {  0.0f,  0.0f, -1.0f }, { 0.0f, -1.0f,  0.0f } }
+};
+
+/**
+ * First node of a quadtree level
+ */
+static uint32_t nexus_shadow_level_offset(uint32_t level) {
+    return ((1u << (2 * level)) - 1) / 3;
+}
+
+/**
+ * Hash bytes (FNV-1a, continuing from hash)
+ */
+static uint64_t nexus_shadow_hash(const void* data, size_t size, uint64_t hash) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+/**
+ * Scramble a hash so sums of hashes stay well distributed
+ */
+static uint64_t nexus_shadow_mix(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/**
+ * Pick a depth format the device can render to and sample
+ * Shadow maps only need 16 bits, which halves the fill and sampling bandwidth
+ */
+static SDL_GPUTextureFormat nexus_shadow_atlas_choose_format(SDL_GPUDevice* device) {
+    static const SDL_GPUTextureFormat s_shadow_formats[] = {
+        SDL_GPU_TEXTUREFORMAT_D16_UNORM,
+        SDL_GPU_TEXTUREFORMAT_D32_FLOAT
+    };
+
+    for (size_t i = 0; i < sizeof(s_shadow_formats) / sizeof(s_shadow_formats[0]); i++) {
+        if (SDL_GPUTextureSupportsFormat(device, s_shadow_formats[i], SDL_GPU_TEXTURETYPE_2D,
+                                         SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET | SDL_GPU_TEXTUREUSAGE_SAMPLER)) {
+            return s_shadow_formats[i];
+        }
+    }
+
+    return SDL_GPU_TEXTUREFORMAT_INVALID;
+}
+
+/**
+ * Create the quad that resets a tile to the far plane (drawn with an identity transform)
+ */
+static NexusMesh* nexus_shadow_atlas_create_clear_mesh(SDL_GPUDevice* device) {
+    NexusVertex vertices[4];
+    memset(vertices, 0, sizeof(vertices));
+    vertices[0].position[0] = -1.0f; vertices[0].position[1] = -1.0f;
+    vertices[1].position[0] =  1.0f; vertices[1].position[1] = -1.0f;
+    vertices[2].position[0] =  1.0f; vertices[2].position[1] =  1.0f;
+    vertices[3].position[0] = -1.0f; vertices[3].position[1] =  1.0f;
+    static const uint32_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+
+    NexusMesh* mesh = nexus_mesh_create(device);
+    if (mesh == NULL) {
+        return NULL;
+    }
+
+    nexus_mesh_set_vertex_layout(mesh, NEXUS_VERTEX_LAYOUT_POSITION, false);
+    if (!nexus_mesh_set_vertices(mesh, vertices, 4) || !nexus_mesh_set_indices(mesh, indices, 6)) {
+        nexus_mesh_destroy(mesh);
+        return NULL;
+    }
+
+    return mesh;
+}
+
+/**
+ * Create a shadow atlas
+ * The size is rounded up to a power of two, cascade_count and distance
+ * fall back to the defaults when 0
+ */
+NexusShadowAtlas* nexus_shadow_atlas_create(SDL_GPUDevice* device, uint32_t size, uint32_t cascade_count,
+                                            float distance) {
+    if (device == NULL) {
+        fprintf(stderr, "GPU device cannot be NULL when creating shadow atlas!\n");
+        return NULL;
+    }
+
+    NexusShadowAtlas* atlas = (NexusShadowAtlas*)malloc(sizeof(NexusShadowAtlas));
+    if (atlas == NULL) {
+        fprintf(stderr, "Failed to allocate memory for shadow atlas!\n");
+        return NULL;
+    }
+    memset(atlas, 0, sizeof(NexusShadowAtlas));
+    atlas->device = device;
+
+    /* Settings */
+    atlas->size = NEXUS_SHADOW_MIN_TILE_SIZE;
+    while (atlas->size < size && atlas->size < NEXUS_SHADOW_MAX_ATLAS_SIZE) {
+        atlas->size *= 2;
+    }
+    for (uint32_t tile = atlas->size; tile >= NEXUS_SHADOW_MIN_TILE_SIZE; tile /= 2) {
+        atlas->levels++;
+    }
+    atlas->cascade_count = cascade_count > 0 ? cascade_count : NEXUS_SHADOW_DEFAULT_CASCADES;
+    if (atlas->cascade_count > NEXUS_SHADOW_MAX_CASCADES) {
+        atlas->cascade_count = NEXUS_SHADOW_MAX_CASCADES;
+    }
+    atlas->distance = distance > 0.0f ? distance : NEXUS_SHADOW_DEFAULT_DISTANCE;
+
+    /* Quadtree with only the root available */
+    atlas->nodes = (uint8_t*)calloc(nexus_shadow_level_offset(atlas->levels), 1);
+    atlas->casters = (NexusShadowCaster*)malloc(sizeof(NexusShadowCaster) * NEXUS_SHADOW_INITIAL_CASTERS);
+    atlas->caster_capacity = NEXUS_SHADOW_INITIAL_CASTERS;
+    atlas->caster_bounds = nexus_culling_buffer_create(NEXUS_SHADOW_INITIAL_CASTERS);
+    atlas->draw_casters = (uint32_t*)malloc(sizeof(uint32_t) * NEXUS_SHADOW_INITIAL_CASTERS);
+    atlas->draw_caster_capacity = NEXUS_SHADOW_INITIAL_CASTERS;
+    if (atlas->nodes == NULL || atlas->casters == NULL || atlas->caster_bounds == NULL ||
+        atlas->draw_casters == NULL) {
+        fprintf(stderr, "Failed to allocate memory for shadow atlas!\n");
+        nexus_shadow_atlas_destroy(atlas);
+        return NULL;
+    }
+    atlas->nodes[0] = NEXUS_SHADOW_NODE_FREE;
+
+    /* Depth atlas */
+    atlas->format = nexus_shadow_atlas_choose_format(device);
+    if (atlas->format == SDL_GPU_TEXTUREFORMAT_INVALID) {
+        fprintf(stderr, "No depth format supports shadow maps!\n");
+        nexus_shadow_atlas_destroy(atlas);
+        return NULL;
+    }
+
+    SDL_GPUTextureCreateInfo texture_info = {
+        .type = SDL_GPU_TEXTURETYPE_2D,
+        .format = atlas->format,
+        .usage = SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET | SDL_GPU_TEXTUREUSAGE_SAMPLER,
+        .width = atlas->size,
+        .height = atlas->size,
+        .layer_count_or_depth = 1,
+        .num_levels = 1,
+        .sample_count = SDL_GPU_SAMPLECOUNT_1
+    };
+    atlas->texture = SDL_CreateGPUTexture(device, &texture_info);
+
+    /* Shadow passes run the casters' fragment stages, which may not sample their own target */
+    texture_info.width = 1;
+    texture_info.height = 1;
+    atlas->placeholder = SDL_CreateGPUTexture(device, &texture_info);
+    if (atlas->texture == NULL || atlas->placeholder == NULL) {
+        fprintf(stderr, "Failed to create shadow atlas: %s\n", SDL_GetError());
+        nexus_shadow_atlas_destroy(atlas);
+        return NULL;
+    }
+
+    /* Hardware depth comparison with bilinear filtering (2x2 PCF per tap) */
+    SDL_GPUSamplerCreateInfo sampler_info = {
+        .min_filter = SDL_GPU_FILTER_LINEAR,
+        .mag_filter = SDL_GPU_FILTER_LINEAR,
+        .mipmap_mode = SDL_GPU_SAMPLERMIPMAPMODE_NEAREST,
+        .address_mode_u = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
+        .address_mode_v = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
+        .address_mode_w = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE,
+        .compare_op = SDL_GPU_COMPAREOP_LESS_OR_EQUAL,
+        .enable_compare = true
+    };
+    atlas->sampler = SDL_CreateGPUSampler(device, &sampler_info);
+
+    /* Views are read by every fragment shader */
+    SDL_GPUBufferCreateInfo buffer_info = {
+        .usage = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ,
+        .size = (uint32_t)(sizeof(NexusShadowView) * NEXUS_SHADOW_MAX_VIEWS)
+    };
+    atlas->view_buffer = SDL_CreateGPUBuffer(device, &buffer_info);
+
+    atlas->clear_mesh = nexus_shadow_atlas_create_clear_mesh(device);
+    if (atlas->sampler == NULL || atlas->view_buffer == NULL || atlas->clear_mesh == NULL) {
+        fprintf(stderr, "Failed to create shadow atlas resources: %s\n", SDL_GetError());
+        nexus_shadow_atlas_destroy(atlas);
+        return NULL;
+    }
+
+    return atlas;
+}
+
+/**
+ * Destroy a shadow atlas and its GPU resources
+ */
+void nexus_shadow_atlas_destroy(NexusShadowAtlas* atlas) {
+    if (atlas == NULL) {
+        return;
+    }
+
+    if (atlas->view_buffer != NULL) {
+        nexus_upload_manager_cancel_buffer(nexus_upload_manager_get(atlas->device), atlas->view_buffer);
+        SDL_ReleaseGPUBuffer(atlas->device, atlas->view_buffer);
+    }
+    if (atlas->sampler != NULL) {
+        SDL_ReleaseGPUSampler(atlas->device, atlas->sampler);
+    }
+    if (atlas->texture != NULL) {
+        SDL_ReleaseGPUTexture(atlas->device, atlas->texture);
+    }
+    if (atlas->placeholder != NULL) {
+        SDL_ReleaseGPUTexture(atlas->device, atlas->placeholder);
+    }
+    nexus_mesh_destroy(atlas->clear_mesh);
+
+    nexus_culling_buffer_destroy(atlas->caster_bounds);
+    free(atlas->nodes);
+    free(atlas->casters);
+    free(atlas->draw_casters);
+    free(atlas);
+}
+
+/**
+ * Remove the shadowed lights of the frame, done together with the frame's lights
+ * Tiles stay allocated for lights that are added again next frame
+ */
+void nexus_shadow_atlas_reset_lights(NexusShadowAtlas* atlas) {
+    if (atlas == NULL) {
+        return;
+    }
+
+    atlas->request_count = 0;
+    atlas->built = false;
+}
+
+/**
+ * Remove the shadow casters of the frame
+ */
+void nexus_shadow_atlas_reset_casters(NexusShadowAtlas* atlas) {
+    if (atlas == NULL) {
+        return;
+    }
+
+    atlas->caster_count = 0;
+    atlas->built = false;
+}
+
+/**
+ * Request shadows for a light of the frame
+ * The id identifies the light across frames (an entity id, never 0), its
+ * tiles are kept and re-rendered only when their contents change
+ * @return false if the id is invalid, already added or too many lights are shadowed
+ */
+bool nexus_shadow_atlas_add_light(NexusShadowAtlas* atlas, uint64_t id, uint32_t light_index, uint32_t resolution) {
+    if (atlas == NULL || id == 0 || atlas->request_count >= NEXUS_SHADOW_MAX_LIGHTS) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < atlas->request_count; i++) {
+        if (atlas->requests[i].id == id) {
+            return false;
+        }
+    }
+
+    NexusShadowRequest* request = &atlas->requests[atlas->request_count++];
+    request->id = id;
+    request->light_index = light_index;
+    request->resolution = resolution;
+    return true;
+}
+
+/**
+ * Add a shadow caster of the frame with its world bounds
+ * Casters are tested against each light frustum, so casters outside the
+ * camera view have to be added as well
+ * @return false if the caster was not added (materials can opt out)
+ */
+bool nexus_shadow_atlas_add_caster(NexusShadowAtlas* atlas, NexusMesh* mesh, uint32_t lod, NexusMaterial* material,
+                                   NexusShader* shader, const float* transform, const float* bounds_min,
+                                   const float* bounds_max) {
+    if (atlas == NULL || mesh == NULL || shader == NULL || transform == NULL ||
+        bounds_min == NULL || bounds_max == NULL) {
+        return false;
+    }
+
+    if (material != NULL && !material->cast_shadows) {
+        return false;
+    }
+
+    /* Grow geometrically */
+    if (atlas->caster_count >= atlas->caster_capacity) {
+        uint32_t capacity = atlas->caster_capacity * 2;
+        NexusShadowCaster* casters = (NexusShadowCaster*)realloc(atlas->casters, sizeof(NexusShadowCaster) * capacity);
+        if (casters == NULL) {
+            fprintf(stderr, "Failed to grow shadow caster list!\n");
+            return false;
+        }
+        atlas->casters = casters;
+        atlas->caster_capacity = capacity;
+    }
+
+    NexusShadowCaster* caster = &atlas->casters[atlas->caster_count++];
+    caster->mesh = mesh;
+    caster->lod = lod;
+    caster->material = material;
+    caster->shader = shader;
+    memcpy(caster->transform, transform, sizeof(caster->transform));
+    memcpy(caster->bounds_min, bounds_min, sizeof(caster->bounds_min));
+    memcpy(caster->bounds_max, bounds_max, sizeof(caster->bounds_max));
+
+    /* Everything that changes the caster's depth goes into its hash */
+    bool two_sided = material != NULL && material->two_sided;
+    uint64_t hash = nexus_shadow_hash(&mesh, sizeof(mesh), 0xCBF29CE484222325ull);
+    hash = nexus_shadow_hash(&lod, sizeof(lod), hash);
+    hash = nexus_shadow_hash(&two_sided, sizeof(two_sided), hash);
+    caster->hash = nexus_shadow_hash(transform, sizeof(float) * 16, hash);
+
+    return true;
+}
+
+/**
+ * Order casters by shader, culling state, mesh and level so each tile draws them in instanced groups
+ */
+static int nexus_shadow_compare_casters(const void* a, const void* b) {
+    const NexusShadowCaster* ca = (const NexusShadowCaster*)a;
+    const NexusShadowCaster* cb = (const NexusShadowCaster*)b;
+
+    if (ca->shader != cb->shader) {
+        return (uintptr_t)ca->shader < (uintptr_t)cb->shader ? -1 : 1;
+    }
+
+    bool ta = ca->material != NULL && ca->material->two_sided;
+    bool tb = cb->material != NULL && cb->material->two_sided;
+    if (ta != tb) {
+        return ta ? 1 : -1;
+    }
+
+    if (ca->mesh != cb->mesh) {
+        return (uintptr_t)ca->mesh < (uintptr_t)cb->mesh ? -1 : 1;
+    }
+
+    if (ca->lod != cb->lod) {
+        return ca->lod < cb->lod ? -1 : 1;
+    }
+
+    return 0;
+}
+
+/**
+ * Allocate a tile at a quadtree level
+ * Free nodes of the right size are used before larger ones are split
+ */
+static bool nexus_shadow_atlas_alloc_tile(NexusShadowAtlas* atlas, uint32_t level, NexusShadowTile* tile) {
+    /* Smallest free node that fits */
+    int32_t found_level = -1;
+    uint32_t found = 0;
+    for (int32_t l = (int32_t)level; l >= 0 && found_level < 0; l--) {
+        uint32_t offset = nexus_shadow_level_offset((uint32_t)l);
+        uint32_t count = 1u << (2 * l);
+        for (uint32_t i = 0; i < count; i++) {
+            if (atlas->nodes[offset + i] == NEXUS_SHADOW_NODE_FREE) {
+                found_level = l;
+                found = i;
+                break;
+            }
+        }
+    }
+
+    if (found_level < 0) {
+        return false;
+    }
+
+    /* Split down to the requested size, continuing in the first child */
+    uint32_t l = (uint32_t)found_level;
+    uint32_t x = found & ((1u << l) - 1);
+    uint32_t y = found >> l;
+    while (l < level) {
+        atlas->nodes[nexus_shadow_level_offset(l) + (y << l) + x] = NEXUS_SHADOW_NODE_SPLIT;
+        l++;
+        x *= 2;
+        y *= 2;
+
+        uint32_t row = 1u << l;
+        uint32_t child = nexus_shadow_level_offset(l) + y * row + x;
+        atlas->nodes[child] = NEXUS_SHADOW_NODE_FREE;
+        atlas->nodes[child + 1] = NEXUS_SHADOW_NODE_FREE;
+        atlas->nodes[child + row] = NEXUS_SHADOW_NODE_FREE;
+        atlas->nodes[child + row + 1] = NEXUS_SHADOW_NODE_FREE;
+    }
+
+    uint32_t node = nexus_shadow_level_offset(level) + (y << level) + x;
+    atlas->nodes[node] = NEXUS_SHADOW_NODE_USED;
+
+    tile->size = (uint16_t)(atlas->size >> level);
+    tile->x = (uint16_t)(x * tile->size);
+    tile->y = (uint16_t)(y * tile->size);
+    tile->node = (uint16_t)node;
+    return true;
+}
+
+/**
+ * Return a tile to the quadtree, merging free siblings back into their parent
+ */
+static void nexus_shadow_atlas_free_tile(NexusShadowAtlas* atlas, const NexusShadowTile* tile) {
+    uint32_t level = 0;
+    while ((atlas->size >> level) > tile->size) {
+        level++;
+    }
+    uint32_t x = tile->x / tile->size;
+    uint32_t y = tile->y / tile->size;
+
+    atlas->nodes[tile->node] = NEXUS_SHADOW_NODE_FREE;
+    while (level > 0) {
+        uint32_t row = 1u << level;
+        uint32_t first = nexus_shadow_level_offset(level) + (y & ~1u) * row + (x & ~1u);
+        if (atlas->nodes[first] != NEXUS_SHADOW_NODE_FREE || atlas->nodes[first + 1] != NEXUS_SHADOW_NODE_FREE ||
+            atlas->nodes[first + row] != NEXUS_SHADOW_NODE_FREE ||
+            atlas->nodes[first + row + 1] != NEXUS_SHADOW_NODE_FREE) {
+            break;
+        }
+
+        atlas->nodes[first] = NEXUS_SHADOW_NODE_NONE;
+        atlas->nodes[first + 1] = NEXUS_SHADOW_NODE_NONE;
+        atlas->nodes[first + row] = NEXUS_SHADOW_NODE_NONE;
+        atlas->nodes[first + row + 1] = NEXUS_SHADOW_NODE_NONE;
+
+        level--;
+        x /= 2;
+        y /= 2;
+        atlas->nodes[nexus_shadow_level_offset(level) + (y << level) + x] = NEXUS_SHADOW_NODE_FREE;
+    }
+}
+
+/**
+ * Free all tiles of a light slot
+ */
+static void nexus_shadow_atlas_release_tiles(NexusShadowAtlas* atlas, NexusShadowLight* slot) {
+    for (uint32_t i = 0; i < slot->tile_count; i++) {
+        nexus_shadow_atlas_free_tile(atlas, &slot->tiles[i]);
+        slot->valid[i] = false;
+    }
+    slot->tile_count = 0;
+}
+
+/**
+ * Quadtree level of a requested resolution (rounded up to a power of two)
+ * Tiles are at most half the atlas so one light cannot take all of it
+ */
+static uint32_t nexus_shadow_atlas_tile_level(const NexusShadowAtlas* atlas, uint32_t resolution) {
+    if (resolution == 0) {
+        resolution = NEXUS_SHADOW_DEFAULT_RESOLUTION;
+    }
+
+    uint32_t level = atlas->levels > 1 ? 1 : 0;
+    uint32_t size = atlas->size >> level;
+    while (size > NEXUS_SHADOW_MIN_TILE_SIZE && size / 2 >= resolution) {
+        size /= 2;
+        level++;
+    }
+    return level;
+}
+
+/**
+ * Allocate the tiles of a light slot, all of one size
+ * Smaller tiles are used while the atlas is too full for the requested size
+ */
+static bool nexus_shadow_atlas_alloc_tiles(NexusShadowAtlas* atlas, NexusShadowLight* slot, uint32_t count) {
+    for (uint32_t level = nexus_shadow_atlas_tile_level(atlas, slot->resolution); level < atlas->levels; level++) {
+        uint32_t allocated = 0;
+        while (allocated < count && nexus_shadow_atlas_alloc_tile(atlas, level, &slot->tiles[allocated])) {
+            allocated++;
+        }
+
+        if (allocated == count) {
+            slot->tile_count = count;
+            memset(slot->valid, 0, sizeof(slot->valid));
+            return true;
+        }
+
+        while (allocated > 0) {
+            nexus_shadow_atlas_free_tile(atlas, &slot->tiles[--allocated]);
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Number of views a light needs (0 = it cannot be shadowed this frame)
+ */
+static uint32_t nexus_shadow_atlas_get_view_count(const NexusShadowAtlas* atlas, const NexusLightData* light,
+                                                  const NexusCamera* camera) {
+    switch ((int)light->direction_type[3]) {
+        case NEXUS_LIGHT_TYPE_DIRECTIONAL:
+            return camera != NULL ? atlas->cascade_count : 0;
+        case NEXUS_LIGHT_TYPE_POINT:
+            return light->position_range[3] > 0.0f ? NEXUS_SHADOW_MAX_FACES : 0;
+        case NEXUS_LIGHT_TYPE_SPOT:
+            return light->position_range[3] > 0.0f ? 1 : 0;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Up vector for a light view looking along direction
+ */
+static void nexus_shadow_get_up(const vec3 direction, vec3 up) {
+    if (fabsf(direction[1]) > 0.99f) {
+        nexus_vec3_set(up, 0.0f, 0.0f, 1.0f);
+    } else {
+        nexus_vec3_set(up, 0.0f, 1.0f, 0.0f);
+    }
+}
+
+/**
+ * Store a view's matrices
+ */
+static void nexus_shadow_store_matrices(mat4 light_view, mat4 projection, NexusShadowViewInfo* info,
+                                        NexusShadowView* view) {
+    mat4 view_projection;
+    glm_mat4_mul(projection, light_view, view_projection);
+    memcpy(info->view, light_view, sizeof(info->view));
+    memcpy(info->projection, projection, sizeof(info->projection));
+    memcpy(view->view_projection, view_projection, sizeof(view->view_projection));
+}
+
+/**
+ * Set up a perspective view (spot lights and cube faces)
+ */
+static void nexus_shadow_perspective_view(const float* position, const float* direction, const float* up,
+                                          float fov, float range, uint32_t tile_size,
+                                          NexusShadowViewInfo* info, NexusShadowView* view) {
+    vec3 eye = { position[0], position[1], position[2] };
+    vec3 target = { position[0] + direction[0], position[1] + direction[1], position[2] + direction[2] };
+    vec3 up_vector = { up[0], up[1], up[2] };
+
+    /* Near plane as far out as small lights allow, for depth precision */
+    float near_plane = range * 0.01f;
+    if (near_plane < 0.05f) {
+        near_plane = glm_min(0.05f, range * 0.5f);
+    }
+
+    mat4 light_view, projection;
+    glm_lookat(eye, target, up_vector, light_view);
+    glm_perspective(fov, 1.0f, near_plane, range, projection);
+    nexus_shadow_store_matrices(light_view, projection, info, view);
+
+    view->params[0] = range;
+    view->params[1] = near_plane;
+    view->params[2] = range;
+    view->params[3] = 2.0f * tanf(fov * 0.5f) / (float)tile_size;
+}
+
+/**
+ * Set up the orthographic view of one cascade, covering the camera frustum between two view depths
+ * The projection is sized from the slice's bounding sphere and snapped to
+ * whole texels in light space, so the cascade does not shimmer when the
+ * camera moves or turns and stays identical while the camera is still
+ */
+static void nexus_shadow_cascade_view(const NexusShadowAtlas* atlas, const NexusLightData* light,
+                                      const NexusCamera* camera, const float* camera_view, float d0, float d1,
+                                      uint32_t tile_size, NexusShadowViewInfo* info, NexusShadowView* view) {
+    /* Camera basis from the view matrix rows */
+    vec3 right = { camera_view[0], camera_view[4], camera_view[8] };
+    vec3 up = { camera_view[1], camera_view[5], camera_view[9] };
+    vec3 forward = { -camera_view[2], -camera_view[6], -camera_view[10] };
+    vec3 eye;
+    nexus_camera_get_position(camera, &eye[0], &eye[1], &eye[2]);
+
+    /* Corners of the slice and their bounding sphere */
+    vec3 corners[8];
+    vec3 center = { 0.0f, 0.0f, 0.0f };
+    for (int s = 0; s < 2; s++) {
+        float depth = s == 0 ? d0 : d1;
+        float half_height, half_width;
+        if (camera->projection_type == NEXUS_CAMERA_ORTHOGRAPHIC) {
+            half_height = camera->ortho_height * 0.5f;
+            half_width = camera->ortho_width * 0.5f;
+        } else {
+            half_height = depth * tanf(glm_rad(camera->fov) * 0.5f);
+            half_width = half_height * camera->aspect_ratio;
+        }
+
+        for (int c = 0; c < 4; c++) {
+            float sx = (c & 1) ? half_width : -half_width;
+            float sy = (c & 2) ? half_height : -half_height;
+            float* corner = corners[s * 4 + c];
+            for (int k = 0; k < 3; k++) {
+                corner[k] = eye[k] + forward[k] * depth + right[k] * sx + up[k] * sy;
+                center[k] += corner[k] * 0.125f;
+            }
+        }
+    }
+
+    float radius = 0.0f;
+    for (int c = 0; c < 8; c++) {
+        radius = glm_max(radius, glm_vec3_distance(center, corners[c]));
+    }
+    radius = glm_max(ceilf(radius * 16.0f) / 16.0f, 0.0625f);
+
+    /* Light rotation without translation, texels form a fixed grid in its space */
+    vec3 origin = { 0.0f, 0.0f, 0.0f };
+    vec3 direction = { light->direction_type[0], light->direction_type[1], light->direction_type[2] };
+    if (glm_vec3_norm2(direction) < 1e-8f) {
+        nexus_vec3_set(direction, 0.0f, -1.0f, 0.0f);
+    }
+    glm_vec3_normalize(direction);
+    vec3 light_up;
+    nexus_shadow_get_up(direction, light_up);
+
+    mat4 light_view;
+    glm_lookat(origin, direction, light_up, light_view);
+
+    vec3 light_center;
+    glm_mat4_mulv3(light_view, center, 1.0f, light_center);
+    float texel = 2.0f * radius / (float)tile_size;
+    light_center[0] = floorf(light_center[0] / texel) * texel;
+    light_center[1] = floorf(light_center[1] / texel) * texel;
+
+    /* Depth range covers the slice, pulled towards the light for casters in front of it */
+    float z_near = light_center[2] + radius;
+    float z_far = light_center[2] - radius;
+    const NexusCullingBuffer* bounds = atlas->caster_bounds;
+    for (uint32_t i = 0; i < bounds->count; i++) {
+        vec3 caster_center = { bounds->center_x[i], bounds->center_y[i], bounds->center_z[i] };
+        float caster_radius = sqrtf(bounds->extent_x[i] * bounds->extent_x[i] +
+                                    bounds->extent_y[i] * bounds->extent_y[i] +
+                                    bounds->extent_z[i] * bounds->extent_z[i]);
+        vec3 light_space;
+        glm_mat4_mulv3(light_view, caster_center, 1.0f, light_space);
+        if (fabsf(light_space[0] - light_center[0]) <= radius + caster_radius &&
+            fabsf(light_space[1] - light_center[1]) <= radius + caster_radius) {
+            z_near = glm_max(z_near, light_space[2] + caster_radius);
+        }
+    }
+
+    /* The light looks down -Z, planes are distances along it */
+    mat4 projection;
+    glm_ortho(light_center[0] - radius, light_center[0] + radius,
+              light_center[1] - radius, light_center[1] + radius,
+              -z_near, -z_far, projection);
+    nexus_shadow_store_matrices(light_view, projection, info, view);
+
+    view->params[0] = d1;
+    view->params[1] = -z_near;
+    view->params[2] = -z_far;
+    view->params[3] = texel;
+}
+
+/**
+ * Cull the casters of a view and decide from its signature whether the tile is rendered again
+ * The signature covers the light matrix, the tile and every caster inside
+ * the light frustum, so a tile stays cached until the light or one of
+ * those casters moves, or casters enter or leave it
+ */
+static void nexus_shadow_atlas_cull_view(NexusShadowAtlas* atlas, NexusShadowLight* slot, uint32_t face,
+                                         NexusShadowViewInfo* info, const NexusShadowView* view) {
+    uint64_t signature = nexus_shadow_hash(view->view_projection, sizeof(view->view_projection),
+                                           0xCBF29CE484222325ull);
+    signature = nexus_shadow_hash(&slot->tiles[face], sizeof(NexusShadowTile), signature);
+
+    /* Casters inside the light frustum, combined independently of their order */
+    NexusCullingBuffer* bounds = atlas->caster_bounds;
+    uint32_t visible = 0;
+    uint64_t casters = 0;
+    if (bounds->count > 0) {
+        mat4 view_projection;
+        vec4 planes[6];
+        memcpy(view_projection, view->view_projection, sizeof(view_projection));
+        nexus_frustum_from_viewproj(view_projection, planes);
+        visible = nexus_culling_buffer_test(bounds, (const vec4*)planes);
+
+        for (uint32_t i = 0; i < bounds->count; i++) {
+            if (bounds->visible[i]) {
+                casters += nexus_shadow_mix(atlas->casters[i].hash);
+            }
+        }
+    }
+    signature = nexus_shadow_mix(signature ^ casters) + visible;
+
+    info->dirty = !slot->valid[face] || slot->signatures[face] != signature;
+    info->caster_offset = atlas->draw_caster_count;
+    info->caster_count = 0;
+    if (!info->dirty) {
+        return;
+    }
+
+    /* Keep the casters of the tile for drawing */
+    uint32_t needed = atlas->draw_caster_count + visible;
+    if (needed > atlas->draw_caster_capacity) {
+        uint32_t capacity = atlas->draw_caster_capacity;
+        while (capacity < needed) {
+            capacity *= 2;
+        }
+        uint32_t* draw_casters = (uint32_t*)realloc(atlas->draw_casters, sizeof(uint32_t) * capacity);
+        if (draw_casters == NULL) {
+            /* Keep the stale tile this frame and retry next frame */
+            fprintf(stderr, "Failed to grow shadow draw list!\n");
+            info->dirty = false;
+            slot->valid[face] = false;
+            return;
+        }
+        atlas->draw_casters = draw_casters;
+        atlas->draw_caster_capacity = capacity;
+    }
+
+    for (uint32_t i = 0; i < bounds->count && visible > 0; i++) {
+        if (bounds->visible[i]) {
+            atlas->draw_casters[atlas->draw_caster_count++] = i;
+        }
+    }
+    info->caster_count = atlas->draw_caster_count - info->caster_offset;
+
+    /* Valid again once the tile was rendered (nexus_shadow_atlas_finish) */
+    slot->signatures[face] = signature;
+    slot->valid[face] = false;
+    atlas->dirty_count++;
+}
+
+/**
+ * Assign tiles to the frame's shadowed lights and set up their views
+ * Writes each shadowed light's first view and view count into spot[2] and
+ * spot[3]. Lights that do not fit into the atlas or the view budget stay
+ * unshadowed. Call before the lights are binned, binning reorders them
+ */
+bool nexus_shadow_atlas_build(NexusShadowAtlas* atlas, NexusLightData* lights, uint32_t light_count,
+                              const NexusCamera* camera) {
+    if (atlas == NULL || (lights == NULL && light_count > 0)) {
+        return false;
+    }
+
+    atlas->view_count = 0;
+    atlas->dirty_count = 0;
+    atlas->draw_caster_count = 0;
+    atlas->built = true;
+
+    /* Group casters so the draws of a tile are instanced, then gather their bounds */
+    if (atlas->caster_count > 1) {
+        qsort(atlas->casters, atlas->caster_count, sizeof(NexusShadowCaster), nexus_shadow_compare_casters);
+    }
+    nexus_culling_buffer_reset(atlas->caster_bounds);
+    for (uint32_t i = 0; i < atlas->caster_count; i++) {
+        if (!nexus_culling_buffer_add(atlas->caster_bounds, atlas->casters[i].bounds_min,
+                                      atlas->casters[i].bounds_max)) {
+            atlas->caster_count = i;
+            break;
+        }
+    }
+
+    /* Match requests to the slots that shadowed the same lights before */
+    int32_t request_slots[NEXUS_SHADOW_MAX_LIGHTS];
+    for (uint32_t s = 0; s < NEXUS_SHADOW_MAX_LIGHTS; s++) {
+        atlas->lights[s].requested = false;
+    }
+    for (uint32_t r = 0; r < atlas->request_count; r++) {
+        const NexusShadowRequest* request = &atlas->requests[r];
+        request_slots[r] = -1;
+        if (request->light_index >= light_count) {
+            continue;
+        }
+
+        uint32_t type = (uint32_t)lights[request->light_index].direction_type[3];
+        for (uint32_t s = 0; s < NEXUS_SHADOW_MAX_LIGHTS; s++) {
+            NexusShadowLight* slot = &atlas->lights[s];
+            if (slot->id == request->id) {
+                if (slot->type != type || slot->resolution != request->resolution) {
+                    nexus_shadow_atlas_release_tiles(atlas, slot);
+                }
+                slot->type = type;
+                slot->resolution = request->resolution;
+                slot->requested = true;
+                request_slots[r] = (int32_t)s;
+                break;
+            }
+        }
+    }
+
+    /* Lights that are gone free their tiles, new ones take the free slots */
+    for (uint32_t s = 0; s < NEXUS_SHADOW_MAX_LIGHTS; s++) {
+        NexusShadowLight* slot = &atlas->lights[s];
+        if (slot->id != 0 && !slot->requested) {
+            nexus_shadow_atlas_release_tiles(atlas, slot);
+            slot->id = 0;
+        }
+    }
+    for (uint32_t r = 0; r < atlas->request_count; r++) {
+        const NexusShadowRequest* request = &atlas->requests[r];
+        if (request_slots[r] >= 0 || request->light_index >= light_count) {
+            continue;
+        }
+
+        for (uint32_t s = 0; s < NEXUS_SHADOW_MAX_LIGHTS; s++) {
+            NexusShadowLight* slot = &atlas->lights[s];
+            if (slot->id == 0) {
+                memset(slot, 0, sizeof(NexusShadowLight));
+                slot->id = request->id;
+                slot->type = (uint32_t)lights[request->light_index].direction_type[3];
+                slot->resolution = request->resolution;
+                slot->requested = true;
+                request_slots[r] = (int32_t)s;
+                break;
+            }
+        }
+    }
+
+    /* Allocate tiles for lights without them, largest first so small tiles fill the gaps */
+    uint32_t order[NEXUS_SHADOW_MAX_LIGHTS];
+    uint32_t order_count = 0;
+    for (uint32_t r = 0; r < atlas->request_count; r++) {
+        if (request_slots[r] < 0) {
+            continue;
+        }
+
+        NexusShadowLight* slot = &atlas->lights[request_slots[r]];
+        uint32_t count = nexus_shadow_atlas_get_view_count(atlas, &lights[atlas->requests[r].light_index], camera);
+        if (count == 0 || slot->tile_count == count) {
+            continue;
+        }
+        nexus_shadow_atlas_release_tiles(atlas, slot);
+
+        /* Insertion sort by tile level, smallest level (largest tile) first */
+        uint32_t level = nexus_shadow_atlas_tile_level(atlas, slot->resolution);
+        uint32_t i = order_count++;
+        while (i > 0 && nexus_shadow_atlas_tile_level(atlas, atlas->lights[request_slots[order[i - 1]]].resolution) > level) {
+            order[i] = order[i - 1];
+            i--;
+        }
+        order[i] = r;
+    }
+    for (uint32_t i = 0; i < order_count; i++) {
+        uint32_t r = order[i];
+        NexusShadowLight* slot = &atlas->lights[request_slots[r]];
+        nexus_shadow_atlas_alloc_tiles(atlas, slot,
+                                       nexus_shadow_atlas_get_view_count(atlas, &lights[atlas->requests[r].light_index], camera));
+    }
+
+    /* Camera data for the cascades */
+    float camera_view[16];
+    float cascade_near = 0.0f, cascade_far = 0.0f;
+    if (camera != NULL) {
+        nexus_camera_get_view_matrix(camera, camera_view);
+        cascade_near = glm_max(camera->near_plane, 0.01f);
+        cascade_far = glm_min(camera->far_plane, atlas->distance);
+        if (cascade_far <= cascade_near) {
+            cascade_far = cascade_near + 1.0f;
+        }
+    }
+
+    /* Set up the views of every light that has its tiles */
+    for (uint32_t r = 0; r < atlas->request_count; r++) {
+        if (request_slots[r] < 0) {
+            continue;
+        }
+
+        NexusShadowLight* slot = &atlas->lights[request_slots[r]];
+        NexusLightData* light = &lights[atlas->requests[r].light_index];
+        uint32_t count = nexus_shadow_atlas_get_view_count(atlas, light, camera);
+        if (count == 0 || slot->tile_count != count || atlas->view_count + count > NEXUS_SHADOW_MAX_VIEWS) {
+            continue;
+        }
+
+        uint32_t first = atlas->view_count;
+        for (uint32_t face = 0; face < count; face++) {
+            NexusShadowViewInfo* info = &atlas->view_info[atlas->view_count];
+            NexusShadowView* view = &atlas->views[atlas->view_count];
+            const NexusShadowTile* tile = &slot->tiles[face];
+            memset(info, 0, sizeof(NexusShadowViewInfo));
+            memset(view, 0, sizeof(NexusShadowView));
+            info->slot = (uint32_t)request_slots[r];
+            info->face = face;
+
+            switch (slot->type) {
+                case NEXUS_LIGHT_TYPE_DIRECTIONAL: {
+                    /* Practical split scheme, logarithmic near the camera and uniform further out */
+                    float d[2];
+                    for (int e = 0; e < 2; e++) {
+                        float t = (float)(face + (uint32_t)e) / (float)count;
+                        float logarithmic = cascade_near * powf(cascade_far / cascade_near, t);
+                        float uniform = cascade_near + (cascade_far - cascade_near) * t;
+                        d[e] = NEXUS_SHADOW_CASCADE_LAMBDA * logarithmic + (1.0f - NEXUS_SHADOW_CASCADE_LAMBDA) * uniform;
+                    }
+                    nexus_shadow_cascade_view(atlas, light, camera, camera_view, d[0], d[1], tile->size, info, view);
+                    break;
+                }
+
+                case NEXUS_LIGHT_TYPE_SPOT: {
+                    vec3 direction = { light->direction_type[0], light->direction_type[1], light->direction_type[2] };
+                    if (glm_vec3_norm2(direction) < 1e-8f) {
+                        nexus_vec3_set(direction, 0.0f, -1.0f, 0.0f);
+                    }
+                    glm_vec3_normalize(direction);
+                    vec3 up;
+                    nexus_shadow_get_up(direction, up);
+
+                    float cos_outer = glm_clamp(light->spot[0], cosf(glm_rad(NEXUS_SHADOW_MAX_SPOT_ANGLE)), 1.0f);
+                    float fov = glm_max(2.0f * acosf(cos_outer), glm_rad(1.0f));
+                    nexus_shadow_perspective_view(light->position_range, direction, up, fov,
+                                                  light->position_range[3], tile->size, info, view);
+                    break;
+                }
+
+                default:
+                    nexus_shadow_perspective_view(light->position_range, s_cube_faces[face][0], s_cube_faces[face][1],
+                                                  glm_rad(90.0f), light->position_range[3], tile->size, info, view);
+                    break;
+            }
+
+            /* Tile in atlas uv */
+            view->atlas_rect[0] = (float)tile->x / (float)atlas->size;
+            view->atlas_rect[1] = (float)tile->y / (float)atlas->size;
+            view->atlas_rect[2] = (float)tile->size / (float)atlas->size;
+            view->atlas_rect[3] = (float)tile->size / (float)atlas->size;
+
+            nexus_shadow_atlas_cull_view(atlas, slot, face, info, view);
+            atlas->view_count++;
+        }
+
+        light->spot[2] = (float)first;
+        light->spot[3] = (float)count;
+    }
+
+    return true;
+}
+
+/**
+ * Mark the tiles built this frame as cached once their passes were submitted
+ * Tiles whose passes failed are rendered again next frame
+ */
+void nexus_shadow_atlas_finish(NexusShadowAtlas* atlas, bool rendered) {
+    if (atlas == NULL) {
+        return;
+    }
+
+    for (uint32_t v = 0; v < atlas->view_count; v++) {
+        const NexusShadowViewInfo* info = &atlas->view_info[v];
+        if (info->dirty) {
+            atlas->lights[info->slot].valid[info->face] = rendered;
+        }
+    }
+}
+
+/**
+ * Stage the frame's shadow views into the view buffer
+ */
+bool nexus_shadow_atlas_upload(NexusShadowAtlas* atlas, NexusUploadManager* manager) {
+    if (atlas == NULL || manager == NULL) {
+        return false;
+    }
+
+    if (atlas->view_count == 0) {
+        return true;
+    }
+
+    /* Cycle the buffer, the previous frame may still be reading it */
+    return nexus_upload_manager_upload_buffer(manager, atlas->view_buffer, 0, atlas->views,
+                                              (uint32_t)(sizeof(NexusShadowView) * atlas->view_count), true);
+}
+
+/**
+ * Bind the atlas and the shadow views for the fragment stage
+ */
+void nexus_shadow_atlas_bind(const NexusShadowAtlas* atlas, SDL_GPURenderPass* render_pass) {
+    if (atlas == NULL || render_pass == NULL) {
+        return;
+    }
+
+    SDL_GPUTextureSamplerBinding binding = {
+        .texture = atlas->texture,
+        .sampler = atlas->sampler
+    };
+    SDL_BindGPUFragmentSamplers(render_pass, NEXUS_SAMPLER_SLOT_FRAGMENT_SHADOW_ATLAS, &binding, 1);
+    SDL_BindGPUFragmentStorageBuffers(render_pass, NEXUS_STORAGE_SLOT_FRAGMENT_SHADOW_VIEWS,
+                                      &atlas->view_buffer, 1);
+}
+
+/**
+ * Bind the placeholder texture in the atlas slot, for passes that render into the atlas
+ */
+void nexus_shadow_atlas_bind_placeholder(const NexusShadowAtlas* atlas, SDL_GPURenderPass* render_pass) {
+    if (atlas == NULL || render_pass == NULL) {
+        return;
+    }
+
+    SDL_GPUTextureSamplerBinding binding = {
+        .texture = atlas->placeholder,
+        .sampler = atlas->sampler
+    };
+    SDL_BindGPUFragmentSamplers(render_pass, NEXUS_SAMPLER_SLOT_FRAGMENT_SHADOW_ATLAS, &binding, 1);
+    SDL_BindGPUFragmentStorageBuffers(render_pass, NEXUS_STORAGE_SLOT_FRAGMENT_SHADOW_VIEWS,
+                                      &atlas->view_buffer, 1);
+}
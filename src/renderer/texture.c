@@ -5,6 +5,7 @@
 
  #include "nexus3d/renderer/texture.h"
 #include <SDL3/SDL.h>
+ #include "nexus3d/renderer/upload.h"
  #include "nexus3d/utils/logger.h"
  #include <stdio.h>
  #include <stdlib.h>
@@ -35,7 +36,7 @@
          case NEXUS_TEXTURE_FORMAT_R32G32F:
              return SDL_GPU_TEXTUREFORMAT_R32G32_FLOAT;
          case NEXUS_TEXTURE_FORMAT_R32G32B32F:
-             return SDL_GPU_TEXTUREFORMAT_R32G32_FLOAT;
+             return SDL_GPU_TEXTUREFORMAT_R32G32B32A32_FLOAT;
          case NEXUS_TEXTURE_FORMAT_R32G32B32A32F:
              return SDL_GPU_TEXTUREFORMAT_R32G32B32A32_FLOAT;
          case NEXUS_TEXTURE_FORMAT_DEPTH16:
@@ -46,6 +47,18 @@
              return SDL_GPU_TEXTUREFORMAT_D32_FLOAT;
          case NEXUS_TEXTURE_FORMAT_DEPTH24_STENCIL8:
              return SDL_GPU_TEXTUREFORMAT_D24_UNORM_S8_UINT;
+         case NEXUS_TEXTURE_FORMAT_BC1:
+             return SDL_GPU_TEXTUREFORMAT_BC1_RGBA_UNORM;
+         case NEXUS_TEXTURE_FORMAT_BC3:
+             return SDL_GPU_TEXTUREFORMAT_BC3_RGBA_UNORM;
+         case NEXUS_TEXTURE_FORMAT_BC7:
+             return SDL_GPU_TEXTUREFORMAT_BC7_RGBA_UNORM;
+         case NEXUS_TEXTURE_FORMAT_ASTC_4X4:
+             return SDL_GPU_TEXTUREFORMAT_ASTC_4x4_UNORM;
+         case NEXUS_TEXTURE_FORMAT_ASTC_6X6:
+             return SDL_GPU_TEXTUREFORMAT_ASTC_6x6_UNORM;
+         case NEXUS_TEXTURE_FORMAT_ASTC_8X8:
+             return SDL_GPU_TEXTUREFORMAT_ASTC_8x8_UNORM;
          default:
              return SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM;
      }
@@ -109,6 +122,8 @@
           .mag_filter = nexus_filter_to_sdl(mag_filter),
           .address_mode_u = nexus_wrap_to_sdl(wrap_s),
           .address_mode_v = nexus_wrap_to_sdl(wrap_t),
+          .mipmap_mode = min_filter == NEXUS_TEXTURE_FILTER_TRILINEAR ?
+                         SDL_GPU_SAMPLERMIPMAPMODE_LINEAR : SDL_GPU_SAMPLERMIPMAPMODE_NEAREST,
           .address_mode_w = nexus_wrap_to_sdl(wrap_r),
           .mip_lod_bias = 0.0f,
           .max_anisotropy = 1.0f,
@@ -187,15 +202,17 @@
            .format = nexus_format_to_sdl(format),
            .width = width,
            .height = height,
-           .layer_count_or_depth = texture->depth,
+           .layer_count_or_depth = type == NEXUS_TEXTURE_TYPE_CUBE ? 6 : texture->depth,
            .num_levels = texture->mip_levels,
            .sample_count = SDL_GPU_SAMPLECOUNT_1,
            .usage = SDL_GPU_TEXTUREUSAGE_SAMPLER,
            .props = 0
        };
 
-       /* Add appropriate usage flags based on format */
-       if (format == NEXUS_TEXTURE_FORMAT_DEPTH16 ||
+       /* Add appropriate usage flags based on format (compressed formats are sample only) */
+       if (nexus_texture_format_is_compressed(format)) {
+           /* No additional usage */
+       } else if (format == NEXUS_TEXTURE_FORMAT_DEPTH16 ||
            format == NEXUS_TEXTURE_FORMAT_DEPTH24 ||
            format == NEXUS_TEXTURE_FORMAT_DEPTH32F ||
            format == NEXUS_TEXTURE_FORMAT_DEPTH24_STENCIL8) {
@@ -244,8 +261,9 @@
          texture->sampler = NULL;
      }
 
-     /* Destroy the GPU texture */
+     /* Destroy the GPU texture, dropping uploads that have not been flushed yet */
      if (texture->gpu_texture != NULL) {
+         nexus_upload_manager_cancel_texture(nexus_upload_manager_get(texture->device), texture->gpu_texture);
          SDL_ReleaseGPUTexture(texture->device, texture->gpu_texture);
          texture->gpu_texture = NULL;
      }
@@ -254,98 +272,303 @@
      free(texture);
  }
 
- /**
- * Set texture data
+/**
+ * Format layout description
  */
-bool nexus_texture_set_data(NexusTexture* texture, const void* data, size_t size) {
-    if (texture == NULL || texture->gpu_texture == NULL || data == NULL || size == 0) {
-        return false;
-    }
+typedef struct {
+    uint32_t block_width;           /* Block width in texels (1 for uncompressed formats) */
+    uint32_t block_height;          /* Block height in texels */
+    uint32_t block_size;            /* Bytes per block in the source data */
+    uint32_t channels;              /* Source channels (0 for compressed formats) */
+    uint32_t channel_size;          /* Bytes per source channel */
+} NexusTextureFormatInfo;
 
-    /* Calculate expected data size */
-    uint32_t bytes_per_pixel;
-    switch (texture->format) {
+/**
+ * Describe the source data layout of a texture format
+ */
+static bool nexus_texture_get_format_info(NexusTextureFormat format, NexusTextureFormatInfo* info) {
+    /* Uncompressed formats are 1x1 blocks */
+    info->block_width = 1;
+    info->block_height = 1;
+
+    switch (format) {
         case NEXUS_TEXTURE_FORMAT_R8:
-            bytes_per_pixel = 1;
+            info->channels = 1; info->channel_size = 1;
             break;
         case NEXUS_TEXTURE_FORMAT_R8G8:
-            bytes_per_pixel = 2;
+            info->channels = 2; info->channel_size = 1;
             break;
         case NEXUS_TEXTURE_FORMAT_R8G8B8:
-            bytes_per_pixel = 3;
+            info->channels = 3; info->channel_size = 1;
             break;
         case NEXUS_TEXTURE_FORMAT_R8G8B8A8:
-            bytes_per_pixel = 4;
+            info->channels = 4; info->channel_size = 1;
             break;
         case NEXUS_TEXTURE_FORMAT_R16F:
-            bytes_per_pixel = 2;
+            info->channels = 1; info->channel_size = 2;
             break;
         case NEXUS_TEXTURE_FORMAT_R16G16F:
-            bytes_per_pixel = 4;
+            info->channels = 2; info->channel_size = 2;
             break;
         case NEXUS_TEXTURE_FORMAT_R16G16B16F:
-            bytes_per_pixel = 6;
+            info->channels = 3; info->channel_size = 2;
             break;
         case NEXUS_TEXTURE_FORMAT_R16G16B16A16F:
-            bytes_per_pixel = 8;
+            info->channels = 4; info->channel_size = 2;
             break;
         case NEXUS_TEXTURE_FORMAT_R32F:
-            bytes_per_pixel = 4;
+            info->channels = 1; info->channel_size = 4;
             break;
         case NEXUS_TEXTURE_FORMAT_R32G32F:
-            bytes_per_pixel = 8;
+            info->channels = 2; info->channel_size = 4;
             break;
         case NEXUS_TEXTURE_FORMAT_R32G32B32F:
-            bytes_per_pixel = 12;
+            info->channels = 3; info->channel_size = 4;
             break;
         case NEXUS_TEXTURE_FORMAT_R32G32B32A32F:
-            bytes_per_pixel = 16;
+            info->channels = 4; info->channel_size = 4;
             break;
         case NEXUS_TEXTURE_FORMAT_DEPTH16:
-            bytes_per_pixel = 2;
+            info->channels = 1; info->channel_size = 2;
             break;
         case NEXUS_TEXTURE_FORMAT_DEPTH24:
         case NEXUS_TEXTURE_FORMAT_DEPTH32F:
-            bytes_per_pixel = 4;
-            break;
         case NEXUS_TEXTURE_FORMAT_DEPTH24_STENCIL8:
-            bytes_per_pixel = 4;
+            info->channels = 1; info->channel_size = 4;
             break;
+        case NEXUS_TEXTURE_FORMAT_BC1:
+            info->block_width = 4; info->block_height = 4; info->block_size = 8;
+            info->channels = 0; info->channel_size = 0;
+            return true;
+        case NEXUS_TEXTURE_FORMAT_BC3:
+        case NEXUS_TEXTURE_FORMAT_BC7:
+        case NEXUS_TEXTURE_FORMAT_ASTC_4X4:
+            info->block_width = 4; info->block_height = 4; info->block_size = 16;
+            info->channels = 0; info->channel_size = 0;
+            return true;
+        case NEXUS_TEXTURE_FORMAT_ASTC_6X6:
+            info->block_width = 6; info->block_height = 6; info->block_size = 16;
+            info->channels = 0; info->channel_size = 0;
+            return true;
+        case NEXUS_TEXTURE_FORMAT_ASTC_8X8:
+            info->block_width = 8; info->block_height = 8; info->block_size = 16;
+            info->channels = 0; info->channel_size = 0;
+            return true;
         default:
-            fprintf(stderr, "Unknown texture format: %d\n", texture->format);
             return false;
     }
 
-    size_t expected_size = texture->width * texture->height * texture->depth * bytes_per_pixel;
+    info->block_size = info->channels * info->channel_size;
+    return true;
+}
+
+/**
+ * Number of array layers (cube faces count as layers)
+ */
+static uint32_t nexus_texture_get_layer_count(const NexusTexture* texture) {
+    if (texture->type == NEXUS_TEXTURE_TYPE_CUBE) {
+        return 6;
+    }
+    if (texture->type == NEXUS_TEXTURE_TYPE_2D_ARRAY) {
+        return texture->depth;
+    }
+    return 1;
+}
+
+/**
+ * Widen three channel texels to four channels with an opaque alpha
+ * (there are no three channel GPU formats)
+ */
+static void* nexus_texture_expand_rgb(const void* data, size_t texel_count, uint32_t channel_size) {
+    uint8_t* expanded = (uint8_t*)malloc(texel_count * 4 * channel_size);
+    if (expanded == NULL) {
+        fprintf(stderr, "Failed to allocate texture expansion buffer!\n");
+        return NULL;
+    }
+
+    /* Alpha value of one in the channel's encoding */
+    uint8_t one[4] = { 0xFF, 0, 0, 0 };
+    if (channel_size == 2) {
+        uint16_t half_one = 0x3C00;
+        memcpy(one, &half_one, sizeof(half_one));
+    } else if (channel_size == 4) {
+        float float_one = 1.0f;
+        memcpy(one, &float_one, sizeof(float_one));
+    }
+
+    const uint8_t* src = (const uint8_t*)data;
+    uint8_t* dst = expanded;
+    for (size_t i = 0; i < texel_count; i++) {
+        memcpy(dst, src, 3 * channel_size);
+        memcpy(dst + 3 * channel_size, one, channel_size);
+        src += 3 * channel_size;
+        dst += 4 * channel_size;
+    }
+
+    return expanded;
+}
+
+/**
+ * Queue an upload into a texture region through the device's upload manager
+ * Without one (no renderer) a temporary manager performs the upload right away
+ */
+static bool nexus_texture_upload(NexusTexture* texture, const SDL_GPUTextureRegion* region,
+                                 const void* data, uint32_t size) {
+    NexusUploadManager* uploader = nexus_upload_manager_get(texture->device);
+    if (uploader != NULL) {
+        return nexus_upload_manager_upload_texture(uploader, region, data, size, false);
+    }
+
+    uploader = nexus_upload_manager_create(texture->device, size);
+    if (uploader == NULL) {
+        return false;
+    }
+
+    bool success = nexus_upload_manager_upload_texture(uploader, region, data, size, false);
+    nexus_upload_manager_destroy(uploader);
+    return success;
+}
+
+/**
+ * Check whether a texture format is block compressed
+ */
+bool nexus_texture_format_is_compressed(NexusTextureFormat format) {
+    return format == NEXUS_TEXTURE_FORMAT_BC1 ||
+           format == NEXUS_TEXTURE_FORMAT_BC3 ||
+           format == NEXUS_TEXTURE_FORMAT_BC7 ||
+           format == NEXUS_TEXTURE_FORMAT_ASTC_4X4 ||
+           format == NEXUS_TEXTURE_FORMAT_ASTC_6X6 ||
+           format == NEXUS_TEXTURE_FORMAT_ASTC_8X8;
+}
+
+/**
+ * Get the source data size of one layer of a mip level
+ */
+size_t nexus_texture_get_mip_size(const NexusTexture* texture, uint32_t mip_level) {
+    if (texture == NULL || mip_level >= texture->mip_levels) {
+        return 0;
+    }
+
+    NexusTextureFormatInfo info;
+    if (!nexus_texture_get_format_info(texture->format, &info)) {
+        return 0;
+    }
+
+    uint32_t width = texture->width >> mip_level;
+    uint32_t height = texture->height >> mip_level;
+    uint32_t depth = texture->type == NEXUS_TEXTURE_TYPE_3D ? texture->depth >> mip_level : 1;
+    if (width == 0) width = 1;
+    if (height == 0) height = 1;
+    if (depth == 0) depth = 1;
+
+    size_t blocks_x = (width + info.block_width - 1) / info.block_width;
+    size_t blocks_y = (height + info.block_height - 1) / info.block_height;
+    return blocks_x * blocks_y * depth * info.block_size;
+}
+
+/**
+ * Set the data of one mip level of one layer (cube face or array slice)
+ * Compressed data is uploaded as is, 3D textures take the whole volume
+ */
+bool nexus_texture_set_mip_data(NexusTexture* texture, uint32_t mip_level, uint32_t layer, const void* data, size_t size) {
+    if (texture == NULL || texture->gpu_texture == NULL || data == NULL || size == 0) {
+        return false;
+    }
+
+    if (mip_level >= texture->mip_levels || layer >= nexus_texture_get_layer_count(texture)) {
+        fprintf(stderr, "Invalid mip level %u / layer %u for texture '%s'\n", mip_level, layer, texture->name);
+        return false;
+    }
+
+    NexusTextureFormatInfo info;
+    if (!nexus_texture_get_format_info(texture->format, &info)) {
+        fprintf(stderr, "Unknown texture format: %d\n", texture->format);
+        return false;
+    }
+
+    /* Validate data size */
+    size_t expected_size = nexus_texture_get_mip_size(texture, mip_level);
     if (size < expected_size) {
         fprintf(stderr, "Texture data size too small: expected %zu bytes, got %zu bytes\n", expected_size, size);
         return false;
     }
 
-    /* Since SDL3's buffer API is still evolving, we'll implement a simpler version */
-    printf("Texture data upload requested for '%s' (%ux%u, size=%zu bytes)\n", 
-           texture->name, texture->width, texture->height, size);
-    
-    /* For now, we'll just return success */
-    return true;
-    /* Simplified texture data setting */
-    /* Just print information and return success */
-    printf("Setting data for texture '%s' (%ux%u, %zu bytes)\n", 
-           texture->name, texture->width, texture->height, size);
-    return true;
+    /* Destination region */
+    SDL_GPUTextureRegion region = {
+        .texture = texture->gpu_texture,
+        .mip_level = mip_level,
+        .layer = layer,
+        .x = 0,
+        .y = 0,
+        .z = 0,
+        .w = texture->width >> mip_level,
+        .h = texture->height >> mip_level,
+        .d = texture->type == NEXUS_TEXTURE_TYPE_3D ? texture->depth >> mip_level : 1
+    };
+    if (region.w == 0) region.w = 1;
+    if (region.h == 0) region.h = 1;
+    if (region.d == 0) region.d = 1;
+
+    /* Three channel data is widened to the four channel GPU format */
+    const void* upload_data = data;
+    size_t upload_size = expected_size;
+    void* expanded = NULL;
+    if (info.channels == 3) {
+        size_t texel_count = (size_t)region.w * region.h * region.d;
+        expanded = nexus_texture_expand_rgb(data, texel_count, info.channel_size);
+        if (expanded == NULL) {
+            return false;
+        }
+        upload_data = expanded;
+        upload_size = texel_count * 4 * info.channel_size;
+    }
+
+    bool success = nexus_texture_upload(texture, &region, upload_data, (uint32_t)upload_size);
+    free(expanded);
+
+    if (!success) {
+        fprintf(stderr, "Failed to upload data for texture '%s'\n", texture->name);
+    }
+    return success;
 }
 
-/* This is a stub function that would be removed in the full implementation */
-static bool texture_stub_function(void) {
-    /* This is just to avoid the unused staging_buffer error */
-    return true;
+/**
+ * Set texture data
+ * Fills mip level 0 of every layer, data holds the layers back to back
+ */
+bool nexus_texture_set_data(NexusTexture* texture, const void* data, size_t size) {
+    if (texture == NULL || texture->gpu_texture == NULL || data == NULL || size == 0) {
+        return false;
+    }
+
+    /* Calculate expected data size */
+    uint32_t layer_count = nexus_texture_get_layer_count(texture);
+    size_t layer_size = nexus_texture_get_mip_size(texture, 0);
+    if (layer_size == 0) {
+        fprintf(stderr, "Unknown texture format: %d\n", texture->format);
+        return false;
+    }
+
+    size_t expected_size = layer_size * layer_count;
+    if (size < expected_size) {
+        fprintf(stderr, "Texture data size too small: expected %zu bytes, got %zu bytes\n", expected_size, size);
+        return false;
+    }
 
-    /* Function simplified - the more complex implementation above will be implemented
-       once the SDL3 GPU API is more stable */
+    /* Upload each layer */
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (uint32_t layer = 0; layer < layer_count; layer++) {
+        if (!nexus_texture_set_mip_data(texture, 0, layer, bytes + layer * layer_size, layer_size)) {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 /**
  * Generate mipmaps for a texture
+ * The blits are recorded with the next upload batch, after the level 0 data it depends on
  */
 bool nexus_texture_generate_mipmaps(NexusTexture* texture) {
     if (texture == NULL || texture->gpu_texture == NULL) {
@@ -358,10 +581,26 @@ bool nexus_texture_generate_mipmaps(NexusTexture* texture) {
         return false;
     }
 
-    /* Placeholder for future implementation */
-    printf("Generate mipmaps requested for texture '%s'\n", texture->name);
-    
-    return true;
+    /* Compressed formats cannot be rendered to, their mip chain has to come with the data */
+    if (nexus_texture_format_is_compressed(texture->format)) {
+        fprintf(stderr, "Cannot generate mipmaps for compressed texture '%s'\n", texture->name);
+        return false;
+    }
+
+    NexusUploadManager* uploader = nexus_upload_manager_get(texture->device);
+    if (uploader != NULL) {
+        return nexus_upload_manager_generate_mipmaps(uploader, texture->gpu_texture);
+    }
+
+    /* No upload manager, generate right away */
+    SDL_GPUCommandBuffer* cmd_buffer = SDL_AcquireGPUCommandBuffer(texture->device);
+    if (cmd_buffer == NULL) {
+        fprintf(stderr, "Failed to acquire command buffer: %s\n", SDL_GetError());
+        return false;
+    }
+
+    SDL_GenerateMipmapsForGPUTexture(cmd_buffer, texture->gpu_texture);
+    return SDL_SubmitGPUCommandBuffer(cmd_buffer);
 }
 
 /**
@@ -423,51 +662,96 @@ void nexus_texture_bind(NexusTexture* texture, SDL_GPURenderPass* render_pass, u
         return;
     }
 
-    /* Simplified texture binding - SDL3 binding API is still evolving */
-    printf("Texture '%s' binding requested (binding = %u)\n", texture->name, binding);
+    /* Bind texture and sampler to the fragment sampler slot */
+    SDL_GPUTextureSamplerBinding sampler_binding = {
+        .texture = texture->gpu_texture,
+        .sampler = texture->sampler
+    };
+    SDL_BindGPUFragmentSamplers(render_pass, binding, &sampler_binding, 1);
 }
 
 /**
- * Load a texture from a file
+ * Decode an image file into tightly packed RGBA8 texels
+ * Only touches CPU memory, so it can run on any thread
  */
-NexusTexture* nexus_texture_load_from_file(SDL_GPUDevice* device, const char* filename, bool generate_mipmaps) {
-    if (device == NULL || filename == NULL) {
-        return NULL;
+bool nexus_texture_decode_file(const char* filename, NexusImageData* image) {
+    if (filename == NULL || image == NULL) {
+        return false;
     }
+    memset(image, 0, sizeof(NexusImageData));
 
     /* Load image using SDL - since SDL_image might not be available */
     SDL_Surface* surface = SDL_LoadBMP(filename);
     if (surface == NULL) {
         fprintf(stderr, "Failed to load image '%s': %s\n", filename, SDL_GetError());
-        
-        /* Create a placeholder texture instead */
-        NexusTexture* placeholder = nexus_texture_create_solid_color(device, 1.0f, 0.0f, 1.0f, 1.0f);
-        if (placeholder) {
-            printf("Created magenta placeholder texture for '%s'\n", filename);
+        return false;
+    }
+
+    /* Convert to tightly packed RGBA8, the layout of NEXUS_TEXTURE_FORMAT_R8G8B8A8 */
+    if (surface->format != SDL_PIXELFORMAT_RGBA32) {
+        SDL_Surface* converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(surface);
+        if (converted == NULL) {
+            fprintf(stderr, "Failed to convert image '%s': %s\n", filename, SDL_GetError());
+            return false;
         }
-        return placeholder;
-        return NULL;
+        surface = converted;
     }
 
-    /* Determine texture format based on surface format */
-    /* Determine texture format - assume RGBA for now */
-    NexusTextureFormat format = NEXUS_TEXTURE_FORMAT_R8G8B8A8;
-    
-    /* For SDL3, we need to access format properties differently than older SDL */
-    /* Format determination is simplified for SDL3 */
+    /* Copy the texels out, repacking rows if the surface is padded */
+    size_t row_size = (size_t)surface->w * 4;
+    image->pixels = malloc(row_size * surface->h);
+    if (image->pixels == NULL) {
+        fprintf(stderr, "Failed to allocate memory for image '%s'!\n", filename);
+        SDL_DestroySurface(surface);
+        return false;
+    }
 
-    /* Extract filename without path for texture name */
-    const char* name = filename;
-    const char* last_slash = strrchr(filename, '/');
-    if (last_slash != NULL) {
-        name = last_slash + 1;
+    if ((size_t)surface->pitch == row_size) {
+        memcpy(image->pixels, surface->pixels, row_size * surface->h);
+    } else {
+        for (int y = 0; y < surface->h; y++) {
+            memcpy((uint8_t*)image->pixels + y * row_size, (const uint8_t*)surface->pixels + y * surface->pitch,
+                   row_size);
+        }
+    }
+
+    image->size = row_size * surface->h;
+    image->width = (uint32_t)surface->w;
+    image->height = (uint32_t)surface->h;
+    image->format = NEXUS_TEXTURE_FORMAT_R8G8B8A8;
+
+    /* Free the surface */
+    SDL_DestroySurface(surface);
+    return true;
+}
+
+/**
+ * Free decoded image data
+ */
+void nexus_image_data_free(NexusImageData* image) {
+    if (image == NULL) {
+        return;
+    }
+
+    free(image->pixels);
+    memset(image, 0, sizeof(NexusImageData));
+}
+
+/**
+ * Create a texture from decoded image data
+ * The texels are staged in the shared upload ring, mipmaps are generated on the GPU
+ */
+NexusTexture* nexus_texture_create_from_image(SDL_GPUDevice* device, const char* name, const NexusImageData* image,
+                                              bool generate_mipmaps) {
+    if (device == NULL || image == NULL || image->pixels == NULL) {
+        return NULL;
     }
 
     /* Calculate mip levels if we're generating mipmaps */
     uint32_t mip_levels = 1;
     if (generate_mipmaps) {
-        uint32_t max_dimension = surface->w > surface->h ? surface->w : surface->h;
-        mip_levels = 1;
+        uint32_t max_dimension = image->width > image->height ? image->width : image->height;
         while (max_dimension > 1) {
             max_dimension >>= 1;
             mip_levels++;
@@ -476,26 +760,56 @@ NexusTexture* nexus_texture_load_from_file(SDL_GPUDevice* device, const char* fi
 
     /* Create texture */
     NexusTexture* texture = nexus_texture_create(device, name, NEXUS_TEXTURE_TYPE_2D,
-                                               surface->w, surface->h, 1, format, mip_levels);
+                                               image->width, image->height, 1, image->format, mip_levels);
     if (texture == NULL) {
-        SDL_DestroySurface(surface);
         return NULL;
     }
 
     /* Set texture data */
-    bool success = nexus_texture_set_data(texture, surface->pixels,
-                                         surface->w * surface->h * 4); /* Assume RGBA */
-
-    /* Free the surface */
-    SDL_DestroySurface(surface);
+    if (!nexus_texture_set_data(texture, image->pixels, image->size)) {
+        nexus_texture_destroy(texture);
+        return NULL;
+    }
 
-    /* Note: since our set_data function always returns true, we don't need to check success */
-    
-    /* Generate mipmaps if requested */
+    /* Generate mipmaps on the GPU if requested */
     if (generate_mipmaps) {
         nexus_texture_generate_mipmaps(texture);
     }
-    
+
+    return texture;
+}
+
+/**
+ * Load a texture from file
+ */
+NexusTexture* nexus_texture_load_from_file(SDL_GPUDevice* device, const char* filename, bool generate_mipmaps) {
+    if (device == NULL || filename == NULL) {
+        return NULL;
+    }
+
+    NexusImageData image;
+    if (!nexus_texture_decode_file(filename, &image)) {
+        /* Create a placeholder texture instead */
+        NexusTexture* placeholder = nexus_texture_create_solid_color(device, 1.0f, 0.0f, 1.0f, 1.0f);
+        if (placeholder) {
+            printf("Created magenta placeholder texture for '%s'\n", filename);
+        }
+        return placeholder;
+    }
+
+    /* Extract filename without path for texture name */
+    const char* name = filename;
+    const char* last_slash = strrchr(filename, '/');
+    if (last_slash != NULL) {
+        name = last_slash + 1;
+    }
+
+    NexusTexture* texture = nexus_texture_create_from_image(device, name, &image, generate_mipmaps);
+    nexus_image_data_free(&image);
+    if (texture == NULL) {
+        return NULL;
+    }
+
     printf("Loaded texture from file '%s' (%ux%u)\n", filename, texture->width, texture->height);
 
     return texture;
@@ -525,6 +839,187 @@ NexusTexture* nexus_texture_load_cubemap_from_files(SDL_GPUDevice* device, const
     return texture;
 }
 
+/* Container magic numbers */
+#define NEXUS_DDS_MAGIC  0x20534444u   /* "DDS " */
+#define NEXUS_ASTC_MAGIC 0x5CA1AB13u
+
+/* DDS header fields (offsets from the start of the file) */
+#define NEXUS_DDS_HEADER_SIZE   128u   /* Magic plus DDS_HEADER */
+#define NEXUS_DDS_DX10_SIZE     20u    /* DDS_HEADER_DXT10 */
+#define NEXUS_DDS_CUBEMAP       0x200u /* DDSCAPS2_CUBEMAP */
+
+/* DXGI formats found in DX10 headers */
+#define NEXUS_DXGI_BC1_UNORM    71u
+#define NEXUS_DXGI_BC1_SRGB     72u
+#define NEXUS_DXGI_BC3_UNORM    77u
+#define NEXUS_DXGI_BC3_SRGB     78u
+#define NEXUS_DXGI_BC7_UNORM    98u
+#define NEXUS_DXGI_BC7_SRGB     99u
+
+/**
+ * Read a little endian 32-bit value
+ */
+static uint32_t nexus_texture_read_u32(const uint8_t* bytes) {
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) |
+           ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+/**
+ * Read a little endian 24-bit value
+ */
+static uint32_t nexus_texture_read_u24(const uint8_t* bytes) {
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16);
+}
+
+/**
+ * Create a compressed texture and upload its mip chain
+ * Data holds every layer's full mip chain, layer after layer
+ */
+static NexusTexture* nexus_texture_create_compressed(SDL_GPUDevice* device, const char* name,
+                                                     NexusTextureType type, uint32_t width, uint32_t height,
+                                                     NexusTextureFormat format, uint32_t mip_levels,
+                                                     const uint8_t* data, size_t size) {
+    /* Not every GPU samples every block format (BC on desktop, ASTC on mobile) */
+    SDL_GPUTextureFormat sdl_format = nexus_format_to_sdl(format);
+    if (!SDL_GPUTextureSupportsFormat(device, sdl_format, nexus_type_to_sdl(type), SDL_GPU_TEXTUREUSAGE_SAMPLER)) {
+        fprintf(stderr, "GPU does not support the compressed format of texture '%s'\n", name);
+        return NULL;
+    }
+
+    NexusTexture* texture = nexus_texture_create(device, name, type, width, height, 1, format, mip_levels);
+    if (texture == NULL) {
+        return NULL;
+    }
+
+    /* Upload every level of every layer */
+    uint32_t layer_count = nexus_texture_get_layer_count(texture);
+    size_t offset = 0;
+    for (uint32_t layer = 0; layer < layer_count; layer++) {
+        for (uint32_t level = 0; level < texture->mip_levels; level++) {
+            size_t level_size = nexus_texture_get_mip_size(texture, level);
+            if (offset + level_size > size) {
+                fprintf(stderr, "Compressed texture '%s' is truncated\n", name);
+                nexus_texture_destroy(texture);
+                return NULL;
+            }
+
+            if (!nexus_texture_set_mip_data(texture, level, layer, data + offset, level_size)) {
+                nexus_texture_destroy(texture);
+                return NULL;
+            }
+            offset += level_size;
+        }
+    }
+
+    return texture;
+}
+
+/**
+ * Load a pre-compressed texture from a DDS (BC1/BC3/BC7) or ASTC file
+ * The texture keeps the file's block format and mip chain
+ */
+NexusTexture* nexus_texture_load_compressed(SDL_GPUDevice* device, const char* filename) {
+    if (device == NULL || filename == NULL) {
+        return NULL;
+    }
+
+    /* Read the whole file */
+    size_t file_size = 0;
+    uint8_t* file_data = (uint8_t*)SDL_LoadFile(filename, &file_size);
+    if (file_data == NULL) {
+        fprintf(stderr, "Failed to load compressed texture '%s': %s\n", filename, SDL_GetError());
+        return NULL;
+    }
+
+    /* Extract filename without path for texture name */
+    const char* name = filename;
+    const char* last_slash = strrchr(filename, '/');
+    if (last_slash != NULL) {
+        name = last_slash + 1;
+    }
+
+    NexusTexture* texture = NULL;
+    uint32_t magic = file_size >= 4 ? nexus_texture_read_u32(file_data) : 0;
+
+    if (magic == NEXUS_DDS_MAGIC && file_size >= NEXUS_DDS_HEADER_SIZE) {
+        uint32_t height = nexus_texture_read_u32(file_data + 12);
+        uint32_t width = nexus_texture_read_u32(file_data + 16);
+        uint32_t mip_levels = nexus_texture_read_u32(file_data + 28);
+        uint32_t four_cc = nexus_texture_read_u32(file_data + 84);
+        uint32_t caps2 = nexus_texture_read_u32(file_data + 112);
+        size_t data_offset = NEXUS_DDS_HEADER_SIZE;
+
+        /* Block format from the FourCC or the DX10 extension header */
+        bool supported = true;
+        NexusTextureFormat format = NEXUS_TEXTURE_FORMAT_BC1;
+        if (four_cc == 0x31545844u) {          /* "DXT1" */
+            format = NEXUS_TEXTURE_FORMAT_BC1;
+        } else if (four_cc == 0x35545844u) {   /* "DXT5" */
+            format = NEXUS_TEXTURE_FORMAT_BC3;
+        } else if (four_cc == 0x30315844u && file_size >= NEXUS_DDS_HEADER_SIZE + NEXUS_DDS_DX10_SIZE) { /* "DX10" */
+            uint32_t dxgi_format = nexus_texture_read_u32(file_data + NEXUS_DDS_HEADER_SIZE);
+            data_offset += NEXUS_DDS_DX10_SIZE;
+            if (dxgi_format == NEXUS_DXGI_BC1_UNORM || dxgi_format == NEXUS_DXGI_BC1_SRGB) {
+                format = NEXUS_TEXTURE_FORMAT_BC1;
+            } else if (dxgi_format == NEXUS_DXGI_BC3_UNORM || dxgi_format == NEXUS_DXGI_BC3_SRGB) {
+                format = NEXUS_TEXTURE_FORMAT_BC3;
+            } else if (dxgi_format == NEXUS_DXGI_BC7_UNORM || dxgi_format == NEXUS_DXGI_BC7_SRGB) {
+                format = NEXUS_TEXTURE_FORMAT_BC7;
+            } else {
+                supported = false;
+            }
+        } else {
+            supported = false;
+        }
+
+        if (supported) {
+            NexusTextureType type = (caps2 & NEXUS_DDS_CUBEMAP) ? NEXUS_TEXTURE_TYPE_CUBE : NEXUS_TEXTURE_TYPE_2D;
+            texture = nexus_texture_create_compressed(device, name, type, width, height, format,
+                                                      mip_levels > 0 ? mip_levels : 1,
+                                                      file_data + data_offset, file_size - data_offset);
+        } else {
+            fprintf(stderr, "Unsupported DDS format in '%s' (expected BC1, BC3 or BC7)\n", filename);
+        }
+    } else if (magic == NEXUS_ASTC_MAGIC && file_size >= 16) {
+        uint32_t block_x = file_data[4];
+        uint32_t block_y = file_data[5];
+        uint32_t block_z = file_data[6];
+        uint32_t width = nexus_texture_read_u24(file_data + 7);
+        uint32_t height = nexus_texture_read_u24(file_data + 10);
+
+        /* ASTC files hold a single 2D level */
+        bool supported = block_z == 1 && block_x == block_y;
+        NexusTextureFormat format = NEXUS_TEXTURE_FORMAT_ASTC_4X4;
+        if (block_x == 4) {
+            format = NEXUS_TEXTURE_FORMAT_ASTC_4X4;
+        } else if (block_x == 6) {
+            format = NEXUS_TEXTURE_FORMAT_ASTC_6X6;
+        } else if (block_x == 8) {
+            format = NEXUS_TEXTURE_FORMAT_ASTC_8X8;
+        } else {
+            supported = false;
+        }
+
+        if (supported) {
+            texture = nexus_texture_create_compressed(device, name, NEXUS_TEXTURE_TYPE_2D, width, height,
+                                                      format, 1, file_data + 16, file_size - 16);
+        } else {
+            fprintf(stderr, "Unsupported ASTC block size %ux%ux%u in '%s'\n", block_x, block_y, block_z, filename);
+        }
+    } else {
+        fprintf(stderr, "Unrecognized compressed texture container '%s'\n", filename);
+    }
+
+    SDL_free(file_data);
+
+    if (texture != NULL) {
+        printf("Loaded compressed texture from file '%s' (%ux%u, %u mips)\n",
+               filename, texture->width, texture->height, texture->mip_levels);
+    }
+
+    return texture;
+}
+
 /**
  * Create a solid color texture
  */
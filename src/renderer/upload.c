@@ -0,0 +1,651 @@
+/**
+ * Nexus3D Upload Manager Implementation
+ * Staging ring allocation, batched copy passes and fence based reclamation
+ */
+
+#include "nexus3d/renderer/upload.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Number of devices that can have an upload manager at the same time */
+#define NEXUS_UPLOAD_MAX_DEVICES 4
+
+/**
+ * Device to upload manager registry, lets resources created from a bare
+ * SDL_GPUDevice find the shared ring
+ */
+static struct {
+    SDL_GPUDevice* device;
+    NexusUploadManager* manager;
+} s_upload_managers[NEXUS_UPLOAD_MAX_DEVICES];
+
+/**
+ * Round a size up to the staging alignment
+ */
+static uint32_t nexus_upload_align(uint32_t size) {
+    return (size + NEXUS_UPLOAD_ALIGNMENT - 1) & ~(NEXUS_UPLOAD_ALIGNMENT - 1);
+}
+
+/**
+ * Release the oldest in-flight batch and move the ring tail past it
+ */
+static void nexus_upload_manager_retire_oldest(NexusUploadManager* manager) {
+    NexusUploadBatch* oldest = &manager->batches[0];
+    if (oldest->fence != NULL) {
+        SDL_ReleaseGPUFence(manager->device, oldest->fence);
+    }
+    manager->tail = oldest->ring_end;
+
+    manager->batch_count--;
+    memmove(&manager->batches[0], &manager->batches[1], sizeof(NexusUploadBatch) * manager->batch_count);
+}
+
+/**
+ * Block until the oldest in-flight batch has executed and retire it
+ */
+static void nexus_upload_manager_wait_oldest(NexusUploadManager* manager) {
+    if (manager->batch_count == 0) {
+        return;
+    }
+
+    SDL_GPUFence* fence = manager->batches[0].fence;
+    if (fence != NULL) {
+        SDL_WaitForGPUFences(manager->device, true, &fence, 1);
+    }
+    nexus_upload_manager_retire_oldest(manager);
+}
+
+/**
+ * Make sure the ring is mapped for writing
+ * Regions handed out by the allocator are never in use by the GPU, so the
+ * ring is mapped without cycling
+ */
+static bool nexus_upload_manager_map(NexusUploadManager* manager) {
+    if (manager->mapped != NULL) {
+        return true;
+    }
+
+    manager->mapped = (uint8_t*)SDL_MapGPUTransferBuffer(manager->device, manager->ring, false);
+    if (manager->mapped == NULL) {
+        fprintf(stderr, "Failed to map upload ring: %s\n", SDL_GetError());
+        return false;
+    }
+
+    return true;
+}
+
+static bool nexus_upload_manager_submit(NexusUploadManager* manager);
+
+/**
+ * Allocate a region of the staging ring
+ * Flushes the pending batch or waits for in-flight batches when the ring is full
+ */
+static bool nexus_upload_manager_allocate(NexusUploadManager* manager, uint32_t size, uint32_t* out_offset) {
+    size = nexus_upload_align(size);
+    if (size > manager->ring_size) {
+        return false;
+    }
+
+    for (;;) {
+        nexus_upload_manager_reclaim(manager);
+
+        /* Regions never wrap, skip to the start of the ring instead */
+        uint32_t offset = (uint32_t)(manager->head % manager->ring_size);
+        uint32_t padding = offset + size > manager->ring_size ? manager->ring_size - offset : 0;
+
+        if (manager->head + padding + size - manager->tail <= manager->ring_size) {
+            manager->head += padding;
+            *out_offset = (uint32_t)(manager->head % manager->ring_size);
+            manager->head += size;
+            return true;
+        }
+
+        /* Out of space, free some by submitting our own copies or waiting for the GPU */
+        if (manager->copy_count > 0) {
+            if (!nexus_upload_manager_submit(manager)) {
+                return false;
+            }
+        } else if (manager->batch_count > 0) {
+            nexus_upload_manager_wait_oldest(manager);
+        } else {
+            /* Nothing in flight, restart at the beginning of the ring */
+            manager->head += padding;
+            manager->tail = manager->head;
+        }
+    }
+}
+
+/**
+ * Append a copy to the pending batch
+ */
+static NexusUploadCopy* nexus_upload_manager_push_copy(NexusUploadManager* manager) {
+    if (manager->copy_count == manager->copy_capacity) {
+        uint32_t capacity = manager->copy_capacity > 0 ? manager->copy_capacity * 2 : 64;
+        NexusUploadCopy* copies = (NexusUploadCopy*)realloc(manager->copies, sizeof(NexusUploadCopy) * capacity);
+        if (copies == NULL) {
+            fprintf(stderr, "Failed to grow upload copy list!\n");
+            return NULL;
+        }
+        manager->copies = copies;
+        manager->copy_capacity = capacity;
+    }
+
+    NexusUploadCopy* copy = &manager->copies[manager->copy_count++];
+    memset(copy, 0, sizeof(NexusUploadCopy));
+    return copy;
+}
+
+/**
+ * Reserve staging memory for a copy and return where to write its data
+ * Uploads larger than the ring get a dedicated transfer buffer, which stays
+ * mapped until the batch is flushed
+ */
+static void* nexus_upload_manager_stage(NexusUploadManager* manager, uint32_t size, NexusUploadCopy* copy) {
+    uint32_t offset;
+    if (nexus_upload_manager_allocate(manager, size, &offset)) {
+        if (!nexus_upload_manager_map(manager)) {
+            return NULL;
+        }
+        copy->transfer = NULL;
+        copy->source_offset = offset;
+        copy->size = size;
+        manager->bytes_uploaded += size;
+        return manager->mapped + offset;
+    }
+
+    /* Oversized upload, released again once the batch has been recorded */
+    SDL_GPUTransferBufferCreateInfo transfer_info = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = size
+    };
+    SDL_GPUTransferBuffer* transfer = SDL_CreateGPUTransferBuffer(manager->device, &transfer_info);
+    if (transfer == NULL) {
+        fprintf(stderr, "Failed to create upload transfer buffer: %s\n", SDL_GetError());
+        return NULL;
+    }
+
+    void* mapped = SDL_MapGPUTransferBuffer(manager->device, transfer, false);
+    if (mapped == NULL) {
+        fprintf(stderr, "Failed to map upload transfer buffer: %s\n", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(manager->device, transfer);
+        return NULL;
+    }
+
+    copy->transfer = transfer;
+    copy->source_offset = 0;
+    copy->size = size;
+    manager->bytes_uploaded += size;
+    return mapped;
+}
+
+/**
+ * Release the dedicated transfer buffer of a copy that is not going to be recorded
+ */
+static void nexus_upload_manager_drop_copy(NexusUploadManager* manager, NexusUploadCopy* copy) {
+    if (copy->transfer != NULL) {
+        SDL_UnmapGPUTransferBuffer(manager->device, copy->transfer);
+        SDL_ReleaseGPUTransferBuffer(manager->device, copy->transfer);
+        copy->transfer = NULL;
+    }
+}
+
+/**
+ * Create an upload manager and register it for the device
+ */
+NexusUploadManager* nexus_upload_manager_create(SDL_GPUDevice* device, uint32_t ring_size) {
+    /* Check for null parameters */
+    if (device == NULL) {
+        fprintf(stderr, "GPU device cannot be NULL when creating upload manager!\n");
+        return NULL;
+    }
+
+    /* Allocate manager structure */
+    NexusUploadManager* manager = (NexusUploadManager*)malloc(sizeof(NexusUploadManager));
+    if (manager == NULL) {
+        fprintf(stderr, "Failed to allocate memory for upload manager!\n");
+        return NULL;
+    }
+
+    /* Initialize manager structure */
+    memset(manager, 0, sizeof(NexusUploadManager));
+    manager->device = device;
+    manager->ring_size = nexus_upload_align(ring_size > 0 ? ring_size : NEXUS_UPLOAD_RING_SIZE);
+
+    /* Resources are created and uploaded from the simulation and render threads */
+    manager->lock = SDL_CreateMutex();
+    if (manager->lock == NULL) {
+        fprintf(stderr, "Failed to create upload manager lock: %s\n", SDL_GetError());
+        free(manager);
+        return NULL;
+    }
+
+    /* Create the staging ring */
+    SDL_GPUTransferBufferCreateInfo transfer_info = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = manager->ring_size
+    };
+    manager->ring = SDL_CreateGPUTransferBuffer(device, &transfer_info);
+    if (manager->ring == NULL) {
+        fprintf(stderr, "Failed to create upload ring: %s\n", SDL_GetError());
+        SDL_DestroyMutex(manager->lock);
+        free(manager);
+        return NULL;
+    }
+
+    /* Register for the device */
+    for (int i = 0; i < NEXUS_UPLOAD_MAX_DEVICES; i++) {
+        if (s_upload_managers[i].device == NULL) {
+            s_upload_managers[i].device = device;
+            s_upload_managers[i].manager = manager;
+            break;
+        }
+    }
+
+    return manager;
+}
+
+/**
+ * Destroy an upload manager, flushing and waiting for outstanding uploads
+ */
+void nexus_upload_manager_destroy(NexusUploadManager* manager) {
+    if (manager == NULL) {
+        return;
+    }
+
+    /* Finish outstanding work */
+    nexus_upload_manager_flush(manager);
+    nexus_upload_manager_wait_idle(manager);
+
+    /* Unregister */
+    for (int i = 0; i < NEXUS_UPLOAD_MAX_DEVICES; i++) {
+        if (s_upload_managers[i].manager == manager) {
+            s_upload_managers[i].device = NULL;
+            s_upload_managers[i].manager = NULL;
+        }
+    }
+
+    /* Release the ring */
+    if (manager->mapped != NULL) {
+        SDL_UnmapGPUTransferBuffer(manager->device, manager->ring);
+        manager->mapped = NULL;
+    }
+    if (manager->ring != NULL) {
+        SDL_ReleaseGPUTransferBuffer(manager->device, manager->ring);
+        manager->ring = NULL;
+    }
+
+    /* Free manager structure */
+    SDL_DestroyMutex(manager->lock);
+    free(manager->copies);
+    free(manager);
+}
+
+/**
+ * Get the upload manager registered for a device (NULL if there is none)
+ */
+NexusUploadManager* nexus_upload_manager_get(SDL_GPUDevice* device) {
+    if (device == NULL) {
+        return NULL;
+    }
+
+    for (int i = 0; i < NEXUS_UPLOAD_MAX_DEVICES; i++) {
+        if (s_upload_managers[i].device == device) {
+            return s_upload_managers[i].manager;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Lock the manager for the calling thread
+ * Held while filling memory from nexus_upload_manager_begin_buffer, when other
+ * threads upload through the same manager. The lock is recursive
+ */
+void nexus_upload_manager_lock(NexusUploadManager* manager) {
+    if (manager == NULL) {
+        return;
+    }
+
+    SDL_LockMutex(manager->lock);
+}
+
+/**
+ * Unlock the manager
+ */
+void nexus_upload_manager_unlock(NexusUploadManager* manager) {
+    if (manager == NULL) {
+        return;
+    }
+
+    SDL_UnlockMutex(manager->lock);
+}
+
+/**
+ * Stage a buffer copy, the caller holds the lock
+ */
+static void* nexus_upload_manager_stage_buffer(NexusUploadManager* manager, SDL_GPUBuffer* buffer, uint32_t offset,
+                                               uint32_t size, bool cycle) {
+    NexusUploadCopy copy;
+    memset(&copy, 0, sizeof(copy));
+    void* staging = nexus_upload_manager_stage(manager, size, &copy);
+    if (staging == NULL) {
+        return NULL;
+    }
+
+    NexusUploadCopy* pending = nexus_upload_manager_push_copy(manager);
+    if (pending == NULL) {
+        nexus_upload_manager_drop_copy(manager, &copy);
+        return NULL;
+    }
+
+    *pending = copy;
+    pending->type = NEXUS_UPLOAD_BUFFER;
+    pending->buffer = buffer;
+    pending->buffer_offset = offset;
+    pending->cycle = cycle;
+    return staging;
+}
+
+/**
+ * Reserve staging memory for an upload into a region of a GPU buffer
+ * The returned memory must be filled before the next upload call or flush,
+ * with the manager locked if other threads use it
+ */
+void* nexus_upload_manager_begin_buffer(NexusUploadManager* manager, SDL_GPUBuffer* buffer, uint32_t offset,
+                                        uint32_t size, bool cycle) {
+    if (manager == NULL || buffer == NULL || size == 0) {
+        return NULL;
+    }
+
+    SDL_LockMutex(manager->lock);
+    void* staging = nexus_upload_manager_stage_buffer(manager, buffer, offset, size, cycle);
+    SDL_UnlockMutex(manager->lock);
+    return staging;
+}
+
+/**
+ * Queue an upload into a region of a GPU buffer
+ * The data is copied immediately, the GPU copy runs with the next flush
+ */
+bool nexus_upload_manager_upload_buffer(NexusUploadManager* manager, SDL_GPUBuffer* buffer, uint32_t offset,
+                                        const void* data, uint32_t size, bool cycle) {
+    if (manager == NULL || buffer == NULL || data == NULL || size == 0) {
+        return false;
+    }
+
+    /* The copy into the ring completes before another thread can flush it */
+    SDL_LockMutex(manager->lock);
+    void* staging = nexus_upload_manager_stage_buffer(manager, buffer, offset, size, cycle);
+    if (staging != NULL) {
+        memcpy(staging, data, size);
+    }
+    SDL_UnlockMutex(manager->lock);
+
+    return staging != NULL;
+}
+
+/**
+ * Queue an upload into a texture region
+ * The data must be tightly packed rows of the region's width
+ */
+bool nexus_upload_manager_upload_texture(NexusUploadManager* manager, const SDL_GPUTextureRegion* region,
+                                         const void* data, uint32_t size, bool cycle) {
+    if (manager == NULL || region == NULL || region->texture == NULL || data == NULL || size == 0) {
+        return false;
+    }
+
+    SDL_LockMutex(manager->lock);
+    NexusUploadCopy copy;
+    memset(&copy, 0, sizeof(copy));
+    void* staging = nexus_upload_manager_stage(manager, size, &copy);
+    if (staging == NULL) {
+        SDL_UnlockMutex(manager->lock);
+        return false;
+    }
+
+    NexusUploadCopy* pending = nexus_upload_manager_push_copy(manager);
+    if (pending == NULL) {
+        nexus_upload_manager_drop_copy(manager, &copy);
+        SDL_UnlockMutex(manager->lock);
+        return false;
+    }
+
+    memcpy(staging, data, size);
+    *pending = copy;
+    pending->type = NEXUS_UPLOAD_TEXTURE;
+    pending->region = *region;
+    pending->cycle = cycle;
+    SDL_UnlockMutex(manager->lock);
+    return true;
+}
+
+/**
+ * Queue mip chain generation for a texture
+ * Runs after all copies of the batch, so it sees level 0 uploads queued before it
+ */
+bool nexus_upload_manager_generate_mipmaps(NexusUploadManager* manager, SDL_GPUTexture* texture) {
+    if (manager == NULL || texture == NULL) {
+        return false;
+    }
+
+    SDL_LockMutex(manager->lock);
+    NexusUploadCopy* pending = nexus_upload_manager_push_copy(manager);
+    if (pending != NULL) {
+        pending->type = NEXUS_UPLOAD_MIPMAPS;
+        pending->region.texture = texture;
+    }
+    SDL_UnlockMutex(manager->lock);
+
+    return pending != NULL;
+}
+
+/**
+ * Drop pending copies into a buffer that is about to be released
+ */
+void nexus_upload_manager_cancel_buffer(NexusUploadManager* manager, SDL_GPUBuffer* buffer) {
+    if (manager == NULL || buffer == NULL) {
+        return;
+    }
+
+    /* Compact in place, keeping the order of the remaining copies */
+    SDL_LockMutex(manager->lock);
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < manager->copy_count; i++) {
+        NexusUploadCopy* copy = &manager->copies[i];
+        if (copy->type == NEXUS_UPLOAD_BUFFER && copy->buffer == buffer) {
+            nexus_upload_manager_drop_copy(manager, copy);
+            continue;
+        }
+        manager->copies[kept++] = *copy;
+    }
+    manager->copy_count = kept;
+    SDL_UnlockMutex(manager->lock);
+}
+
+/**
+ * Drop pending copies into a texture that is about to be released
+ */
+void nexus_upload_manager_cancel_texture(NexusUploadManager* manager, SDL_GPUTexture* texture) {
+    if (manager == NULL || texture == NULL) {
+        return;
+    }
+
+    /* Compact in place, keeping the order of the remaining copies */
+    SDL_LockMutex(manager->lock);
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < manager->copy_count; i++) {
+        NexusUploadCopy* copy = &manager->copies[i];
+        if (copy->type != NEXUS_UPLOAD_BUFFER && copy->region.texture == texture) {
+            nexus_upload_manager_drop_copy(manager, copy);
+            continue;
+        }
+        manager->copies[kept++] = *copy;
+    }
+    manager->copy_count = kept;
+    SDL_UnlockMutex(manager->lock);
+}
+
+/**
+ * Record the pending copies into a copy pass and submit it, the caller holds the lock
+ */
+static bool nexus_upload_manager_submit(NexusUploadManager* manager) {
+    if (manager->copy_count == 0) {
+        return true;
+    }
+
+    /* Staged data must be unmapped before the copies are recorded */
+    if (manager->mapped != NULL) {
+        SDL_UnmapGPUTransferBuffer(manager->device, manager->ring);
+        manager->mapped = NULL;
+    }
+    for (uint32_t i = 0; i < manager->copy_count; i++) {
+        if (manager->copies[i].transfer != NULL) {
+            SDL_UnmapGPUTransferBuffer(manager->device, manager->copies[i].transfer);
+        }
+    }
+
+    /* Make room for another in-flight batch */
+    if (manager->batch_count == NEXUS_UPLOAD_MAX_BATCHES) {
+        nexus_upload_manager_wait_oldest(manager);
+    }
+
+    SDL_GPUCommandBuffer* cmd_buffer = SDL_AcquireGPUCommandBuffer(manager->device);
+    if (cmd_buffer == NULL) {
+        fprintf(stderr, "Failed to acquire upload command buffer: %s\n", SDL_GetError());
+        return false;
+    }
+
+    SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass(cmd_buffer);
+    if (copy_pass == NULL) {
+        fprintf(stderr, "Failed to begin upload copy pass: %s\n", SDL_GetError());
+        SDL_CancelGPUCommandBuffer(cmd_buffer);
+        return false;
+    }
+
+    /* Record copies */
+    for (uint32_t i = 0; i < manager->copy_count; i++) {
+        NexusUploadCopy* copy = &manager->copies[i];
+        SDL_GPUTransferBuffer* source = copy->transfer != NULL ? copy->transfer : manager->ring;
+
+        if (copy->type == NEXUS_UPLOAD_BUFFER) {
+            SDL_GPUTransferBufferLocation src_location = {
+                .transfer_buffer = source,
+                .offset = copy->source_offset
+            };
+            SDL_GPUBufferRegion dst_region = {
+                .buffer = copy->buffer,
+                .offset = copy->buffer_offset,
+                .size = copy->size
+            };
+            SDL_UploadToGPUBuffer(copy_pass, &src_location, &dst_region, copy->cycle);
+        } else if (copy->type == NEXUS_UPLOAD_TEXTURE) {
+            SDL_GPUTextureTransferInfo src_info = {
+                .transfer_buffer = source,
+                .offset = copy->source_offset,
+                .pixels_per_row = copy->pixels_per_row,
+                .rows_per_layer = copy->rows_per_layer
+            };
+            SDL_UploadToGPUTexture(copy_pass, &src_info, &copy->region, copy->cycle);
+        }
+    }
+
+    SDL_EndGPUCopyPass(copy_pass);
+
+    /* Mip generation blits have to be recorded outside of the copy pass */
+    for (uint32_t i = 0; i < manager->copy_count; i++) {
+        if (manager->copies[i].type == NEXUS_UPLOAD_MIPMAPS) {
+            SDL_GenerateMipmapsForGPUTexture(cmd_buffer, manager->copies[i].region.texture);
+        }
+    }
+
+    /* Submit and remember when this part of the ring becomes free again */
+    SDL_GPUFence* fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmd_buffer);
+    if (fence == NULL) {
+        fprintf(stderr, "Failed to submit upload batch: %s\n", SDL_GetError());
+    }
+
+    NexusUploadBatch* batch = &manager->batches[manager->batch_count++];
+    batch->fence = fence;
+    batch->ring_end = manager->head;
+    manager->batches_submitted++;
+
+    /* Dedicated transfer buffers are kept alive by the GPU until the copy is done */
+    for (uint32_t i = 0; i < manager->copy_count; i++) {
+        if (manager->copies[i].transfer != NULL) {
+            SDL_ReleaseGPUTransferBuffer(manager->device, manager->copies[i].transfer);
+        }
+    }
+    manager->copy_count = 0;
+
+    /* Without a fence we cannot tell when the ring region is free */
+    if (fence == NULL) {
+        SDL_WaitForGPUIdle(manager->device);
+        while (manager->batch_count > 0) {
+            nexus_upload_manager_retire_oldest(manager);
+        }
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Record all pending copies into a single copy pass and submit it
+ * The batch is submitted on its own command buffer, so it executes before any
+ * command buffer submitted after this call
+ */
+bool nexus_upload_manager_flush(NexusUploadManager* manager) {
+    if (manager == NULL) {
+        return true;
+    }
+
+    SDL_LockMutex(manager->lock);
+    bool submitted = nexus_upload_manager_submit(manager);
+    SDL_UnlockMutex(manager->lock);
+    return submitted;
+}
+
+/**
+ * Retire batches the GPU has finished with (non-blocking)
+ */
+void nexus_upload_manager_reclaim(NexusUploadManager* manager) {
+    if (manager == NULL) {
+        return;
+    }
+
+    /* Batches complete in submission order */
+    SDL_LockMutex(manager->lock);
+    while (manager->batch_count > 0 &&
+           (manager->batches[0].fence == NULL || SDL_QueryGPUFence(manager->device, manager->batches[0].fence))) {
+        nexus_upload_manager_retire_oldest(manager);
+    }
+    SDL_UnlockMutex(manager->lock);
+}
+
+/**
+ * Block until every submitted batch has executed
+ */
+void nexus_upload_manager_wait_idle(NexusUploadManager* manager) {
+    if (manager == NULL) {
+        return;
+    }
+
+    SDL_LockMutex(manager->lock);
+    while (manager->batch_count > 0) {
+        nexus_upload_manager_wait_oldest(manager);
+    }
+    SDL_UnlockMutex(manager->lock);
+}
+
+/**
+ * Get the number of copies waiting for the next flush
+ */
+uint32_t nexus_upload_manager_get_pending_count(const NexusUploadManager* manager) {
+    if (manager == NULL) {
+        return 0;
+    }
+
+    return manager->copy_count;
+}
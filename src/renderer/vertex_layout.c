@@ -0,0 +1,229 @@
+/**
+ * Nexus3D Vertex Layouts Implementation
+ * Layout descriptor table and conversion from full precision vertices
+ */
+
+#include "nexus3d/renderer/vertex_layout.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+/* Descriptor table, indexed by NEXUS_VERTEX_LAYOUT_* */
+static const NexusVertexLayout s_vertex_layouts[NEXUS_VERTEX_LAYOUT_COUNT] = {
+    {
+        .name = "default",
+        .stride = sizeof(NexusVertex),
+        .attribute_count = 4,
+        .attributes = {
+            { .location = 0, .buffer_slot = 0, .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3,
+              .offset = offsetof(NexusVertex, position) },
+            { .location = 1, .buffer_slot = 0, .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3,
+              .offset = offsetof(NexusVertex, normal) },
+            { .location = 2, .buffer_slot = 0, .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2,
+              .offset = offsetof(NexusVertex, texcoord) },
+            { .location = 3, .buffer_slot = 0, .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4,
+              .offset = offsetof(NexusVertex, color) }
+        }
+    },
+    {
+        .name = "compact",
+        .stride = sizeof(NexusVertexCompact),
+        .attribute_count = 4,
+        .attributes = {
+            { .location = 0, .buffer_slot = 0, .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3,
+              .offset = offsetof(NexusVertexCompact, position) },
+            { .location = 1, .buffer_slot = 0, .format = SDL_GPU_VERTEXELEMENTFORMAT_BYTE4_NORM,
+              .offset = offsetof(NexusVertexCompact, normal) },
+            { .location = 2, .buffer_slot = 0, .format = SDL_GPU_VERTEXELEMENTFORMAT_HALF2,
+              .offset = offsetof(NexusVertexCompact, texcoord) },
+            { .location = 3, .buffer_slot = 0, .format = SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM,
+              .offset = offsetof(NexusVertexCompact, color) }
+        }
+    },
+    {
+        .name = "position",
+        .stride = sizeof(float) * 3,
+        .attribute_count = 1,
+        .attributes = {
+            { .location = 0, .buffer_slot = 0, .format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3, .offset = 0 }
+        }
+    }
+};
+
+/**
+ * Get the descriptor of a vertex layout
+ * @return The descriptor, or NULL for an unknown layout
+ */
+const NexusVertexLayout* nexus_vertex_layout_get(uint32_t layout) {
+    if (layout >= NEXUS_VERTEX_LAYOUT_COUNT) {
+        return NULL;
+    }
+
+    return &s_vertex_layouts[layout];
+}
+
+/**
+ * Get the bytes per vertex of a layout (0 for an unknown layout)
+ */
+uint32_t nexus_vertex_layout_get_stride(uint32_t layout) {
+    const NexusVertexLayout* descriptor = nexus_vertex_layout_get(layout);
+    return descriptor != NULL ? descriptor->stride : 0;
+}
+
+/**
+ * Convert a float to a half float (round to nearest even)
+ */
+uint16_t nexus_float_to_half(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    int32_t exponent = (int32_t)((bits >> 23) & 0xFFu) - 127 + 15;
+    uint32_t mantissa = bits & 0x007FFFFFu;
+
+    /* Infinity and NaN */
+    if (((bits >> 23) & 0xFFu) == 0xFFu) {
+        return (uint16_t)(sign | 0x7C00u | (mantissa != 0 ? 0x0200u : 0u));
+    }
+
+    /* Too large, clamp to infinity */
+    if (exponent >= 31) {
+        return (uint16_t)(sign | 0x7C00u);
+    }
+
+    /* Denormal or zero */
+    if (exponent <= 0) {
+        if (exponent < -10) {
+            return (uint16_t)sign;
+        }
+        mantissa |= 0x00800000u;
+        uint32_t shift = (uint32_t)(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1u) != 0)) {
+            half++;
+        }
+        return (uint16_t)(sign | half);
+    }
+
+    /* Normal, rounding may carry into the exponent (which is still correct) */
+    uint32_t half = ((uint32_t)exponent << 10) | (mantissa >> 13);
+    uint32_t rest = mantissa & 0x1FFFu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u) != 0)) {
+        half++;
+    }
+    return (uint16_t)(sign | half);
+}
+
+/**
+ * Convert a half float to a float
+ */
+float nexus_half_to_float(uint16_t value) {
+    uint32_t sign = (uint32_t)(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x03FFu;
+    uint32_t bits;
+
+    if (exponent == 0x1Fu) {
+        /* Infinity and NaN */
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else if (exponent != 0) {
+        /* Normal */
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    } else if (mantissa != 0) {
+        /* Denormal, normalize it */
+        exponent = 127 - 15 + 1;
+        while ((mantissa & 0x0400u) == 0) {
+            mantissa <<= 1;
+            exponent--;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x03FFu) << 13);
+    } else {
+        bits = sign;
+    }
+
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+/**
+ * Quantize a [-1, 1] value to snorm8
+ */
+static int8_t nexus_vertex_pack_snorm8(float value) {
+    if (value > 1.0f) value = 1.0f;
+    if (value < -1.0f) value = -1.0f;
+    return (int8_t)lrintf(value * 127.0f);
+}
+
+/**
+ * Quantize a [0, 1] value to unorm8
+ */
+static uint8_t nexus_vertex_pack_unorm8(float value) {
+    if (value > 1.0f) value = 1.0f;
+    if (value < 0.0f) value = 0.0f;
+    return (uint8_t)lrintf(value * 255.0f);
+}
+
+/**
+ * Convert full precision vertices into a layout
+ * out must hold vertex_count * nexus_vertex_layout_get_stride(layout) bytes
+ */
+bool nexus_vertex_layout_encode(uint32_t layout, const NexusVertex* vertices, uint32_t vertex_count, void* out) {
+    if (vertices == NULL || out == NULL) {
+        return false;
+    }
+
+    switch (layout) {
+        case NEXUS_VERTEX_LAYOUT_DEFAULT:
+            memcpy(out, vertices, (size_t)vertex_count * sizeof(NexusVertex));
+            return true;
+
+        case NEXUS_VERTEX_LAYOUT_COMPACT: {
+            NexusVertexCompact* compact = (NexusVertexCompact*)out;
+            for (uint32_t i = 0; i < vertex_count; i++) {
+                const NexusVertex* src = &vertices[i];
+                NexusVertexCompact* dst = &compact[i];
+
+                memcpy(dst->position, src->position, sizeof(dst->position));
+
+                /* Unit length normals use the whole snorm8 range */
+                float nx = src->normal[0], ny = src->normal[1], nz = src->normal[2];
+                float length = sqrtf(nx * nx + ny * ny + nz * nz);
+                if (length > 0.0f) {
+                    nx /= length;
+                    ny /= length;
+                    nz /= length;
+                }
+                dst->normal[0] = nexus_vertex_pack_snorm8(nx);
+                dst->normal[1] = nexus_vertex_pack_snorm8(ny);
+                dst->normal[2] = nexus_vertex_pack_snorm8(nz);
+                dst->normal[3] = 0;
+
+                dst->texcoord[0] = nexus_float_to_half(src->texcoord[0]);
+                dst->texcoord[1] = nexus_float_to_half(src->texcoord[1]);
+
+                for (int c = 0; c < 4; c++) {
+                    dst->color[c] = nexus_vertex_pack_unorm8(src->color[c]);
+                }
+            }
+            return true;
+        }
+
+        case NEXUS_VERTEX_LAYOUT_POSITION: {
+            float* positions = (float*)out;
+            for (uint32_t i = 0; i < vertex_count; i++) {
+                positions[i * 3 + 0] = vertices[i].position[0];
+                positions[i * 3 + 1] = vertices[i].position[1];
+                positions[i * 3 + 2] = vertices[i].position[2];
+            }
+            return true;
+        }
+
+        default:
+            fprintf(stderr, "Unknown vertex layout %u!\n", layout);
+            return false;
+    }
+}
@@ -0,0 +1,553 @@
+/**
+ * Nexus3D Allocators Implementation
+ * Chained linear arenas, spin locked pools and the engine frame/scratch arenas
+ */
+
+#include "nexus3d/utils/allocator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Scratch arenas tracked for statistics and shutdown */
+#define NEXUS_MEMORY_MAX_SCRATCH 64
+
+/* Elements per pool chunk when none was given */
+#define NEXUS_POOL_DEFAULT_CHUNK 64
+
+/* Pool chunk header, keeps elements 16 byte aligned like the arenas */
+#define NEXUS_POOL_CHUNK_HEADER NEXUS_ARENA_DEFAULT_ALIGNMENT
+
+/**
+ * Engine memory state
+ */
+typedef struct {
+    NexusArena frames[2];          /* Double buffered frame arenas */
+    uint32_t frame_index;          /* Frame arena being filled */
+    size_t frame_high_water;       /* Most memory used by a finished frame */
+    SDL_SpinLock frame_lock;       /* Frame allocations come from any thread */
+
+    size_t scratch_size;           /* Block size of new scratch arenas */
+    SDL_TLSID scratch_tls;         /* Scratch arena of each thread */
+    NexusArena* scratch[NEXUS_MEMORY_MAX_SCRATCH]; /* Live scratch arenas */
+    uint32_t scratch_count;        /* Number of live scratch arenas */
+    SDL_SpinLock scratch_lock;     /* Guards the scratch list */
+} NexusMemory;
+
+static NexusMemory g_memory = {
+    .frames = {
+        { NULL, NEXUS_FRAME_ARENA_DEFAULT_SIZE, 0, 0, 0, 0 },
+        { NULL, NEXUS_FRAME_ARENA_DEFAULT_SIZE, 0, 0, 0, 0 }
+    },
+    .scratch_size = NEXUS_SCRATCH_ARENA_DEFAULT_SIZE
+};
+
+/**
+ * Chain a new block large enough for size bytes at the given alignment
+ */
+static bool nexus_arena_grow(NexusArena* arena, size_t size, size_t alignment) {
+    size_t capacity = arena->block_size;
+    if (capacity < size + alignment) {
+        capacity = size + alignment;
+    }
+
+    NexusArenaBlock* block = (NexusArenaBlock*)malloc(sizeof(NexusArenaBlock) + capacity);
+    if (block == NULL) {
+        fprintf(stderr, "Failed to allocate arena block!\n");
+        return false;
+    }
+
+    block->prev = arena->current;
+    block->capacity = capacity;
+    block->offset = 0;
+    arena->current = block;
+    arena->block_count++;
+    return true;
+}
+
+/**
+ * Free every block of an arena
+ */
+static void nexus_arena_free_blocks(NexusArena* arena) {
+    NexusArenaBlock* block = arena->current;
+    while (block != NULL) {
+        NexusArenaBlock* prev = block->prev;
+        free(block);
+        block = prev;
+    }
+    arena->current = NULL;
+    arena->block_count = 0;
+}
+
+/**
+ * Initialize an arena, blocks are allocated on first use
+ */
+void nexus_arena_init(NexusArena* arena, size_t block_size) {
+    if (arena == NULL) {
+        return;
+    }
+
+    memset(arena, 0, sizeof(NexusArena));
+    arena->block_size = block_size > 0 ? block_size : NEXUS_SCRATCH_ARENA_DEFAULT_SIZE;
+}
+
+/**
+ * Release all memory of an arena (it stays usable)
+ */
+void nexus_arena_release(NexusArena* arena) {
+    if (arena == NULL) {
+        return;
+    }
+
+    nexus_arena_free_blocks(arena);
+    arena->used = 0;
+    arena->alloc_count = 0;
+}
+
+/**
+ * Allocate from an arena
+ * alignment must be a power of two (0 = NEXUS_ARENA_DEFAULT_ALIGNMENT)
+ */
+void* nexus_arena_alloc(NexusArena* arena, size_t size, size_t alignment) {
+    if (arena == NULL) {
+        return NULL;
+    }
+
+    if (alignment == 0) {
+        alignment = NEXUS_ARENA_DEFAULT_ALIGNMENT;
+    }
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        NexusArenaBlock* block = arena->current;
+        if (block != NULL) {
+            uintptr_t base = (uintptr_t)(block + 1);
+            uintptr_t start = (base + block->offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+            size_t end = (size_t)(start - base) + size;
+
+            if (end <= block->capacity) {
+                arena->used += end - block->offset;
+                block->offset = end;
+                arena->alloc_count++;
+                if (arena->used > arena->high_water) {
+                    arena->high_water = arena->used;
+                }
+                return (void*)start;
+            }
+        }
+
+        /* Out of space, chain a block and try once more */
+        if (!nexus_arena_grow(arena, size, alignment)) {
+            return NULL;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Allocate zeroed memory from an arena
+ */
+void* nexus_arena_calloc(NexusArena* arena, size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) {
+        return NULL;
+    }
+
+    void* data = nexus_arena_alloc(arena, count * size, 0);
+    if (data != NULL) {
+        memset(data, 0, count * size);
+    }
+    return data;
+}
+
+/**
+ * Remember the current arena position
+ */
+NexusArenaMark nexus_arena_mark(const NexusArena* arena) {
+    NexusArenaMark mark = {0};
+    if (arena == NULL) {
+        return mark;
+    }
+
+    mark.block = arena->current;
+    mark.offset = arena->current != NULL ? arena->current->offset : 0;
+    mark.used = arena->used;
+    mark.alloc_count = arena->alloc_count;
+    return mark;
+}
+
+/**
+ * Free everything allocated after a mark
+ */
+void nexus_arena_rewind(NexusArena* arena, NexusArenaMark mark) {
+    if (arena == NULL) {
+        return;
+    }
+
+    /* Drop blocks chained after the mark */
+    while (arena->current != NULL && arena->current != mark.block) {
+        NexusArenaBlock* prev = arena->current->prev;
+        free(arena->current);
+        arena->current = prev;
+        arena->block_count--;
+    }
+
+    if (arena->current != NULL) {
+        arena->current->offset = mark.offset;
+    }
+    arena->used = mark.used;
+    arena->alloc_count = mark.alloc_count;
+}
+
+/**
+ * Free all allocations of an arena
+ * Chained blocks are replaced by a single block of the high-water size so a
+ * steady workload settles into one block
+ */
+void nexus_arena_reset(NexusArena* arena) {
+    if (arena == NULL) {
+        return;
+    }
+
+    if (arena->block_count > 1) {
+        nexus_arena_free_blocks(arena);
+        if (arena->block_size < arena->high_water) {
+            arena->block_size = arena->high_water;
+        }
+        nexus_arena_grow(arena, 0, 0);
+    } else if (arena->current != NULL) {
+        arena->current->offset = 0;
+    }
+
+    arena->used = 0;
+    arena->alloc_count = 0;
+}
+
+/**
+ * Get arena statistics
+ */
+NexusArenaStats nexus_arena_get_stats(const NexusArena* arena) {
+    NexusArenaStats stats = {0};
+    if (arena == NULL) {
+        return stats;
+    }
+
+    for (const NexusArenaBlock* block = arena->current; block != NULL; block = block->prev) {
+        stats.capacity += block->capacity;
+    }
+    stats.used = arena->used;
+    stats.high_water = arena->high_water;
+    stats.alloc_count = arena->alloc_count;
+    stats.block_count = arena->block_count;
+    return stats;
+}
+
+/**
+ * Allocate an element from a pool
+ */
+void* nexus_pool_alloc(NexusPool* pool) {
+    if (pool == NULL || pool->element_size == 0) {
+        return NULL;
+    }
+
+    SDL_LockSpinlock(&pool->lock);
+
+    /* Add a chunk when the free list ran dry */
+    if (pool->free_list == NULL) {
+        uint32_t count = pool->chunk_elements > 0 ? pool->chunk_elements : NEXUS_POOL_DEFAULT_CHUNK;
+        size_t stride = (pool->element_size + NEXUS_ARENA_DEFAULT_ALIGNMENT - 1) &
+                        ~(size_t)(NEXUS_ARENA_DEFAULT_ALIGNMENT - 1);
+        uint8_t* chunk = (uint8_t*)malloc(NEXUS_POOL_CHUNK_HEADER + stride * count);
+        if (chunk == NULL) {
+            SDL_UnlockSpinlock(&pool->lock);
+            fprintf(stderr, "Failed to allocate pool chunk!\n");
+            return NULL;
+        }
+
+        *(void**)chunk = pool->chunks;
+        pool->chunks = chunk;
+
+        /* Thread the new elements onto the free list */
+        uint8_t* elements = chunk + NEXUS_POOL_CHUNK_HEADER;
+        for (uint32_t i = count; i-- > 0;) {
+            void* element = elements + stride * i;
+            *(void**)element = pool->free_list;
+            pool->free_list = element;
+        }
+        pool->capacity += count;
+    }
+
+    void* element = pool->free_list;
+    pool->free_list = *(void**)element;
+    pool->live++;
+    pool->alloc_count++;
+    if (pool->live > pool->high_water) {
+        pool->high_water = pool->live;
+    }
+
+    SDL_UnlockSpinlock(&pool->lock);
+    return element;
+}
+
+/**
+ * Return an element to its pool
+ */
+void nexus_pool_free(NexusPool* pool, void* element) {
+    if (pool == NULL || element == NULL) {
+        return;
+    }
+
+    SDL_LockSpinlock(&pool->lock);
+    *(void**)element = pool->free_list;
+    pool->free_list = element;
+    pool->live--;
+    SDL_UnlockSpinlock(&pool->lock);
+}
+
+/**
+ * Free all chunks of a pool (elements still handed out become invalid)
+ */
+void nexus_pool_release(NexusPool* pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    SDL_LockSpinlock(&pool->lock);
+    void* chunk = pool->chunks;
+    while (chunk != NULL) {
+        void* next = *(void**)chunk;
+        free(chunk);
+        chunk = next;
+    }
+    pool->chunks = NULL;
+    pool->free_list = NULL;
+    pool->capacity = 0;
+    pool->live = 0;
+    SDL_UnlockSpinlock(&pool->lock);
+}
+
+/**
+ * Get pool statistics
+ */
+NexusPoolStats nexus_pool_get_stats(NexusPool* pool) {
+    NexusPoolStats stats = {0};
+    if (pool == NULL) {
+        return stats;
+    }
+
+    SDL_LockSpinlock(&pool->lock);
+    stats.live = pool->live;
+    stats.capacity = pool->capacity;
+    stats.high_water = pool->high_water;
+    stats.alloc_count = pool->alloc_count;
+    SDL_UnlockSpinlock(&pool->lock);
+    return stats;
+}
+
+/**
+ * Set the arena sizes of the engine memory
+ */
+void nexus_memory_init(size_t frame_arena_size, size_t scratch_arena_size) {
+    SDL_LockSpinlock(&g_memory.frame_lock);
+    for (int i = 0; i < 2; i++) {
+        nexus_arena_release(&g_memory.frames[i]);
+        nexus_arena_init(&g_memory.frames[i], frame_arena_size > 0 ? frame_arena_size : NEXUS_FRAME_ARENA_DEFAULT_SIZE);
+    }
+    g_memory.frame_index = 0;
+    g_memory.frame_high_water = 0;
+    SDL_UnlockSpinlock(&g_memory.frame_lock);
+
+    SDL_LockSpinlock(&g_memory.scratch_lock);
+    g_memory.scratch_size = scratch_arena_size > 0 ? scratch_arena_size : NEXUS_SCRATCH_ARENA_DEFAULT_SIZE;
+    SDL_UnlockSpinlock(&g_memory.scratch_lock);
+}
+
+/**
+ * Remove a scratch arena from the live list
+ */
+static void nexus_memory_forget_scratch(NexusArena* arena) {
+    SDL_LockSpinlock(&g_memory.scratch_lock);
+    for (uint32_t i = 0; i < g_memory.scratch_count; i++) {
+        if (g_memory.scratch[i] == arena) {
+            g_memory.scratch[i] = g_memory.scratch[--g_memory.scratch_count];
+            break;
+        }
+    }
+    SDL_UnlockSpinlock(&g_memory.scratch_lock);
+}
+
+/**
+ * Free a thread's scratch arena when the thread exits
+ */
+static void SDLCALL nexus_memory_scratch_destructor(void* value) {
+    NexusArena* arena = (NexusArena*)value;
+    if (arena == NULL) {
+        return;
+    }
+
+    nexus_memory_forget_scratch(arena);
+    nexus_arena_release(arena);
+    free(arena);
+}
+
+/**
+ * Release the engine memory
+ * Scratch arenas of other threads keep their headers until the threads exit
+ */
+void nexus_memory_shutdown(void) {
+    SDL_LockSpinlock(&g_memory.frame_lock);
+    nexus_arena_release(&g_memory.frames[0]);
+    nexus_arena_release(&g_memory.frames[1]);
+    SDL_UnlockSpinlock(&g_memory.frame_lock);
+
+    /* The calling thread's arena goes away now */
+    NexusArena* own = (NexusArena*)SDL_GetTLS(&g_memory.scratch_tls);
+    if (own != NULL) {
+        SDL_SetTLS(&g_memory.scratch_tls, NULL, NULL);
+        nexus_memory_scratch_destructor(own);
+    }
+
+    SDL_LockSpinlock(&g_memory.scratch_lock);
+    for (uint32_t i = 0; i < g_memory.scratch_count; i++) {
+        nexus_arena_release(g_memory.scratch[i]);
+    }
+    SDL_UnlockSpinlock(&g_memory.scratch_lock);
+}
+
+/**
+ * Flip the frame arenas
+ * Frame allocations stay valid until the end of the next frame
+ */
+void nexus_memory_begin_frame(void) {
+    SDL_LockSpinlock(&g_memory.frame_lock);
+
+    NexusArena* finished = &g_memory.frames[g_memory.frame_index];
+    if (finished->used > g_memory.frame_high_water) {
+        g_memory.frame_high_water = finished->used;
+    }
+
+    g_memory.frame_index ^= 1;
+    nexus_arena_reset(&g_memory.frames[g_memory.frame_index]);
+
+    SDL_UnlockSpinlock(&g_memory.frame_lock);
+}
+
+/**
+ * Allocate memory that lives until the end of the next frame
+ */
+void* nexus_frame_alloc(size_t size) {
+    SDL_LockSpinlock(&g_memory.frame_lock);
+    void* data = nexus_arena_alloc(&g_memory.frames[g_memory.frame_index], size, 0);
+    SDL_UnlockSpinlock(&g_memory.frame_lock);
+    return data;
+}
+
+/**
+ * Allocate zeroed memory that lives until the end of the next frame
+ */
+void* nexus_frame_calloc(size_t count, size_t size) {
+    SDL_LockSpinlock(&g_memory.frame_lock);
+    void* data = nexus_arena_calloc(&g_memory.frames[g_memory.frame_index], count, size);
+    SDL_UnlockSpinlock(&g_memory.frame_lock);
+    return data;
+}
+
+/**
+ * Get the scratch arena of the calling thread, creating it on first use
+ */
+static NexusArena* nexus_memory_get_scratch(void) {
+    NexusArena* arena = (NexusArena*)SDL_GetTLS(&g_memory.scratch_tls);
+    if (arena != NULL) {
+        return arena;
+    }
+
+    arena = (NexusArena*)malloc(sizeof(NexusArena));
+    if (arena == NULL) {
+        fprintf(stderr, "Failed to allocate scratch arena!\n");
+        return NULL;
+    }
+
+    SDL_LockSpinlock(&g_memory.scratch_lock);
+    nexus_arena_init(arena, g_memory.scratch_size);
+    SDL_UnlockSpinlock(&g_memory.scratch_lock);
+
+    /* The first block stays for the lifetime of the thread */
+    if (!nexus_arena_grow(arena, 0, 0)) {
+        free(arena);
+        return NULL;
+    }
+
+    SDL_LockSpinlock(&g_memory.scratch_lock);
+    if (g_memory.scratch_count < NEXUS_MEMORY_MAX_SCRATCH) {
+        g_memory.scratch[g_memory.scratch_count++] = arena;
+    }
+    SDL_UnlockSpinlock(&g_memory.scratch_lock);
+
+    if (!SDL_SetTLS(&g_memory.scratch_tls, arena, nexus_memory_scratch_destructor)) {
+        fprintf(stderr, "Failed to set scratch arena: %s\n", SDL_GetError());
+        nexus_memory_scratch_destructor(arena);
+        return NULL;
+    }
+
+    return arena;
+}
+
+/**
+ * Open a scratch scope on the calling thread
+ * Scopes nest and have to be closed in reverse order
+ */
+NexusScratch nexus_scratch_begin(void) {
+    NexusScratch scratch;
+    scratch.arena = nexus_memory_get_scratch();
+    scratch.mark = nexus_arena_mark(scratch.arena);
+    return scratch;
+}
+
+/**
+ * Allocate from a scratch scope
+ */
+void* nexus_scratch_alloc(NexusScratch* scratch, size_t size) {
+    if (scratch == NULL) {
+        return NULL;
+    }
+    return nexus_arena_alloc(scratch->arena, size, 0);
+}
+
+/**
+ * Close a scratch scope, freeing everything allocated in it
+ */
+void nexus_scratch_end(NexusScratch* scratch) {
+    if (scratch == NULL || scratch->arena == NULL) {
+        return;
+    }
+
+    /* Closing the outermost scope folds overflow blocks into one */
+    if (scratch->mark.used == 0) {
+        nexus_arena_reset(scratch->arena);
+    } else {
+        nexus_arena_rewind(scratch->arena, scratch->mark);
+    }
+    scratch->arena = NULL;
+}
+
+/**
+ * Get engine memory statistics
+ */
+NexusMemoryStats nexus_memory_get_stats(void) {
+    NexusMemoryStats stats;
+    memset(&stats, 0, sizeof(NexusMemoryStats));
+
+    SDL_LockSpinlock(&g_memory.frame_lock);
+    stats.frame = nexus_arena_get_stats(&g_memory.frames[g_memory.frame_index]);
+    stats.frame_high_water = g_memory.frame_high_water;
+    SDL_UnlockSpinlock(&g_memory.frame_lock);
+
+    SDL_LockSpinlock(&g_memory.scratch_lock);
+    stats.scratch_arenas = g_memory.scratch_count;
+    for (uint32_t i = 0; i < g_memory.scratch_count; i++) {
+        if (g_memory.scratch[i]->high_water > stats.scratch_high_water) {
+            stats.scratch_high_water = g_memory.scratch[i]->high_water;
+        }
+    }
+    SDL_UnlockSpinlock(&g_memory.scratch_lock);
+
+    return stats;
+}
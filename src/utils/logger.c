@@ -6,10 +6,48 @@
 #include "nexus3d/utils/logger.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <stdarg.h>
 #include <time.h>
 
+/* Formatted message size */
+#define NEXUS_LOGGER_MESSAGE_SIZE 1024
+
+/* Argument bytes a record can carry */
+#define NEXUS_LOGGER_MAX_PAYLOAD (NEXUS_LOGGER_MAX_RECORD - (uint32_t)sizeof(NexusLogRecord))
+
+/* Writer batches */
+#define NEXUS_LOGGER_OUTPUT_STDOUT 0
+#define NEXUS_LOGGER_OUTPUT_STDERR 1
+#define NEXUS_LOGGER_OUTPUT_FILE   2
+
+/**
+ * Packed argument types
+ */
+typedef enum {
+    NEXUS_LOG_ARG_NONE,            /* %% */
+    NEXUS_LOG_ARG_INT,             /* int (also char and short) */
+    NEXUS_LOG_ARG_LONG,            /* long */
+    NEXUS_LOG_ARG_LLONG,           /* long long */
+    NEXUS_LOG_ARG_INTMAX,          /* intmax_t */
+    NEXUS_LOG_ARG_SIZE,            /* size_t */
+    NEXUS_LOG_ARG_PTRDIFF,         /* ptrdiff_t */
+    NEXUS_LOG_ARG_DOUBLE,          /* double (also float) */
+    NEXUS_LOG_ARG_LONG_DOUBLE,     /* long double */
+    NEXUS_LOG_ARG_STRING,          /* Copied string */
+    NEXUS_LOG_ARG_POINTER          /* void* */
+} NexusLogArgType;
+
+/**
+ * Parsed conversion of a format string
+ */
+typedef struct {
+    uint8_t type;                  /* NexusLogArgType */
+    uint8_t stars;                 /* '*' width and precision arguments before the value */
+    bool is_unsigned;              /* Unsigned integer conversion */
+} NexusLogSpec;
+
 /* ANSI color codes for colored output */
 #define NEXUS_COLOR_RESET   "\033[0m"
 #define NEXUS_COLOR_TRACE   "\033[90m"  /* Bright Black (Gray) */
@@ -79,6 +117,9 @@ void nexus_logger_destroy(NexusLogger* logger) {
         return;
     }
     
+    /* Write everything still queued */
+    nexus_logger_enable_async(logger, false, logger->overflow_policy);
+
     /* Close log file if open */
     if (logger->file_output && logger->file_handle != NULL) {
         fclose((FILE*)logger->file_handle);
@@ -163,6 +204,10 @@ void nexus_logger_enable_file_output(NexusLogger* logger, bool enable, const cha
         return;
     }
     
+    /* The writer thread must not write to the file while it is swapped */
+    bool async_output = logger->async_output;
+    nexus_logger_enable_async(logger, false, logger->overflow_policy);
+
     /* Close previous file if open */
     if (logger->file_output && logger->file_handle != NULL) {
         fclose((FILE*)logger->file_handle);
@@ -183,6 +228,10 @@ void nexus_logger_enable_file_output(NexusLogger* logger, bool enable, const cha
             logger->file_output = false;
         }
     }
+
+    if (async_output) {
+        nexus_logger_enable_async(logger, true, logger->overflow_policy);
+    }
 }
 
 /**
@@ -209,34 +258,567 @@ void nexus_logger_set_callback(NexusLogger* logger, NexusLoggerCallback callback
 }
 
 /**
- * Log a message
+ * Parse the conversion at fmt (pointing at the '%')
+ * @return End of the conversion, NULL for conversions records cannot carry
+ *         (%n, positional and wide arguments), which are formatted right away
  */
-void nexus_log(NexusLogger* logger, NexusLogLevel level, NexusLogCategory category, const char* fmt, ...) {
-    if (logger == NULL || fmt == NULL) {
-        return;
+static const char* nexus_logger_parse_spec(const char* fmt, NexusLogSpec* spec) {
+    const char* p = fmt + 1;
+    spec->type = NEXUS_LOG_ARG_NONE;
+    spec->is_unsigned = false;
+    spec->stars = 0;
+
+    if (*p == '%') {
+        return p + 1;
     }
-    
-    /* Check level and category */
-    if (level < logger->min_level || !logger->enabled_categories[category]) {
-        return;
+
+    /* Flags */
+    while (*p != '\0' && strchr("-+ #0", *p) != NULL) {
+        p++;
     }
-    
-    /* Format message */
-    char message[1024];
+
+    /* Width */
+    if (*p == '*') {
+        spec->stars++;
+        p++;
+    } else {
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+        if (*p == '$') {
+            return NULL;
+        }
+    }
+
+    /* Precision */
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            spec->stars++;
+            p++;
+        } else {
+            while (*p >= '0' && *p <= '9') {
+                p++;
+            }
+        }
+    }
+
+    /* Length modifier */
+    uint8_t length = NEXUS_LOG_ARG_INT;
+    bool long_double = false;
+    bool has_length = true;
+    if (p[0] == 'h' && p[1] == 'h') {
+        p += 2;
+    } else if (p[0] == 'h') {
+        p++;
+    } else if (p[0] == 'l' && p[1] == 'l') {
+        length = NEXUS_LOG_ARG_LLONG;
+        p += 2;
+    } else if (p[0] == 'l') {
+        length = NEXUS_LOG_ARG_LONG;
+        p++;
+    } else if (p[0] == 'j') {
+        length = NEXUS_LOG_ARG_INTMAX;
+        p++;
+    } else if (p[0] == 'z') {
+        length = NEXUS_LOG_ARG_SIZE;
+        p++;
+    } else if (p[0] == 't') {
+        length = NEXUS_LOG_ARG_PTRDIFF;
+        p++;
+    } else if (p[0] == 'L') {
+        long_double = true;
+        p++;
+    } else {
+        has_length = false;
+    }
+
+    /* Conversion */
+    switch (*p) {
+        case 'u': case 'o': case 'x': case 'X':
+            spec->is_unsigned = true;
+            /* fall through */
+        case 'd': case 'i':
+            if (long_double) {
+                return NULL;
+            }
+            spec->type = length;
+            break;
+        case 'c':
+            if (has_length) {
+                return NULL;
+            }
+            spec->type = NEXUS_LOG_ARG_INT;
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            spec->type = long_double ? NEXUS_LOG_ARG_LONG_DOUBLE : NEXUS_LOG_ARG_DOUBLE;
+            break;
+        case 's':
+            if (has_length) {
+                return NULL;
+            }
+            spec->type = NEXUS_LOG_ARG_STRING;
+            break;
+        case 'p':
+            spec->type = NEXUS_LOG_ARG_POINTER;
+            break;
+        default:
+            return NULL;
+    }
+
+    return p + 1;
+}
+
+/**
+ * Append bytes to a record's arguments
+ */
+static bool nexus_logger_pack(uint8_t* payload, uint32_t* size, const void* value, uint32_t length) {
+    if (*size + length > NEXUS_LOGGER_MAX_PAYLOAD) {
+        return false;
+    }
+
+    memcpy(payload + *size, value, length);
+    *size += length;
+    return true;
+}
+
+/**
+ * Pack the arguments of a format string, integers are widened to 64 bits
+ * @return false if the format has to be formatted on the logging thread
+ */
+static bool nexus_logger_pack_arguments(const char* fmt, va_list source, uint8_t* payload, uint32_t* size) {
     va_list args;
-    va_start(args, fmt);
-    vsnprintf(message, sizeof(message), fmt, args);
+    va_copy(args, source);
+
+    bool packed = true;
+    for (const char* p = strchr(fmt, '%'); p != NULL && packed; p = strchr(p, '%')) {
+        NexusLogSpec spec;
+        p = nexus_logger_parse_spec(p, &spec);
+        if (p == NULL) {
+            packed = false;
+            break;
+        }
+
+        /* '*' widths and precisions come first */
+        for (uint8_t s = 0; s < spec.stars && packed; s++) {
+            int64_t star = va_arg(args, int);
+            packed = nexus_logger_pack(payload, size, &star, sizeof(star));
+        }
+        if (!packed) {
+            break;
+        }
+
+        switch (spec.type) {
+            case NEXUS_LOG_ARG_NONE:
+                break;
+            case NEXUS_LOG_ARG_DOUBLE: {
+                double value = va_arg(args, double);
+                packed = nexus_logger_pack(payload, size, &value, sizeof(value));
+                break;
+            }
+            case NEXUS_LOG_ARG_LONG_DOUBLE: {
+                long double value = va_arg(args, long double);
+                packed = nexus_logger_pack(payload, size, &value, sizeof(value));
+                break;
+            }
+            case NEXUS_LOG_ARG_POINTER: {
+                void* value = va_arg(args, void*);
+                packed = nexus_logger_pack(payload, size, &value, sizeof(value));
+                break;
+            }
+            case NEXUS_LOG_ARG_STRING: {
+                /* The string may not outlive the call, copy it (truncated to the record) */
+                const char* value = va_arg(args, const char*);
+                if (value == NULL) {
+                    value = "(null)";
+                }
+                uint32_t length = (uint32_t)strlen(value);
+                uint32_t room = NEXUS_LOGGER_MAX_PAYLOAD - *size;
+                if (room < sizeof(uint32_t)) {
+                    packed = false;
+                    break;
+                }
+                if (length > room - (uint32_t)sizeof(uint32_t)) {
+                    length = room - (uint32_t)sizeof(uint32_t);
+                }
+                nexus_logger_pack(payload, size, &length, sizeof(length));
+                nexus_logger_pack(payload, size, value, length);
+                break;
+            }
+            default: {
+                uint64_t value = 0;
+                switch (spec.type) {
+                    case NEXUS_LOG_ARG_INT:
+                        value = spec.is_unsigned ? (uint64_t)va_arg(args, unsigned int) :
+                                                   (uint64_t)(int64_t)va_arg(args, int);
+                        break;
+                    case NEXUS_LOG_ARG_LONG:
+                        value = spec.is_unsigned ? (uint64_t)va_arg(args, unsigned long) :
+                                                   (uint64_t)(int64_t)va_arg(args, long);
+                        break;
+                    case NEXUS_LOG_ARG_LLONG:
+                        value = spec.is_unsigned ? (uint64_t)va_arg(args, unsigned long long) :
+                                                   (uint64_t)(int64_t)va_arg(args, long long);
+                        break;
+                    case NEXUS_LOG_ARG_INTMAX:
+                        value = spec.is_unsigned ? (uint64_t)va_arg(args, uintmax_t) :
+                                                   (uint64_t)(int64_t)va_arg(args, intmax_t);
+                        break;
+                    case NEXUS_LOG_ARG_SIZE:
+                        value = (uint64_t)va_arg(args, size_t);
+                        break;
+                    case NEXUS_LOG_ARG_PTRDIFF:
+                        value = (uint64_t)(int64_t)va_arg(args, ptrdiff_t);
+                        break;
+                }
+                packed = nexus_logger_pack(payload, size, &value, sizeof(value));
+                break;
+            }
+        }
+    }
+
     va_end(args);
-    
-    /* Get time string */
-    char time_str[64];
-    get_time_string(time_str, sizeof(time_str));
-    
+    return packed;
+}
+
+/**
+ * Read packed bytes of a record
+ */
+static bool nexus_logger_unpack(const uint8_t* payload, uint32_t size, uint32_t* offset, void* value, uint32_t length) {
+    if (*offset + length > size) {
+        return false;
+    }
+
+    memcpy(value, payload + *offset, length);
+    *offset += length;
+    return true;
+}
+
+/**
+ * Format a record from its format string and packed arguments
+ */
+static void nexus_logger_format_record(const char* fmt, const uint8_t* payload, uint32_t size,
+                                       char* message, size_t message_size) {
+    size_t length = 0;
+    uint32_t offset = 0;
+    const char* p = fmt;
+
+    while (*p != '\0' && length + 1 < message_size) {
+        /* Literal text up to the next conversion */
+        const char* next = strchr(p, '%');
+        size_t literal = next != NULL ? (size_t)(next - p) : strlen(p);
+        if (literal > message_size - 1 - length) {
+            literal = message_size - 1 - length;
+        }
+        memcpy(message + length, p, literal);
+        length += literal;
+        if (next == NULL || length + 1 >= message_size) {
+            break;
+        }
+
+        NexusLogSpec spec;
+        const char* end = nexus_logger_parse_spec(next, &spec);
+        if (end == NULL) {
+            break;
+        }
+        p = end;
+        if (spec.type == NEXUS_LOG_ARG_NONE && spec.stars == 0) {
+            if (length + 1 < message_size) {
+                message[length++] = '%';
+            }
+            continue;
+        }
+
+        /* Rebuild the conversion with the '*' arguments written out */
+        char conversion[64];
+        size_t conversion_length = 0;
+        bool valid = true;
+        for (const char* c = next; c < end && valid; c++) {
+            if (*c != '*') {
+                if (conversion_length + 1 >= sizeof(conversion)) {
+                    valid = false;
+                    break;
+                }
+                conversion[conversion_length++] = *c;
+                continue;
+            }
+
+            int64_t star = 0;
+            valid = nexus_logger_unpack(payload, size, &offset, &star, sizeof(star));
+            if (valid && star < 0 && conversion_length > 0 && conversion[conversion_length - 1] == '.') {
+                /* A negative precision counts as omitted */
+                conversion_length--;
+            } else if (valid) {
+                int written = snprintf(conversion + conversion_length, sizeof(conversion) - conversion_length,
+                                       "%d", (int)star);
+                valid = written > 0 && (size_t)written < sizeof(conversion) - conversion_length;
+                conversion_length += valid ? (size_t)written : 0;
+            }
+        }
+        if (!valid) {
+            break;
+        }
+        conversion[conversion_length] = '\0';
+
+        /* Format the argument */
+        char* out = message + length;
+        size_t room = message_size - length;
+        int written = 0;
+        switch (spec.type) {
+            case NEXUS_LOG_ARG_DOUBLE: {
+                double value;
+                valid = nexus_logger_unpack(payload, size, &offset, &value, sizeof(value));
+                written = valid ? snprintf(out, room, conversion, value) : 0;
+                break;
+            }
+            case NEXUS_LOG_ARG_LONG_DOUBLE: {
+                long double value;
+                valid = nexus_logger_unpack(payload, size, &offset, &value, sizeof(value));
+                written = valid ? snprintf(out, room, conversion, value) : 0;
+                break;
+            }
+            case NEXUS_LOG_ARG_POINTER: {
+                void* value;
+                valid = nexus_logger_unpack(payload, size, &offset, &value, sizeof(value));
+                written = valid ? snprintf(out, room, conversion, value) : 0;
+                break;
+            }
+            case NEXUS_LOG_ARG_STRING: {
+                char text[NEXUS_LOGGER_MAX_PAYLOAD + 1];
+                uint32_t text_length = 0;
+                valid = nexus_logger_unpack(payload, size, &offset, &text_length, sizeof(text_length)) &&
+                        nexus_logger_unpack(payload, size, &offset, text, text_length);
+                if (valid) {
+                    text[text_length] = '\0';
+                    written = snprintf(out, room, conversion, text);
+                }
+                break;
+            }
+            default: {
+                uint64_t value;
+                valid = nexus_logger_unpack(payload, size, &offset, &value, sizeof(value));
+                if (!valid) {
+                    break;
+                }
+                switch (spec.type) {
+                    case NEXUS_LOG_ARG_INT:
+                        written = spec.is_unsigned ? snprintf(out, room, conversion, (unsigned int)value) :
+                                                     snprintf(out, room, conversion, (int)(int64_t)value);
+                        break;
+                    case NEXUS_LOG_ARG_LONG:
+                        written = spec.is_unsigned ? snprintf(out, room, conversion, (unsigned long)value) :
+                                                     snprintf(out, room, conversion, (long)(int64_t)value);
+                        break;
+                    case NEXUS_LOG_ARG_LLONG:
+                        written = spec.is_unsigned ? snprintf(out, room, conversion, (unsigned long long)value) :
+                                                     snprintf(out, room, conversion, (long long)(int64_t)value);
+                        break;
+                    case NEXUS_LOG_ARG_INTMAX:
+                        written = spec.is_unsigned ? snprintf(out, room, conversion, (uintmax_t)value) :
+                                                     snprintf(out, room, conversion, (intmax_t)(int64_t)value);
+                        break;
+                    case NEXUS_LOG_ARG_SIZE:
+                        written = snprintf(out, room, conversion, (size_t)value);
+                        break;
+                    case NEXUS_LOG_ARG_PTRDIFF:
+                        written = snprintf(out, room, conversion, (ptrdiff_t)(int64_t)value);
+                        break;
+                }
+                break;
+            }
+        }
+        if (!valid || written < 0) {
+            break;
+        }
+        length += (size_t)written < room ? (size_t)written : room - 1;
+    }
+
+    if (length >= message_size) {
+        length = message_size - 1;
+    }
+    message[length] = '\0';
+}
+
+/**
+ * Get the ring of the calling thread, claiming one on its first message
+ * @return NULL once all rings are taken
+ */
+static NexusLogRing* nexus_logger_get_ring(NexusLogger* logger) {
+    NexusLogRing* ring = (NexusLogRing*)SDL_GetTLS(&logger->ring_tls);
+    if (ring != NULL) {
+        return ring;
+    }
+
+    int index = SDL_AddAtomicInt(&logger->ring_count, 1);
+    if (index >= NEXUS_LOGGER_MAX_THREADS) {
+        SDL_SetAtomicInt(&logger->ring_count, NEXUS_LOGGER_MAX_THREADS);
+        return NULL;
+    }
+
+    ring = &logger->rings[index];
+    ring->data = (uint8_t*)malloc(NEXUS_LOGGER_RING_SIZE);
+    if (ring->data == NULL) {
+        fprintf(stderr, "Failed to allocate memory for log ring!\n");
+        return NULL;
+    }
+
+    /* The writer only reads the ring once it is published */
+    SDL_SetAtomicU32(&ring->head, 0);
+    SDL_SetAtomicU32(&ring->tail, 0);
+    SDL_SetAtomicInt(&ring->ready, 1);
+    SDL_SetTLS(&logger->ring_tls, ring, NULL);
+    return ring;
+}
+
+/**
+ * Copy a record into the calling thread's ring
+ * @return false if the record was dropped
+ */
+static bool nexus_logger_push(NexusLogger* logger, NexusLogRing* ring, NexusLogRecord* record,
+                              const uint8_t* payload, uint32_t payload_size) {
+    uint32_t size = ((uint32_t)sizeof(NexusLogRecord) + payload_size + 7u) & ~7u;
+    uint32_t tail;
+    uint32_t head;
+    uint32_t offset;
+    uint32_t contiguous;
+
+    for (;;) {
+        tail = SDL_GetAtomicU32(&ring->tail);
+        head = SDL_GetAtomicU32(&ring->head);
+        offset = tail & (NEXUS_LOGGER_RING_SIZE - 1);
+        contiguous = NEXUS_LOGGER_RING_SIZE - offset;
+
+        /* Records never wrap, the space up to the ring end is skipped */
+        uint32_t needed = size + (contiguous < size ? contiguous : 0);
+        if (NEXUS_LOGGER_RING_SIZE - (tail - head) >= needed) {
+            break;
+        }
+
+        if (logger->overflow_policy == NEXUS_LOG_OVERFLOW_DROP) {
+            SDL_AddAtomicInt(&logger->dropped, 1);
+            return false;
+        }
+        SDL_SignalSemaphore(logger->wake);
+        SDL_Delay(1);
+    }
+
+    /* Wrap marker */
+    if (contiguous < size) {
+        uint32_t marker = 0;
+        memcpy(ring->data + offset, &marker, sizeof(marker));
+        tail += contiguous;
+        offset = 0;
+    }
+
+    record->size = size;
+    memcpy(ring->data + offset, record, sizeof(NexusLogRecord));
+    memcpy(ring->data + offset + sizeof(NexusLogRecord), payload, payload_size);
+    SDL_SetAtomicU32(&ring->tail, tail + size);
+
+    /* Wake the writer once the ring passes half full instead of on every record */
+    uint32_t used_before = tail - head;
+    uint32_t used_after = tail + size - head;
+    if (used_before < NEXUS_LOGGER_RING_SIZE / 2 && used_after >= NEXUS_LOGGER_RING_SIZE / 2) {
+        SDL_SignalSemaphore(logger->wake);
+    }
+    return true;
+}
+
+/**
+ * Get the next record of a ring (writer thread), skipping wrap markers
+ */
+static const NexusLogRecord* nexus_logger_peek(NexusLogRing* ring, NexusLogRecord* record) {
+    for (;;) {
+        uint32_t head = SDL_GetAtomicU32(&ring->head);
+        uint32_t tail = SDL_GetAtomicU32(&ring->tail);
+        if (head == tail) {
+            return NULL;
+        }
+
+        /* A wrap marker may sit in the last bytes, too close to the end for a record */
+        uint32_t offset = head & (NEXUS_LOGGER_RING_SIZE - 1);
+        uint32_t size;
+        memcpy(&size, ring->data + offset, sizeof(size));
+        if (size != 0) {
+            memcpy(record, ring->data + offset, sizeof(NexusLogRecord));
+            return record;
+        }
+        SDL_SetAtomicU32(&ring->head, head + (NEXUS_LOGGER_RING_SIZE - offset));
+    }
+}
+
+/**
+ * Get the time string of a record (writer thread), localtime only runs once per second
+ */
+static const char* nexus_logger_get_record_time(NexusLogger* logger, uint64_t timestamp_ns) {
+    int64_t second = logger->start_time;
+    if (timestamp_ns > logger->start_ticks) {
+        second += (int64_t)((timestamp_ns - logger->start_ticks) / 1000000000ull);
+    }
+
+    if (second != logger->cached_second) {
+        time_t raw_time = (time_t)second;
+        struct tm* time_info = localtime(&raw_time);
+        strftime(logger->cached_time, sizeof(logger->cached_time), "%Y-%m-%d %H:%M:%S", time_info);
+        logger->cached_second = second;
+    }
+    return logger->cached_time;
+}
+
+/**
+ * Write out the batches collected by the writer
+ */
+static void nexus_logger_flush_batches(NexusLogger* logger) {
+    FILE* outputs[3] = { stdout, stderr, (FILE*)logger->file_handle };
+    for (uint32_t i = 0; i < 3; i++) {
+        if (logger->batch_length[i] == 0) {
+            continue;
+        }
+        if (outputs[i] != NULL) {
+            fwrite(logger->batch + i * NEXUS_LOGGER_BATCH_SIZE, 1, logger->batch_length[i], outputs[i]);
+            fflush(outputs[i]);
+        }
+        logger->batch_length[i] = 0;
+    }
+}
+
+/**
+ * Write a line to an output, either right away or into the writer's batch
+ */
+static void nexus_logger_write(NexusLogger* logger, uint32_t output, const char* line, int length, bool batched) {
+    if (length <= 0) {
+        return;
+    }
+    size_t size = (size_t)length < NEXUS_LOGGER_MESSAGE_SIZE + 160 ? (size_t)length : NEXUS_LOGGER_MESSAGE_SIZE + 159;
+
+    if (!batched) {
+        FILE* file = output == NEXUS_LOGGER_OUTPUT_STDOUT ? stdout :
+                     output == NEXUS_LOGGER_OUTPUT_STDERR ? stderr : (FILE*)logger->file_handle;
+        fwrite(line, 1, size, file);
+        if (output == NEXUS_LOGGER_OUTPUT_FILE) {
+            fflush(file);
+        }
+        return;
+    }
+
+    if (logger->batch_length[output] + size > NEXUS_LOGGER_BATCH_SIZE) {
+        nexus_logger_flush_batches(logger);
+    }
+    memcpy(logger->batch + output * NEXUS_LOGGER_BATCH_SIZE + logger->batch_length[output], line, size);
+    logger->batch_length[output] += size;
+}
+
+/**
+ * Build the console and file lines of a message and write them
+ * The writer thread collects them in its batches instead of writing each
+ */
+static void nexus_logger_output(NexusLogger* logger, NexusLogLevel level, NexusLogCategory category,
+                                const char* time_str, const char* message, bool batched) {
     /* Call callback if set */
     if (logger->callback != NULL) {
         logger->callback(level, category, message, logger->callback_user_data);
     }
-    
+
     /* Color codes for different log levels */
     const char* color = NEXUS_COLOR_RESET;
     if (logger->color_output) {
@@ -249,28 +831,289 @@ void nexus_log(NexusLogger* logger, NexusLogLevel level, NexusLogCategory catego
             case NEXUS_LOG_LEVEL_FATAL:   color = NEXUS_COLOR_FATAL;   break;
         }
     }
-    
+
+    char line[NEXUS_LOGGER_MESSAGE_SIZE + 160];
+    int length;
+
     /* Write to console */
     if (logger->console_output) {
-        FILE* output = (level >= NEXUS_LOG_LEVEL_ERROR) ? stderr : stdout;
+        uint32_t output = (level >= NEXUS_LOG_LEVEL_ERROR) ? NEXUS_LOGGER_OUTPUT_STDERR : NEXUS_LOGGER_OUTPUT_STDOUT;
         if (logger->color_output) {
-            fprintf(output, "%s[%s] [%s] [%s]%s %s\n",
-                   color, time_str, level_strings[level], category_strings[category],
-                   NEXUS_COLOR_RESET, message);
+            length = snprintf(line, sizeof(line), "%s[%s] [%s] [%s]%s %s\n",
+                              color, time_str, level_strings[level], category_strings[category],
+                              NEXUS_COLOR_RESET, message);
         } else {
-            fprintf(output, "[%s] [%s] [%s] %s\n",
-                   time_str, level_strings[level], category_strings[category],
-                   message);
+            length = snprintf(line, sizeof(line), "[%s] [%s] [%s] %s\n",
+                              time_str, level_strings[level], category_strings[category],
+                              message);
         }
+        nexus_logger_write(logger, output, line, length, batched);
     }
-    
+
     /* Write to file */
     if (logger->file_output && logger->file_handle != NULL) {
-        fprintf((FILE*)logger->file_handle, "[%s] [%s] [%s] %s\n",
-               time_str, level_strings[level], category_strings[category],
-               message);
-        fflush((FILE*)logger->file_handle);
+        length = snprintf(line, sizeof(line), "[%s] [%s] [%s] %s\n",
+                          time_str, level_strings[level], category_strings[category],
+                          message);
+        nexus_logger_write(logger, NEXUS_LOGGER_OUTPUT_FILE, line, length, batched);
+    }
+}
+
+/**
+ * Format and write all queued records, oldest first across the rings (writer thread)
+ * @return Number of records written
+ */
+static uint32_t nexus_logger_drain(NexusLogger* logger) {
+    uint32_t written = 0;
+    int ring_count = SDL_GetAtomicInt(&logger->ring_count);
+
+    for (;;) {
+        /* Merge the rings by timestamp */
+        NexusLogRing* oldest = NULL;
+        NexusLogRecord oldest_record;
+        for (int i = 0; i < ring_count; i++) {
+            NexusLogRing* ring = &logger->rings[i];
+            NexusLogRecord record;
+            if (SDL_GetAtomicInt(&ring->ready) == 0 || nexus_logger_peek(ring, &record) == NULL) {
+                continue;
+            }
+            if (oldest == NULL || record.timestamp_ns < oldest_record.timestamp_ns) {
+                oldest = ring;
+                oldest_record = record;
+            }
+        }
+        if (oldest == NULL) {
+            break;
+        }
+
+        /* Format the record */
+        uint32_t head = SDL_GetAtomicU32(&oldest->head);
+        const uint8_t* payload = oldest->data + (head & (NEXUS_LOGGER_RING_SIZE - 1)) + sizeof(NexusLogRecord);
+        uint32_t payload_size = oldest_record.size - (uint32_t)sizeof(NexusLogRecord);
+        char message[NEXUS_LOGGER_MESSAGE_SIZE];
+        if (oldest_record.flags & NEXUS_LOG_RECORD_FORMATTED) {
+            const char* terminator = (const char*)memchr(payload, '\0', payload_size);
+            size_t length = terminator != NULL ? (size_t)(terminator - (const char*)payload) : payload_size;
+            length = length < sizeof(message) - 1 ? length : sizeof(message) - 1;
+            memcpy(message, payload, length);
+            message[length] = '\0';
+        } else {
+            nexus_logger_format_record(oldest_record.fmt, payload, payload_size, message, sizeof(message));
+        }
+        SDL_SetAtomicU32(&oldest->head, head + oldest_record.size);
+
+        nexus_logger_output(logger, (NexusLogLevel)oldest_record.level, (NexusLogCategory)oldest_record.category,
+                            nexus_logger_get_record_time(logger, oldest_record.timestamp_ns), message, true);
+        written++;
+    }
+
+    /* Report records lost to full rings */
+    int dropped = SDL_SetAtomicInt(&logger->dropped, 0);
+    if (dropped > 0) {
+        char message[64];
+        snprintf(message, sizeof(message), "%d log message(s) dropped, log rings were full", dropped);
+        nexus_logger_output(logger, NEXUS_LOG_LEVEL_WARNING, NEXUS_LOG_CATEGORY_GENERAL,
+                            nexus_logger_get_record_time(logger, SDL_GetTicksNS()), message, true);
+    }
+
+    nexus_logger_flush_batches(logger);
+    return written;
+}
+
+/**
+ * Writer thread main loop
+ */
+static int nexus_logger_writer_main(void* data) {
+    NexusLogger* logger = (NexusLogger*)data;
+
+    while (SDL_GetAtomicInt(&logger->writer_running) != 0) {
+        if (nexus_logger_drain(logger) == 0) {
+            SDL_WaitSemaphoreTimeout(logger->wake, NEXUS_LOGGER_FLUSH_MS);
+        }
+        SDL_AddAtomicInt(&logger->writer_passes, 1);
+    }
+
+    /* Write what was queued before the writer was stopped */
+    nexus_logger_drain(logger);
+    SDL_AddAtomicInt(&logger->writer_passes, 1);
+    return 0;
+}
+
+/**
+ * Enable or disable asynchronous output
+ * Logging threads only pack records into rings of their own, a writer thread
+ * formats them and writes in batches. Switch modes while no other thread logs.
+ */
+bool nexus_logger_enable_async(NexusLogger* logger, bool enable, NexusLogOverflowPolicy policy) {
+    if (logger == NULL) {
+        return false;
+    }
+
+    logger->overflow_policy = policy;
+    if (enable == logger->async_output) {
+        return true;
+    }
+
+    if (!enable) {
+        /* Stop the writer, it drains the rings before it returns */
+        SDL_SetAtomicInt(&logger->writer_running, 0);
+        SDL_SignalSemaphore(logger->wake);
+        SDL_WaitThread(logger->writer, NULL);
+        logger->writer = NULL;
+        logger->async_output = false;
+
+        for (int i = 0; i < SDL_GetAtomicInt(&logger->ring_count); i++) {
+            free(logger->rings[i].data);
+        }
+        free(logger->rings);
+        free(logger->batch);
+        SDL_DestroySemaphore(logger->wake);
+        logger->rings = NULL;
+        logger->batch = NULL;
+        logger->wake = NULL;
+        return true;
+    }
+
+    logger->rings = (NexusLogRing*)malloc(sizeof(NexusLogRing) * NEXUS_LOGGER_MAX_THREADS);
+    logger->batch = (char*)malloc(NEXUS_LOGGER_BATCH_SIZE * 3);
+    logger->wake = SDL_CreateSemaphore(0);
+    if (logger->rings == NULL || logger->batch == NULL || logger->wake == NULL) {
+        fprintf(stderr, "Failed to allocate memory for async logger!\n");
+        free(logger->rings);
+        free(logger->batch);
+        if (logger->wake != NULL) {
+            SDL_DestroySemaphore(logger->wake);
+        }
+        logger->rings = NULL;
+        logger->batch = NULL;
+        logger->wake = NULL;
+        return false;
+    }
+
+    /* Threads claim rings again, the TLS slot of a previous session is abandoned */
+    memset(logger->rings, 0, sizeof(NexusLogRing) * NEXUS_LOGGER_MAX_THREADS);
+    memset(logger->batch_length, 0, sizeof(logger->batch_length));
+    SDL_SetAtomicInt(&logger->ring_tls, 0);
+    SDL_SetAtomicInt(&logger->ring_count, 0);
+    SDL_SetAtomicInt(&logger->dropped, 0);
+    logger->start_time = (int64_t)time(NULL);
+    logger->start_ticks = SDL_GetTicksNS();
+    logger->cached_second = -1;
+
+    SDL_SetAtomicInt(&logger->writer_running, 1);
+    logger->writer = SDL_CreateThread(nexus_logger_writer_main, "NexusLogger", logger);
+    if (logger->writer == NULL) {
+        fprintf(stderr, "Failed to create logger thread: %s\n", SDL_GetError());
+        free(logger->rings);
+        free(logger->batch);
+        SDL_DestroySemaphore(logger->wake);
+        logger->rings = NULL;
+        logger->batch = NULL;
+        logger->wake = NULL;
+        return false;
+    }
+
+    logger->async_output = true;
+    return true;
+}
+
+/**
+ * Wait until all queued records are written (no-op for synchronous loggers)
+ */
+void nexus_logger_flush(NexusLogger* logger) {
+    if (logger == NULL || !logger->async_output) {
+        return;
+    }
+
+    /* Wait for the rings to empty, then for a pass that finished writing them */
+    for (;;) {
+        bool empty = true;
+        for (int i = 0; i < SDL_GetAtomicInt(&logger->ring_count); i++) {
+            NexusLogRing* ring = &logger->rings[i];
+            if (SDL_GetAtomicInt(&ring->ready) != 0 &&
+                SDL_GetAtomicU32(&ring->head) != SDL_GetAtomicU32(&ring->tail)) {
+                empty = false;
+                break;
+            }
+        }
+        if (empty) {
+            break;
+        }
+        SDL_SignalSemaphore(logger->wake);
+        SDL_Delay(1);
+    }
+
+    int passes = SDL_GetAtomicInt(&logger->writer_passes);
+    while (SDL_GetAtomicInt(&logger->writer_passes) == passes) {
+        SDL_SignalSemaphore(logger->wake);
+        SDL_Delay(1);
+    }
+}
+
+/**
+ * Log a message with a va_list
+ */
+static void nexus_log_va(NexusLogger* logger, NexusLogLevel level, NexusLogCategory category,
+                         const char* fmt, va_list args) {
+    /* Asynchronous loggers queue a record, threads without a ring log synchronously */
+    if (logger->async_output) {
+        NexusLogRing* ring = nexus_logger_get_ring(logger);
+        if (ring != NULL) {
+            NexusLogRecord record;
+            uint8_t payload[NEXUS_LOGGER_MAX_PAYLOAD];
+            uint32_t payload_size = 0;
+            record.level = (uint8_t)level;
+            record.category = (uint8_t)category;
+            record.flags = 0;
+            record.timestamp_ns = SDL_GetTicksNS();
+            record.fmt = fmt;
+
+            if (!nexus_logger_pack_arguments(fmt, args, payload, &payload_size)) {
+                /* Formats the writer cannot rebuild are formatted here */
+                int length = vsnprintf((char*)payload, sizeof(payload), fmt, args);
+                record.flags = NEXUS_LOG_RECORD_FORMATTED;
+                record.fmt = NULL;
+                payload_size = length < 0 ? 0 : (uint32_t)length < sizeof(payload) ? (uint32_t)length + 1 :
+                               (uint32_t)sizeof(payload);
+            }
+            nexus_logger_push(logger, ring, &record, payload, payload_size);
+
+            /* The process may not survive a fatal message, get it out first */
+            if (level == NEXUS_LOG_LEVEL_FATAL) {
+                nexus_logger_flush(logger);
+            }
+            return;
+        }
     }
+
+    /* Format message */
+    char message[NEXUS_LOGGER_MESSAGE_SIZE];
+    vsnprintf(message, sizeof(message), fmt, args);
+
+    /* Get time string */
+    char time_str[64];
+    get_time_string(time_str, sizeof(time_str));
+
+    nexus_logger_output(logger, level, category, time_str, message, false);
+}
+
+/**
+ * Log a message
+ */
+void nexus_log(NexusLogger* logger, NexusLogLevel level, NexusLogCategory category, const char* fmt, ...) {
+    if (logger == NULL || fmt == NULL) {
+        return;
+    }
+
+    /* Check level and category */
+    if (level < logger->min_level || !logger->enabled_categories[category]) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, fmt);
+    nexus_log_va(logger, level, category, fmt, args);
+    va_end(args);
 }
 
 /**
@@ -280,21 +1123,16 @@ void nexus_log_trace(NexusLogger* logger, NexusLogCategory category, const char*
     if (logger == NULL || fmt == NULL) {
         return;
     }
-    
+
     /* Check level and category */
     if (NEXUS_LOG_LEVEL_TRACE < logger->min_level || !logger->enabled_categories[category]) {
         return;
     }
-    
-    /* Format message */
-    char message[1024];
+
     va_list args;
     va_start(args, fmt);
-    vsnprintf(message, sizeof(message), fmt, args);
+    nexus_log_va(logger, NEXUS_LOG_LEVEL_TRACE, category, fmt, args);
     va_end(args);
-    
-    /* Log the message */
-    nexus_log(logger, NEXUS_LOG_LEVEL_TRACE, category, "%s", message);
 }
 
 /**
@@ -304,21 +1142,16 @@ void nexus_log_debug(NexusLogger* logger, NexusLogCategory category, const char*
     if (logger == NULL || fmt == NULL) {
         return;
     }
-    
+
     /* Check level and category */
     if (NEXUS_LOG_LEVEL_DEBUG < logger->min_level || !logger->enabled_categories[category]) {
         return;
     }
-    
-    /* Format message */
-    char message[1024];
+
     va_list args;
     va_start(args, fmt);
-    vsnprintf(message, sizeof(message), fmt, args);
+    nexus_log_va(logger, NEXUS_LOG_LEVEL_DEBUG, category, fmt, args);
     va_end(args);
-    
-    /* Log the message */
-    nexus_log(logger, NEXUS_LOG_LEVEL_DEBUG, category, "%s", message);
 }
 
 /**
@@ -328,21 +1161,16 @@ void nexus_log_info(NexusLogger* logger, NexusLogCategory category, const char*
     if (logger == NULL || fmt == NULL) {
         return;
     }
-    
+
     /* Check level and category */
     if (NEXUS_LOG_LEVEL_INFO < logger->min_level || !logger->enabled_categories[category]) {
         return;
     }
-    
-    /* Format message */
-    char message[1024];
+
     va_list args;
     va_start(args, fmt);
-    vsnprintf(message, sizeof(message), fmt, args);
+    nexus_log_va(logger, NEXUS_LOG_LEVEL_INFO, category, fmt, args);
     va_end(args);
-    
-    /* Log the message */
-    nexus_log(logger, NEXUS_LOG_LEVEL_INFO, category, "%s", message);
 }
 
 /**
@@ -352,21 +1180,16 @@ void nexus_log_warning(NexusLogger* logger, NexusLogCategory category, const cha
     if (logger == NULL || fmt == NULL) {
         return;
     }
-    
+
     /* Check level and category */
     if (NEXUS_LOG_LEVEL_WARNING < logger->min_level || !logger->enabled_categories[category]) {
         return;
     }
-    
-    /* Format message */
-    char message[1024];
+
     va_list args;
     va_start(args, fmt);
-    vsnprintf(message, sizeof(message), fmt, args);
+    nexus_log_va(logger, NEXUS_LOG_LEVEL_WARNING, category, fmt, args);
     va_end(args);
-    
-    /* Log the message */
-    nexus_log(logger, NEXUS_LOG_LEVEL_WARNING, category, "%s", message);
 }
 
 /**
@@ -376,21 +1199,16 @@ void nexus_log_error(NexusLogger* logger, NexusLogCategory category, const char*
     if (logger == NULL || fmt == NULL) {
         return;
     }
-    
+
     /* Check level and category */
     if (NEXUS_LOG_LEVEL_ERROR < logger->min_level || !logger->enabled_categories[category]) {
         return;
     }
-    
-    /* Format message */
-    char message[1024];
+
     va_list args;
     va_start(args, fmt);
-    vsnprintf(message, sizeof(message), fmt, args);
+    nexus_log_va(logger, NEXUS_LOG_LEVEL_ERROR, category, fmt, args);
     va_end(args);
-    
-    /* Log the message */
-    nexus_log(logger, NEXUS_LOG_LEVEL_ERROR, category, "%s", message);
 }
 
 /**
@@ -400,19 +1218,14 @@ void nexus_log_fatal(NexusLogger* logger, NexusLogCategory category, const char*
     if (logger == NULL || fmt == NULL) {
         return;
     }
-    
+
     /* Check level and category */
     if (NEXUS_LOG_LEVEL_FATAL < logger->min_level || !logger->enabled_categories[category]) {
         return;
     }
-    
-    /* Format message */
-    char message[1024];
+
     va_list args;
     va_start(args, fmt);
-    vsnprintf(message, sizeof(message), fmt, args);
+    nexus_log_va(logger, NEXUS_LOG_LEVEL_FATAL, category, fmt, args);
     va_end(args);
-    
-    /* Log the message */
-    nexus_log(logger, NEXUS_LOG_LEVEL_FATAL, category, "%s", message);
 }
@@ -0,0 +1,118 @@
+/**
+ * Nexus3D Mapped File Implementation
+ * mmap on POSIX systems, a single heap read elsewhere
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "nexus3d/utils/mapped_file.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define NEXUS_MAPPED_FILE_MMAP 1
+#endif
+
+/**
+ * Read a whole file into a heap block (fallback when mapping is unavailable)
+ */
+static bool nexus_mapped_file_read(NexusMappedFile* file, const char* filename) {
+    FILE* handle = fopen(filename, "rb");
+    if (handle == NULL) {
+        return false;
+    }
+
+    /* Get file size */
+    fseek(handle, 0, SEEK_END);
+    long file_size = ftell(handle);
+    fseek(handle, 0, SEEK_SET);
+    if (file_size <= 0) {
+        fclose(handle);
+        return false;
+    }
+
+    /* Read file content */
+    void* data = malloc((size_t)file_size);
+    if (data == NULL) {
+        fprintf(stderr, "Failed to allocate memory for file: %s\n", filename);
+        fclose(handle);
+        return false;
+    }
+
+    size_t read_size = fread(data, 1, (size_t)file_size, handle);
+    fclose(handle);
+    if (read_size != (size_t)file_size) {
+        free(data);
+        return false;
+    }
+
+    file->data = data;
+    file->size = (size_t)file_size;
+    file->mapped = false;
+    return true;
+}
+
+/**
+ * Open a file for reading through a read-only mapping
+ * Empty and missing files fail, the caller reports the error
+ */
+bool nexus_mapped_file_open(NexusMappedFile* file, const char* filename) {
+    if (file == NULL || filename == NULL) {
+        return false;
+    }
+
+    memset(file, 0, sizeof(NexusMappedFile));
+
+#ifdef NEXUS_MAPPED_FILE_MMAP
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    /* The mapping stays valid after the descriptor is closed */
+    void* data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data != MAP_FAILED) {
+        file->data = data;
+        file->size = (size_t)info.st_size;
+        file->mapped = true;
+        return true;
+    }
+#endif
+
+    return nexus_mapped_file_read(file, filename);
+}
+
+/**
+ * Close a mapped file
+ */
+void nexus_mapped_file_close(NexusMappedFile* file) {
+    if (file == NULL || file->data == NULL) {
+        return;
+    }
+
+#ifdef NEXUS_MAPPED_FILE_MMAP
+    if (file->mapped) {
+        munmap((void*)file->data, file->size);
+    } else {
+        free((void*)file->data);
+    }
+#else
+    free((void*)file->data);
+#endif
+
+    memset(file, 0, sizeof(NexusMappedFile));
+}
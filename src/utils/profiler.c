@@ -0,0 +1,380 @@
+/**
+ * Nexus3D CPU Profiler Implementation
+ * Each thread records finished scopes into a buffer of its own, a capture is
+ * written out as Chrome trace "complete" events once it was stopped
+ */
+
+#include "nexus3d/utils/profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef NEXUS_PROFILE
+
+/**
+ * Profiler state
+ */
+typedef struct {
+    SDL_AtomicInt initialized;     /* Scopes are recorded */
+    SDL_TLSID thread_tls;          /* Buffer of the calling thread */
+    NexusProfileThread* threads[NEXUS_PROFILER_MAX_THREADS]; /* Registered threads */
+    SDL_AtomicInt thread_count;    /* Threads that claimed a buffer */
+    NexusProfileThread* gpu_track; /* Buffer of the GPU timings (recorded by the renderer) */
+    SDL_AtomicInt capturing;       /* Finished scopes are stored */
+    SDL_AtomicInt capture;         /* Capture counter, buffers of older captures are reset */
+    uint64_t capture_begin;        /* Performance counter when the capture started */
+    uint64_t frequency;            /* Performance counter ticks per second */
+} NexusProfiler;
+
+static NexusProfiler g_profiler;
+
+/**
+ * Claim a buffer for a new trace track
+ * @return NULL if all buffers are taken
+ */
+static NexusProfileThread* nexus_profiler_create_track(const char* name) {
+    int index = SDL_AddAtomicInt(&g_profiler.thread_count, 1);
+    if (index >= NEXUS_PROFILER_MAX_THREADS) {
+        SDL_SetAtomicInt(&g_profiler.thread_count, NEXUS_PROFILER_MAX_THREADS);
+        return NULL;
+    }
+
+    NexusProfileThread* thread = (NexusProfileThread*)malloc(sizeof(NexusProfileThread));
+    if (thread == NULL) {
+        fprintf(stderr, "Failed to allocate memory for profiler thread!\n");
+        return NULL;
+    }
+    memset(thread, 0, sizeof(NexusProfileThread));
+    thread->thread_id = SDL_GetCurrentThreadID();
+    if (name != NULL) {
+        strncpy(thread->name, name, sizeof(thread->name) - 1);
+    } else {
+        snprintf(thread->name, sizeof(thread->name), "Thread %d", index);
+    }
+
+    SDL_SetAtomicPointer((void**)&g_profiler.threads[index], thread);
+    return thread;
+}
+
+/**
+ * Get the buffer of the calling thread, registering the thread on first use
+ * @return NULL if the profiler is not initialized or all buffers are taken
+ */
+static NexusProfileThread* nexus_profiler_get_thread(void) {
+    if (SDL_GetAtomicInt(&g_profiler.initialized) == 0) {
+        return NULL;
+    }
+
+    NexusProfileThread* thread = (NexusProfileThread*)SDL_GetTLS(&g_profiler.thread_tls);
+    if (thread != NULL) {
+        return thread;
+    }
+
+    thread = nexus_profiler_create_track(NULL);
+    if (thread != NULL) {
+        SDL_SetTLS(&g_profiler.thread_tls, thread, NULL);
+    }
+    return thread;
+}
+
+/**
+ * Append a finished event to a track of the running capture
+ */
+static void nexus_profiler_record(NexusProfileThread* thread, const char* name, uint64_t begin, uint64_t end) {
+    /* Events that began before the capture started are not part of it */
+    if (SDL_GetAtomicInt(&g_profiler.capturing) == 0 || begin < g_profiler.capture_begin) {
+        return;
+    }
+
+    /* The first event of a capture resets the buffer, only its thread writes it */
+    uint32_t capture = (uint32_t)SDL_GetAtomicInt(&g_profiler.capture);
+    if (thread->capture != capture) {
+        SDL_SetAtomicU32(&thread->event_count, 0);
+        SDL_SetAtomicU32(&thread->dropped, 0);
+        thread->capture = capture;
+    }
+    if (thread->events == NULL) {
+        thread->events = (NexusProfileEvent*)malloc(sizeof(NexusProfileEvent) * NEXUS_PROFILER_MAX_EVENTS);
+        if (thread->events == NULL) {
+            fprintf(stderr, "Failed to allocate memory for profiler events!\n");
+            return;
+        }
+    }
+
+    uint32_t count = SDL_GetAtomicU32(&thread->event_count);
+    if (count >= NEXUS_PROFILER_MAX_EVENTS) {
+        SDL_SetAtomicU32(&thread->dropped, SDL_GetAtomicU32(&thread->dropped) + 1);
+        return;
+    }
+
+    thread->events[count].name = name;
+    thread->events[count].begin = begin;
+    thread->events[count].end = end;
+    SDL_SetAtomicU32(&thread->event_count, count + 1);
+}
+
+/**
+ * Initialize the profiler, the calling thread is named "Main"
+ */
+bool nexus_profiler_init(void) {
+    if (SDL_GetAtomicInt(&g_profiler.initialized) != 0) {
+        return true;
+    }
+
+    memset(g_profiler.threads, 0, sizeof(g_profiler.threads));
+    SDL_SetAtomicInt(&g_profiler.thread_tls, 0);
+    SDL_SetAtomicInt(&g_profiler.thread_count, 0);
+    SDL_SetAtomicInt(&g_profiler.capturing, 0);
+    g_profiler.frequency = SDL_GetPerformanceFrequency();
+    SDL_SetAtomicInt(&g_profiler.initialized, 1);
+
+    nexus_profiler_set_thread_name("Main");
+    return true;
+}
+
+/**
+ * Shut down the profiler, no other thread may record scopes any more
+ */
+void nexus_profiler_shutdown(void) {
+    if (SDL_GetAtomicInt(&g_profiler.initialized) == 0) {
+        return;
+    }
+
+    SDL_SetAtomicInt(&g_profiler.initialized, 0);
+    SDL_SetAtomicInt(&g_profiler.capturing, 0);
+
+    int thread_count = SDL_GetAtomicInt(&g_profiler.thread_count);
+    for (int i = 0; i < thread_count && i < NEXUS_PROFILER_MAX_THREADS; i++) {
+        NexusProfileThread* thread = g_profiler.threads[i];
+        if (thread != NULL) {
+            free(thread->events);
+            free(thread);
+        }
+        g_profiler.threads[i] = NULL;
+    }
+    g_profiler.gpu_track = NULL;
+
+    /* Threads register again after a new init, their old TLS slot is abandoned */
+    SDL_SetTLS(&g_profiler.thread_tls, NULL, NULL);
+    SDL_SetAtomicInt(&g_profiler.thread_tls, 0);
+    SDL_SetAtomicInt(&g_profiler.thread_count, 0);
+}
+
+/**
+ * Name the calling thread in the trace
+ */
+void nexus_profiler_set_thread_name(const char* name) {
+    NexusProfileThread* thread = nexus_profiler_get_thread();
+    if (thread == NULL || name == NULL) {
+        return;
+    }
+
+    strncpy(thread->name, name, sizeof(thread->name) - 1);
+    thread->name[sizeof(thread->name) - 1] = '\0';
+}
+
+/**
+ * Open a scope on the calling thread
+ */
+void nexus_profiler_begin(const char* name) {
+    NexusProfileThread* thread = nexus_profiler_get_thread();
+    if (thread == NULL) {
+        return;
+    }
+
+    /* Scopes nested too deep are counted so their ends still pair up */
+    if (thread->depth < NEXUS_PROFILER_MAX_DEPTH) {
+        thread->stack[thread->depth].name = name;
+        thread->stack[thread->depth].begin = SDL_GetPerformanceCounter();
+    }
+    thread->depth++;
+}
+
+/**
+ * Close the innermost scope of the calling thread
+ */
+void nexus_profiler_end(void) {
+    NexusProfileThread* thread = nexus_profiler_get_thread();
+    if (thread == NULL || thread->depth == 0) {
+        return;
+    }
+
+    thread->depth--;
+    if (thread->depth >= NEXUS_PROFILER_MAX_DEPTH) {
+        return;
+    }
+
+    const NexusProfileScope* scope = &thread->stack[thread->depth];
+    nexus_profiler_record(thread, scope->name, scope->begin, SDL_GetPerformanceCounter());
+}
+
+/**
+ * Record a GPU timing on the trace's GPU track
+ * Timings come from one thread at a time (the renderer's)
+ */
+void nexus_profiler_add_gpu_event(const char* name, uint64_t begin, uint64_t end) {
+    if (SDL_GetAtomicInt(&g_profiler.initialized) == 0) {
+        return;
+    }
+
+    if (g_profiler.gpu_track == NULL) {
+        g_profiler.gpu_track = nexus_profiler_create_track("GPU");
+        if (g_profiler.gpu_track == NULL) {
+            return;
+        }
+    }
+    nexus_profiler_record(g_profiler.gpu_track, name, begin, end);
+}
+
+/**
+ * Start a capture, events of the previous one are discarded
+ */
+void nexus_profiler_start_capture(void) {
+    if (SDL_GetAtomicInt(&g_profiler.initialized) == 0) {
+        return;
+    }
+
+    g_profiler.capture_begin = SDL_GetPerformanceCounter();
+    SDL_AddAtomicInt(&g_profiler.capture, 1);
+    SDL_SetAtomicInt(&g_profiler.capturing, 1);
+}
+
+/**
+ * Stop the capture, its events stay available for nexus_profiler_write_trace
+ */
+void nexus_profiler_stop_capture(void) {
+    SDL_SetAtomicInt(&g_profiler.capturing, 0);
+}
+
+/**
+ * Check if a capture is running
+ */
+bool nexus_profiler_is_capturing(void) {
+    return SDL_GetAtomicInt(&g_profiler.capturing) != 0;
+}
+
+/**
+ * Write a string as a JSON string literal
+ */
+static void nexus_profiler_write_json_string(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const char* c = text != NULL ? text : ""; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', file);
+            fputc(*c, file);
+        } else if ((unsigned char)*c < 0x20) {
+            fprintf(file, "\\u%04x", (unsigned int)(unsigned char)*c);
+        } else {
+            fputc(*c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+/**
+ * Write the last capture as Chrome trace JSON
+ * Call after nexus_profiler_stop_capture
+ */
+bool nexus_profiler_write_trace(const char* filepath) {
+    if (filepath == NULL || SDL_GetAtomicInt(&g_profiler.initialized) == 0) {
+        return false;
+    }
+
+    FILE* file = fopen(filepath, "w");
+    if (file == NULL) {
+        fprintf(stderr, "Failed to open trace file for writing: %s\n", filepath);
+        return false;
+    }
+
+    uint32_t capture = (uint32_t)SDL_GetAtomicInt(&g_profiler.capture);
+    double to_us = 1000000.0 / (double)g_profiler.frequency;
+    uint32_t dropped = 0;
+
+    fprintf(file, "{\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Nexus3D\"}}");
+
+    int thread_count = SDL_GetAtomicInt(&g_profiler.thread_count);
+    for (int i = 0; i < thread_count && i < NEXUS_PROFILER_MAX_THREADS; i++) {
+        NexusProfileThread* thread = (NexusProfileThread*)SDL_GetAtomicPointer((void**)&g_profiler.threads[i]);
+        if (thread == NULL) {
+            continue;
+        }
+
+        /* Thread name, threads keep their registration order */
+        fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", i + 1);
+        nexus_profiler_write_json_string(file, thread->name);
+        fprintf(file, "}}");
+        fprintf(file, ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                "\"args\":{\"sort_index\":%d}}", i + 1, i);
+
+        if (thread->capture != capture || thread->events == NULL) {
+            continue;
+        }
+
+        /* Complete events, timestamps in microseconds since the capture start */
+        uint32_t count = SDL_GetAtomicU32(&thread->event_count);
+        for (uint32_t e = 0; e < count; e++) {
+            const NexusProfileEvent* event = &thread->events[e];
+            fprintf(file, ",\n{\"name\":");
+            nexus_profiler_write_json_string(file, event->name);
+            fprintf(file, ",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                    (double)(event->begin - g_profiler.capture_begin) * to_us,
+                    (double)(event->end - event->begin) * to_us, i + 1);
+        }
+        dropped += SDL_GetAtomicU32(&thread->dropped);
+    }
+
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(file);
+
+    if (dropped > 0) {
+        fprintf(stderr, "Profiler dropped %u event(s), the thread buffers were full\n", dropped);
+    }
+    printf("Profiler trace written to %s\n", filepath);
+    return true;
+}
+
+#else
+
+/* Profiling is compiled out, the capture API does nothing */
+
+bool nexus_profiler_init(void) {
+    return true;
+}
+
+void nexus_profiler_shutdown(void) {
+}
+
+void nexus_profiler_set_thread_name(const char* name) {
+    (void)name;
+}
+
+void nexus_profiler_begin(const char* name) {
+    (void)name;
+}
+
+void nexus_profiler_end(void) {
+}
+
+void nexus_profiler_add_gpu_event(const char* name, uint64_t begin, uint64_t end) {
+    (void)name;
+    (void)begin;
+    (void)end;
+}
+
+void nexus_profiler_start_capture(void) {
+}
+
+void nexus_profiler_stop_capture(void) {
+}
+
+bool nexus_profiler_is_capturing(void) {
+    return false;
+}
+
+bool nexus_profiler_write_trace(const char* filepath) {
+    (void)filepath;
+    return false;
+}
+
+#endif /* NEXUS_PROFILE */
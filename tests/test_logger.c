@@ -0,0 +1,110 @@
+/**
+ * Nexus3D Logger Tests
+ * Formatting of asynchronous records at the message size limit
+ */
+
+#include "nexus3d/utils/logger.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Message buffer of the writer thread (NEXUS_LOGGER_MESSAGE_SIZE in logger.c) */
+#define TEST_MESSAGE_SIZE 1024
+
+/* Longest string argument that fits a record */
+#define TEST_STRING_LENGTH 900
+
+/* Format strings have to outlive the records, they are only read by the writer */
+static char test_format[TEST_MESSAGE_SIZE * 2];
+static char test_argument[TEST_STRING_LENGTH + 1];
+
+/* Last message passed to the callback */
+static char test_message[TEST_MESSAGE_SIZE * 2];
+static int test_message_count;
+
+/**
+ * Callback recording the formatted message
+ */
+static void test_capture(NexusLogLevel level, NexusLogCategory category, const char* message, void* user_data) {
+    strncpy(test_message, message, sizeof(test_message) - 1);
+    test_message[sizeof(test_message) - 1] = '\0';
+    test_message_count++;
+}
+
+/**
+ * Log one record through an asynchronous logger and wait for it to be written
+ */
+static bool test_log_async(const char* fmt, const char* argument) {
+    NexusLogger* logger = nexus_logger_create();
+    if (logger == NULL) {
+        return false;
+    }
+
+    nexus_logger_enable_console_output(logger, false);
+    nexus_logger_set_callback(logger, test_capture, NULL);
+    if (!nexus_logger_enable_async(logger, true, NEXUS_LOG_OVERFLOW_BLOCK)) {
+        nexus_logger_destroy(logger);
+        return false;
+    }
+
+    test_message[0] = '\0';
+    test_message_count = 0;
+    if (argument != NULL) {
+        nexus_log_info(logger, NEXUS_LOG_CATEGORY_GENERAL, fmt, argument);
+    } else {
+        nexus_log_info(logger, NEXUS_LOG_CATEGORY_GENERAL, fmt);
+    }
+
+    nexus_logger_flush(logger);
+    nexus_logger_enable_async(logger, false, NEXUS_LOG_OVERFLOW_BLOCK);
+    nexus_logger_destroy(logger);
+    return test_message_count == 1;
+}
+
+/**
+ * Check that a message was truncated to the buffer and ends with the expected character
+ */
+static bool test_check_truncated(const char* name, char last) {
+    size_t length = strlen(test_message);
+    bool passed = length == TEST_MESSAGE_SIZE - 1 && test_message[length - 1] == last;
+    printf("%s: %s (length %zu)\n", passed ? "PASS" : "FAIL", name, length);
+    return passed;
+}
+
+/**
+ * "%%" right after literal text that fills the buffer
+ */
+static bool test_percent_after_full_literal(void) {
+    memset(test_format, 'a', TEST_MESSAGE_SIZE - 1);
+    strcpy(test_format + TEST_MESSAGE_SIZE - 1, "%%");
+
+    return test_log_async(test_format, NULL) && test_check_truncated("percent after full literal", 'a');
+}
+
+/**
+ * Long "%s" argument, literal text up to the limit, then "%%"
+ */
+static bool test_percent_after_string_and_literal(void) {
+    memset(test_argument, 's', TEST_STRING_LENGTH);
+    test_argument[TEST_STRING_LENGTH] = '\0';
+
+    size_t literal = TEST_MESSAGE_SIZE - 1 - TEST_STRING_LENGTH;
+    strcpy(test_format, "%s");
+    memset(test_format + 2, 'b', literal);
+    strcpy(test_format + 2 + literal, "%%%%");
+
+    return test_log_async(test_format, test_argument) &&
+           test_check_truncated("percent after string and literal", 'b');
+}
+
+/**
+ * Run all logger tests
+ */
+int main(int argc, char* argv[]) {
+    int failed = 0;
+
+    failed += test_percent_after_full_literal() ? 0 : 1;
+    failed += test_percent_after_string_and_literal() ? 0 : 1;
+
+    printf("%d logger test(s) failed\n", failed);
+    return failed == 0 ? 0 : 1;
+}